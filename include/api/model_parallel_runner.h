@@ -25,6 +25,10 @@ namespace mindspore {
 struct RunnerConfig {
   std::shared_ptr<Context> context = nullptr;
   int workers_num = 0;
+  /// \brief Merge the concurrent requests whose batch is less than max_batch_size into one inference, 0 means disable.
+  int max_batch_size = 0;
+  /// \brief The max time in microseconds that a request waits for the other requests to be merged with.
+  int max_batch_delay_us = 0;
 };
 
 /// \brief The ModelParallelRunner class is used to define a MindSpore ModelParallelRunner, facilitating Model
@@ -42,6 +42,17 @@ DynamicMemPoolBestFit::~DynamicMemPoolBestFit() {
 }
 
 DeviceMemPtr DynamicMemPoolBestFit::AllocTensorMem(size_t size, bool from_persistent_mem) {
+  // The small common memory is served by the size class cache without the global lock, if it is enabled.
+  if (size_class_mem_cache_ != nullptr && !from_persistent_mem && SizeClassMemCache::IsSizeClassMem(size)) {
+    auto device_addr = size_class_mem_cache_->Alloc(size);
+    if (device_addr != nullptr) {
+      return device_addr;
+    }
+  }
+  return AllocBestFitMem(size, from_persistent_mem);
+}
+
+DeviceMemPtr DynamicMemPoolBestFit::AllocBestFitMem(size_t size, bool from_persistent_mem) {
   size_t align_size = AlignMemorySize(size);
   std::lock_guard<std::mutex> locker(mutex_);
   // Find the idle memory buf by tensor size, if not find, then add new memory block and memory buf.
@@ -61,8 +72,8 @@ DeviceMemPtr DynamicMemPoolBestFit::AllocTensorMem(size_t size, bool from_persis
 std::vector<DeviceMemPtr> DynamicMemPoolBestFit::AllocContinuousTensorMem(size_t total_size,
                                                                           const std::vector<size_t> &size_list) {
   std::vector<DeviceMemPtr> device_addr_list;
-  // Pre-alloc the one whole piece memory.
-  auto device_addr = AllocTensorMem(total_size, false);
+  // Pre-alloc the one whole piece memory, which must be in the best fit pool to be split.
+  auto device_addr = AllocBestFitMem(total_size, false);
   if (!device_addr) {
     return device_addr_list;
   }
@@ -294,6 +305,14 @@ DynamicMemBlockPtr DynamicMemPoolBestFit::FindMemBlock(const DeviceMemPtr &devic
 }
 
 void DynamicMemPoolBestFit::FreeTensorMem(const DeviceMemPtr &device_addr) {
+  MS_EXCEPTION_IF_NULL(device_addr);
+  if (size_class_mem_cache_ != nullptr && size_class_mem_cache_->Free(device_addr)) {
+    return;
+  }
+  FreeBestFitMem(device_addr);
+}
+
+void DynamicMemPoolBestFit::FreeBestFitMem(const DeviceMemPtr &device_addr) {
   MS_EXCEPTION_IF_NULL(device_addr);
   std::lock_guard<std::mutex> locker(mutex_);
   auto fn = [this](const MemStatusManagerPtr &mem_mng, const DeviceMemPtr &device_addr) -> DynamicMemBlockPtr {
@@ -389,7 +408,22 @@ void DynamicMemPoolBestFit::EraseIdleMemBuf(size_t size, const DeviceMemPtr &dev
   MS_LOG(ERROR) << "Can't find the size[" << size << "] and device address[" << device_addr << "] in the idle mem_buf.";
 }
 
+void DynamicMemPoolBestFit::EnableSizeClassMemCache(size_t max_cache_mem_size) {
+  if (size_class_mem_cache_ != nullptr) {
+    return;
+  }
+  size_class_mem_cache_ = std::make_unique<SizeClassMemCache>(
+    [this](size_t size) { return AllocBestFitMem(size, false); },
+    [this](const DeviceMemPtr &device_addr) { FreeBestFitMem(device_addr); }, max_cache_mem_size);
+  MS_LOG(INFO) << "Enable size class mem cache, max cache size " << max_cache_mem_size;
+}
+
 void DynamicMemPoolBestFit::ReleaseDeviceRes() {
+  // Give back the arenas of size class cache before releasing the memory blocks.
+  if (size_class_mem_cache_ != nullptr) {
+    size_class_mem_cache_->DumpSizeClassMemStateInfo();
+    size_class_mem_cache_->Release();
+  }
   std::lock_guard<std::mutex> locker(mutex_);
   auto fn = [this](const MemStatusManagerPtr &mem_mng) {
     for (auto &iter : mem_mng->mem_block_list_) {
@@ -435,6 +469,9 @@ void DynamicMemPoolBestFit::DumpDynamicMemPoolStateInfo() {
 
   fn(common_mem_, std::string(kCommonMem));
   fn(persistent_mem_, std::string(kPersistentParamMem));
+  if (size_class_mem_cache_ != nullptr) {
+    size_class_mem_cache_->DumpSizeClassMemStateInfo();
+  }
 }
 
 void DynamicMemPoolBestFit::DumpDynamicMemPoolDebugInfo() {
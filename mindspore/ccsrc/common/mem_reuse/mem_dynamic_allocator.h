@@ -26,10 +26,10 @@
 #include <mutex>
 #include <string>
 #include "utils/ms_utils.h"
+#include "common/mem_reuse/size_class_mem_cache.h"
 
 namespace mindspore {
 namespace device {
-using DeviceMemPtr = void(*);
 
 // The status of memory buf.
 enum DynamicMemBufStatus : int { kMemBufIdle, kMemBufUsed };
@@ -154,6 +154,9 @@ class DynamicMemPoolBestFit {
   void SetMemAllocUintSize(size_t common_size, size_t persist_size = DYNAMIC_MEM_ALLOC_UNIT_SIZE);
   // Set mem pool block size
   void SetMemPoolBlockSize(size_t available_device_mem_size);
+  // Serve the small common memory by the size class cache with per-thread caches in front of the best fit pool, the
+  // memory held by the cache is limited to max_cache_mem_size.
+  void EnableSizeClassMemCache(size_t max_cache_mem_size);
 
   // The statistics information.
   size_t TotalMemStatistics() const {
@@ -165,6 +168,7 @@ class DynamicMemPoolBestFit {
   size_t UsedMemPeakStatistics() const {
     return common_mem_->mps_.used_mem_peak_size_ + persistent_mem_->mps_.used_mem_peak_size_;
   }
+  const SizeClassMemCache *size_class_mem_cache() const { return size_class_mem_cache_.get(); }
 
   // Display the brief state information of memory block and memory buf.
   void DumpDynamicMemPoolStateInfo();
@@ -203,8 +207,13 @@ class DynamicMemPoolBestFit {
   // Erase the idle memory buf by size and device address when idle memory buf is combined.
   void EraseIdleMemBuf(size_t size, const DeviceMemPtr &device_addr, const MemStatusManagerPtr &mem_mng);
 
+  // Alloc and free the memory of best fit pool, which are used by size class cache to get its arenas.
+  DeviceMemPtr AllocBestFitMem(size_t size, bool from_persistent_mem);
+  void FreeBestFitMem(const DeviceMemPtr &device_addr);
+
   // Support multi-thread.
   std::mutex mutex_;
+  std::unique_ptr<SizeClassMemCache> size_class_mem_cache_{nullptr};
   MemStatusManagerPtr persistent_mem_{nullptr};
   MemStatusManagerPtr common_mem_{nullptr};
   // In the graph mode, the unit size set in the context will be modified through the FetchMemUnitSize function, so it
@@ -0,0 +1,403 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/mem_reuse/size_class_mem_cache.h"
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <utility>
+#include "utils/log_adapter.h"
+#include "utils/convert_utils_base.h"
+
+namespace mindspore {
+namespace device {
+namespace {
+constexpr size_t kArenaSize = (kSizeClassSpanNumPerArena + 1) * kSizeClassSpanSize;
+
+size_t NewCacheId() {
+  static std::atomic<size_t> cache_num{0};
+  return cache_num++;
+}
+}  // namespace
+
+class SizeClassMemCache::ThreadCacheSet {
+ public:
+  ThreadCacheSet() = default;
+  ~ThreadCacheSet() {
+    for (auto &entry : entries_) {
+      std::lock_guard<std::mutex> locker(entry.handle_->lock_);
+      if (entry.handle_->cache_ != nullptr) {
+        entry.handle_->cache_->FlushThreadCache(entry.thread_cache_.get());
+      }
+    }
+  }
+
+  ThreadCache *Get(SizeClassMemCache *cache) {
+    if (last_ != nullptr && last_->id_ == cache->id_) {
+      return last_->thread_cache_.get();
+    }
+    for (auto &entry : entries_) {
+      if (entry.id_ == cache->id_) {
+        last_ = &entry;
+        return entry.thread_cache_.get();
+      }
+    }
+    // Drop the thread caches of the destroyed caches before adding a new one.
+    (void)entries_.erase(std::remove_if(entries_.begin(), entries_.end(),
+                                        [](const Entry &entry) {
+                                          std::lock_guard<std::mutex> locker(entry.handle_->lock_);
+                                          return entry.handle_->cache_ == nullptr;
+                                        }),
+                         entries_.end());
+    auto thread_cache = std::make_unique<ThreadCache>();
+    thread_cache->epoch_ = cache->epoch_;
+    entries_.push_back({cache->id_, cache->handle_, std::move(thread_cache)});
+    last_ = &entries_.back();
+    return last_->thread_cache_.get();
+  }
+
+ private:
+  struct Entry {
+    size_t id_;
+    std::shared_ptr<Handle> handle_;
+    std::unique_ptr<ThreadCache> thread_cache_;
+  };
+  std::vector<Entry> entries_;
+  Entry *last_{nullptr};
+
+  DISABLE_COPY_AND_ASSIGN(ThreadCacheSet);
+};
+
+SizeClassMemCache::SizeClassMemCache(ArenaAllocFunc alloc_func, ArenaFreeFunc free_func, size_t max_cache_mem_size)
+    : alloc_func_(std::move(alloc_func)),
+      free_func_(std::move(free_func)),
+      max_cache_mem_size_(max_cache_mem_size),
+      span_map_(std::make_unique<std::atomic<SpanMapLeaf *>[]>(kSpanMapRootSize)),
+      id_(NewCacheId()),
+      handle_(std::make_shared<Handle>()) {
+  for (size_t i = 0; i < kSpanMapRootSize; ++i) {
+    span_map_[i] = nullptr;
+  }
+  handle_->cache_ = this;
+}
+
+SizeClassMemCache::~SizeClassMemCache() {
+  // The threads exiting later must not return their memory to this cache.
+  {
+    std::lock_guard<std::mutex> locker(handle_->lock_);
+    handle_->cache_ = nullptr;
+  }
+  // The arenas belong to the best fit pool which releases them, only the span map is freed here.
+  for (size_t i = 0; i < kSpanMapRootSize; ++i) {
+    delete span_map_[i].load();
+  }
+}
+
+DeviceMemPtr SizeClassMemCache::Alloc(size_t size) {
+  if (!IsSizeClassMem(size)) {
+    return nullptr;
+  }
+  auto size_class = SizeToClass(size);
+  auto &stat = stats_[size_class];
+  auto thread_cache = GetThreadCache();
+  auto &free_list = thread_cache->free_lists_[size_class];
+  if (free_list.empty()) {
+    if (!FetchFromCentral(size_class, thread_cache)) {
+      return nullptr;
+    }
+  } else {
+    (void)++stat.thread_cache_hit_count_;
+  }
+  auto device_addr = free_list.back();
+  free_list.pop_back();
+  thread_cache->cached_size_ -= ClassToSize(size_class);
+  (void)++stat.alloc_count_;
+  total_used_mem_size_ += ClassToSize(size_class);
+  return device_addr;
+}
+
+bool SizeClassMemCache::Free(const DeviceMemPtr &device_addr) {
+  auto span = FindSpan(device_addr);
+  if (span == nullptr) {
+    return false;
+  }
+  auto size_class = span->size_class_;
+  (void)++stats_[size_class].free_count_;
+  total_used_mem_size_ -= ClassToSize(size_class);
+  auto thread_cache = GetThreadCache();
+  auto &free_list = thread_cache->free_lists_[size_class];
+  free_list.emplace_back(device_addr);
+  thread_cache->cached_size_ += ClassToSize(size_class);
+  // Give back half of the size class to the central free list to bound the memory held by one thread.
+  auto max_count = ThreadCacheMaxCount(size_class);
+  if (free_list.size() > max_count) {
+    ReturnToCentral(size_class, thread_cache, free_list.size() - max_count / 2);
+  }
+  if (thread_cache->cached_size_ > kThreadCacheMaxSize) {
+    ShrinkThreadCache(thread_cache);
+  }
+  return true;
+}
+
+void SizeClassMemCache::Release() {
+  // The thread caches are owned by their threads, they drop the memory when they see the new epoch.
+  (void)++epoch_;
+  for (auto &central : central_free_lists_) {
+    std::lock_guard<std::mutex> locker(central.lock_);
+    central.partial_spans_.clear();
+  }
+  std::lock_guard<std::mutex> locker(span_lock_);
+  for (size_t i = 0; i < kSpanMapRootSize; ++i) {
+    auto leaf = span_map_[i].load();
+    if (leaf == nullptr) {
+      continue;
+    }
+    for (auto &span : *leaf) {
+      span = nullptr;
+    }
+  }
+  idle_spans_.clear();
+  for (auto &arena : arenas_) {
+    free_func_(arena->addr_);
+  }
+  arenas_.clear();
+  for (auto &stat : stats_) {
+    stat.span_count_ = 0;
+  }
+  total_mem_size_ = 0;
+  total_used_mem_size_ = 0;
+}
+
+SizeClassMemCache::ThreadCache *SizeClassMemCache::GetThreadCache() {
+  thread_local ThreadCacheSet thread_cache_set;
+  auto thread_cache = thread_cache_set.Get(this);
+  size_t epoch = epoch_;
+  if (thread_cache->epoch_ != epoch) {
+    for (auto &free_list : thread_cache->free_lists_) {
+      free_list.clear();
+    }
+    thread_cache->cached_size_ = 0;
+    thread_cache->epoch_ = epoch;
+  }
+  return thread_cache;
+}
+
+void SizeClassMemCache::FlushThreadCache(ThreadCache *thread_cache) {
+  MS_EXCEPTION_IF_NULL(thread_cache);
+  if (thread_cache->epoch_ != epoch_) {
+    return;
+  }
+  for (size_t size_class = 0; size_class < kSizeClassNum; ++size_class) {
+    ReturnToCentral(size_class, thread_cache, thread_cache->free_lists_[size_class].size());
+  }
+}
+
+void SizeClassMemCache::ShrinkThreadCache(ThreadCache *thread_cache) {
+  MS_EXCEPTION_IF_NULL(thread_cache);
+  for (size_t size_class = 0; size_class < kSizeClassNum; ++size_class) {
+    auto count = thread_cache->free_lists_[size_class].size();
+    ReturnToCentral(size_class, thread_cache, count - count / 2);
+  }
+}
+
+bool SizeClassMemCache::FetchFromCentral(size_t size_class, ThreadCache *thread_cache) {
+  MS_EXCEPTION_IF_NULL(thread_cache);
+  auto &central = central_free_lists_[size_class];
+  auto &free_list = thread_cache->free_lists_[size_class];
+  std::lock_guard<std::mutex> locker(central.lock_);
+  if (central.partial_spans_.empty() && !CarveSpan(size_class, &central)) {
+    return false;
+  }
+  // Fill half of the thread cache from the spans having free memory.
+  auto count = std::max<size_t>(ThreadCacheMaxCount(size_class) / 2, 1);
+  while (count > 0 && !central.partial_spans_.empty()) {
+    auto span = central.partial_spans_.back();
+    auto fetch_count = std::min(count, span->free_list_.size());
+    auto begin = span->free_list_.end() - SizeToLong(fetch_count);
+    (void)free_list.insert(free_list.end(), begin, span->free_list_.end());
+    (void)span->free_list_.erase(begin, span->free_list_.end());
+    thread_cache->cached_size_ += fetch_count * ClassToSize(size_class);
+    count -= fetch_count;
+    if (span->free_list_.empty()) {
+      central.partial_spans_.pop_back();
+      span->partial_index_ = kNotPartial;
+    }
+  }
+  return true;
+}
+
+void SizeClassMemCache::ReturnToCentral(size_t size_class, ThreadCache *thread_cache, size_t count) {
+  MS_EXCEPTION_IF_NULL(thread_cache);
+  auto &free_list = thread_cache->free_lists_[size_class];
+  count = std::min(count, free_list.size());
+  if (count == 0) {
+    return;
+  }
+  auto &central = central_free_lists_[size_class];
+  auto begin = free_list.end() - SizeToLong(count);
+  {
+    std::lock_guard<std::mutex> locker(central.lock_);
+    for (auto iter = begin; iter != free_list.end(); ++iter) {
+      auto span = FindSpan(*iter);
+      MS_EXCEPTION_IF_NULL(span);
+      if (span->partial_index_ == kNotPartial) {
+        span->partial_index_ = central.partial_spans_.size();
+        central.partial_spans_.emplace_back(span);
+      }
+      span->free_list_.emplace_back(*iter);
+      if (span->free_list_.size() == span->object_num_) {
+        ReleaseSpan(span, &central);
+      }
+    }
+  }
+  (void)free_list.erase(begin, free_list.end());
+  thread_cache->cached_size_ -= count * ClassToSize(size_class);
+}
+
+bool SizeClassMemCache::CarveSpan(size_t size_class, CentralFreeList *central) {
+  MS_EXCEPTION_IF_NULL(central);
+  std::lock_guard<std::mutex> locker(span_lock_);
+  auto span = NewSpan();
+  if (span == nullptr) {
+    return false;
+  }
+  if (!RegisterSpan(span->addr_, span)) {
+    idle_spans_.emplace_back(span);
+    return false;
+  }
+  ++span->arena_->used_span_num_;
+  span->size_class_ = size_class;
+  auto object_size = ClassToSize(size_class);
+  span->object_num_ = kSizeClassSpanSize / object_size;
+  span->free_list_.reserve(span->object_num_);
+  // Push in reverse order so that the memory is handed out from the low address.
+  for (size_t i = span->object_num_; i > 0; --i) {
+    span->free_list_.emplace_back(AddressOffset(span->addr_, (i - 1) * object_size));
+  }
+  span->partial_index_ = central->partial_spans_.size();
+  central->partial_spans_.emplace_back(span);
+  (void)++stats_[size_class].span_count_;
+  return true;
+}
+
+void SizeClassMemCache::ReleaseSpan(Span *span, CentralFreeList *central) {
+  MS_EXCEPTION_IF_NULL(span);
+  MS_EXCEPTION_IF_NULL(central);
+  auto &partial_spans = central->partial_spans_;
+  partial_spans[span->partial_index_] = partial_spans.back();
+  partial_spans[span->partial_index_]->partial_index_ = span->partial_index_;
+  partial_spans.pop_back();
+  span->partial_index_ = kNotPartial;
+  std::vector<DeviceMemPtr>().swap(span->free_list_);
+  (void)--stats_[span->size_class_].span_count_;
+
+  std::lock_guard<std::mutex> locker(span_lock_);
+  (void)RegisterSpan(span->addr_, nullptr);
+  idle_spans_.emplace_back(span);
+  auto arena = span->arena_;
+  --arena->used_span_num_;
+  // Keep the last arena, so the memory freed and allocated in turn does not allocate the arena again and again.
+  if (arena->used_span_num_ != 0 || arenas_.size() == 1) {
+    return;
+  }
+  (void)idle_spans_.erase(std::remove_if(idle_spans_.begin(), idle_spans_.end(),
+                                         [arena](const Span *idle_span) { return idle_span->arena_ == arena; }),
+                          idle_spans_.end());
+  free_func_(arena->addr_);
+  total_mem_size_ -= kArenaSize;
+  (void)arenas_.erase(std::find_if(arenas_.begin(), arenas_.end(),
+                                   [arena](const std::unique_ptr<Arena> &item) { return item.get() == arena; }));
+}
+
+SizeClassMemCache::Span *SizeClassMemCache::NewSpan() {
+  if (idle_spans_.empty()) {
+    if (total_mem_size_ + kArenaSize > max_cache_mem_size_) {
+      MS_LOG(DEBUG) << "The size class memory cache reaches the max size " << max_cache_mem_size_;
+      return nullptr;
+    }
+    auto arena_addr = alloc_func_(kArenaSize);
+    if (arena_addr == nullptr) {
+      return nullptr;
+    }
+    auto arena = std::make_unique<Arena>();
+    arena->addr_ = arena_addr;
+    // Align the spans by the span size, so the span can be found by the address in the span map.
+    auto span_addr = (reinterpret_cast<uintptr_t>(arena_addr) + kSizeClassSpanSize - 1) & ~(kSizeClassSpanSize - 1);
+    // Push in reverse order so that the spans are handed out from the low address.
+    for (size_t i = kSizeClassSpanNumPerArena; i > 0; --i) {
+      auto &span = arena->spans_[i - 1];
+      span.addr_ = reinterpret_cast<DeviceMemPtr>(span_addr + (i - 1) * kSizeClassSpanSize);
+      span.arena_ = arena.get();
+      idle_spans_.emplace_back(&span);
+    }
+    arenas_.emplace_back(std::move(arena));
+    total_mem_size_ += kArenaSize;
+  }
+  auto span = idle_spans_.back();
+  idle_spans_.pop_back();
+  return span;
+}
+
+bool SizeClassMemCache::RegisterSpan(const DeviceMemPtr &span_addr, Span *span) {
+  auto span_index = reinterpret_cast<uintptr_t>(span_addr) >> kSizeClassSpanShift;
+  auto root_index = span_index >> kSpanMapLeafBits;
+  if (root_index >= kSpanMapRootSize) {
+    MS_LOG(WARNING) << "The address " << span_addr << " is out of the range of size class memory cache.";
+    return false;
+  }
+  auto leaf = span_map_[root_index].load();
+  if (leaf == nullptr) {
+    leaf = new (std::nothrow) SpanMapLeaf();
+    if (leaf == nullptr) {
+      return false;
+    }
+    for (auto &item : *leaf) {
+      item = nullptr;
+    }
+    span_map_[root_index] = leaf;
+  }
+  (*leaf)[span_index & (kSpanMapLeafSize - 1)] = span;
+  return true;
+}
+
+SizeClassMemCache::Span *SizeClassMemCache::FindSpan(const DeviceMemPtr &device_addr) const {
+  auto span_index = reinterpret_cast<uintptr_t>(device_addr) >> kSizeClassSpanShift;
+  auto root_index = span_index >> kSpanMapLeafBits;
+  if (root_index >= kSpanMapRootSize) {
+    return nullptr;
+  }
+  auto leaf = span_map_[root_index].load();
+  if (leaf == nullptr) {
+    return nullptr;
+  }
+  return (*leaf)[span_index & (kSpanMapLeafSize - 1)].load();
+}
+
+void SizeClassMemCache::DumpSizeClassMemStateInfo() const {
+  std::ostringstream buf;
+  for (size_t i = 0; i < kSizeClassNum; ++i) {
+    const auto &stat = stats_[i];
+    if (stat.alloc_count_ == 0) {
+      continue;
+    }
+    buf << ", class[" << ClassToSize(i) << "] alloc:" << stat.alloc_count_ << " free:" << stat.free_count_
+        << " thread cache hit:" << stat.thread_cache_hit_count_ << " span:" << stat.span_count_;
+  }
+  MS_LOG(INFO) << "Size class mem cache info: total mem " << total_mem_size_ << ", in used mem "
+               << total_used_mem_size_ << buf.str();
+}
+}  // namespace device
+}  // namespace mindspore
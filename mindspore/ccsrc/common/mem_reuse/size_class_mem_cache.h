@@ -0,0 +1,185 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_COMMON_MEM_REUSE_SIZE_CLASS_MEM_CACHE_H_
+#define MINDSPORE_CCSRC_COMMON_MEM_REUSE_SIZE_CLASS_MEM_CACHE_H_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "utils/ms_utils.h"
+
+namespace mindspore {
+namespace device {
+using DeviceMemPtr = void(*);
+
+// The granularity of size class, which is the same as the align size of dynamic memory pool.
+constexpr size_t kSizeClassAlignSize = 512;
+// The memory whose size is bigger than this size is allocated from the best fit pool directly.
+constexpr size_t kMaxSizeClassMemSize = 64 << 10;
+constexpr size_t kSizeClassNum = kMaxSizeClassMemSize / kSizeClassAlignSize;
+// The span is the unit carved into memory of one size class, all spans are aligned by the span size.
+constexpr size_t kSizeClassSpanShift = 20;
+constexpr size_t kSizeClassSpanSize = static_cast<size_t>(1) << kSizeClassSpanShift;
+// The arena is the unit allocated from the best fit pool and carved into spans.
+constexpr size_t kSizeClassSpanNumPerArena = 32;
+// The thread cache keeps at most kThreadCacheMaxCount memory and kThreadCacheMaxClassSize bytes of one size class, and
+// kThreadCacheMaxSize bytes of all the size classes.
+constexpr size_t kThreadCacheMaxCount = 64;
+constexpr size_t kThreadCacheMaxClassSize = 256 << 10;
+constexpr size_t kThreadCacheMaxSize = 4 << 20;
+
+// The allocation statistics of one size class.
+struct SizeClassStat {
+  std::atomic<size_t> alloc_count_{0};
+  std::atomic<size_t> free_count_{0};
+  // The allocation served by the thread cache without any shared lock.
+  std::atomic<size_t> thread_cache_hit_count_{0};
+  // The spans in use by the size class, the idle spans are given back.
+  std::atomic<size_t> span_count_{0};
+};
+
+// Size-class slab layer with per-thread caches in front of the best fit memory pool. The small memory is carved from
+// spans of the arenas allocated from the best fit pool. A span is given back once all its memory is returned to the
+// central free list, and can be carved for another size class, and an arena whose spans are all idle is freed to the
+// best fit pool.
+class SizeClassMemCache {
+ public:
+  // The function to alloc the arena memory from the best fit pool and free it back.
+  using ArenaAllocFunc = std::function<DeviceMemPtr(size_t)>;
+  using ArenaFreeFunc = std::function<void(const DeviceMemPtr &)>;
+
+  SizeClassMemCache(ArenaAllocFunc alloc_func, ArenaFreeFunc free_func, size_t max_cache_mem_size);
+  ~SizeClassMemCache();
+
+  // Whether the size is served by the size class cache.
+  static bool IsSizeClassMem(size_t size) { return size != 0 && size <= kMaxSizeClassMemSize; }
+
+  // Return nullptr when the memory can not be served by the cache and should be allocated from the best fit pool.
+  DeviceMemPtr Alloc(size_t size);
+  // Return false when the device address is not allocated by the cache.
+  bool Free(const DeviceMemPtr &device_addr);
+  // Return all the arenas to the best fit pool, the memory allocated by the cache must not be used any more.
+  void Release();
+
+  // The statistics information.
+  size_t TotalMemStatistics() const { return total_mem_size_; }
+  size_t TotalUsedMemStatistics() const { return total_used_mem_size_; }
+  const SizeClassStat &SizeClassStatistics(size_t size_class) const { return stats_[size_class]; }
+  void DumpSizeClassMemStateInfo() const;
+
+ private:
+  struct Arena;
+  struct Span {
+    size_t size_class_{0};
+    DeviceMemPtr addr_{nullptr};
+    Arena *arena_{nullptr};
+    size_t object_num_{0};
+    // The free memory of the span in the central free list, the memory in the thread caches is in use for the span.
+    std::vector<DeviceMemPtr> free_list_;
+    // The position in the partial spans of the central free list, kNotPartial if it has no free memory.
+    size_t partial_index_{kNotPartial};
+  };
+  struct Arena {
+    DeviceMemPtr addr_{nullptr};
+    size_t used_span_num_{0};
+    std::array<Span, kSizeClassSpanNumPerArena> spans_;
+  };
+
+  // The memory cached by one thread, which is only accessed by the thread. The memory cached before the last
+  // Release is dropped when the epoch is changed.
+  struct ThreadCache {
+    size_t epoch_{0};
+    size_t cached_size_{0};
+    std::array<std::vector<DeviceMemPtr>, kSizeClassNum> free_lists_;
+  };
+  // The handle kept by the threads to return their cached memory when they exit, which outlives the cache.
+  struct Handle {
+    std::mutex lock_;
+    SizeClassMemCache *cache_{nullptr};
+  };
+  // The thread caches of one thread for all the size class caches, defined in the source file.
+  class ThreadCacheSet;
+
+  // The central free list of one size class, made of the spans having free memory.
+  struct CentralFreeList {
+    std::mutex lock_;
+    std::vector<Span *> partial_spans_;
+  };
+
+  // The two-level radix tree from the span index of address to span.
+  static constexpr size_t kNotPartial = SIZE_MAX;
+  static constexpr size_t kSpanMapLeafBits = 14;
+  static constexpr size_t kSpanMapLeafSize = static_cast<size_t>(1) << kSpanMapLeafBits;
+  static constexpr size_t kSpanMapRootBits = 48 - kSizeClassSpanShift - kSpanMapLeafBits;
+  static constexpr size_t kSpanMapRootSize = static_cast<size_t>(1) << kSpanMapRootBits;
+  using SpanMapLeaf = std::array<std::atomic<Span *>, kSpanMapLeafSize>;
+
+  static size_t SizeToClass(size_t size) { return (size - 1) / kSizeClassAlignSize; }
+  static size_t ClassToSize(size_t size_class) { return (size_class + 1) * kSizeClassAlignSize; }
+
+  static size_t ThreadCacheMaxCount(size_t size_class) {
+    return std::max<size_t>(std::min(kThreadCacheMaxCount, kThreadCacheMaxClassSize / ClassToSize(size_class)), 1);
+  }
+
+  ThreadCache *GetThreadCache();
+  // Return all the memory of the thread cache to the central free lists, called when the thread exits.
+  void FlushThreadCache(ThreadCache *thread_cache);
+  // Fetch a batch of memory from the central free list, carve a new span if the central free list is empty.
+  bool FetchFromCentral(size_t size_class, ThreadCache *thread_cache);
+  // Return the last count memory of the size class in the thread cache to the central free list.
+  void ReturnToCentral(size_t size_class, ThreadCache *thread_cache, size_t count);
+  // Return half of the memory of each size class when the thread cache holds more than kThreadCacheMaxSize bytes.
+  void ShrinkThreadCache(ThreadCache *thread_cache);
+  // Carve a new span into the central free list, must be called with the lock of central free list.
+  bool CarveSpan(size_t size_class, CentralFreeList *central);
+  // Give back the span whose memory is all free, must be called with the lock of central free list.
+  void ReleaseSpan(Span *span, CentralFreeList *central);
+  Span *NewSpan();
+  Span *FindSpan(const DeviceMemPtr &device_addr) const;
+  bool RegisterSpan(const DeviceMemPtr &span_addr, Span *span);
+
+  ArenaAllocFunc alloc_func_;
+  ArenaFreeFunc free_func_;
+  size_t max_cache_mem_size_;
+
+  // Protect the arenas, the idle spans and the span map.
+  std::mutex span_lock_;
+  std::vector<std::unique_ptr<Arena>> arenas_;
+  std::vector<Span *> idle_spans_;
+  std::unique_ptr<std::atomic<SpanMapLeaf *>[]> span_map_;
+
+  std::array<CentralFreeList, kSizeClassNum> central_free_lists_;
+  // The unique id of the cache to find its thread cache, which is not reused by the caches created later.
+  size_t id_;
+  std::shared_ptr<Handle> handle_;
+  std::atomic<size_t> epoch_{0};
+  std::array<SizeClassStat, kSizeClassNum> stats_;
+
+  std::atomic<size_t> total_mem_size_{0};
+  std::atomic<size_t> total_used_mem_size_{0};
+
+  DISABLE_COPY_AND_ASSIGN(SizeClassMemCache);
+};
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_COMMON_MEM_REUSE_SIZE_CLASS_MEM_CACHE_H_
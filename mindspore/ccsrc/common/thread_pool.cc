@@ -1,5 +1,5 @@
 /**
- * Copyright 2020 Huawei Technologies Co., Ltd
+ * Copyright 2020-2022 Huawei Technologies Co., Ltd
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -17,9 +17,16 @@
 #include "include/common/thread_pool.h"
 #include <algorithm>
 #include <exception>
+#include <limits>
 #include "utils/log_adapter.h"
 #include "utils/convert_utils_base.h"
 #include "utils/ms_exception.h"
+#ifndef _WIN32
+#if defined(__x86_64__) || defined(__amd64__) || defined(_M_IX86) || defined(_M_X64)
+#define PLATFORM_86
+#include <pmmintrin.h>
+#endif
+#endif
 
 namespace mindspore {
 namespace common {
@@ -28,6 +35,13 @@ constexpr size_t kDeviceNum = 8;
 #endif
 constexpr size_t kMaxThreadNum = 23;
 constexpr size_t kYieldThreshold = 1000;
+constexpr size_t kNotPoolThread = std::numeric_limits<size_t>::max();
+constexpr size_t kNoTask = std::numeric_limits<size_t>::max();
+
+namespace {
+// the index of the queue owned by the current thread, kNotPoolThread for the threads outside the pool.
+thread_local size_t current_queue_index = kNotPoolThread;
+}  // namespace
 
 ThreadPool::ThreadPool() {
   size_t process_core_num = std::thread::hardware_concurrency() - 1;
@@ -45,42 +59,141 @@ ThreadPool::ThreadPool() {
   if (max_thread_num_ > kMaxThreadNum) {
     max_thread_num_ = kMaxThreadNum;
   }
+  for (size_t i = 0; i < max_thread_num_; ++i) {
+    (void)queues_.emplace_back(std::make_unique<WorkQueue>());
+  }
 }
 
-void ThreadPool::SyncRunLoop(const std::shared_ptr<ThreadContext> &context) {
-  if (context == nullptr) {
+void ThreadPool::StartThreads() {
+  if (started_.load(std::memory_order_acquire)) {
     return;
   }
+  std::lock_guard<std::mutex> lock(pool_mtx_);
+  if (started_) {
+    return;
+  }
+  exit_run_ = false;
+  for (size_t i = 0; i < max_thread_num_; ++i) {
+    (void)sync_run_threads_.emplace_back(std::thread(&ThreadPool::SyncRunLoop, this, i));
+  }
+  started_.store(true, std::memory_order_release);
+}
+
+void ThreadPool::SyncRunLoop(size_t index) {
+#ifdef PLATFORM_86
+  // Some CPU kernels need set the flush zero mode to improve performance.
+  _MM_SET_FLUSH_ZERO_MODE(_MM_FLUSH_ZERO_ON);
+  _MM_SET_DENORMALS_ZERO_MODE(_MM_DENORMALS_ZERO_ON);
+#endif
+  current_queue_index = index;
   size_t yield_count = 0;
-  while (true) {
-    if (exit_run_) {
-      return;
+  while (!exit_run_) {
+    if (RunOneJob()) {
+      yield_count = 0;
+      continue;
     }
+    ++yield_count;
+    if (yield_count <= kYieldThreshold) {
+      std::this_thread::yield();
+      continue;
+    }
+    yield_count = 0;
+    std::unique_lock<std::mutex> lock(sleep_mtx_);
+    ++sleeping_thread_num_;
+    sleep_cond_.wait(lock, [this] { return pending_job_num_ > 0 || exit_run_; });
+    --sleeping_thread_num_;
+  }
+}
 
-    if (!context->task) {
-      ++yield_count;
-      if (yield_count > kYieldThreshold) {
-        yield_count = 0;
-        std::unique_lock<std::mutex> lock(context->mutex);
-        context->cond_var.wait(lock, [&context, this] { return context->task != nullptr || exit_run_; });
-      } else {
-        std::this_thread::yield();
-        continue;
+void ThreadPool::PushJob(std::function<void()> &&job) {
+  size_t index = current_queue_index;
+  if (index == kNotPoolThread) {
+    index = next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+  }
+  {
+    std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+    queues_[index]->jobs.push_back(std::move(job));
+  }
+  // pairs with the sleeping thread, which checks pending_job_num_ after increasing sleeping_thread_num_.
+  ++pending_job_num_;
+  if (sleeping_thread_num_ > 0) {
+    std::lock_guard<std::mutex> lock(sleep_mtx_);
+    sleep_cond_.notify_one();
+  }
+}
+
+bool ThreadPool::RunOneJob() {
+  if (pending_job_num_ == 0) {
+    return false;
+  }
+  std::function<void()> job;
+  size_t self = current_queue_index;
+  if (self != kNotPoolThread) {
+    std::lock_guard<std::mutex> lock(queues_[self]->mutex);
+    if (!queues_[self]->jobs.empty()) {
+      job = std::move(queues_[self]->jobs.back());
+      queues_[self]->jobs.pop_back();
+    }
+  }
+  if (!job) {
+    size_t queue_num = queues_.size();
+    size_t start = (self == kNotPoolThread) ? next_queue_.load(std::memory_order_relaxed) : self + 1;
+    for (size_t i = 0; i < queue_num && !job; ++i) {
+      auto &queue = queues_[(start + i) % queue_num];
+      std::lock_guard<std::mutex> lock(queue->mutex);
+      if (!queue->jobs.empty()) {
+        job = std::move(queue->jobs.front());
+        queue->jobs.pop_front();
       }
     }
+  }
+  if (!job) {
+    return false;
+  }
+  --pending_job_num_;
+  job();
+  return true;
+}
 
-    if (exit_run_) {
-      return;
+void ThreadPool::Wait(const TaskGroup &group) {
+  // help the pool instead of blocking, the jobs of this group may be queued behind the current thread. When there is
+  // nothing to run for a while, sleep until the group finishes or a job is pushed.
+  size_t yield_count = 0;
+  while (group.pending > 0) {
+    if (RunOneJob()) {
+      yield_count = 0;
+      continue;
     }
-
-    try {
-      auto &task = *(context->task);
-      task();
-    } catch (std::exception &e) {
-      MsException::Instance().SetException();
+    ++yield_count;
+    if (yield_count <= kYieldThreshold) {
+      std::this_thread::yield();
+      continue;
     }
     yield_count = 0;
-    context->task = nullptr;
+    std::unique_lock<std::mutex> lock(sleep_mtx_);
+    ++sleeping_thread_num_;
+    sleep_cond_.wait(lock, [this, &group] { return group.pending == 0 || pending_job_num_ > 0; });
+    --sleeping_thread_num_;
+  }
+}
+
+void ThreadPool::FinishJob(TaskGroup *group) {
+  // the group may be destroyed by its waiter once pending is 0, so it is not touched after the decrease. Pairs with the
+  // waiter, which checks pending after increasing sleeping_thread_num_.
+  if (group->pending.fetch_sub(1) == 1 && sleeping_thread_num_ > 0) {
+    std::lock_guard<std::mutex> lock(sleep_mtx_);
+    sleep_cond_.notify_all();
+  }
+}
+
+void ThreadPool::RunTask(const Task &task, TaskGroup *group) const {
+  try {
+    if (task() != SUCCESS) {
+      group->failed = true;
+    }
+  } catch (std::exception &e) {
+    MsException::Instance().SetException();
+    group->failed = true;
   }
 }
 
@@ -92,50 +205,132 @@ bool ThreadPool::SyncRun(const std::vector<Task> &tasks) {
     auto ret = tasks[0]();
     return ret == SUCCESS;
   }
-  std::unique_lock<std::mutex> lock(pool_mtx_);
-  exit_run_ = false;
+  StartThreads();
+  TaskGroup group(tasks.size());
+  for (size_t i = 1; i < tasks.size(); ++i) {
+    PushJob([this, &task = tasks[i], &group]() {
+      RunTask(task, &group);
+      FinishJob(&group);
+    });
+  }
+  RunTask(tasks[0], &group);
+  FinishJob(&group);
+  Wait(group);
+  return !group.failed;
+}
+
+bool ThreadPool::ParallelFor(size_t count, size_t grain, const RangeTask &task) {
+  if (count == 0) {
+    return true;
+  }
+  grain = std::max<size_t>(grain, 1);
+  size_t block_num = (count + grain - 1) / grain;
+  if (block_num == 1) {
+    return task(0, count) == SUCCESS;
+  }
+  StartThreads();
+  // the current thread and at most max_thread_num_ threads of the pool claim the blocks.
+  size_t claimer_num = std::min(block_num, max_thread_num_ + 1);
+  std::atomic_size_t next_block{0};
+  TaskGroup group(claimer_num);
+  auto claim_blocks = [this, &task, &next_block, &group, block_num, grain, count]() {
+    for (size_t block = next_block++; block < block_num && !group.failed; block = next_block++) {
+      size_t start = block * grain;
+      size_t end = std::min(start + grain, count);
+      try {
+        if (task(start, end) != SUCCESS) {
+          group.failed = true;
+        }
+      } catch (std::exception &e) {
+        MsException::Instance().SetException();
+        group.failed = true;
+      }
+    }
+    FinishJob(&group);
+  };
+  for (size_t i = 1; i < claimer_num; ++i) {
+    PushJob(claim_blocks);
+  }
+  claim_blocks();
+  Wait(group);
+  return !group.failed;
+}
+
+bool ThreadPool::SyncRunGraph(const std::vector<Task> &tasks, const std::vector<std::vector<size_t>> &depends) {
+  if (tasks.size() != depends.size()) {
+    MS_LOG(ERROR) << "The number of tasks " << tasks.size() << " is not equal to the number of dependencies "
+                  << depends.size();
+    return false;
+  }
   size_t task_num = tasks.size();
-  size_t thread_num = sync_run_threads_.size();
-  if (thread_num < max_thread_num_ && thread_num < task_num) {
-    auto new_thread_num = max_thread_num_;
-    if (task_num < max_thread_num_) {
-      new_thread_num = task_num;
+  std::vector<std::vector<size_t>> successors(task_num);
+  auto in_degrees = std::make_unique<std::atomic_size_t[]>(task_num);
+  for (size_t i = 0; i < task_num; ++i) {
+    in_degrees[i] = depends[i].size();
+    for (auto depend : depends[i]) {
+      if (depend >= task_num || depend == i) {
+        MS_LOG(ERROR) << "Task " << i << " has an invalid dependency " << depend;
+        return false;
+      }
+      (void)successors[depend].emplace_back(i);
+    }
+  }
+  // reject the cycles before running anything, otherwise the tasks on the cycle never start.
+  std::vector<size_t> ready;
+  std::vector<size_t> remain_degrees(task_num);
+  for (size_t i = 0; i < task_num; ++i) {
+    remain_degrees[i] = depends[i].size();
+    if (remain_degrees[i] == 0) {
+      ready.push_back(i);
     }
-    contexts_.resize(new_thread_num);
-    for (size_t i = thread_num; i < new_thread_num; ++i) {
-      contexts_[i] = std::make_shared<ThreadContext>();
-      sync_run_threads_.emplace_back(std::thread(&ThreadPool::SyncRunLoop, this, contexts_[i]));
+  }
+  std::vector<size_t> roots = ready;
+  size_t sorted_num = 0;
+  while (!ready.empty()) {
+    auto current = ready.back();
+    ready.pop_back();
+    ++sorted_num;
+    for (auto successor : successors[current]) {
+      if (--remain_degrees[successor] == 0) {
+        ready.push_back(successor);
+      }
     }
   }
-  if (contexts_.empty()) {
+  if (sorted_num != task_num) {
+    MS_LOG(ERROR) << "The dependencies of the tasks have a cycle.";
+    return false;
+  }
+  if (task_num == 0) {
     return true;
   }
-  size_t used_thread_num = contexts_.size();
-  if (task_num < used_thread_num) {
-    used_thread_num = task_num;
-  }
-  bool running = true;
-  size_t task_index = 0;
-  while (running) {
-    running = false;
-    for (size_t i = 0; i < used_thread_num; ++i) {
-      MS_EXCEPTION_IF_NULL(contexts_[i]);
-      auto &task_run = contexts_[i]->task;
-      if (task_run) {
-        running = true;
-      } else if (task_index < task_num) {
-        std::lock_guard<std::mutex> task_lock(contexts_[i]->mutex);
-        contexts_[i]->task = &(tasks[task_index]);
-        contexts_[i]->cond_var.notify_one();
-        running = true;
-        ++task_index;
+
+  StartThreads();
+  TaskGroup group(task_num);
+  std::function<void(size_t)> run_node = [this, &tasks, &successors, &in_degrees, &group, &run_node](size_t index) {
+    while (index != kNoTask) {
+      if (!group.failed) {
+        RunTask(tasks[index], &group);
       }
+      // the successors ready now are queued, the last one is run by the current thread to save a hand-over.
+      size_t next = kNoTask;
+      for (auto successor : successors[index]) {
+        if (in_degrees[successor].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+          if (next != kNoTask) {
+            PushJob([&run_node, next]() { run_node(next); });
+          }
+          next = successor;
+        }
+      }
+      FinishJob(&group);
+      index = next;
     }
-    if (running) {
-      std::this_thread::yield();
-    }
+  };
+  for (size_t i = 1; i < roots.size(); ++i) {
+    PushJob([&run_node, root = roots[i]]() { run_node(root); });
   }
-  return true;
+  run_node(roots[0]);
+  Wait(group);
+  return !group.failed;
 }
 
 ThreadPool &ThreadPool::GetInstance() {
@@ -145,13 +340,13 @@ ThreadPool &ThreadPool::GetInstance() {
 
 void ThreadPool::ClearThreadPool() {
   std::lock_guard<std::mutex> sync_run_lock(pool_mtx_);
-  if (exit_run_) {
+  if (!started_) {
     return;
   }
-  exit_run_ = true;
-  for (auto &context : contexts_) {
-    MS_EXCEPTION_IF_NULL(context);
-    context->cond_var.notify_one();
+  {
+    std::lock_guard<std::mutex> lock(sleep_mtx_);
+    exit_run_ = true;
+    sleep_cond_.notify_all();
   }
   for (auto &it : sync_run_threads_) {
     if (it.joinable()) {
@@ -159,6 +354,24 @@ void ThreadPool::ClearThreadPool() {
     }
   }
   sync_run_threads_.clear();
+  started_ = false;
+}
+
+void ThreadPool::SetMaxThreadNum(size_t thread_num) {
+  thread_num = std::max<size_t>(thread_num, 1);
+  if (thread_num == max_thread_num_) {
+    return;
+  }
+  ClearThreadPool();
+  std::lock_guard<std::mutex> lock(pool_mtx_);
+  max_thread_num_ = thread_num;
+  queues_.resize(max_thread_num_);
+  for (auto &queue : queues_) {
+    if (queue == nullptr) {
+      queue = std::make_unique<WorkQueue>();
+    }
+  }
+  MS_LOG(INFO) << "The thread number of the common thread pool is set to " << max_thread_num_;
 }
 
 ThreadPool::~ThreadPool() {
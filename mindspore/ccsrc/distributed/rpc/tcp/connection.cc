@@ -115,12 +115,15 @@ Connection::Connection()
       send_event_loop(nullptr),
       recv_event_loop(nullptr),
       send_metrics(nullptr),
-      send_message(nullptr),
+      send_messages{nullptr},
+      send_message_num(0),
       recv_message(nullptr),
+      flush_pending(false),
       recv_state(kMsgHeader),
       total_recv_len(0),
       total_send_len(0),
       recv_len(0),
+      send_io_vec_num(0),
       event_callback(nullptr),
       succ_callback(nullptr),
       write_callback(nullptr),
@@ -136,15 +139,8 @@ Connection::Connection()
   recv_kernel_msg.msg_iov = recv_io_vec;
   recv_kernel_msg.msg_iovlen = RECV_MSG_IO_VEC_LEN;
 
-  // Initialize the send message header.
+  // The send message headers are initialized with the magic id by the constructor of MessageHeader.
   send_metrics = new SendMetrics();
-  for (unsigned int i = 0; i < BUSMAGIC_LEN; i++) {
-    if (i < sizeof(RPC_MAGICID) - 1) {
-      send_msg_header.magic[i] = RPC_MAGICID[i];
-    } else {
-      send_msg_header.magic[i] = '\0';
-    }
-  }
 
   // Initialize the send kernel message structure.
   send_kernel_msg.msg_control = nullptr;
@@ -153,7 +149,7 @@ Connection::Connection()
   send_kernel_msg.msg_name = nullptr;
   send_kernel_msg.msg_namelen = 0;
   send_kernel_msg.msg_iov = send_io_vec;
-  send_kernel_msg.msg_iovlen = SEND_MSG_IO_VEC_LEN;
+  send_kernel_msg.msg_iovlen = 0;
 }
 
 int Connection::Initialize() {
@@ -218,10 +214,12 @@ void Connection::Close() {
     }
   }
 
-  if (total_send_len != 0 && send_message != nullptr) {
-    delete send_message;
-    send_message = nullptr;
+  for (size_t i = 0; i < send_message_num; ++i) {
+    delete send_messages[i];
+    send_messages[i] = nullptr;
   }
+  send_message_num = 0;
+  total_send_len = 0;
 
   MessageBase *tmpMsg = nullptr;
   while (!send_message_queue.empty()) {
@@ -321,68 +319,87 @@ std::string Connection::GenerateHttpMessage(MessageBase *msg) {
   return postLine + userAgentLine + fromLine + connectLine + hostLine + commonEndLine;
 }
 
-void Connection::FillSendMessage(MessageBase *msg, const std::string &advertiseUrl, bool isHttpKmsg, int index) {
-  index = 0;
-  if (msg->type == MessageBase::Type::KMSG) {
-    if (!isHttpKmsg) {
-      send_to = msg->to;
-      send_from = msg->from.Name() + "@" + advertiseUrl;
-
-      send_msg_header.name_len = htonl(static_cast<uint32_t>(msg->name.size()));
-      send_msg_header.to_len = htonl(static_cast<uint32_t>(send_to.size()));
-      send_msg_header.from_len = htonl(static_cast<uint32_t>(send_from.size()));
-      send_msg_header.body_len = htonl(static_cast<uint32_t>(msg->body.size()));
-
-      send_io_vec[index].iov_base = &send_msg_header;
-      send_io_vec[index].iov_len = sizeof(send_msg_header);
-      ++index;
-      send_io_vec[index].iov_base = const_cast<char *>(msg->name.data());
-      send_io_vec[index].iov_len = msg->name.size();
-      ++index;
-      send_io_vec[index].iov_base = const_cast<char *>(send_to.data());
-      send_io_vec[index].iov_len = send_to.size();
-      ++index;
-      send_io_vec[index].iov_base = const_cast<char *>(send_from.data());
-      send_io_vec[index].iov_len = send_from.size();
-      ++index;
-      send_io_vec[index].iov_base = const_cast<char *>(msg->body.data());
-      send_io_vec[index].iov_len = msg->body.size();
-      ++index;
-      send_kernel_msg.msg_iov = send_io_vec;
-      send_kernel_msg.msg_iovlen = IntToSize(index);
-      total_send_len =
-        UlongToUint(sizeof(send_msg_header)) + msg->name.size() + send_to.size() + send_from.size() + msg->body.size();
-      send_message = msg;
-
-      // update metrics
-      send_metrics->UpdateMax(msg->body.size());
-      send_metrics->last_send_msg_name = msg->name;
-
-      return;
-    } else {
-      if (advertise_addr_.empty()) {
-        size_t index = advertiseUrl.find(URL_PROTOCOL_IP_SEPARATOR);
-        if (index == std::string::npos) {
-          advertise_addr_ = advertiseUrl;
-        } else {
-          advertise_addr_ = advertiseUrl.substr(index + sizeof(URL_PROTOCOL_IP_SEPARATOR) - 1);
-        }
+void Connection::FillSendMessage(MessageBase *msg, const std::string &advertiseUrl, bool isHttpKmsg) {
+  if (msg->type != MessageBase::Type::KMSG) {
+    MS_LOG(WARNING) << "Drop the message with invalid type " << static_cast<int>(msg->type) << ", name: " << msg->name;
+    delete msg;
+    return;
+  }
+  auto index = send_message_num;
+  auto io_vec_num = send_io_vec_num;
+  if (!isHttpKmsg) {
+    send_to[index] = msg->to;
+    send_from[index] = msg->from.Name() + "@" + advertiseUrl;
+
+    auto &header = send_msg_header[index];
+    header.name_len = htonl(static_cast<uint32_t>(msg->name.size()));
+    header.to_len = htonl(static_cast<uint32_t>(send_to[index].size()));
+    header.from_len = htonl(static_cast<uint32_t>(send_from[index].size()));
+    header.body_len = htonl(static_cast<uint32_t>(msg->body.size()));
+
+    send_io_vec[io_vec_num].iov_base = &header;
+    send_io_vec[io_vec_num].iov_len = sizeof(header);
+    ++io_vec_num;
+    send_io_vec[io_vec_num].iov_base = const_cast<char *>(msg->name.data());
+    send_io_vec[io_vec_num].iov_len = msg->name.size();
+    ++io_vec_num;
+    send_io_vec[io_vec_num].iov_base = const_cast<char *>(send_to[index].data());
+    send_io_vec[io_vec_num].iov_len = send_to[index].size();
+    ++io_vec_num;
+    send_io_vec[io_vec_num].iov_base = const_cast<char *>(send_from[index].data());
+    send_io_vec[io_vec_num].iov_len = send_from[index].size();
+    ++io_vec_num;
+    send_io_vec[io_vec_num].iov_base = const_cast<char *>(msg->body.data());
+    send_io_vec[io_vec_num].iov_len = msg->body.size();
+    ++io_vec_num;
+    total_send_len += UlongToUint(sizeof(header)) + msg->name.size() + send_to[index].size() +
+                      send_from[index].size() + msg->body.size();
+  } else {
+    if (advertise_addr_.empty()) {
+      size_t pos = advertiseUrl.find(URL_PROTOCOL_IP_SEPARATOR);
+      if (pos == std::string::npos) {
+        advertise_addr_ = advertiseUrl;
+      } else {
+        advertise_addr_ = advertiseUrl.substr(pos + sizeof(URL_PROTOCOL_IP_SEPARATOR) - 1);
       }
-      msg->body = GenerateHttpMessage(msg);
     }
+    msg->body = GenerateHttpMessage(msg);
 
-    send_io_vec[index].iov_base = const_cast<char *>(msg->body.data());
-    send_io_vec[index].iov_len = msg->body.size();
-    ++index;
-    send_kernel_msg.msg_iov = send_io_vec;
-    send_kernel_msg.msg_iovlen = IntToSize(index);
-    total_send_len = UlongToUint(msg->body.size());
-    send_message = msg;
+    send_io_vec[io_vec_num].iov_base = const_cast<char *>(msg->body.data());
+    send_io_vec[io_vec_num].iov_len = msg->body.size();
+    ++io_vec_num;
+    total_send_len += UlongToUint(msg->body.size());
+  }
+  send_io_vec_num = io_vec_num;
+  send_messages[send_message_num++] = msg;
+  send_kernel_msg.msg_iov = send_io_vec;
+  send_kernel_msg.msg_iovlen = send_io_vec_num;
+
+  // update metrics
+  send_metrics->UpdateMax(msg->body.size());
+  send_metrics->last_send_msg_name = msg->name;
+}
+
+void Connection::FillSendMessages(const std::string &advertiseUrl) {
+  send_message_num = 0;
+  send_io_vec_num = 0;
+  total_send_len = 0;
+  while (!send_message_queue.empty() && send_message_num < SEND_MSG_BATCH_SIZE &&
+         total_send_len < SEND_MSG_BATCH_BYTES) {
+    auto msg = send_message_queue.front();
+    send_message_queue.pop();
+    FillSendMessage(msg, advertiseUrl, false);
+  }
+}
 
-    // update metrics
-    send_metrics->UpdateMax(msg->body.size());
-    send_metrics->last_send_msg_name = msg->name;
+void Connection::ReleaseSendMessages() {
+  for (size_t i = 0; i < send_message_num; ++i) {
+    output_buffer_size -= send_messages[i]->body.size();
+    delete send_messages[i];
+    send_messages[i] = nullptr;
   }
+  send_message_num = 0;
+  send_io_vec_num = 0;
 }
 
 void Connection::FillRecvMessage() {
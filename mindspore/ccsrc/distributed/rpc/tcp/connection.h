@@ -121,8 +121,14 @@ struct Connection {
   int ReceiveMessage();
   void CheckMessageType();
 
-  // Fill the message to be sent based on the input message.
-  void FillSendMessage(MessageBase *msg, const std::string &advertiseUrl, bool isHttpKmsg, int index = 0);
+  // Append the message to the batch sent by one sendmsg call.
+  void FillSendMessage(MessageBase *msg, const std::string &advertiseUrl, bool isHttpKmsg);
+
+  // Take the queued messages as a batch to be sent.
+  void FillSendMessages(const std::string &advertiseUrl);
+
+  // Release the messages of the batch which are sent completely.
+  void ReleaseSendMessages();
 
   void FillRecvMessage();
 
@@ -167,12 +173,16 @@ struct Connection {
   SendMetrics *send_metrics;
 
   // The message data waiting to be sent and receive through this connection..
-  MessageBase *send_message;
+  MessageBase *send_messages[SEND_MSG_BATCH_SIZE];
+  size_t send_message_num;
   MessageBase *recv_message;
 
-  // Owned by the tcp_comm.
+  // The mutex for the send and receive state of this connection.
   std::shared_ptr<std::mutex> conn_mutex;
 
+  // Whether a task to send the queued messages is added to the send event loop.
+  bool flush_pending;
+
   State recv_state;
 
   // Total length of received and sent messages.
@@ -180,13 +190,13 @@ struct Connection {
   uint32_t total_send_len;
   uint32_t recv_len;
 
-  std::string send_to;
-  std::string send_from;
+  std::string send_to[SEND_MSG_BATCH_SIZE];
+  std::string send_from[SEND_MSG_BATCH_SIZE];
   std::string recv_to;
   std::string recv_from;
 
   // Message header.
-  MessageHeader send_msg_header;
+  MessageHeader send_msg_header[SEND_MSG_BATCH_SIZE];
   MessageHeader recv_msg_header;
 
   // The message structure of kernel.
@@ -194,7 +204,8 @@ struct Connection {
   struct msghdr recv_kernel_msg;
 
   struct iovec recv_io_vec[RECV_MSG_IO_VEC_LEN];
-  struct iovec send_io_vec[SEND_MSG_IO_VEC_LEN];
+  struct iovec send_io_vec[SEND_MSG_IO_VEC_LEN * SEND_MSG_BATCH_SIZE];
+  size_t send_io_vec_num;
 
   ParseType recv_message_type{kUnknown};
 
@@ -36,6 +36,11 @@ using ConnectionCallBack = void (*)(void *conn);
 constexpr int SEND_MSG_IO_VEC_LEN = 5;
 constexpr int RECV_MSG_IO_VEC_LEN = 4;
 
+// The queued messages of a connection are sent in batches by one sendmsg call, the batch is limited by the message
+// number and the total bytes.
+constexpr int SEND_MSG_BATCH_SIZE = 32;
+constexpr uint32_t SEND_MSG_BATCH_BYTES = 1048576;
+
 constexpr unsigned int BUSMAGIC_LEN = 4;
 constexpr int SENDMSG_QUEUELEN = 1024;
 constexpr int SENDMSG_DROPED = -1;
@@ -76,6 +81,14 @@ static const char URL_PROTOCOL_IP_SEPARATOR[] = "://";
 static const char URL_IP_PORT_SEPARATOR[] = ":";
 static const char TCP_RECV_EVLOOP_THREADNAME[] = "RECV_EVENT_LOOP";
 static const char TCP_SEND_EVLOOP_THREADNAME[] = "SEND_EVENT_LOOP";
+// The thread name prefixes of the event loops when there are more than one loop, the thread name is limited to 16 chars.
+static const char TCP_RECV_EVLOOP_THREADNAME_PREFIX[] = "RECV_EVLOOP_";
+static const char TCP_SEND_EVLOOP_THREADNAME_PREFIX[] = "SEND_EVLOOP_";
+
+// The number of the recv and send event loops of a tcp communicator, the connections are sharded among them.
+static const char TCP_EVLOOP_NUM_ENV[] = "MS_RPC_EVENT_LOOP_NUM";
+constexpr size_t TCP_DEFAULT_EVLOOP_NUM = 1;
+constexpr size_t TCP_MAX_EVLOOP_NUM = 64;
 
 constexpr int RPC_ERROR = -1;
 constexpr int RPC_OK = 0;
@@ -22,7 +22,7 @@ namespace rpc {
 bool TCPClient::Initialize() {
   bool rt = false;
   if (tcp_comm_ == nullptr) {
-    tcp_comm_ = std::make_unique<TCPComm>();
+    tcp_comm_ = std::make_unique<TCPComm>(event_loop_num_);
     MS_EXCEPTION_IF_NULL(tcp_comm_);
     rt = tcp_comm_->Initialize();
   } else {
@@ -28,7 +28,8 @@ namespace distributed {
 namespace rpc {
 class TCPClient {
  public:
-  TCPClient() = default;
+  // The connections are handled by `event_loop_num` pairs of event loops, see the constructor of TCPComm.
+  explicit TCPClient(size_t event_loop_num = 0) : event_loop_num_(event_loop_num) {}
   ~TCPClient() = default;
 
   // Build or destroy the TCP client.
@@ -48,6 +49,9 @@ class TCPClient {
   // The basic TCP communication component used by the client.
   std::unique_ptr<TCPComm> tcp_comm_;
 
+  // The number of event loops used by the TCP communication component.
+  size_t event_loop_num_;
+
   DISABLE_COPY_AND_ASSIGN(TCPClient);
 };
 }  // namespace rpc
@@ -19,8 +19,11 @@
 #include <mutex>
 #include <utility>
 #include <memory>
+#include <functional>
+#include <algorithm>
 
 #include "actor/aid.h"
+#include "utils/ms_utils.h"
 #include "distributed/rpc/tcp/constants.h"
 #include "distributed/rpc/tcp/tcp_socket_operation.h"
 
@@ -67,7 +70,7 @@ void OnAccept(int server, uint32_t events, void *arg) {
     return;
   }
   TCPComm *tcpmgr = reinterpret_cast<TCPComm *>(arg);
-  if (tcpmgr->recv_event_loop_ == nullptr) {
+  if (tcpmgr->recv_event_loops_.empty() || tcpmgr->send_event_loops_.empty()) {
     MS_LOG(ERROR) << "EventLoop is null, server fd: " << server << ", events: " << events;
     return;
   }
@@ -106,10 +109,12 @@ void OnAccept(int server, uint32_t events, void *arg) {
   conn->peer = SocketOperation::GetPeer(acceptFd);
 
   conn->is_remote = true;
-  conn->recv_event_loop = tcpmgr->recv_event_loop_;
-  conn->send_event_loop = tcpmgr->send_event_loop_;
+  // The accepted connections are assigned to the event loops in turn.
+  auto loop_index = tcpmgr->next_accept_loop_++ % tcpmgr->recv_event_loops_.size();
+  conn->recv_event_loop = tcpmgr->recv_event_loops_[loop_index];
+  conn->send_event_loop = tcpmgr->send_event_loops_[loop_index];
 
-  conn->conn_mutex = tcpmgr->conn_mutex_;
+  conn->conn_mutex = std::make_shared<std::mutex>();
   conn->message_handler = tcpmgr->message_handler_;
 
   conn->event_callback = TCPComm::EventCallBack;
@@ -133,8 +138,10 @@ void OnAccept(int server, uint32_t events, void *arg) {
 void DoSend(Connection *conn) {
   while (!conn->send_message_queue.empty() || conn->total_send_len != 0) {
     if (conn->total_send_len == 0) {
-      conn->FillSendMessage(conn->send_message_queue.front(), conn->source, false);
-      conn->send_message_queue.pop();
+      conn->FillSendMessages(conn->source);
+      if (conn->total_send_len == 0) {
+        continue;
+      }
     }
 
     int sendLen = conn->socket_operation->SendMessage(conn, &conn->send_kernel_msg, &conn->total_send_len);
@@ -142,10 +149,7 @@ void DoSend(Connection *conn) {
       if (conn->total_send_len == 0) {
         // update metrics
         conn->send_metrics->UpdateError(false);
-
-        conn->output_buffer_size -= conn->send_message->body.size();
-        delete conn->send_message;
-        conn->send_message = nullptr;
+        conn->ReleaseSendMessages();
       }
     } else if (sendLen == 0) {
       // EAGAIN
@@ -170,6 +174,22 @@ TCPComm::~TCPComm() {
 
 void TCPComm::SetMessageHandler(MessageHandler handler) { message_handler_ = handler; }
 
+TCPComm::TCPComm(size_t event_loop_num) : server_fd_(-1), event_loop_num_(event_loop_num), next_accept_loop_(0) {
+  if (event_loop_num_ == 0) {
+    event_loop_num_ = TCP_DEFAULT_EVLOOP_NUM;
+    auto env_loop_num = common::GetEnv(TCP_EVLOOP_NUM_ENV);
+    if (!env_loop_num.empty()) {
+      try {
+        event_loop_num_ = IntToSize(std::max(std::stoi(env_loop_num), 1));
+      } catch (const std::exception &e) {
+        MS_LOG(WARNING) << "Invalid environment variable " << TCP_EVLOOP_NUM_ENV << ": " << env_loop_num
+                        << ", use the default event loop number " << TCP_DEFAULT_EVLOOP_NUM;
+      }
+    }
+  }
+  event_loop_num_ = std::min(event_loop_num_, TCP_MAX_EVLOOP_NUM);
+}
+
 bool TCPComm::Initialize() {
   conn_pool_ = std::make_shared<ConnectionPool>();
   MS_EXCEPTION_IF_NULL(conn_pool_);
@@ -177,40 +197,54 @@ bool TCPComm::Initialize() {
   conn_mutex_ = std::make_shared<std::mutex>();
   MS_EXCEPTION_IF_NULL(conn_mutex_);
 
-  recv_event_loop_ = new (std::nothrow) EventLoop();
-  if (recv_event_loop_ == nullptr) {
-    MS_LOG(ERROR) << "Failed to create recv evLoop.";
-    return false;
-  }
-
-  bool ok = recv_event_loop_->Initialize(TCP_RECV_EVLOOP_THREADNAME);
-  if (!ok) {
+  if (!InitEventLoops(TCP_RECV_EVLOOP_THREADNAME, TCP_RECV_EVLOOP_THREADNAME_PREFIX, &recv_event_loops_)) {
     MS_LOG(ERROR) << "Failed to init recv evLoop";
-    delete recv_event_loop_;
-    recv_event_loop_ = nullptr;
-    return false;
-  }
-
-  send_event_loop_ = new (std::nothrow) EventLoop();
-  if (send_event_loop_ == nullptr) {
-    MS_LOG(ERROR) << "Failed to create send evLoop.";
-    delete recv_event_loop_;
-    recv_event_loop_ = nullptr;
     return false;
   }
-  ok = send_event_loop_->Initialize(TCP_SEND_EVLOOP_THREADNAME);
-  if (!ok) {
+  if (!InitEventLoops(TCP_SEND_EVLOOP_THREADNAME, TCP_SEND_EVLOOP_THREADNAME_PREFIX, &send_event_loops_)) {
     MS_LOG(ERROR) << "Failed to init send evLoop";
-    delete recv_event_loop_;
-    recv_event_loop_ = nullptr;
-    delete send_event_loop_;
-    send_event_loop_ = nullptr;
+    FinalizeEventLoops(&recv_event_loops_);
     return false;
   }
+  MS_LOG(INFO) << "The number of event loops is " << event_loop_num_;
+  return true;
+}
 
+bool TCPComm::InitEventLoops(const std::string &name, const std::string &prefix,
+                             std::vector<EventLoop *> *event_loops) const {
+  MS_EXCEPTION_IF_NULL(event_loops);
+  for (size_t i = 0; i < event_loop_num_; ++i) {
+    auto event_loop = new (std::nothrow) EventLoop();
+    if (event_loop == nullptr) {
+      MS_LOG(ERROR) << "Failed to create evLoop " << name;
+      FinalizeEventLoops(event_loops);
+      return false;
+    }
+    auto thread_name = event_loop_num_ == 1 ? name : prefix + std::to_string(i);
+    if (!event_loop->Initialize(thread_name)) {
+      MS_LOG(ERROR) << "Failed to init evLoop " << thread_name;
+      delete event_loop;
+      FinalizeEventLoops(event_loops);
+      return false;
+    }
+    event_loops->push_back(event_loop);
+  }
   return true;
 }
 
+void TCPComm::FinalizeEventLoops(std::vector<EventLoop *> *event_loops) {
+  MS_EXCEPTION_IF_NULL(event_loops);
+  for (auto event_loop : *event_loops) {
+    event_loop->Finalize();
+    delete event_loop;
+  }
+  event_loops->clear();
+}
+
+size_t TCPComm::EventLoopIndex(const std::string &dst_url) const {
+  return std::hash<std::string>{}(dst_url) % event_loop_num_;
+}
+
 bool TCPComm::StartServerSocket(const std::string &url) {
   server_fd_ = SocketOperation::Listen(url);
   if (server_fd_ < 0) {
@@ -224,7 +258,7 @@ bool TCPComm::StartServerSocket(const std::string &url) {
   }
 
   // Register read event callback for server socket
-  int retval = recv_event_loop_->SetEventHandler(server_fd_, EPOLLIN | EPOLLHUP | EPOLLERR, OnAccept,
+  int retval = recv_event_loops_[0]->SetEventHandler(server_fd_, EPOLLIN | EPOLLHUP | EPOLLERR, OnAccept,
                                                  reinterpret_cast<void *>(this));
   if (retval != RPC_OK) {
     MS_LOG(ERROR) << "Failed to add server event, url: " << url.c_str();
@@ -355,16 +389,19 @@ void TCPComm::DropMessage(MessageBase *msg) {
 }
 
 int TCPComm::Send(MessageBase *msg) {
-  return send_event_loop_->AddTask([msg, this] {
-    std::lock_guard<std::mutex> lock(*conn_mutex_);
+  auto dst_url = msg->to.Url();
+  return send_event_loops_[EventLoopIndex(dst_url)]->AddTask([msg, dst_url, this] {
+    std::unique_lock<std::mutex> pool_lock(*conn_mutex_);
     // Search connection by the target address
-    Connection *conn = conn_pool_->FindConnection(msg->to.Url());
+    Connection *conn = conn_pool_->FindConnection(dst_url);
     if (conn == nullptr) {
       MS_LOG(ERROR) << "Can not found remote link and send fail name: " << msg->name.c_str()
-                    << ", from: " << msg->from.Url().c_str() << ", to: " << msg->to.Url().c_str();
+                    << ", from: " << msg->from.Url().c_str() << ", to: " << dst_url.c_str();
       DropMessage(msg);
       return;
     }
+    std::lock_guard<std::mutex> lock(*conn->conn_mutex);
+    pool_lock.unlock();
 
     if (conn->send_message_queue.size() >= SENDMSG_QUEUELEN) {
       MS_LOG(WARNING) << "The message queue is full(max len:" << SENDMSG_QUEUELEN
@@ -382,17 +419,36 @@ int TCPComm::Send(MessageBase *msg) {
       return;
     }
 
-    if (conn->total_send_len == 0) {
-      conn->FillSendMessage(msg, url_, false);
-    } else {
-      (void)conn->send_message_queue.emplace(msg);
+    conn->output_buffer_size += msg->body.size();
+    (void)conn->send_message_queue.emplace(msg);
+    if (conn->send_message_queue.size() >= SEND_MSG_BATCH_SIZE) {
+      DoSend(conn);
+    } else if (!conn->flush_pending) {
+      // The messages arrived before the flush task runs are sent together.
+      conn->flush_pending = true;
+      (void)conn->send_event_loop->AddTask([dst_url, this] { FlushMessages(dst_url); });
     }
-    DoSend(conn);
   });
 }
 
+void TCPComm::FlushMessages(const std::string &dst_url) {
+  std::unique_lock<std::mutex> pool_lock(*conn_mutex_);
+  Connection *conn = conn_pool_->FindConnection(dst_url);
+  if (conn == nullptr) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(*conn->conn_mutex);
+  pool_lock.unlock();
+
+  conn->flush_pending = false;
+  if (conn->state == ConnectionState::kConnected) {
+    DoSend(conn);
+  }
+}
+
 void TCPComm::Connect(const std::string &dst_url) {
-  (void)recv_event_loop_->AddTask([dst_url, this] {
+  auto loop_index = EventLoopIndex(dst_url);
+  (void)recv_event_loops_[loop_index]->AddTask([dst_url, loop_index, this] {
     std::lock_guard<std::mutex> lock(*conn_mutex_);
 
     // Search connection by the target address
@@ -408,9 +464,9 @@ void TCPComm::Connect(const std::string &dst_url) {
       conn->source = url_;
       conn->destination = dst_url;
 
-      conn->recv_event_loop = this->recv_event_loop_;
-      conn->send_event_loop = this->send_event_loop_;
-      conn->conn_mutex = conn_mutex_;
+      conn->recv_event_loop = this->recv_event_loops_[loop_index];
+      conn->send_event_loop = this->send_event_loops_[loop_index];
+      conn->conn_mutex = std::make_shared<std::mutex>();
       conn->message_handler = message_handler_;
       conn->InitSocketOperation();
 
@@ -449,6 +505,7 @@ void TCPComm::Connect(const std::string &dst_url) {
 }
 
 bool TCPComm::IsConnected(const std::string &dst_url) {
+  std::lock_guard<std::mutex> lock(*conn_mutex_);
   Connection *conn = conn_pool_->FindConnection(dst_url);
   if (conn != nullptr && conn->state == ConnectionState::kConnected) {
     return true;
@@ -457,8 +514,15 @@ bool TCPComm::IsConnected(const std::string &dst_url) {
 }
 
 void TCPComm::Disconnect(const std::string &dst_url) {
-  (void)recv_event_loop_->AddTask([dst_url, this] {
-    std::lock_guard<std::mutex> lock(*conn_mutex_);
+  (void)recv_event_loops_[EventLoopIndex(dst_url)]->AddTask([dst_url, this] {
+    std::lock_guard<std::mutex> pool_lock(*conn_mutex_);
+    Connection *conn = conn_pool_->FindConnection(dst_url);
+    if (conn == nullptr) {
+      return;
+    }
+    // Hold the mutex of the connection by a copy since the connection is deleted.
+    auto conn_mutex = conn->conn_mutex;
+    std::lock_guard<std::mutex> lock(*conn_mutex);
     conn_pool_->DeleteConnection(dst_url);
   });
 }
@@ -471,27 +535,24 @@ Connection *TCPComm::CreateDefaultConn(std::string to) {
   }
   conn->source = url_.data();
   conn->destination = to;
-  conn->recv_event_loop = this->recv_event_loop_;
-  conn->send_event_loop = this->send_event_loop_;
-  conn->conn_mutex = conn_mutex_;
+  auto loop_index = EventLoopIndex(to);
+  conn->recv_event_loop = this->recv_event_loops_[loop_index];
+  conn->send_event_loop = this->send_event_loops_[loop_index];
+  conn->conn_mutex = std::make_shared<std::mutex>();
   conn->message_handler = message_handler_;
   conn->InitSocketOperation();
   return conn;
 }
 
 void TCPComm::Finalize() {
-  if (send_event_loop_ != nullptr) {
-    MS_LOG(INFO) << "Delete send event loop";
-    send_event_loop_->Finalize();
-    delete send_event_loop_;
-    send_event_loop_ = nullptr;
-  }
-
-  if (recv_event_loop_ != nullptr) {
-    MS_LOG(INFO) << "Delete recv event loop";
-    recv_event_loop_->Finalize();
-    delete recv_event_loop_;
-    recv_event_loop_ = nullptr;
+  if (!send_event_loops_.empty()) {
+    MS_LOG(INFO) << "Delete send event loops";
+    FinalizeEventLoops(&send_event_loops_);
+  }
+
+  if (!recv_event_loops_.empty()) {
+    MS_LOG(INFO) << "Delete recv event loops";
+    FinalizeEventLoops(&recv_event_loops_);
   }
 
   if (server_fd_ > 0) {
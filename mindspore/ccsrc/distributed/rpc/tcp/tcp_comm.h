@@ -21,6 +21,7 @@
 #include <memory>
 #include <vector>
 #include <mutex>
+#include <atomic>
 
 #include "actor/msg.h"
 #include "distributed/rpc/tcp/connection.h"
@@ -42,7 +43,9 @@ void ConnectedEventHandler(int fd, uint32_t events, void *context);
 
 class TCPComm {
  public:
-  TCPComm() : server_fd_(-1), recv_event_loop_(nullptr), send_event_loop_(nullptr) {}
+  // The connections are sharded over `event_loop_num` pairs of receive and send event loops. If `event_loop_num` is 0,
+  // the number is read from the environment variable MS_RPC_EVENT_LOOP_NUM, and 1 by default.
+  explicit TCPComm(size_t event_loop_num = 0);
   TCPComm(const TCPComm &) = delete;
   TCPComm &operator=(const TCPComm &) = delete;
   ~TCPComm();
@@ -77,6 +80,20 @@ class TCPComm {
   // Build the connection.
   Connection *CreateDefaultConn(std::string to);
 
+  // Create and initialize the event loops whose thread names are built by the name and the prefix.
+  bool InitEventLoops(const std::string &name, const std::string &prefix, std::vector<EventLoop *> *event_loops) const;
+
+  // Finalize and delete the event loops.
+  static void FinalizeEventLoops(std::vector<EventLoop *> *event_loops);
+
+  // Return the index of the event loops which handle the connection to the destination. All the tasks and messages to
+  // the same destination are handled by the same loop, so the order of messages is kept.
+  size_t EventLoopIndex(const std::string &dst_url) const;
+
+  // Send the messages queued in the connection to the destination, it is added to the send event loop after the first
+  // message is queued, so the messages sent in one round of the loop are batched into fewer sendmsg calls.
+  void FlushMessages(const std::string &dst_url);
+
   // Send a message.
   static void SendExitMsg(const std::string &from, const std::string &to);
 
@@ -104,14 +121,18 @@ class TCPComm {
   // User defined handler for Handling received messages.
   MessageHandler message_handler_;
 
-  // All the connections share the same read and write event loop objects.
-  EventLoop *recv_event_loop_;
-  EventLoop *send_event_loop_;
+  // The connections are sharded over the read and write event loop objects.
+  size_t event_loop_num_;
+  std::vector<EventLoop *> recv_event_loops_;
+  std::vector<EventLoop *> send_event_loops_;
+
+  // The index of the receive event loop to handle the next accepted connection.
+  std::atomic<size_t> next_accept_loop_;
 
   // The connection pool used to store new connections.
   std::shared_ptr<ConnectionPool> conn_pool_;
 
-  // The mutex for connection operations.
+  // The mutex for the connection pool, each connection has its own mutex for the send and receive state.
   std::shared_ptr<std::mutex> conn_mutex_;
 
   friend void OnAccept(int server, uint32_t events, void *arg);
@@ -28,7 +28,8 @@ namespace distributed {
 namespace rpc {
 class TCPServer {
  public:
-  TCPServer() = default;
+  // The connections are handled by `event_loop_num` pairs of event loops, see the constructor of TCPComm.
+  explicit TCPServer(size_t event_loop_num = 0) : event_loop_num_(event_loop_num) {}
   ~TCPServer() = default;
 
   // Init the tcp server using the specified url.
@@ -53,6 +54,9 @@ class TCPServer {
   // The basic TCP communication component used by the server.
   std::unique_ptr<TCPComm> tcp_comm_;
 
+  // The number of event loops used by the TCP communication component.
+  size_t event_loop_num_;
+
   std::string ip_{""};
   uint32_t port_{0};
 
@@ -16,12 +16,36 @@
 
 #include "frontend/parallel/auto_parallel/costmodel.h"
 #include <cmath>
+#include <map>
+#include <mutex>
 #include <numeric>
+#include <sstream>
+#include <string>
 #include <utility>
 #include "frontend/parallel/auto_parallel/graph_costmodel.h"
+#include "frontend/parallel/tensor_layout/tensor_redistribution.h"
+#include "include/common/thread_pool.h"
+#include "utils/ms_exception.h"
 
 namespace mindspore {
 namespace parallel {
+namespace {
+std::mutex redistribution_cost_mutex;
+std::map<std::string, RedistributionCost> redistribution_cost_cache;
+size_t redistribution_cost_hit_count = 0;
+
+std::string RedistributionCostKey(const TensorLayout &from_layout, const TensorLayout &to_layout,
+                                  const RankList &dev_list, bool keep_reshape) {
+  std::ostringstream buffer;
+  buffer << from_layout.ToString() << to_layout.ToString() << std::endl << "devices =";
+  for (auto rank : dev_list) {
+    buffer << " " << rank;
+  }
+  buffer << std::endl << "keep reshape = " << keep_reshape;
+  return buffer.str();
+}
+}  // namespace
+
 void Simplify(CostPtrList *clist_ptrs) {
   const auto run_phase = CostModelContext::GetInstance()->run_phase();
   if (run_phase == TRAINING_PHASE) {
@@ -125,5 +149,61 @@ void RefineForPracticalCost(const CostPtr &origin_cost, bool is_redistribution)
     }
   }
 }
+
+void ParallelForEachStrategy(size_t count, const std::function<void(size_t)> &task) {
+  auto run_range = [&task](size_t start, size_t end) {
+    for (size_t i = start; i < end; ++i) {
+      task(i);
+    }
+    return common::SUCCESS;
+  };
+  if (count <= 1) {
+    (void)run_range(0, count);
+    return;
+  }
+  if (!common::ThreadPool::GetInstance().ParallelFor(count, 1, run_range)) {
+    MsException::Instance().CheckException();
+    MS_LOG(EXCEPTION) << "Computing the costs of " << count << " strategies failed.";
+  }
+}
+
+RedistributionCost ComputeRedistributionCost(const TensorLayout &from_layout, const TensorLayout &to_layout,
+                                             const RankList &dev_list, bool keep_reshape) {
+  auto key = RedistributionCostKey(from_layout, to_layout, dev_list, keep_reshape);
+  {
+    std::lock_guard<std::mutex> lock(redistribution_cost_mutex);
+    auto iter = redistribution_cost_cache.find(key);
+    if (iter != redistribution_cost_cache.end()) {
+      ++redistribution_cost_hit_count;
+      return iter->second;
+    }
+  }
+  TensorRedistribution tensor_redistribution(false, keep_reshape);
+  if (tensor_redistribution.Init(from_layout, to_layout, dev_list) == FAILED) {
+    MS_LOG(EXCEPTION) << "Failure: tensor_redistribution init failed.";
+  }
+  if (tensor_redistribution.ComputeCost() == FAILED) {
+    MS_LOG(EXCEPTION) << "Failure: tensor_redistribution ComputeCost failed.";
+  }
+  RedistributionCost cost;
+  cost.comm_cost = tensor_redistribution.comm_cost();
+  cost.forward_comm_cost = tensor_redistribution.forward_comm_cost();
+  cost.backward_comm_cost = tensor_redistribution.backward_comm_cost();
+  cost.computation_cost = tensor_redistribution.computation_cost();
+  cost.memory_cost = tensor_redistribution.memory_cost();
+  std::lock_guard<std::mutex> lock(redistribution_cost_mutex);
+  (void)redistribution_cost_cache.emplace(key, cost);
+  return cost;
+}
+
+void ClearRedistributionCostCache() {
+  std::lock_guard<std::mutex> lock(redistribution_cost_mutex);
+  if (!redistribution_cost_cache.empty()) {
+    MS_LOG(INFO) << "The redistribution costs of the last search: " << redistribution_cost_cache.size()
+                 << " computed, " << redistribution_cost_hit_count << " reused.";
+  }
+  redistribution_cost_cache.clear();
+  redistribution_cost_hit_count = 0;
+}
 }  // namespace parallel
 }  // namespace mindspore
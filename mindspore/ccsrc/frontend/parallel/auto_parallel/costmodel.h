@@ -18,6 +18,7 @@
 #define MINDSPORE_CCSRC_FRONTEND_PARALLEL_AUTO_PARALLEL_COSTMODEL_H_
 
 #include <algorithm>
+#include <functional>
 #include <memory>
 #include <string>
 #include <utility>
@@ -344,6 +345,24 @@ void Simplify(CostPtrList *clist);
 void SimplifyForDecreasingCommunicationForward(CostPtrList *clist);
 void SimplifyForDecreasingCommunicationWithPartialPara(CostPtrList *clist);
 void RefineForPracticalCost(const CostPtr &, bool is_redistribution);
+// Run 'task' for each index in [0, count) on the common thread pool. Each index writes its own results, so they are
+// the same as running in order. The exception thrown by a task is thrown again by the caller.
+void ParallelForEachStrategy(size_t count, const std::function<void(size_t)> &task);
+
+// The costs of a tensor redistribution per byte, computed by TensorRedistribution::ComputeCost.
+struct RedistributionCost {
+  double comm_cost = 0.0;
+  double forward_comm_cost = 0.0;
+  double backward_comm_cost = 0.0;
+  double computation_cost = 0.0;
+  double memory_cost = 0.0;
+};
+// Compute the costs of redistributing the tensor from 'from_layout' to 'to_layout' on the devices. The costs are
+// memoized by the layouts and the devices, so the edges and the reshapes of the repeated layers compute them once.
+RedistributionCost ComputeRedistributionCost(const TensorLayout &from_layout, const TensorLayout &to_layout,
+                                             const RankList &dev_list, bool keep_reshape);
+// Clear the memoized redistribution costs, called before searching the strategies of a graph.
+void ClearRedistributionCostCache();
 }  // namespace parallel
 }  // namespace mindspore
 
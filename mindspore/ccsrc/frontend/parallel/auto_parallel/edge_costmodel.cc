@@ -64,14 +64,14 @@ Status Edge::InitEdgeCost() {
       }
     }
   } else {
-    for (auto &target_output : pre_op_output_) {
-      auto target_output_lyt = target_output.second[prev_op_output_index_].tensor_layout();
-      auto target_output_str = target_output.first;
+    // The costs of each output strategy are computed in parallel, then inserted in order.
+    std::vector<std::vector<CostPtr>> costs(pre_op_output_.size());
+    ParallelForEachStrategy(pre_op_output_.size(), [this, &costs](size_t i) {
+      auto target_output_lyt = pre_op_output_[i].second[prev_op_output_index_].tensor_layout();
       auto type_length = prev_op_->GetOutputTypeLengths()[prev_op_output_index_];
       auto type = prev_op_->outputs_type()[prev_op_output_index_];
       for (auto &target_input : next_op_input_) {
         auto target_input_lyt = target_input.second[next_op_input_index_].tensor_layout();
-        auto target_input_str = target_input.first;
         CostPtr cost;
         if (GetRedistributionCost(target_output_lyt, target_input_lyt, type_length, type, &cost) != SUCCESS) {
           MS_LOG(EXCEPTION) << "Failure: redistribution cost calculation failed";
@@ -84,9 +84,14 @@ Status Edge::InitEdgeCost() {
         // refine communication cost calculation for practice
         RefineForPracticalCost(cost, true);
         cost->communication_forward_ = cost->communication_redis_forward_;
-        CostPtrKey ck = {target_output_str, target_input_str};
+        costs[i].push_back(cost);
+      }
+    });
+    for (size_t i = 0; i < pre_op_output_.size(); ++i) {
+      for (size_t j = 0; j < next_op_input_.size(); ++j) {
+        CostPtrKey ck = {pre_op_output_[i].first, next_op_input_[j].first};
         CostPtrList cl;
-        cl.push_back(cost);
+        cl.push_back(costs[i][j]);
         (void)cost_map_.emplace(std::make_pair(ck, cl));
         has_available_cost = true;
       }
@@ -119,22 +124,13 @@ Status Edge::GetRedistributionCost(const TensorLayout &prev_op_output_layout, co
   MS_EXCEPTION_IF_NULL(prev_op_);
   MS_EXCEPTION_IF_NULL(cost);
   RankList dev_list = prev_op_->stage_device_list();
-  TensorRedistribution tensor_redistribution(false);
+  auto redistribution_cost = ComputeRedistributionCost(prev_op_output_layout, next_op_input_layout, dev_list, false);
 
-  // Init TensorRedistribution
-  if (tensor_redistribution.Init(prev_op_output_layout, next_op_input_layout, dev_list) == FAILED) {
-    MS_LOG(EXCEPTION) << "Failure: tensor_redistribution init failed.";
-  }
-
-  if (tensor_redistribution.ComputeCost() == FAILED) {
-    MS_LOG(EXCEPTION) << "Failure: tensor_redistribution ComputeCost failed.";
-  }
-
-  double comm_cost = tensor_redistribution.comm_cost();
-  double forward_comm_cost = tensor_redistribution.forward_comm_cost();
-  double backward_comm_cost = tensor_redistribution.backward_comm_cost();
-  double computation_cost = tensor_redistribution.computation_cost();
-  double mem_cost = tensor_redistribution.memory_cost();
+  double comm_cost = redistribution_cost.comm_cost;
+  double forward_comm_cost = redistribution_cost.forward_comm_cost;
+  double backward_comm_cost = redistribution_cost.backward_comm_cost;
+  double computation_cost = redistribution_cost.computation_cost;
+  double mem_cost = redistribution_cost.memory_cost;
   const auto gamma = CostModelContext::GetInstance()->costmodel_gamma();
 
   // Now AllGather, ReduceScatter, AlltoAll don't support bool type
@@ -207,21 +203,28 @@ CostPtrList Edge::CreateEdgeEliminationCostList(const StrategyPtr &output_st_ptr
   return result;
 }
 
-void Edge::EdgeEliminationSetNewCost(OperatorInfoPtr, const std::vector<EdgePtr> &edges, OperatorInfoPtr) {
+bool Edge::SetNewCostMap(const std::vector<std::vector<CostPtrList>> &clists) {
   bool valid = false;
-  for (const auto &output_pair : pre_op_output_) {
-    StrategyPtr output_st_ptr = output_pair.first;
-    for (const auto &input_pair : next_op_input_) {
-      StrategyPtr input_st_ptr = input_pair.first;
-      CostPtrList clist = CreateEdgeEliminationCostList(output_st_ptr, edges, input_st_ptr);
-      CostPtrKey key = {output_st_ptr, input_st_ptr};
-      cost_map_[key] = clist;
-      if ((!valid) && (!clist.empty())) {
+  for (size_t i = 0; i < pre_op_output_.size(); ++i) {
+    for (size_t j = 0; j < next_op_input_.size(); ++j) {
+      CostPtrKey key = {pre_op_output_[i].first, next_op_input_[j].first};
+      cost_map_[key] = clists[i][j];
+      if ((!valid) && (!clists[i][j].empty())) {
         valid = true;
       }
     }
   }
-  if (!valid) {
+  return valid;
+}
+
+void Edge::EdgeEliminationSetNewCost(OperatorInfoPtr, const std::vector<EdgePtr> &edges, OperatorInfoPtr) {
+  std::vector<std::vector<CostPtrList>> clists(pre_op_output_.size());
+  ParallelForEachStrategy(pre_op_output_.size(), [this, &clists, &edges](size_t i) {
+    for (const auto &input_pair : next_op_input_) {
+      clists[i].push_back(CreateEdgeEliminationCostList(pre_op_output_[i].first, edges, input_pair.first));
+    }
+  });
+  if (!SetNewCostMap(clists)) {
     MS_LOG(EXCEPTION) << "Creating edge: " << edge_name_ << " failed.";
   }
 }
@@ -280,21 +283,13 @@ CostPtrList Edge::CreateOpEliminationCostList(const EdgePtr &e1, const StrategyP
 }
 
 void Edge::OpEliminationSetNewCost(const EdgePtr &e1, const OperatorInfoPtr &op, const EdgePtr &e2) {
-  bool valid = false;
-  for (const auto &output_pair : pre_op_output_) {
-    StrategyPtr output_st_ptr = output_pair.first;
+  std::vector<std::vector<CostPtrList>> clists(pre_op_output_.size());
+  ParallelForEachStrategy(pre_op_output_.size(), [this, &clists, &e1, &op, &e2](size_t i) {
     for (const auto &input_pair : next_op_input_) {
-      StrategyPtr input_st_ptr = input_pair.first;
-
-      CostPtrList clist = CreateOpEliminationCostList(e1, output_st_ptr, op, e2, input_st_ptr);
-      CostPtrKey key = {output_st_ptr, input_st_ptr};
-      cost_map_[key] = clist;
-      if ((!valid) && (!clist.empty())) {
-        valid = true;
-      }
+      clists[i].push_back(CreateOpEliminationCostList(e1, pre_op_output_[i].first, op, e2, input_pair.first));
     }
-  }
-  if (!valid) {
+  });
+  if (!SetNewCostMap(clists)) {
     MS_LOG(EXCEPTION) << "Creating edge: " << edge_name_ << " failed.";
   }
 }
@@ -158,6 +158,10 @@ class Edge {
   bool CheckStrategyCostPossibility() const;
 
  private:
+  // Set 'cost_map_' by the costlists of each pair of the strategies of 'pre_op_output_' and 'next_op_input_', return
+  // false if all of them are empty.
+  bool SetNewCostMap(const std::vector<std::vector<CostPtrList>> &clists);
+
   std::string edge_name_;
   std::shared_ptr<OperatorInfo> prev_op_, next_op_;
   std::map<CostPtrKey, CostPtrList> cost_map_;
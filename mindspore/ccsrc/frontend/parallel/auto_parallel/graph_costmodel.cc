@@ -30,7 +30,17 @@ namespace parallel {
 CostGraphPtr entire_costgraph = nullptr;
 size_t TOTAL_OPS = 0;
 
+namespace {
+// The elimination is valid if some strategy of the operator taking the costs still has a cost.
+bool HasValidStrategyCost(const std::vector<std::shared_ptr<StrategyWithCost>> &stra_costs) {
+  return std::any_of(stra_costs.begin(), stra_costs.end(), [](const std::shared_ptr<StrategyWithCost> &stra_cost) {
+    return !stra_cost->cost_list.empty();
+  });
+}
+}  // namespace
+
 void CostGraph::Init() {
+  ClearRedistributionCostCache();
   inputs_tensor_name_list_.clear();
   tuple_getitem_list_.clear();
   ops_.clear();
@@ -1229,15 +1239,17 @@ OperatorInfoPtr CostGraph::EliminationMerge(const OperatorInfoPtr &op) {
   MS_EXCEPTION_IF_NULL(target_op);
   MS_EXCEPTION_IF_NULL(edge_ptr);
   MS_LOG(INFO) << "Now merging " << op->name() << " into " << target_op->name() << ".";
-  bool valid = false;
-
-  for (auto &tar_stra_cost : target_op->GetStrategyCost()) {
+  const auto tar_stra_costs = target_op->GetStrategyCost();
+  const auto op_stra_costs = op->GetStrategyCost();
+  // The new costlist of each strategy of the target_op only reads the costlist of the same strategy.
+  ParallelForEachStrategy(tar_stra_costs.size(), [this, &tar_stra_costs, &op_stra_costs, &edge_ptr](size_t i) {
+    auto &tar_stra_cost = tar_stra_costs[i];
     MS_EXCEPTION_IF_NULL(tar_stra_cost);
     auto tar_stra = tar_stra_cost->strategy_ptr;
     auto tar_clist_origin = tar_stra_cost->cost_list;
     CostPtrList tar_clist_new;
 
-    for (auto &op_stra_cost : op->GetStrategyCost()) {
+    for (auto &op_stra_cost : op_stra_costs) {
       MS_EXCEPTION_IF_NULL(op_stra_cost);
       auto op_stra = op_stra_cost->strategy_ptr;
       auto op_clist = op_stra_cost->cost_list;
@@ -1248,12 +1260,9 @@ OperatorInfoPtr CostGraph::EliminationMerge(const OperatorInfoPtr &op) {
     Simplify(&tar_clist_new);
     // Set the new costlist w.r.t the strategy
     tar_stra_cost->cost_list = tar_clist_new;
-    if ((!valid) && (!tar_clist_new.empty())) {
-      valid = true;
-    }
-  }
+  });
 
-  if (!valid) {
+  if (!HasValidStrategyCost(tar_stra_costs)) {
     MS_LOG(EXCEPTION) << "Merging " << op->name() << " into " << target_op->name() << " failed.";
   }
   op->SetNotAlive();
@@ -1310,15 +1319,16 @@ OperatorInfoPtr CostGraph::EliminationContract(const OperatorInfoPtr &op) {
   auto target_op = op->GetAlivePrevEdges()[0]->prev_operator();
   auto edge_ptr = op->GetAlivePrevEdges()[0];
   MS_LOG(INFO) << "Now contracting " << op->name() << " into " << target_op->name() << ".";
-  bool valid = false;
-
-  for (auto &tar_stra_cost : target_op->GetStrategyCost()) {
+  const auto tar_stra_costs = target_op->GetStrategyCost();
+  const auto op_stra_costs = op->GetStrategyCost();
+  ParallelForEachStrategy(tar_stra_costs.size(), [this, &tar_stra_costs, &op_stra_costs, &edge_ptr](size_t i) {
+    auto &tar_stra_cost = tar_stra_costs[i];
     MS_EXCEPTION_IF_NULL(tar_stra_cost);
     auto tar_stra = tar_stra_cost->strategy_ptr;
     auto tar_clist_origin = tar_stra_cost->cost_list;
     CostPtrList tar_clist_new;
 
-    for (auto &op_stra_cost : op->GetStrategyCost()) {
+    for (auto &op_stra_cost : op_stra_costs) {
       MS_EXCEPTION_IF_NULL(op_stra_cost);
       auto op_stra = op_stra_cost->strategy_ptr;
       auto op_clist = op_stra_cost->cost_list;
@@ -1329,11 +1339,8 @@ OperatorInfoPtr CostGraph::EliminationContract(const OperatorInfoPtr &op) {
     Simplify(&tar_clist_new);
     // Set the new costlist w.r.t the strategy
     tar_stra_cost->cost_list = tar_clist_new;
-    if ((!valid) && (!tar_clist_new.empty())) {
-      valid = true;
-    }
-  }
-  if (!valid) {
+  });
+  if (!HasValidStrategyCost(tar_stra_costs)) {
     MS_LOG(EXCEPTION) << "Contracting " << op->name() << " into " << target_op->name() << " failed.";
   }
   op->SetNotAlive();
@@ -1431,21 +1438,23 @@ OperatorInfoPtr CostGraph::EliminationTriangle(const OperatorInfoPtr &elimi_op,
     left_edge = right_edge;
     right_edge = tmp;
   }
-  bool valid = false;
-
-  for (auto &left_node_stra_cost : left_node->GetStrategyCost()) {
+  const auto left_node_stra_costs = left_node->GetStrategyCost();
+  const auto elimi_op_stra_costs = elimi_op->GetStrategyCost();
+  const auto right_node_stra_costs = right_node->GetStrategyCost();
+  ParallelForEachStrategy(left_node_stra_costs.size(), [&, this](size_t i) {
+    auto &left_node_stra_cost = left_node_stra_costs[i];
     MS_EXCEPTION_IF_NULL(left_node_stra_cost);
     auto left_node_stra = left_node_stra_cost->strategy_ptr;
     auto left_node_clist_origin = left_node_stra_cost->cost_list;
     CostPtrList left_node_clist_new;
 
-    for (auto &elimi_op_stra_cost : elimi_op->GetStrategyCost()) {
+    for (auto &elimi_op_stra_cost : elimi_op_stra_costs) {
       MS_EXCEPTION_IF_NULL(elimi_op_stra_cost);
       auto elimi_op_stra = elimi_op_stra_cost->strategy_ptr;
       auto elimi_op_clist = elimi_op_stra_cost->cost_list;
       auto left_edge_clist = left_edge->GetCostList(elimi_op_stra, left_node_stra);
 
-      for (auto &right_node_stra_cost : right_node->GetStrategyCost()) {
+      for (auto &right_node_stra_cost : right_node_stra_costs) {
         MS_EXCEPTION_IF_NULL(right_node_stra_cost);
         auto right_node_stra = right_node_stra_cost->strategy_ptr;
         auto right_node_clist = right_node_stra_cost->cost_list;
@@ -1459,12 +1468,9 @@ OperatorInfoPtr CostGraph::EliminationTriangle(const OperatorInfoPtr &elimi_op,
     Simplify(&left_node_clist_new);
     // Set the new costlist w.r.t the strategy
     left_node_stra_cost->cost_list = left_node_clist_new;
-    if ((!valid) && (!left_node_clist_new.empty())) {
-      valid = true;
-    }
-  }
+  });
 
-  if (!valid) {
+  if (!HasValidStrategyCost(left_node_stra_costs)) {
     MS_LOG(EXCEPTION) << "Eliminating triangle: " << elimi_op->name()
                       << " failed. It may be caused by "
                          "configuring inconsistent strategies for operators.";
@@ -1593,17 +1599,18 @@ std::vector<std::shared_ptr<Edge>> CostGraph::EliminationStar(const OperatorInfo
   MS_EXCEPTION_IF_NULL(succ_edges[0]);
   auto first_succ_node = succ_edges[0]->next_operator();
   auto first_succ_edge = succ_edges[0];
-  bool valid = false;
-
   // 'merged_op' is merged into first_node
   MS_EXCEPTION_IF_NULL(first_succ_node);
-  for (auto &first_succ_node_stra_cost : first_succ_node->GetStrategyCost()) {
+  const auto first_succ_node_stra_costs = first_succ_node->GetStrategyCost();
+  const auto merged_op_stra_costs = merged_op->GetStrategyCost();
+  auto eliminate_star = [&, this](size_t i) {
+    auto &first_succ_node_stra_cost = first_succ_node_stra_costs[i];
     MS_EXCEPTION_IF_NULL(first_succ_node_stra_cost);
     auto first_succ_node_stra = first_succ_node_stra_cost->strategy_ptr;
     auto first_succ_node_clist = first_succ_node_stra_cost->cost_list;
     CostPtrList first_succ_node_clist_new;
 
-    for (auto &merged_op_stra_cost : merged_op->GetStrategyCost()) {
+    for (auto &merged_op_stra_cost : merged_op_stra_costs) {
       MS_EXCEPTION_IF_NULL(merged_op_stra_cost);
       auto merged_op_stra = merged_op_stra_cost->strategy_ptr;
       auto merged_op_clist = merged_op_stra_cost->cost_list;
@@ -1615,12 +1622,22 @@ std::vector<std::shared_ptr<Edge>> CostGraph::EliminationStar(const OperatorInfo
     Simplify(&first_succ_node_clist_new);
     // Set the new costlist w.r.t the strategy
     first_succ_node_stra_cost->cost_list = first_succ_node_clist_new;
-    if ((!valid) && (!first_succ_node_clist_new.empty())) {
-      valid = true;
+  };
+  // The costlists of the other successive nodes are read while computing each strategy of the first one, so the
+  // strategies are computed in order if the first one is also the node of another successive edge.
+  bool first_succ_node_repeated = std::any_of(succ_edges.begin() + 1, succ_edges.end(),
+                                              [&first_succ_node](const std::shared_ptr<Edge> &succ_edge) {
+                                                return succ_edge->next_operator() == first_succ_node;
+                                              });
+  if (first_succ_node_repeated) {
+    for (size_t i = 0; i < first_succ_node_stra_costs.size(); ++i) {
+      eliminate_star(i);
     }
+  } else {
+    ParallelForEachStrategy(first_succ_node_stra_costs.size(), eliminate_star);
   }
 
-  if (!valid) {
+  if (!HasValidStrategyCost(first_succ_node_stra_costs)) {
     MS_LOG(EXCEPTION) << "Eliminating star centered at: " << merged_op->name()
                       << " failed. It may be caused by "
                          "configuring inconsistent strategies for operators.";
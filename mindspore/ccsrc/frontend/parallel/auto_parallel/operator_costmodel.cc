@@ -20,6 +20,7 @@
 #include <random>
 #include "frontend/parallel/device_matrix.h"
 #include "frontend/parallel/tensor_layout/tensor_redistribution.h"
+#include "frontend/parallel/auto_parallel/costmodel.h"
 
 namespace mindspore {
 namespace parallel {
@@ -669,14 +670,9 @@ double ReshapeCost::GetForwardCommCost(const std::vector<TensorInfo> &inputs, co
   CheckGlobalDeviceManager();
   MS_EXCEPTION_IF_NULL(g_device_manager);
   RankList dev_list = g_device_manager->GetDeviceListByStageId(stage_id);
-  TensorRedistribution tensor_redistribution(false, true);
-  if (tensor_redistribution.Init(inputs[0].tensor_layout(), outputs[0].tensor_layout(), dev_list) == FAILED) {
-    MS_LOG(EXCEPTION) << "Failure: tensor_redistribution init failed.";
-  }
-  if (tensor_redistribution.ComputeCost() == FAILED) {
-    MS_LOG(EXCEPTION) << "Failure: tensor_redistribution ComputeCost failed.";
-  }
-  return (inputs_type_lengths_[0] * tensor_redistribution.comm_cost());
+  auto redistribution_cost =
+    ComputeRedistributionCost(inputs[0].tensor_layout(), outputs[0].tensor_layout(), dev_list, true);
+  return (inputs_type_lengths_[0] * redistribution_cost.comm_cost);
 }
 
 // return the per device communication cost in the backward phase.
@@ -707,14 +703,9 @@ double ReshapeCost::GetForwardComputationCost(const std::vector<TensorInfo> &inp
   CheckGlobalDeviceManager();
   MS_EXCEPTION_IF_NULL(g_device_manager);
   RankList dev_list = g_device_manager->GetDeviceListByStageId(stage_id);
-  TensorRedistribution tensor_redistribution(false, true);
-  if (tensor_redistribution.Init(inputs[0].tensor_layout(), outputs[0].tensor_layout(), dev_list) == FAILED) {
-    MS_LOG(EXCEPTION) << "Failure: tensor_redistribution init failed.";
-  }
-  if (tensor_redistribution.ComputeCost() == FAILED) {
-    MS_LOG(EXCEPTION) << "Failure: tensor_redistribution ComputeCost failed.";
-  }
-  return (inputs_type_lengths_[0] * tensor_redistribution.computation_cost());
+  auto redistribution_cost =
+    ComputeRedistributionCost(inputs[0].tensor_layout(), outputs[0].tensor_layout(), dev_list, true);
+  return (inputs_type_lengths_[0] * redistribution_cost.computation_cost);
 }
 
 // Return the per device computation cost in the backward phase. The cost is calculated according to the bytes
@@ -390,6 +390,9 @@ OperatorInfoPtr CreateTheOperatorInfo(const PrimitivePtr &prim, const CNodePtr &
     operator_info->addAttr(IN_STRATEGY, attrs[GEN_STRATEGY]);  // for d-rec
   } else {
     MS_LOG(INFO) << "auto-searching strategy...";
+    // The strategies are generated one operator after another: SetCostUnderStrategy re-initializes the members of
+    // the operator for each strategy, and the initialization may create the communication groups, which must be done
+    // in the thread initializing the collective communication.
     retGenStra = operator_info->GenerateStrategies(0);
   }
 
@@ -21,7 +21,7 @@
 #include <condition_variable>
 #include <thread>
 #include <vector>
-#include <queue>
+#include <deque>
 #include <string>
 #include <atomic>
 #include <memory>
@@ -35,13 +35,25 @@ namespace mindspore {
 namespace common {
 enum Status { FAIL = -1, SUCCESS = 0 };
 using Task = std::function<Status()>;
+// Run the elements in [start, end) of a parallel for.
+using RangeTask = std::function<Status(size_t, size_t)>;
 
-struct ThreadContext {
+// The jobs pushed by a thread of the pool go to its own queue, it takes the newest job from the back while the idle
+// threads steal the oldest ones from the front.
+struct WorkQueue {
   std::mutex mutex;
-  std::condition_variable cond_var;
-  const Task *task{nullptr};
+  std::deque<std::function<void()>> jobs;
 };
 
+// Counts the unfinished jobs of one SyncRun, ParallelFor or SyncRunGraph call.
+struct TaskGroup {
+  explicit TaskGroup(size_t job_num) : pending(job_num) {}
+  std::atomic_size_t pending;
+  std::atomic_bool failed{false};
+};
+
+// Work stealing thread pool. A thread waiting for its tasks runs the queued jobs, including the ones of other calls,
+// until its tasks finish, so the pool can be called from inside a task without blocking or creating more threads.
 class COMMON_EXPORT ThreadPool {
  public:
   ~ThreadPool();
@@ -49,18 +61,41 @@ class COMMON_EXPORT ThreadPool {
   ThreadPool &operator=(const ThreadPool &) = delete;
   static ThreadPool &GetInstance();
   bool SyncRun(const std::vector<Task> &tasks);
+  // Split [0, count) into blocks of grain elements, the blocks are claimed one by one by the threads joining in, so
+  // uneven blocks are balanced among the threads.
+  bool ParallelFor(size_t count, size_t grain, const RangeTask &task);
+  // Run the tasks in the order of the dependencies, depends[i] lists the tasks that must finish before tasks[i].
+  // Once a task fails, the tasks not started yet are skipped.
+  bool SyncRunGraph(const std::vector<Task> &tasks, const std::vector<std::vector<size_t>> &depends);
   size_t GetSyncRunThreadNum() const { return max_thread_num_; }
+  // Resize the pool, the threads are restarted by the next call. It must be called when no task is running, e.g. when
+  // the runtime initializes and gives the kernel threads of runtime_num_threads to the pool.
+  void SetMaxThreadNum(size_t thread_num);
   void ClearThreadPool();
 
  private:
   ThreadPool();
-  void SyncRunLoop(const std::shared_ptr<ThreadContext> &context);
+  void StartThreads();
+  void SyncRunLoop(size_t index);
+  void PushJob(std::function<void()> &&job);
+  bool RunOneJob();
+  void Wait(const TaskGroup &group);
+  void FinishJob(TaskGroup *group);
+  void RunTask(const Task &task, TaskGroup *group) const;
 
   size_t max_thread_num_{1};
   std::mutex pool_mtx_;
   std::atomic_bool exit_run_ = {false};
+  std::atomic_bool started_ = {false};
   std::vector<std::thread> sync_run_threads_{};
-  std::vector<std::shared_ptr<ThreadContext>> contexts_;
+  std::vector<std::unique_ptr<WorkQueue>> queues_;
+  std::atomic_size_t next_queue_{0};
+  // the number of jobs in the queues, the idle threads and the waiting callers sleep when it is 0.
+  std::atomic_size_t pending_job_num_{0};
+  // the sleeping pool threads and callers of Wait, a caller is also woken when its group finishes.
+  std::atomic_size_t sleeping_thread_num_{0};
+  std::mutex sleep_mtx_;
+  std::condition_variable sleep_cond_;
 };
 }  // namespace common
 }  // namespace mindspore
@@ -44,6 +44,7 @@ constexpr auto kStridedSliceMaxDims = 8;
 const std::unordered_map<std::string, std::string> dtype_shortdtype_map_ = {
   {"float16", "f16"}, {"float32", "f32"}, {"float64", "f64"}, {"int8", "i8"},    {"int16", "i16"},  {"int32", "i32"},
   {"int64", "i64"},   {"uint8", "u8"},    {"uint16", "u16"},  {"uint32", "u32"}, {"uint64", "u64"}, {"bool", "bool"},
+  {"bfloat16", "bf16"},
 };
 
 const std::unordered_map<std::string, size_t> dtype_nbyte_map = {
@@ -51,7 +52,7 @@ const std::unordered_map<std::string, size_t> dtype_nbyte_map = {
   {"int8", sizeof(int) / 4},       {"int16", sizeof(int) / 2},  {"int32", sizeof(int)},
   {"int64", sizeof(int) * 2},      {"uint8", sizeof(int) / 4},  {"uint16", sizeof(int) / 2},
   {"uint32", sizeof(int)},         {"uint64", sizeof(int) * 2}, {"bool", sizeof(char)},
-  {"complex64", sizeof(float) * 2}};
+  {"complex64", sizeof(float) * 2}, {"bfloat16", sizeof(float) / 2}};
 
 // Define all patterns here for different schedule
 const std::unordered_map<FusionType, std::string> fusion_type_name_maps = {
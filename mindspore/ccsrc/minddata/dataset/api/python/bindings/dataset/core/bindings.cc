@@ -61,6 +61,10 @@ PYBIND_REGISTER(ConfigManager, 0, ([](const py::module *m) {
                     .def("get_enable_shared_mem", &ConfigManager::enable_shared_mem)
                     .def("set_auto_offload", &ConfigManager::set_auto_offload)
                     .def("get_auto_offload", &ConfigManager::get_auto_offload)
+                    .def("set_unordered_connector", &ConfigManager::set_unordered_connector)
+                    .def("get_unordered_connector", &ConfigManager::unordered_connector)
+                    .def("set_mindrecord_mmap", &ConfigManager::set_mindrecord_mmap)
+                    .def("get_mindrecord_mmap", &ConfigManager::mindrecord_mmap)
                     .def("set_enable_autotune",
                          [](ConfigManager &c, bool enable, bool save_autoconfig, std::string json_filepath) {
                            THROW_IF_ERROR(c.set_enable_autotune(enable, save_autoconfig, json_filepath));
@@ -58,7 +58,9 @@ ConfigManager::ConfigManager()
       save_autoconfig_(false),
       autotune_interval_(kCfgAutoTuneInterval),
       enable_watchdog_(true),
-      multiprocessing_timeout_interval_(kCfgMultiprocessingTimeoutInterval) {
+      multiprocessing_timeout_interval_(kCfgMultiprocessingTimeoutInterval),
+      unordered_connector_(false),
+      mindrecord_mmap_(false) {
   autotune_json_filepath_ = kEmptyString;
   num_cpu_threads_ = num_cpu_threads_ > 0 ? num_cpu_threads_ : std::numeric_limits<uint16_t>::max();
   num_parallel_workers_ = num_parallel_workers_ < num_cpu_threads_ ? num_parallel_workers_ : num_cpu_threads_;
@@ -275,6 +275,22 @@ class ConfigManager {
   // @param interval - multiprocessing timeout interval in seconds
   void set_multiprocessing_timeout_interval(uint32_t interval) { multiprocessing_timeout_interval_ = interval; }
 
+  // setter function
+  // @param unordered - To let the workers of the dataset ops deliver rows without keeping the order among them
+  void set_unordered_connector(bool unordered) { unordered_connector_ = unordered; }
+
+  // getter function
+  // @return - Flag to indicate whether the worker connectors are created in unordered mode
+  bool unordered_connector() const { return unordered_connector_; }
+
+  // setter function
+  // @param enable - To read the MindRecord files by mapping them into memory
+  void set_mindrecord_mmap(bool enable) { mindrecord_mmap_ = enable; }
+
+  // getter function
+  // @return - Flag to indicate whether the MindRecord files are read by mapping them into memory
+  bool mindrecord_mmap() const { return mindrecord_mmap_; }
+
  private:
   int32_t num_parallel_workers_;
   int32_t worker_connector_size_;
@@ -304,6 +320,8 @@ class ConfigManager {
   int64_t autotune_interval_;
   bool enable_watchdog_;                       // Watchdog python thread enabled flag
   uint32_t multiprocessing_timeout_interval_;  // Multiprocessing timeout interval in seconds
+  bool unordered_connector_;                   // Worker connectors do not keep the row order among workers
+  bool mindrecord_mmap_;                       // MindRecord files are read by mapping them into memory
   // Private helper function that takes a nlohmann json format and populates the settings
   // @param j - The json nlohmann json info
   Status FromJson(const nlohmann::json &j);
@@ -823,6 +823,22 @@ Status Tensor::GetDataAsNumpy(py::array *data) {
   }
   return Status::OK();
 }
+Status Tensor::GetDataAsNumpyView(const std::shared_ptr<Tensor> &tensor, py::array *data) {
+  RETURN_UNEXPECTED_IF_NULL(tensor);
+  RETURN_UNEXPECTED_IF_NULL(data);
+  if (!tensor->type().IsNumeric() || !tensor->HasData()) {
+    return tensor->GetDataAsNumpy(data);
+  }
+  // the capsule holds a reference of the tensor, which is released when the array is destroyed.
+  auto holder = std::make_unique<std::shared_ptr<Tensor>>(tensor);
+  py::capsule base(holder.get(), [](void *ptr) { delete reinterpret_cast<std::shared_ptr<Tensor> *>(ptr); });
+  (void)holder.release();
+  *data = py::array(tensor->type().AsNumpyType(), tensor->shape().AsVector(), tensor->Strides(),
+                    tensor->GetMutableBuffer(), base);
+  (void)data->attr("setflags")(py::arg("write") = false);
+  return Status::OK();
+}
+
 Status Tensor::GetDataAsNumpyStrings(py::array *data) {
   RETURN_UNEXPECTED_IF_NULL(data);
   auto itr = begin<std::string_view>();
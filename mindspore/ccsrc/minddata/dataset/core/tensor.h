@@ -451,6 +451,13 @@ class Tensor {
 
   Status GetDataAsNumpyStrings(py::array *data);
 
+  /// Constructs a read only numpy array which shares the memory of a numeric tensor, the array keeps the tensor
+  /// alive. The data of other tensors is copied as GetDataAsNumpy does.
+  /// \param[in] tensor The input tensor
+  /// \param[out] data The numpy array
+  /// \return Status code
+  static Status GetDataAsNumpyView(const std::shared_ptr<Tensor> &tensor, py::array *data);
+
   static Status GetBufferInfo(Tensor *t, py::buffer_info *out);
 #endif
 
@@ -35,6 +35,15 @@ namespace mindspore {
 namespace dataset {
 const char CacheAdminArgHandler::kServerBinary[] = "cache_server";
 
+namespace {
+// Format a ratio of two counters with two decimals for the session listing.
+std::string FormatRatio(int64_t numerator, int64_t denominator) {
+  std::stringstream ss;
+  ss << std::fixed << std::setprecision(2) << static_cast<double>(numerator) / denominator;
+  return ss.str();
+}
+}  // namespace
+
 CacheAdminArgHandler::CacheAdminArgHandler()
     : command_id_(CommandId::kCmdUnknown),
       num_workers_(kDefaultNumWorkers),
@@ -90,6 +99,7 @@ CacheAdminArgHandler::CacheAdminArgHandler()
   arg_map_["--memory_cap_ratio"] = ArgValue::kArgMemoryCapRatio;
   arg_map_["--list_sessions"] = ArgValue::kArgListSessions;
   arg_map_["--server_info"] = ArgValue::kArgServerInfo;
+  arg_map_["--compress"] = ArgValue::kArgCompress;
   // Initialize argument tracker with false values
   for (int16_t i = 0; i < static_cast<int16_t>(ArgValue::kArgNumArgs); ++i) {
     ArgValue currAV = static_cast<ArgValue>(i);
@@ -342,6 +352,10 @@ Status CacheAdminArgHandler::ParseArgStream(std::stringstream *arg_stream) {
         RETURN_IF_NOT_OK(AssignArg(tok, static_cast<std::string *>(nullptr), arg_stream, CommandId::kCmdServerInfo));
         break;
       }
+      case ArgValue::kArgCompress: {
+        RETURN_IF_NOT_OK(AssignArg(tok, static_cast<std::string *>(nullptr), arg_stream));
+        break;
+      }
       default: {
         // Save space delimited trailing arguments
         trailing_args_ += (" " + tok);
@@ -392,6 +406,10 @@ Status CacheAdminArgHandler::Validate() {
     return Status(StatusCode::kMDSyntaxError, "Port must be in range (1025..65535).");
   }
 
+  if (used_args_[ArgValue::kArgCompress] && command_id_ != CommandId::kCmdGenerateSession) {
+    return Status(StatusCode::kMDSyntaxError, "The --compress option can only be used with --generate_session.");
+  }
+
   return Status::OK();
 }
 
@@ -412,11 +430,12 @@ Status CacheAdminArgHandler::RunCommand() {
     case CommandId::kCmdGenerateSession: {
       CacheClientGreeter comm(hostname_, port_, 1);
       RETURN_IF_NOT_OK(comm.ServiceStart());
-      auto rq = std::make_shared<GenerateSessionIdRequest>();
+      bool compress = used_args_[ArgValue::kArgCompress];
+      auto rq = std::make_shared<GenerateSessionIdRequest>(compress);
       RETURN_IF_NOT_OK(comm.HandleRequest(rq));
       RETURN_IF_NOT_OK(rq->Wait());
       std::cout << "Session created for server on port " << std::to_string(port_) << ": " << rq->GetSessionId()
-                << std::endl;
+                << (compress ? " (compressed)" : "") << std::endl;
       break;
     }
     case CommandId::kCmdDestroySession: {
@@ -443,13 +462,15 @@ Status CacheAdminArgHandler::RunCommand() {
       if (!session_info.empty()) {
         std::cout << std::setw(12) << "Session" << std::setw(12) << "Cache Id" << std::setw(12) << "Mem cached"
                   << std::setw(12) << "Disk cached" << std::setw(16) << "Avg cache size" << std::setw(10) << "Numa hit"
-                  << std::endl;
+                  << std::setw(12) << "Hit ratio" << std::setw(16) << "Compress ratio" << std::endl;
         for (auto curr_session : session_info) {
           std::string cache_id;
           std::string stat_mem_cached;
           std::string stat_disk_cached;
           std::string stat_avg_cached;
           std::string stat_numa_hit;
+          std::string stat_hit_ratio;
+          std::string stat_compress_ratio;
           uint32_t crc = (curr_session.connection_id & 0x00000000FFFFFFFF);
           cache_id = (curr_session.connection_id == 0) ? "n/a" : std::to_string(crc);
           stat_mem_cached =
@@ -460,10 +481,17 @@ Status CacheAdminArgHandler::RunCommand() {
             (curr_session.stats.avg_cache_sz == 0) ? "n/a" : std::to_string(curr_session.stats.avg_cache_sz);
           stat_numa_hit =
             (curr_session.stats.num_numa_hit == 0) ? "n/a" : std::to_string(curr_session.stats.num_numa_hit);
+          // The share of the fetched rows served from memory, the rest are read from the spill directory.
+          int64_t num_hit = curr_session.stats.num_mem_hit + curr_session.stats.num_disk_hit;
+          stat_hit_ratio = (num_hit == 0) ? "n/a" : FormatRatio(curr_session.stats.num_mem_hit, num_hit);
+          stat_compress_ratio = (!curr_session.compress || curr_session.stats.stored_sz == 0)
+                                  ? "n/a"
+                                  : FormatRatio(curr_session.stats.uncompressed_sz, curr_session.stats.stored_sz);
 
           std::cout << std::setw(12) << curr_session.session_id << std::setw(12) << cache_id << std::setw(12)
                     << stat_mem_cached << std::setw(12) << stat_disk_cached << std::setw(16) << stat_avg_cached
-                    << std::setw(10) << stat_numa_hit << std::endl;
+                    << std::setw(10) << stat_numa_hit << std::setw(12) << stat_hit_ratio << std::setw(16)
+                    << stat_compress_ratio << std::endl;
         }
       } else {
         std::cout << "No active sessions." << std::endl;
@@ -673,7 +701,7 @@ void CacheAdminArgHandler::Help() {
   std::cerr << "                [[-l | --loglevel] <log level>]           Default is 1 (INFO level).\n";
   std::cerr << "            [--destroy_session  | -d] <session id>\n";
   std::cerr << "                [[-p | --port] <port number>]\n";
-  std::cerr << "            [--generate_session | -g]\n";
+  std::cerr << "            [--generate_session | -g] [--compress]\n";
   std::cerr << "                [[-p | --port] <port number>]\n";
   std::cerr << "            [--list_sessions]\n";
   std::cerr << "                [[-p | --port] <port number>]\n";
@@ -75,7 +75,8 @@ class CacheAdminArgHandler {
     kArgMemoryCapRatio = 12,
     kArgListSessions = 13,
     kArgServerInfo = 14,
-    kArgNumArgs = 15  // Must be the last position to provide a count
+    kArgCompress = 15,
+    kArgNumArgs = 16  // Must be the last position to provide a count
   };
 
   Status StartServer();
@@ -61,6 +61,7 @@ CacheClient::CacheClient(session_id_type session_id, uint64_t cache_mem_sz, bool
       server_connection_id_(0),
       client_id_(-1),
       local_bypass_(false),
+      compress_(false),
       num_connections_(num_connections),
       prefetch_size_(prefetch_size),
       fetch_all_keys_(true) {
@@ -391,15 +392,10 @@ Status CacheClient::AsyncBufferStream::Init(CacheClient *cc) {
 
 Status CacheClient::AsyncBufferStream::AsyncWrite(const TensorRow &row) {
   std::vector<ReadableSlice> v;
-  v.reserve(row.size() + 1);
   std::shared_ptr<flatbuffers::FlatBufferBuilder> fbb;
-  RETURN_IF_NOT_OK(::mindspore::dataset::SerializeTensorRowHeader(row, &fbb));
-  int64_t sz = fbb->GetSize();
-  v.emplace_back(fbb->GetBufferPointer(), sz);
-  for (const auto &ts : row) {
-    sz += ts->SizeInBytes();
-    v.emplace_back(ts->GetBuffer(), ts->SizeInBytes());
-  }
+  std::string compressed;
+  int64_t sz = 0;
+  RETURN_IF_NOT_OK(::mindspore::dataset::SerializeTensorRow(row, cc_->CompressRows(), &fbb, &compressed, &v, &sz));
   // If the size is too big, tell the user to send it directly.
   if (sz > kAsyncBufferSize) {
     return Status(StatusCode::kMDNotImplementedYet);
@@ -222,6 +222,11 @@ class CacheClient {
   /// \return boolean value
   bool SupportLocalClient() const { return local_bypass_; }
 
+  /// \brief If the session of the cache is created with compression, the rows are compressed before they are sent to
+  /// the server and decompressed after they are fetched back.
+  /// \return boolean value
+  bool CompressRows() const { return compress_; }
+
   /// \brief Return the base memory address if we attach to any shared memory.
   auto SharedMemoryBaseAddr() const { return comm_->SharedMemoryBaseAddr(); }
 
@@ -284,6 +289,7 @@ class CacheClient {
   std::vector<int32_t> cpu_list_;
   // Comm layer
   bool local_bypass_;
+  bool compress_;
   int32_t num_connections_;
   int32_t prefetch_size_;
   mutable std::shared_ptr<CacheClientGreeter> comm_;
@@ -53,6 +53,9 @@ constexpr static uint32_t kLocalClientSupport = 1;
 /// \brief A flag used by CacheRow request (client side) and BatchFetch (server side) reply to indicate if the data is
 /// inline in the protobuf. This also implies kLocalClientSupport is also true.
 constexpr static uint32_t kDataIsInSharedMemory = 2;
+/// \brief A flag used by the GenerateSessionId request to create a session whose rows are cached compressed. The rows
+/// are compressed and decompressed by the clients, so the server only stores them.
+constexpr static uint32_t kCompressSession = 4;
 /// \brief Size of each message used in message queue.
 constexpr static int32_t kSharedMessageSize = 2048;
 /// \brief The default common path for all users
@@ -14,6 +14,9 @@
  * limitations under the License.
 */
 #include "minddata/dataset/engine/cache/cache_fbb.h"
+#ifdef ENABLE_CACHE
+#include <zlib.h>
+#endif
 namespace mindspore {
 namespace dataset {
 /// A private function used by SerializeTensorRowHeader to serialize each column in a tensor
@@ -63,7 +66,8 @@ Status SerializeOneTensorMeta(const std::shared_ptr<flatbuffers::FlatBufferBuild
   return Status::OK();
 }
 
-Status SerializeTensorRowHeader(const TensorRow &row, std::shared_ptr<flatbuffers::FlatBufferBuilder> *out_fbb) {
+Status SerializeTensorRowHeader(const TensorRow &row, std::shared_ptr<flatbuffers::FlatBufferBuilder> *out_fbb,
+                                int64_t compressed_sz) {
   RETURN_UNEXPECTED_IF_NULL(out_fbb);
   auto fbb = std::make_shared<flatbuffers::FlatBufferBuilder>();
   try {
@@ -86,6 +90,7 @@ Status SerializeTensorRowHeader(const TensorRow &row, std::shared_ptr<flatbuffer
     row_builder.add_data_sz(data_sz_off);
     // Pass the row_id even if it may not be known.
     row_builder.add_row_id(row.getId());
+    row_builder.add_compressed_sz(compressed_sz);
     row_builder.add_size_of_this(-1);  // fill in later after we call Finish.
     auto out = row_builder.Finish();
     fbb->Finish(out);
@@ -102,6 +107,114 @@ Status SerializeTensorRowHeader(const TensorRow &row, std::shared_ptr<flatbuffer
   }
 }
 
+Status CompressTensorRowData(const TensorRow &row, std::string *out) {
+  RETURN_UNEXPECTED_IF_NULL(out);
+  out->clear();
+#ifdef ENABLE_CACHE
+  int64_t total_sz = 0;
+  for (const auto &ts : row) {
+    total_sz += ts->SizeInBytes();
+  }
+  if (total_sz == 0) {
+    return Status::OK();
+  }
+  // Favor speed over ratio, the rows are compressed on the critical path of the pipeline.
+  z_stream zs{};
+  CHECK_FAIL_RETURN_UNEXPECTED(deflateInit(&zs, Z_BEST_SPEED) == Z_OK, "Failed to initialize compression");
+  try {
+    out->resize(deflateBound(&zs, static_cast<uLong>(total_sz)));
+  } catch (const std::bad_alloc &e) {
+    (void)deflateEnd(&zs);
+    return Status(StatusCode::kMDOutOfMemory, __LINE__, __FILE__);
+  }
+  zs.next_out = reinterpret_cast<Bytef *>(out->data());
+  zs.avail_out = static_cast<uInt>(out->size());
+  int rc = Z_OK;
+  for (size_t i = 0; i < row.size() && rc == Z_OK; ++i) {
+    if (row[i]->SizeInBytes() == 0) {
+      continue;
+    }
+    zs.next_in = const_cast<Bytef *>(reinterpret_cast<const Bytef *>(row[i]->GetBuffer()));
+    zs.avail_in = static_cast<uInt>(row[i]->SizeInBytes());
+    rc = deflate(&zs, Z_NO_FLUSH);
+  }
+  if (rc == Z_OK) {
+    rc = deflate(&zs, Z_FINISH);
+  }
+  auto compressed_sz = static_cast<int64_t>(zs.total_out);
+  (void)deflateEnd(&zs);
+  CHECK_FAIL_RETURN_UNEXPECTED(rc == Z_STREAM_END, "Failed to compress tensor row, error code: " + std::to_string(rc));
+  if (compressed_sz >= total_sz) {
+    // Not worth it. The row is cached as it is.
+    out->clear();
+  } else {
+    out->resize(compressed_sz);
+  }
+  return Status::OK();
+#else
+  RETURN_STATUS_UNEXPECTED("Compression is not supported without cache server support.");
+#endif
+}
+
+Status SerializeTensorRow(const TensorRow &row, bool compress, std::shared_ptr<flatbuffers::FlatBufferBuilder> *fbb,
+                          std::string *compressed, std::vector<ReadableSlice> *out, int64_t *sz) {
+  RETURN_UNEXPECTED_IF_NULL(fbb);
+  RETURN_UNEXPECTED_IF_NULL(compressed);
+  RETURN_UNEXPECTED_IF_NULL(out);
+  RETURN_UNEXPECTED_IF_NULL(sz);
+  compressed->clear();
+  if (compress) {
+    RETURN_IF_NOT_OK(CompressTensorRowData(row, compressed));
+  }
+  RETURN_IF_NOT_OK(SerializeTensorRowHeader(row, fbb, static_cast<int64_t>(compressed->size())));
+  out->clear();
+  out->reserve(row.size() + 1);
+  out->emplace_back((*fbb)->GetBufferPointer(), (*fbb)->GetSize());
+  *sz = (*fbb)->GetSize();
+  if (!compressed->empty()) {
+    out->emplace_back(compressed->data(), compressed->size());
+    *sz += compressed->size();
+  } else {
+    for (const auto &ts : row) {
+      out->emplace_back(ts->GetBuffer(), ts->SizeInBytes());
+      *sz += ts->SizeInBytes();
+    }
+  }
+  return Status::OK();
+}
+
+int64_t GetTensorRowDataSize(const TensorRowHeaderMsg *msg, int64_t *uncompressed_sz) {
+  int64_t data_sz = 0;
+  for (auto k = 0; k < msg->data_sz()->size(); ++k) {
+    data_sz += msg->data_sz()->Get(k);
+  }
+  if (uncompressed_sz != nullptr) {
+    *uncompressed_sz = data_sz;
+  }
+  return msg->compressed_sz() > 0 ? msg->compressed_sz() : data_sz;
+}
+
+Status DecompressTensorRowData(const ReadableSlice &data, int64_t uncompressed_sz, std::string *out) {
+  RETURN_UNEXPECTED_IF_NULL(out);
+#ifdef ENABLE_CACHE
+  try {
+    out->resize(uncompressed_sz);
+  } catch (const std::bad_alloc &e) {
+    return Status(StatusCode::kMDOutOfMemory, __LINE__, __FILE__);
+  }
+  auto dest_sz = static_cast<uLongf>(uncompressed_sz);
+  auto rc = uncompress(reinterpret_cast<Bytef *>(out->data()), &dest_sz,
+                       reinterpret_cast<const Bytef *>(data.GetPointer()), static_cast<uLong>(data.GetSize()));
+  CHECK_FAIL_RETURN_UNEXPECTED(rc == Z_OK, "Failed to decompress tensor row, error code: " + std::to_string(rc));
+  CHECK_FAIL_RETURN_UNEXPECTED(static_cast<int64_t>(dest_sz) == uncompressed_sz,
+                               "Length mismatch. Decompressed " + std::to_string(dest_sz) + ". Expected " +
+                                 std::to_string(uncompressed_sz) + ".");
+  return Status::OK();
+#else
+  RETURN_STATUS_UNEXPECTED("Compression is not supported without cache server support.");
+#endif
+}
+
 Status RestoreOneTensor(const TensorMetaMsg *col_ts, const ReadableSlice &data, std::shared_ptr<Tensor> *out) {
   RETURN_UNEXPECTED_IF_NULL(col_ts);
   auto shape_in = col_ts->dims();
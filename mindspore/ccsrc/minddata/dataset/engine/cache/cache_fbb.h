@@ -20,6 +20,7 @@
 /// Google Flatbuffer
 
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 #include "minddata/dataset/engine/cache/de_tensor_generated.h"
@@ -32,8 +33,43 @@ namespace dataset {
 /// \brief Function to serialize TensorRow header used by CacheRowRequest
 /// \param row TensorRow
 /// \param fbb [in/out] fbb that contains the serialized data
+/// \param compressed_sz Size of the compressed data of all the columns, 0 if the data is not compressed
 /// \return Status object
-Status SerializeTensorRowHeader(const TensorRow &row, std::shared_ptr<flatbuffers::FlatBufferBuilder> *fbb);
+Status SerializeTensorRowHeader(const TensorRow &row, std::shared_ptr<flatbuffers::FlatBufferBuilder> *fbb,
+                                int64_t compressed_sz = 0);
+
+/// \brief Serialize a tensor row into the header followed by the data of each column. If compress is true, the data of
+/// all the columns is compressed into one piece, unless it doesn't get smaller.
+/// \param row TensorRow
+/// \param compress If the data is compressed
+/// \param fbb [out] fbb that contains the serialized header
+/// \param compressed [out] Holds the compressed data
+/// \param out [out] The header followed by the data, which point into the row, fbb or compressed
+/// \param sz [out] Total size of the serialized row
+/// \return Status object
+Status SerializeTensorRow(const TensorRow &row, bool compress, std::shared_ptr<flatbuffers::FlatBufferBuilder> *fbb,
+                          std::string *compressed, std::vector<ReadableSlice> *out, int64_t *sz);
+
+/// \brief Size of the data following a serialized tensor row header, which is the size of the compressed data if the
+/// row is compressed
+/// \param msg Serialized tensor row header
+/// \param uncompressed_sz [out] Optional. Total size of the data of all the columns
+/// \return Size of the data
+int64_t GetTensorRowDataSize(const TensorRowHeaderMsg *msg, int64_t *uncompressed_sz = nullptr);
+
+/// \brief Compress the data of all the columns of a tensor row into one buffer. Used by CacheRowRequest for a
+/// session created with compression.
+/// \param row TensorRow
+/// \param out [out] The compressed data. It is left empty if the data doesn't get smaller, e.g. encoded images.
+/// \return Status object
+Status CompressTensorRowData(const TensorRow &row, std::string *out);
+
+/// \brief Decompress the data of all the columns of a tensor row. Used by BatchFetchRequest.
+/// \param data The compressed data
+/// \param uncompressed_sz The total size of the data of all the columns
+/// \param out [out] The data of all the columns
+/// \return Status object
+Status DecompressTensorRowData(const ReadableSlice &data, int64_t uncompressed_sz, std::string *out);
 
 /// \brief A function used by BatchFetchRequest to deserialize a flat buffer back to a tensor row.
 /// \param col_ts A serialized version of Tensor meta data
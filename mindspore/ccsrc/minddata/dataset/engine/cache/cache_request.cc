@@ -40,12 +40,14 @@ Status CacheRowRequest::SerializeCacheRowRequest(const CacheClient *cc, const Te
   CHECK_FAIL_RETURN_UNEXPECTED(cc->SupportLocalClient() == support_local_bypass_, "Local bypass mismatch");
   // Calculate how many bytes (not counting the cookie) we are sending to the server. We only
   // use shared memory (if supported) if we exceed certain amount
+  // The data of the columns is compressed into one piece if the session is created with compression.
   std::shared_ptr<flatbuffers::FlatBufferBuilder> fbb;
-  RETURN_IF_NOT_OK(::mindspore::dataset::SerializeTensorRowHeader(row, &fbb));
-  sz_ += fbb->GetSize();
-  for (const auto &ts : row) {
-    sz_ += ts->SizeInBytes();
-  }
+  std::string compressed;
+  std::vector<ReadableSlice> slices;
+  int64_t row_sz = 0;
+  RETURN_IF_NOT_OK(
+    ::mindspore::dataset::SerializeTensorRow(row, cc->CompressRows(), &fbb, &compressed, &slices, &row_sz));
+  sz_ += row_sz;
   bool sent_using_local_bypass = support_local_bypass_ ? (sz_ >= kLocalByPassThreshold) : false;
   uint32_t flag = 0;
   if (support_local_bypass_) {
@@ -67,19 +69,17 @@ Status CacheRowRequest::SerializeCacheRowRequest(const CacheClient *cc, const Te
     auto p = reinterpret_cast<void *>(reinterpret_cast<int64_t>(base) + addr_);
     // Now we copy the data onto shared memory.
     WritableSlice all(p, sz_);
-    auto offset = fbb->GetSize();
-    ReadableSlice header(fbb->GetBufferPointer(), fbb->GetSize());
-    Status copy_rc = WritableSlice::Copy(&all, header);
-    if (copy_rc.IsOk()) {
-      for (const auto &ts : row) {
-        WritableSlice row_data(all, offset, ts->SizeInBytes());
-        ReadableSlice src(ts->GetBuffer(), ts->SizeInBytes());
-        copy_rc = WritableSlice::Copy(&row_data, src);
-        if (copy_rc.IsError()) {
-          break;
-        }
-        offset += ts->SizeInBytes();
+    size_t offset = 0;
+    Status copy_rc;
+    for (const auto &src : slices) {
+      WritableSlice row_data(all, offset, src.GetSize());
+      copy_rc = WritableSlice::Copy(&row_data, src);
+      if (copy_rc.IsError()) {
+        break;
       }
+      offset += src.GetSize();
+    }
+    if (copy_rc.IsOk()) {
       // Fill in where to find the data
       AddDataLocation();
     }
@@ -96,9 +96,8 @@ Status CacheRowRequest::SerializeCacheRowRequest(const CacheClient *cc, const Te
   } else {
     // We have already filled the first buffer which is the cookie.
     sz_ += rq_.buf_data(0).size();
-    rq_.add_buf_data(fbb->GetBufferPointer(), fbb->GetSize());
-    for (const auto &ts : row) {
-      rq_.add_buf_data(ts->GetBuffer(), ts->SizeInBytes());
+    for (const auto &src : slices) {
+      rq_.add_buf_data(src.GetPointer(), src.GetSize());
     }
     MS_LOG(DEBUG) << "Sending " << sz_ << " bytes of tensor data in " << rq_.buf_data_size() << " segments";
   }
@@ -187,11 +186,22 @@ Status BatchFetchRequest::RestoreRows(TensorTable *out, const void *baseAddr, in
       auto msg_sz = msg->size_of_this();
       // Start of the tensor data
       auto ts_offset = msg_sz;
+      ReadableSlice all_data(row_data, ts_offset, len - ts_offset);
+      // The server keeps the compressed rows as they are, we decompress them here to keep the server cpu free.
+      std::string decompressed;
+      if (msg->compressed_sz() > 0) {
+        int64_t uncompressed_sz = 0;
+        (void)GetTensorRowDataSize(msg, &uncompressed_sz);
+        ReadableSlice compressed(row_data, ts_offset, msg->compressed_sz());
+        RETURN_IF_NOT_OK(DecompressTensorRowData(compressed, uncompressed_sz, &decompressed));
+        all_data = ReadableSlice(decompressed.data(), decompressed.size());
+      }
+      ts_offset = 0;
       row.reserve(msg->column()->size());
       for (auto k = 0; k < msg->column()->size(); ++k) {
         auto col_ts = msg->column()->Get(k);
         std::shared_ptr<Tensor> ts;
-        ReadableSlice data(row_data, ts_offset, msg->data_sz()->Get(k));
+        ReadableSlice data(all_data, ts_offset, msg->data_sz()->Get(k));
         RETURN_IF_NOT_OK(mindspore::dataset::RestoreOneTensor(col_ts, data, &ts));
         row.push_back(ts);
         ts_offset += data.GetSize();
@@ -233,6 +243,7 @@ Status CreateCacheRequest::PostReply() {
   cc_->server_connection_id_ = p->connection_id();
   cc_->cookie_ = p->cookie()->str();
   cc_->client_id_ = p->client_id();
+  cc_->compress_ = p->compress();
   // Next is a set of cpu id that we should re-adjust ourselves for better affinity.
   auto sz = p->cpu_id()->size();
   cc_->cpu_list_.reserve(sz);
@@ -303,6 +314,10 @@ Status GetStatRequest::PostReply() {
   stat_.max_row_id = msg->max_row_id();
   stat_.min_row_id = msg->min_row_id();
   stat_.cache_service_state = msg->state();
+  stat_.num_mem_hit = msg->num_mem_hit();
+  stat_.num_disk_hit = msg->num_disk_hit();
+  stat_.uncompressed_sz = msg->uncompressed_sz();
+  stat_.stored_sz = msg->stored_sz();
   return Status::OK();
 }
 
@@ -315,6 +330,13 @@ Status GetCacheStateRequest::PostReply() {
   return Status::OK();
 }
 
+GenerateSessionIdRequest::GenerateSessionIdRequest(bool compress) : BaseRequest(RequestType::kGenerateSessionId) {
+  // We don't have anything client info nor connection id to send. But we will manually
+  // set the connection id to 0.
+  rq_.set_connection_id(0);
+  rq_.set_flag(compress ? kCompressSession : 0);
+}
+
 Status ListSessionsRequest::PostReply() {
   auto *msg = flatbuffers::GetRoot<ListSessionsMsg>(reply_.result().data());
   auto session_vector = msg->sessions();
@@ -331,6 +353,11 @@ Status ListSessionsRequest::PostReply() {
     stats.min_row_id = current_session_info->stats()->min_row_id();
     stats.max_row_id = current_session_info->stats()->max_row_id();
     stats.cache_service_state = current_session_info->stats()->state();
+    stats.num_mem_hit = current_session_info->stats()->num_mem_hit();
+    stats.num_disk_hit = current_session_info->stats()->num_disk_hit();
+    stats.uncompressed_sz = current_session_info->stats()->uncompressed_sz();
+    stats.stored_sz = current_session_info->stats()->stored_sz();
+    current_info.compress = current_session_info->compress();
     current_info.stats = stats;  // fixed length struct.  = operator is safe
     session_info_list_.push_back(current_info);
   }
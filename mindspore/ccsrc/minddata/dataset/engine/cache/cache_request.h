@@ -45,6 +45,10 @@ struct CacheServiceStat {
   row_id_type min_row_id;
   row_id_type max_row_id;
   int8_t cache_service_state;
+  int64_t num_mem_hit;
+  int64_t num_disk_hit;
+  int64_t uncompressed_sz;
+  int64_t stored_sz;
 };
 
 struct CacheServerCfgInfo {
@@ -58,6 +62,7 @@ struct SessionCacheInfo {
   session_id_type session_id;
   connection_id_type connection_id;
   CacheServiceStat stats;
+  bool compress;
 };
 
 /// \brief CacheClient communicates with CacheServer using Requests.
@@ -384,11 +389,8 @@ class DropSessionRequest : public BaseRequest {
 class GenerateSessionIdRequest : public BaseRequest {
  public:
   friend class CacheServer;
-  GenerateSessionIdRequest() : BaseRequest(RequestType::kGenerateSessionId) {
-    // We don't have anything client info nor connection id to send. But we will manually
-    // set the connection id to 0.
-    rq_.set_connection_id(0);
-  }
+  /// \param compress The caches of the new session keep the rows compressed
+  explicit GenerateSessionIdRequest(bool compress = false);
 
   ~GenerateSessionIdRequest() override = default;
 
@@ -19,6 +19,7 @@
 #include <limits>
 #include <vector>
 #include "minddata/dataset/include/dataset/constants.h"
+#include "minddata/dataset/engine/cache/cache_fbb.h"
 #include "minddata/dataset/engine/cache/cache_ipc.h"
 #include "minddata/dataset/engine/cache/cache_service.h"
 #include "minddata/dataset/engine/cache/cache_request.h"
@@ -196,6 +197,7 @@ Status CacheServer::CreateService(CacheRequest *rq, CacheReply *reply) {
   if (session_it == active_sessions_.end()) {
     RETURN_STATUS_UNEXPECTED("A cache creation has been requested but the session was not found!");
   }
+  bool compress = compressed_sessions_.count(session_id) > 0;
 
   // We concat both numbers to form the internal connection id.
   auto connection_id = GetConnectionID(session_id, crc);
@@ -233,7 +235,7 @@ Status CacheServer::CreateService(CacheRequest *rq, CacheReply *reply) {
     RETURN_IF_NOT_OK(GlobalMemoryCheck(cache_mem_sz));
     std::unique_ptr<CacheService> cs;
     try {
-      cs = std::make_unique<CacheService>(cache_mem_sz, spill ? top_ : "", generate_id);
+      cs = std::make_unique<CacheService>(cache_mem_sz, spill ? top_ : "", generate_id, compress);
       RETURN_IF_NOT_OK(cs->ServiceStart());
       cookie = cs->cookie();
       client_id = cs->num_clients_.fetch_add(1);
@@ -261,6 +263,7 @@ Status CacheServer::CreateService(CacheRequest *rq, CacheReply *reply) {
   bld.add_client_id(client_id);
   // The last thing we send back is a set of cpu id that we suggest the client should bind itself to
   bld.add_cpu_id(off_cpu_list);
+  bld.add_compress(compress);
   auto off = bld.Finish();
   fbb.Finish(off);
   reply->set_result(fbb.GetBufferPointer(), fbb.GetSize());
@@ -578,6 +581,10 @@ Status CacheServer::GetStat(CacheRequest *rq, CacheReply *reply) {
     bld.add_max_row_id(svc_stat.stat_.max_key);
     bld.add_min_row_id(svc_stat.stat_.min_key);
     bld.add_state(svc_stat.state_);
+    bld.add_num_mem_hit(svc_stat.num_mem_hit_);
+    bld.add_num_disk_hit(svc_stat.num_disk_hit_);
+    bld.add_uncompressed_sz(svc_stat.uncompressed_sz_);
+    bld.add_stored_sz(svc_stat.stored_sz_);
     auto offset = bld.Finish();
     fbb.Finish(offset);
     reply->set_result(fbb.GetBufferPointer(), fbb.GetSize());
@@ -702,6 +709,7 @@ Status CacheServer::ListSessions(CacheReply *reply) {
   std::vector<flatbuffers::Offset<ListSessionMsg>> session_msgs_vector;
   for (auto const &current_session_id : active_sessions_) {
     bool found = false;
+    bool compress = compressed_sessions_.count(current_session_id) > 0;
     for (auto const &it : all_caches_) {
       auto current_conn_id = it.first;
       if (GetSessionID(current_conn_id) == current_session_id) {
@@ -711,15 +719,18 @@ Status CacheServer::ListSessions(CacheReply *reply) {
         RETURN_IF_NOT_OK(cs->GetStat(&svc_stat));
         auto current_stats = CreateServiceStatMsg(fbb, svc_stat.stat_.num_mem_cached, svc_stat.stat_.num_disk_cached,
                                                   svc_stat.stat_.average_cache_sz, svc_stat.stat_.num_numa_hit,
-                                                  svc_stat.stat_.min_key, svc_stat.stat_.max_key, svc_stat.state_);
-        auto current_session_info = CreateListSessionMsg(fbb, current_session_id, current_conn_id, current_stats);
+                                                  svc_stat.stat_.min_key, svc_stat.stat_.max_key, svc_stat.state_,
+                                                  svc_stat.num_mem_hit_, svc_stat.num_disk_hit_,
+                                                  svc_stat.uncompressed_sz_, svc_stat.stored_sz_);
+        auto current_session_info =
+          CreateListSessionMsg(fbb, current_session_id, current_conn_id, current_stats, compress);
         session_msgs_vector.push_back(current_session_info);
       }
     }
     if (!found) {
       // If there is no cache created yet, assign a connection id of 0 along with empty stats
       auto current_stats = CreateServiceStatMsg(fbb, 0, 0, 0, 0, 0, 0);
-      auto current_session_info = CreateListSessionMsg(fbb, current_session_id, 0, current_stats);
+      auto current_session_info = CreateListSessionMsg(fbb, current_session_id, 0, current_stats, compress);
       session_msgs_vector.push_back(current_session_info);
     }
   }
@@ -773,10 +784,7 @@ Status CacheServer::BatchCacheRows(CacheRequest *rq) {
     for (auto i = 0; i < num_elem; ++i) {
       auto start = reinterpret_cast<int64_t>(p);
       auto msg = GetTensorRowHeaderMsg(p);
-      p += msg->size_of_this();
-      for (auto k = 0; k < msg->column()->size(); ++k) {
-        p += msg->data_sz()->Get(k);
-      }
+      p += msg->size_of_this() + GetTensorRowDataSize(msg);
       CacheServerRequest *cache_rq;
       RETURN_IF_NOT_OK(GetFreeRequestTag(&cache_rq));
       // Fill in details.
@@ -850,7 +858,7 @@ Status CacheServer::ProcessSessionRequest(CacheServerRequest *cache_req) {
       break;
     }
     case BaseRequest::RequestType::kGenerateSessionId: {
-      cache_req->rc_ = GenerateClientSessionID(GenerateSessionID(), &reply);
+      cache_req->rc_ = GenerateClientSessionID(GenerateSessionID(BitTest(rq.flag(), kCompressSession)), &reply);
       break;
     }
     case BaseRequest::RequestType::kListSessions: {
@@ -1081,6 +1089,7 @@ Status CacheServer::DestroySession(CacheRequest *rq) {
   }
   // Finally remove the session itself
   auto n = active_sessions_.erase(drop_session_id);
+  (void)compressed_sessions_.erase(drop_session_id);
   if (n > 0) {
     MS_LOG(INFO) << "Session destroyed with id " << drop_session_id;
     return Status::OK();
@@ -1097,7 +1106,7 @@ Status CacheServer::DestroySession(CacheRequest *rq) {
   }
 }
 
-session_id_type CacheServer::GenerateSessionID() {
+session_id_type CacheServer::GenerateSessionID(bool compress) {
   UniqueLock sess_lck(&sessions_lock_);
   auto mt = GetRandomDevice();
   std::uniform_int_distribution<session_id_type> distribution(0, std::numeric_limits<session_id_type>::max());
@@ -1108,6 +1117,9 @@ session_id_type CacheServer::GenerateSessionID() {
     auto r = active_sessions_.insert(session_id);
     duplicate = !r.second;
   } while (duplicate);
+  if (compress) {
+    (void)compressed_sessions_.insert(session_id);
+  }
   return session_id;
 }
 
@@ -283,6 +283,7 @@ class CacheServer : public Service {
   std::string top_;
   cache_index all_caches_;
   std::set<session_id_type> active_sessions_;
+  std::set<session_id_type> compressed_sessions_;
   std::shared_ptr<QueueList<CacheServerRequest *>> cache_q_;
   std::shared_ptr<CacheServerGreeterImpl> comm_layer_;
   TaskGroup vg_;
@@ -347,8 +348,9 @@ class CacheServer : public Service {
   session_id_type GetSessionID(connection_id_type connection_id) const;
 
   /// \brief Generate a session ID for the client
+  /// \param compress The rows of the caches of this session are compressed
   /// \return Session ID
-  session_id_type GenerateSessionID();
+  session_id_type GenerateSessionID(bool compress);
 
   /// \brief Handle kAllocateSharedBlock request
   /// \param rq CacheRequest
@@ -15,6 +15,7 @@
 */
 #include <random>
 #include "minddata/dataset/engine/cache/cache_service.h"
+#include "minddata/dataset/engine/cache/cache_fbb.h"
 #include "minddata/dataset/engine/cache/cache_server.h"
 #include "minddata/dataset/engine/cache/cache_numa.h"
 #include "minddata/dataset/util/random.h"
@@ -22,14 +23,19 @@
 
 namespace mindspore {
 namespace dataset {
-CacheService::CacheService(uint64_t mem_sz, const std::string &root, bool generate_id)
+CacheService::CacheService(uint64_t mem_sz, const std::string &root, bool generate_id, bool compress)
     : root_(root),
       cache_mem_sz_(mem_sz * 1048576L),  // mem_sz is in MB unit
       cp_(nullptr),
       next_id_(0),
       generate_id_(generate_id),
       num_clients_(0),
-      st_(generate_id ? CacheServiceState::kBuildPhase : CacheServiceState::kNone) {}
+      st_(generate_id ? CacheServiceState::kBuildPhase : CacheServiceState::kNone),
+      compress_(compress),
+      num_mem_hit_(0),
+      num_disk_hit_(0),
+      uncompressed_sz_(0),
+      stored_sz_(0) {}
 
 CacheService::~CacheService() { (void)ServiceStop(); }
 
@@ -104,22 +110,33 @@ Status CacheService::CacheRow(const std::vector<const void *> &buf, row_id_type
     auto size_of_this = msg->size_of_this();
     size_t total_sz = size_of_this;
     auto column_hdr = msg->column();
-    // Number of tensor buffer should match the number of columns plus one.
-    if (buf.size() != column_hdr->size() + 1) {
-      std::string errMsg = "Column count does not match. Expect " + std::to_string(column_hdr->size() + 1) +
-                           " but get " + std::to_string(buf.size());
+    // Number of tensor buffer should match the number of columns plus one. A compressed row has the data of all the
+    // columns in one buffer.
+    bool compressed = msg->compressed_sz() > 0;
+    size_t num_data_buf = compressed ? 1 : column_hdr->size();
+    if (buf.size() != num_data_buf + 1) {
+      std::string errMsg = "Column count does not match. Expect " + std::to_string(num_data_buf + 1) + " but get " +
+                           std::to_string(buf.size());
       RETURN_STATUS_UNEXPECTED(errMsg);
     }
     // Next we store in either memory or on disk. Low level code will consolidate everything in one piece.
     std::vector<ReadableSlice> all_data;
-    all_data.reserve(column_hdr->size() + 1);
+    all_data.reserve(num_data_buf + 1);
     all_data.emplace_back(fb, size_of_this);
-    for (auto i = 0; i < column_hdr->size(); ++i) {
-      all_data.emplace_back(buf.at(i + 1), msg->data_sz()->Get(i));
-      total_sz += msg->data_sz()->Get(i);
+    if (compressed) {
+      all_data.emplace_back(buf.at(1), msg->compressed_sz());
+      total_sz += msg->compressed_sz();
+    } else {
+      for (auto i = 0; i < column_hdr->size(); ++i) {
+        all_data.emplace_back(buf.at(i + 1), msg->data_sz()->Get(i));
+        total_sz += msg->data_sz()->Get(i);
+      }
     }
     // Now we cache the buffer.
     Status rc = cp_->Insert(*row_id_generated, all_data);
+    if (rc.IsOk()) {
+      RecordCachedRow(msg);
+    }
     if (rc == Status(StatusCode::kMDDuplicateKey)) {
       MS_LOG(DEBUG) << "Ignoring duplicate key.";
     } else {
@@ -156,6 +173,7 @@ Status CacheService::FastCacheRow(const ReadableSlice &src, row_id_type *row_id_
     return Status(StatusCode::kMDOutOfMemory);
   }
   try {
+    auto msg = GetTensorRowHeaderMsg(src.GetPointer());
     // If we don't need to generate id, we need to find it from the buffer.
     if (generate_id_) {
       *row_id_generated = GetNextRowId();
@@ -165,7 +183,6 @@ Status CacheService::FastCacheRow(const ReadableSlice &src, row_id_type *row_id_
         MS_LOG(DEBUG) << "Number of rows cached: " << ((*row_id_generated) + 1);
       }
     } else {
-      auto msg = GetTensorRowHeaderMsg(src.GetPointer());
       if (msg->row_id() < 0) {
         std::string errMsg = "Expect positive row id: " + std::to_string(msg->row_id());
         RETURN_STATUS_UNEXPECTED(errMsg);
@@ -174,6 +191,9 @@ Status CacheService::FastCacheRow(const ReadableSlice &src, row_id_type *row_id_
     }
     // Now we cache the buffer.
     Status rc = cp_->Insert(*row_id_generated, {src});
+    if (rc.IsOk()) {
+      RecordCachedRow(msg);
+    }
     if (rc == Status(StatusCode::kMDDuplicateKey)) {
       MS_LOG(DEBUG) << "Ignoring duplicate key.";
     } else {
@@ -229,9 +249,20 @@ Status CacheService::GetStat(CacheService::ServiceStat *out) {
   RETURN_UNEXPECTED_IF_NULL(out);
   out->stat_ = cp_->GetStat();
   out->state_ = static_cast<ServiceStat::state_type>(st_.load());
+  out->num_mem_hit_ = num_mem_hit_;
+  out->num_disk_hit_ = num_disk_hit_;
+  out->uncompressed_sz_ = uncompressed_sz_;
+  out->stored_sz_ = stored_sz_;
   return Status::OK();
 }
 
+void CacheService::RecordCachedRow(const TensorRowHeaderMsg *msg) {
+  int64_t uncompressed_sz = 0;
+  int64_t data_sz = GetTensorRowDataSize(msg, &uncompressed_sz);
+  uncompressed_sz_ += msg->size_of_this() + uncompressed_sz;
+  stored_sz_ += msg->size_of_this() + data_sz;
+}
+
 Status CacheService::PreBatchFetch(connection_id_type connection_id, const std::vector<row_id_type> &v,
                                    const std::shared_ptr<flatbuffers::FlatBufferBuilder> &fbb) {
   SharedLock rw(&rw_lock_);
@@ -270,8 +301,10 @@ Status CacheService::InternalFetchRow(const FetchRowMsg *p) {
     // This saves another tree lookup and is faster.
     ReadableSlice src(source_addr, sz);
     RETURN_IF_NOT_OK(WritableSlice::Copy(&dest, src));
+    ++num_mem_hit_;
   } else {
     RETURN_IF_NOT_OK(cp_->Read(key, &dest, &bytesRead));
+    ++num_disk_hit_;
     if (bytesRead != sz) {
       std::string errMsg = "Unexpected length. Read " + std::to_string(bytesRead) + ". Expected " + std::to_string(sz) +
                            "." + " Internal key: " + std::to_string(key);
@@ -49,7 +49,8 @@ class CacheService : public Service {
   /// \param root Spill path. Empty string means no spilling
   /// \param generate_id If the cache service should generate row id for buffer that is cached.
   /// For non-mappable dataset, this should be set to true.
-  CacheService(uint64_t mem_sz, const std::string &root, bool generate_id);
+  /// \param compress If the clients cache the rows compressed. The server only keeps the statistics.
+  CacheService(uint64_t mem_sz, const std::string &root, bool generate_id, bool compress = false);
   ~CacheService() override;
 
   Status DoServiceStart() override;
@@ -86,6 +87,10 @@ class CacheService : public Service {
     ~ServiceStat() = default;
     CachePool::CacheStat stat_{};
     state_type state_;
+    int64_t num_mem_hit_{0};      // number of rows fetched from memory
+    int64_t num_disk_hit_{0};     // number of rows fetched from disk
+    int64_t uncompressed_sz_{0};  // total size of the rows cached before compression
+    int64_t stored_sz_{0};        // total size of the rows cached
   };
   /// \brief Statistics for the current service
   /// \param[in/out] A pointer to a pre-allocated ServiceStat structure
@@ -123,6 +128,8 @@ class CacheService : public Service {
   Status BuildPhaseDone();
   /// \brief For kToggleWriteMode request
   Status ToggleWriteMode(bool on_off);
+  /// \brief If the rows of this cache are compressed by the clients
+  bool IsCompressed() const { return compress_; }
 
  private:
   mutable RWLock rw_lock_;
@@ -136,6 +143,11 @@ class CacheService : public Service {
   std::atomic<CacheServiceState> st_;
   std::string schema_;
   std::shared_ptr<NumaMemoryPool> numa_pool_;
+  bool compress_;
+  std::atomic<int64_t> num_mem_hit_;
+  std::atomic<int64_t> num_disk_hit_;
+  std::atomic<int64_t> uncompressed_sz_;
+  std::atomic<int64_t> stored_sz_;
   // We also cache the result from calling FindKeysMiss because it is expensive. Besides user make
   // this request after we hit memory full or disk full. So the result is unlikely to change.
   std::mutex get_key_miss_mux_;
@@ -145,6 +157,9 @@ class CacheService : public Service {
   row_id_type GetNextRowId() { return next_id_.fetch_add(1); }
 
   Status InternalFetchRow(const FetchRowMsg *p);
+
+  /// \brief Record the size of a row cached successfully for the compression ratio
+  void RecordCachedRow(const TensorRowHeaderMsg *msg);
 };
 }  // namespace dataset
 }  // namespace mindspore
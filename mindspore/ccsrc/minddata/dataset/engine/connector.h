@@ -16,11 +16,13 @@
 #ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CONNECTOR_H_
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CONNECTOR_H_
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 #include "minddata/dataset/util/task_manager.h"
+#include "minddata/dataset/util/lock_free_ring.h"
 #include "minddata/dataset/util/queue.h"
 #include "minddata/dataset/util/services.h"
 #include "minddata/dataset/util/cond_var.h"
@@ -50,6 +52,12 @@ namespace dataset {
 //        - The caller thread of pop() is not equal to the _expectConsumer. This is to enforce
 //          the ordering.
 //
+// Unordered mode:
+//   When the order of the elements does not matter (e.g. the data is shuffled anyway), the Connector can be
+//   created with ordered = false. Each producer then pushes to its own lock free ring, and a consumer pops
+//   from the ring of its own id first and steals from the other rings when it is empty. Consumers never wait
+//   for each other, and only block when all the rings are empty.
+//
 // Future improvement:
 //   1. Fault tolerant: Right now, if one of the worker dies, the Connector will not work
 //      properly.
@@ -71,8 +79,9 @@ class Connector {
   // @param n_producers The number of threads producing data into this DbConnector.
   // @param n_consumers The number of thread consuming data from this DbConnector.
   // @param queue_capacity The number of element for each queue.
-  Connector(int32_t n_producers, int32_t n_consumers, int32_t queue_capacity)
-      : num_producers_(n_producers), num_consumers_(n_consumers) {
+  // @param ordered Whether the consumers pop the elements in the order of the producers.
+  Connector(int32_t n_producers, int32_t n_consumers, int32_t queue_capacity, bool ordered = true)
+      : num_producers_(n_producers), num_consumers_(n_consumers), ordered_(ordered) {
     MS_LOG(DEBUG) << "A connector is created with " << n_producers << " producers and " << n_consumers << " consumers.";
     my_name_ = Services::GetUniqueID();
     // We require the consumers to have ids sequentially from 0 to the num_consumers_-1,
@@ -82,9 +91,16 @@ class Connector {
     // Roundrobin pop starts from index 0 of the queues_.
     pop_from_ = 0;
 
-    // Initialize the queues_ to have num_producers_ number of queues.
-    // Each queue is a blocking queue and has the same queue_capacity.
-    queues_.Init(num_producers_, queue_capacity);
+    if (ordered_) {
+      // Initialize the queues_ to have num_producers_ number of queues.
+      // Each queue is a blocking queue and has the same queue_capacity.
+      queues_.Init(num_producers_, queue_capacity);
+    } else {
+      rings_.reserve(num_producers_);
+      for (int32_t i = 0; i < num_producers_; ++i) {
+        rings_.emplace_back(std::make_unique<ProducerRing>(queue_capacity));
+      }
+    }
   }
 
   // Destructor of Connector
@@ -96,6 +112,9 @@ class Connector {
   // @param result The address of an object where the popped element will be placed.
   virtual Status Pop(int32_t worker_id,  // The worker-id of the caller. See the requirement at the top of this file.
                      T *result) noexcept {
+    if (!ordered_) {
+      return PopUnordered(worker_id, result);
+    }
     {
       MS_ASSERT(worker_id < num_consumers_);
       std::unique_lock<std::mutex> lk(m_);
@@ -116,6 +135,10 @@ class Connector {
   // @param worker_id The id of a worker thread calling this method.
   // @param el A const lvalue element to be passed/added/pushed.
   Status Push(int32_t worker_id, const T &el) noexcept {
+    if (!ordered_) {
+      T copy = el;
+      return PushUnordered(worker_id, std::move(copy));
+    }
     MS_ASSERT(worker_id < static_cast<int32_t>(queues_.size()));
     MS_ASSERT(queues_[worker_id] != nullptr);
     return (queues_[worker_id]->Add(el));
@@ -129,6 +152,9 @@ class Connector {
   // @param worker_id The id of a worker thread calling this method.
   // @param el An element to be passed/added/pushed.
   virtual Status Push(int32_t worker_id, T &&el) noexcept {
+    if (!ordered_) {
+      return PushUnordered(worker_id, std::forward<T>(el));
+    }
     MS_ASSERT(worker_id < static_cast<int32_t>(queues_.size()));
     MS_ASSERT(queues_[worker_id] != nullptr);
     return (queues_[worker_id]->Add(std::forward<T>(el)));
@@ -140,6 +166,9 @@ class Connector {
     for (size_t i = 0; i < queues_.size(); ++i) {
       queues_[i]->Reset();
     }
+    for (auto &ring : rings_) {
+      ring->ring_.Reset();
+    }
     expect_consumer_ = 0;
     pop_from_ = 0;
     out_buffers_count_ = 0;
@@ -149,7 +178,7 @@ class Connector {
   void Print(std::ostream &out, bool showAll) const {
     out << "\n--------- Connector ------------"
         << "\nConnector Name           : " << my_name_ << "\nNumber of consumers      : " << num_consumers_
-        << "\nNumber of producers      : " << num_producers_ << "\n";
+        << "\nNumber of producers      : " << num_producers_ << "\nOrdered                  : " << ordered_ << "\n";
   }
 
   friend std::ostream &operator<<(std::ostream &out, const Connector &con) {
@@ -163,6 +192,9 @@ class Connector {
     for (size_t i = 0; i < queues_.size(); ++i) {
       size += queues_[i]->size();
     }
+    for (const auto &ring : rings_) {
+      size += ring->ring_.size();
+    }
     return size;
   }
 
@@ -171,6 +203,9 @@ class Connector {
     for (size_t i = 0; i < queues_.size(); ++i) {
       capacity += queues_[i]->capacity();
     }
+    for (const auto &ring : rings_) {
+      capacity += ring->ring_.capacity();
+    }
     return capacity;
   }
 
@@ -182,9 +217,14 @@ class Connector {
     if (rc.IsOk()) {
       rc = cv_.Register(vg->GetIntrpService());
     }
+    for (size_t i = 0; i < rings_.size() && rc.IsOk(); ++i) {
+      rc = rings_[i]->full_cv_.Register(vg->GetIntrpService());
+    }
     return rc;
   }
 
+  bool ordered() const { return ordered_; }
+
  protected:
   std::string my_name_;
 
@@ -200,10 +240,88 @@ class Connector {
   int32_t num_producers_;
   int32_t num_consumers_;
 
+  // The ring owned by one producer in unordered mode. The producer blocks on its own condition variable
+  // when the ring is full, so that a pop only wakes up the producer of the ring it pops from.
+  struct ProducerRing {
+    explicit ProducerRing(int32_t capacity) : ring_(capacity) {}
+    LockFreeRing<T> ring_;
+    std::atomic<bool> full_waiting_ = false;
+    CondVar full_cv_;
+  };
+
+  // In unordered mode, each producer owns a ring in rings_ and queues_ is not used.
+  bool ordered_;
+  std::vector<std::unique_ptr<ProducerRing>> rings_;
+  // The number of consumers blocked on an empty connector, so that the producers only take the lock to
+  // notify them when there is someone waiting.
+  std::atomic<int32_t> num_empty_waiters_ = 0;
+
   // Used in the Pop(), when a thread call pop() but it is not the expect_consumer_.
   std::mutex m_;
   CondVar cv_;
   std::atomic<std::int64_t> out_buffers_count_ = 0;
+
+ private:
+  // Pop from the ring of the caller first, then steal from the rings of the other producers.
+  ProducerRing *TryPopAnyRing(int32_t worker_id, T *result) {
+    auto num_rings = rings_.size();
+    for (size_t i = 0; i < num_rings; ++i) {
+      auto &ring = rings_[(static_cast<size_t>(worker_id) + i) % num_rings];
+      if (ring->ring_.TryPop(result)) {
+        return ring.get();
+      }
+    }
+    return nullptr;
+  }
+
+  bool AllRingsEmpty() const {
+    for (const auto &ring : rings_) {
+      if (!ring->ring_.empty()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  Status PopUnordered(int32_t worker_id, T *result) noexcept {
+    MS_ASSERT(worker_id < num_consumers_);
+    ProducerRing *ring = nullptr;
+    while ((ring = TryPopAnyRing(worker_id, result)) == nullptr) {
+      std::unique_lock<std::mutex> lk(m_);
+      ++num_empty_waiters_;
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      Status rc = cv_.Wait(&lk, [this]() { return !AllRingsEmpty(); });
+      --num_empty_waiters_;
+      RETURN_IF_NOT_OK(rc);
+    }
+    out_buffers_count_++;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (ring->full_waiting_) {
+      // Take the lock so that the notification can not fall in between the check and the wait of the producer.
+      { std::unique_lock<std::mutex> lk(m_); }
+      ring->full_cv_.NotifyOne();
+    }
+    return Status::OK();
+  }
+
+  Status PushUnordered(int32_t worker_id, T &&el) noexcept {
+    MS_ASSERT(worker_id < static_cast<int32_t>(rings_.size()));
+    auto &ring = rings_[worker_id];
+    if (!ring->ring_.TryPush(std::forward<T>(el))) {
+      std::unique_lock<std::mutex> lk(m_);
+      ring->full_waiting_ = true;
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      Status rc = ring->full_cv_.Wait(&lk, [&ring, &el]() { return ring->ring_.TryPush(std::forward<T>(el)); });
+      ring->full_waiting_ = false;
+      RETURN_IF_NOT_OK(rc);
+    }
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (num_empty_waiters_ > 0) {
+      { std::unique_lock<std::mutex> lk(m_); }
+      cv_.NotifyOne();
+    }
+    return Status::OK();
+  }
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -25,6 +25,9 @@
 #include "minddata/dataset/core/global_context.h"
 
 #include "minddata/dataset/engine/datasetops/map_op/cpu_map_job.h"
+#ifdef ENABLE_PYTHON
+#include "minddata/dataset/kernels/py_func_op.h"
+#endif
 #include "minddata/dataset/kernels/tensor_op.h"
 #include "minddata/dataset/util/log_adapter.h"
 #include "minddata/dataset/util/task_manager.h"
@@ -406,7 +409,17 @@ Status MapOp::RemoveWorkers(int32_t num_workers) {
   }
   return Status::OK();
 }
-void MapOp::SetPythonMp(std::shared_ptr<PythonMultiprocessingRuntime> python_mp) { python_mp_ = std::move(python_mp); }
+void MapOp::SetPythonMp(std::shared_ptr<PythonMultiprocessingRuntime> python_mp) {
+  python_mp_ = std::move(python_mp);
+#ifdef ENABLE_PYTHON
+  // the input of the pyfuncs is copied to the worker processes, it is not copied again when it is converted to numpy.
+  for (auto &op : tfuncs_) {
+    if (op->Name() == kPyFuncOp) {
+      std::static_pointer_cast<PyFuncOp>(op)->SetZeroCopyInput(python_mp_ != nullptr);
+    }
+  }
+#endif
+}
 
 Status MapOp::Launch() {
   // launch python multiprocessing. This will create the MP pool and shared memory if needed.
@@ -44,7 +44,7 @@ Status ClueOp::Init() {
   int32_t safe_queue_size = static_cast<int32_t>(std::ceil(clue_files_list_.size() / num_workers_) + 1);
   io_block_queues_.Init(num_workers_, safe_queue_size);
 
-  jagged_rows_connector_ = std::make_unique<JaggedConnector>(num_workers_, 1, worker_connector_size_);
+  CreateJaggedConnector();
 
   return Status::OK();
 }
@@ -62,8 +62,9 @@ MindRecordOp::MindRecordOp(int32_t num_mind_record_workers, std::vector<std::str
 
 // Private helper method to encapsulate some common construction/reset tasks
 Status MindRecordOp::Init() {
+  use_mmap_ = GlobalContext::config_manager()->mindrecord_mmap();
   RETURN_IF_NOT_OK(shard_reader_->Open(dataset_file_, load_dataset_, num_mind_record_workers_, columns_to_load_,
-                                       operators_, num_padded_));
+                                       operators_, num_padded_, false, use_mmap_));
 
   data_schema_ = std::make_unique<DataSchema>();
 
@@ -182,11 +183,14 @@ Status MindRecordOp::WorkerEntry(int32_t worker_id) {
 
 Status MindRecordOp::GetRowFromReader(TensorRow *fetched_row, uint64_t row_id, int32_t worker_id) {
   *fetched_row = {};
+  if (use_mmap_) {
+    return GetRowFromBlobView(fetched_row, row_id, worker_id);
+  }
   auto rc = shard_reader_->GetNextById(row_id, worker_id);
   auto task_type = rc.first;
-  auto tupled_buffer = rc.second;
+  const auto &tupled_buffer = rc.second;
   if (task_type == mindrecord::TaskType::kPaddedTask) {
-    RETURN_IF_NOT_OK(LoadTensorRow(fetched_row, {}, mindrecord::json(), task_type));
+    RETURN_IF_NOT_OK(LoadTensorRow(fetched_row, nullptr, 0, mindrecord::json(), task_type));
     std::vector<std::string> file_path(fetched_row->size(), dataset_file_[0]);
     fetched_row->setPath(file_path);
     fetched_row->setId(row_id);
@@ -196,9 +200,10 @@ Status MindRecordOp::GetRowFromReader(TensorRow *fetched_row, uint64_t row_id, i
   }
   if (task_type == mindrecord::TaskType::kCommonTask) {
     for (const auto &tupled_row : tupled_buffer) {
-      std::vector<uint8_t> columns_blob = std::get<0>(tupled_row);
-      mindrecord::json columns_json = std::get<1>(tupled_row);
-      RETURN_IF_NOT_OK(LoadTensorRow(fetched_row, columns_blob, columns_json, task_type));
+      const std::vector<uint8_t> &columns_blob = std::get<0>(tupled_row);
+      const mindrecord::json &columns_json = std::get<1>(tupled_row);
+      RETURN_IF_NOT_OK(
+        LoadTensorRow(fetched_row, columns_blob.data(), columns_blob.size(), columns_json, task_type));
       std::vector<std::string> file_path(fetched_row->size(), dataset_file_[0]);
       fetched_row->setPath(file_path);
       fetched_row->setId(row_id);
@@ -208,7 +213,25 @@ Status MindRecordOp::GetRowFromReader(TensorRow *fetched_row, uint64_t row_id, i
   return Status::OK();
 }
 
-Status MindRecordOp::LoadTensorRow(TensorRow *tensor_row, const std::vector<uint8_t> &columns_blob,
+Status MindRecordOp::GetRowFromBlobView(TensorRow *fetched_row, uint64_t row_id, int32_t worker_id) {
+  mindrecord::TaskType task_type = mindrecord::TaskType::kCommonTask;
+  mindrecord::ShardBlobView blob;
+  mindrecord::json columns_json;
+  Status rc = shard_reader_->GetBlobViewById(row_id, worker_id, &task_type, &blob, &columns_json);
+  if (rc.StatusCode() == StatusCode::kMDInterrupted) {
+    // Same as the copying path, the row is left empty when the reader is interrupted.
+    return Status::OK();
+  }
+  RETURN_IF_NOT_OK(rc);
+  // The tensors are created from the blob view directly, which refers to the mapped file if the file is mapped.
+  RETURN_IF_NOT_OK(LoadTensorRow(fetched_row, blob.data, blob.size, columns_json, task_type));
+  std::vector<std::string> file_path(fetched_row->size(), dataset_file_[0]);
+  fetched_row->setPath(file_path);
+  fetched_row->setId(row_id);
+  return Status::OK();
+}
+
+Status MindRecordOp::LoadTensorRow(TensorRow *tensor_row, const uint8_t *columns_blob, uint64_t blob_size,
                                    const mindrecord::json &columns_json, const mindrecord::TaskType task_type) {
   for (int32_t i_col = 0; i_col < columns_to_load_.size(); i_col++) {
     auto column_name = columns_to_load_[i_col];
@@ -245,9 +268,9 @@ Status MindRecordOp::LoadTensorRow(TensorRow *tensor_row, const std::vector<uint
         data = reinterpret_cast<const unsigned char *>(data_ptr.get());
       }
     } else {
-      RETURN_IF_NOT_OK(shard_column->GetColumnValueByName(column_name, columns_blob, columns_json, &data, &data_ptr,
-                                                          &n_bytes, &column_data_type, &column_data_type_size,
-                                                          &column_shape));
+      RETURN_IF_NOT_OK(shard_column->GetColumnValueByName(column_name, columns_blob, blob_size, columns_json, &data,
+                                                          &data_ptr, &n_bytes, &column_data_type,
+                                                          &column_data_type_size, &column_shape));
     }
 
     std::shared_ptr<Tensor> tensor;
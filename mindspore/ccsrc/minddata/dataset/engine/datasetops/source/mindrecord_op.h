@@ -120,11 +120,15 @@ class MindRecordOp : public MappableLeafOp {
  private:
   Status GetRowFromReader(TensorRow *fetched_row, uint64_t row_id, int32_t worker_id);
 
+  /// Fetches a row through the blob view of the reader, which avoids copying the blob out of the mapped file
+  Status GetRowFromBlobView(TensorRow *fetched_row, uint64_t row_id, int32_t worker_id);
+
   /// Parses a single cell and puts the data into a tensor
   /// @param tensor_row - the tensor row to put the parsed data in
   /// @param columns_blob - the blob data received from the reader
+  /// @param blob_size - the size of the blob data
   /// @param columns_json - the data for fields received from the reader
-  Status LoadTensorRow(TensorRow *tensor_row, const std::vector<uint8_t> &columns_blob,
+  Status LoadTensorRow(TensorRow *tensor_row, const uint8_t *columns_blob, uint64_t blob_size,
                        const mindrecord::json &columns_json, const mindrecord::TaskType task_type);
 
   Status LoadTensorRow(row_id_type row_id, TensorRow *row) override {
@@ -168,6 +172,7 @@ class MindRecordOp : public MappableLeafOp {
   std::vector<int32_t> columns_blob_index_;  // Blob Columns to load from dataset
 
   std::unique_ptr<ShardReader> shard_reader_;
+  bool use_mmap_ = false;  // read the rows through the mapped mindrecord files
 
   std::mutex ended_worker_mutex_;
 
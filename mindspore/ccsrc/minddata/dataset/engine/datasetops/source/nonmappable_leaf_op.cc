@@ -16,6 +16,7 @@
 #include "minddata/dataset/engine/datasetops/source/nonmappable_leaf_op.h"
 
 #include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/engine/datasetops/source/io_block.h"
 #include "minddata/dataset/engine/execution_tree.h"
 #include "minddata/dataset/engine/jagged_connector.h"
@@ -249,6 +250,11 @@ void NonMappableLeafOp::ShuffleKeys(std::vector<int64_t> *i_keys, uint32_t seed)
   std::shuffle(i_keys->begin(), i_keys->end(), rng);
 }
 
+void NonMappableLeafOp::CreateJaggedConnector() {
+  bool ordered = !GlobalContext::config_manager()->unordered_connector();
+  jagged_rows_connector_ = std::make_unique<JaggedConnector>(num_workers_, 1, worker_connector_size_, ordered);
+}
+
 Status NonMappableLeafOp::WaitToFillIOBlockQueue() {
   // must be called first if called by worker spanwed by taskgroup
   TaskManager::FindMe()->Post();
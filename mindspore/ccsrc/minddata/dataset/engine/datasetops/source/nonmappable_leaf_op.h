@@ -138,6 +138,10 @@ class NonMappableLeafOp : public ParallelOp<std::unique_ptr<IOBlock>, TensorRow>
 
   static void ShuffleKeys(std::vector<int64_t> *i_keys, uint32_t seed);
 
+  // Create the connector from the workers to the master thread. The rows of different workers are popped
+  // out of order when the unordered connector is enabled in the config.
+  void CreateJaggedConnector();
+
   // Fill the IOBlockQueue.
   // @para i_keys - keys of file to fill to the IOBlockQueue
   // @return Status - the error code returned.
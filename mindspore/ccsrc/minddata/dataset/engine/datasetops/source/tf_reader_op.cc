@@ -16,6 +16,7 @@
 #include "minddata/dataset/engine/datasetops/source/tf_reader_op.h"
 
 #include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <future>
 #include <memory>
@@ -41,6 +42,137 @@ namespace mindspore {
 namespace dataset {
 const int64_t kTFRecordFileLimit = 0x140000000;
 
+namespace {
+// field numbers and wire types of the protobuf messages in example.proto and feature.proto
+constexpr uint32_t kWireTypeVarint = 0;
+constexpr uint32_t kWireTypeFixed64 = 1;
+constexpr uint32_t kWireTypeLengthDelimited = 2;
+constexpr uint32_t kWireTypeFixed32 = 5;
+constexpr uint32_t kWireTypeBits = 3;
+constexpr uint32_t kExampleFeaturesField = 1;
+constexpr uint32_t kFeaturesMapField = 1;
+constexpr uint32_t kMapKeyField = 1;
+constexpr uint32_t kMapValueField = 2;
+constexpr uint32_t kBytesListField = 1;
+constexpr uint32_t kInt64ListField = 3;
+constexpr uint32_t kListValueField = 1;
+constexpr int kMaxVarintBytes = 10;
+constexpr uint32_t kVarintPayloadBits = 7;
+constexpr unsigned char kVarintPayloadMask = 0x7F;
+constexpr unsigned char kVarintContinueBit = 0x80;
+constexpr int32_t kSplitFileQueueSize = 3;
+
+// the payload of a length delimited field, which points into the serialized record
+struct WireSpan {
+  const unsigned char *data = nullptr;
+  size_t size = 0;
+};
+
+bool ReadVarint(const unsigned char **pos, const unsigned char *end, uint64_t *value) {
+  uint64_t result = 0;
+  for (int i = 0; i < kMaxVarintBytes && *pos < end; ++i) {
+    unsigned char byte = *((*pos)++);
+    result |= static_cast<uint64_t>(byte & kVarintPayloadMask) << (kVarintPayloadBits * i);
+    if ((byte & kVarintContinueBit) == 0) {
+      *value = result;
+      return true;
+    }
+  }
+  return false;
+}
+
+// Reads the next field of a message, the payload is only set for length delimited fields.
+bool ReadWireField(const unsigned char **pos, const unsigned char *end, uint32_t *field_number, uint32_t *wire_type,
+                   WireSpan *payload) {
+  uint64_t tag = 0;
+  if (!ReadVarint(pos, end, &tag)) {
+    return false;
+  }
+  *field_number = static_cast<uint32_t>(tag >> kWireTypeBits);
+  *wire_type = static_cast<uint32_t>(tag & ((1U << kWireTypeBits) - 1));
+  uint64_t value = 0;
+  switch (*wire_type) {
+    case kWireTypeVarint:
+      return ReadVarint(pos, end, &value);
+    case kWireTypeFixed64:
+      if (end - *pos < static_cast<int64_t>(sizeof(uint64_t))) {
+        return false;
+      }
+      *pos += sizeof(uint64_t);
+      return true;
+    case kWireTypeLengthDelimited:
+      if (!ReadVarint(pos, end, &value) || value > static_cast<uint64_t>(end - *pos)) {
+        return false;
+      }
+      payload->data = *pos;
+      payload->size = static_cast<size_t>(value);
+      *pos += value;
+      return true;
+    case kWireTypeFixed32:
+      if (end - *pos < static_cast<int64_t>(sizeof(uint32_t))) {
+        return false;
+      }
+      *pos += sizeof(uint32_t);
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Finds the serialized Feature of each column in a serialized Example without parsing the other features, a later
+// entry of the same key overrides the earlier one, the same as protobuf map.
+bool FindExampleFeatures(const std::string &serialized_example, const std::vector<std::string> &column_names,
+                         std::vector<WireSpan> *features, std::vector<bool> *found) {
+  const auto *pos = reinterpret_cast<const unsigned char *>(serialized_example.data());
+  const unsigned char *end = pos + serialized_example.size();
+  uint32_t field_number = 0;
+  uint32_t wire_type = 0;
+  while (pos < end) {
+    WireSpan example_features;
+    if (!ReadWireField(&pos, end, &field_number, &wire_type, &example_features)) {
+      return false;
+    }
+    if (wire_type != kWireTypeLengthDelimited || field_number != kExampleFeaturesField) {
+      continue;
+    }
+    const unsigned char *features_pos = example_features.data;
+    const unsigned char *features_end = example_features.data + example_features.size;
+    while (features_pos < features_end) {
+      WireSpan entry;
+      if (!ReadWireField(&features_pos, features_end, &field_number, &wire_type, &entry)) {
+        return false;
+      }
+      if (wire_type != kWireTypeLengthDelimited || field_number != kFeaturesMapField) {
+        continue;
+      }
+      WireSpan key;
+      WireSpan value;
+      const unsigned char *entry_pos = entry.data;
+      const unsigned char *entry_end = entry.data + entry.size;
+      while (entry_pos < entry_end) {
+        WireSpan payload;
+        if (!ReadWireField(&entry_pos, entry_end, &field_number, &wire_type, &payload)) {
+          return false;
+        }
+        if (wire_type == kWireTypeLengthDelimited && field_number == kMapKeyField) {
+          key = payload;
+        } else if (wire_type == kWireTypeLengthDelimited && field_number == kMapValueField) {
+          value = payload;
+        }
+      }
+      for (size_t col = 0; col < column_names.size(); ++col) {
+        if (column_names[col].size() == key.size &&
+            (key.size == 0 || memcmp(column_names[col].data(), key.data, key.size) == 0)) {
+          (*features)[col] = value;
+          (*found)[col] = true;
+        }
+      }
+    }
+  }
+  return true;
+}
+}  // namespace
+
 bool TFReaderOp::ValidateFirstRowCrc(const std::string &filename) {
   auto realpath = FileUtils::GetRealPath(filename.c_str());
   if (!realpath.has_value()) {
@@ -86,7 +218,9 @@ TFReaderOp::TFReaderOp(int32_t num_workers, int32_t worker_connector_size, int64
       dataset_files_list_(std::move(dataset_files_list)),
       columns_to_load_(std::move(columns_to_load)),
       data_schema_(std::move(data_schema)),
-      equal_rows_per_shard_(equal_rows_per_shard) {}
+      equal_rows_per_shard_(equal_rows_per_shard),
+      split_files_(false),
+      num_file_splits_(1) {}
 
 // A print method typically used for debugging
 void TFReaderOp::Print(std::ostream &out, bool show_all) const {
@@ -124,6 +258,9 @@ Status TFReaderOp::Init() {
   if (total_rows_ == 0) {
     total_rows_ = data_schema_->NumRows();
   }
+  for (int32_t i = 0; i < data_schema_->NumColumns(); ++i) {
+    column_names_.push_back(data_schema_->Column(i).Name());
+  }
   if (total_rows_ < 0) {
     RETURN_STATUS_UNEXPECTED(
       "[Internal ERROR] num_samples or num_rows for TFRecordDataset must be greater than 0, but got: " +
@@ -133,23 +270,37 @@ Status TFReaderOp::Init() {
   // Build the index with our files such that each file corresponds to a key id.
   RETURN_IF_NOT_OK(filename_index_->insert(dataset_files_list_));
 
-  jagged_rows_connector_ = std::make_unique<JaggedConnector>(num_workers_, 1, worker_connector_size_);
+  CreateJaggedConnector();
 
   // temporary: make size large enough to hold all files + EOE to avoid hangs
   int32_t safe_queue_size = static_cast<int32_t>(std::ceil(dataset_files_list_.size() / num_workers_)) + 1;
+  if (split_files_ && !equal_rows_per_shard_) {
+    // when the files are split, there are less than 2 * num_workers_ blocks in total, at most 2 blocks + EOE a queue.
+    safe_queue_size = std::max(safe_queue_size, kSplitFileQueueSize);
+  }
   io_block_queues_.Init(num_workers_, safe_queue_size);
 
   return Status::OK();
 }
 
 Status TFReaderOp::CalculateNumRowsPerShard() {
+  // the files of this shard are split at record boundaries when there are fewer files than workers.
+  int64_t num_files = static_cast<int64_t>(dataset_files_list_.size());
+  int64_t num_shard_files = device_id_ < num_files ? (num_files - device_id_ + num_devices_ - 1) / num_devices_ : 0;
   if (!equal_rows_per_shard_) {
+    // the files of the shard are scanned when their row ranges are pushed, since the files of the shard change by
+    // epoch when they are shuffled.
+    if (split_files_ && num_shard_files > 0 && num_shard_files < num_workers_) {
+      num_file_splits_ = (num_workers_ + num_shard_files - 1) / num_shard_files;
+    }
     return Status::OK();
   }
 
+  // the equal rows sharding counts the rows of all the files, and its blocks are row ranges of the files.
   for (auto it = filename_index_->begin(); it != filename_index_->end(); ++it) {
-    std::vector<std::string> file(1, it.value());
-    int64_t num = CountTotalRowsSectioned(file, 0, 1);
+    const std::vector<int64_t> *record_offsets = nullptr;
+    RETURN_IF_NOT_OK(GetRecordOffsets(it.value(), &record_offsets));
+    int64_t num = static_cast<int64_t>(record_offsets->size());
     filename_numrows_[it.value()] = num;
     num_rows_ += num;
   }
@@ -187,9 +338,7 @@ Status TFReaderOp::FillIOBlockShuffle(const std::vector<int64_t> &i_keys) {
       }
       if (!equal_rows_per_shard_) {
         if (key_index++ % num_devices_ == device_id_) {
-          auto ioBlock = std::make_unique<FilenameBlock>(*it, kInvalidOffset, kInvalidOffset, IOBlock::kDeIoBlockNone);
-          RETURN_IF_NOT_OK(PushIoBlockQueue(queue_index, std::move(ioBlock)));
-          queue_index = (queue_index + 1) % num_workers_;
+          RETURN_IF_NOT_OK(PushFileIOBlocks(*it, &queue_index));
         }
       } else {
         // Do an index lookup using that key to get the filename.
@@ -235,10 +384,7 @@ Status TFReaderOp::FillIOBlockNoShuffle() {
       }
       if (!equal_rows_per_shard_) {
         if (key_index++ % num_devices_ == device_id_) {
-          auto ioBlock =
-            std::make_unique<FilenameBlock>(it.key(), kInvalidOffset, kInvalidOffset, IOBlock::kDeIoBlockNone);
-          RETURN_IF_NOT_OK(PushIoBlockQueue(queue_index, std::move(ioBlock)));
-          queue_index = (queue_index + 1) % num_workers_;
+          RETURN_IF_NOT_OK(PushFileIOBlocks(it.key(), &queue_index));
         }
       } else {
         std::string file_name = it.value();
@@ -263,6 +409,26 @@ Status TFReaderOp::FillIOBlockNoShuffle() {
   return Status::OK();
 }
 
+Status TFReaderOp::PushFileIOBlocks(int64_t key, int32_t *queue_index) {
+  if (num_file_splits_ == 1) {
+    auto ioBlock = std::make_unique<FilenameBlock>(key, kInvalidOffset, kInvalidOffset, IOBlock::kDeIoBlockNone);
+    RETURN_IF_NOT_OK(PushIoBlockQueue(*queue_index, std::move(ioBlock)));
+    *queue_index = (*queue_index + 1) % num_workers_;
+    return Status::OK();
+  }
+  const std::vector<int64_t> *record_offsets = nullptr;
+  RETURN_IF_NOT_OK(GetRecordOffsets((*filename_index_)[key], &record_offsets));
+  int64_t num_rows = static_cast<int64_t>(record_offsets->size());
+  int64_t rows_per_split = std::max<int64_t>((num_rows + num_file_splits_ - 1) / num_file_splits_, 1);
+  for (int64_t start_offset = 0; start_offset < num_rows; start_offset += rows_per_split) {
+    int64_t end_offset = std::min(start_offset + rows_per_split, num_rows);
+    auto ioBlock = std::make_unique<FilenameBlock>(key, start_offset, end_offset, IOBlock::kDeIoBlockNone);
+    RETURN_IF_NOT_OK(PushIoBlockQueue(*queue_index, std::move(ioBlock)));
+    *queue_index = (*queue_index + 1) % num_workers_;
+  }
+  return Status::OK();
+}
+
 // Reads a tf_file file and loads the data into multiple TensorRows.
 Status TFReaderOp::LoadFile(const std::string &filename, int64_t start_offset, int64_t end_offset, int32_t worker_id) {
   auto realpath = FileUtils::GetRealPath(filename.c_str());
@@ -277,14 +443,26 @@ Status TFReaderOp::LoadFile(const std::string &filename, int64_t start_offset, i
     RETURN_STATUS_UNEXPECTED("Invalid file, " + filename + " open failed: permission denied!");
   }
 
-  int64_t rows_read = 0;
   int64_t rows_total = 0;
+  // seek to the first row of the block directly when the record offsets of the file are known.
+  if (start_offset != kInvalidOffset) {
+    std::unique_lock<std::mutex> lock(record_offsets_mutex_);
+    auto iter = filename_record_offsets_.find(filename);
+    if (iter != filename_record_offsets_.end() && start_offset < static_cast<int64_t>(iter->second.size())) {
+      (void)reader.seekg(iter->second[start_offset], std::ios::beg);
+      rows_total = start_offset;
+    }
+  }
 
   while (reader.peek() != EOF) {
     if (!load_jagged_connector_) {
       break;
     }
     RETURN_IF_INTERRUPTED();
+    // the rest of the file belongs to the other blocks
+    if (start_offset != kInvalidOffset && rows_total >= end_offset) {
+      break;
+    }
 
     // read length
     int64_t record_length = 0;
@@ -293,27 +471,21 @@ Status TFReaderOp::LoadFile(const std::string &filename, int64_t start_offset, i
     // ignore crc header
     (void)reader.ignore(static_cast<std::streamsize>(sizeof(int32_t)));
 
-    // read serialized Example
-    std::string serialized_example;
-    serialized_example.resize(record_length);
-    (void)reader.read(&serialized_example[0], static_cast<std::streamsize>(record_length));
-
-    int32_t num_columns = data_schema_->NumColumns();
-    TensorRow newRow(num_columns, nullptr);
-
-    if (start_offset == kInvalidOffset || (rows_total >= start_offset && rows_total < end_offset)) {
-      dataengine::Example tf_file;
-      if (!tf_file.ParseFromString(serialized_example)) {
-        std::string errMsg = "Failed to parse tfrecord file: " + filename + ", make sure protobuf version is suitable.";
-        MS_LOG(DEBUG) << errMsg + ", details of string: " << serialized_example;
-        RETURN_STATUS_UNEXPECTED(errMsg);
-      }
+    if (start_offset == kInvalidOffset || rows_total >= start_offset) {
+      // read serialized Example
+      std::string serialized_example;
+      serialized_example.resize(record_length);
+      (void)reader.read(&serialized_example[0], static_cast<std::streamsize>(record_length));
 
+      int32_t num_columns = data_schema_->NumColumns();
+      TensorRow newRow(num_columns, nullptr);
       std::vector<std::string> file_path(num_columns, filename);
       newRow.setPath(file_path);
-      RETURN_IF_NOT_OK(LoadExample(&tf_file, &newRow));
-      rows_read++;
+      RETURN_IF_NOT_OK(LoadExample(serialized_example, filename, &newRow));
       RETURN_IF_NOT_OK(jagged_rows_connector_->Add(worker_id, std::move(newRow)));
+    } else {
+      // skip the Example before the block without reading it
+      (void)reader.seekg(record_length, std::ios::cur);
     }
 
     // ignore crc footer
@@ -325,24 +497,109 @@ Status TFReaderOp::LoadFile(const std::string &filename, int64_t start_offset, i
 }
 
 // Parses a single row and puts the data into a tensor table.
-Status TFReaderOp::LoadExample(const dataengine::Example *tf_file, TensorRow *out_row) {
+Status TFReaderOp::LoadExample(const std::string &serialized_example, const std::string &filename,
+                               TensorRow *out_row) {
   int32_t num_columns = data_schema_->NumColumns();
+  std::vector<WireSpan> features(num_columns);
+  std::vector<bool> found(num_columns, false);
+  if (!FindExampleFeatures(serialized_example, column_names_, &features, &found)) {
+    std::string errMsg = "Failed to parse tfrecord file: " + filename + ", make sure protobuf version is suitable.";
+    MS_LOG(DEBUG) << errMsg + ", details of string: " << serialized_example;
+    RETURN_STATUS_UNEXPECTED(errMsg);
+  }
   for (int32_t col = 0; col < num_columns; ++col) {
     const ColDescriptor current_col = data_schema_->Column(col);
-    const dataengine::Features &example_features = tf_file->features();
-    const google::protobuf::Map<std::string, dataengine::Feature> &feature_map = example_features.feature();
-    auto iter_column = feature_map.find(current_col.Name());
-    if (iter_column == feature_map.end()) {
+    if (!found[col]) {
       RETURN_STATUS_UNEXPECTED("Invalid columns_list, column name: " + current_col.Name() +
                                " does not exist in tfrecord file, check tfrecord files.");
     }
-    const dataengine::Feature &column_values_list = iter_column->second;
-    RETURN_IF_NOT_OK(LoadFeature(out_row, column_values_list, current_col, col));
+    RETURN_IF_NOT_OK(LoadFeatureFromWire(out_row, features[col].data, features[col].size, current_col, col));
   }
 
   return Status::OK();
 }
 
+Status TFReaderOp::LoadFeatureFromWire(TensorRow *tensor_row, const unsigned char *feature, size_t feature_size,
+                                       const ColDescriptor &current_col, int32_t col) {
+  // the kind of a Feature is the last field of the oneof
+  uint32_t kind = 0;
+  WireSpan kind_list;
+  const unsigned char *pos = feature;
+  const unsigned char *end = feature + feature_size;
+  while (pos < end) {
+    uint32_t field_number = 0;
+    uint32_t wire_type = 0;
+    WireSpan payload;
+    if (!ReadWireField(&pos, end, &field_number, &wire_type, &payload)) {
+      RETURN_STATUS_UNEXPECTED("Failed to parse the feature of column: " + current_col.Name() +
+                               ", make sure protobuf version is suitable.");
+    }
+    if (wire_type == kWireTypeLengthDelimited && field_number >= kBytesListField && field_number <= kInt64ListField) {
+      kind = field_number;
+      kind_list = payload;
+    }
+  }
+
+  if (kind == kBytesListField &&
+      (current_col.Type() == DataType::DE_UINT8 || current_col.Type() == DataType::DE_INT8)) {
+    std::vector<WireSpan> values;
+    pos = kind_list.data;
+    end = kind_list.data + kind_list.size;
+    uint64_t max_size = 0;
+    while (pos < end) {
+      uint32_t field_number = 0;
+      uint32_t wire_type = 0;
+      WireSpan payload;
+      if (!ReadWireField(&pos, end, &field_number, &wire_type, &payload)) {
+        RETURN_STATUS_UNEXPECTED("Failed to parse the bytes list of column: " + current_col.Name() +
+                                 ", make sure protobuf version is suitable.");
+      }
+      if (wire_type == kWireTypeLengthDelimited && field_number == kListValueField) {
+        values.push_back(payload);
+        max_size = std::max<uint64_t>(max_size, payload.size);
+      }
+    }
+    int64_t pad_size = 0;
+    RETURN_IF_NOT_OK(GetBytesListPadSize(current_col, max_size, &pad_size));
+    TensorShape current_shape = TensorShape::CreateScalar();
+    RETURN_IF_NOT_OK(
+      current_col.MaterializeTensorShape(static_cast<int32_t>(values.size()) * pad_size, &current_shape));
+    std::shared_ptr<Tensor> ts;
+    RETURN_IF_NOT_OK(Tensor::CreateEmpty(current_shape, current_col.Type(), &ts));
+    // copy the bytes from the record buffer and pad them with ' ', the same as Tensor::CreateFromByteList
+    unsigned char *current_tensor_addr = ts->GetMutableBuffer();
+    int64_t tensor_bytes_remaining = static_cast<int64_t>(values.size()) * pad_size;
+    for (auto &value : values) {
+      CHECK_FAIL_RETURN_UNEXPECTED(static_cast<int64_t>(value.size) <= pad_size,
+                                   "Invalid data, the element of column: " + current_col.Name() +
+                                     " is larger than the pad size: " + std::to_string(pad_size));
+      int return_code = 0;
+      if (value.size > 0) {
+        return_code = memcpy_s(current_tensor_addr, tensor_bytes_remaining, value.data, value.size);
+        CHECK_FAIL_RETURN_UNEXPECTED(return_code == 0, "memcpy_s failed when reading bytesList element into Tensor");
+      }
+      int64_t chars_to_pad = pad_size - static_cast<int64_t>(value.size);
+      if (chars_to_pad > 0) {
+        return_code = memset_s(current_tensor_addr + value.size, tensor_bytes_remaining - value.size,
+                               static_cast<int>(' '), chars_to_pad);
+        CHECK_FAIL_RETURN_UNEXPECTED(return_code == 0, "memset_s failed when padding bytesList in Tensor");
+      }
+      current_tensor_addr += pad_size;
+      tensor_bytes_remaining -= pad_size;
+    }
+    (*tensor_row)[col] = std::move(ts);
+    return Status::OK();
+  }
+
+  // the other kinds are small, parse the Feature of this column only
+  dataengine::Feature column_values_list;
+  if (!column_values_list.ParseFromArray(feature, static_cast<int>(feature_size))) {
+    RETURN_STATUS_UNEXPECTED("Failed to parse the feature of column: " + current_col.Name() +
+                             ", make sure protobuf version is suitable.");
+  }
+  return LoadFeature(tensor_row, column_values_list, current_col, col);
+}
+
 // Parses a single cell and puts the data into a tensor table.
 Status TFReaderOp::LoadFeature(TensorRow *tensor_row, const dataengine::Feature &column_values_list,
                                const ColDescriptor &current_col, int32_t col) {
@@ -432,7 +689,19 @@ Status TFReaderOp::LoadBytesList(const ColDescriptor &current_col, const dataeng
 #endif
   }
 
-  int64_t pad_size = max_size;
+  int64_t pad_size = 0;
+  RETURN_IF_NOT_OK(GetBytesListPadSize(current_col, max_size, &pad_size));
+
+  // know how many elements there are and the total bytes, create tensor here:
+  TensorShape current_shape = TensorShape::CreateScalar();
+  RETURN_IF_NOT_OK(current_col.MaterializeTensorShape((*num_elements) * pad_size, &current_shape));
+  RETURN_IF_NOT_OK(Tensor::CreateFromByteList(bytes_list, current_shape, current_col.Type(), pad_size, tensor));
+
+  return Status::OK();
+}
+
+Status TFReaderOp::GetBytesListPadSize(const ColDescriptor &current_col, uint64_t max_size, int64_t *pad_size) {
+  *pad_size = max_size;
 
   // if user provides a shape in the form of [-1, d1, 2d, ... , dn], we need to pad to d1 * d2 * ... * dn
   if (current_col.HasShape()) {
@@ -448,7 +717,7 @@ Status TFReaderOp::LoadBytesList(const ColDescriptor &current_col, const dataeng
         }
         new_pad_size *= cur_shape[i];
       }
-      pad_size = new_pad_size;
+      *pad_size = new_pad_size;
     } else {
       if (cur_shape.known() && cur_shape.NumOfElements() != max_size) {
         std::string err_msg = "Data dimensions of '" + current_col.Name() +
@@ -459,12 +728,6 @@ Status TFReaderOp::LoadBytesList(const ColDescriptor &current_col, const dataeng
       }
     }
   }
-
-  // know how many elements there are and the total bytes, create tensor here:
-  TensorShape current_shape = TensorShape::CreateScalar();
-  RETURN_IF_NOT_OK(current_col.MaterializeTensorShape((*num_elements) * pad_size, &current_shape));
-  RETURN_IF_NOT_OK(Tensor::CreateFromByteList(bytes_list, current_shape, current_col.Type(), pad_size, tensor));
-
   return Status::OK();
 }
 
@@ -724,6 +987,55 @@ int64_t TFReaderOp::CountTotalRowsSectioned(const std::vector<std::string> &file
   return rows_read;
 }
 
+Status TFReaderOp::GetRecordOffsets(const std::string &filename, const std::vector<int64_t> **record_offsets) {
+  RETURN_UNEXPECTED_IF_NULL(record_offsets);
+  {
+    std::unique_lock<std::mutex> lock(record_offsets_mutex_);
+    auto iter = filename_record_offsets_.find(filename);
+    if (iter != filename_record_offsets_.end()) {
+      *record_offsets = &iter->second;
+      return Status::OK();
+    }
+  }
+  // only the thread filling the io blocks scans the files, the workers just look up the scanned ones.
+  std::vector<int64_t> offsets;
+  RETURN_IF_NOT_OK(ScanRecordOffsets(filename, &offsets));
+  std::unique_lock<std::mutex> lock(record_offsets_mutex_);
+  auto &scanned = filename_record_offsets_[filename];
+  scanned = std::move(offsets);
+  *record_offsets = &scanned;
+  return Status::OK();
+}
+
+Status TFReaderOp::ScanRecordOffsets(const std::string &filename, std::vector<int64_t> *record_offsets) {
+  RETURN_UNEXPECTED_IF_NULL(record_offsets);
+  auto realpath = FileUtils::GetRealPath(filename.c_str());
+  if (!realpath.has_value()) {
+    MS_LOG(ERROR) << "Invalid file path, " << filename << " does not exist.";
+    RETURN_STATUS_UNEXPECTED("Invalid file path, " + filename + " does not exist.");
+  }
+
+  std::ifstream reader;
+  reader.open(realpath.value());
+  if (!reader) {
+    RETURN_STATUS_UNEXPECTED("Invalid file, " + filename + " open failed: permission denied!");
+  }
+
+  record_offsets->clear();
+  int64_t offset = 0;
+  while (reader.peek() != EOF) {
+    int64_t record_length = 0;
+    (void)reader.read(reinterpret_cast<char *>(&record_length), static_cast<std::streamsize>(sizeof(int64_t)));
+    CHECK_FAIL_RETURN_UNEXPECTED(reader.good() && record_length >= 0,
+                                 "Invalid file, " + filename + " is truncated or not a tfrecord file.");
+    record_offsets->push_back(offset);
+    // skip the crc header, the record and the crc footer
+    offset += static_cast<int64_t>(sizeof(int64_t) + sizeof(int32_t)) + record_length + sizeof(int32_t);
+    (void)reader.seekg(offset, std::ios::beg);
+  }
+  return Status::OK();
+}
+
 Status TFReaderOp::ComputeColMap() {
   // Construct the column name map for this operator (base class field)
   if (column_name_id_map_.empty()) {
@@ -104,6 +104,11 @@ class TFReaderOp : public NonMappableLeafOp {
 
   static bool ValidateFirstRowCrc(const std::string &filename);
 
+  /// Lets several workers read the row ranges of one file when the shard has fewer files than workers. The rows of
+  /// the ranges come out interleaved, so it is only set when the rows are shuffled globally after this op.
+  /// @param split_files - whether to split the files of the shard into row ranges.
+  void SetSplitFiles(bool split_files) { split_files_ = split_files; }
+
  private:
   // Reads a tf_file file and loads the data into multiple TensorRows.
   // @param filename - the tf_file file to read.
@@ -113,12 +118,24 @@ class TFReaderOp : public NonMappableLeafOp {
   // @return Status - the error code returned.
   Status LoadFile(const std::string &filename, int64_t start_offset, int64_t end_offset, int32_t worker_id) override;
 
-  // Parses a single row and puts the data into a tensor table.
-  // @param tf_file - the row to be parsed.
-  // @param tensor_table - the tensor table to put the parsed data in.
-  // @param row - the id of the row filled in the tensor table.
+  // Parses a single row and puts the data into a tensor table. The requested columns are found in the wire format of
+  // the serialized Example, the other features are skipped without being parsed.
+  // @param serialized_example - the serialized Example of the row.
+  // @param filename - the tf_file file the row is read from.
+  // @param out_row - the row to put the parsed data in.
+  // @return Status - the error code returned.
+  Status LoadExample(const std::string &serialized_example, const std::string &filename, TensorRow *out_row);
+
+  // Parses a single cell from the wire format of a serialized Feature. The bytes of uint8 and int8 columns are copied
+  // into the tensor from the record buffer, the other kinds are parsed by protobuf.
+  // @param tensor_row - the row to put the parsed data in.
+  // @param feature - the serialized Feature.
+  // @param feature_size - the size of the serialized Feature.
+  // @param current_col - the column descriptor containing the expected shape and type of the data.
+  // @param col - the index of the column in the row.
   // @return Status - the error code returned.
-  Status LoadExample(const dataengine::Example *tf_file, TensorRow *out_row);
+  Status LoadFeatureFromWire(TensorRow *tensor_row, const unsigned char *feature, size_t feature_size,
+                             const ColDescriptor &current_col, int32_t col);
 
   // Parses a single cell and puts the data into a tensor table.
   // @param tensor_table - the tensor table to put the parsed data in.
@@ -136,6 +153,13 @@ class TFReaderOp : public NonMappableLeafOp {
   static Status LoadBytesList(const ColDescriptor &current_col, const dataengine::Feature &column_values_list,
                               int32_t *num_elements, std::shared_ptr<Tensor> *tensor);
 
+  /// Gets the size each element of a uint8 or int8 bytes list is padded to
+  /// @param current_col - the column descriptor containing the expected shape and type of the data.
+  /// @param max_size - the size of the largest element of the bytes list.
+  /// @param pad_size - the size each element is padded to.
+  /// @return Status - the error code returned.
+  static Status GetBytesListPadSize(const ColDescriptor &current_col, uint64_t max_size, int64_t *pad_size);
+
   /// Reads values from a float list
   /// @param current_col - the column descriptor containing the expected shape and type of the data.
   /// @param column_values_list - the cell that contains the float list to read from.
@@ -177,6 +201,12 @@ class TFReaderOp : public NonMappableLeafOp {
   static int64_t CountTotalRowsSectioned(const std::vector<std::string> &filenames, const int64_t begin,
                                          const int64_t end);
 
+  /// Scans the record lengths of a tf_file file to get the file offset of each record, without reading the records.
+  /// @param filename - the tf_file file to scan.
+  /// @param record_offsets - the file offset of each record.
+  /// @return Status - the error code returned.
+  static Status ScanRecordOffsets(const std::string &filename, std::vector<int64_t> *record_offsets);
+
  protected:
   Status FillIOBlockQueue(const std::vector<int64_t> &i_keys) override;
 
@@ -193,6 +223,19 @@ class TFReaderOp : public NonMappableLeafOp {
    */
   Status FillIOBlockNoShuffle();
 
+  // Pushes the IOBlocks of a file, the file is split into several row ranges at record boundaries when there are
+  // fewer files than workers, so that the workers read one file in parallel.
+  // @param key - the key of the file in filename_index_.
+  // @param queue_index - the index of the queue to push to, updated to the next queue.
+  // @return Status - the error code returned.
+  Status PushFileIOBlocks(int64_t key, int32_t *queue_index);
+
+  // Gets the record offsets of a file, the file is scanned the first time it is asked for.
+  // @param filename - the tf_file file.
+  // @param record_offsets - the record offsets of the file, they are not changed once scanned.
+  // @return Status - the error code returned.
+  Status GetRecordOffsets(const std::string &filename, const std::vector<int64_t> **record_offsets);
+
   // Calculate number of rows in each shard.
   // @return Status - the error code returned.
   Status CalculateNumRowsPerShard() override;
@@ -204,8 +247,17 @@ class TFReaderOp : public NonMappableLeafOp {
   std::vector<std::string> dataset_files_list_;
   std::vector<std::string> columns_to_load_;
   std::unique_ptr<DataSchema> data_schema_;
+  std::vector<std::string> column_names_;
 
   bool equal_rows_per_shard_;
+
+  // the file offset of each record of the files. All the files are scanned before the workers start for the equal
+  // rows sharding, otherwise a file of the shard is scanned before its first row range is pushed.
+  std::map<std::string, std::vector<int64_t>> filename_record_offsets_;
+  std::mutex record_offsets_mutex_;
+  bool split_files_;
+  // the number of row ranges a file is split into, 1 means the files are not split.
+  int64_t num_file_splits_;
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -29,8 +29,8 @@ namespace mindspore {
 namespace dataset {
 class JaggedConnector : public Connector<TensorRow> {
  public:
-  JaggedConnector(int32_t num_producers, int32_t num_consumers, int32_t queue_capacity)
-      : Connector<TensorRow>(num_producers, num_consumers, queue_capacity) {
+  JaggedConnector(int32_t num_producers, int32_t num_consumers, int32_t queue_capacity, bool ordered = true)
+      : Connector<TensorRow>(num_producers, num_consumers, queue_capacity, ordered) {
     for (int i = 0; i < num_producers; i++) {
       is_queue_finished_.push_back(false);
     }
@@ -44,6 +44,11 @@ class JaggedConnector : public Connector<TensorRow> {
 
   Status Pop(int32_t worker_id, TensorRow *result) noexcept override {
     RETURN_UNEXPECTED_IF_NULL(result);
+    // In unordered mode a producer pushes nothing after its eoe until the reset, so the rows can be popped
+    // from any producer without tracking the finished queues.
+    if (!ordered_) {
+      return Connector<TensorRow>::Pop(worker_id, result);
+    }
     {
       MS_ASSERT(worker_id < num_consumers_);
       std::unique_lock<std::mutex> lock(m_);
@@ -16,6 +16,7 @@
 
 #include "minddata/dataset/engine/opt/optional/tensor_op_fusion_pass.h"
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -23,9 +24,16 @@
 #include "minddata/dataset/kernels/image/random_crop_and_resize_op.h"
 #include "minddata/dataset/kernels/image/random_crop_decode_resize_op.h"
 #include "minddata/dataset/kernels/ir/data/transforms_ir.h"
+#include "minddata/dataset/kernels/ir/vision/center_crop_ir.h"
 #include "minddata/dataset/kernels/ir/vision/decode_ir.h"
+#include "minddata/dataset/kernels/ir/vision/decode_resize_crop_ir.h"
+#include "minddata/dataset/kernels/ir/vision/horizontal_flip_ir.h"
+#include "minddata/dataset/kernels/ir/vision/hwc_to_chw_ir.h"
+#include "minddata/dataset/kernels/ir/vision/normalize_hwc_to_chw_ir.h"
+#include "minddata/dataset/kernels/ir/vision/normalize_ir.h"
 #include "minddata/dataset/kernels/ir/vision/random_crop_decode_resize_ir.h"
 #include "minddata/dataset/kernels/ir/vision/random_resized_crop_ir.h"
+#include "minddata/dataset/kernels/ir/vision/resize_ir.h"
 
 namespace mindspore {
 namespace dataset {
@@ -51,19 +59,95 @@ Status TensorOpFusionPass::Visit(std::shared_ptr<MapNode> node, bool *const modi
   }  // end of temporary code, needs to be deleted when tensorOperation's pybind completes
 
   // logic below is for non-prebuilt TensorOperation
+  bool decode_fused = false;
   pattern = {vision::kDecodeOperation, vision::kRandomResizedCropOperation};
   itr = std::search(ops.begin(), ops.end(), pattern.begin(), pattern.end(),
                     [](auto op, const std::string &nm) { return op != nullptr ? op->Name() == nm : false; });
+  if (itr != ops.end()) {
+    auto *fused_ir = dynamic_cast<vision::RandomResizedCropOperation *>((itr + 1)->get());
+    RETURN_UNEXPECTED_IF_NULL(fused_ir);
+    // fuse the two ops
+    (*itr) = std::make_shared<vision::RandomCropDecodeResizeOperation>(*fused_ir);
+    ops.erase(itr + 1);
+    decode_fused = true;
+  } else {
+    RETURN_IF_NOT_OK(FuseDecodeResizeCrop(&ops, &decode_fused));
+  }
+  // the ops after the decoding are fused as well, e.g. Normalize and HWC2CHW of the training pipeline
+  bool normalize_fused = false;
+  RETURN_IF_NOT_OK(FuseNormalizeHwcToChw(&ops, &normalize_fused));
+  if (decode_fused || normalize_fused) {
+    node->setOperations(ops);
+    *modified = true;
+  }
+  return Status::OK();
+}
 
+Status TensorOpFusionPass::FuseDecodeResizeCrop(std::vector<std::shared_ptr<TensorOperation>> *ops, bool *fused) {
+  // fuse Decode followed by Resize, CenterCrop or Resize and CenterCrop, so that the JPEG images are decoded with
+  // the scaled IDCT and only the ROI kept by CenterCrop is decoded.
+  auto itr = ops->begin();
+  for (; itr != ops->end(); ++itr) {
+    auto *decode_ir = dynamic_cast<vision::DecodeOperation *>(itr->get());
+    if (decode_ir != nullptr && decode_ir->IsRgb()) {
+      break;
+    }
+  }
+  RETURN_OK_IF_TRUE(itr == ops->end());
+  auto next = itr + 1;
+  std::vector<int32_t> resize_size;
+  InterpolationMode interpolation = InterpolationMode::kLinear;
+  if (next != ops->end() && *next != nullptr && (*next)->Name() == vision::kResizeOperation) {
+    auto *resize_ir = dynamic_cast<vision::ResizeOperation *>(next->get());
+    RETURN_UNEXPECTED_IF_NULL(resize_ir);
+    resize_size = resize_ir->Size();
+    interpolation = resize_ir->Interpolation();
+    ++next;
+  }
+  std::vector<int32_t> crop_size;
+  if (next != ops->end() && *next != nullptr && (*next)->Name() == vision::kCenterCropOperation) {
+    auto *crop_ir = dynamic_cast<vision::CenterCropOperation *>(next->get());
+    RETURN_UNEXPECTED_IF_NULL(crop_ir);
+    crop_size = crop_ir->Size();
+    ++next;
+  }
   // return here if no pattern is found
-  RETURN_OK_IF_TRUE(itr == ops.end());
-  auto *fused_ir = dynamic_cast<vision::RandomResizedCropOperation *>((itr + 1)->get());
-  RETURN_UNEXPECTED_IF_NULL(fused_ir);
-  // fuse the two ops
-  (*itr) = std::make_shared<vision::RandomCropDecodeResizeOperation>(*fused_ir);
-  ops.erase(itr + 1);
-  node->setOperations(ops);
-  *modified = true;
+  RETURN_OK_IF_TRUE(next == itr + 1);
+  (*itr) = std::make_shared<vision::DecodeResizeCropOperation>(resize_size, interpolation, crop_size);
+  (void)ops->erase(itr + 1, next);
+  *fused = true;
+  return Status::OK();
+}
+
+Status TensorOpFusionPass::FuseNormalizeHwcToChw(std::vector<std::shared_ptr<TensorOperation>> *ops, bool *fused) {
+  // fuse HorizontalFlip (optional), Normalize, HWC2CHW and TypeCast to float32 or float16 (optional), so that the
+  // image is read once and written to the channel planes directly, the same for a batch of images.
+  std::vector<std::string> pattern = {vision::kNormalizeOperation, vision::kHwcToChwOperation};
+  auto itr = std::search(ops->begin(), ops->end(), pattern.begin(), pattern.end(),
+                         [](auto op, const std::string &nm) { return op != nullptr ? op->Name() == nm : false; });
+  RETURN_OK_IF_TRUE(itr == ops->end());
+  auto *normalize_ir = dynamic_cast<vision::NormalizeOperation *>(itr->get());
+  RETURN_UNEXPECTED_IF_NULL(normalize_ir);
+  auto first = itr;
+  auto next = itr + pattern.size();
+  bool flip_horizontal = false;
+  if (itr != ops->begin() && *(itr - 1) != nullptr && (*(itr - 1))->Name() == vision::kHorizontalFlipOperation) {
+    flip_horizontal = true;
+    --first;
+  }
+  DataType output_type(DataType::DE_FLOAT32);
+  if (next != ops->end() && *next != nullptr && (*next)->Name() == kTypeCastOperation) {
+    auto *type_cast_ir = dynamic_cast<transforms::TypeCastOperation *>(next->get());
+    RETURN_UNEXPECTED_IF_NULL(type_cast_ir);
+    if (type_cast_ir->Type() == DataType::DE_FLOAT32 || type_cast_ir->Type() == DataType::DE_FLOAT16) {
+      output_type = type_cast_ir->Type();
+      ++next;
+    }
+  }
+  (*first) = std::make_shared<vision::NormalizeHwcToChwOperation>(normalize_ir->Mean(), normalize_ir->Std(),
+                                                                  flip_horizontal, output_type);
+  (void)ops->erase(first + 1, next);
+  *fused = true;
   return Status::OK();
 }
 }  // namespace dataset
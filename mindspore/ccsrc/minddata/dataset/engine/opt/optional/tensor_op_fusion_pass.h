@@ -17,20 +17,34 @@
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_TENSOR_OP_FUSION_PASS_H_
 
 #include <memory>
+#include <vector>
 #include "minddata/dataset/engine/opt/pass.h"
+#include "minddata/dataset/kernels/ir/tensor_operation.h"
 
 namespace mindspore {
 namespace dataset {
 
 /// \class TensorOpFusionPass tensor_op_fusion_pass.h
 /// \brief And optional optimization pass identifying and fusing
-///     tensor ops within MapOp
+///     tensor ops within MapOp, it only runs when the environment variable OPTIMIZE is set to true
 class TensorOpFusionPass : public IRNodePass {
   /// \brief Identifies and fuses tensor ops within MapOp
   /// \param[in] node The node being visited
   /// \param[in, out] *modified indicates whether the node has been visited
   /// \return Status The status code returned
   Status Visit(std::shared_ptr<MapNode> node, bool *const modified) override;
+
+  /// \brief Fuses Decode followed by Resize, CenterCrop or Resize and CenterCrop into DecodeResizeCrop
+  /// \param[in, out] ops The tensor operations of the MapOp
+  /// \param[out] fused Whether the operations are fused
+  /// \return Status The status code returned
+  Status FuseDecodeResizeCrop(std::vector<std::shared_ptr<TensorOperation>> *ops, bool *fused);
+
+  /// \brief Fuses HorizontalFlip (optional), Normalize, HWC2CHW and TypeCast (optional) into NormalizeHwcToChw
+  /// \param[in, out] ops The tensor operations of the MapOp
+  /// \param[out] fused Whether the operations are fused
+  /// \return Status The status code returned
+  Status FuseNormalizeHwcToChw(std::vector<std::shared_ptr<TensorOperation>> *ops, bool *fused);
 };
 }  // namespace dataset
 }  // namespace mindspore
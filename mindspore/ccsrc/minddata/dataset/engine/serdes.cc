@@ -280,6 +280,7 @@ Serdes::InitializeFuncPtr() {
   ops_ptr[vision::kCutMixBatchOperation] = &(vision::CutMixBatchOperation::from_json);
   ops_ptr[vision::kCutOutOperation] = &(vision::CutOutOperation::from_json);
   ops_ptr[vision::kDecodeOperation] = &(vision::DecodeOperation::from_json);
+  ops_ptr[vision::kDecodeResizeCropOperation] = &(vision::DecodeResizeCropOperation::from_json);
 #ifdef ENABLE_ACL
   ops_ptr[vision::kDvppCropJpegOperation] = &(vision::DvppCropJpegOperation::from_json);
   ops_ptr[vision::kDvppDecodeResizeOperation] = &(vision::DvppDecodeResizeOperation::from_json);
@@ -294,6 +295,7 @@ Serdes::InitializeFuncPtr() {
   ops_ptr[vision::kInvertOperation] = &(vision::InvertOperation::from_json);
   ops_ptr[vision::kMixUpBatchOperation] = &(vision::MixUpBatchOperation::from_json);
   ops_ptr[vision::kNormalizeOperation] = &(vision::NormalizeOperation::from_json);
+  ops_ptr[vision::kNormalizeHwcToChwOperation] = &(vision::NormalizeHwcToChwOperation::from_json);
   ops_ptr[vision::kNormalizePadOperation] = &(vision::NormalizePadOperation::from_json);
   ops_ptr[vision::kPadOperation] = &(vision::PadOperation::from_json);
   ops_ptr[vision::kRandomAffineOperation] = &(vision::RandomAffineOperation::from_json);
@@ -0,0 +1,174 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/kernels/image/decode_resize_crop_op.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "minddata/dataset/kernels/image/center_crop_op.h"
+#include "minddata/dataset/kernels/image/decode_op.h"
+#include "minddata/dataset/kernels/image/resize_op.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+constexpr int kMaxJpegScaleDenom = 8;
+constexpr int32_t kOutNumComponents = 3;
+}  // namespace
+
+DecodeResizeCropOp::DecodeResizeCropOp(int32_t resize_height, int32_t resize_width, InterpolationMode interpolation,
+                                       int32_t crop_height, int32_t crop_width)
+    : resize_height_(resize_height),
+      resize_width_(resize_width),
+      interpolation_(interpolation),
+      crop_height_(crop_height),
+      crop_width_(crop_width == 0 ? crop_height : crop_width) {}
+
+Status DecodeResizeCropOp::GetResizedSize(int32_t img_height, int32_t img_width, int32_t *resized_height,
+                                          int32_t *resized_width) const {
+  if (resize_height_ == 0) {
+    *resized_height = img_height;
+    *resized_width = img_width;
+  } else if (resize_width_ != 0) {
+    *resized_height = resize_height_;
+    *resized_width = resize_width_;
+  } else if (img_height < img_width) {
+    CHECK_FAIL_RETURN_UNEXPECTED(img_height != 0, "DecodeResizeCrop: the input height cannot be 0.");
+    *resized_height = resize_height_;
+    *resized_width = static_cast<int32_t>(std::lround((static_cast<float>(img_width) / img_height) * resize_height_));
+  } else {
+    CHECK_FAIL_RETURN_UNEXPECTED(img_width != 0, "DecodeResizeCrop: the input width cannot be 0.");
+    *resized_width = resize_height_;
+    *resized_height = static_cast<int32_t>(std::lround((static_cast<float>(img_height) / img_width) * resize_height_));
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(*resized_height > 0 && *resized_width > 0,
+                               "DecodeResizeCrop: the resized size should be positive, got height: " +
+                                 std::to_string(*resized_height) + ", width: " + std::to_string(*resized_width));
+  return Status::OK();
+}
+
+Status DecodeResizeCropOp::DecodeThenResizeCrop(const std::shared_ptr<Tensor> &input,
+                                                std::shared_ptr<Tensor> *output) const {
+  std::shared_ptr<Tensor> decoded;
+  RETURN_IF_NOT_OK(DecodeOp(true).Compute(input, &decoded));
+  std::shared_ptr<Tensor> resized = decoded;
+  if (resize_height_ > 0) {
+    RETURN_IF_NOT_OK(ResizeOp(resize_height_, resize_width_, interpolation_).Compute(decoded, &resized));
+  }
+  if (crop_height_ > 0) {
+    return CenterCropOp(crop_height_, crop_width_).Compute(resized, output);
+  }
+  *output = resized;
+  return Status::OK();
+}
+
+Status DecodeResizeCropOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  IO_CHECK(input, output);
+  if (input->Rank() != 1) {
+    RETURN_STATUS_UNEXPECTED("DecodeResizeCrop: invalid input shape, only support 1D input, got rank: " +
+                             std::to_string(input->Rank()));
+  }
+  if (!IsNonEmptyJPEG(input)) {
+    return DecodeThenResizeCrop(input, output);
+  }
+  int img_width = 0;
+  int img_height = 0;
+  RETURN_IF_NOT_OK(GetJpegImageInfo(input, &img_width, &img_height));
+  CHECK_FAIL_RETURN_UNEXPECTED(img_width > 0 && img_height > 0, "DecodeResizeCrop: the JPEG image is empty.");
+  int32_t resized_height = 0;
+  int32_t resized_width = 0;
+  RETURN_IF_NOT_OK(GetResizedSize(img_height, img_width, &resized_height, &resized_width));
+
+  // the ROI of the resized image kept by CenterCrop, CenterCrop pads when the crop size is larger than the image,
+  // in which case the whole image is kept and CenterCrop runs at last.
+  int32_t roi_x = 0;
+  int32_t roi_y = 0;
+  int32_t roi_width = resized_width;
+  int32_t roi_height = resized_height;
+  bool need_pad = false;
+  if (crop_height_ > 0) {
+    if (crop_height_ <= resized_height && crop_width_ <= resized_width) {
+      roi_x = (resized_width - crop_width_) / 2;
+      roi_y = (resized_height - crop_height_) / 2;
+      roi_width = crop_width_;
+      roi_height = crop_height_;
+    } else {
+      need_pad = true;
+    }
+  }
+
+  // the largest scale of the IDCT which keeps the decoded image not smaller than the resized image, so that the
+  // quality is kept by the final resize.
+  int scale_denom = 1;
+  for (int denom = kMaxJpegScaleDenom; denom > 1 && resize_height_ > 0; denom /= 2) {
+    if ((img_width + denom - 1) / denom >= resized_width && (img_height + denom - 1) / denom >= resized_height) {
+      scale_denom = denom;
+      break;
+    }
+  }
+  // libjpeg rounds up the scaled size
+  int scaled_width = (img_width + scale_denom - 1) / scale_denom;
+  int scaled_height = (img_height + scale_denom - 1) / scale_denom;
+
+  // map the ROI to the scaled image, it is widened to whole pixels.
+  float ratio_x = static_cast<float>(scaled_width) / resized_width;
+  float ratio_y = static_cast<float>(scaled_height) / resized_height;
+  int x_begin = static_cast<int>(std::floor(roi_x * ratio_x));
+  int y_begin = static_cast<int>(std::floor(roi_y * ratio_y));
+  int x_end = std::min(static_cast<int>(std::ceil((roi_x + roi_width) * ratio_x)), scaled_width);
+  int y_end = std::min(static_cast<int>(std::ceil((roi_y + roi_height) * ratio_y)), scaled_height);
+
+  std::shared_ptr<Tensor> decoded;
+  RETURN_IF_NOT_OK(
+    JpegCropAndDecode(input, &decoded, x_begin, y_begin, x_end - x_begin, y_end - y_begin, scale_denom));
+  std::shared_ptr<Tensor> resized = decoded;
+  if (decoded->shape()[0] != roi_height || decoded->shape()[1] != roi_width) {
+    RETURN_IF_NOT_OK(Resize(decoded, &resized, roi_height, roi_width, 0, 0, interpolation_));
+  }
+  if (need_pad) {
+    return CenterCropOp(crop_height_, crop_width_).Compute(resized, output);
+  }
+  *output = resized;
+  return Status::OK();
+}
+
+Status DecodeResizeCropOp::OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) {
+  RETURN_IF_NOT_OK(TensorOp::OutputShape(inputs, outputs));
+  outputs.clear();
+  TensorShape out({-1, -1, kOutNumComponents});
+  if (crop_height_ > 0) {
+    out = TensorShape({crop_height_, crop_width_, kOutNumComponents});
+  } else if (resize_height_ > 0 && resize_width_ > 0) {
+    out = TensorShape({resize_height_, resize_width_, kOutNumComponents});
+  }
+  if (inputs[0].Rank() == 1) {
+    (void)outputs.emplace_back(out);
+  }
+  if (!outputs.empty()) {
+    return Status::OK();
+  }
+  return Status(StatusCode::kMDUnexpectedError,
+                "DecodeResizeCrop: invalid input shape, expected 1D input, but got input dimension is:" +
+                  std::to_string(inputs[0].Rank()));
+}
+
+Status DecodeResizeCropOp::OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) {
+  RETURN_IF_NOT_OK(TensorOp::OutputType(inputs, outputs));
+  outputs[0] = DataType(DataType::DE_UINT8);
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
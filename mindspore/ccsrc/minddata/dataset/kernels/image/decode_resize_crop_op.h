@@ -0,0 +1,74 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_DECODE_RESIZE_CROP_OP_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_DECODE_RESIZE_CROP_OP_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/kernels/image/image_utils.h"
+#include "minddata/dataset/kernels/tensor_op.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+// DecodeResizeCropOp is the fusion of Decode followed by Resize, CenterCrop or Resize and CenterCrop.
+// For a JPEG image, only the ROI kept by the center crop is decoded, and the image is downscaled by the scaled IDCT
+// of libjpeg as long as it stays not smaller than the resize target, the rest of the resize is done on the small
+// image. Other images are decoded and processed by the original ops.
+class DecodeResizeCropOp : public TensorOp {
+ public:
+  // @param resize_height: the first size of Resize, 0 means there is no Resize.
+  // @param resize_width: the second size of Resize, 0 means the smaller edge is resized to resize_height.
+  // @param interpolation: the interpolation mode of Resize.
+  // @param crop_height: the height of CenterCrop, 0 means there is no CenterCrop.
+  // @param crop_width: the width of CenterCrop.
+  DecodeResizeCropOp(int32_t resize_height, int32_t resize_width, InterpolationMode interpolation,
+                     int32_t crop_height, int32_t crop_width);
+
+  ~DecodeResizeCropOp() override = default;
+
+  void Print(std::ostream &out) const override {
+    out << Name() << ": " << resize_height_ << " " << resize_width_ << " " << crop_height_ << " " << crop_width_;
+  }
+
+  Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
+
+  Status OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) override;
+
+  Status OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) override;
+
+  std::string Name() const override { return kDecodeResizeCropOp; }
+
+ private:
+  // the size of the image after Resize, the same as ResizeOp
+  Status GetResizedSize(int32_t img_height, int32_t img_width, int32_t *resized_height, int32_t *resized_width) const;
+
+  // decode the image and run Resize and CenterCrop one by one
+  Status DecodeThenResizeCrop(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) const;
+
+  int32_t resize_height_;
+  int32_t resize_width_;
+  InterpolationMode interpolation_;
+  int32_t crop_height_;
+  int32_t crop_width_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_DECODE_RESIZE_CROP_OP_H_
@@ -35,16 +35,18 @@ Status HwcToChwOp::OutputShape(const std::vector<TensorShape> &inputs, std::vect
   outputs.clear();
   CHECK_FAIL_RETURN_UNEXPECTED(inputs.size() > 0, "HwcToChwOp::OutputShape inputs size should > 0");
   TensorShape in = inputs[0];
-  TensorShape out = TensorShape{in[2], in[0], in[1]};
   if (inputs[0].Rank() == 3) {
-    (void)outputs.emplace_back(out);
+    (void)outputs.emplace_back(TensorShape{in[2], in[0], in[1]});
+  } else if (inputs[0].Rank() == 4) {
+    // a batch of images
+    (void)outputs.emplace_back(TensorShape{in[0], in[3], in[1], in[2]});
   }
   if (!outputs.empty()) {
     return Status::OK();
   }
-  return Status(
-    StatusCode::kMDUnexpectedError,
-    "HWC2CHW: invalid input shape, expected 3D input, but got input dimension is:" + std::to_string(inputs[0].Rank()));
+  return Status(StatusCode::kMDUnexpectedError,
+                "HWC2CHW: invalid input shape, expected 3D or 4D input, but got input dimension is:" +
+                  std::to_string(inputs[0].Rank()));
 }
 }  // namespace dataset
 }  // namespace mindspore
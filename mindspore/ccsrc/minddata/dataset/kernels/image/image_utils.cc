@@ -373,7 +373,11 @@ void JpegErrorExitCustom(j_common_ptr cinfo) {
 }
 
 Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int crop_x, int crop_y,
-                         int crop_w, int crop_h) {
+                         int crop_w, int crop_h, int scale_denom) {
+  constexpr int kMaxScaleDenom = 8;
+  CHECK_FAIL_RETURN_UNEXPECTED(scale_denom == 1 || scale_denom == 2 || scale_denom == 4 || scale_denom == kMaxScaleDenom,
+                               "JpegCropAndDecode: scale denom should be 1, 2, 4 or 8, got: " +
+                                 std::to_string(scale_denom));
   struct jpeg_decompress_struct cinfo;
   auto DestroyDecompressAndReturnError = [&cinfo](const std::string &err) {
     jpeg_destroy_decompress(&cinfo);
@@ -387,6 +391,8 @@ Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<T
     JpegSetSource(&cinfo, input->GetBuffer(), input->SizeInBytes());
     (void)jpeg_read_header(&cinfo, TRUE);
     RETURN_IF_NOT_OK(JpegSetColorSpace(&cinfo));
+    cinfo.scale_num = 1;
+    cinfo.scale_denom = static_cast<unsigned int>(scale_denom);
     jpeg_calc_output_dimensions(&cinfo);
   } catch (std::runtime_error &e) {
     return DestroyDecompressAndReturnError(e.what());
@@ -548,22 +554,36 @@ Status HwcToChw(std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> *output)
     CHECK_FAIL_RETURN_UNEXPECTED(input_cv->shape().Size() > CHANNEL_INDEX,
                                  "HWC2CHW: rank of input data should be greater than:" + std::to_string(CHANNEL_INDEX) +
                                    ", but got:" + std::to_string(input_cv->shape().Size()));
-    int num_channels = input_cv->shape()[CHANNEL_INDEX];
-    if (input_cv->shape().Size() != DEFAULT_IMAGE_RANK) {
-      RETURN_STATUS_UNEXPECTED("HWC2CHW: image shape should be <H,W,C>, but got rank: " +
+    // a batch of images <N,H,W,C> is converted to <N,C,H,W>
+    if (input_cv->shape().Size() != DEFAULT_IMAGE_RANK && input_cv->shape().Size() != kBatchImageRank) {
+      RETURN_STATUS_UNEXPECTED("HWC2CHW: image shape should be <H,W,C> or <N,H,W,C>, but got rank: " +
                                std::to_string(input_cv->shape().Size()));
     }
-    cv::Mat output_img;
-
-    int height = input_cv->shape()[0];
-    int width = input_cv->shape()[1];
+    int num_channels = input_cv->shape()[-1];
+    int height = input_cv->shape()[-3];
+    int width = input_cv->shape()[-2];
 
     std::shared_ptr<CVTensor> output_cv;
-    RETURN_IF_NOT_OK(CVTensor::CreateEmpty(TensorShape{num_channels, height, width}, input_cv->type(), &output_cv));
-    for (int i = 0; i < num_channels; ++i) {
-      cv::Mat mat;
-      RETURN_IF_NOT_OK(output_cv->MatAtIndex({i}, &mat));
-      cv::extractChannel(input_cv->mat(), mat, i);
+    if (input_cv->Rank() == DEFAULT_IMAGE_RANK) {
+      RETURN_IF_NOT_OK(CVTensor::CreateEmpty(TensorShape{num_channels, height, width}, input_cv->type(), &output_cv));
+      for (int i = 0; i < num_channels; ++i) {
+        cv::Mat mat;
+        RETURN_IF_NOT_OK(output_cv->MatAtIndex({i}, &mat));
+        cv::extractChannel(input_cv->mat(), mat, i);
+      }
+    } else {
+      int num_images = input_cv->shape()[0];
+      RETURN_IF_NOT_OK(
+        CVTensor::CreateEmpty(TensorShape{num_images, num_channels, height, width}, input_cv->type(), &output_cv));
+      for (int n = 0; n < num_images; ++n) {
+        cv::Mat image;
+        RETURN_IF_NOT_OK(input_cv->MatAtIndex({n}, &image));
+        for (int i = 0; i < num_channels; ++i) {
+          cv::Mat mat;
+          RETURN_IF_NOT_OK(output_cv->MatAtIndex({n, i}, &mat));
+          cv::extractChannel(image, mat, i);
+        }
+      }
     }
     *output = std::move(output_cv);
     return Status::OK();
@@ -816,17 +836,17 @@ Status Rotate(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *out
 template <typename T>
 void Normalize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, std::vector<float> mean,
                std::vector<float> std) {
-  auto itr_out = (*output)->begin<float>();
-  auto itr = input->begin<T>();
-  auto end = input->end<T>();
-  int64_t num_channels = (*output)->shape()[CHANNEL_INDEX];
-
-  while (itr != end) {
+  // loop over the raw buffers, so that the inner loop is vectorized by the compiler
+  const T *in = reinterpret_cast<const T *>(input->GetBuffer());
+  float *out = &(*(*output)->begin<float>());
+  int64_t num_channels = (*output)->shape()[-1];
+  int64_t num_pixels = (*output)->shape().NumOfElements() / num_channels;
+  for (int64_t p = 0; p < num_pixels; p++) {
     for (int64_t i = 0; i < num_channels; i++) {
-      *itr_out = static_cast<float>(*itr) / std[i] - mean[i];
-      ++itr_out;
-      ++itr;
+      out[i] = static_cast<float>(in[i]) / std[i] - mean[i];
     }
+    in += num_channels;
+    out += num_channels;
   }
 }
 
@@ -837,25 +857,26 @@ Status Normalize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *
     RETURN_IF_NOT_OK((*output)->ExpandDim(MIN_IMAGE_DIMENSION));
   }
 
-  CHECK_FAIL_RETURN_UNEXPECTED((*output)->Rank() == DEFAULT_IMAGE_RANK,
-                               "Normalize: output image rank should be:" + std::to_string(DEFAULT_IMAGE_RANK) +
-                                 ", but got:" + std::to_string((*output)->Rank()));
+  // a batch of images <N,H,W,C> is normalized in one pass
+  CHECK_FAIL_RETURN_UNEXPECTED((*output)->Rank() == DEFAULT_IMAGE_RANK || (*output)->Rank() == kBatchImageRank,
+                               "Normalize: output image rank should be:" + std::to_string(DEFAULT_IMAGE_RANK) + " or " +
+                                 std::to_string(kBatchImageRank) + ", but got:" + std::to_string((*output)->Rank()));
   CHECK_FAIL_RETURN_UNEXPECTED(std.size() == mean.size(),
                                "Normalize: mean and std vectors are not of same size, got size of std:" +
                                  std::to_string(std.size()) + ", and mean size:" + std::to_string(mean.size()));
 
   // caller provided 1 mean/std value and there are more than one channel --> duplicate mean/std value
-  if (mean.size() == 1 && (*output)->shape()[CHANNEL_INDEX] != 1) {
-    for (int64_t i = 0; i < (*output)->shape()[CHANNEL_INDEX] - 1; i++) {
+  int64_t num_channels = (*output)->shape()[-1];
+  if (mean.size() == 1 && num_channels != 1) {
+    for (int64_t i = 0; i < num_channels - 1; i++) {
       mean.push_back(mean[0]);
       std.push_back(std[0]);
     }
   }
-  CHECK_FAIL_RETURN_UNEXPECTED((*output)->shape()[CHANNEL_INDEX] == mean.size(),
+  CHECK_FAIL_RETURN_UNEXPECTED(num_channels == mean.size(),
                                "Normalize: number of channels does not match the size of mean and std vectors, got "
                                "channels: " +
-                                 std::to_string((*output)->shape()[CHANNEL_INDEX]) +
-                                 ", size of mean:" + std::to_string(mean.size()));
+                                 std::to_string(num_channels) + ", size of mean:" + std::to_string(mean.size()));
 
   switch (input->type().value()) {
     case DataType::DE_BOOL:
@@ -906,6 +927,139 @@ Status Normalize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *
   return Status::OK();
 }
 
+template <typename T, typename O>
+void NormalizeHwcToChw(const std::shared_ptr<Tensor> &input, const TensorShape &shape,
+                       std::shared_ptr<Tensor> *output, const std::vector<float> &mean, const std::vector<float> &std,
+                       bool flip_horizontal) {
+  int64_t num_images = shape.Rank() == kBatchImageRank ? shape[0] : 1;
+  int64_t height = shape[-3];
+  int64_t width = shape[-2];
+  int64_t num_channels = shape[-1];
+  int64_t plane_size = height * width;
+  const T *in = reinterpret_cast<const T *>(input->GetBuffer());
+  O *out = &(*(*output)->begin<O>());
+  // each row of the HWC image is read once per channel while it is in the cache, and written to the row of the
+  // channel plane, the loop over the pixels of a row is vectorized by the compiler.
+  for (int64_t n = 0; n < num_images; n++) {
+    for (int64_t h = 0; h < height; h++) {
+      const T *in_row = in + (n * height + h) * width * num_channels;
+      for (int64_t c = 0; c < num_channels; c++) {
+        O *out_row = out + (n * num_channels + c) * plane_size + h * width;
+        const float std_c = std[c];
+        const float mean_c = mean[c];
+        if (flip_horizontal) {
+          const T *in_pixel = in_row + (width - 1) * num_channels + c;
+          for (int64_t w = 0; w < width; w++) {
+            out_row[w] = static_cast<O>(static_cast<float>(in_pixel[-w * num_channels]) / std_c - mean_c);
+          }
+        } else {
+          const T *in_pixel = in_row + c;
+          for (int64_t w = 0; w < width; w++) {
+            out_row[w] = static_cast<O>(static_cast<float>(in_pixel[w * num_channels]) / std_c - mean_c);
+          }
+        }
+      }
+    }
+  }
+}
+
+template <typename O>
+Status NormalizeHwcToChw(const std::shared_ptr<Tensor> &input, const TensorShape &shape,
+                         std::shared_ptr<Tensor> *output, const std::vector<float> &mean, const std::vector<float> &std,
+                         bool flip_horizontal) {
+  switch (input->type().value()) {
+    case DataType::DE_BOOL:
+      NormalizeHwcToChw<bool, O>(input, shape, output, mean, std, flip_horizontal);
+      break;
+    case DataType::DE_INT8:
+      NormalizeHwcToChw<int8_t, O>(input, shape, output, mean, std, flip_horizontal);
+      break;
+    case DataType::DE_UINT8:
+      NormalizeHwcToChw<uint8_t, O>(input, shape, output, mean, std, flip_horizontal);
+      break;
+    case DataType::DE_INT16:
+      NormalizeHwcToChw<int16_t, O>(input, shape, output, mean, std, flip_horizontal);
+      break;
+    case DataType::DE_UINT16:
+      NormalizeHwcToChw<uint16_t, O>(input, shape, output, mean, std, flip_horizontal);
+      break;
+    case DataType::DE_INT32:
+      NormalizeHwcToChw<int32_t, O>(input, shape, output, mean, std, flip_horizontal);
+      break;
+    case DataType::DE_UINT32:
+      NormalizeHwcToChw<uint32_t, O>(input, shape, output, mean, std, flip_horizontal);
+      break;
+    case DataType::DE_INT64:
+      NormalizeHwcToChw<int64_t, O>(input, shape, output, mean, std, flip_horizontal);
+      break;
+    case DataType::DE_UINT64:
+      NormalizeHwcToChw<uint64_t, O>(input, shape, output, mean, std, flip_horizontal);
+      break;
+    case DataType::DE_FLOAT16:
+      NormalizeHwcToChw<float16, O>(input, shape, output, mean, std, flip_horizontal);
+      break;
+    case DataType::DE_FLOAT32:
+      NormalizeHwcToChw<float, O>(input, shape, output, mean, std, flip_horizontal);
+      break;
+    case DataType::DE_FLOAT64:
+      NormalizeHwcToChw<double, O>(input, shape, output, mean, std, flip_horizontal);
+      break;
+    default:
+      RETURN_STATUS_UNEXPECTED(
+        "NormalizeHwcToChw: unsupported type, currently supported types include "
+        "[bool,int8_t,uint8_t,int16_t,uint16_t,int32_t,uint32_t,int64_t,uint64_t,float16,float,double].");
+  }
+  return Status::OK();
+}
+
+Status NormalizeHwcToChw(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output,
+                         std::vector<float> mean, std::vector<float> std, bool flip_horizontal,
+                         const DataType &output_type) {
+  RETURN_UNEXPECTED_IF_NULL(input);
+  RETURN_UNEXPECTED_IF_NULL(output);
+  // the same as Normalize, an image <H,W> is taken as <H,W,1>
+  TensorShape shape = input->shape();
+  if (shape.Rank() == MIN_IMAGE_DIMENSION) {
+    shape = shape.AppendDim(1);
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(shape.Rank() == DEFAULT_IMAGE_RANK || shape.Rank() == kBatchImageRank,
+                               "NormalizeHwcToChw: image shape should be <H,W>, <H,W,C> or <N,H,W,C>, but got rank: " +
+                                 std::to_string(input->Rank()));
+  CHECK_FAIL_RETURN_UNEXPECTED(std.size() == mean.size(),
+                               "NormalizeHwcToChw: mean and std vectors are not of same size, got size of std:" +
+                                 std::to_string(std.size()) + ", and mean size:" + std::to_string(mean.size()));
+  int64_t num_channels = shape[-1];
+  if (mean.size() == 1 && num_channels != 1) {
+    float mean_value = mean[0];
+    float std_value = std[0];
+    mean.resize(num_channels, mean_value);
+    std.resize(num_channels, std_value);
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(num_channels == mean.size(),
+                               "NormalizeHwcToChw: number of channels does not match the size of mean and std "
+                               "vectors, got channels: " +
+                                 std::to_string(num_channels) + ", size of mean:" + std::to_string(mean.size()));
+  // the same as NormalizeOp, the mean is divided by the std in advance
+  for (size_t i = 0; i < mean.size(); i++) {
+    mean[i] = mean[i] / std[i];
+  }
+  std::vector<dsize_t> out_shape = {num_channels, shape[-3], shape[-2]};
+  if (shape.Rank() == kBatchImageRank) {
+    (void)out_shape.insert(out_shape.begin(), shape[0]);
+  }
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(TensorShape(out_shape), output_type, output));
+  if (shape.NumOfElements() == 0) {
+    return Status::OK();
+  }
+  if (output_type == DataType::DE_FLOAT16) {
+    return NormalizeHwcToChw<float16>(input, shape, output, mean, std, flip_horizontal);
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(output_type == DataType::DE_FLOAT32,
+                               "NormalizeHwcToChw: output type should be float32 or float16, but got: " +
+                                 output_type.ToString());
+  return NormalizeHwcToChw<float>(input, shape, output, mean, std, flip_horizontal);
+}
+
 Status NormalizePad(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output,
                     const std::shared_ptr<Tensor> &mean, const std::shared_ptr<Tensor> &std, const std::string &dtype) {
   std::shared_ptr<CVTensor> input_cv = CVTensor::AsCVTensor(input);
@@ -44,6 +44,7 @@
 #define MIN_IMAGE_CHANNELS 1      // image ops support minimum of 1 channel
 #define MAX_IMAGE_CHANNELS 4      // image ops support maximum of 4 channel
 #define MIN_IMAGE_DIMENSION 2     // images are at least 2 dimensional
+constexpr int64_t kBatchImageRank = 4;  // a batch of images is nhwc
 namespace mindspore {
 namespace dataset {
 void JpegErrorExitCustom(j_common_ptr cinfo);
@@ -115,8 +116,12 @@ bool IsNonEmptyPNG(const std::shared_ptr<Tensor> &input);
 
 void JpegSetSource(j_decompress_ptr c_info, const void *data, int64_t data_size);
 
+/// \brief Decodes the ROI of a JPEG image, the rows above the ROI are skipped and the columns out of it are not
+///     transformed by the IDCT.
+/// \param scale_denom: decode with the scaled IDCT of libjpeg, the image is downscaled by 1/scale_denom (1, 2, 4 or 8)
+///     while decoding, and the ROI is given in the downscaled image.
 Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int x = 0, int y = 0,
-                         int w = 0, int h = 0);
+                         int w = 0, int h = 0, int scale_denom = 1);
 
 /// \brief Returns Rescaled image
 /// \param input: Tensor of shape <H,W,C> or <H,W> and any OpenCv compatible type, see CVTensor.
@@ -141,8 +146,8 @@ Status Crop(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *outpu
 Status ConvertColor(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, ConvertMode convert_mode);
 
 /// \brief Swaps the channels in the image, i.e. converts HWC to CHW
-/// \param input: Tensor of shape <H,W,C> or <H,W> and any OpenCv compatible type, see CVTensor.
-/// \param output: Tensor of shape <C,H,W> or <H,W> and same input type.
+/// \param input: Tensor of shape <H,W,C>, <N,H,W,C> or <H,W> and any OpenCv compatible type, see CVTensor.
+/// \param output: Tensor of shape <C,H,W>, <N,C,H,W> or <H,W> and same input type.
 Status HwcToChw(std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> *output);
 
 /// \brief Masks the given part of the input image with a another image (sub_mat)
@@ -199,13 +204,26 @@ Status Rotate(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *out
               uint8_t fill_r = 0, uint8_t fill_g = 0, uint8_t fill_b = 0);
 
 /// \brief Returns Normalized image
-/// \param input: Tensor of shape <H,W,C> in RGB order and any OpenCv compatible type, see CVTensor.
+/// \param input: Tensor of shape <H,W,C> or a batch of images <N,H,W,C> in RGB order and any OpenCv compatible type,
+///     see CVTensor.
 /// \param mean: Tensor of shape <3> and type DE_FLOAT32 which are mean of each channel in RGB order
 /// \param std:  Tensor of shape <3> and type DE_FLOAT32 which are std of each channel in RGB order
 /// \param output: Normalized image Tensor of same input shape and type DE_FLOAT32
 Status Normalize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, std::vector<float> mean,
                  std::vector<float> std);
 
+/// \brief Returns the images normalized and converted from HWC to CHW in one pass, the same as HorizontalFlip
+///     (optional), Normalize, HWC2CHW and TypeCast (optional) one by one.
+/// \param input: Tensor of shape <H,W>, <H,W,C> or a batch of images <N,H,W,C> of any numeric type.
+/// \param output: Tensor of shape <C,H,W> (<1,H,W> for <H,W>) or <N,C,H,W> and type output_type.
+/// \param mean: mean of each channel, or one value for all the channels.
+/// \param std: std of each channel, or one value for all the channels.
+/// \param flip_horizontal: whether to flip the images horizontally before the normalization.
+/// \param output_type: DE_FLOAT32 or DE_FLOAT16.
+Status NormalizeHwcToChw(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output,
+                         std::vector<float> mean, std::vector<float> std, bool flip_horizontal,
+                         const DataType &output_type);
+
 /// \brief Returns Normalized and paded image
 /// \param input: Tensor of shape <H,W,C> in RGB order and any OpenCv compatible type, see CVTensor.
 /// \param mean: Tensor of shape <3> and type DE_FLOAT32 which are mean of each channel in RGB order
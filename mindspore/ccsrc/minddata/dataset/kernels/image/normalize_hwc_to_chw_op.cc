@@ -0,0 +1,69 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/kernels/image/normalize_hwc_to_chw_op.h"
+
+#include "minddata/dataset/kernels/image/image_utils.h"
+
+namespace mindspore {
+namespace dataset {
+NormalizeHwcToChwOp::NormalizeHwcToChwOp(const std::vector<float> &mean, const std::vector<float> &std,
+                                         bool flip_horizontal, const DataType &output_type)
+    : mean_(mean), std_(std), flip_horizontal_(flip_horizontal), output_type_(output_type) {}
+
+Status NormalizeHwcToChwOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  IO_CHECK(input, output);
+  return NormalizeHwcToChw(input, output, mean_, std_, flip_horizontal_, output_type_);
+}
+
+Status NormalizeHwcToChwOp::OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) {
+  RETURN_IF_NOT_OK(TensorOp::OutputShape(inputs, outputs));
+  outputs.clear();
+  CHECK_FAIL_RETURN_UNEXPECTED(!inputs.empty(), "NormalizeHwcToChwOp::OutputShape inputs size should > 0");
+  const TensorShape &in = inputs[0];
+  if (in.Rank() == MIN_IMAGE_DIMENSION) {
+    (void)outputs.emplace_back(TensorShape{1, in[0], in[1]});
+  } else if (in.Rank() == DEFAULT_IMAGE_RANK) {
+    (void)outputs.emplace_back(TensorShape{in[-1], in[-3], in[-2]});
+  } else if (in.Rank() == kBatchImageRank) {
+    (void)outputs.emplace_back(TensorShape{in[0], in[-1], in[-3], in[-2]});
+  }
+  if (!outputs.empty()) {
+    return Status::OK();
+  }
+  return Status(StatusCode::kMDUnexpectedError,
+                "NormalizeHwcToChw: invalid input shape, expected 2D, 3D or 4D input, but got input dimension is:" +
+                  std::to_string(in.Rank()));
+}
+
+Status NormalizeHwcToChwOp::OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) {
+  RETURN_IF_NOT_OK(TensorOp::OutputType(inputs, outputs));
+  outputs[0] = output_type_;
+  return Status::OK();
+}
+
+void NormalizeHwcToChwOp::Print(std::ostream &out) const {
+  out << Name() << ", mean: ";
+  for (const auto &m : mean_) {
+    out << m << ", ";
+  }
+  out << "std: ";
+  for (const auto &s : std_) {
+    out << s << ", ";
+  }
+  out << "flip_horizontal: " << flip_horizontal_ << ", output_type: " << output_type_;
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,63 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_NORMALIZE_HWC_TO_CHW_OP_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_NORMALIZE_HWC_TO_CHW_OP_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/kernels/tensor_op.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+// NormalizeHwcToChwOp is the fusion of HorizontalFlip (optional), Normalize, HWC2CHW and TypeCast to float32 or
+// float16 (optional). The image is read once and the normalized values are written to the channel planes directly,
+// instead of creating the intermediate tensors of each op. The input can be an image <H,W,C> or a batch of images
+// <N,H,W,C>, so that it also runs on the batches when the map is after the batch.
+class NormalizeHwcToChwOp : public TensorOp {
+ public:
+  // @param mean: the mean of Normalize.
+  // @param std: the std of Normalize.
+  // @param flip_horizontal: whether HorizontalFlip is fused.
+  // @param output_type: the type of the output, DE_FLOAT32, or DE_FLOAT16 when TypeCast to float16 is fused.
+  NormalizeHwcToChwOp(const std::vector<float> &mean, const std::vector<float> &std, bool flip_horizontal,
+                      const DataType &output_type);
+
+  ~NormalizeHwcToChwOp() override = default;
+
+  void Print(std::ostream &out) const override;
+
+  Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
+
+  Status OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) override;
+
+  Status OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) override;
+
+  std::string Name() const override { return kNormalizeHwcToChwOp; }
+
+ private:
+  std::vector<float> mean_;
+  std::vector<float> std_;
+  bool flip_horizontal_;
+  DataType output_type_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_NORMALIZE_HWC_TO_CHW_OP_H_
@@ -255,6 +255,8 @@ class TypeCastOperation : public TensorOperation {
 
   static Status from_json(nlohmann::json op_params, std::shared_ptr<TensorOperation> *operation);
 
+  const DataType &Type() const { return data_type_; }
+
  private:
   DataType data_type_;
 };
@@ -53,6 +53,8 @@ class CenterCropOperation : public TensorOperation {
 
   static Status from_json(nlohmann::json op_params, std::shared_ptr<TensorOperation> *operation);
 
+  const std::vector<int32_t> &Size() const { return size_; }
+
  private:
   std::vector<int32_t> size_;
 };
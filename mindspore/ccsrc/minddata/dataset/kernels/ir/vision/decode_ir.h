@@ -51,6 +51,8 @@ class DecodeOperation : public TensorOperation {
 
   static Status from_json(nlohmann::json op_params, std::shared_ptr<TensorOperation> *operation);
 
+  bool IsRgb() const { return rgb_; }
+
  private:
   bool rgb_;
 };
@@ -0,0 +1,82 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/kernels/ir/vision/decode_resize_crop_ir.h"
+
+#include "minddata/dataset/kernels/image/decode_resize_crop_op.h"
+
+#include "minddata/dataset/kernels/ir/validators.h"
+#include "minddata/dataset/util/validators.h"
+
+namespace mindspore {
+namespace dataset {
+namespace vision {
+// DecodeResizeCropOperation
+DecodeResizeCropOperation::DecodeResizeCropOperation(const std::vector<int32_t> &resize_size,
+                                                     InterpolationMode interpolation,
+                                                     const std::vector<int32_t> &crop_size)
+    : resize_size_(resize_size), interpolation_(interpolation), crop_size_(crop_size) {}
+
+DecodeResizeCropOperation::~DecodeResizeCropOperation() = default;
+
+std::string DecodeResizeCropOperation::Name() const { return kDecodeResizeCropOperation; }
+
+Status DecodeResizeCropOperation::ValidateParams() {
+  if (resize_size_.empty() && crop_size_.empty()) {
+    std::string err_msg = "DecodeResizeCrop: at least one of Resize and CenterCrop should be fused.";
+    LOG_AND_RETURN_STATUS_SYNTAX_ERROR(err_msg);
+  }
+  if (!resize_size_.empty()) {
+    RETURN_IF_NOT_OK(ValidateVectorSize("DecodeResizeCrop", resize_size_));
+  }
+  if (!crop_size_.empty()) {
+    RETURN_IF_NOT_OK(ValidateVectorSize("DecodeResizeCrop", crop_size_));
+  }
+  return Status::OK();
+}
+
+std::shared_ptr<TensorOp> DecodeResizeCropOperation::Build() {
+  constexpr size_t size_two = 2;
+  // the same as ResizeOperation and CenterCropOperation, a single resize value is for the smaller edge and a single
+  // crop value is for both edges.
+  int32_t resize_height = resize_size_.empty() ? 0 : resize_size_[0];
+  int32_t resize_width = resize_size_.size() == size_two ? resize_size_[1] : 0;
+  int32_t crop_height = crop_size_.empty() ? 0 : crop_size_[0];
+  int32_t crop_width = crop_size_.size() == size_two ? crop_size_[1] : crop_height;
+  return std::make_shared<DecodeResizeCropOp>(resize_height, resize_width, interpolation_, crop_height, crop_width);
+}
+
+Status DecodeResizeCropOperation::to_json(nlohmann::json *out_json) {
+  nlohmann::json args;
+  args["resize_size"] = resize_size_;
+  args["interpolation"] = interpolation_;
+  args["crop_size"] = crop_size_;
+  *out_json = args;
+  return Status::OK();
+}
+
+Status DecodeResizeCropOperation::from_json(nlohmann::json op_params, std::shared_ptr<TensorOperation> *operation) {
+  RETURN_IF_NOT_OK(ValidateParamInJson(op_params, "resize_size", kDecodeResizeCropOperation));
+  RETURN_IF_NOT_OK(ValidateParamInJson(op_params, "interpolation", kDecodeResizeCropOperation));
+  RETURN_IF_NOT_OK(ValidateParamInJson(op_params, "crop_size", kDecodeResizeCropOperation));
+  std::vector<int32_t> resize_size = op_params["resize_size"];
+  InterpolationMode interpolation = static_cast<InterpolationMode>(op_params["interpolation"]);
+  std::vector<int32_t> crop_size = op_params["crop_size"];
+  *operation = std::make_shared<vision::DecodeResizeCropOperation>(resize_size, interpolation, crop_size);
+  return Status::OK();
+}
+}  // namespace vision
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,74 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/kernels/ir/vision/normalize_hwc_to_chw_ir.h"
+
+#include "minddata/dataset/kernels/image/normalize_hwc_to_chw_op.h"
+
+#include "minddata/dataset/kernels/ir/validators.h"
+#include "minddata/dataset/util/validators.h"
+
+namespace mindspore {
+namespace dataset {
+namespace vision {
+// NormalizeHwcToChwOperation
+NormalizeHwcToChwOperation::NormalizeHwcToChwOperation(const std::vector<float> &mean, const std::vector<float> &std,
+                                                       bool flip_horizontal, const DataType &output_type)
+    : mean_(mean), std_(std), flip_horizontal_(flip_horizontal), output_type_(output_type) {}
+
+NormalizeHwcToChwOperation::~NormalizeHwcToChwOperation() = default;
+
+std::string NormalizeHwcToChwOperation::Name() const { return kNormalizeHwcToChwOperation; }
+
+Status NormalizeHwcToChwOperation::ValidateParams() {
+  RETURN_IF_NOT_OK(ValidateVectorMeanStd("NormalizeHwcToChw", mean_, std_));
+  if (output_type_ != DataType::DE_FLOAT32 && output_type_ != DataType::DE_FLOAT16) {
+    std::string err_msg = "NormalizeHwcToChw: output type should be float32 or float16, but got: " +
+                          output_type_.ToString();
+    LOG_AND_RETURN_STATUS_SYNTAX_ERROR(err_msg);
+  }
+  return Status::OK();
+}
+
+std::shared_ptr<TensorOp> NormalizeHwcToChwOperation::Build() {
+  return std::make_shared<NormalizeHwcToChwOp>(mean_, std_, flip_horizontal_, output_type_);
+}
+
+Status NormalizeHwcToChwOperation::to_json(nlohmann::json *out_json) {
+  nlohmann::json args;
+  args["mean"] = mean_;
+  args["std"] = std_;
+  args["flip_horizontal"] = flip_horizontal_;
+  args["output_type"] = output_type_.ToString();
+  *out_json = args;
+  return Status::OK();
+}
+
+Status NormalizeHwcToChwOperation::from_json(nlohmann::json op_params, std::shared_ptr<TensorOperation> *operation) {
+  RETURN_IF_NOT_OK(ValidateParamInJson(op_params, "mean", kNormalizeHwcToChwOperation));
+  RETURN_IF_NOT_OK(ValidateParamInJson(op_params, "std", kNormalizeHwcToChwOperation));
+  RETURN_IF_NOT_OK(ValidateParamInJson(op_params, "flip_horizontal", kNormalizeHwcToChwOperation));
+  RETURN_IF_NOT_OK(ValidateParamInJson(op_params, "output_type", kNormalizeHwcToChwOperation));
+  std::vector<float> mean = op_params["mean"];
+  std::vector<float> std = op_params["std"];
+  bool flip_horizontal = op_params["flip_horizontal"];
+  std::string output_type = op_params["output_type"];
+  *operation =
+    std::make_shared<vision::NormalizeHwcToChwOperation>(mean, std, flip_horizontal, DataType(output_type));
+  return Status::OK();
+}
+}  // namespace vision
+}  // namespace dataset
+}  // namespace mindspore
@@ -51,6 +51,10 @@ class NormalizeOperation : public TensorOperation {
 
   static Status from_json(nlohmann::json op_params, std::shared_ptr<TensorOperation> *operation);
 
+  const std::vector<float> &Mean() const { return mean_; }
+
+  const std::vector<float> &Std() const { return std_; }
+
  private:
   std::vector<float> mean_;
   std::vector<float> std_;
@@ -51,6 +51,10 @@ class ResizeOperation : public TensorOperation {
 
   static Status from_json(nlohmann::json op_params, std::shared_ptr<TensorOperation> *operation);
 
+  const std::vector<int32_t> &Size() const { return size_; }
+
+  InterpolationMode Interpolation() const { return interpolation_; }
+
  private:
   std::vector<int32_t> size_;
   InterpolationMode interpolation_;
@@ -43,8 +43,12 @@ Status PyFuncOp::Compute(const TensorRow &input, TensorRow *output) {
       if (input.size() > 0) {
         for (size_t i = 0; i < input.size(); i++) {
           py::array new_data;
-          RETURN_IF_NOT_OK(input.at(i)->GetDataAsNumpy(&new_data));
-          // possible memcpy here
+          if (zero_copy_input_) {
+            RETURN_IF_NOT_OK(Tensor::GetDataAsNumpyView(input.at(i), &new_data));
+          } else {
+            RETURN_IF_NOT_OK(input.at(i)->GetDataAsNumpy(&new_data));
+            // possible memcpy here
+          }
           input_args[i] = new_data;
         }
         // Invoke python function
@@ -57,9 +57,15 @@ class PyFuncOp : public TensorOp {
   /// \return True if this pyfunc op is random
   bool IsRandom();
 
+  /// \brief Pass the input tensors as read only numpy views instead of copies
+  /// \notes It is set when the pyfunc runs in the python multiprocessing workers, which get a copy of the input.
+  /// \param[in] zero_copy_input Whether to pass the input as views
+  void SetZeroCopyInput(bool zero_copy_input) { zero_copy_input_ = zero_copy_input; }
+
  private:
   py::function py_func_ptr_;
   DataType::Type output_type_;
+  bool zero_copy_input_{false};
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -59,6 +59,7 @@ constexpr char kAutoAugmentOp[] = "AutoAugmentOp";
 constexpr char kAutoContrastOp[] = "AutoContrastOp";
 constexpr char kBoundingBoxAugmentOp[] = "BoundingBoxAugmentOp";
 constexpr char kDecodeOp[] = "DecodeOp";
+constexpr char kDecodeResizeCropOp[] = "DecodeResizeCropOp";
 constexpr char kCenterCropOp[] = "CenterCropOp";
 constexpr char kConvertColorOp[] = "ConvertColorOp";
 constexpr char kCutMixBatchOp[] = "CutMixBatchOp";
@@ -78,6 +79,7 @@ constexpr char kHwcToChwOp[] = "HWC2CHWOp";
 constexpr char kInvertOp[] = "InvertOp";
 constexpr char kMixUpBatchOp[] = "MixUpBatchOp";
 constexpr char kNormalizeOp[] = "NormalizeOp";
+constexpr char kNormalizeHwcToChwOp[] = "NormalizeHwcToChwOp";
 constexpr char kNormalizePadOp[] = "NormalizePadOp";
 constexpr char kPadOp[] = "PadOp";
 constexpr char kRandomAdjustSharpnessOp[] = "RandomAdjustSharpnessOp";
@@ -0,0 +1,127 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_LOCK_FREE_RING_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_LOCK_FREE_RING_H_
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+namespace mindspore {
+namespace dataset {
+// A bounded lock free ring buffer. Each slot carries a sequence number which tells whether the slot is ready to be
+// written or read at a given position, so that the producer and the consumers never take a lock.
+// The ring is designed for one producer thread, but any number of consumer threads can pop from it concurrently,
+// which allows an idle consumer to steal elements from the ring of another producer.
+template <typename T>
+class LockFreeRing {
+ public:
+  explicit LockFreeRing(size_t capacity)
+      : capacity_(capacity == 0 ? 1 : capacity), slots_(std::make_unique<Slot[]>(capacity_)), head_(0), tail_(0) {
+    for (size_t i = 0; i < capacity_; ++i) {
+      slots_[i].seq_.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  ~LockFreeRing() = default;
+
+  // Add an element to the tail of the ring.
+  // @param ele - The element to be moved into the ring, it is untouched when the ring is full.
+  // @return - false if the ring is full.
+  bool TryPush(T &&ele) {
+    size_t pos = tail_.load(std::memory_order_relaxed);
+    Slot *slot = nullptr;
+    while (true) {
+      slot = &slots_[pos % capacity_];
+      size_t seq = slot->seq_.load(std::memory_order_acquire);
+      auto diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos);
+      if (diff == 0) {
+        if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = tail_.load(std::memory_order_relaxed);
+      }
+    }
+    slot->value_ = std::move(ele);
+    slot->seq_.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Pop an element from the head of the ring, it is safe to be called by several threads.
+  // @param p - The address where the popped element will be placed.
+  // @return - false if the ring is empty.
+  bool TryPop(T *p) {
+    size_t pos = head_.load(std::memory_order_relaxed);
+    Slot *slot = nullptr;
+    while (true) {
+      slot = &slots_[pos % capacity_];
+      size_t seq = slot->seq_.load(std::memory_order_acquire);
+      auto diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos + 1);
+      if (diff == 0) {
+        if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = head_.load(std::memory_order_relaxed);
+      }
+    }
+    *p = std::move(slot->value_);
+    // Release the memory held by the element as soon as possible.
+    slot->value_ = T();
+    slot->seq_.store(pos + capacity_, std::memory_order_release);
+    return true;
+  }
+
+  // The number of elements in the ring, it is a snapshot when the ring is accessed concurrently.
+  size_t size() const {
+    size_t head = head_.load(std::memory_order_acquire);
+    size_t tail = tail_.load(std::memory_order_acquire);
+    return tail > head ? tail - head : 0;
+  }
+
+  size_t capacity() const { return capacity_; }
+
+  bool empty() const { return size() == 0; }
+
+  bool full() const { return size() >= capacity_; }
+
+  // Drop all the elements in the ring, it must not be called concurrently with TryPush or TryPop.
+  void Reset() {
+    T val;
+    while (TryPop(&val)) {
+    }
+  }
+
+ private:
+  struct Slot {
+    std::atomic<size_t> seq_;
+    T value_;
+  };
+
+  const size_t capacity_;
+  std::unique_ptr<Slot[]> slots_;
+  // Keep the indices on different cache lines, since they are updated by different threads.
+  alignas(64) std::atomic<size_t> head_;
+  alignas(64) std::atomic<size_t> tail_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_LOCK_FREE_RING_H_
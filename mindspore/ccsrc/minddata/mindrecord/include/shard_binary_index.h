@@ -0,0 +1,156 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_BINARY_INDEX_H_
+#define MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_BINARY_INDEX_H_
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "minddata/mindrecord/include/shard_error.h"
+#include "minddata/mindrecord/include/shard_mmap_file.h"
+
+namespace mindspore {
+namespace mindrecord {
+// The suffix of the binary index file which is generated beside the sqlite index file of each shard.
+const char kBinaryIndexSuffix[] = ".idx";
+
+/// \brief The columns of each row in the binary index, which are the same as the columns of the sqlite index.
+enum BinaryIndexColumn : int {
+  kIndexRowId = 0,
+  kIndexRowGroupId,
+  kIndexPageIdRaw,
+  kIndexPageOffsetRaw,
+  kIndexPageOffsetRawEnd,
+  kIndexPageIdBlob,
+  kIndexPageOffsetBlob,
+  kIndexPageOffsetBlobEnd,
+  kIndexColumnNum
+};
+
+/// \brief Build the binary index of one shard from the rows which are inserted to the sqlite index.
+///
+/// The file contains the columns of the rows sorted by the row id, the order of the rows sorted by the blob page id,
+/// and for each index field a sorted dictionary of the distinct values, the dictionary code of each row and the rows
+/// grouped by the code. All the sections are aligned by 8 bytes so they are used in place after the file is mapped.
+class __attribute__((visibility("default"))) ShardBinaryIndexWriter {
+ public:
+  /// \brief constructor
+  /// \param[in] fields the pairs of the field name in the sqlite index and the sql type of the field
+  explicit ShardBinaryIndexWriter(std::vector<std::pair<std::string, std::string>> fields);
+
+  ~ShardBinaryIndexWriter() = default;
+
+  /// \brief add the rows which are bound to the insert statement of the sqlite index
+  /// \param[in] rows the tuples of place holder, sql type and value of each row
+  /// \return Status
+  Status AddRows(const std::vector<std::vector<std::tuple<std::string, std::string, std::string>>> &rows);
+
+  /// \brief write the binary index file
+  /// \param[in] file_path the path of the binary index file
+  /// \param[in] shard_name the file name of the shard, which is verified by the reader
+  /// \param[in] shard_size the size of the shard file, which is verified by the reader to detect a stale index
+  /// \return Status
+  Status Write(const std::string &file_path, const std::string &shard_name, uint64_t shard_size);
+
+ private:
+  std::vector<std::pair<std::string, std::string>> fields_;
+  std::map<std::string, int> field_ids_;
+  std::vector<std::vector<uint64_t>> columns_;
+  std::vector<std::vector<std::string>> field_values_;
+};
+
+/// \brief The binary index of one shard, which is mapped into memory and queried without sqlite.
+class __attribute__((visibility("default"))) ShardBinaryIndex {
+ public:
+  ShardBinaryIndex() = default;
+
+  ~ShardBinaryIndex() = default;
+
+  /// \brief map the binary index file and check its layout
+  /// \param[in] file_path the path of the binary index file
+  /// \return Status
+  Status Open(const std::string &file_path);
+
+  std::string_view ShardName() const { return shard_name_; }
+
+  uint64_t ShardSize() const { return shard_size_; }
+
+  uint64_t NumRows() const { return num_rows_; }
+
+  /// \brief get a column of a row, the rows are sorted by the row id
+  uint64_t Get(BinaryIndexColumn column, uint64_t row) const { return columns_[column][row]; }
+
+  /// \brief find the row by the row id
+  /// \return the row, or NumRows() if the row id is not found
+  uint64_t FindRow(uint64_t row_id) const;
+
+  /// \brief get the rows in a blob page ordered by the row id
+  /// \param[in] page_id the id of the blob page
+  /// \return the rows
+  std::vector<uint64_t> RowsInBlobPage(uint64_t page_id) const;
+
+  /// \brief get the id of an index field
+  /// \param[in] field_name the field name in the sqlite index, e.g. label_0
+  /// \return the id of the field, -1 if the field is not found
+  int FieldId(const std::string &field_name) const;
+
+  /// \brief get the value of the field of a row, it is the same text as the sqlite index returns
+  std::string_view FieldValue(int field_id, uint64_t row) const;
+
+  /// \brief get the distinct values of the field
+  std::vector<std::string> DistinctValues(int field_id) const;
+
+  /// \brief get the rows ordered by the row id whose field equals the value, numbers are compared by value
+  std::vector<uint64_t> RowsWithValue(int field_id, const std::string &value) const;
+
+  /// \brief whether the field of a row equals the value, numbers are compared by value
+  bool RowHasValue(int field_id, uint64_t row, const std::string &value) const;
+
+ private:
+  struct Field {
+    std::string name_;
+    bool is_number_ = false;
+    uint64_t num_values_ = 0;
+    const uint64_t *value_offsets_ = nullptr;
+    const char *values_ = nullptr;
+    const uint32_t *codes_ = nullptr;
+    const uint64_t *code_row_offsets_ = nullptr;
+    const uint64_t *rows_by_code_ = nullptr;
+  };
+
+  std::string_view DictValue(const Field &field, uint64_t code) const;
+
+  // Find the dictionary codes matching the value, a number field may have several texts of the same value.
+  std::vector<uint64_t> FindCodes(const Field &field, const std::string &value) const;
+
+  std::shared_ptr<ShardMmapFile> file_;
+  std::string_view shard_name_;
+  uint64_t shard_size_ = 0;
+  uint64_t num_rows_ = 0;
+  const uint64_t *columns_[kIndexColumnNum] = {nullptr};
+  const uint64_t *rows_by_blob_page_ = nullptr;
+  std::vector<Field> fields_;
+};
+}  // namespace mindrecord
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_BINARY_INDEX_H_
@@ -71,6 +71,14 @@ class __attribute__((visibility("default"))) ShardColumn {
                               ColumnDataType *column_data_type, uint64_t *column_data_type_size,
                               std::vector<int64_t> *column_shape);
 
+  /// \brief get column value by column name, the blob is given by its address and size so that it can be a view
+  /// of the mapped file, and the data of uncompressed blob column points into the blob
+  Status GetColumnValueByName(const std::string &column_name, const uint8_t *columns_blob, uint64_t blob_size,
+                              const json &columns_json, const unsigned char **data,
+                              std::unique_ptr<unsigned char[]> *data_ptr, uint64_t *const n_bytes,
+                              ColumnDataType *column_data_type, uint64_t *column_data_type_size,
+                              std::vector<int64_t> *column_shape);
+
   /// \brief compress blob
   std::vector<uint8_t> CompressBlob(const std::vector<uint8_t> &blob, int64_t *compression_size);
 
@@ -94,6 +102,11 @@ class __attribute__((visibility("default"))) ShardColumn {
                            const unsigned char **data, std::unique_ptr<unsigned char[]> *data_ptr,
                            uint64_t *const n_bytes);
 
+  /// \brief get column value from blob given by its address and size
+  Status GetColumnFromBlob(const std::string &column_name, const uint8_t *columns_blob, uint64_t blob_size,
+                           const unsigned char **data, std::unique_ptr<unsigned char[]> *data_ptr,
+                           uint64_t *const n_bytes);
+
   /// \brief get column type
   Status GetColumnTypeByName(const std::string &column_name, ColumnDataType *column_data_type,
                              uint64_t *column_data_type_size, std::vector<int64_t> *column_shape,
@@ -116,7 +129,7 @@ class __attribute__((visibility("default"))) ShardColumn {
   Status GetInt(std::unique_ptr<unsigned char[]> *data_ptr, const json &json_column_value);
 
   /// \brief get column offset address and size from blob
-  Status GetColumnAddressInBlock(const uint64_t &column_id, const std::vector<uint8_t> &columns_blob,
+  Status GetColumnAddressInBlock(const uint64_t &column_id, const uint8_t *columns_blob, uint64_t blob_size,
                                  uint64_t *num_bytes, uint64_t *shift_idx);
 
   /// \brief check if column name is available
@@ -128,7 +141,7 @@ class __attribute__((visibility("default"))) ShardColumn {
   /// \brief uncompress integer array column
   template <typename T>
   static Status UncompressInt(const uint64_t &column_id, std::unique_ptr<unsigned char[]> *const data_ptr,
-                              const std::vector<uint8_t> &columns_blob, uint64_t *num_bytes, uint64_t shift_idx);
+                              const uint8_t *columns_blob, uint64_t *num_bytes, uint64_t shift_idx);
 
   /// \brief convert big-endian bytes to unsigned int
   /// \param bytes_array bytes array
@@ -138,6 +151,13 @@ class __attribute__((visibility("default"))) ShardColumn {
   static uint64_t BytesBigToUInt64(const std::vector<uint8_t> &bytes_array, const uint64_t &pos,
                                    const IntegerType &i_type);
 
+  /// \brief convert big-endian bytes to unsigned int
+  /// \param bytes_array address of bytes array
+  /// \param pos shift address in bytes array
+  /// \param i_type integer type
+  /// \return unsigned int
+  static uint64_t BytesBigToUInt64(const uint8_t *bytes_array, const uint64_t &pos, const IntegerType &i_type);
+
   /// \brief convert unsigned int to big-endian bytes
   /// \param value integer value
   /// \param i_type integer type
@@ -159,6 +179,15 @@ class __attribute__((visibility("default"))) ShardColumn {
   static int64_t BytesLittleToMinIntType(const std::vector<uint8_t> &bytes_array, const uint64_t &pos,
                                          const IntegerType &src_i_type, IntegerType *dst_i_type = nullptr);
 
+  /// \brief convert little-endian bytes to the minimum integer type
+  /// \param bytes_array address of bytes array
+  /// \param pos shift address in bytes array
+  /// \param src_i_type source integer type
+  /// \param dst_i_type (output), destination integer type
+  /// \return integer
+  static int64_t BytesLittleToMinIntType(const uint8_t *bytes_array, const uint64_t &pos,
+                                         const IntegerType &src_i_type, IntegerType *dst_i_type = nullptr);
+
  private:
   std::vector<std::string> column_name_;                      // column name list
   std::vector<ColumnDataType> column_data_type_;              // column data type list
@@ -0,0 +1,63 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_MMAP_FILE_H_
+#define MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_MMAP_FILE_H_
+
+#include <cstdint>
+#include <string>
+#include "minddata/mindrecord/include/shard_error.h"
+
+namespace mindspore {
+namespace mindrecord {
+/// \brief A shard file mapped into memory in read only mode, the blobs are read from the mapped memory directly
+/// instead of being copied from the file stream.
+class __attribute__((visibility("default"))) ShardMmapFile {
+ public:
+  ShardMmapFile() = default;
+
+  ~ShardMmapFile();
+
+  ShardMmapFile(const ShardMmapFile &) = delete;
+
+  ShardMmapFile &operator=(const ShardMmapFile &) = delete;
+
+  /// \brief map the whole file into memory
+  /// \param[in] file_path the real path of the shard file
+  /// \return Status the status of mapping
+  Status Open(const std::string &file_path);
+
+  /// \brief get the address of a range in the file
+  /// \param[in] offset the offset of the range in the file
+  /// \param[in] length the length of the range
+  /// \return the address of the range, nullptr if the range is out of the file
+  const uint8_t *Data(uint64_t offset, uint64_t length) const;
+
+  /// \brief advise the kernel to read ahead a range which is going to be accessed soon
+  /// \param[in] offset the offset of the range in the file
+  /// \param[in] length the length of the range
+  void WillNeed(uint64_t offset, uint64_t length) const;
+
+  uint64_t Size() const { return size_; }
+
+ private:
+  void *addr_ = nullptr;
+  uint64_t size_ = 0;
+};
+}  // namespace mindrecord
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_MMAP_FILE_H_
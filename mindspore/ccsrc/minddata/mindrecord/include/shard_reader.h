@@ -43,11 +43,13 @@
 #include <utility>
 #include <vector>
 #include "minddata/mindrecord/include/common/shard_utils.h"
+#include "minddata/mindrecord/include/shard_binary_index.h"
 #include "minddata/mindrecord/include/shard_category.h"
 #include "minddata/mindrecord/include/shard_column.h"
 #include "minddata/mindrecord/include/shard_distributed_sample.h"
 #include "minddata/mindrecord/include/shard_error.h"
 #include "minddata/mindrecord/include/shard_index_generator.h"
+#include "minddata/mindrecord/include/shard_mmap_file.h"
 #include "minddata/mindrecord/include/shard_operator.h"
 #include "minddata/mindrecord/include/shard_pk_sample.h"
 #include "minddata/mindrecord/include/shard_reader.h"
@@ -62,7 +64,16 @@ namespace mindrecord {
 using ROW_GROUPS = std::pair<std::vector<std::vector<std::vector<uint64_t>>>, std::vector<std::vector<json>>>;
 using ROW_GROUP_BRIEF = std::tuple<std::string, int, uint64_t, std::vector<std::vector<uint64_t>>, std::vector<json>>;
 using TASK_CONTENT = std::pair<TaskType, std::vector<std::tuple<std::vector<uint8_t>, json>>>;
-const int kNumBatchInMap = 1000;  // iterator buffer size in row-reader mode
+const int kNumBatchInMap = 1000;    // iterator buffer size in row-reader mode
+const int kNumReadAheadTasks = 64;  // number of upcoming tasks whose blobs are read ahead in mmap mode
+
+/// \brief the blob of one row, which points into the mapped shard file without copy in mmap mode
+struct ShardBlobView {
+  const uint8_t *data = nullptr;        // address of the blob
+  uint64_t size = 0;                    // size of the blob
+  std::shared_ptr<ShardMmapFile> file;  // keep the mapped file alive while the view is in use
+  std::vector<uint8_t> buffer;          // hold the blob read from file stream if the file is not mapped
+};
 
 class API_PUBLIC ShardReader {
  public:
@@ -78,11 +89,12 @@ class API_PUBLIC ShardReader {
   /// \param[in] operators operators applied to data, operator type is shuffle, sample or category
   /// \param[in] num_padded the number of padded samples
   /// \param[in] lazy_load if the mindrecord dataset is too large, enable lazy load mode to speed up initialization
+  /// \param[in] use_mmap map the shard files into memory and read the blobs without copy
   /// \return MSRStatus the status of MSRStatus
   Status Open(const std::vector<std::string> &file_paths, bool load_dataset, int n_consumer = 4,
               const std::vector<std::string> &selected_columns = {},
               const std::vector<std::shared_ptr<ShardOperator>> &operators = {}, const int64_t num_padded = 0,
-              bool lazy_load = false);
+              bool lazy_load = false, bool use_mmap = false);
 
   /// \brief close reader
   /// \return null
@@ -183,6 +195,16 @@ class API_PUBLIC ShardReader {
   /// \brief return a row by id
   /// \return a batch of images and image data
   TASK_CONTENT GetNextById(const int64_t &task_id, const int32_t &consumer_id);
+
+  /// \brief return the blob view of a row by id, the blob is not copied if the shard file is mapped
+  /// \param[in] task_id the id of the task
+  /// \param[in] consumer_id the id of the consumer whose file stream is used if the shard file is not mapped
+  /// \param[out] task_type the type of the task
+  /// \param[out] blob the view of the blob
+  /// \param[out] var_fields the scalar variable fields
+  /// \return MSRStatus the status of MSRStatus, kMDInterrupted if the reader is interrupted
+  Status GetBlobViewById(int64_t task_id, int32_t consumer_id, TaskType *task_type, ShardBlobView *blob,
+                         json *var_fields);
   /// \brief  get blob filed list
   /// \return blob field list
   std::pair<ShardType, std::vector<std::string>> GetBlobFields();
@@ -219,6 +241,10 @@ class API_PUBLIC ShardReader {
                             const std::vector<std::string> &columns,
                             std::shared_ptr<std::vector<std::vector<json>>> col_val_ptr);
 
+  /// \brief read the scalar fields of one row from the raw data page
+  Status ReadRawLabel(const std::shared_ptr<std::fstream> &fs, int raw_page_id, uint64_t label_start,
+                      uint64_t label_end, const std::vector<std::string> &columns, json *label);
+
   /// \brief convert json format to expected type
   Status ConvertJsonValue(const std::vector<std::string> &label, const std::vector<std::string> &columns,
                           const json &schema, json *value);
@@ -235,6 +261,22 @@ class API_PUBLIC ShardReader {
                             std::shared_ptr<std::vector<std::vector<std::vector<uint64_t>>>> offset_ptr,
                             std::shared_ptr<std::vector<std::vector<json>>> col_val_ptr);
 
+  /// \brief read the rows in one shard from the binary index
+  /// \param[in] row_id the row id to read, -1 to read all the rows
+  Status ReadRowsInBinaryIndex(int shard_id, int64_t row_id, const std::vector<std::string> &columns,
+                               std::shared_ptr<std::vector<std::vector<std::vector<uint64_t>>>> offset_ptr,
+                               std::shared_ptr<std::vector<std::vector<json>>> col_val_ptr);
+
+  /// \brief find the rows in a blob page which fulfill the criteria from the binary index
+  Status FindRowsInBinaryIndex(int page_id, int shard_id, const std::pair<std::string, std::string> &criteria,
+                               std::vector<uint64_t> *rows);
+
+  /// \brief get the id of the index field of a column in the binary index
+  Status GetBinaryIndexFieldId(int shard_id, const std::string &column, int *field_id);
+
+  /// \brief open the binary index of a shard file, fails if it is absent or does not match the shard file
+  Status OpenBinaryIndex(const std::string &file, std::shared_ptr<ShardBinaryIndex> *binary_index);
+
   /// \brief initialize reader
   Status Init(const std::vector<std::string> &file_paths, bool load_dataset);
 
@@ -290,6 +332,20 @@ class API_PUBLIC ShardReader {
   /// \brief read one row by one task
   Status ConsumerOneTask(int64_t task_id, uint32_t consumer_id, std::shared_ptr<TASK_CONTENT> *task_content_pt);
 
+  /// \brief get the location of the blob and the scalar variable fields of one task, var_fields can be nullptr
+  Status GetTaskBlobLocation(int64_t task_id, TaskType *task_type, uint32_t *shard_id, uint64_t *file_offset,
+                             uint64_t *blob_size, json *var_fields);
+
+  /// \brief read the blob from the file stream of the consumer
+  Status ReadBlobFromStream(uint32_t consumer_id, uint32_t shard_id, uint64_t file_offset, uint64_t blob_size,
+                            uint8_t *dst);
+
+  /// \brief map all the shard files into memory, fall back to file stream if a file fails to be mapped
+  void MapShardFiles();
+
+  /// \brief advise the kernel to read ahead the blobs of the upcoming tasks in the sample ids
+  void ReadAheadTasks();
+
   /// \brief get labels from binary file
   Status GetLabelsFromBinaryFile(int shard_id, const std::vector<std::string> &columns,
                                  const std::vector<std::vector<std::string>> &label_offsets,
@@ -299,6 +355,10 @@ class API_PUBLIC ShardReader {
   void GetClassesInShard(sqlite3 *db, int shard_id, const std::string &sql,
                          std::shared_ptr<std::set<std::string>> category_ptr);
 
+  /// \brief get classes in one shard from the binary index
+  void GetClassesInBinaryIndex(int shard_id, const std::string &field_name,
+                               std::shared_ptr<std::set<std::string>> category_ptr);
+
   /// \brief get number of classes
   int64_t GetNumClasses(const std::string &category_field);
 
@@ -314,9 +374,11 @@ class API_PUBLIC ShardReader {
   std::shared_ptr<ShardColumn> shard_column_;  // shard column
 
   std::vector<sqlite3 *> database_paths_;                                        // sqlite handle list
+  std::vector<std::shared_ptr<ShardBinaryIndex>> binary_indexes_;                // binary index list, nullptr if absent
   std::vector<string> file_paths_;                                               // file paths
   std::vector<std::shared_ptr<std::fstream>> file_streams_;                      // single-file handle list
   std::vector<std::vector<std::shared_ptr<std::fstream>>> file_streams_random_;  // multiple-file handle list
+  bool use_binary_index_ = true;  // use the binary index instead of the sqlite index if it is available
 
  private:
   int n_consumer_;                                         // number of workers (threads)
@@ -349,6 +411,11 @@ class API_PUBLIC ShardReader {
   // all metadata in the index is not loaded during initialization
   bool lazy_load_;
 
+  // mmap mode, the blobs are read from the mapped shard files
+  bool use_mmap_ = false;
+  std::vector<std::shared_ptr<ShardMmapFile>> mmap_files_;  // mapped file of each shard, nullptr if not mapped
+  std::atomic<int64_t> read_ahead_position_{0};             // approximate position in the sample ids being read
+
   // indicate shard_id : inc_count
   // 0 : 15  -  shard0 has 15 samples
   // 1 : 41  -  shard1 has 26 samples
@@ -0,0 +1,432 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/mindrecord/include/shard_binary_index.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+
+namespace mindspore {
+namespace mindrecord {
+namespace {
+const char kBinaryIndexMagic[] = "MRIDX001";
+constexpr uint64_t kBinaryIndexMagicLen = 8;
+constexpr uint64_t kBinaryIndexAlign = 8;
+// The place holders of the insert statement of the sqlite index, in the order of BinaryIndexColumn.
+const char *const kIndexColumnPlaceHolders[kIndexColumnNum] = {
+  ":ROW_ID",       ":ROW_GROUP_ID",     ":PAGE_ID_RAW",         ":PAGE_OFFSET_RAW", ":PAGE_OFFSET_RAW_END",
+  ":PAGE_ID_BLOB", ":PAGE_OFFSET_BLOB", ":PAGE_OFFSET_BLOB_END"};
+
+uint64_t AlignUp(uint64_t size) { return (size + kBinaryIndexAlign - 1) / kBinaryIndexAlign * kBinaryIndexAlign; }
+
+bool IsNumberType(const std::string &type) { return type == "INTEGER" || type == "NUMERIC"; }
+
+bool ParseNumber(std::string_view text, long double *value) {
+  try {
+    size_t pos = 0;
+    *value = std::stold(std::string(text), &pos);
+    return pos == text.size();
+  } catch (...) {
+    return false;
+  }
+}
+
+// Append the values to the file in the order of the layout.
+class IndexFileWriter {
+ public:
+  explicit IndexFileWriter(std::ofstream *out) : out_(out) {}
+
+  void WriteU64(uint64_t value) { (void)out_->write(reinterpret_cast<const char *>(&value), sizeof(value)); }
+
+  void WriteU64Array(const std::vector<uint64_t> &values) {
+    (void)out_->write(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(uint64_t));
+  }
+
+  void WriteU32Array(const std::vector<uint32_t> &values) {
+    (void)out_->write(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(uint32_t));
+    Pad(values.size() * sizeof(uint32_t));
+  }
+
+  void WriteBytes(const char *data, uint64_t size) {
+    (void)out_->write(data, size);
+    Pad(size);
+  }
+
+  void WriteString(const std::string &value) {
+    WriteU64(value.size());
+    WriteBytes(value.data(), value.size());
+  }
+
+ private:
+  void Pad(uint64_t size) {
+    static const char zeros[kBinaryIndexAlign] = {0};
+    (void)out_->write(zeros, AlignUp(size) - size);
+  }
+
+  std::ofstream *out_;
+};
+
+// Take the sections from the mapped file in the order of the layout, and check that they are inside the file.
+class IndexFileParser {
+ public:
+  IndexFileParser(const uint8_t *data, uint64_t size) : data_(data), size_(size) {}
+
+  bool Take(uint64_t size, const uint8_t **section) {
+    auto aligned_size = AlignUp(size);
+    if (aligned_size < size || pos_ > size_ || aligned_size > size_ - pos_) {
+      return false;
+    }
+    *section = data_ + pos_;
+    pos_ += aligned_size;
+    return true;
+  }
+
+  bool TakeU64(uint64_t *value) {
+    const uint8_t *section = nullptr;
+    if (!Take(sizeof(uint64_t), &section)) {
+      return false;
+    }
+    *value = *reinterpret_cast<const uint64_t *>(section);
+    return true;
+  }
+
+  template <typename T>
+  bool TakeArray(uint64_t count, const T **array) {
+    if (count > size_ / sizeof(T)) {
+      return false;
+    }
+    const uint8_t *section = nullptr;
+    if (!Take(count * sizeof(T), &section)) {
+      return false;
+    }
+    *array = reinterpret_cast<const T *>(section);
+    return true;
+  }
+
+  bool TakeString(std::string_view *value) {
+    uint64_t len = 0;
+    const char *chars = nullptr;
+    if (!TakeU64(&len) || !TakeArray(len, &chars)) {
+      return false;
+    }
+    *value = std::string_view(chars, len);
+    return true;
+  }
+
+  bool Finished() const { return pos_ == size_; }
+
+ private:
+  const uint8_t *data_;
+  uint64_t size_;
+  uint64_t pos_ = 0;
+};
+}  // namespace
+
+ShardBinaryIndexWriter::ShardBinaryIndexWriter(std::vector<std::pair<std::string, std::string>> fields)
+    : fields_(std::move(fields)), columns_(kIndexColumnNum), field_values_(fields_.size()) {
+  for (size_t i = 0; i < fields_.size(); ++i) {
+    field_ids_[":" + fields_[i].first] = static_cast<int>(i);
+  }
+}
+
+Status ShardBinaryIndexWriter::AddRows(
+  const std::vector<std::vector<std::tuple<std::string, std::string, std::string>>> &rows) {
+  for (const auto &row : rows) {
+    std::vector<bool> filled(kIndexColumnNum + fields_.size(), false);
+    for (const auto &item : row) {
+      const auto &place_holder = std::get<0>(item);
+      const auto &value = std::get<2>(item);
+      auto column = std::find(kIndexColumnPlaceHolders, kIndexColumnPlaceHolders + kIndexColumnNum, place_holder) -
+                    kIndexColumnPlaceHolders;
+      if (column < kIndexColumnNum) {
+        try {
+          columns_[column].push_back(std::stoull(value));
+        } catch (...) {
+          RETURN_STATUS_UNEXPECTED("[Internal ERROR] Failed to convert the value of " + place_holder + ": " + value);
+        }
+        filled[column] = true;
+        continue;
+      }
+      auto iter = field_ids_.find(place_holder);
+      if (iter == field_ids_.end()) {
+        continue;
+      }
+      auto text = value;
+      // The integer is stored as int64 by sqlite, keep the same text as it returns.
+      if (fields_[iter->second].second == "INTEGER") {
+        try {
+          text = std::to_string(std::stoll(value));
+        } catch (...) {
+          RETURN_STATUS_UNEXPECTED("[Internal ERROR] Failed to convert the value of " + place_holder + ": " + value);
+        }
+      }
+      field_values_[iter->second].emplace_back(std::move(text));
+      filled[kIndexColumnNum + iter->second] = true;
+    }
+    CHECK_FAIL_RETURN_UNEXPECTED(std::all_of(filled.begin(), filled.end(), [](bool f) { return f; }),
+                                 "[Internal ERROR] The row of index misses some columns.");
+  }
+  return Status::OK();
+}
+
+Status ShardBinaryIndexWriter::Write(const std::string &file_path, const std::string &shard_name,
+                                     uint64_t shard_size) {
+  uint64_t num_rows = columns_[kIndexRowId].size();
+  // Sort the rows by the row id, and the blob pages keep the order of the row id in each page.
+  std::vector<uint64_t> order(num_rows);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [this](uint64_t a, uint64_t b) { return columns_[kIndexRowId][a] < columns_[kIndexRowId][b]; });
+  std::vector<uint64_t> rows_by_blob_page(num_rows);
+  std::iota(rows_by_blob_page.begin(), rows_by_blob_page.end(), 0);
+  const auto &blob_pages = columns_[kIndexPageIdBlob];
+  std::stable_sort(rows_by_blob_page.begin(), rows_by_blob_page.end(), [&order, &blob_pages](uint64_t a, uint64_t b) {
+    return blob_pages[order[a]] < blob_pages[order[b]];
+  });
+
+  std::ofstream out(file_path, std::ios::out | std::ios::binary | std::ios::trunc);
+  CHECK_FAIL_RETURN_UNEXPECTED(out.good(), "[Internal ERROR] Failed to open mindrecord index file: " + file_path);
+  IndexFileWriter writer(&out);
+  writer.WriteBytes(kBinaryIndexMagic, kBinaryIndexMagicLen);
+  writer.WriteString(shard_name);
+  writer.WriteU64(shard_size);
+  writer.WriteU64(num_rows);
+  writer.WriteU64(fields_.size());
+  std::vector<uint64_t> sorted(num_rows);
+  for (const auto &column : columns_) {
+    for (uint64_t i = 0; i < num_rows; ++i) {
+      sorted[i] = column[order[i]];
+    }
+    writer.WriteU64Array(sorted);
+  }
+  writer.WriteU64Array(rows_by_blob_page);
+
+  for (size_t f = 0; f < fields_.size(); ++f) {
+    const auto &values = field_values_[f];
+    std::vector<std::string> dict(values);
+    std::sort(dict.begin(), dict.end());
+    dict.erase(std::unique(dict.begin(), dict.end()), dict.end());
+    std::vector<uint64_t> value_offsets(dict.size() + 1, 0);
+    std::string value_chars;
+    for (size_t i = 0; i < dict.size(); ++i) {
+      value_chars += dict[i];
+      value_offsets[i + 1] = value_chars.size();
+    }
+    // Group the rows by the code, the rows in a group keep the order of the row id.
+    std::vector<uint32_t> codes(num_rows);
+    std::vector<uint64_t> code_row_offsets(dict.size() + 1, 0);
+    for (uint64_t i = 0; i < num_rows; ++i) {
+      const auto &value = values[order[i]];
+      codes[i] = static_cast<uint32_t>(std::lower_bound(dict.begin(), dict.end(), value) - dict.begin());
+      ++code_row_offsets[codes[i] + 1];
+    }
+    std::partial_sum(code_row_offsets.begin(), code_row_offsets.end(), code_row_offsets.begin());
+    std::vector<uint64_t> rows_by_code(num_rows);
+    std::vector<uint64_t> next(code_row_offsets.begin(), code_row_offsets.end() - 1);
+    for (uint64_t i = 0; i < num_rows; ++i) {
+      rows_by_code[next[codes[i]]++] = i;
+    }
+
+    writer.WriteString(fields_[f].first);
+    writer.WriteString(fields_[f].second);
+    writer.WriteU64(dict.size());
+    writer.WriteU64Array(value_offsets);
+    writer.WriteBytes(value_chars.data(), value_chars.size());
+    writer.WriteU32Array(codes);
+    writer.WriteU64Array(code_row_offsets);
+    writer.WriteU64Array(rows_by_code);
+  }
+  out.close();
+  CHECK_FAIL_RETURN_UNEXPECTED(!out.fail(), "[Internal ERROR] Failed to write mindrecord index file: " + file_path);
+  return Status::OK();
+}
+
+Status ShardBinaryIndex::Open(const std::string &file_path) {
+  file_ = std::make_shared<ShardMmapFile>();
+  RETURN_IF_NOT_OK(file_->Open(file_path));
+  // The index is scanned when the tasks are created, so read it ahead as a whole.
+  file_->WillNeed(0, file_->Size());
+  const std::string err_msg = "Invalid file, the mindrecord index file is broken: " + file_path;
+  IndexFileParser parser(file_->Data(0, file_->Size()), file_->Size());
+  const uint8_t *magic = nullptr;
+  CHECK_FAIL_RETURN_UNEXPECTED(parser.Take(kBinaryIndexMagicLen, &magic) &&
+                                 memcmp(magic, kBinaryIndexMagic, kBinaryIndexMagicLen) == 0,
+                               err_msg);
+  uint64_t num_fields = 0;
+  CHECK_FAIL_RETURN_UNEXPECTED(parser.TakeString(&shard_name_) && parser.TakeU64(&shard_size_) &&
+                                 parser.TakeU64(&num_rows_) && parser.TakeU64(&num_fields),
+                               err_msg);
+  for (auto &column : columns_) {
+    CHECK_FAIL_RETURN_UNEXPECTED(parser.TakeArray(num_rows_, &column), err_msg);
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(parser.TakeArray(num_rows_, &rows_by_blob_page_), err_msg);
+
+  fields_.clear();
+  for (uint64_t f = 0; f < num_fields; ++f) {
+    Field field;
+    std::string_view name;
+    std::string_view type;
+    uint64_t num_chars = 0;
+    CHECK_FAIL_RETURN_UNEXPECTED(parser.TakeString(&name) && parser.TakeString(&type) &&
+                                   parser.TakeU64(&field.num_values_) && field.num_values_ < UINT32_MAX &&
+                                   parser.TakeArray(field.num_values_ + 1, &field.value_offsets_),
+                                 err_msg);
+    num_chars = field.value_offsets_[field.num_values_];
+    CHECK_FAIL_RETURN_UNEXPECTED(parser.TakeArray(num_chars, &field.values_) &&
+                                   parser.TakeArray(num_rows_, &field.codes_) &&
+                                   parser.TakeArray(field.num_values_ + 1, &field.code_row_offsets_) &&
+                                   parser.TakeArray(num_rows_, &field.rows_by_code_),
+                                 err_msg);
+    for (uint64_t i = 0; i < field.num_values_; ++i) {
+      CHECK_FAIL_RETURN_UNEXPECTED(field.value_offsets_[i] <= field.value_offsets_[i + 1] &&
+                                     field.code_row_offsets_[i] <= field.code_row_offsets_[i + 1],
+                                   err_msg);
+    }
+    CHECK_FAIL_RETURN_UNEXPECTED(field.code_row_offsets_[field.num_values_] == num_rows_, err_msg);
+    field.name_ = std::string(name);
+    field.is_number_ = IsNumberType(std::string(type));
+    fields_.emplace_back(std::move(field));
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(parser.Finished(), err_msg);
+  // The codes and rows are checked once here, so the queries do not check them any more.
+  for (const auto &field : fields_) {
+    for (uint64_t i = 0; i < num_rows_; ++i) {
+      CHECK_FAIL_RETURN_UNEXPECTED(field.codes_[i] < field.num_values_ && field.rows_by_code_[i] < num_rows_, err_msg);
+    }
+  }
+  for (uint64_t i = 0; i < num_rows_; ++i) {
+    CHECK_FAIL_RETURN_UNEXPECTED(rows_by_blob_page_[i] < num_rows_, err_msg);
+  }
+  return Status::OK();
+}
+
+uint64_t ShardBinaryIndex::FindRow(uint64_t row_id) const {
+  const uint64_t *row_ids = columns_[kIndexRowId];
+  auto iter = std::lower_bound(row_ids, row_ids + num_rows_, row_id);
+  if (iter == row_ids + num_rows_ || *iter != row_id) {
+    return num_rows_;
+  }
+  return static_cast<uint64_t>(iter - row_ids);
+}
+
+std::vector<uint64_t> ShardBinaryIndex::RowsInBlobPage(uint64_t page_id) const {
+  const uint64_t *blob_pages = columns_[kIndexPageIdBlob];
+  // Binary search the first row of the page in the rows ordered by the blob page id.
+  uint64_t low = 0;
+  uint64_t high = num_rows_;
+  while (low < high) {
+    auto mid = low + (high - low) / 2;
+    if (blob_pages[rows_by_blob_page_[mid]] < page_id) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  std::vector<uint64_t> rows;
+  for (auto i = low; i < num_rows_ && blob_pages[rows_by_blob_page_[i]] == page_id; ++i) {
+    rows.push_back(rows_by_blob_page_[i]);
+  }
+  return rows;
+}
+
+int ShardBinaryIndex::FieldId(const std::string &field_name) const {
+  for (size_t i = 0; i < fields_.size(); ++i) {
+    if (fields_[i].name_ == field_name) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+std::string_view ShardBinaryIndex::DictValue(const Field &field, uint64_t code) const {
+  auto begin = field.value_offsets_[code];
+  return std::string_view(field.values_ + begin, field.value_offsets_[code + 1] - begin);
+}
+
+std::string_view ShardBinaryIndex::FieldValue(int field_id, uint64_t row) const {
+  const auto &field = fields_[field_id];
+  return DictValue(field, field.codes_[row]);
+}
+
+std::vector<std::string> ShardBinaryIndex::DistinctValues(int field_id) const {
+  const auto &field = fields_[field_id];
+  std::vector<std::string> values;
+  values.reserve(field.num_values_);
+  for (uint64_t i = 0; i < field.num_values_; ++i) {
+    values.emplace_back(DictValue(field, i));
+  }
+  return values;
+}
+
+std::vector<uint64_t> ShardBinaryIndex::FindCodes(const Field &field, const std::string &value) const {
+  std::vector<uint64_t> codes;
+  if (!field.is_number_) {
+    uint64_t low = 0;
+    uint64_t high = field.num_values_;
+    while (low < high) {
+      auto mid = low + (high - low) / 2;
+      if (DictValue(field, mid) < value) {
+        low = mid + 1;
+      } else {
+        high = mid;
+      }
+    }
+    if (low < field.num_values_ && DictValue(field, low) == value) {
+      codes.push_back(low);
+    }
+    return codes;
+  }
+  // The numbers are compared by value as sqlite does, e.g. 1 equals 1.0.
+  long double target = 0;
+  if (!ParseNumber(value, &target)) {
+    return codes;
+  }
+  for (uint64_t i = 0; i < field.num_values_; ++i) {
+    long double number = 0;
+    if (ParseNumber(DictValue(field, i), &number) && number == target) {
+      codes.push_back(i);
+    }
+  }
+  return codes;
+}
+
+std::vector<uint64_t> ShardBinaryIndex::RowsWithValue(int field_id, const std::string &value) const {
+  const auto &field = fields_[field_id];
+  std::vector<uint64_t> rows;
+  for (auto code : FindCodes(field, value)) {
+    rows.insert(rows.end(), field.rows_by_code_ + field.code_row_offsets_[code],
+                field.rows_by_code_ + field.code_row_offsets_[code + 1]);
+  }
+  if (field.is_number_) {
+    std::sort(rows.begin(), rows.end());
+  }
+  return rows;
+}
+
+bool ShardBinaryIndex::RowHasValue(int field_id, uint64_t row, const std::string &value) const {
+  const auto &field = fields_[field_id];
+  auto text = DictValue(field, field.codes_[row]);
+  if (!field.is_number_) {
+    return text == value;
+  }
+  long double target = 0;
+  long double number = 0;
+  return ParseNumber(value, &target) && ParseNumber(text, &number) && number == target;
+}
+}  // namespace mindrecord
+}  // namespace mindspore
@@ -15,6 +15,8 @@
  */
 #include "minddata/mindrecord/include/shard_index_generator.h"
 
+#include <cstdio>
+#include "minddata/mindrecord/include/shard_binary_index.h"
 #include "utils/file_utils.h"
 #include "utils/ms_utils.h"
 
@@ -517,6 +519,17 @@ Status ShardIndexGenerator::ExecuteTransaction(const int &shard_no, sqlite3 *db,
       "-a): " +
       shard_address);
   }
+  std::vector<std::pair<std::string, std::string>> index_fields;
+  for (const auto &field : fields_) {
+    std::shared_ptr<Schema> schema_ptr;
+    RELEASE_AND_RETURN_IF_NOT_OK(shard_header_.GetSchemaByID(field.first, &schema_ptr), db, in);
+    std::shared_ptr<std::string> fn_ptr;
+    RELEASE_AND_RETURN_IF_NOT_OK(GenerateFieldName(field, &fn_ptr), db, in);
+    index_fields.emplace_back(*fn_ptr, ConvertJsonToSQL(TakeFieldType(field.second, schema_ptr->GetSchema()["schema"])));
+  }
+  ShardBinaryIndexWriter binary_index(index_fields);
+  // The binary index is optional, the failure of it only skips the binary index of this shard.
+  bool binary_index_ok = true;
   (void)sqlite3_exec(db, "BEGIN TRANSACTION;", nullptr, nullptr, nullptr);
   for (int raw_page_id : raw_page_ids) {
     std::shared_ptr<std::string> sql_ptr;
@@ -524,11 +537,37 @@ Status ShardIndexGenerator::ExecuteTransaction(const int &shard_no, sqlite3 *db,
     auto row_data_ptr = std::make_shared<ROW_DATA>();
     RELEASE_AND_RETURN_IF_NOT_OK(GenerateRowData(shard_no, blob_id_to_page_id, raw_page_id, in, &row_data_ptr), db, in);
     RELEASE_AND_RETURN_IF_NOT_OK(BindParameterExecuteSQL(db, *sql_ptr, *row_data_ptr), db, in);
+    if (binary_index_ok) {
+      auto rc = binary_index.AddRows(*row_data_ptr);
+      if (rc.IsError()) {
+        MS_LOG(WARNING) << "Failed to generate binary index for shard: " << shard_no << ", skip it. " << rc.ToString();
+        binary_index_ok = false;
+      }
+    }
     MS_LOG(INFO) << "Insert " << row_data_ptr->size() << " rows to index db.";
   }
   (void)sqlite3_exec(db, "END TRANSACTION;", nullptr, nullptr, nullptr);
+  in.clear();
+  (void)in.seekg(0, std::ios::end);
+  auto shard_size = static_cast<uint64_t>(in.tellg());
   in.close();
 
+  // The binary index is written beside the sqlite index, the reader falls back to sqlite if it is not usable.
+  if (binary_index_ok) {
+    auto binary_index_path = realpath.value() + kBinaryIndexSuffix;
+    std::shared_ptr<std::string> fn_ptr;
+    auto rc = GetFileName(shard_address, &fn_ptr);
+    if (rc.IsOk()) {
+      rc = binary_index.Write(binary_index_path, *fn_ptr, shard_size);
+    }
+    if (rc.IsOk()) {
+      MS_LOG(INFO) << "Write binary index for shard: " << shard_no << " successfully.";
+    } else {
+      MS_LOG(WARNING) << "Failed to write binary index for shard: " << shard_no << ", skip it. " << rc.ToString();
+      (void)std::remove(binary_index_path.c_str());
+    }
+  }
+
   // Close database
   sqlite3_close(db);
   db = nullptr;
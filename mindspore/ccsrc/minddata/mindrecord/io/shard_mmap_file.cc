@@ -0,0 +1,86 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/mindrecord/include/shard_mmap_file.h"
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace mindrecord {
+ShardMmapFile::~ShardMmapFile() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (addr_ != nullptr) {
+    if (munmap(addr_, size_) != 0) {
+      MS_LOG(WARNING) << "Failed to unmap the mindrecord file, errno: " << errno;
+    }
+    addr_ = nullptr;
+  }
+#endif
+}
+
+Status ShardMmapFile::Open(const std::string &file_path) {
+#if !defined(_WIN32) && !defined(_WIN64)
+  CHECK_FAIL_RETURN_UNEXPECTED(addr_ == nullptr, "[Internal ERROR] The mindrecord file is mapped already.");
+  int fd = open(file_path.c_str(), O_RDONLY);
+  CHECK_FAIL_RETURN_UNEXPECTED(fd >= 0, "Invalid file, failed to open mindrecord file for mapping: " + file_path);
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+    (void)close(fd);
+    RETURN_STATUS_UNEXPECTED("Invalid file, failed to get the size of mindrecord file: " + file_path);
+  }
+  auto size = static_cast<uint64_t>(file_stat.st_size);
+  void *addr = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  // The mapping is kept after the file descriptor is closed.
+  (void)close(fd);
+  CHECK_FAIL_RETURN_UNEXPECTED(addr != MAP_FAILED, "Failed to map mindrecord file: " + file_path);
+  // The blobs are accessed in the order of the sampler, the read ahead is advised explicitly by WillNeed.
+  (void)madvise(addr, size, MADV_RANDOM);
+  addr_ = addr;
+  size_ = size;
+  return Status::OK();
+#else
+  RETURN_STATUS_UNEXPECTED("Mapping mindrecord file is not supported on Windows.");
+#endif
+}
+
+const uint8_t *ShardMmapFile::Data(uint64_t offset, uint64_t length) const {
+  if (addr_ == nullptr || offset > size_ || length > size_ - offset) {
+    return nullptr;
+  }
+  return static_cast<const uint8_t *>(addr_) + offset;
+}
+
+void ShardMmapFile::WillNeed(uint64_t offset, uint64_t length) const {
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (addr_ == nullptr || offset >= size_ || length == 0) {
+    return;
+  }
+  if (length > size_ - offset) {
+    length = size_ - offset;
+  }
+  // madvise requires the address aligned with the page size.
+  static const uint64_t page_size = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+  uint64_t begin = offset / page_size * page_size;
+  (void)madvise(static_cast<uint8_t *>(addr_) + begin, offset + length - begin, MADV_WILLNEED);
+#endif
+}
+}  // namespace mindrecord
+}  // namespace mindspore
@@ -17,6 +17,7 @@
 #include "minddata/mindrecord/include/shard_reader.h"
 
 #include <algorithm>
+#include <numeric>
 #include <thread>
 
 #include "utils/file_utils.h"
@@ -90,9 +91,17 @@ Status ShardReader::Init(const std::vector<std::string> &file_paths, bool load_d
       *meta_data_ptr == *first_meta_data_ptr,
       "Invalid file, the metadata of mindrecord file: " + file +
         " is different from others, please make sure all the mindrecord files generated by the same script.");
+    // The binary index is preferred, the sqlite index is used if the binary index is absent or stale.
+    std::shared_ptr<ShardBinaryIndex> binary_index;
+    if (use_binary_index_ && OpenBinaryIndex(file, &binary_index).IsOk()) {
+      binary_indexes_.push_back(binary_index);
+      database_paths_.push_back(nullptr);
+      continue;
+    }
     sqlite3 *db = nullptr;
     RETURN_IF_NOT_OK(VerifyDataset(&db, file));
     database_paths_.push_back(db);
+    binary_indexes_.push_back(nullptr);
   }
   ShardHeader sh = ShardHeader();
   RETURN_IF_NOT_OK(sh.BuildDataset(file_paths_, load_dataset));
@@ -176,6 +185,34 @@ Status ShardReader::VerifyDataset(sqlite3 **db, const string &file) {
   return Status::OK();
 }
 
+Status ShardReader::OpenBinaryIndex(const std::string &file, std::shared_ptr<ShardBinaryIndex> *binary_index) {
+  RETURN_UNEXPECTED_IF_NULL(binary_index);
+  auto index_path = file + kBinaryIndexSuffix;
+  struct stat index_stat;
+  if (stat(index_path.c_str(), &index_stat) != 0) {
+    RETURN_STATUS_UNEXPECTED("The binary index file does not exist: " + index_path);
+  }
+  auto index = std::make_shared<ShardBinaryIndex>();
+  Status rc = index->Open(index_path);
+  std::shared_ptr<std::string> fn_ptr;
+  if (rc.IsOk()) {
+    rc = GetFileName(file, &fn_ptr);
+  }
+  struct stat file_stat;
+  if (rc.IsOk() && (index->ShardName() != *fn_ptr || stat(file.c_str(), &file_stat) != 0 ||
+                    static_cast<uint64_t>(file_stat.st_size) != index->ShardSize())) {
+    rc = Status(StatusCode::kMDUnexpectedError, "The binary index file does not match the mindrecord file.");
+  }
+  if (rc.IsError()) {
+    MS_LOG(WARNING) << "Failed to use the binary index file: " << index_path
+                    << ", the sqlite index file is used instead. " << rc.ToString();
+    return rc;
+  }
+  MS_LOG(DEBUG) << "Succeed to open binary index file, path: " << index_path;
+  *binary_index = index;
+  return Status::OK();
+}
+
 Status ShardReader::CheckColumnList(const std::vector<std::string> &selected_columns) {
   auto schema_ptr = GetShardHeader()->GetSchemas()[0];
   auto schema = schema_ptr->GetSchema()["schema"];
@@ -345,6 +382,8 @@ void ShardReader::FileStreamsOperator() {
       }
     }
   }
+  // The views handed out keep their mapped files alive until they are released.
+  mmap_files_.clear();
   for (int i = static_cast<int>(database_paths_.size()) - 1; i >= 0; --i) {
     if (database_paths_[i] != nullptr) {
       auto ret = sqlite3_close(database_paths_[i]);
@@ -354,6 +393,7 @@ void ShardReader::FileStreamsOperator() {
       database_paths_[i] = nullptr;
     }
   }
+  binary_indexes_.clear();
 }
 
 ShardReader::~ShardReader() { Close(); }
@@ -435,29 +475,8 @@ Status ShardReader::ConvertLabelToJson(const std::vector<std::vector<std::string
         int raw_page_id = std::stoi(labels[i][3]);
         uint64_t label_start = std::stoull(labels[i][4]) + kInt64Len;
         uint64_t label_end = std::stoull(labels[i][5]);
-        auto len = label_end - label_start;
-        auto label_raw = std::vector<uint8_t>(len);
-        auto &io_seekg = fs->seekg(page_size_ * raw_page_id + header_size_ + label_start, std::ios::beg);
-        if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
-          fs->close();
-          RETURN_STATUS_UNEXPECTED("[Internal ERROR] Failed to seekg file.");
-        }
-        auto &io_read = fs->read(reinterpret_cast<char *>(&label_raw[0]), len);
-        if (!io_read.good() || io_read.fail() || io_read.bad()) {
-          fs->close();
-          RETURN_STATUS_UNEXPECTED("[Internal ERROR] Failed to read file.");
-        }
-        json label_json = json::from_msgpack(label_raw);
         json tmp;
-        if (!columns.empty()) {
-          for (const auto &col : columns) {
-            if (label_json.find(col) != label_json.end()) {
-              tmp[col] = label_json[col];
-            }
-          }
-        } else {
-          tmp = label_json;
-        }
+        RETURN_IF_NOT_OK(ReadRawLabel(fs, raw_page_id, label_start, label_end, columns, &tmp));
         (*col_val_ptr)[shard_id].emplace_back(tmp);
       } else {
         json construct_json;
@@ -482,6 +501,34 @@ Status ShardReader::ConvertLabelToJson(const std::vector<std::vector<std::string
   return Status::OK();
 }
 
+Status ShardReader::ReadRawLabel(const std::shared_ptr<std::fstream> &fs, int raw_page_id, uint64_t label_start,
+                                 uint64_t label_end, const std::vector<std::string> &columns, json *label) {
+  RETURN_UNEXPECTED_IF_NULL(label);
+  auto len = label_end - label_start;
+  auto label_raw = std::vector<uint8_t>(len);
+  auto &io_seekg = fs->seekg(page_size_ * raw_page_id + header_size_ + label_start, std::ios::beg);
+  if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
+    fs->close();
+    RETURN_STATUS_UNEXPECTED("[Internal ERROR] Failed to seekg file.");
+  }
+  auto &io_read = fs->read(reinterpret_cast<char *>(&label_raw[0]), len);
+  if (!io_read.good() || io_read.fail() || io_read.bad()) {
+    fs->close();
+    RETURN_STATUS_UNEXPECTED("[Internal ERROR] Failed to read file.");
+  }
+  json label_json = json::from_msgpack(label_raw);
+  if (!columns.empty()) {
+    for (const auto &col : columns) {
+      if (label_json.find(col) != label_json.end()) {
+        (*label)[col] = label_json[col];
+      }
+    }
+  } else {
+    *label = label_json;
+  }
+  return Status::OK();
+}
+
 Status ShardReader::ConvertJsonValue(const std::vector<std::string> &label, const std::vector<std::string> &columns,
                                      const json &schema, json *value) {
   for (unsigned int j = 0; j < columns.size(); ++j) {
@@ -557,6 +604,10 @@ Status ShardReader::GetAllClasses(const std::string &category_field,
   std::string sql = "SELECT DISTINCT " + *fn_ptr + " FROM INDEXES";
   std::vector<std::thread> threads = std::vector<std::thread>(shard_count_);
   for (int x = 0; x < shard_count_; x++) {
+    if (binary_indexes_[x] != nullptr) {
+      threads[x] = std::thread(&ShardReader::GetClassesInBinaryIndex, this, x, *fn_ptr, category_ptr);
+      continue;
+    }
     threads[x] = std::thread(&ShardReader::GetClassesInShard, this, database_paths_[x], x, sql, category_ptr);
   }
 
@@ -566,6 +617,22 @@ Status ShardReader::GetAllClasses(const std::string &category_field,
   return Status::OK();
 }
 
+void ShardReader::GetClassesInBinaryIndex(int shard_id, const std::string &field_name,
+                                          std::shared_ptr<std::set<std::string>> category_ptr) {
+  const auto &binary_index = binary_indexes_[shard_id];
+  auto field_id = binary_index->FieldId(field_name);
+  if (field_id < 0) {
+    MS_LOG(ERROR) << "[Internal ERROR] Failed to find the field " << field_name << " in the binary index of shard "
+                  << shard_id << ".";
+    return;
+  }
+  auto values = binary_index->DistinctValues(field_id);
+  MS_LOG(INFO) << "Succeed to get " << values.size() << " records from shard " << std::to_string(shard_id)
+               << " index.";
+  std::lock_guard<std::mutex> lck(shard_locker_);
+  category_ptr->insert(values.begin(), values.end());
+}
+
 void ShardReader::GetClassesInShard(sqlite3 *db, int shard_id, const std::string &sql,
                                     std::shared_ptr<std::set<std::string>> category_ptr) {
   if (db == nullptr) {
@@ -615,6 +682,11 @@ Status ShardReader::ReadAllRowGroup(const std::vector<std::string> &columns,
 
   std::vector<std::thread> thread_read_db = std::vector<std::thread>(shard_count_);
   for (int x = 0; x < shard_count_; x++) {
+    if (binary_indexes_[x] != nullptr) {
+      thread_read_db[x] =
+        std::thread(&ShardReader::ReadRowsInBinaryIndex, this, x, -1, columns, offset_ptr, col_val_ptr);
+      continue;
+    }
     thread_read_db[x] = std::thread(&ShardReader::ReadAllRowsInShard, this, x, sql, columns, offset_ptr, col_val_ptr);
   }
 
@@ -625,6 +697,73 @@ Status ShardReader::ReadAllRowGroup(const std::vector<std::string> &columns,
   return Status::OK();
 }
 
+Status ShardReader::GetBinaryIndexFieldId(int shard_id, const std::string &column, int *field_id) {
+  RETURN_UNEXPECTED_IF_NULL(field_id);
+  auto iter = column_schema_id_.find(column);
+  uint64_t schema_id = iter == column_schema_id_.end() ? 0 : iter->second;
+  std::shared_ptr<std::string> fn_ptr;
+  RETURN_IF_NOT_OK(ShardIndexGenerator::GenerateFieldName(std::make_pair(schema_id, column), &fn_ptr));
+  *field_id = binary_indexes_[shard_id]->FieldId(*fn_ptr);
+  CHECK_FAIL_RETURN_UNEXPECTED(*field_id >= 0, "Invalid data, field: " + column +
+                                                 " can not found in the index of mindrecord file: " +
+                                                 file_paths_[shard_id]);
+  return Status::OK();
+}
+
+Status ShardReader::ReadRowsInBinaryIndex(int shard_id, int64_t row_id, const std::vector<std::string> &columns,
+                                          std::shared_ptr<std::vector<std::vector<std::vector<uint64_t>>>> offset_ptr,
+                                          std::shared_ptr<std::vector<std::vector<json>>> col_val_ptr) {
+  const auto &binary_index = binary_indexes_[shard_id];
+  uint64_t begin = 0;
+  uint64_t end = binary_index->NumRows();
+  if (row_id >= 0) {
+    begin = binary_index->FindRow(static_cast<uint64_t>(row_id));
+    end = std::min(begin + 1, end);
+  }
+  std::vector<int> field_ids(columns.size(), -1);
+  std::shared_ptr<std::fstream> fs = std::make_shared<std::fstream>();
+  if (all_in_index_) {
+    for (size_t i = 0; i < columns.size(); ++i) {
+      RETURN_IF_NOT_OK(GetBinaryIndexFieldId(shard_id, columns[i], &field_ids[i]));
+    }
+  } else {
+    std::string file_name = file_paths_[shard_id];
+    auto realpath = FileUtils::GetRealPath(file_name.c_str());
+    CHECK_FAIL_RETURN_UNEXPECTED(
+      realpath.has_value(),
+      "Invalid file, failed to get the realpath of mindrecord files. Please check file: " + file_name);
+    fs->open(realpath.value(), std::ios::in | std::ios::binary);
+    CHECK_FAIL_RETURN_UNEXPECTED(fs->good(),
+                                 "Invalid file, failed to open files for reading mindrecord files. Please check file "
+                                 "path, permission and open files limit(ulimit -a): " +
+                                   file_name);
+  }
+  auto schema = shard_header_->GetSchemas()[0]->GetSchema()["schema"];
+  // The first three labels are skipped by ConvertJsonValue, they are the offsets in the sqlite result.
+  std::vector<std::string> label(columns.size() + 3);
+  for (auto row = begin; row < end; ++row) {
+    (*offset_ptr)[shard_id].emplace_back(std::vector<uint64_t>{
+      static_cast<uint64_t>(shard_id), binary_index->Get(kIndexRowGroupId, row),
+      binary_index->Get(kIndexPageOffsetBlob, row) + kInt64Len, binary_index->Get(kIndexPageOffsetBlobEnd, row)});
+    json value;
+    if (all_in_index_) {
+      for (size_t i = 0; i < columns.size(); ++i) {
+        label[i + 3] = binary_index->FieldValue(field_ids[i], row);
+      }
+      RETURN_IF_NOT_OK(ConvertJsonValue(label, columns, schema, &value));
+    } else {
+      RETURN_IF_NOT_OK(ReadRawLabel(fs, static_cast<int>(binary_index->Get(kIndexPageIdRaw, row)),
+                                    binary_index->Get(kIndexPageOffsetRaw, row) + kInt64Len,
+                                    binary_index->Get(kIndexPageOffsetRawEnd, row), columns, &value));
+    }
+    (*col_val_ptr)[shard_id].emplace_back(std::move(value));
+  }
+  fs->close();
+  MS_LOG(INFO) << "Succeed to get " << end - begin << " records from shard " << std::to_string(shard_id)
+               << " binary index.";
+  return Status::OK();
+}
+
 Status ShardReader::ReadRowGroupByShardIDAndSampleID(const std::vector<std::string> &columns, const uint32_t &shard_id,
                                                      const uint32_t &sample_id,
                                                      std::shared_ptr<ROW_GROUPS> *row_group_ptr) {
@@ -633,6 +772,11 @@ Status ShardReader::ReadRowGroupByShardIDAndSampleID(const std::vector<std::stri
   auto offset_ptr = std::make_shared<std::vector<std::vector<std::vector<uint64_t>>>>(
     shard_count_, std::vector<std::vector<uint64_t>>{});
   auto col_val_ptr = std::make_shared<std::vector<std::vector<json>>>(shard_count_, std::vector<json>{});
+  if (binary_indexes_[shard_id] != nullptr) {
+    RETURN_IF_NOT_OK(ReadRowsInBinaryIndex(shard_id, sample_id, columns, offset_ptr, col_val_ptr));
+    *row_group_ptr = std::make_shared<ROW_GROUPS>(std::move(*offset_ptr), std::move(*col_val_ptr));
+    return Status::OK();
+  }
   if (all_in_index_) {
     for (unsigned int i = 0; i < columns.size(); ++i) {
       fields += ',';
@@ -703,6 +847,18 @@ int ShardReader::SelectCallback(void *p_data, int num_fields, char **p_fields, c
 
 std::vector<std::vector<uint64_t>> ShardReader::GetImageOffset(int page_id, int shard_id,
                                                                const std::pair<std::string, std::string> &criteria) {
+  if (binary_indexes_[shard_id] != nullptr) {
+    std::vector<uint64_t> rows;
+    if (FindRowsInBinaryIndex(page_id, shard_id, criteria, &rows).IsError()) {
+      return std::vector<std::vector<uint64_t>>();
+    }
+    std::vector<std::vector<uint64_t>> res;
+    for (auto row : rows) {
+      res.emplace_back(std::vector<uint64_t>{binary_indexes_[shard_id]->Get(kIndexPageOffsetBlob, row) + kInt64Len,
+                                             binary_indexes_[shard_id]->Get(kIndexPageOffsetBlobEnd, row)});
+    }
+    return res;
+  }
   auto db = database_paths_[shard_id];
 
   std::string sql =
@@ -749,6 +905,26 @@ std::vector<std::vector<uint64_t>> ShardReader::GetImageOffset(int page_id, int
 Status ShardReader::GetPagesByCategory(int shard_id, const std::pair<std::string, std::string> &criteria,
                                        std::shared_ptr<std::vector<uint64_t>> *pages_ptr) {
   RETURN_UNEXPECTED_IF_NULL(pages_ptr);
+  if (binary_indexes_[shard_id] != nullptr) {
+    const auto &binary_index = binary_indexes_[shard_id];
+    std::vector<uint64_t> rows;
+    if (criteria.first.empty()) {
+      rows.resize(binary_index->NumRows());
+      std::iota(rows.begin(), rows.end(), 0);
+    } else {
+      int field_id = -1;
+      RETURN_IF_NOT_OK(GetBinaryIndexFieldId(shard_id, criteria.first, &field_id));
+      rows = binary_index->RowsWithValue(field_id, criteria.second);
+    }
+    std::set<uint64_t> found_pages;
+    for (auto row : rows) {
+      auto page_id = binary_index->Get(kIndexPageIdBlob, row);
+      if (found_pages.insert(page_id).second) {
+        (*pages_ptr)->emplace_back(page_id);
+      }
+    }
+    return Status::OK();
+  }
   auto db = database_paths_[shard_id];
 
   std::string sql = "SELECT DISTINCT PAGE_ID_BLOB FROM INDEXES WHERE 1 = 1 ";
@@ -897,6 +1073,18 @@ Status ShardReader::GetLabelsFromPage(int page_id, int shard_id, const std::vect
                                       const std::pair<std::string, std::string> &criteria,
                                       std::shared_ptr<std::vector<json>> *labels_ptr) {
   RETURN_UNEXPECTED_IF_NULL(labels_ptr);
+  if (binary_indexes_[shard_id] != nullptr) {
+    std::vector<uint64_t> rows;
+    RETURN_IF_NOT_OK(FindRowsInBinaryIndex(page_id, shard_id, criteria, &rows));
+    std::vector<std::vector<std::string>> label_offsets;
+    for (auto row : rows) {
+      label_offsets.emplace_back(
+        std::vector<std::string>{std::to_string(binary_indexes_[shard_id]->Get(kIndexPageIdRaw, row)),
+                                 std::to_string(binary_indexes_[shard_id]->Get(kIndexPageOffsetRaw, row)),
+                                 std::to_string(binary_indexes_[shard_id]->Get(kIndexPageOffsetRawEnd, row))});
+    }
+    return GetLabelsFromBinaryFile(shard_id, columns, label_offsets, labels_ptr);
+  }
   // get page info from sqlite
   auto db = database_paths_[shard_id];
   std::string sql = "SELECT PAGE_ID_RAW, PAGE_OFFSET_RAW,PAGE_OFFSET_RAW_END FROM INDEXES WHERE PAGE_ID_BLOB = " +
@@ -925,10 +1113,47 @@ Status ShardReader::GetLabelsFromPage(int page_id, int shard_id, const std::vect
   return GetLabelsFromBinaryFile(shard_id, columns, *label_offset_ptr, labels_ptr);
 }
 
+Status ShardReader::FindRowsInBinaryIndex(int page_id, int shard_id, const std::pair<std::string, std::string> &criteria,
+                                          std::vector<uint64_t> *rows) {
+  RETURN_UNEXPECTED_IF_NULL(rows);
+  const auto &binary_index = binary_indexes_[shard_id];
+  *rows = binary_index->RowsInBlobPage(page_id);
+  if (criteria.first.empty()) {
+    return Status::OK();
+  }
+  int field_id = -1;
+  RETURN_IF_NOT_OK(GetBinaryIndexFieldId(shard_id, criteria.first, &field_id));
+  (void)rows->erase(std::remove_if(rows->begin(), rows->end(),
+                                   [&binary_index, field_id, &criteria](uint64_t row) {
+                                     return !binary_index->RowHasValue(field_id, row, criteria.second);
+                                   }),
+                    rows->end());
+  return Status::OK();
+}
+
 Status ShardReader::GetLabels(int page_id, int shard_id, const std::vector<std::string> &columns,
                               const std::pair<std::string, std::string> &criteria,
                               std::shared_ptr<std::vector<json>> *labels_ptr) {
   RETURN_UNEXPECTED_IF_NULL(labels_ptr);
+  if (all_in_index_ && binary_indexes_[shard_id] != nullptr) {
+    std::vector<uint64_t> rows;
+    RETURN_IF_NOT_OK(FindRowsInBinaryIndex(page_id, shard_id, criteria, &rows));
+    std::vector<int> field_ids(columns.size(), -1);
+    for (size_t i = 0; i < columns.size(); ++i) {
+      RETURN_IF_NOT_OK(GetBinaryIndexFieldId(shard_id, columns[i], &field_ids[i]));
+    }
+    auto schema = shard_header_->GetSchemas()[0]->GetSchema()["schema"];
+    std::vector<std::string> label(columns.size() + 3);
+    for (auto row : rows) {
+      for (size_t i = 0; i < columns.size(); ++i) {
+        label[i + 3] = binary_indexes_[shard_id]->FieldValue(field_ids[i], row);
+      }
+      json construct_json;
+      RETURN_IF_NOT_OK(ConvertJsonValue(label, columns, schema, &construct_json));
+      (*labels_ptr)->emplace_back(std::move(construct_json));
+    }
+    return Status::OK();
+  }
   if (all_in_index_) {
     auto db = database_paths_[shard_id];
     std::string fields;
@@ -1017,6 +1242,10 @@ int64_t ShardReader::GetNumClasses(const std::string &category_field) {
   auto category_ptr = std::make_shared<std::set<std::string>>();
   sqlite3 *db = nullptr;
   for (int x = 0; x < shard_count; x++) {
+    if (x < binary_indexes_.size() && binary_indexes_[x] != nullptr) {
+      threads[x] = std::thread(&ShardReader::GetClassesInBinaryIndex, this, x, *fn_ptr, category_ptr);
+      continue;
+    }
     std::string path_utf8 = "";
 #if defined(_WIN32) || defined(_WIN64)
     path_utf8 = FileUtils::GB2312ToUTF_8((file_paths_[x] + ".db").data());
@@ -1104,8 +1333,9 @@ Status ShardReader::CountTotalRows(const std::vector<std::string> &file_paths, b
 Status ShardReader::Open(const std::vector<std::string> &file_paths, bool load_dataset, int n_consumer,
                          const std::vector<std::string> &selected_columns,
                          const std::vector<std::shared_ptr<ShardOperator>> &operators, int64_t num_padded,
-                         bool lazy_load) {
+                         bool lazy_load, bool use_mmap) {
   lazy_load_ = lazy_load;
+  use_mmap_ = use_mmap;
 
   // Open file and set header by ShardReader
   RETURN_IF_NOT_OK(Init(file_paths, load_dataset));
@@ -1127,9 +1357,25 @@ Status ShardReader::Open(const std::vector<std::string> &file_paths, bool load_d
 
   operators_ = operators;
   RETURN_IF_NOT_OK(Open(n_consumer));
+  if (use_mmap_) {
+    MapShardFiles();
+  }
   return Status::OK();
 }
 
+void ShardReader::MapShardFiles() {
+  mmap_files_.clear();
+  for (const auto &file : file_paths_) {
+    auto realpath = FileUtils::GetRealPath(file.c_str());
+    auto mmap_file = std::make_shared<ShardMmapFile>();
+    if (!realpath.has_value() || mmap_file->Open(realpath.value()).IsError()) {
+      MS_LOG(WARNING) << "Failed to map mindrecord file: " << file << ", it will be read by file stream.";
+      mmap_file = nullptr;
+    }
+    mmap_files_.push_back(mmap_file);
+  }
+}
+
 Status ShardReader::Launch(bool is_sample_read) {
   // Get all row groups' info
   auto row_group_summary = ReadRowGroupSummary();
@@ -1355,71 +1601,106 @@ Status ShardReader::CreateTasks(const std::vector<std::tuple<int, int, int, uint
   return Status::OK();
 }
 
-Status ShardReader::ConsumerOneTask(int64_t task_id, uint32_t consumer_id,
-                                    std::shared_ptr<TASK_CONTENT> *task_content_ptr) {
-  RETURN_UNEXPECTED_IF_NULL(task_content_ptr);
+Status ShardReader::GetTaskBlobLocation(int64_t task_id, TaskType *task_type, uint32_t *shard_id,
+                                        uint64_t *file_offset, uint64_t *blob_size, json *var_fields) {
+  RETURN_UNEXPECTED_IF_NULL(task_type);
+  RETURN_UNEXPECTED_IF_NULL(shard_id);
+  RETURN_UNEXPECTED_IF_NULL(file_offset);
+  RETURN_UNEXPECTED_IF_NULL(blob_size);
   // All tasks are done
   CHECK_FAIL_RETURN_UNEXPECTED(task_id < tasks_.Size(), "[Internal ERROR] 'task_id': " + std::to_string(task_id) +
                                                           " is out of bound: " + std::to_string(tasks_.Size()));
-  uint32_t shard_id = 0;
   uint32_t group_id = 0;
   uint32_t blob_start = 0;
   uint32_t blob_end = 0;
-  json var_fields;
   // Pick up task from task list
-  ShardTask task = tasks_.GetTaskByID(task_id);
+  const ShardTask &task = tasks_.GetTaskByID(task_id);
 
   // check task type
-  auto task_type = std::get<0>(task);
-  if (task_type == TaskType::kPaddedTask) {
-    *task_content_ptr =
-      std::make_shared<TASK_CONTENT>(TaskType::kPaddedTask, std::vector<std::tuple<std::vector<uint8_t>, json>>());
+  *task_type = std::get<0>(task);
+  if (*task_type == TaskType::kPaddedTask) {
     return Status::OK();
   }
 
-  shard_id = std::get<0>(std::get<1>(task));  // shard id
+  *shard_id = std::get<0>(std::get<1>(task));  // shard id
 
   if (lazy_load_ == false) {
     group_id = std::get<1>(std::get<1>(task));  // group id
     blob_start = std::get<2>(task)[0];          // blob start
     blob_end = std::get<2>(task)[1];            // blob end
-    var_fields = std::get<3>(task);             // scalar variable field
+    if (var_fields != nullptr) {
+      *var_fields = std::get<3>(task);  // scalar variable field
+    }
   } else {
     // get scalar variable fields by sample id
     uint32_t sample_id_in_shard = std::get<1>(std::get<1>(task));
 
     // read the meta from index
     std::shared_ptr<ROW_GROUPS> row_group_ptr;
-    RETURN_IF_NOT_OK(ReadRowGroupByShardIDAndSampleID(selected_columns_, shard_id, sample_id_in_shard, &row_group_ptr));
+    RETURN_IF_NOT_OK(
+      ReadRowGroupByShardIDAndSampleID(selected_columns_, *shard_id, sample_id_in_shard, &row_group_ptr));
     auto &offsets = std::get<0>(*row_group_ptr);
     auto &local_columns = std::get<1>(*row_group_ptr);
 
-    group_id = offsets[shard_id][0][1];       // group_id
-    blob_start = offsets[shard_id][0][2];     // blob start
-    blob_end = offsets[shard_id][0][3];       // blob end
-    var_fields = local_columns[shard_id][0];  // scalar variable field
+    group_id = offsets[*shard_id][0][1];    // group_id
+    blob_start = offsets[*shard_id][0][2];  // blob start
+    blob_end = offsets[*shard_id][0][3];    // blob end
+    if (var_fields != nullptr) {
+      *var_fields = local_columns[*shard_id][0];  // scalar variable field
+    }
   }
 
-  // read the blob from data file
+  // locate the blob in data file
   std::shared_ptr<Page> page_ptr;
-  RETURN_IF_NOT_OK(shard_header_->GetPageByGroupId(group_id, shard_id, &page_ptr));
+  RETURN_IF_NOT_OK(shard_header_->GetPageByGroupId(group_id, *shard_id, &page_ptr));
   MS_LOG(DEBUG) << "[Internal ERROR] Success to get page by group id: " << group_id;
 
-  // Pack image list
-  std::vector<uint8_t> images(blob_end - blob_start);
-  auto file_offset = header_size_ + page_size_ * (page_ptr->GetPageID()) + blob_start;
+  *file_offset = header_size_ + page_size_ * (page_ptr->GetPageID()) + blob_start;
+  *blob_size = blob_end - blob_start;
+  return Status::OK();
+}
 
+Status ShardReader::ReadBlobFromStream(uint32_t consumer_id, uint32_t shard_id, uint64_t file_offset,
+                                       uint64_t blob_size, uint8_t *dst) {
   auto &io_seekg = file_streams_random_[consumer_id][shard_id]->seekg(file_offset, std::ios::beg);
   if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
     file_streams_random_[consumer_id][shard_id]->close();
     RETURN_STATUS_UNEXPECTED("[Internal ERROR] Failed to seekg file.");
   }
-  auto &io_read =
-    file_streams_random_[consumer_id][shard_id]->read(reinterpret_cast<char *>(&images[0]), blob_end - blob_start);
+  auto &io_read = file_streams_random_[consumer_id][shard_id]->read(reinterpret_cast<char *>(dst), blob_size);
   if (!io_read.good() || io_read.fail() || io_read.bad()) {
     file_streams_random_[consumer_id][shard_id]->close();
     RETURN_STATUS_UNEXPECTED("[Internal ERROR] Failed to read file.");
   }
+  return Status::OK();
+}
+
+Status ShardReader::ConsumerOneTask(int64_t task_id, uint32_t consumer_id,
+                                    std::shared_ptr<TASK_CONTENT> *task_content_ptr) {
+  RETURN_UNEXPECTED_IF_NULL(task_content_ptr);
+  TaskType task_type = TaskType::kCommonTask;
+  uint32_t shard_id = 0;
+  uint64_t file_offset = 0;
+  uint64_t blob_size = 0;
+  json var_fields;
+  RETURN_IF_NOT_OK(GetTaskBlobLocation(task_id, &task_type, &shard_id, &file_offset, &blob_size, &var_fields));
+  if (task_type == TaskType::kPaddedTask) {
+    *task_content_ptr =
+      std::make_shared<TASK_CONTENT>(TaskType::kPaddedTask, std::vector<std::tuple<std::vector<uint8_t>, json>>());
+    return Status::OK();
+  }
+
+  // Pack image list
+  std::vector<uint8_t> images(blob_size);
+  const uint8_t *mapped_blob = nullptr;
+  if (shard_id < mmap_files_.size() && mmap_files_[shard_id] != nullptr) {
+    mapped_blob = mmap_files_[shard_id]->Data(file_offset, blob_size);
+  }
+  if (mapped_blob != nullptr) {
+    std::copy(mapped_blob, mapped_blob + blob_size, images.begin());
+  } else {
+    RETURN_IF_NOT_OK(ReadBlobFromStream(consumer_id, shard_id, file_offset, blob_size, images.data()));
+  }
 
   // Deliver batch data to output map
   std::vector<std::tuple<std::vector<uint8_t>, json>> batch;
@@ -1429,6 +1710,62 @@ Status ShardReader::ConsumerOneTask(int64_t task_id, uint32_t consumer_id,
   return Status::OK();
 }
 
+Status ShardReader::GetBlobViewById(int64_t task_id, int32_t consumer_id, TaskType *task_type, ShardBlobView *blob,
+                                    json *var_fields) {
+  RETURN_UNEXPECTED_IF_NULL(task_type);
+  RETURN_UNEXPECTED_IF_NULL(blob);
+  if (interrupt_) {
+    return Status(StatusCode::kMDInterrupted);
+  }
+  uint32_t shard_id = 0;
+  uint64_t file_offset = 0;
+  uint64_t blob_size = 0;
+  RETURN_IF_NOT_OK(GetTaskBlobLocation(task_id, task_type, &shard_id, &file_offset, &blob_size, var_fields));
+  if (*task_type == TaskType::kPaddedTask) {
+    return Status::OK();
+  }
+  ReadAheadTasks();
+
+  if (shard_id < mmap_files_.size() && mmap_files_[shard_id] != nullptr) {
+    blob->data = mmap_files_[shard_id]->Data(file_offset, blob_size);
+    CHECK_FAIL_RETURN_UNEXPECTED(blob->data != nullptr, "Invalid data, the blob is out of the mindrecord file: " +
+                                                          file_paths_[shard_id]);
+    blob->size = blob_size;
+    blob->file = mmap_files_[shard_id];
+    return Status::OK();
+  }
+  blob->buffer.resize(blob_size);
+  RETURN_IF_NOT_OK(ReadBlobFromStream(consumer_id, shard_id, file_offset, blob_size, blob->buffer.data()));
+  blob->data = blob->buffer.data();
+  blob->size = blob_size;
+  blob->file = nullptr;
+  return Status::OK();
+}
+
+void ShardReader::ReadAheadTasks() {
+  // The workers fetch the tasks in the order of the sample ids, so the number of fetched tasks approximates the
+  // position in the sample ids. The blobs of the next batch of tasks are advised once every kNumReadAheadTasks.
+  auto position = read_ahead_position_++;
+  if (mmap_files_.empty() || lazy_load_ || position % kNumReadAheadTasks != 0) {
+    return;
+  }
+  const auto &sample_ids = tasks_.sample_ids_;
+  auto end = std::min(static_cast<int64_t>(sample_ids.size()), position + kNumReadAheadTasks * 2);
+  for (auto i = position + kNumReadAheadTasks; i < end; ++i) {
+    TaskType task_type = TaskType::kCommonTask;
+    uint32_t shard_id = 0;
+    uint64_t file_offset = 0;
+    uint64_t blob_size = 0;
+    if (GetTaskBlobLocation(sample_ids[i], &task_type, &shard_id, &file_offset, &blob_size, nullptr).IsError() ||
+        task_type == TaskType::kPaddedTask) {
+      continue;
+    }
+    if (shard_id < mmap_files_.size() && mmap_files_[shard_id] != nullptr) {
+      mmap_files_[shard_id]->WillNeed(file_offset, blob_size);
+    }
+  }
+}
+
 void ShardReader::ConsumerByRow(int consumer_id) {
   // Set thread name
 #if !defined(_WIN32) && !defined(_WIN64) && !defined(__APPLE__)
@@ -1540,6 +1877,7 @@ void ShardReader::Reset() {
 }
 
 void ShardReader::ShuffleTask() {
+  read_ahead_position_ = 0;
   // exist shuffle and distributed sampler in ops, skip shuffle
   bool has_sharding = false;
   for (const auto &op : operators_) {
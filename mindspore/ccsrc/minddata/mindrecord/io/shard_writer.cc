@@ -16,6 +16,7 @@
 
 #include "minddata/dataset/util/random.h"
 #include "minddata/mindrecord/include/shard_writer.h"
+#include "minddata/mindrecord/include/shard_binary_index.h"
 #include "utils/file_utils.h"
 #include "utils/ms_utils.h"
 #include "minddata/mindrecord/include/common/shard_utils.h"
@@ -110,6 +111,8 @@ Status ShardWriter::OpenDataFiles(bool append, bool overwrite) {
           if (res2 == 0) {
             MS_LOG(WARNING) << "Succeed to remove the old mindrecord metadata files, path: " << file + ".db";
           }
+          // The binary index is regenerated with the sqlite index, a stale one is detected by the reader anyway.
+          (void)std::remove((whole_path.value() + kBinaryIndexSuffix).c_str());
         } else {
           RETURN_STATUS_UNEXPECTED(
             "Invalid file, mindrecord files already exist. Please check file path: " + file +
@@ -0,0 +1,363 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "plugin/device/cpu/hal/device/cpu_compile_cache.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include "nlohmann/json.hpp"
+#include "backend/common/session/anf_runtime_algorithm.h"
+#include "include/common/utils/anfalgo.h"
+#include "plugin/device/cpu/kernel/parallel_search_cache.h"
+#include "utils/file_utils.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+constexpr char kCompileCacheFile[] = "cpu_backend_compile_cache.json";
+// The version of the graph key, change it when the selection or the memory plan changes the results of a graph.
+constexpr char kGraphKeyVersion[] = "cpu_backend_v1";
+constexpr char kGraphs[] = "graphs";
+constexpr char kKernels[] = "kernels";
+constexpr char kMemPlans[] = "mem_plans";
+constexpr char kOpName[] = "op";
+constexpr char kCached[] = "cached";
+constexpr char kInputFormats[] = "input_formats";
+constexpr char kInputTypes[] = "input_types";
+constexpr char kOutputFormats[] = "output_formats";
+constexpr char kOutputTypes[] = "output_types";
+constexpr char kMemSize[] = "mem_size";
+constexpr char kOffsets[] = "offsets";
+// The attributes which don't change the selection, the instance name is numbered by the order of creating.
+constexpr char kAttrInstanceName[] = "instance_name";
+
+// The 64 bits FNV-1a hash, it is the same in all the processes.
+std::string HashString(const std::string &data) {
+  constexpr uint64_t kFnvOffsetBasis = 14695981039346656037ULL;
+  constexpr uint64_t kFnvPrime = 1099511628211ULL;
+  uint64_t hash = kFnvOffsetBasis;
+  for (auto c : data) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= kFnvPrime;
+  }
+  std::ostringstream oss;
+  oss << std::hex << std::setw(sizeof(uint64_t) * 2) << std::setfill('0') << hash;
+  return oss.str();
+}
+
+void AppendTypeAndShape(const AnfNodePtr &node, size_t output_index, std::ostringstream *signature) {
+  MS_EXCEPTION_IF_NULL(node);
+  MS_EXCEPTION_IF_NULL(signature);
+  if (node->abstract() == nullptr) {
+    *signature << "none";
+    return;
+  }
+  *signature << TypeIdLabel(common::AnfAlgo::GetOutputInferDataType(node, output_index)) << "[";
+  for (auto dim : common::AnfAlgo::GetOutputInferShape(node, output_index)) {
+    *signature << dim << " ";
+  }
+  *signature << "]";
+}
+}  // namespace
+
+CPUCompileCache &CPUCompileCache::GetInstance() {
+  static CPUCompileCache instance(kernel::GetCPUCompileCacheDir());
+  return instance;
+}
+
+CPUCompileCache::CPUCompileCache(const std::string &cache_dir) : cache_dir_(cache_dir) {
+  if (cache_dir_.empty()) {
+    return;
+  }
+  cache_file_ = cache_dir_ + "/" + kCompileCacheFile;
+  Load();
+}
+
+std::string CPUCompileCache::GraphKey(const session::KernelGraph &graph) {
+  std::ostringstream signature;
+  signature << kGraphKeyVersion << ";dynamic:" << graph.is_dynamic_shape();
+  std::map<const AnfNode *, size_t> parameter_indexes;
+  const auto &parameters = graph.inputs();
+  for (size_t i = 0; i < parameters.size(); ++i) {
+    parameter_indexes[parameters[i].get()] = i;
+  }
+  std::map<const AnfNode *, size_t> kernel_indexes;
+  const auto &kernels = graph.execution_order();
+  for (size_t i = 0; i < kernels.size(); ++i) {
+    const auto &kernel = kernels[i];
+    MS_EXCEPTION_IF_NULL(kernel);
+    signature << "|" << common::AnfAlgo::GetCNodeName(kernel) << "(";
+    size_t input_num = common::AnfAlgo::GetInputTensorNum(kernel);
+    for (size_t j = 0; j < input_num; ++j) {
+      auto input = common::AnfAlgo::GetPrevNodeOutput(kernel, j, false);
+      MS_EXCEPTION_IF_NULL(input.first);
+      auto kernel_iter = kernel_indexes.find(input.first.get());
+      auto parameter_iter = parameter_indexes.find(input.first.get());
+      if (kernel_iter != kernel_indexes.end()) {
+        signature << "k" << kernel_iter->second << "." << input.second;
+      } else if (parameter_iter != parameter_indexes.end()) {
+        signature << "p" << parameter_iter->second;
+      } else {
+        signature << "v";
+      }
+      signature << ":";
+      AppendTypeAndShape(input.first, input.second, &signature);
+      signature << ",";
+    }
+    signature << ")->(";
+    size_t output_num = common::AnfAlgo::GetOutputTensorNum(kernel);
+    for (size_t j = 0; j < output_num; ++j) {
+      AppendTypeAndShape(kernel, j, &signature);
+      signature << ",";
+    }
+    signature << ")";
+    auto prim = common::AnfAlgo::GetCNodePrimitive(kernel);
+    if (prim != nullptr) {
+      std::map<std::string, ValuePtr> attrs(prim->attrs().begin(), prim->attrs().end());
+      for (const auto &attr : attrs) {
+        if (attr.first == kAttrInstanceName) {
+          continue;
+        }
+        signature << attr.first << "=" << (attr.second == nullptr ? "null" : attr.second->ToString()) << ";";
+      }
+    }
+    kernel_indexes[kernel.get()] = i;
+  }
+  return HashString(signature.str());
+}
+
+std::string CPUCompileCache::GetGraphKey(const session::KernelGraph &graph) {
+  auto key = graph.get_attr(kAttrCPUCompileCacheKey);
+  if (key == nullptr || !key->isa<StringImm>()) {
+    return "";
+  }
+  return GetValue<std::string>(key);
+}
+
+void CPUCompileCache::Load() {
+  std::ifstream ifs(cache_file_);
+  if (!ifs.is_open()) {
+    MS_LOG(INFO) << "No cpu backend compile cache in " << cache_file_;
+    return;
+  }
+  try {
+    auto js = nlohmann::json::parse(ifs);
+    for (auto &graph_item : js.at(kGraphs).items()) {
+      GraphCache graph_cache;
+      for (auto &kernel_js : graph_item.value().at(kKernels)) {
+        KernelCache kernel_cache;
+        kernel_cache.op_name = kernel_js.at(kOpName).get<std::string>();
+        kernel_cache.cached = kernel_js.at(kCached).get<bool>();
+        if (kernel_cache.cached) {
+          kernel_cache.input_formats = kernel_js.at(kInputFormats).get<std::vector<std::string>>();
+          kernel_cache.input_types = kernel_js.at(kInputTypes).get<std::vector<TypeId>>();
+          kernel_cache.output_formats = kernel_js.at(kOutputFormats).get<std::vector<std::string>>();
+          kernel_cache.output_types = kernel_js.at(kOutputTypes).get<std::vector<TypeId>>();
+        }
+        (void)graph_cache.kernels.emplace_back(std::move(kernel_cache));
+      }
+      for (auto &plan_item : graph_item.value().at(kMemPlans).items()) {
+        MemPlanCache plan_cache;
+        plan_cache.mem_size = plan_item.value().at(kMemSize).get<size_t>();
+        plan_cache.offsets = plan_item.value().at(kOffsets).get<std::vector<size_t>>();
+        graph_cache.mem_plans[plan_item.key()] = std::move(plan_cache);
+      }
+      graphs_[graph_item.key()] = std::move(graph_cache);
+    }
+  } catch (const std::exception &e) {
+    MS_LOG(WARNING) << "Failed to load the cpu backend compile cache " << cache_file_
+                    << ", it is ignored. Error: " << e.what();
+    graphs_.clear();
+    return;
+  }
+  MS_LOG(INFO) << "Load the backend compile results of " << graphs_.size() << " cpu graphs from " << cache_file_;
+}
+
+bool CPUCompileCache::FindKernelBuildInfos(const std::string &graph_key, const std::vector<CNodePtr> &kernels,
+                                           std::vector<kernel::KernelBuildInfoPtr> *build_infos) {
+  MS_EXCEPTION_IF_NULL(build_infos);
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = graphs_.find(graph_key);
+  if (iter == graphs_.end() || iter->second.kernels.size() != kernels.size()) {
+    ++miss_count_;
+    return false;
+  }
+  const auto &kernel_caches = iter->second.kernels;
+  build_infos->assign(kernels.size(), nullptr);
+  for (size_t i = 0; i < kernels.size(); ++i) {
+    MS_EXCEPTION_IF_NULL(kernels[i]);
+    const auto &kernel_cache = kernel_caches[i];
+    if (kernel_cache.op_name != common::AnfAlgo::GetCNodeName(kernels[i])) {
+      MS_LOG(WARNING) << "The kernel " << i << " of the cached graph " << graph_key << " is " << kernel_cache.op_name
+                      << ", but got " << kernels[i]->fullname_with_scope() << ", the cache is ignored.";
+      ++miss_count_;
+      return false;
+    }
+    if (!kernel_cache.cached) {
+      continue;
+    }
+    auto builder = std::make_shared<kernel::KernelBuildInfo::KernelBuildInfoBuilder>();
+    builder->SetInputsFormat(kernel_cache.input_formats);
+    builder->SetInputsDeviceType(kernel_cache.input_types);
+    builder->SetOutputsFormat(kernel_cache.output_formats);
+    builder->SetOutputsDeviceType(kernel_cache.output_types);
+    (*build_infos)[i] = builder->Build();
+  }
+  ++hit_count_;
+  return true;
+}
+
+void CPUCompileCache::InsertKernelBuildInfos(const std::string &graph_key, const std::vector<CNodePtr> &kernels,
+                                             const std::vector<bool> &cacheable) {
+  if (kernels.size() != cacheable.size()) {
+    MS_LOG(EXCEPTION) << "The kernels size " << kernels.size() << " is not equal to the cacheable flags size "
+                      << cacheable.size();
+  }
+  GraphCache graph_cache;
+  for (size_t i = 0; i < kernels.size(); ++i) {
+    MS_EXCEPTION_IF_NULL(kernels[i]);
+    KernelCache kernel_cache;
+    kernel_cache.op_name = common::AnfAlgo::GetCNodeName(kernels[i]);
+    auto build_info = cacheable[i] ? AnfAlgo::GetSelectKernelBuildInfo(kernels[i]) : nullptr;
+    if (build_info != nullptr) {
+      kernel_cache.cached = true;
+      kernel_cache.input_formats = build_info->GetAllInputFormats();
+      kernel_cache.input_types = build_info->GetAllInputDeviceTypes();
+      kernel_cache.output_formats = build_info->GetAllOutputFormats();
+      kernel_cache.output_types = build_info->GetAllOutputDeviceTypes();
+    }
+    (void)graph_cache.kernels.emplace_back(std::move(kernel_cache));
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    graphs_[graph_key] = std::move(graph_cache);
+    dirty_ = true;
+  }
+  // Save at once, so the results are kept even if the process exits without destroying the device context.
+  Save();
+}
+
+std::string CPUCompileCache::MemPlanKey(const std::vector<MemPlanBuffer> &buffers) {
+  std::ostringstream signature;
+  for (const auto &buffer : buffers) {
+    signature << buffer.size << "," << buffer.first_use << "," << buffer.last_use << ";";
+  }
+  return HashString(signature.str());
+}
+
+bool CPUCompileCache::FindMemPlan(const std::string &graph_key, std::vector<MemPlanBuffer> *buffers,
+                                  size_t *mem_size) {
+  MS_EXCEPTION_IF_NULL(buffers);
+  MS_EXCEPTION_IF_NULL(mem_size);
+  auto plan_key = MemPlanKey(*buffers);
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto graph_iter = graphs_.find(graph_key);
+  if (graph_iter == graphs_.end()) {
+    return false;
+  }
+  auto plan_iter = graph_iter->second.mem_plans.find(plan_key);
+  if (plan_iter == graph_iter->second.mem_plans.end() || plan_iter->second.offsets.size() != buffers->size()) {
+    return false;
+  }
+  for (size_t i = 0; i < buffers->size(); ++i) {
+    (*buffers)[i].offset = plan_iter->second.offsets[i];
+  }
+  *mem_size = plan_iter->second.mem_size;
+  return true;
+}
+
+void CPUCompileCache::InsertMemPlan(const std::string &graph_key, const std::vector<MemPlanBuffer> &buffers,
+                                    size_t mem_size) {
+  MemPlanCache plan_cache;
+  plan_cache.mem_size = mem_size;
+  for (const auto &buffer : buffers) {
+    (void)plan_cache.offsets.emplace_back(buffer.offset);
+  }
+  auto plan_key = MemPlanKey(buffers);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // The memory plans are kept with the kernels of the graph, so they are dropped when the graph changes.
+    auto graph_iter = graphs_.find(graph_key);
+    if (graph_iter == graphs_.end()) {
+      return;
+    }
+    graph_iter->second.mem_plans[plan_key] = std::move(plan_cache);
+    dirty_ = true;
+  }
+  Save();
+}
+
+void CPUCompileCache::Save() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  MS_LOG(DEBUG) << "Cpu backend compile cache hit: " << hit_count_ << ", miss: " << miss_count_;
+  if (cache_file_.empty() || !dirty_) {
+    return;
+  }
+  auto cache_dir = FileUtils::CreateNotExistDirs(cache_dir_, true);
+  if (!cache_dir.has_value()) {
+    MS_LOG(WARNING) << "Failed to create the directory of the cpu backend compile cache " << cache_file_;
+    return;
+  }
+  nlohmann::json js;
+  js[kGraphs] = nlohmann::json::object();
+  for (const auto &graph_item : graphs_) {
+    nlohmann::json graph_js;
+    graph_js[kKernels] = nlohmann::json::array();
+    for (const auto &kernel_cache : graph_item.second.kernels) {
+      nlohmann::json kernel_js;
+      kernel_js[kOpName] = kernel_cache.op_name;
+      kernel_js[kCached] = kernel_cache.cached;
+      if (kernel_cache.cached) {
+        kernel_js[kInputFormats] = kernel_cache.input_formats;
+        kernel_js[kInputTypes] = kernel_cache.input_types;
+        kernel_js[kOutputFormats] = kernel_cache.output_formats;
+        kernel_js[kOutputTypes] = kernel_cache.output_types;
+      }
+      graph_js[kKernels].push_back(kernel_js);
+    }
+    graph_js[kMemPlans] = nlohmann::json::object();
+    for (const auto &plan_item : graph_item.second.mem_plans) {
+      graph_js[kMemPlans][plan_item.first] = {{kMemSize, plan_item.second.mem_size},
+                                              {kOffsets, plan_item.second.offsets}};
+    }
+    js[kGraphs][graph_item.first] = graph_js;
+  }
+  // write a temporary file first, so a job starting meanwhile never reads a half written cache.
+  std::string tmp_file = cache_file_ + ".tmp";
+  {
+    std::ofstream ofs(tmp_file);
+    if (!ofs.is_open()) {
+      MS_LOG(WARNING) << "Failed to open " << tmp_file << " to save the cpu backend compile cache.";
+      return;
+    }
+    ofs << js.dump(1);
+  }
+  if (std::rename(tmp_file.c_str(), cache_file_.c_str()) != 0) {
+    MS_LOG(WARNING) << "Failed to save the cpu backend compile cache to " << cache_file_;
+    (void)std::remove(tmp_file.c_str());
+    return;
+  }
+  dirty_ = false;
+  MS_LOG(INFO) << "Save the backend compile results of " << graphs_.size() << " cpu graphs to " << cache_file_;
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,112 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_HAL_DEVICE_CPU_COMPILE_CACHE_H_
+#define MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_HAL_DEVICE_CPU_COMPILE_CACHE_H_
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "backend/common/session/kernel_graph.h"
+#include "kernel/kernel_build_info.h"
+#include "plugin/device/cpu/hal/device/cpu_simple_mem_plan.h"
+#include "utils/ms_utils.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+// The attribute of the kernel graph keeping its key in the cpu compile cache.
+constexpr char kAttrCPUCompileCacheKey[] = "cpu_compile_cache_key";
+
+// The backend compile results of the cpu graphs, keyed by the hash of the graph before the kernel selection: the
+// kernel build info selected for each kernel, and the offsets of the memory plans of the graph. When the compile cache
+// path is set, the results are loaded from and saved to the cache file under it, so a restarted job takes them
+// instead of selecting the kernels and planning the memory again.
+class CPUCompileCache {
+ public:
+  // The instance of the compile cache path in the context.
+  static CPUCompileCache &GetInstance();
+  // The cache of the cache file under the directory, it is not saved if the directory is empty.
+  explicit CPUCompileCache(const std::string &cache_dir);
+  ~CPUCompileCache() = default;
+
+  bool enabled() const { return !cache_file_.empty(); }
+
+  // The hash of the kernels in the execution order, the types and the shapes of their inputs and outputs, the
+  // attributes and the edges between them. The graphs of the same key select the same kernels.
+  static std::string GraphKey(const session::KernelGraph &graph);
+  // The key set on the graph, empty if the graph is not cached.
+  static std::string GetGraphKey(const session::KernelGraph &graph);
+
+  // Get the cached kernel build info of the kernels, the ones not cached are null. Return false if the graph is not
+  // cached or the kernels don't match.
+  bool FindKernelBuildInfos(const std::string &graph_key, const std::vector<CNodePtr> &kernels,
+                            std::vector<kernel::KernelBuildInfoPtr> *build_infos);
+  // Cache the selected kernel build info of the kernels and save the cache file, the cacheable ones are the kernels
+  // whose selection only sets the kernel build info.
+  void InsertKernelBuildInfos(const std::string &graph_key, const std::vector<CNodePtr> &kernels,
+                              const std::vector<bool> &cacheable);
+
+  // Set the offsets of the buffers by the cached plan of the same buffers, return false if it is not cached.
+  bool FindMemPlan(const std::string &graph_key, std::vector<MemPlanBuffer> *buffers, size_t *mem_size);
+  // Cache the plan of the buffers and save the cache file.
+  void InsertMemPlan(const std::string &graph_key, const std::vector<MemPlanBuffer> &buffers, size_t mem_size);
+
+  // Write the cache file if there are new results.
+  void Save();
+
+  size_t hit_count() const { return hit_count_; }
+  size_t miss_count() const { return miss_count_; }
+
+ private:
+  struct KernelCache {
+    std::string op_name;
+    bool cached{false};
+    std::vector<std::string> input_formats;
+    std::vector<TypeId> input_types;
+    std::vector<std::string> output_formats;
+    std::vector<TypeId> output_types;
+  };
+  struct MemPlanCache {
+    size_t mem_size{0};
+    std::vector<size_t> offsets;
+  };
+  struct GraphCache {
+    std::vector<KernelCache> kernels;
+    // keyed by the hash of the sizes and the lifetimes of the buffers.
+    std::map<std::string, MemPlanCache> mem_plans;
+  };
+
+  DISABLE_COPY_AND_ASSIGN(CPUCompileCache)
+  void Load();
+  static std::string MemPlanKey(const std::vector<MemPlanBuffer> &buffers);
+
+  // empty if the compile cache path is not set.
+  std::string cache_dir_;
+  std::string cache_file_;
+  std::mutex mutex_;
+  std::map<std::string, GraphCache> graphs_;
+  bool dirty_{false};
+  std::atomic_size_t hit_count_{0};
+  std::atomic_size_t miss_count_{0};
+};
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_HAL_DEVICE_CPU_COMPILE_CACHE_H_
@@ -0,0 +1,463 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "plugin/device/cpu/hal/device/cpu_offload_mem_handler.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#include "utils/file_utils.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+// The zero runs shorter than it are kept in the literals, so a record always saves more than its header.
+constexpr size_t kMinZeroRun = 32;
+constexpr size_t kRecordHeaderSize = 2 * sizeof(uint64_t);
+// A quarter of the memory limit is reserved for the prefetched data.
+constexpr size_t kPrefetchReserveRatio = 4;
+
+void CopyMemory(void *dst, const void *src, size_t size) {
+  // The security memory copy function 'memcpy_s' has a size limit (SECUREC_MEM_MAX_LEN).
+  auto dst_bytes = reinterpret_cast<uint8_t *>(dst);
+  auto src_bytes = reinterpret_cast<const uint8_t *>(src);
+  for (size_t pos = 0; pos < size; pos += SECUREC_MEM_MAX_LEN) {
+    size_t count = std::min(size - pos, static_cast<size_t>(SECUREC_MEM_MAX_LEN));
+    auto ret = memcpy_s(dst_bytes + pos, count, src_bytes + pos, count);
+    if (ret != EOK) {
+      MS_LOG(EXCEPTION) << "Copy the offload memory failed, size: " << count << ", error code: " << ret;
+    }
+  }
+}
+
+void AppendRecord(std::vector<uint8_t> *compressed, uint64_t zero_count, const uint8_t *literal,
+                  uint64_t literal_count) {
+  size_t pos = compressed->size();
+  compressed->resize(pos + kRecordHeaderSize + literal_count);
+  CopyMemory(compressed->data() + pos, &zero_count, sizeof(uint64_t));
+  CopyMemory(compressed->data() + pos + sizeof(uint64_t), &literal_count, sizeof(uint64_t));
+  if (literal_count > 0) {
+    CopyMemory(compressed->data() + pos + kRecordHeaderSize, literal, literal_count);
+  }
+}
+}  // namespace
+
+CPUOffloadMemHandler::CPUOffloadMemHandler(size_t mem_limit, const std::string &offload_path)
+    : device_limit_(mem_limit - mem_limit / kPrefetchReserveRatio),
+      prefetch_limit_(mem_limit / kPrefetchReserveRatio) {
+  if (!offload_path.empty()) {
+#ifndef _WIN32
+    auto real_path = FileUtils::CreateNotExistDirs(offload_path, true);
+    if (!real_path.has_value()) {
+      MS_LOG(EXCEPTION) << "Create the offload path " << offload_path << " failed.";
+    }
+    static std::atomic<size_t> file_index{0};
+    auto file_name = real_path.value() + "/cpu_offload_" + std::to_string(getpid()) + "_" +
+                     std::to_string(file_index.fetch_add(1)) + ".bin";
+    fd_ = open(file_name.c_str(), O_RDWR | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+    if (fd_ < 0) {
+      MS_LOG(EXCEPTION) << "Open the offload file " << file_name << " failed, errno: " << errno;
+    }
+    // The file is removed when it is closed, even if the process exits abnormally.
+    (void)unlink(file_name.c_str());
+    MS_LOG(INFO) << "Offload to the file " << file_name;
+#else
+    MS_LOG(WARNING) << "Offloading to a file is not supported on windows, the memory is offloaded to the host.";
+#endif
+  }
+  worker_ = std::thread(&CPUOffloadMemHandler::WorkerLoop, this);
+}
+
+CPUOffloadMemHandler::~CPUOffloadMemHandler() {
+  {
+    std::lock_guard<std::mutex> lock(task_mutex_);
+    stop_ = true;
+  }
+  task_cond_.notify_all();
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+  // the device memory and the prefetched data which are not freed.
+  for (auto &item : mem_sizes_) {
+    std::free(item.first);
+  }
+#ifndef _WIN32
+  if (fd_ >= 0) {
+    (void)close(fd_);
+  }
+#endif
+}
+
+size_t CPUOffloadMemHandler::mem_used() const {
+  std::lock_guard<std::mutex> lock(mem_mutex_);
+  return device_used_ + prefetch_used_;
+}
+
+void *CPUOffloadMemHandler::MallocMem(size_t mem_size, bool for_prefetch) {
+  {
+    std::lock_guard<std::mutex> lock(mem_mutex_);
+    size_t used = for_prefetch ? prefetch_used_ : device_used_;
+    size_t limit = for_prefetch ? prefetch_limit_ : device_limit_;
+    if (used + mem_size > limit) {
+      return nullptr;
+    }
+    (for_prefetch ? prefetch_used_ : device_used_) += mem_size;
+  }
+  // The freed memory is returned to the system instead of being cached, so the memory of the process is limited too.
+  auto ptr = std::malloc(std::max(mem_size, static_cast<size_t>(1)));
+  std::lock_guard<std::mutex> lock(mem_mutex_);
+  if (ptr == nullptr) {
+    (for_prefetch ? prefetch_used_ : device_used_) -= mem_size;
+    return nullptr;
+  }
+  mem_sizes_[ptr] = std::make_pair(mem_size, for_prefetch);
+  return ptr;
+}
+
+void CPUOffloadMemHandler::FreeMem(void *ptr) {
+  std::lock_guard<std::mutex> lock(mem_mutex_);
+  auto iter = mem_sizes_.find(ptr);
+  if (iter == mem_sizes_.end()) {
+    MS_LOG(EXCEPTION) << "The memory " << ptr << " is not allocated by the offload memory handler.";
+  }
+  (iter->second.second ? prefetch_used_ : device_used_) -= iter->second.first;
+  (void)mem_sizes_.erase(iter);
+  std::free(ptr);
+}
+
+void *CPUOffloadMemHandler::MallocDevice(size_t mem_size) {
+  auto ptr = MallocMem(mem_size, false);
+  if (ptr != nullptr) {
+    return ptr;
+  }
+  // The memory being swapped out is freed when the swap out tasks finish.
+  bool has_swapping_out = false;
+  {
+    std::lock_guard<std::mutex> lock(mem_mutex_);
+    has_swapping_out = !free_after_swap_out_.empty();
+  }
+  if (!has_swapping_out) {
+    return nullptr;
+  }
+  WaitAllTasks();
+  return MallocMem(mem_size, false);
+}
+
+void CPUOffloadMemHandler::FreeDevice(void *ptr) {
+  {
+    std::lock_guard<std::mutex> lock(mem_mutex_);
+    if (swapping_out_.count(ptr) > 0) {
+      (void)free_after_swap_out_.insert(ptr);
+      return;
+    }
+  }
+  FreeMem(ptr);
+}
+
+void *CPUOffloadMemHandler::MallocHost(size_t mem_size) {
+  auto block = std::make_unique<OffloadBlock>();
+  block->size = mem_size;
+  if (file_backed()) {
+    block->file_offset = AllocFileSpace(mem_size);
+  }
+  void *host_ptr = block.get();
+  blocks_[host_ptr] = std::move(block);
+  return host_ptr;
+}
+
+void CPUOffloadMemHandler::FreeHost(void *ptr) {
+  auto iter = blocks_.find(ptr);
+  if (iter == blocks_.end()) {
+    return;
+  }
+  auto block = iter->second.get();
+  DropStaging(block);
+  WaitTask(block->write_task);
+  if (file_backed()) {
+    (void)free_file_space_[block->size].emplace_back(block->file_offset);
+  }
+  (void)blocks_.erase(iter);
+}
+
+void CPUOffloadMemHandler::SwapIn(const void *host_ptr, void *device_ptr, size_t mem_size, void *stream) {
+  MS_EXCEPTION_IF_NULL(host_ptr);
+  MS_EXCEPTION_IF_NULL(device_ptr);
+  // The memory is not copied when the memory scheduler mocks the steps.
+  if (stream == nullptr) {
+    return;
+  }
+  auto block = FindBlock(host_ptr);
+  if (block == nullptr) {
+    CopyMemory(device_ptr, host_ptr, mem_size);
+    return;
+  }
+  if (block->staging != nullptr) {
+    WaitTask(block->prefetch_task);
+    CopyMemory(device_ptr, block->staging, std::min(mem_size, block->size));
+    DropStaging(block);
+    return;
+  }
+  WaitTask(block->write_task);
+  if (block->written) {
+    ReadBlock(block, reinterpret_cast<uint8_t *>(device_ptr));
+  }
+}
+
+void CPUOffloadMemHandler::SwapOut(const void *device_ptr, void *host_ptr, size_t mem_size, void *stream) {
+  MS_EXCEPTION_IF_NULL(host_ptr);
+  MS_EXCEPTION_IF_NULL(device_ptr);
+  if (stream == nullptr) {
+    return;
+  }
+  auto block = FindBlock(host_ptr);
+  if (block == nullptr) {
+    CopyMemory(host_ptr, device_ptr, mem_size);
+    return;
+  }
+  // The prefetched data is out of date.
+  DropStaging(block);
+  auto ptr = const_cast<void *>(device_ptr);
+  {
+    std::lock_guard<std::mutex> lock(mem_mutex_);
+    (void)swapping_out_.insert(ptr);
+  }
+  block->write_task = AddTask([this, block, ptr]() {
+    WriteBlock(block, reinterpret_cast<const uint8_t *>(ptr));
+    bool need_free = false;
+    {
+      std::lock_guard<std::mutex> lock(mem_mutex_);
+      (void)swapping_out_.erase(ptr);
+      need_free = free_after_swap_out_.erase(ptr) > 0;
+    }
+    if (need_free) {
+      FreeMem(ptr);
+    }
+  });
+}
+
+void CPUOffloadMemHandler::Prefetch(const void *host_ptr, size_t mem_size) {
+  auto block = FindBlock(host_ptr);
+  if (block == nullptr || block->staging != nullptr || (!block->written && block->write_task == 0)) {
+    return;
+  }
+  // The data is swapped in directly if the memory reserved for the prefetched data is used up.
+  auto staging = MallocMem(block->size, true);
+  if (staging == nullptr) {
+    return;
+  }
+  block->staging = staging;
+  block->prefetch_task = AddTask([this, block, staging]() { ReadBlock(block, reinterpret_cast<uint8_t *>(staging)); });
+}
+
+CPUOffloadMemHandler::OffloadBlock *CPUOffloadMemHandler::FindBlock(const void *host_ptr) {
+  auto iter = blocks_.find(host_ptr);
+  return iter == blocks_.end() ? nullptr : iter->second.get();
+}
+
+void CPUOffloadMemHandler::DropStaging(OffloadBlock *block) {
+  MS_EXCEPTION_IF_NULL(block);
+  if (block->staging == nullptr) {
+    return;
+  }
+  WaitTask(block->prefetch_task);
+  FreeMem(block->staging);
+  block->staging = nullptr;
+}
+
+void CPUOffloadMemHandler::WriteBlock(OffloadBlock *block, const uint8_t *src) {
+  MS_EXCEPTION_IF_NULL(block);
+  MS_EXCEPTION_IF_NULL(src);
+#ifndef _WIN32
+  if (file_backed()) {
+    size_t pos = 0;
+    while (pos < block->size) {
+      auto ret = pwrite(fd_, src + pos, block->size - pos, static_cast<off_t>(block->file_offset + pos));
+      if (ret <= 0) {
+        MS_LOG(EXCEPTION) << "Write the offload file failed, size: " << block->size << ", errno: " << errno;
+      }
+      pos += static_cast<size_t>(ret);
+    }
+    block->written = true;
+    return;
+  }
+#endif
+  block->data = CompressZeros(src, block->size);
+  block->raw = false;
+  if (block->data.size() >= block->size) {
+    block->data.assign(src, src + block->size);
+    block->raw = true;
+  }
+  block->data.shrink_to_fit();
+  block->written = true;
+}
+
+void CPUOffloadMemHandler::ReadBlock(const OffloadBlock *block, uint8_t *dst) const {
+  MS_EXCEPTION_IF_NULL(block);
+  MS_EXCEPTION_IF_NULL(dst);
+#ifndef _WIN32
+  if (file_backed()) {
+    size_t pos = 0;
+    while (pos < block->size) {
+      auto ret = pread(fd_, dst + pos, block->size - pos, static_cast<off_t>(block->file_offset + pos));
+      if (ret <= 0) {
+        MS_LOG(EXCEPTION) << "Read the offload file failed, size: " << block->size << ", errno: " << errno;
+      }
+      pos += static_cast<size_t>(ret);
+    }
+    return;
+  }
+#endif
+  if (block->raw) {
+    CopyMemory(dst, block->data.data(), block->size);
+    return;
+  }
+  DecompressZeros(block->data, dst, block->size);
+}
+
+size_t CPUOffloadMemHandler::AllocFileSpace(size_t size) {
+  auto iter = free_file_space_.find(size);
+  if (iter != free_file_space_.end() && !iter->second.empty()) {
+    auto offset = iter->second.back();
+    iter->second.pop_back();
+    return offset;
+  }
+  auto offset = file_size_;
+  file_size_ += size;
+  return offset;
+}
+
+std::vector<uint8_t> CPUOffloadMemHandler::CompressZeros(const uint8_t *data, size_t size) {
+  MS_EXCEPTION_IF_NULL(data);
+  std::vector<uint8_t> compressed;
+  size_t pos = 0;
+  while (pos < size) {
+    size_t zero_begin = pos;
+    while (pos < size && data[pos] == 0) {
+      ++pos;
+    }
+    size_t literal_begin = pos;
+    size_t zero_run = 0;
+    while (pos < size) {
+      if (data[pos] != 0) {
+        zero_run = 0;
+      } else if (++zero_run == kMinZeroRun) {
+        break;
+      }
+      ++pos;
+    }
+    // the literal ends at the beginning of a long zero run, or at the end of the data.
+    size_t literal_end = (zero_run == kMinZeroRun) ? pos + 1 - kMinZeroRun : pos;
+    AppendRecord(&compressed, literal_begin - zero_begin, data + literal_begin, literal_end - literal_begin);
+    pos = literal_end;
+  }
+  return compressed;
+}
+
+void CPUOffloadMemHandler::DecompressZeros(const std::vector<uint8_t> &compressed, uint8_t *data, size_t size) {
+  MS_EXCEPTION_IF_NULL(data);
+  size_t in_pos = 0;
+  size_t out_pos = 0;
+  while (in_pos < compressed.size()) {
+    if (compressed.size() - in_pos < kRecordHeaderSize) {
+      MS_LOG(EXCEPTION) << "The compressed data is truncated at " << in_pos << ", size: " << compressed.size();
+    }
+    uint64_t zero_count = 0;
+    uint64_t literal_count = 0;
+    CopyMemory(&zero_count, compressed.data() + in_pos, sizeof(uint64_t));
+    CopyMemory(&literal_count, compressed.data() + in_pos + sizeof(uint64_t), sizeof(uint64_t));
+    in_pos += kRecordHeaderSize;
+    if (zero_count > size - out_pos || literal_count > size - out_pos - zero_count ||
+        literal_count > compressed.size() - in_pos) {
+      MS_LOG(EXCEPTION) << "The compressed data is out of range at " << in_pos << ", size: " << size;
+    }
+    std::fill(data + out_pos, data + out_pos + zero_count, 0);
+    out_pos += zero_count;
+    if (literal_count > 0) {
+      CopyMemory(data + out_pos, compressed.data() + in_pos, literal_count);
+    }
+    out_pos += literal_count;
+    in_pos += literal_count;
+  }
+  if (out_pos != size) {
+    MS_LOG(EXCEPTION) << "The size of the decompressed data " << out_pos << " is not equal to " << size;
+  }
+}
+
+uint64_t CPUOffloadMemHandler::AddTask(std::function<void()> &&task) {
+  uint64_t task_id = 0;
+  {
+    std::lock_guard<std::mutex> lock(task_mutex_);
+    task_id = ++last_task_;
+    tasks_.emplace(task_id, std::move(task));
+  }
+  task_cond_.notify_one();
+  return task_id;
+}
+
+void CPUOffloadMemHandler::WaitTask(uint64_t task_id) {
+  std::unique_lock<std::mutex> lock(task_mutex_);
+  done_cond_.wait(lock, [this, task_id]() { return done_task_ >= task_id || !task_error_.empty(); });
+  if (!task_error_.empty()) {
+    MS_LOG(EXCEPTION) << "The offload task failed: " << task_error_;
+  }
+}
+
+void CPUOffloadMemHandler::WaitAllTasks() {
+  uint64_t task_id = 0;
+  {
+    std::lock_guard<std::mutex> lock(task_mutex_);
+    task_id = last_task_;
+  }
+  WaitTask(task_id);
+}
+
+void CPUOffloadMemHandler::WorkerLoop() {
+  while (true) {
+    std::pair<uint64_t, std::function<void()>> task;
+    {
+      std::unique_lock<std::mutex> lock(task_mutex_);
+      task_cond_.wait(lock, [this]() { return stop_ || !tasks_.empty(); });
+      if (tasks_.empty()) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop();
+    }
+    std::string error;
+    try {
+      task.second();
+    } catch (const std::exception &e) {
+      error = e.what();
+    }
+    {
+      std::lock_guard<std::mutex> lock(task_mutex_);
+      done_task_ = task.first;
+      if (!error.empty() && task_error_.empty()) {
+        task_error_ = error;
+      }
+    }
+    done_cond_.notify_all();
+  }
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
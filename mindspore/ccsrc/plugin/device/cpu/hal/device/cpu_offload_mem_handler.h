@@ -0,0 +1,129 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_HAL_DEVICE_CPU_OFFLOAD_MEM_HANDLER_H_
+#define MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_HAL_DEVICE_CPU_OFFLOAD_MEM_HANDLER_H_
+
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "runtime/device/memory_scheduler.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+// The environment variable of the memory limit in MB of the graph working set, the graphs are replayed with their
+// activations offloaded when it is set.
+constexpr char kCPUOffloadMemLimitEnv[] = "MS_DEV_CPU_OFFLOAD_MEM_LIMIT";
+// The environment variable of the directory to offload to, the offloaded memory is kept compressed in the host memory
+// when it is not set.
+constexpr char kCPUOffloadPathEnv[] = "MS_DEV_CPU_OFFLOAD_PATH";
+
+// The memory handler of the memory scheduler on CPU. The "device" memory is the working set in the RAM, and the "host"
+// memory is the offload tier: the data swapped out are compressed in the host memory, or written to a file in the
+// offload path. The host pointers of the offload tier are handles which can only be used by this handler, the other
+// host pointers, such as the data of the graph inputs, are copied directly. The swap out and the prefetch run in a
+// background thread, the swap in waits for them. The memory of the working set and the prefetched data is not more
+// than mem_limit bytes, a part of it is reserved for the prefetched data.
+class CPUOffloadMemHandler : public MemHandler {
+ public:
+  CPUOffloadMemHandler(size_t mem_limit, const std::string &offload_path);
+  ~CPUOffloadMemHandler() override;
+
+  size_t GetAvailableMemSize() override { return device_limit_; }
+  void *MallocDevice(size_t mem_size) override;
+  void FreeDevice(void *ptr) override;
+  void *MallocHost(size_t mem_size) override;
+  void FreeHost(void *ptr) override;
+  void SwapIn(const void *host_ptr, void *device_ptr, size_t mem_size, void *stream) override;
+  void SwapOut(const void *device_ptr, void *host_ptr, size_t mem_size, void *stream) override;
+  void Prefetch(const void *host_ptr, size_t mem_size) override;
+
+  size_t mem_used() const;
+  bool file_backed() const { return fd_ >= 0; }
+
+  // The activations are sparse after the activation functions such as ReLU and the dropout, so the runs of zero bytes
+  // are compressed: the data are records of the zero count, the literal count and the literal bytes.
+  static std::vector<uint8_t> CompressZeros(const uint8_t *data, size_t size);
+  static void DecompressZeros(const std::vector<uint8_t> &compressed, uint8_t *data, size_t size);
+
+ private:
+  struct OffloadBlock {
+    size_t size{0};
+    bool written{false};
+    // the data in the host memory, not compressed if raw.
+    std::vector<uint8_t> data;
+    bool raw{false};
+    // the offset in the offload file.
+    size_t file_offset{0};
+    // the last task writing the block, and the task prefetching it to the staging memory.
+    uint64_t write_task{0};
+    uint64_t prefetch_task{0};
+    void *staging{nullptr};
+  };
+  using OffloadBlockPtr = std::unique_ptr<OffloadBlock>;
+
+  OffloadBlock *FindBlock(const void *host_ptr);
+  void WriteBlock(OffloadBlock *block, const uint8_t *src);
+  void ReadBlock(const OffloadBlock *block, uint8_t *dst) const;
+  void DropStaging(OffloadBlock *block);
+  size_t AllocFileSpace(size_t size);
+
+  void *MallocMem(size_t mem_size, bool for_prefetch);
+  void FreeMem(void *ptr);
+  uint64_t AddTask(std::function<void()> &&task);
+  void WaitTask(uint64_t task_id);
+  void WaitAllTasks();
+  void WorkerLoop();
+
+  size_t device_limit_;
+  size_t prefetch_limit_;
+  int fd_{-1};
+  size_t file_size_{0};
+  std::map<size_t, std::vector<size_t>> free_file_space_;
+  std::map<const void *, OffloadBlockPtr> blocks_;
+
+  mutable std::mutex mem_mutex_;
+  size_t device_used_{0};
+  size_t prefetch_used_{0};
+  // the size of the memory, and whether it is for the prefetched data.
+  std::map<void *, std::pair<size_t, bool>> mem_sizes_;
+  // the device memory being swapped out, it is freed by the task if it is freed before the task finishes.
+  std::set<void *> swapping_out_;
+  std::set<void *> free_after_swap_out_;
+
+  std::mutex task_mutex_;
+  std::condition_variable task_cond_;
+  std::condition_variable done_cond_;
+  std::queue<std::pair<uint64_t, std::function<void()>>> tasks_;
+  uint64_t last_task_{0};
+  uint64_t done_task_{0};
+  std::string task_error_;
+  bool stop_{false};
+  std::thread worker_;
+};
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_HAL_DEVICE_CPU_OFFLOAD_MEM_HANDLER_H_
@@ -14,61 +14,112 @@
  * limitations under the License.
  */
 #include "plugin/device/cpu/hal/device/cpu_simple_mem_plan.h"
+#include <algorithm>
 #include "backend/common/session/anf_runtime_algorithm.h"
 #include "include/common/utils/anfalgo.h"
+#include "plugin/device/cpu/hal/device/cpu_compile_cache.h"
 
 namespace mindspore {
 namespace device {
 namespace cpu {
-size_t CPUSimpleMemPlan::MemPlan(const session::KernelGraph *graph) {
-  MS_EXCEPTION_IF_NULL(graph);
-  size_t total_mem_size = 32;
-  auto kernels = graph->execution_order();
-  for (const auto &kernel : kernels) {
-    MS_EXCEPTION_IF_NULL(kernel);
-    size_t input_num = common::AnfAlgo::GetInputTensorNum(kernel);
-    for (size_t i = 0; i < input_num; ++i) {
-      auto kernel_with_index = common::AnfAlgo::GetPrevNodeOutput(kernel, i);
-      MS_EXCEPTION_IF_NULL(kernel_with_index.first);
-      if (kernel_with_index.first->isa<Parameter>()) {
-        continue;
-      }
-      auto address = AnfAlgo::GetOutputAddr(kernel_with_index.first, kernel_with_index.second, true);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        total_mem_size += address->size_;
-      }
+namespace {
+// the same as the original plan, some extra memory is reserved at the end.
+constexpr size_t kReservedMemSize = 32;
+constexpr size_t kMemAlignSize = 64;
+
+size_t AlignMemSize(size_t size) { return (size + kMemAlignSize - 1) / kMemAlignSize * kMemAlignSize; }
+
+bool IsLiveTogether(const MemPlanBuffer &lhs, const MemPlanBuffer &rhs) {
+  return lhs.first_use <= rhs.last_use && rhs.first_use <= lhs.last_use;
+}
+}  // namespace
+
+size_t CPUSimpleMemPlan::AssignOffsets(std::vector<MemPlanBuffer> *buffers) {
+  MS_EXCEPTION_IF_NULL(buffers);
+  std::vector<size_t> order(buffers->size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(), [buffers](size_t lhs, size_t rhs) {
+    const auto &lhs_buffer = (*buffers)[lhs];
+    const auto &rhs_buffer = (*buffers)[rhs];
+    if (lhs_buffer.size != rhs_buffer.size) {
+      return lhs_buffer.size > rhs_buffer.size;
     }
+    return lhs_buffer.first_use < rhs_buffer.first_use;
+  });
 
-    size_t output_num = common::AnfAlgo::GetOutputTensorNum(kernel);
-    for (size_t i = 0; i < output_num; ++i) {
-      auto address = AnfAlgo::GetOutputAddr(kernel, i);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        total_mem_size += address->size_;
+  size_t total_size = 0;
+  std::vector<size_t> placed;
+  std::vector<const MemPlanBuffer *> conflicts;
+  for (auto index : order) {
+    auto &buffer = (*buffers)[index];
+    size_t size = AlignMemSize(buffer.size);
+    conflicts.clear();
+    for (auto placed_index : placed) {
+      const auto &placed_buffer = (*buffers)[placed_index];
+      if (IsLiveTogether(buffer, placed_buffer)) {
+        conflicts.push_back(&placed_buffer);
       }
     }
-
-    auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
-    MS_EXCEPTION_IF_NULL(kernel_mod);
-    for (size_t i = 0; i < kernel_mod->GetWorkspaceSizeList().size(); ++i) {
-      auto address = AnfAlgo::GetWorkspaceAddr(kernel, i);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        total_mem_size += address->size_;
+    std::sort(conflicts.begin(), conflicts.end(),
+              [](const MemPlanBuffer *lhs, const MemPlanBuffer *rhs) { return lhs->offset < rhs->offset; });
+    // find the smallest gap between the conflicting buffers which fits the buffer, or place it after all of them.
+    size_t best_offset = 0;
+    size_t best_gap = SIZE_MAX;
+    size_t gap_begin = 0;
+    for (auto conflict : conflicts) {
+      if (conflict->offset > gap_begin) {
+        size_t gap = conflict->offset - gap_begin;
+        if (gap >= size && gap < best_gap) {
+          best_gap = gap;
+          best_offset = gap_begin;
+        }
       }
+      gap_begin = std::max(gap_begin, conflict->offset + AlignMemSize(conflict->size));
     }
+    if (best_gap == SIZE_MAX) {
+      best_offset = gap_begin;
+    }
+    buffer.offset = best_offset;
+    total_size = std::max(total_size, best_offset + size);
+    placed.push_back(index);
   }
+  return total_size;
+}
 
-  return total_mem_size;
+void CPUSimpleMemPlan::AddBufferUse(DeviceAddress *address, size_t step) {
+  MS_EXCEPTION_IF_NULL(address);
+  if (address->ptr_ != nullptr) {
+    return;
+  }
+  auto iter = buffer_index_.find(address);
+  if (iter == buffer_index_.end()) {
+    buffer_index_[address] = buffers_.size();
+    (void)buffers_.emplace_back(MemPlanBuffer{address->size_, step, step, 0});
+    (void)addresses_.emplace_back(address);
+    return;
+  }
+  auto &buffer = buffers_[iter->second];
+  buffer.first_use = std::min(buffer.first_use, step);
+  buffer.last_use = std::max(buffer.last_use, step);
 }
 
-void CPUSimpleMemPlan::MemAssign(const session::KernelGraph *graph, uint8_t *base_ptr) {
+void CPUSimpleMemPlan::AnalyzeLiveness(const session::KernelGraph *graph, const std::vector<size_t> &kernel_steps) {
   MS_EXCEPTION_IF_NULL(graph);
-  MS_EXCEPTION_IF_NULL(base_ptr);
-  uint8_t *mem_ptr = base_ptr;
+  buffers_.clear();
+  addresses_.clear();
+  buffer_index_.clear();
   auto kernels = graph->execution_order();
-  for (const auto &kernel : kernels) {
+  if (kernel_steps.size() != kernels.size()) {
+    MS_LOG(EXCEPTION) << "The kernel steps size " << kernel_steps.size() << " is not equal to the kernels size "
+                      << kernels.size() << " of graph " << graph->graph_id();
+  }
+  size_t end_step = 0;
+  for (size_t index = 0; index < kernels.size(); ++index) {
+    const auto &kernel = kernels[index];
+    size_t step = kernel_steps[index];
+    end_step = std::max(end_step, step + 1);
     MS_EXCEPTION_IF_NULL(kernel);
     size_t input_num = common::AnfAlgo::GetInputTensorNum(kernel);
     for (size_t i = 0; i < input_num; ++i) {
@@ -78,34 +129,94 @@ void CPUSimpleMemPlan::MemAssign(const session::KernelGraph *graph, uint8_t *bas
         continue;
       }
       auto address = AnfAlgo::GetMutableOutputAddr(kernel_with_index.first, kernel_with_index.second, true);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        address->ptr_ = mem_ptr;
-        mem_ptr = mem_ptr + address->size_;
-      }
+      AddBufferUse(address.get(), step);
     }
 
     size_t output_num = common::AnfAlgo::GetOutputTensorNum(kernel);
     for (size_t i = 0; i < output_num; ++i) {
       auto address = AnfAlgo::GetMutableOutputAddr(kernel, i);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        address->ptr_ = mem_ptr;
-        mem_ptr = mem_ptr + address->size_;
-      }
+      AddBufferUse(address.get(), step);
     }
 
     auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
     MS_EXCEPTION_IF_NULL(kernel_mod);
     for (size_t i = 0; i < kernel_mod->GetWorkspaceSizeList().size(); ++i) {
-      auto address = AnfAlgo::GetWorkspaceAddr(kernel, i);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        address->ptr_ = mem_ptr;
-        mem_ptr = mem_ptr + address->size_;
-      }
+      auto address = AnfAlgo::GetMutableWorkspaceAddr(kernel, i);
+      AddBufferUse(address.get(), step);
+    }
+  }
+
+  // the graph outputs and the summary tensors are read after the graph runs, they are live to the end.
+  std::vector<session::KernelWithIndex> keep_alive;
+  if (graph->output() != nullptr) {
+    keep_alive = common::AnfAlgo::GetAllOutputWithIndex(graph->output());
+  }
+  for (const auto &summary : graph->summary_nodes()) {
+    (void)keep_alive.emplace_back(summary.second.first, IntToSize(summary.second.second));
+  }
+  for (const auto &output : keep_alive) {
+    MS_EXCEPTION_IF_NULL(output.first);
+    if (!output.first->isa<CNode>() || !AnfAlgo::OutputAddrExist(output.first, output.second, true)) {
+      continue;
+    }
+    auto address = AnfAlgo::GetMutableOutputAddr(output.first, output.second, true);
+    auto iter = buffer_index_.find(address.get());
+    if (iter != buffer_index_.end()) {
+      buffers_[iter->second].last_use = end_step;
+    }
+  }
+}
+
+size_t CPUSimpleMemPlan::MemPlan(const session::KernelGraph *graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  std::vector<size_t> kernel_steps(graph->execution_order().size());
+  for (size_t i = 0; i < kernel_steps.size(); ++i) {
+    kernel_steps[i] = i;
+  }
+  return MemPlan(graph, kernel_steps);
+}
+
+size_t CPUSimpleMemPlan::MemPlan(const session::KernelGraph *graph, const std::vector<size_t> &kernel_steps) {
+  MS_EXCEPTION_IF_NULL(graph);
+  AnalyzeLiveness(graph, kernel_steps);
+  planned_graph_ = graph;
+  size_t naive_size = kReservedMemSize;
+  for (const auto &buffer : buffers_) {
+    naive_size += buffer.size;
+  }
+  // the offsets planned for the same buffers of the same graph are taken from the compile cache.
+  auto &compile_cache = CPUCompileCache::GetInstance();
+  auto graph_key = CPUCompileCache::GetGraphKey(*graph);
+  size_t planned_size = 0;
+  if (graph_key.empty() || !compile_cache.FindMemPlan(graph_key, &buffers_, &planned_size)) {
+    planned_size = AssignOffsets(&buffers_);
+    if (!graph_key.empty()) {
+      compile_cache.InsertMemPlan(graph_key, buffers_, planned_size);
+    }
+  }
+  size_t total_mem_size = planned_size + kReservedMemSize;
+  MS_LOG(INFO) << "CPU mem plan of graph " << graph->graph_id() << ": " << buffers_.size()
+               << " buffers, planned size: " << total_mem_size << ", size without reuse: " << naive_size;
+  return total_mem_size;
+}
+
+void CPUSimpleMemPlan::MemAssign(const session::KernelGraph *graph, uint8_t *base_ptr) {
+  MS_EXCEPTION_IF_NULL(graph);
+  MS_EXCEPTION_IF_NULL(base_ptr);
+  if (planned_graph_ != graph) {
+    (void)MemPlan(graph);
+  }
+  for (size_t i = 0; i < buffers_.size(); ++i) {
+    auto address = addresses_[i];
+    MS_EXCEPTION_IF_NULL(address);
+    if (address->ptr_ == nullptr) {
+      address->ptr_ = base_ptr + buffers_[i].offset;
     }
   }
+  planned_graph_ = nullptr;
+  buffers_.clear();
+  addresses_.clear();
+  buffer_index_.clear();
 }
 }  // namespace cpu
 }  // namespace device
@@ -16,6 +16,7 @@
 #ifndef MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_CPU_SIMPLE_MEM_PLAN_H_
 #define MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_CPU_SIMPLE_MEM_PLAN_H_
 
+#include <unordered_map>
 #include <vector>
 #include "backend/common/session/kernel_graph.h"
 #include "runtime/device/device_address.h"
@@ -23,13 +24,41 @@
 namespace mindspore {
 namespace device {
 namespace cpu {
+// A buffer of the graph memory, it is live from the first to the last step of the kernels using it.
+struct MemPlanBuffer {
+  size_t size{0};
+  size_t first_use{0};
+  size_t last_use{0};
+  size_t offset{0};
+};
+
 class CPUSimpleMemPlan {
  public:
   CPUSimpleMemPlan() = default;
   ~CPUSimpleMemPlan() = default;
 
+  // Return the memory size of the graph, the buffers which are not live at the same time share the memory.
   size_t MemPlan(const session::KernelGraph *graph);
+  // The same as above, but the kernel i of the execution order runs at kernel_steps[i] instead of the step i, and the
+  // kernels of the same step may run at the same time.
+  size_t MemPlan(const session::KernelGraph *graph, const std::vector<size_t> &kernel_steps);
   void MemAssign(const session::KernelGraph *graph, uint8_t *base_ptr);
+
+  // Assign the offsets of the buffers, so that the buffers live at the same time don't overlap, and return the size
+  // of the memory. The large buffers are placed first, each at the best fit gap between the placed buffers which are
+  // live at the same time.
+  static size_t AssignOffsets(std::vector<MemPlanBuffer> *buffers);
+
+ private:
+  // Collect the buffers of the addresses which are not allocated and their lifetimes.
+  void AnalyzeLiveness(const session::KernelGraph *graph, const std::vector<size_t> &kernel_steps);
+  void AddBufferUse(DeviceAddress *address, size_t step);
+
+  const session::KernelGraph *planned_graph_{nullptr};
+  std::vector<MemPlanBuffer> buffers_;
+  // the address of each buffer, in the same order as buffers_
+  std::vector<DeviceAddress *> addresses_;
+  std::unordered_map<DeviceAddress *, size_t> buffer_index_;
 };
 }  // namespace cpu
 }  // namespace device
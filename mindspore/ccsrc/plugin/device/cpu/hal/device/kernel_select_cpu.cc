@@ -353,6 +353,22 @@ KernelAttr FillNoneInKernelAttr(const CNodePtr &kernel_node, const std::vector<T
   }
   return result;
 }
+
+std::vector<KernelAttr> GetSupportedKernelAttrs(const std::string &op_name) {
+  auto kernel_attrs = kernel::NativeCpuKernelModFactory::GetInstance().GetSupportedKernelAttrList(op_name);
+  if (kernel_attrs.empty() || (kernel_attrs[0].GetInputSize() == 0 && kernel_attrs[0].GetOutputSize() == 0)) {
+    MS_LOG(DEBUG) << "Operator[" << op_name << "] will get ops attr info.";
+    auto op_info_ptr = mindspore::kernel::OpLib::FindOp(op_name, kernel::OpImplyType::kCPU);
+    if (op_info_ptr == nullptr) {
+      MS_LOG(EXCEPTION) << "Not find op[" << op_name << "] in cpu. For more details, "
+                        << "please refer to the list of supported cpu operations at https://www.mindspore.cn.";
+    }
+    kernel_attrs.clear();
+    kernel::NativeCpuKernelModFactory::GetInstance().SetKernelAttrs(op_info_ptr, &kernel_attrs);
+    kernel::NativeCpuKernelModFactory::GetInstance().UpdateKernelAttrs(op_name, kernel_attrs);
+  }
+  return kernel_attrs;
+}
 }  // namespace
 
 bool IsDynamicParamKernel(const std::string &op_name) {
@@ -450,19 +466,7 @@ void SetKernelInfo(const CNodePtr &kernel_node) {
   std::vector<TypeId> output_types;
   std::vector<TypeId> selected_output_types;
   MS_LOG(INFO) << "SetKernelInfo, CNode Name: " << op_name;
-  auto kernel_attrs = kernel::NativeCpuKernelModFactory::GetInstance().GetSupportedKernelAttrList(
-    common::AnfAlgo::GetCNodeName(kernel_node));
-  if (kernel_attrs.empty() || (kernel_attrs[0].GetInputSize() == 0 && kernel_attrs[0].GetOutputSize() == 0)) {
-    MS_LOG(DEBUG) << "Operator[" << op_name << "] will get ops attr info.";
-    auto op_info_ptr = mindspore::kernel::OpLib::FindOp(op_name, kernel::OpImplyType::kCPU);
-    if (op_info_ptr == nullptr) {
-      MS_LOG(EXCEPTION) << "Not find op[" << op_name << "] in cpu. For more details, "
-                        << "please refer to the list of supported cpu operations at https://www.mindspore.cn.";
-    }
-    kernel_attrs.clear();
-    kernel::NativeCpuKernelModFactory::GetInstance().SetKernelAttrs(op_info_ptr, &kernel_attrs);
-    kernel::NativeCpuKernelModFactory::GetInstance().UpdateKernelAttrs(op_name, kernel_attrs);
-  }
+  auto kernel_attrs = GetSupportedKernelAttrs(op_name);
   GetInputDtypes(kernel_node, &input_types, &input_not_cnode_indexes);
   GetOutputDtypes(kernel_node, &output_types);
   KernelAttr selected_kernel_attr;
@@ -490,6 +494,65 @@ void SetKernelInfo(const CNodePtr &kernel_node) {
   }
   SetKernelBuildInfo(input_formats, input_types, selected_output_formats, selected_output_types, kernel_node.get());
 }
+
+bool IsKernelBuildInfoCacheable(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  // The selection of these kernels registers the kernels or sets the attributes besides the kernel build info.
+  return !IsPrimitiveCNode(kernel_node, prim::kPrimCustom) &&
+         !IsDynamicParamKernel(common::AnfAlgo::GetCNodeName(kernel_node)) && !IsAKGSparseOP(kernel_node);
+}
+
+namespace {
+// Whether the type and the format of the kernel attr match the build info, the ones not set in the attr match any.
+bool IsDataTypeMatched(const DataType &attr, TypeId type, const std::string &format) {
+  return (attr.first == kMetaTypeNone || attr.first == type) && (attr.second.empty() || attr.second == format);
+}
+
+// Whether the build info is one of the supported kernel attrs, the attrs of the op may change with the version.
+bool IsSupportedBuildInfo(const CNodePtr &kernel_node, const kernel::KernelBuildInfoPtr &build_info,
+                          const std::vector<KernelAttr> &kernel_attrs) {
+  const auto &input_types = build_info->GetAllInputDeviceTypes();
+  const auto &input_formats = build_info->GetAllInputFormats();
+  const auto &output_types = build_info->GetAllOutputDeviceTypes();
+  const auto &output_formats = build_info->GetAllOutputFormats();
+  if (input_types.size() != input_formats.size() || output_types.size() != output_formats.size()) {
+    return false;
+  }
+  for (auto kernel_attr : kernel_attrs) {
+    if (kernel_attr.GetAllSame() && kernel_attr.GetInputSize() > 0) {
+      ExpandKernelAttr(kernel_node, &kernel_attr);
+    }
+    if (kernel_attr.GetInputSize() != input_types.size() || kernel_attr.GetOutputSize() != output_types.size()) {
+      continue;
+    }
+    bool matched = true;
+    for (size_t i = 0; i < input_types.size() && matched; ++i) {
+      matched = IsDataTypeMatched(kernel_attr.GetInputAttr(i), input_types[i], input_formats[i]);
+    }
+    for (size_t i = 0; i < output_types.size() && matched; ++i) {
+      matched = IsDataTypeMatched(kernel_attr.GetOutputAttr(i), output_types[i], output_formats[i]);
+    }
+    if (matched) {
+      return true;
+    }
+  }
+  return false;
+}
+}  // namespace
+
+bool SetCachedKernelInfo(const CNodePtr &kernel_node, const kernel::KernelBuildInfoPtr &build_info) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  MS_EXCEPTION_IF_NULL(build_info);
+  // Update the supported kernel attrs of the op as the selection does, the kernel mod gets them when initialized.
+  auto kernel_attrs = GetSupportedKernelAttrs(common::AnfAlgo::GetCNodeName(kernel_node));
+  if (!IsSupportedBuildInfo(kernel_node, build_info, kernel_attrs)) {
+    MS_LOG(INFO) << "The cached kernel build info of " << kernel_node->fullname_with_scope()
+                 << " is not supported anymore, select the kernel again.";
+    return false;
+  }
+  AnfAlgo::SetSelectKernelBuildInfo(build_info, kernel_node.get());
+  return true;
+}
 }  // namespace cpu
 }  // namespace device
 }  // namespace mindspore
@@ -24,6 +24,7 @@
 #include "ir/anf.h"
 #include "ir/dtype/type.h"
 #include "include/common/utils/utils.h"
+#include "kernel/kernel_build_info.h"
 
 namespace mindspore {
 namespace device {
@@ -33,6 +34,11 @@ using DataType = std::pair<TypeId, std::string>;
 void SetKernelInfo(const CNodePtr &apply_kernel_ptr);
 // Indicate whether the kernel input/output number are variable.
 bool IsDynamicParamKernel(const std::string &op_name);
+// Indicate whether the selected kernel build info is all the result of selecting the kernel.
+bool IsKernelBuildInfoCacheable(const CNodePtr &kernel_node);
+// Set the kernel build info selected for the same kernel before instead of selecting it, return false without setting
+// it if the build info is not one of the supported kernel attrs.
+bool SetCachedKernelInfo(const CNodePtr &kernel_node, const kernel::KernelBuildInfoPtr &build_info);
 
 class KernelAttr {
  public:
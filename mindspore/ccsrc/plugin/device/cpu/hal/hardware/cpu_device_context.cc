@@ -16,10 +16,14 @@
 
 #include "plugin/device/cpu/hal/hardware/cpu_device_context.h"
 #include <string>
+#include <set>
+#include <vector>
+#include "plugin/device/cpu/hal/device/cpu_compile_cache.h"
 #include "plugin/device/cpu/hal/device/cpu_device_address.h"
 #include "plugin/device/cpu/hal/device/cpu_memory_manager.h"
 #include "plugin/device/cpu/kernel/akg/akg_cpu_kernel_build.h"
 #include "plugin/device/cpu/kernel/cpu_kernel_factory.h"
+#include "plugin/device/cpu/kernel/parallel_search_cache.h"
 #include "kernel/kernel_build_info.h"
 #include "plugin/device/cpu/hal/device/kernel_select_cpu.h"
 #include "utils/trace_base.h"
@@ -68,6 +72,14 @@ void CPUDeviceContext::Initialize() {
 }
 
 void CPUDeviceContext::Destroy() {
+  // Keep the searched block sizes of the kernels for the next job.
+  kernel::ParallelSearchCache::GetInstance().Save();
+  CPUCompileCache::GetInstance().Save();
+  // The replayers free their memory to the memory manager.
+  {
+    std::lock_guard<std::mutex> lock(replayer_mutex_);
+    graph_replayers_.clear();
+  }
   // Release memory.
   if (mem_manager_ != nullptr) {
     mem_manager_->Finalize();
@@ -128,7 +140,7 @@ void CPUDeviceContext::OptimizeGraph(const KernelGraphPtr &graph) const {
   // Update Graph Dynamic Shape Attr.
   opt::AddDynamicShapeAttrPass(graph);
 
-  SetOperatorInfo(graph->execution_order());
+  SetOperatorInfoWithCache(graph);
   OptimizeGraphImpl(graph);
 
   // Run final optimization.
@@ -200,6 +212,34 @@ void CPUDeviceContext::SetOperatorInfo(const std::vector<CNodePtr> &nodes) const
   }
 }
 
+void CPUDeviceContext::SetOperatorInfoWithCache(const KernelGraphPtr &graph) const {
+  MS_EXCEPTION_IF_NULL(graph);
+  auto &compile_cache = CPUCompileCache::GetInstance();
+  if (!compile_cache.enabled()) {
+    SetOperatorInfo(graph->execution_order());
+    return;
+  }
+  const auto &nodes = graph->execution_order();
+  auto graph_key = CPUCompileCache::GraphKey(*graph);
+  graph->set_attr(kAttrCPUCompileCacheKey, MakeValue(graph_key));
+  std::vector<kernel::KernelBuildInfoPtr> build_infos;
+  if (compile_cache.FindKernelBuildInfos(graph_key, nodes, &build_infos)) {
+    MS_LOG(INFO) << "Use the cached kernel build info of the graph " << graph->graph_id() << ", key: " << graph_key;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+      if (build_infos[i] == nullptr || !SetCachedKernelInfo(nodes[i], build_infos[i])) {
+        SetOperatorInfo({nodes[i]});
+      }
+    }
+    return;
+  }
+  SetOperatorInfo(nodes);
+  std::vector<bool> cacheable;
+  for (const auto &node : nodes) {
+    cacheable.push_back(!common::AnfAlgo::IsControlOpExecInBackend(node) && IsKernelBuildInfoCacheable(node));
+  }
+  compile_cache.InsertKernelBuildInfos(graph_key, nodes, cacheable);
+}
+
 void CPUDeviceContext::CreateKernel(const std::vector<CNodePtr> &nodes) const {
   kernel::KernelMeta *bin_map = kernel::KernelMeta::GetInstance();
   MS_EXCEPTION_IF_NULL(bin_map);
@@ -249,12 +289,110 @@ void CPUDeviceContext::UpdateDynamicShape(const CNodePtr &kernel) const {
   cpu_kernel->InitOp();
 }
 
+namespace {
+// Whether the kernels of the graph can be replayed, the kernels which are run by the actors of their own can't be.
+bool CanReplayKernels(const KernelGraphPtr &graph) {
+  static const std::set<std::string> kActorKernels = {kGetNextOpName, kRpcSendOpName, kRpcRecvOpName};
+  for (const auto &kernel : graph->execution_order()) {
+    MS_EXCEPTION_IF_NULL(kernel);
+    if (common::AnfAlgo::IsControlOpExecInBackend(kernel) || common::AnfAlgo::IsDynamicShape(kernel) ||
+        kActorKernels.count(common::AnfAlgo::GetCNodeName(kernel)) > 0) {
+      MS_LOG(INFO) << "The graph " << graph->graph_id() << " is not replayed because of the kernel "
+                   << kernel->fullname_with_scope();
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace
+
 void CPUDeviceContext::PreprocessBeforeRunGraph(const KernelGraphPtr &graph) const {
   MS_EXCEPTION_IF_NULL(graph);
   // Remove reorder after PS feature finish adapting push/pull in auto_monad.
   auto execution_order = graph->execution_order();
   common::AnfAlgo::ReorderPosteriorExecList(NOT_NULL(&execution_order));
   graph->set_execution_order(execution_order);
+  // The kernels are checked after the optimization, which may add dynamic shape or control kernels.
+  if (graph->is_executing_sink() && (graph->is_dynamic_shape() || !CanReplayKernels(graph))) {
+    graph->set_is_executing_sink(false);
+  }
+}
+
+namespace {
+constexpr double kMBToByte = 1024.0 * 1024.0;
+
+// Get the memory limit of the offloaded graphs, 0 if the memory is not offloaded.
+size_t GetOffloadMemLimit() {
+  auto limit_env = common::GetEnv(kCPUOffloadMemLimitEnv);
+  if (limit_env.empty()) {
+    return 0;
+  }
+  double limit_mb = 0;
+  try {
+    limit_mb = std::stod(limit_env);
+  } catch (const std::exception &) {
+    MS_LOG(EXCEPTION) << "The value of " << kCPUOffloadMemLimitEnv << " should be a number in MB, but got "
+                      << limit_env;
+  }
+  if (limit_mb <= 0) {
+    MS_LOG(EXCEPTION) << "The value of " << kCPUOffloadMemLimitEnv << " should be positive, but got " << limit_env;
+  }
+  return static_cast<size_t>(limit_mb * kMBToByte);
+}
+}  // namespace
+
+bool CPUDeviceContext::IsExecutingSink(const KernelGraphPtr &graph) const {
+  MS_EXCEPTION_IF_NULL(graph);
+  // The graphs whose memory is offloaded are replayed too.
+  auto replay_mode = common::GetEnv(kCPUGraphReplayEnv);
+  if (replay_mode != "1" && replay_mode != "2" && common::GetEnv(kCPUOffloadMemLimitEnv).empty()) {
+    return false;
+  }
+  auto ms_context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(ms_context);
+  if (ms_context->get_param<int>(MS_CTX_EXECUTION_MODE) != kGraphMode || graph->is_dynamic_shape()) {
+    return false;
+  }
+#ifndef ENABLE_SECURITY
+  // The kernels of a replayed graph are not dumped one by one.
+  if (DumpJsonParser::GetInstance().e2e_dump_enabled()) {
+    return false;
+  }
+#endif
+  // The graph is checked before the optimization, its kernels are checked by PreprocessBeforeRunGraph.
+  return true;
+}
+
+bool CPUDeviceContext::LaunchGraph(const KernelGraphPtr &graph) const {
+  MS_EXCEPTION_IF_NULL(graph);
+  CPUGraphReplayer *replayer = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(replayer_mutex_);
+    auto &graph_replayer = graph_replayers_[graph->graph_id()];
+    if (graph_replayer == nullptr || graph_replayer->graph() != graph.get()) {
+      bool level_parallel = common::GetEnv(kCPUGraphReplayEnv) == "2";
+      std::shared_ptr<CPUOffloadMemHandler> offload_mem_handler = nullptr;
+      auto offload_mem_limit = GetOffloadMemLimit();
+      if (offload_mem_limit > 0) {
+        offload_mem_handler =
+          std::make_shared<CPUOffloadMemHandler>(offload_mem_limit, common::GetEnv(kCPUOffloadPathEnv));
+      }
+      graph_replayer = std::make_unique<CPUGraphReplayer>(graph, this, level_parallel, offload_mem_handler);
+    }
+    replayer = graph_replayer.get();
+  }
+  MS_EXCEPTION_IF_NULL(replayer);
+  return replayer->Launch();
+}
+
+void CPUDeviceContext::ReleaseGraph(const KernelGraphPtr &graph) const {
+  MS_EXCEPTION_IF_NULL(graph);
+  // The replayer frees its memory to the memory manager.
+  std::lock_guard<std::mutex> lock(replayer_mutex_);
+  auto iter = graph_replayers_.find(graph->graph_id());
+  if (iter != graph_replayers_.end() && iter->second != nullptr && iter->second->graph() == graph.get()) {
+    (void)graph_replayers_.erase(iter);
+  }
 }
 
 bool CPUDeviceContext::LaunchKernel(const CNodePtr &kernel, const std::vector<AddressPtr> &inputs,
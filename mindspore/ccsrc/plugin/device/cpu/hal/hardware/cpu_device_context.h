@@ -20,9 +20,11 @@
 #include <memory>
 #include <string>
 #include <mutex>
+#include <map>
 #include "runtime/hardware/device_context.h"
 #include "runtime/hardware/device_context_manager.h"
 #include "runtime/device/memory_manager.h"
+#include "plugin/device/cpu/hal/hardware/cpu_graph_replayer.h"
 
 namespace mindspore {
 namespace device {
@@ -56,6 +58,11 @@ class CPUDeviceContext : public DeviceContext {
 
   void PreprocessBeforeRunGraph(const KernelGraphPtr &graph) const override;
 
+  // The static shape graphs run by replaying their launch lists when MS_DEV_CPU_GRAPH_REPLAY is set.
+  bool IsExecutingSink(const KernelGraphPtr &graph) const override;
+  bool LaunchGraph(const KernelGraphPtr &graph) const override;
+  void ReleaseGraph(const KernelGraphPtr &graph) const override;
+
   bool LaunchKernel(const CNodePtr &kernel, const std::vector<AddressPtr> &inputs,
                     const std::vector<AddressPtr> &workspace, const std::vector<AddressPtr> &outputs,
                     bool is_dynamic_shape = false) const override;
@@ -66,6 +73,8 @@ class CPUDeviceContext : public DeviceContext {
   DISABLE_COPY_AND_ASSIGN(CPUDeviceContext);
 
   void OptimizeGraphImpl(const KernelGraphPtr &graph) const;
+  // Set the kernel build info selected by the last job for the same graph when the compile cache is enabled.
+  void SetOperatorInfoWithCache(const KernelGraphPtr &graph) const;
 #ifndef ENABLE_SECURITY
   // Launch a kernel and record the elapsed time end to end.
   bool LaunchKernelWithProfiling(const CNodePtr &kernel, const std::vector<AddressPtr> &inputs,
@@ -77,6 +86,9 @@ class CPUDeviceContext : public DeviceContext {
                       const std::vector<AddressPtr> &workspace, const std::vector<AddressPtr> &outputs) const;
 
   mutable std::mutex launch_mutex_;
+  // The replayers of the graphs executing sink, keyed by the graph id.
+  mutable std::mutex replayer_mutex_;
+  mutable std::map<uint32_t, CPUGraphReplayerPtr> graph_replayers_;
   std::shared_ptr<MemoryManager> mem_manager_;
   bool initialized_;
 };
@@ -0,0 +1,409 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "plugin/device/cpu/hal/hardware/cpu_graph_replayer.h"
+#include <algorithm>
+#include <map>
+#include "plugin/device/cpu/hal/device/cpu_simple_mem_plan.h"
+#include "backend/common/session/anf_runtime_algorithm.h"
+#include "include/common/utils/anfalgo.h"
+#include "include/common/thread_pool.h"
+#include "runtime/device/kernel_info.h"
+#include "utils/flags.h"
+#include "utils/ms_exception.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+// The kernels which can't run at the same time with the kernels before or after them in the execution order: the
+// kernels writing the parameters or their inputs in place, and the ones which must keep the order themselves.
+bool HasSideEffect(const CNodePtr &kernel, const session::KernelGraph *graph) {
+  MS_EXCEPTION_IF_NULL(kernel);
+  MS_EXCEPTION_IF_NULL(graph);
+  auto prim = common::AnfAlgo::GetCNodePrimitive(kernel);
+  if (prim != nullptr && (GetPrimitiveFlag(prim, GRAPH_FLAG_SIDE_EFFECT_MEM) ||
+                          GetPrimitiveFlag(prim, GRAPH_FLAG_SIDE_EFFECT_IO) ||
+                          GetPrimitiveFlag(prim, GRAPH_FLAG_SIDE_EFFECT_HIDDEN))) {
+    return true;
+  }
+  if (common::AnfAlgo::IsCommunicationOp(kernel) ||
+      kOpNotSupportMultiThreadExecList.count(common::AnfAlgo::GetCNodeName(kernel)) > 0) {
+    return true;
+  }
+  size_t output_num = common::AnfAlgo::GetOutputTensorNum(kernel);
+  for (size_t i = 0; i < output_num; ++i) {
+    if (graph->IsInRefOutputMap(std::make_pair(kernel, i))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+AddressPtr CreateLaunchAddress(const DeviceAddressPtr &device_address) {
+  MS_EXCEPTION_IF_NULL(device_address);
+  return std::make_shared<kernel::Address>(device_address->GetMutablePtr(), device_address->GetSize());
+}
+
+void UpdateLaunchAddress(const session::KernelWithIndex &node_with_index, const AddressPtr &address) {
+  MS_EXCEPTION_IF_NULL(address);
+  auto device_address = AnfAlgo::GetMutableOutputAddr(node_with_index.first, node_with_index.second, false);
+  MS_EXCEPTION_IF_NULL(device_address);
+  address->addr = device_address->GetMutablePtr();
+  address->size = device_address->GetSize();
+}
+}  // namespace
+
+CPUGraphReplayer::CPUGraphReplayer(const KernelGraphPtr &graph, const DeviceContext *device_context,
+                                   bool level_parallel,
+                                   const std::shared_ptr<CPUOffloadMemHandler> &offload_mem_handler)
+    : graph_(graph.get()),
+      device_context_(device_context),
+      level_parallel_(level_parallel),
+      offload_mem_handler_(offload_mem_handler) {
+  MS_EXCEPTION_IF_NULL(graph_);
+  MS_EXCEPTION_IF_NULL(device_context_);
+  if (offload_mem_handler_ != nullptr && level_parallel_) {
+    MS_LOG(WARNING) << "The kernels of graph " << graph_->graph_id()
+                    << " are launched one by one, because the memory is offloaded.";
+    level_parallel_ = false;
+  }
+}
+
+CPUGraphReplayer::~CPUGraphReplayer() {
+  if (mem_scheduler_ != nullptr) {
+    mem_scheduler_->ClearAllocatedMem();
+  }
+  if (static_memory_ != nullptr) {
+    device_context_->FreeMemory(static_memory_);
+    static_memory_ = nullptr;
+  }
+  for (auto ptr : kept_memory_) {
+    device_context_->FreeMemory(ptr);
+  }
+  kept_memory_.clear();
+}
+
+std::vector<size_t> CPUGraphReplayer::ComputeLevels(const std::vector<std::vector<size_t>> &inputs,
+                                                    const std::vector<bool> &has_side_effect) {
+  if (inputs.size() != has_side_effect.size()) {
+    MS_LOG(EXCEPTION) << "The inputs size " << inputs.size() << " is not equal to the side effect flags size "
+                      << has_side_effect.size();
+  }
+  std::vector<size_t> levels(inputs.size(), 0);
+  // the kernels after a kernel with side effects are in the levels after it.
+  size_t min_level = 0;
+  size_t max_level = 0;
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    size_t level = min_level;
+    for (auto input : inputs[i]) {
+      if (input >= i) {
+        MS_LOG(EXCEPTION) << "The input " << input << " of kernel " << i << " is not before it.";
+      }
+      level = std::max(level, levels[input] + 1);
+    }
+    if (has_side_effect[i]) {
+      if (i > 0) {
+        level = std::max(level, max_level + 1);
+      }
+      min_level = level + 1;
+    }
+    levels[i] = level;
+    max_level = std::max(max_level, level);
+  }
+  return levels;
+}
+
+void CPUGraphReplayer::Build() {
+  const auto &kernels = graph_->execution_order();
+  std::vector<size_t> levels(kernels.size());
+  if (level_parallel_) {
+    std::map<AnfNode *, size_t> kernel_indexes;
+    std::vector<std::vector<size_t>> inputs(kernels.size());
+    std::vector<bool> has_side_effect(kernels.size());
+    for (size_t i = 0; i < kernels.size(); ++i) {
+      const auto &kernel = kernels[i];
+      MS_EXCEPTION_IF_NULL(kernel);
+      size_t input_num = common::AnfAlgo::GetInputTensorNum(kernel);
+      for (size_t j = 0; j < input_num; ++j) {
+        auto input_node = common::AnfAlgo::GetPrevNodeOutput(kernel, j, false).first;
+        auto iter = kernel_indexes.find(input_node.get());
+        if (iter != kernel_indexes.end()) {
+          (void)inputs[i].emplace_back(iter->second);
+        }
+      }
+      has_side_effect[i] = HasSideEffect(kernel, graph_);
+      kernel_indexes[kernel.get()] = i;
+    }
+    levels = ComputeLevels(inputs, has_side_effect);
+  } else {
+    for (size_t i = 0; i < levels.size(); ++i) {
+      levels[i] = i;
+    }
+  }
+  if (offload_mem_handler_ != nullptr) {
+    AllocateKeptMemory();
+  } else {
+    AllocateStaticMemory(kernels, levels);
+  }
+
+  std::vector<size_t> order(kernels.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(),
+                   [&levels](size_t lhs, size_t rhs) { return levels[lhs] < levels[rhs]; });
+  launch_list_.clear();
+  level_begins_.clear();
+  size_t current_level = 0;
+  for (auto index : order) {
+    const auto &kernel = kernels[index];
+    // The in place kernels marked skip share the memory of their inputs and are not launched.
+    if (common::AnfAlgo::IsInplaceNode(kernel, "skip")) {
+      continue;
+    }
+    if (launch_list_.empty() || levels[index] != current_level) {
+      current_level = levels[index];
+      (void)level_begins_.emplace_back(launch_list_.size());
+    }
+    LaunchItem item;
+    item.kernel = kernel;
+    size_t input_num = common::AnfAlgo::GetInputTensorNum(kernel);
+    for (size_t i = 0; i < input_num; ++i) {
+      auto input_node_with_index = common::AnfAlgo::GetPrevNodeOutput(kernel, i, false);
+      MS_EXCEPTION_IF_NULL(input_node_with_index.first);
+      auto device_address =
+        AnfAlgo::GetMutableOutputAddr(input_node_with_index.first, input_node_with_index.second, false);
+      (void)item.inputs.emplace_back(CreateLaunchAddress(device_address));
+      if (input_node_with_index.first->isa<Parameter>()) {
+        (void)item.parameter_inputs.emplace_back(i, input_node_with_index);
+      } else {
+        AddOffloadAddress(device_address, item.inputs.back(), &item);
+      }
+    }
+    auto kernel_info = dynamic_cast<KernelInfo *>(kernel->kernel_info());
+    MS_EXCEPTION_IF_NULL(kernel_info);
+    const auto &output_addresses = kernel_info->output_address_list();
+    for (size_t i = 0; i < output_addresses.size(); ++i) {
+      (void)item.outputs.emplace_back(CreateLaunchAddress(output_addresses[i]));
+      session::AnfWithOutIndex out_pair(kernel, i);
+      if (graph_->IsInRefOutputMap(out_pair)) {
+        auto origin_pair = graph_->GetRefCorrespondOutput(out_pair);
+        MS_EXCEPTION_IF_NULL(origin_pair.first);
+        if (origin_pair.first->isa<Parameter>()) {
+          (void)item.parameter_outputs.emplace_back(i, origin_pair);
+          continue;
+        }
+      }
+      AddOffloadAddress(output_addresses[i], item.outputs.back(), &item);
+    }
+    for (const auto &workspace_address : kernel_info->workspace_address_list()) {
+      (void)item.workspaces.emplace_back(CreateLaunchAddress(workspace_address));
+      AddOffloadAddress(workspace_address, item.workspaces.back(), &item);
+    }
+    (void)launch_list_.emplace_back(std::move(item));
+  }
+  (void)level_begins_.emplace_back(launch_list_.size());
+  if (offload_mem_handler_ != nullptr) {
+    BuildMemScheduler();
+  }
+  built_ = true;
+  MS_LOG(INFO) << "Build the replayer of graph " << graph_->graph_id() << ", kernel num: " << launch_list_.size()
+               << ", level num: " << (level_begins_.size() - 1) << ", level parallel: " << level_parallel_;
+}
+
+void CPUGraphReplayer::AllocateStaticMemory(const std::vector<CNodePtr> &kernels, const std::vector<size_t> &levels) {
+  CPUSimpleMemPlan mem_plan;
+  size_t mem_size = mem_plan.MemPlan(graph_, levels);
+  static_memory_ = device_context_->AllocateMemory(mem_size);
+  if (static_memory_ == nullptr) {
+    MS_LOG(EXCEPTION) << "Allocate the memory of graph " << graph_->graph_id() << " failed, size: " << mem_size;
+  }
+  auto base_ptr = reinterpret_cast<uint8_t *>(static_memory_);
+  mem_plan.MemAssign(graph_, base_ptr);
+
+  // The output actor copies the graph outputs of the persisted addresses instead of taking their memory away.
+  auto is_planned = [base_ptr, mem_size](const DeviceAddressPtr &address) {
+    auto ptr = reinterpret_cast<uint8_t *>(address->GetMutablePtr());
+    return ptr >= base_ptr && ptr < base_ptr + mem_size;
+  };
+  for (const auto &kernel : kernels) {
+    auto kernel_info = dynamic_cast<KernelInfo *>(kernel->kernel_info());
+    MS_EXCEPTION_IF_NULL(kernel_info);
+    for (const auto &address : kernel_info->output_address_list()) {
+      MS_EXCEPTION_IF_NULL(address);
+      if (is_planned(address)) {
+        address->set_is_ptr_persisted(true);
+      }
+    }
+    for (const auto &address : kernel_info->workspace_address_list()) {
+      MS_EXCEPTION_IF_NULL(address);
+      if (is_planned(address)) {
+        address->set_is_ptr_persisted(true);
+      }
+    }
+  }
+}
+
+void CPUGraphReplayer::AllocateKeptMemory() {
+  std::vector<session::KernelWithIndex> keep_alive;
+  if (graph_->output() != nullptr) {
+    keep_alive = common::AnfAlgo::GetAllOutputWithIndex(graph_->output());
+  }
+  for (const auto &summary : graph_->summary_nodes()) {
+    (void)keep_alive.emplace_back(summary.second.first, IntToSize(summary.second.second));
+  }
+  for (const auto &output : keep_alive) {
+    MS_EXCEPTION_IF_NULL(output.first);
+    if (!output.first->isa<CNode>() || !AnfAlgo::OutputAddrExist(output.first, output.second, true)) {
+      continue;
+    }
+    auto address = AnfAlgo::GetMutableOutputAddr(output.first, output.second, true);
+    MS_EXCEPTION_IF_NULL(address);
+    if (address->GetPtr() != nullptr) {
+      continue;
+    }
+    auto ptr = device_context_->AllocateMemory(address->GetSize());
+    if (ptr == nullptr) {
+      MS_LOG(EXCEPTION) << "Allocate the memory of the output of graph " << graph_->graph_id()
+                        << " failed, size: " << address->GetSize();
+    }
+    (void)kept_memory_.emplace_back(ptr);
+    address->set_ptr(ptr);
+    address->set_is_ptr_persisted(true);
+  }
+}
+
+void CPUGraphReplayer::AddOffloadAddress(const DeviceAddressPtr &device_address, const AddressPtr &launch_address,
+                                         LaunchItem *item) const {
+  MS_EXCEPTION_IF_NULL(device_address);
+  MS_EXCEPTION_IF_NULL(item);
+  if (offload_mem_handler_ == nullptr || device_address->GetPtr() != nullptr) {
+    return;
+  }
+  (void)item->offload_addresses.emplace_back(launch_address, device_address.get());
+}
+
+void CPUGraphReplayer::BuildMemScheduler() {
+  mem_scheduler_ = std::make_shared<MemScheduler>();
+  mem_scheduler_->SetMemHandler(offload_mem_handler_);
+  mem_scheduler_->SetTotalStep(launch_list_.size());
+  // Record the uses of the memory in the launch list, the memory scheduler plans the swaps by the events.
+  for (const auto &item : launch_list_) {
+    for (const auto &address : item.offload_addresses) {
+      (void)mem_scheduler_->GetOrMalloc(address.second, address.second->GetSize());
+    }
+    (void)mem_scheduler_->PostCompute(nullptr);
+  }
+  mem_scheduler_->set_need_record_event(false);
+  if (!mem_scheduler_->Optimize()) {
+    MS_LOG(EXCEPTION) << "Can't run graph " << graph_->graph_id() << " within the memory limit "
+                      << offload_mem_handler_->GetAvailableMemSize() << ", please increase "
+                      << kCPUOffloadMemLimitEnv << ".";
+  }
+}
+
+bool CPUGraphReplayer::LaunchWithOffload() {
+  MS_EXCEPTION_IF_NULL(mem_scheduler_);
+  // The CPU has no stream, the memory handler is passed as the stream to tell the launch from the mock.
+  void *stream = offload_mem_handler_.get();
+  mem_scheduler_->Reset();
+  mem_scheduler_->Update();
+  for (auto &item : launch_list_) {
+    if (!mem_scheduler_->PreCompute(stream)) {
+      MS_LOG(ERROR) << "Prepare the memory of kernel " << item.kernel->fullname_with_scope() << " failed.";
+      return false;
+    }
+    for (auto &address : item.offload_addresses) {
+      address.first->addr = mem_scheduler_->GetOrMalloc(address.second, address.second->GetSize());
+      if (address.first->addr == nullptr) {
+        MS_LOG(ERROR) << "Get the memory of kernel " << item.kernel->fullname_with_scope() << " failed.";
+        return false;
+      }
+    }
+    if (!LaunchKernel(&item)) {
+      return false;
+    }
+    if (!mem_scheduler_->PostCompute(stream)) {
+      MS_LOG(ERROR) << "Release the memory of kernel " << item.kernel->fullname_with_scope() << " failed.";
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CPUGraphReplayer::Launch() {
+  if (!built_) {
+    Build();
+  }
+  // The addresses of the parameters may be replaced by the data prepare actor in each step.
+  for (auto &item : launch_list_) {
+    for (const auto &input : item.parameter_inputs) {
+      UpdateLaunchAddress(input.second, item.inputs[input.first]);
+    }
+    for (const auto &output : item.parameter_outputs) {
+      UpdateLaunchAddress(output.second, item.outputs[output.first]);
+    }
+  }
+  if (mem_scheduler_ != nullptr) {
+    return LaunchWithOffload();
+  }
+  if (!level_parallel_) {
+    return LaunchKernels(0, launch_list_.size());
+  }
+
+  auto &thread_pool = common::ThreadPool::GetInstance();
+  for (size_t level = 0; level + 1 < level_begins_.size(); ++level) {
+    size_t begin = level_begins_[level];
+    size_t end = level_begins_[level + 1];
+    if (end - begin == 1) {
+      if (!LaunchKernel(&launch_list_[begin])) {
+        return false;
+      }
+      continue;
+    }
+    auto task = [this, begin](size_t start, size_t stop) {
+      return LaunchKernels(begin + start, begin + stop) ? common::SUCCESS : common::FAIL;
+    };
+    if (!thread_pool.ParallelFor(end - begin, 1, task)) {
+      MsException::Instance().CheckException();
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CPUGraphReplayer::LaunchKernels(size_t begin, size_t end) {
+  for (size_t i = begin; i < end; ++i) {
+    if (!LaunchKernel(&launch_list_[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CPUGraphReplayer::LaunchKernel(LaunchItem *item) const {
+  MS_EXCEPTION_IF_NULL(item);
+  if (!device_context_->LaunchKernel(item->kernel, item->inputs, item->workspaces, item->outputs)) {
+    MS_LOG(ERROR) << "Launch kernel failed: " << item->kernel->fullname_with_scope() << " of graph "
+                  << graph_->graph_id();
+    return false;
+  }
+  return true;
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,103 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_HAL_HARDWARE_CPU_GRAPH_REPLAYER_H_
+#define MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_HAL_HARDWARE_CPU_GRAPH_REPLAYER_H_
+
+#include <memory>
+#include <utility>
+#include <vector>
+#include "backend/common/session/kernel_graph.h"
+#include "kernel/kernel.h"
+#include "plugin/device/cpu/hal/device/cpu_offload_mem_handler.h"
+#include "runtime/device/memory_scheduler.h"
+#include "runtime/hardware/device_context.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+// The environment variable to run the static shape graphs by replaying: "1" launches the kernels one by one in the
+// execution order, "2" launches the kernels of the same level in parallel.
+constexpr char kCPUGraphReplayEnv[] = "MS_DEV_CPU_GRAPH_REPLAY";
+
+// Runs a static shape graph without the kernel actors. At the first launch the kernels are put into a launch list and
+// the memory of their outputs and workspaces is planned and allocated as a whole, then each launch replays the list.
+// The memory is kept by the replayer, so the output and workspace addresses stay the same in all the steps, only the
+// addresses of the graph parameters are fetched again before each launch.
+// With an offload memory handler, only the graph outputs get the memory of their own. The other outputs and the
+// workspaces are managed by a memory scheduler within the memory limit of the handler, the scheduler records their
+// uses in the launch list at the first launch and swaps the cold ones out to the offload tier, the kernels are
+// launched one by one in this mode.
+class CPUGraphReplayer {
+ public:
+  CPUGraphReplayer(const KernelGraphPtr &graph, const DeviceContext *device_context, bool level_parallel,
+                   const std::shared_ptr<CPUOffloadMemHandler> &offload_mem_handler = nullptr);
+  ~CPUGraphReplayer();
+
+  bool Launch();
+  const session::KernelGraph *graph() const { return graph_; }
+
+  // Get the level of each kernel, a kernel launches after all the kernels of the lower levels. The level of a kernel
+  // is higher than its inputs, and a kernel which has side effects is in a level higher than all the kernels before
+  // it in the execution order and lower than all the kernels after it. The inputs[i] are the kernels producing the
+  // inputs of the kernel i, and they are before the kernel i.
+  static std::vector<size_t> ComputeLevels(const std::vector<std::vector<size_t>> &inputs,
+                                           const std::vector<bool> &has_side_effect);
+
+ private:
+  struct LaunchItem {
+    CNodePtr kernel;
+    std::vector<AddressPtr> inputs;
+    std::vector<AddressPtr> workspaces;
+    std::vector<AddressPtr> outputs;
+    // the indexes in inputs and outputs whose device addresses belong to the graph parameters, with the parameters.
+    std::vector<std::pair<size_t, session::KernelWithIndex>> parameter_inputs;
+    std::vector<std::pair<size_t, session::KernelWithIndex>> parameter_outputs;
+    // the launch addresses whose memory is got from the memory scheduler, with the device addresses as the keys.
+    std::vector<std::pair<AddressPtr, const DeviceAddress *>> offload_addresses;
+  };
+
+  void Build();
+  // Plan the memory of the addresses which are not allocated, the steps are the levels using the addresses.
+  void AllocateStaticMemory(const std::vector<CNodePtr> &kernels, const std::vector<size_t> &levels);
+  // Allocate the memory of the graph outputs and the summary tensors which are read after the graph runs.
+  void AllocateKeptMemory();
+  void AddOffloadAddress(const DeviceAddressPtr &device_address, const AddressPtr &launch_address,
+                         LaunchItem *item) const;
+  void BuildMemScheduler();
+  bool LaunchWithOffload();
+  bool LaunchKernels(size_t begin, size_t end);
+  bool LaunchKernel(LaunchItem *item) const;
+
+  const session::KernelGraph *graph_;
+  const DeviceContext *device_context_;
+  bool level_parallel_;
+  bool built_{false};
+
+  std::vector<LaunchItem> launch_list_;
+  // the launch list is sorted by levels, the items of level i are in [level_begins_[i], level_begins_[i + 1]).
+  std::vector<size_t> level_begins_;
+  void *static_memory_{nullptr};
+
+  std::shared_ptr<CPUOffloadMemHandler> offload_mem_handler_;
+  std::shared_ptr<MemScheduler> mem_scheduler_{nullptr};
+  std::vector<void *> kept_memory_;
+};
+using CPUGraphReplayerPtr = std::unique_ptr<CPUGraphReplayer>;
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_HAL_HARDWARE_CPU_GRAPH_REPLAYER_H_
@@ -15,6 +15,7 @@
  */
 
 #include "plugin/device/cpu/hal/hardware/cpu_memory_pool.h"
+#include <cstdlib>
 #include <string>
 #include "utils/log_adapter.h"
 #include "utils/convert_utils_base.h"
@@ -24,7 +25,12 @@ namespace device {
 namespace cpu {
 namespace {
 const size_t kKBToByte = 1024;
+const size_t kMBToByte = kKBToByte * kKBToByte;
 const size_t kLineMaxSize = 1024;
+// The max size of the size class memory cache in MB, which is set by MS_DEV_CPU_SIZE_CLASS_MEM_CACHE_SIZE, and 0
+// disables the cache.
+const char kSizeClassMemCacheSizeEnv[] = "MS_DEV_CPU_SIZE_CLASS_MEM_CACHE_SIZE";
+const size_t kDefaultSizeClassMemCacheSizeMB = 1024;
 
 size_t GetSystemMemorySize(const std::string &key) {
 #if defined(_WIN32) || defined(_WIN64) || defined(__APPLE__)
@@ -62,8 +68,31 @@ size_t GetSystemMemorySize(const std::string &key) {
   return mem_size * kKBToByte;
 #endif
 }
+
+size_t GetSizeClassMemCacheMaxSize() {
+  auto env = common::GetEnv(kSizeClassMemCacheSizeEnv);
+  if (env.empty()) {
+    return kDefaultSizeClassMemCacheSizeMB * kMBToByte;
+  }
+  char *end = nullptr;
+  auto size_mb = std::strtoull(env.c_str(), &end, 10);
+  if (end == env.c_str() || *end != '\0' || size_mb > SIZE_MAX / kMBToByte) {
+    MS_LOG(WARNING) << "The " << kSizeClassMemCacheSizeEnv << " " << env << " is not a valid size in MB, use the default "
+                    << kDefaultSizeClassMemCacheSizeMB << " MB.";
+    return kDefaultSizeClassMemCacheSizeMB * kMBToByte;
+  }
+  return static_cast<size_t>(size_mb) * kMBToByte;
+}
 }  // namespace
 
+CPUMemoryPool::CPUMemoryPool() {
+  // The many small kernels on CPU allocate and free memory concurrently from the actor threads.
+  auto max_cache_mem_size = GetSizeClassMemCacheMaxSize();
+  if (max_cache_mem_size != 0) {
+    EnableSizeClassMemCache(max_cache_mem_size);
+  }
+}
+
 size_t CPUMemoryPool::AllocDeviceMem(size_t alloc_size, DeviceMemPtr *addr) {
   if (alloc_size == 0) {
     MS_LOG(EXCEPTION) << "The memory alloc size is 0.";
@@ -21,6 +21,7 @@
 #include <memory>
 #include <vector>
 
+#include "base/bfloat16.h"
 #include "plugin/device/cpu/kernel/cpu_kernel.h"
 #include "plugin/device/cpu/kernel/cpu_kernel_factory.h"
 
@@ -198,6 +199,9 @@ MS_REG_CPU_KERNEL_T_S(Cast, KernelAttr(), CastCpuKernelMod, bool, float);
 MS_REG_CPU_KERNEL_T_S(Cast, KernelAttr(), CastCpuKernelMod, bool, double);
 MS_REG_CPU_KERNEL_T_S(Cast, KernelAttr(), CastCpuKernelMod, bool, bool);
 
+MS_REG_CPU_KERNEL_T_S(Cast, KernelAttr(), CastCpuKernelMod, float, bfloat16);
+MS_REG_CPU_KERNEL_T_S(Cast, KernelAttr(), CastCpuKernelMod, bfloat16, float);
+
 }  // namespace kernel
 }  // namespace mindspore
 
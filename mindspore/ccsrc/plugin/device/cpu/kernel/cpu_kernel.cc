@@ -17,14 +17,40 @@
 #include "plugin/device/cpu/kernel/cpu_kernel.h"
 
 #include <algorithm>
+#include <mutex>
 #include <utility>
 #include <cmath>
+#include <sstream>
 
 #include "utils/profile.h"
+#include "utils/ms_exception.h"
 #include "runtime/graph_scheduler/actor/actor_common.h"
+#include "plugin/device/cpu/kernel/parallel_search_cache.h"
 
 namespace mindspore {
 namespace kernel {
+namespace {
+constexpr size_t kMaxSearchPow = 6;
+constexpr size_t kSearchAvgCount = 5;
+
+std::string GetParallelSearchKey(const CNodePtr &kernel_node) {
+  std::ostringstream buf;
+  buf << common::AnfAlgo::GetCNodeName(kernel_node);
+  size_t input_num = common::AnfAlgo::GetInputTensorNum(kernel_node);
+  for (size_t i = 0; i < input_num; ++i) {
+    buf << "_" << TypeIdLabel(AnfAlgo::GetInputDeviceDataType(kernel_node, i)) << ":"
+        << AnfAlgo::GetInputDeviceShape(kernel_node, i);
+  }
+  buf << "->";
+  size_t output_num = common::AnfAlgo::GetOutputTensorNum(kernel_node);
+  for (size_t i = 0; i < output_num; ++i) {
+    buf << "_" << TypeIdLabel(AnfAlgo::GetOutputDeviceDataType(kernel_node, i)) << ":"
+        << AnfAlgo::GetOutputDeviceShape(kernel_node, i);
+  }
+  return buf.str();
+}
+}  // namespace
+
 void NativeCpuKernelMod::InferOp() {
   if (common::AnfAlgo::IsDynamicShape(cnode_ptr_.lock())) {
     anf_node_ = cnode_ptr_.lock();
@@ -80,6 +106,12 @@ void NativeCpuKernelMod::Init(const CNodePtr &kernel_node) {
 
   InitKernel(kernel_node);
   InitInputOutputSize(kernel_node);
+  // the shapes of a dynamic shape kernel change on each init, the block size is searched again for the new shapes.
+  auto search_key = GetParallelSearchKey(kernel_node);
+  if (search_key != parallel_search_info_.kernel_key) {
+    parallel_search_info_ = ParallelSearchInfo();
+    parallel_search_info_.kernel_key = search_key;
+  }
 }
 
 void CPUKernelUtils::ExpandDimsTo4(std::vector<size_t> *shape) {
@@ -122,121 +154,82 @@ void CPUKernelUtils::GetElementNumEveryDim(const std::vector<size_t> &shape, std
 }
 
 void CPUKernelUtils::ParallelFor(const CTask &task, size_t count, float block_size) {
-  auto max_thread_num = common::ThreadPool::GetInstance().GetSyncRunThreadNum();
-  size_t thread_num = count < block_size * max_thread_num ? std::ceil(count / block_size) : max_thread_num;
-  std::vector<common::Task> tasks;
-  size_t start = 0;
-  size_t once_compute_size = (count + thread_num - 1) / thread_num;
-  while (start < count) {
-    size_t end = (start + once_compute_size) > count ? count : (start + once_compute_size);
-    auto block = [&, start, end]() {
-      task(start, end);
-      return common::SUCCESS;
-    };
-    (void)tasks.emplace_back(block);
-    start += once_compute_size;
-  }
-  (void)common::ThreadPool::GetInstance().SyncRun(tasks);
+  ParallelLaunch(task, count, block_size);
 }
 
-// Search for best block_size to get best thread num : 1 2 4 8 16 23(32)
-// Each block_size runs 5 times to get an average cpu kernel cost time.
-// If the speed of block_size[i] is slower than block_size[i-2], than we
-// assume that  block_size[i-2] is the best block_size.
 void CPUKernelUtils::ParallelForAutoSearch(const CTask &task, size_t count, ParallelSearchInfo *parallel_search_info) {
-  const size_t MAX_POW = 6;
-  const size_t AVG_COUNT = 5;
-  MS_EXCEPTION_IF_NULL(parallel_search_info);
-  size_t current_pow = parallel_search_info->search_count / AVG_COUNT;
-  if (current_pow < MAX_POW) {
-    if (parallel_search_info->search_count % AVG_COUNT == 0) {
-      parallel_search_info->tmp_sum_cost_time = 0;
-    }
-    float block_size = static_cast<float>(count) / std::pow(2.0f, current_pow);
-    double start_time = GetTime();
-    ParallelFor(task, count, block_size);
-    double cost_time = GetTime() - start_time;
-    parallel_search_info->tmp_sum_cost_time += cost_time;
-    parallel_search_info->search_count++;
-    if (parallel_search_info->search_count % AVG_COUNT == 0) {
-      double avg_time = parallel_search_info->tmp_sum_cost_time / AVG_COUNT;
-      if (parallel_search_info->min_cost_time > avg_time) {
-        parallel_search_info->min_cost_time = avg_time;
-        parallel_search_info->best_block_size = block_size;
-        parallel_search_info->best_pow = current_pow;
-      } else if (current_pow - parallel_search_info->best_pow >= 2) {
-        parallel_search_info->search_count = AVG_COUNT * MAX_POW;
-      }
-    }
-  } else {
-    ParallelFor(task, count, parallel_search_info->best_block_size);
-  }
+  ParallelLaunchAutoSearch(task, count, nullptr, parallel_search_info);
 }
 
-ActorThreadPool *GetActorMgrInnerThreadPool() {
-  auto actor_manager = ActorMgr::GetActorMgrRef();
-  MS_EXCEPTION_IF_NULL(actor_manager);
-  auto thread_pool = actor_manager->GetActorThreadPool();
-  // Init thread_pool if env is windows or ascend, in case that it won't be init in graph_scheduler.
-  if (thread_pool == nullptr) {
+common::ThreadPool &GetKernelThreadPool() {
+  // The graph scheduler gives the kernel threads to the common thread pool, size it here if env is windows or ascend,
+  // in case that the graph scheduler is not initialized.
+  static std::once_flag init_flag;
+  std::call_once(init_flag, []() {
+    auto actor_manager = ActorMgr::GetActorMgrRef();
+    MS_EXCEPTION_IF_NULL(actor_manager);
+    if (actor_manager->GetActorThreadPool() != nullptr) {
+      return;
+    }
     size_t actor_thread_num = 0;
     size_t actor_and_kernel_thread_num = 0;
     runtime::ComputeThreadNums(&actor_thread_num, &actor_and_kernel_thread_num);
-    (void)actor_manager->Initialize(true, actor_thread_num, actor_and_kernel_thread_num);
-    thread_pool = actor_manager->GetActorThreadPool();
-    MS_EXCEPTION_IF_NULL(thread_pool);
-  }
-  return thread_pool;
+    common::ThreadPool::GetInstance().SetMaxThreadNum(actor_and_kernel_thread_num - actor_thread_num);
+  });
+  return common::ThreadPool::GetInstance();
 }
 
-// Use threadpool of mindrt
+// The blocks are claimed by the threads of the common pool one by one, the current thread joins in, so a kernel
+// launched from inside a parallel task runs nested on the idle threads instead of serializing.
 void ParallelLaunch(const CTask &task, size_t count, float block_size, Content content) {
   if (count == 0) {
     return;
   }
-  auto thread_pool = GetActorMgrInnerThreadPool();
-  size_t kernel_thread_num = thread_pool->GetKernelThreadNum();
-  if (kernel_thread_num == 0) {
-    MS_LOG(EXCEPTION) << "Actor inner pool has been init, but kernel thread is 0!";
-  }
-
+  auto &thread_pool = GetKernelThreadPool();
+  size_t kernel_thread_num = thread_pool.GetSyncRunThreadNum();
   size_t thread_num = count < block_size * kernel_thread_num ? std::ceil(count / block_size) : kernel_thread_num;
   size_t once_compute_size = (count + thread_num - 1) / thread_num;
-  size_t task_num = count / once_compute_size;
-  if (count % once_compute_size != 0) {
-    task_num += 1;
-  }
-  auto func = [&](void *, int task_id, float, float) {
-    size_t start = task_id * once_compute_size;
-    size_t end = (start + once_compute_size) > count ? count : (start + once_compute_size);
+  auto func = [&task](size_t start, size_t end) {
     task(start, end);
     return common::SUCCESS;
   };
-  (void)thread_pool->ParallelLaunch(func, content, task_num);
+  if (!thread_pool.ParallelFor(count, once_compute_size, func)) {
+    MsException::Instance().CheckException();
+    MS_LOG(EXCEPTION) << "Parallel launch of the kernel " << content << " failed.";
+  }
 }
 
 void ParallelLaunch(const std::vector<common::Task> &tasks, Content content) {
-  auto thread_pool = GetActorMgrInnerThreadPool();
-  size_t kernel_thread_num = thread_pool->GetKernelThreadNum();
-  if (kernel_thread_num == 0) {
-    MS_LOG(EXCEPTION) << "Actor inner pool has been init, but kernel thread is 0!";
+  if (!GetKernelThreadPool().SyncRun(tasks)) {
+    MsException::Instance().CheckException();
+    MS_LOG(EXCEPTION) << "Parallel launch of the tasks of the kernel " << content << " failed.";
   }
-
-  size_t task_num = tasks.size();
-  auto func = [&](void *, int task_id, float, float) {
-    tasks[task_id]();
-    return common::SUCCESS;
-  };
-  (void)thread_pool->ParallelLaunch(func, content, task_num);
 }
 
+// Search for best block_size to get best thread num : 1 2 4 8 16 23(32)
+// Each block_size runs 5 times to get an average cpu kernel cost time.
+// If the speed of block_size[i] is slower than block_size[i-2], than we
+// assume that  block_size[i-2] is the best block_size.
+// The result is kept in ParallelSearchCache, the kernels of the same key skip the search.
 void ParallelLaunchAutoSearch(const CTask &task, size_t count, Content content,
                               ParallelSearchInfo *parallel_search_info) {
-  const size_t MAX_POW = 6;
-  const size_t AVG_COUNT = 5;
-  size_t current_pow = parallel_search_info->search_count / AVG_COUNT;
-  if (current_pow < MAX_POW) {
-    if (parallel_search_info->search_count % AVG_COUNT == 0) {
+  MS_EXCEPTION_IF_NULL(parallel_search_info);
+  auto &search_cache = ParallelSearchCache::GetInstance();
+  if (!parallel_search_info->cache_checked) {
+    parallel_search_info->cache_checked = true;
+    if (!parallel_search_info->kernel_key.empty()) {
+      parallel_search_info->cache_key = parallel_search_info->kernel_key + "_" + std::to_string(count) + "_t" +
+                                        std::to_string(GetKernelThreadPool().GetSyncRunThreadNum());
+      float block_size = 0;
+      if (search_cache.Find(parallel_search_info->cache_key, &block_size) && block_size > 0) {
+        parallel_search_info->best_block_size = block_size;
+        parallel_search_info->search_count = kSearchAvgCount * kMaxSearchPow;
+      }
+    }
+  }
+  size_t current_pow = parallel_search_info->search_count / kSearchAvgCount;
+  if (current_pow < kMaxSearchPow) {
+    if (parallel_search_info->search_count % kSearchAvgCount == 0) {
       parallel_search_info->tmp_sum_cost_time = 0;
     }
     float block_size = static_cast<float>(count) / std::pow(2.0f, current_pow);
@@ -245,16 +238,20 @@ void ParallelLaunchAutoSearch(const CTask &task, size_t count, Content content,
     double cost_time = GetTime() - start_time;
     parallel_search_info->tmp_sum_cost_time += cost_time;
     parallel_search_info->search_count++;
-    if (parallel_search_info->search_count % AVG_COUNT == 0) {
-      double avg_time = parallel_search_info->tmp_sum_cost_time / AVG_COUNT;
+    if (parallel_search_info->search_count % kSearchAvgCount == 0) {
+      double avg_time = parallel_search_info->tmp_sum_cost_time / kSearchAvgCount;
       if (parallel_search_info->min_cost_time > avg_time) {
         parallel_search_info->min_cost_time = avg_time;
         parallel_search_info->best_block_size = block_size;
         parallel_search_info->best_pow = current_pow;
       } else if (current_pow - parallel_search_info->best_pow >= 2) {
-        parallel_search_info->search_count = AVG_COUNT * MAX_POW;
+        parallel_search_info->search_count = kSearchAvgCount * kMaxSearchPow;
       }
     }
+    if (parallel_search_info->search_count >= kSearchAvgCount * kMaxSearchPow &&
+        !parallel_search_info->cache_key.empty()) {
+      search_cache.Insert(parallel_search_info->cache_key, parallel_search_info->best_block_size);
+    }
   } else {
     ParallelLaunch(task, count, parallel_search_info->best_block_size, content);
   }
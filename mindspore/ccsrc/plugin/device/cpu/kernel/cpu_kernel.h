@@ -122,6 +122,10 @@ struct ParallelSearchInfo {
   float best_block_size{0.f};
   size_t best_pow{0};
   size_t search_count{0};
+  // the kernel type, data types and shapes, set by NativeCpuKernelMod::Init, the result is not cached if empty.
+  std::string kernel_key;
+  std::string cache_key;
+  bool cache_checked{false};
 };
 
 class NativeCpuKernelMod : public CpuKernelMod {
@@ -220,7 +224,9 @@ class TransposeIterator {
   size_t pos_{0};
 };
 
-ActorThreadPool *GetActorMgrInnerThreadPool();
+// The thread pool running the CPU kernels, it has the kernel threads of runtime_num_threads.
+common::ThreadPool &GetKernelThreadPool();
+// The content is the kernel launching the tasks, it is reported when a task fails.
 void ParallelLaunch(const CTask &task, size_t count, float block_size = 128.0, Content content = nullptr);
 void ParallelLaunch(const std::vector<common::Task> &tasks, Content content = nullptr);
 void ParallelLaunchAutoSearch(const CTask &task, size_t count, Content content,
@@ -20,6 +20,7 @@
 #include "plugin/device/cpu/kernel/nnacl/op_base.h"
 #include "plugin/device/cpu/kernel/nnacl/matmul_parameter.h"
 #include "plugin/device/cpu/kernel/nnacl/fp32/matmul_fp32.h"
+#include "plugin/device/cpu/kernel/nnacl/bf16/matmul_bf16.h"
 #include "plugin/device/cpu/hal/device/cpu_device_address.h"
 #include "utils/ms_utils.h"
 
@@ -59,6 +60,17 @@ void MatMulCpuKernelMod::InitKernel(const CNodePtr &kernel_node) {
     dim_k = SizeToLong(a_shape[rank - 1]);
   }
 
+  is_bf16_ = AnfAlgo::GetInputDeviceDataType(kernel_node, 0) == kNumberTypeBFloat16;
+  if (is_bf16_) {
+    trans_a_ = trans_a;
+    trans_b_ = trans_b;
+    batch_ = LongToSize(batch);
+    dim_m_ = LongToSize(dim_m);
+    dim_n_ = LongToSize(dim_n);
+    dim_k_ = LongToSize(dim_k);
+    return;
+  }
+
   dims src_dims, weights_dims, dst_dims, a_strides, b_strides, o_strides;
   if (batch > 1) {
     src_dims = {batch, dim_m, dim_k};
@@ -88,10 +100,55 @@ void MatMulCpuKernelMod::InitKernel(const CNodePtr &kernel_node) {
   AddArgument(DNNL_ARG_DST, dst_md);
 }
 
-bool MatMulCpuKernelMod::Launch(const std::vector<kernel::AddressPtr> &inputs, const std::vector<kernel::AddressPtr> &,
+void MatMulCpuKernelMod::InitInputOutputSize(const CNodePtr &kernel_node) {
+  NativeCpuKernelMod::InitInputOutputSize(kernel_node);
+  if (!is_bf16_) {
+    return;
+  }
+  // the packed lhs and rhs of one batch, which are reused by all batches.
+  size_t deep2 = UP_ROUND(dim_k_, C2NUM);
+  size_t col16 = UP_ROUND(dim_n_, C16NUM);
+  (void)workspace_size_list_.emplace_back(dim_m_ * deep2 * sizeof(uint16_t));
+  (void)workspace_size_list_.emplace_back(col16 * deep2 * sizeof(uint16_t));
+}
+
+void MatMulCpuKernelMod::LaunchBf16(const std::vector<kernel::AddressPtr> &inputs,
+                                    const std::vector<kernel::AddressPtr> &workspace,
+                                    const std::vector<kernel::AddressPtr> &outputs) {
+  const auto input_a = reinterpret_cast<uint16_t *>(inputs[0]->addr);
+  const auto input_b = reinterpret_cast<uint16_t *>(inputs[1]->addr);
+  auto output = reinterpret_cast<float *>(outputs[0]->addr);
+  auto packed_a = GetDeviceAddress<uint16_t>(workspace, 0);
+  auto packed_b = GetDeviceAddress<uint16_t>(workspace, 1);
+  size_t deep2 = UP_ROUND(dim_k_, C2NUM);
+  size_t col_block_num = UP_DIV(dim_n_, C16NUM);
+  int deep = SizeToInt(dim_k_);
+  int row = SizeToInt(dim_m_);
+  int col = SizeToInt(dim_n_);
+  for (size_t b = 0; b < batch_; ++b) {
+    PackMatmulLhsBf16(input_a + b * dim_m_ * dim_k_, packed_a, row, deep, trans_a_);
+    PackMatmulRhsBf16(input_b + b * dim_k_ * dim_n_, packed_b, deep, col, trans_b_);
+    float *batch_output = output + b * dim_m_ * dim_n_;
+    auto task = [&](size_t start, size_t end) {
+      for (size_t i = start; i < end; ++i) {
+        int cur_col = MSMIN(C16NUM, col - SizeToInt(i * C16NUM));
+        MatMulBf16(packed_a, packed_b + i * deep2 * C16NUM, batch_output + i * C16NUM, nullptr, ActType_No, deep, row,
+                   cur_col, col);
+      }
+    };
+    ParallelLaunchAutoSearch(task, col_block_num, this, &parallel_search_info_);
+  }
+}
+
+bool MatMulCpuKernelMod::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                                const std::vector<kernel::AddressPtr> &workspace,
                                 const std::vector<kernel::AddressPtr> &outputs) {
   CHECK_KERNEL_INPUTS_NUM(inputs.size(), kMatMulInputsNum, kernel_name_);
   CHECK_KERNEL_OUTPUTS_NUM(outputs.size(), kMatMulOutputsNum, kernel_name_);
+  if (is_bf16_) {
+    LaunchBf16(inputs, workspace, outputs);
+    return true;
+  }
   const auto input_a = reinterpret_cast<float *>(inputs[0]->addr);
   const auto input_b = reinterpret_cast<float *>(inputs[1]->addr);
   auto output = reinterpret_cast<float *>(outputs[0]->addr);
@@ -32,6 +32,22 @@ class MatMulCpuKernelMod : public MKLCpuKernelMod {
 
   bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
               const std::vector<AddressPtr> &outputs) override;
+
+ protected:
+  void InitInputOutputSize(const CNodePtr &kernel_node) override;
+
+ private:
+  // bf16 inputs are computed by the nnacl bf16 gemm with fp32 accumulation, the output is fp32.
+  void LaunchBf16(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+                  const std::vector<AddressPtr> &outputs);
+
+  bool is_bf16_{false};
+  bool trans_a_{false};
+  bool trans_b_{false};
+  size_t batch_{1};
+  size_t dim_m_{0};
+  size_t dim_n_{0};
+  size_t dim_k_{0};
 };
 MS_REG_CPU_KERNEL(
   MatMul,
@@ -42,6 +58,16 @@ MS_REG_CPU_KERNEL(
   BatchMatMul,
   KernelAttr().AddInputAttr(kNumberTypeFloat32).AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
   MatMulCpuKernelMod);
+
+MS_REG_CPU_KERNEL(
+  MatMul,
+  KernelAttr().AddInputAttr(kNumberTypeBFloat16).AddInputAttr(kNumberTypeBFloat16).AddOutputAttr(kNumberTypeFloat32),
+  MatMulCpuKernelMod);
+
+MS_REG_CPU_KERNEL(
+  BatchMatMul,
+  KernelAttr().AddInputAttr(kNumberTypeBFloat16).AddInputAttr(kNumberTypeBFloat16).AddOutputAttr(kNumberTypeFloat32),
+  MatMulCpuKernelMod);
 }  // namespace kernel
 }  // namespace mindspore
 
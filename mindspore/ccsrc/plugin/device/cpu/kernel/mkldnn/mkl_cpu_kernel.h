@@ -132,23 +132,25 @@ auto GetMemDesc(const T &prim_desc) {
 #ifdef USE_MS_THREADPOOL_FOR_DNNL
 class mkl_threadpool : public dnnl::threadpool_interop::threadpool_iface {
  private:
-  ActorThreadPool *tp_;
+  common::ThreadPool *tp_;
   int thread_num_{8};
 
  public:
-  explicit mkl_threadpool(ActorThreadPool *tp) { tp_ = tp; }
+  explicit mkl_threadpool(common::ThreadPool *tp) { tp_ = tp; }
   void set_num_threads(int num) { thread_num_ = num; }
-  int get_num_threads() const override { return std::min(SizeToInt(tp_->GetKernelThreadNum()), thread_num_); }
+  int get_num_threads() const override { return std::min(SizeToInt(tp_->GetSyncRunThreadNum()), thread_num_); }
   bool get_in_parallel() const override { return false; }
   uint64_t get_flags() const override { return 0; }
   void parallel_for(int n, const std::function<void(int, int)> &fn) override {
     int nthr = get_num_threads();
     int n_jobs = std::min(n, nthr);
-    auto func = [&, n_jobs](void *, int i, float, float) {
-      fn(i, n_jobs);
-      return 0;
+    auto func = [&fn, n_jobs](size_t start, size_t end) {
+      for (size_t i = start; i < end; ++i) {
+        fn(SizeToInt(i), n_jobs);
+      }
+      return common::SUCCESS;
     };
-    tp_->ParallelLaunch(func, nullptr, n_jobs);
+    (void)tp_->ParallelFor(IntToSize(n_jobs), 1, func);
   }
 };
 #endif
@@ -168,8 +170,7 @@ class MKLCpuKernelMod : public NativeCpuKernelMod {
  public:
 #ifdef USE_MS_THREADPOOL_FOR_DNNL
   MKLCpuKernelMod() : engine_(dnnl::engine::kind::cpu, 0) {
-    auto thread_pool = GetActorMgrInnerThreadPool();
-    mkl_threadpool_ = std::make_shared<mkl_threadpool>(thread_pool);
+    mkl_threadpool_ = std::make_shared<mkl_threadpool>(&GetKernelThreadPool());
     MS_LOG(DEBUG) << "begin to invoke dnnl::threadpool_interop::make_stream";
     stream_ = dnnl::threadpool_interop::make_stream(engine_, mkl_threadpool_.get());
     MS_LOG(DEBUG) << "end to invoke dnnl::threadpool_interop::make_stream";
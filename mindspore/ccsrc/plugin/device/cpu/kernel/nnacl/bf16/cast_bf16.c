@@ -0,0 +1,63 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "nnacl/bf16/cast_bf16.h"
+#ifdef ENABLE_AVX
+#ifdef _MSC_VER
+#include <immintrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+void Float32ToBf16(const float *input, uint16_t *output, int number) {
+  int i = 0;
+#ifdef ENABLE_AVX
+  const __m256i nan_mask = _mm256_set1_epi32(0x7fffffff);
+  const __m256i inf_value = _mm256_set1_epi32(0x7f800000);
+  const __m256i nan_value = _mm256_set1_epi32(0x7fc00000);
+  const __m256i rounding_bias = _mm256_set1_epi32(0x7fff);
+  const __m256i one = _mm256_set1_epi32(1);
+  for (; i <= number - C16NUM; i += C16NUM) {
+    __m256i res[C2NUM];
+    for (int j = 0; j < C2NUM; ++j) {
+      __m256i u = _mm256_castps_si256(_mm256_loadu_ps(input + i + j * C8NUM));
+      __m256i is_nan = _mm256_cmpgt_epi32(_mm256_and_si256(u, nan_mask), inf_value);
+      __m256i odd = _mm256_and_si256(_mm256_srli_epi32(u, 16), one);
+      __m256i rounded = _mm256_add_epi32(u, _mm256_add_epi32(rounding_bias, odd));
+      res[j] = _mm256_srli_epi32(_mm256_blendv_epi8(rounded, nan_value, is_nan), 16);
+    }
+    // packus works in 128 bits lanes, so the 64 bits blocks are reordered after packing.
+    __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(res[0], res[1]), _MM_SHUFFLE(3, 1, 2, 0));
+    _mm256_storeu_si256((__m256i *)(output + i), packed);
+  }
+#endif
+  for (; i < number; ++i) {
+    output[i] = Float32ToBf16Scalar(input[i]);
+  }
+}
+
+void Bf16ToFloat32(const uint16_t *input, float *output, int number) {
+  int i = 0;
+#ifdef ENABLE_AVX
+  for (; i <= number - C8NUM; i += C8NUM) {
+    __m256i u = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(input + i)));
+    _mm256_storeu_ps(output + i, _mm256_castsi256_ps(_mm256_slli_epi32(u, 16)));
+  }
+#endif
+  for (; i < number; ++i) {
+    output[i] = Bf16ToFloat32Scalar(input[i]);
+  }
+}
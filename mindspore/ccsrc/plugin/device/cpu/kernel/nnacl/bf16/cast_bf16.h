@@ -0,0 +1,54 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_NNACL_BF16_CAST_BF16_H_
+#define MINDSPORE_NNACL_BF16_CAST_BF16_H_
+
+#include "nnacl/op_base.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+// bfloat16 is stored as uint16_t, which is the upper half of float32.
+static inline float Bf16ToFloat32Scalar(uint16_t value) {
+  union {
+    uint32_t u;
+    float f;
+  } f32;
+  f32.u = (uint32_t)value << 16;
+  return f32.f;
+}
+
+// round to nearest even, nan keeps nan.
+static inline uint16_t Float32ToBf16Scalar(float value) {
+  union {
+    uint32_t u;
+    float f;
+  } f32;
+  f32.f = value;
+  if ((f32.u & 0x7fffffff) > 0x7f800000) {
+    return 0x7fc0;
+  }
+  f32.u += 0x7fff + ((f32.u >> 16) & 1);
+  return (uint16_t)(f32.u >> 16);
+}
+
+void Float32ToBf16(const float *input, uint16_t *output, int number);
+void Bf16ToFloat32(const uint16_t *input, float *output, int number);
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // MINDSPORE_NNACL_BF16_CAST_BF16_H_
@@ -0,0 +1,91 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "nnacl/bf16/conv_bf16.h"
+#include <string.h>
+#include "nnacl/bf16/matmul_bf16.h"
+
+void Im2ColPackUnitBf16(const uint16_t *input_data, const ConvParameter *conv_param, uint16_t *packed_input,
+                        int real_cal_num, int block_index, int row_stride) {
+  // input format : nhwc
+  int kernel_h = conv_param->kernel_h_;
+  int kernel_w = conv_param->kernel_w_;
+  int dilation_h = conv_param->dilation_h_;
+  int dilation_w = conv_param->dilation_w_;
+  int out_w = conv_param->output_w_;
+  if (dilation_h == 0 || dilation_w == 0 || out_w == 0) {
+    return;
+  }
+  int in_channel = conv_param->input_channel_;
+  int in_w = conv_param->input_w_;
+  for (int i = 0; i < real_cal_num; i++) {
+    int block_start = block_index + i;
+    int input_h = block_start / out_w * conv_param->stride_h_ - conv_param->pad_u_;
+    int input_w = block_start % out_w * conv_param->stride_w_ - conv_param->pad_l_;
+    if (conv_param->input_h_ - input_h < 0 || in_w - input_w < 0) {
+      continue;
+    }
+    int input_stride = (input_h * in_w + input_w) * in_channel;
+    int kh_s = MSMAX(0, UP_DIV(-input_h, dilation_h));
+    int kh_e = MSMIN(kernel_h, UP_DIV(conv_param->input_h_ - input_h, dilation_h));
+    int kw_s = MSMAX(0, UP_DIV(-input_w, dilation_w));
+    int kw_e = MSMIN(kernel_w, UP_DIV(in_w - input_w, dilation_w));
+    for (int j = kh_s; j < kh_e; j++) {
+      int input_y_stride = j * dilation_h * in_w * in_channel + input_stride;
+      if (dilation_w == 1) {
+        int input_plane_offset = (j * kernel_w + kw_s) * in_channel + i * row_stride;
+        memcpy(packed_input + input_plane_offset, input_data + input_y_stride + kw_s * in_channel,
+               (kw_e - kw_s) * in_channel * sizeof(uint16_t));
+        continue;
+      }
+      for (int k = kw_s; k < kw_e; ++k) {
+        int input_x_stride = input_y_stride + k * dilation_w * in_channel;
+        int input_plane_offset = (j * kernel_w + k) * in_channel + i * row_stride;
+        memcpy(packed_input + input_plane_offset, input_data + input_x_stride, in_channel * sizeof(uint16_t));
+      }
+    }  // kernel_h loop
+  }  // tile num loop
+}
+
+void ConvBf16(const uint16_t *input_data, uint16_t *packed_input, const uint16_t *packed_weight, const float *bias_data,
+              float *output_data, int task_id, const ConvParameter *conv_param) {
+  if (conv_param->thread_num_ == 0) {
+    return;
+  }
+  int output_hw = conv_param->output_h_ * conv_param->output_w_;
+  int block_per_thread = UP_DIV(UP_DIV(output_hw, CONV_BF16_TILE), conv_param->thread_num_);
+  int start_hw = block_per_thread * task_id * CONV_BF16_TILE;
+  int end_hw = MSMIN(output_hw, (block_per_thread * (task_id + 1)) * CONV_BF16_TILE);
+  if (start_hw >= end_hw) {
+    return;
+  }
+  int out_channel = conv_param->output_channel_;
+  int deep = conv_param->kernel_h_ * conv_param->kernel_w_ * conv_param->input_channel_;
+  int deep2 = UP_ROUND(deep, C2NUM);
+  packed_input += task_id * deep2 * CONV_BF16_TILE;
+  size_t input_size = deep2 * CONV_BF16_TILE * sizeof(uint16_t);
+
+  for (int b = 0; b < conv_param->input_batch_; b++) {
+    int in_offset = b * conv_param->input_channel_ * conv_param->input_h_ * conv_param->input_w_;
+    int out_offset = (b * output_hw + start_hw) * out_channel;
+    for (int i = start_hw; i < end_hw; i += CONV_BF16_TILE, out_offset += CONV_BF16_TILE * out_channel) {
+      int real_cal_row = MSMIN(output_hw - i, CONV_BF16_TILE);
+      memset(packed_input, 0, input_size);
+      Im2ColPackUnitBf16(input_data + in_offset, conv_param, packed_input, real_cal_row, i, deep2);
+      MatMulBf16(packed_input, packed_weight, output_data + out_offset, bias_data, conv_param->act_type_,
+                 deep, real_cal_row, out_channel, out_channel);
+    }
+  }
+}
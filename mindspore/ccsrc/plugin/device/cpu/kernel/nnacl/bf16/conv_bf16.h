@@ -0,0 +1,39 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_NNACL_BF16_CONV_BF16_H_
+#define MINDSPORE_NNACL_BF16_CONV_BF16_H_
+
+#include "nnacl/op_base.h"
+#include "nnacl/conv_parameter.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+// the number of output pixels computed by one gemm call, packed_input holds thread_num * CONV_BF16_TILE * deep2.
+#define CONV_BF16_TILE C8NUM
+
+void Im2ColPackUnitBf16(const uint16_t *input_data, const ConvParameter *conv_param, uint16_t *packed_input,
+                        int real_cal_num, int block_index, int row_stride);
+
+// bf16 convolution (im2col+gemm) with fp32 accumulation, the input is nhwc bf16, the output is nhwc fp32 and the
+// ohwi weight is packed by PackMatmulRhsBf16 as a col x deep matrix.
+void ConvBf16(const uint16_t *input_data, uint16_t *packed_input, const uint16_t *packed_weight, const float *bias_data,
+              float *output_data, int task_id, const ConvParameter *conv_param);
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // MINDSPORE_NNACL_BF16_CONV_BF16_H_
@@ -0,0 +1,85 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "nnacl/bf16/matmul_bf16.h"
+#include <string.h>
+#include "nnacl/bf16/cast_bf16.h"
+#include "nnacl/nnacl_utils.h"
+
+void PackMatmulLhsBf16(const uint16_t *src, uint16_t *dst, int row, int deep, bool transpose) {
+  int deep2 = UP_ROUND(deep, C2NUM);
+  for (int r = 0; r < row; ++r) {
+    uint16_t *dst_row = dst + r * deep2;
+    if (transpose) {
+      for (int d = 0; d < deep; ++d) {
+        dst_row[d] = src[d * row + r];
+      }
+    } else {
+      memcpy(dst_row, src + r * deep, deep * sizeof(uint16_t));
+    }
+    if (deep2 != deep) {
+      dst_row[deep] = 0;
+    }
+  }
+}
+
+void PackMatmulRhsBf16(const uint16_t *src, uint16_t *dst, int deep, int col, bool transpose) {
+  int deep2 = UP_ROUND(deep, C2NUM);
+  int col16 = UP_ROUND(col, C16NUM);
+  memset(dst, 0, col16 * deep2 * sizeof(uint16_t));
+  for (int d = 0; d < deep; ++d) {
+    for (int c = 0; c < col; ++c) {
+      int dst_index = c / C16NUM * deep2 * C16NUM + d / C2NUM * C32NUM + c % C16NUM * C2NUM + d % C2NUM;
+      dst[dst_index] = transpose ? src[c * deep + d] : src[d * col + c];
+    }
+  }
+}
+
+void MatMulBf16Emulate(const uint16_t *a, const uint16_t *b, float *c, const float *bias, ActType act_type, int deep,
+                       int row, int col, int stride) {
+  int deep2 = UP_ROUND(deep, C2NUM);
+  for (int r = 0; r < row; ++r) {
+    for (int j = 0; j < col; ++j) {
+      const uint16_t *b_col = b + j / C16NUM * deep2 * C16NUM + j % C16NUM * C2NUM;
+      float value = 0;
+      for (int d = 0; d < deep2; ++d) {
+        value += Bf16ToFloat32Scalar(a[r * deep2 + d]) * Bf16ToFloat32Scalar(b_col[d / C2NUM * C32NUM + d % C2NUM]);
+      }
+      value += bias != NULL ? bias[j] : 0;
+      if (act_type == ActType_Relu || act_type == ActType_Relu6) {
+        value = MSMAX(0.0f, value);
+      }
+      if (act_type == ActType_Relu6) {
+        value = MSMIN(6.0f, value);
+      }
+      c[r * stride + j] = value;
+    }
+  }
+}
+
+void MatMulBf16(const uint16_t *a, const uint16_t *b, float *c, const float *bias, ActType act_type, int deep, int row,
+                int col, int stride) {
+#ifdef ENABLE_AVX512
+  if (X86Avx512Bf16Support()) {
+    MatMulBf16Avx512(a, b, c, bias, act_type, deep, row, col, stride);
+    return;
+  }
+#endif
+#ifdef ENABLE_AVX
+  MatMulBf16Avx2(a, b, c, bias, act_type, deep, row, col, stride);
+#else
+  MatMulBf16Emulate(a, b, c, bias, act_type, deep, row, col, stride);
+#endif
+}
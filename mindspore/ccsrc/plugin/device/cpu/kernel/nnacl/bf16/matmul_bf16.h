@@ -0,0 +1,52 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_NNACL_BF16_MATMUL_BF16_H_
+#define MINDSPORE_NNACL_BF16_MATMUL_BF16_H_
+
+#include <stdbool.h>
+#include "nnacl/op_base.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/* The bf16 matmul multiplies the bf16 matrices and accumulates in fp32.
+ * lhs is packed to row x deep2, deep2 = UP_ROUND(deep, 2), row-major with zero padded.
+ * rhs is packed to col16 blocks, each block holds deep2 / 2 pairs of rows, a pair of row holds 16 columns, and
+ * the two values of the same column are adjacent, which is the operand layout of the avx512 bf16 dot product.
+ * */
+void PackMatmulLhsBf16(const uint16_t *src, uint16_t *dst, int row, int deep, bool transpose);
+void PackMatmulRhsBf16(const uint16_t *src, uint16_t *dst, int deep, int col, bool transpose);
+
+// c(row x col, row stride is stride) = a(packed lhs) * b(packed rhs) + bias, the col of b is started at a col16 block.
+void MatMulBf16(const uint16_t *a, const uint16_t *b, float *c, const float *bias, ActType act_type, int deep, int row,
+                int col, int stride);
+
+void MatMulBf16Emulate(const uint16_t *a, const uint16_t *b, float *c, const float *bias, ActType act_type, int deep,
+                       int row, int col, int stride);
+#ifdef ENABLE_AVX
+void MatMulBf16Avx2(const uint16_t *a, const uint16_t *b, float *c, const float *bias, ActType act_type, int deep,
+                    int row, int col, int stride);
+#endif
+#ifdef ENABLE_AVX512
+/* only called when the cpu supports avx512 bf16, see X86Avx512Bf16Support */
+void MatMulBf16Avx512(const uint16_t *a, const uint16_t *b, float *c, const float *bias, ActType act_type, int deep,
+                      int row, int col, int stride);
+#endif
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // MINDSPORE_NNACL_BF16_MATMUL_BF16_H_
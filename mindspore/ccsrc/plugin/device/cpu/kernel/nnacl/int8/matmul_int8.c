@@ -16,6 +16,7 @@
 
 #include "nnacl/int8/matmul_int8.h"
 #include "nnacl/int8/fixed_point.h"
+#include "nnacl/nnacl_utils.h"
 
 void RowMajor2Row2x16MajorInt8(const int8_t *src_ptr, int8_t *dst_ptr, int row, int col) {
   int col16 = UP_ROUND(col, C16NUM);
@@ -303,6 +304,17 @@ void MatmulInt8Opt(const int8_t *a, const int8_t *b, int8_t *dst, int row, int c
    * a_sums is  perT  : input_row_sum * filter_zp
    *            perOc : input_row_sum
    * */
+#ifdef ENABLE_AVX512
+  if (X86Avx512VnniSupport()) {
+    MatmulInt8OptAvx512Vnni(a, b, dst, row, col, deep16, a_sums, bias, mini, maxi, out_zp, multiplier, left_shift,
+                            right_shift, stride, filter_peroc, filter_zp);
+    return;
+  }
+#endif
+#ifdef ENABLE_AVX
+  MatmulInt8OptAvx2(a, b, dst, row, col, deep16, a_sums, bias, mini, maxi, out_zp, multiplier, left_shift,
+                    right_shift, stride, filter_peroc, filter_zp);
+#else
   for (int r = 0; r < row; r++) {
     for (int c = 0; c < col; c++) {
       int r4div = r / C4NUM, r4mod = r % C4NUM;
@@ -327,6 +339,7 @@ void MatmulInt8Opt(const int8_t *a, const int8_t *b, int8_t *dst, int row, int c
       dst[ci] = (int8_t)value;
     }
   }
+#endif
   return;
 }
 #endif
@@ -335,6 +348,17 @@ void MatMulInt8_8x8_r(const int8_t *a, const int8_t *b, int8_t *dst, size_t row,
                       const int32_t *right_shift, const int32_t *multiplier, int32_t output_zp, int32_t mini,
                       int32_t maxi, size_t per_channel) {
   /*  row8x4-major * row4x8-major => (int8)row-major  */
+#ifdef ENABLE_AVX512
+  if (X86Avx512VnniSupport()) {
+    MatMulInt8_8x8_rAvx512Vnni(a, b, dst, row, col, deep_4, stride, input_sum, bias, left_shift, right_shift,
+                               multiplier, output_zp, mini, maxi, per_channel);
+    return;
+  }
+#endif
+#ifdef ENABLE_AVX
+  MatMulInt8_8x8_rAvx2(a, b, dst, row, col, deep_4, stride, input_sum, bias, left_shift, right_shift, multiplier,
+                       output_zp, mini, maxi, per_channel);
+#else
   for (size_t r = 0; r < row; r++) {
     for (size_t c = 0; c < col; c++) {
       size_t r8div = r / C8NUM, r8mod = r % C8NUM;
@@ -360,6 +384,7 @@ void MatMulInt8_8x8_r(const int8_t *a, const int8_t *b, int8_t *dst, size_t row,
       dst[ci] = (int8_t)value;
     }
   }
+#endif
   return;
 }
 
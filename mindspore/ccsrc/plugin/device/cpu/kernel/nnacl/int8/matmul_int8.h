@@ -72,6 +72,27 @@ void MatMulInt8_4x16_r(const int8_t *a, const int8_t *b, int8_t *dst, size_t row
                        const int32_t *right_shift, const int32_t *multiplier, int32_t output_zp, int32_t mini,
                        int32_t maxi, size_t per_channel, const int32_t *filter_zp);
 
+#ifdef ENABLE_AVX
+void MatmulInt8OptAvx2(const int8_t *a, const int8_t *b, int8_t *dst, int row, int col, int deep16, const int *a_sums,
+                       const int *bias, int act_min, int act_max, int out_zp, const int32_t *multiplier,
+                       const int32_t *left_shift, const int32_t *right_shift, size_t stride, size_t filter_peroc,
+                       const int32_t *filter_zp);
+void MatMulInt8_8x8_rAvx2(const int8_t *a, const int8_t *b, int8_t *dst, size_t row, size_t col, size_t deep_4,
+                          size_t stride, const int32_t *input_sum, const int32_t *bias, const int32_t *left_shift,
+                          const int32_t *right_shift, const int32_t *multiplier, int32_t output_zp, int32_t mini,
+                          int32_t maxi, size_t per_channel);
+#endif
+#ifdef ENABLE_AVX512
+/* only called when the cpu supports avx512 vnni, see X86Avx512VnniSupport */
+void MatmulInt8OptAvx512Vnni(const int8_t *a, const int8_t *b, int8_t *dst, int row, int col, int deep16,
+                             const int *a_sums, const int *bias, int act_min, int act_max, int out_zp,
+                             const int32_t *multiplier, const int32_t *left_shift, const int32_t *right_shift,
+                             size_t stride, size_t filter_peroc, const int32_t *filter_zp);
+void MatMulInt8_8x8_rAvx512Vnni(const int8_t *a, const int8_t *b, int8_t *dst, size_t row, size_t col, size_t deep_4,
+                                size_t stride, const int32_t *input_sum, const int32_t *bias,
+                                const int32_t *left_shift, const int32_t *right_shift, const int32_t *multiplier,
+                                int32_t output_zp, int32_t mini, int32_t maxi, size_t per_channel);
+#endif
 #ifdef ENABLE_ARM64
 void MatmulInt8Neon64(const int8_t *a, const int8_t *b, int8_t *dst, int row4, int col4, int deep16, const int *a_sums,
                       const int *bias, int act_min, int act_max, int out_zp, int32_t *multiplier, int32_t *left_shift,
@@ -0,0 +1,167 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifdef ENABLE_AVX
+#ifdef _MSC_VER
+#include <immintrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#include <string.h>
+#include "nnacl/bf16/matmul_bf16.h"
+
+#define MATMUL_BF16_AVX2_ROW 4
+#define MATMUL_BF16_AVX512_ROW 8
+
+static inline uint32_t LoadBf16Pair(const uint16_t *src) {
+  uint32_t pair;
+  memcpy(&pair, src, sizeof(pair));
+  return pair;
+}
+
+static inline __m256 ActBlockAvx2(__m256 value, ActType act_type) {
+  if (act_type == ActType_Relu || act_type == ActType_Relu6) {
+    value = _mm256_max_ps(value, _mm256_setzero_ps());
+  }
+  if (act_type == ActType_Relu6) {
+    value = _mm256_min_ps(value, _mm256_set1_ps(6.0f));
+  }
+  return value;
+}
+
+// computes rows x 16 columns, the bf16 values are widened to fp32 by shifting and accumulated by fma.
+static void MatMulBf16BlockAvx2(const uint16_t *a, const uint16_t *b, float *c, const float *bias, ActType act_type,
+                                int deep2, int rows, int cols, int stride) {
+  const __m256i high_mask = _mm256_set1_epi32((int)0xffff0000);
+  __m256 acc[MATMUL_BF16_AVX2_ROW][C2NUM];
+  for (int i = 0; i < MATMUL_BF16_AVX2_ROW; ++i) {
+    acc[i][0] = _mm256_setzero_ps();
+    acc[i][1] = _mm256_setzero_ps();
+  }
+  for (int d = 0; d < deep2; d += C2NUM) {
+    __m256i b0 = _mm256_loadu_si256((const __m256i *)(b + d * C16NUM));
+    __m256i b1 = _mm256_loadu_si256((const __m256i *)(b + d * C16NUM + C16NUM));
+    __m256 b0_even = _mm256_castsi256_ps(_mm256_slli_epi32(b0, 16));
+    __m256 b0_odd = _mm256_castsi256_ps(_mm256_and_si256(b0, high_mask));
+    __m256 b1_even = _mm256_castsi256_ps(_mm256_slli_epi32(b1, 16));
+    __m256 b1_odd = _mm256_castsi256_ps(_mm256_and_si256(b1, high_mask));
+    for (int i = 0; i < rows; ++i) {
+      uint32_t pair = LoadBf16Pair(a + i * deep2 + d);
+      __m256 a_even = _mm256_castsi256_ps(_mm256_set1_epi32((int)(pair << 16)));
+      __m256 a_odd = _mm256_castsi256_ps(_mm256_set1_epi32((int)(pair & 0xffff0000)));
+      acc[i][0] = _mm256_fmadd_ps(a_even, b0_even, acc[i][0]);
+      acc[i][0] = _mm256_fmadd_ps(a_odd, b0_odd, acc[i][0]);
+      acc[i][1] = _mm256_fmadd_ps(a_even, b1_even, acc[i][1]);
+      acc[i][1] = _mm256_fmadd_ps(a_odd, b1_odd, acc[i][1]);
+    }
+  }
+  float bias_block[C16NUM] = {0};
+  if (bias != NULL) {
+    memcpy(bias_block, bias, cols * sizeof(float));
+  }
+  __m256 bias0 = _mm256_loadu_ps(bias_block);
+  __m256 bias1 = _mm256_loadu_ps(bias_block + C8NUM);
+  for (int i = 0; i < rows; ++i) {
+    __m256 res0 = ActBlockAvx2(_mm256_add_ps(acc[i][0], bias0), act_type);
+    __m256 res1 = ActBlockAvx2(_mm256_add_ps(acc[i][1], bias1), act_type);
+    float *dst = c + i * stride;
+    if (cols == C16NUM) {
+      _mm256_storeu_ps(dst, res0);
+      _mm256_storeu_ps(dst + C8NUM, res1);
+    } else {
+      float res[C16NUM];
+      _mm256_storeu_ps(res, res0);
+      _mm256_storeu_ps(res + C8NUM, res1);
+      memcpy(dst, res, cols * sizeof(float));
+    }
+  }
+}
+
+void MatMulBf16Avx2(const uint16_t *a, const uint16_t *b, float *c, const float *bias, ActType act_type, int deep,
+                    int row, int col, int stride) {
+  int deep2 = UP_ROUND(deep, C2NUM);
+  for (int j = 0; j < col; j += C16NUM) {
+    int cols = MSMIN(C16NUM, col - j);
+    const uint16_t *b_block = b + j * deep2;
+    const float *bias_block = bias != NULL ? bias + j : NULL;
+    for (int r = 0; r < row; r += MATMUL_BF16_AVX2_ROW) {
+      int rows = MSMIN(MATMUL_BF16_AVX2_ROW, row - r);
+      MatMulBf16BlockAvx2(a + r * deep2, b_block, c + r * stride + j, bias_block, act_type, deep2, rows, cols, stride);
+    }
+  }
+}
+
+#ifdef ENABLE_AVX512
+#ifdef _MSC_VER
+#define NNACL_AVX512_BF16_TARGET
+#else
+#define NNACL_AVX512_BF16_TARGET __attribute__((target("avx512f,avx512bf16")))
+#endif
+
+// computes rows x 16 columns, vdpbf16ps multiplies the pairs of bf16 and accumulates in fp32.
+NNACL_AVX512_BF16_TARGET static void MatMulBf16BlockAvx512(const uint16_t *a, const uint16_t *b, float *c,
+                                                           const float *bias, ActType act_type, int deep2, int rows,
+                                                           int cols, int stride) {
+  __m512 acc[MATMUL_BF16_AVX512_ROW];
+  for (int i = 0; i < MATMUL_BF16_AVX512_ROW; ++i) {
+    acc[i] = _mm512_setzero_ps();
+  }
+  if (rows == MATMUL_BF16_AVX512_ROW) {
+    for (int d = 0; d < deep2; d += C2NUM) {
+      __m512bh vb = (__m512bh)_mm512_loadu_si512(b + d * C16NUM);
+      for (int i = 0; i < MATMUL_BF16_AVX512_ROW; ++i) {
+        __m512bh va = (__m512bh)_mm512_set1_epi32((int)LoadBf16Pair(a + i * deep2 + d));
+        acc[i] = _mm512_dpbf16_ps(acc[i], va, vb);
+      }
+    }
+  } else {
+    for (int d = 0; d < deep2; d += C2NUM) {
+      __m512bh vb = (__m512bh)_mm512_loadu_si512(b + d * C16NUM);
+      for (int i = 0; i < rows; ++i) {
+        __m512bh va = (__m512bh)_mm512_set1_epi32((int)LoadBf16Pair(a + i * deep2 + d));
+        acc[i] = _mm512_dpbf16_ps(acc[i], va, vb);
+      }
+    }
+  }
+  __mmask16 mask = (__mmask16)((1u << cols) - 1);
+  __m512 bias_value = bias != NULL ? _mm512_maskz_loadu_ps(mask, bias) : _mm512_setzero_ps();
+  for (int i = 0; i < rows; ++i) {
+    __m512 res = _mm512_add_ps(acc[i], bias_value);
+    if (act_type == ActType_Relu || act_type == ActType_Relu6) {
+      res = _mm512_max_ps(res, _mm512_setzero_ps());
+    }
+    if (act_type == ActType_Relu6) {
+      res = _mm512_min_ps(res, _mm512_set1_ps(6.0f));
+    }
+    _mm512_mask_storeu_ps(c + i * stride, mask, res);
+  }
+}
+
+NNACL_AVX512_BF16_TARGET void MatMulBf16Avx512(const uint16_t *a, const uint16_t *b, float *c, const float *bias,
+                                               ActType act_type, int deep, int row, int col, int stride) {
+  int deep2 = UP_ROUND(deep, C2NUM);
+  for (int j = 0; j < col; j += C16NUM) {
+    int cols = MSMIN(C16NUM, col - j);
+    const uint16_t *b_block = b + j * deep2;
+    const float *bias_block = bias != NULL ? bias + j : NULL;
+    for (int r = 0; r < row; r += MATMUL_BF16_AVX512_ROW) {
+      int rows = MSMIN(MATMUL_BF16_AVX512_ROW, row - r);
+      MatMulBf16BlockAvx512(a + r * deep2, b_block, c + r * stride + j, bias_block, act_type, deep2, rows, cols,
+                            stride);
+    }
+  }
+}
+#endif
+#endif
@@ -0,0 +1,307 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifdef ENABLE_AVX
+#ifdef _MSC_VER
+#include <immintrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#include "nnacl/int8/matmul_int8.h"
+#include "nnacl/int8/fixed_point.h"
+
+#define MS_AVX_PERMUTE_0213 _MM_SHUFFLE(3, 1, 2, 0)
+
+static inline int8_t RequantizeInt8(int32_t value, int32_t multiplier, int32_t left_shift, int32_t right_shift,
+                                    int32_t out_zp, int32_t mini, int32_t maxi) {
+  value = MultiplyByQuantizedMultiplier(value, multiplier, left_shift, right_shift) + out_zp;
+  value = MSMIN(maxi, value);
+  value = MSMAX(mini, value);
+  return (int8_t)value;
+}
+
+// Sum the partial results of four columns, each in one vector, to one vector of the four columns.
+static inline __m128i ReduceCol4Avx2(__m256i c0, __m256i c1, __m256i c2, __m256i c3) {
+  __m256i sum01 = _mm256_hadd_epi32(c0, c1);
+  __m256i sum23 = _mm256_hadd_epi32(c2, c3);
+  __m256i sum = _mm256_hadd_epi32(sum01, sum23);
+  return _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+}
+
+/*
+ * row4x16-major * row16x4-major => row-major 4x4 int32 block
+ * the int8 values are widened to int16 and multiplied by vpmaddwd, two rows are computed in one pass.
+ */
+static void MatMulInt8Block4x4x16Avx2(const int8_t *a, const int8_t *b, int deep16, int32_t *dst) {
+  for (int r = 0; r < C4NUM; r += C2NUM) {
+    __m256i acc00 = _mm256_setzero_si256();
+    __m256i acc01 = _mm256_setzero_si256();
+    __m256i acc02 = _mm256_setzero_si256();
+    __m256i acc03 = _mm256_setzero_si256();
+    __m256i acc10 = _mm256_setzero_si256();
+    __m256i acc11 = _mm256_setzero_si256();
+    __m256i acc12 = _mm256_setzero_si256();
+    __m256i acc13 = _mm256_setzero_si256();
+    const int8_t *a_ptr = a + r * C16NUM;
+    const int8_t *b_ptr = b;
+    for (int d = 0; d < deep16; d += C16NUM) {
+      __m256i a0 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)a_ptr));
+      __m256i a1 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(a_ptr + C16NUM)));
+      __m256i b0 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)b_ptr));
+      __m256i b1 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(b_ptr + C16NUM)));
+      __m256i b2 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(b_ptr + C32NUM)));
+      __m256i b3 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(b_ptr + C48NUM)));
+      acc00 = _mm256_add_epi32(acc00, _mm256_madd_epi16(a0, b0));
+      acc01 = _mm256_add_epi32(acc01, _mm256_madd_epi16(a0, b1));
+      acc02 = _mm256_add_epi32(acc02, _mm256_madd_epi16(a0, b2));
+      acc03 = _mm256_add_epi32(acc03, _mm256_madd_epi16(a0, b3));
+      acc10 = _mm256_add_epi32(acc10, _mm256_madd_epi16(a1, b0));
+      acc11 = _mm256_add_epi32(acc11, _mm256_madd_epi16(a1, b1));
+      acc12 = _mm256_add_epi32(acc12, _mm256_madd_epi16(a1, b2));
+      acc13 = _mm256_add_epi32(acc13, _mm256_madd_epi16(a1, b3));
+      a_ptr += C4NUM * C16NUM;
+      b_ptr += C4NUM * C16NUM;
+    }
+    _mm_storeu_si128((__m128i *)(dst + r * C4NUM), ReduceCol4Avx2(acc00, acc01, acc02, acc03));
+    _mm_storeu_si128((__m128i *)(dst + (r + 1) * C4NUM), ReduceCol4Avx2(acc10, acc11, acc12, acc13));
+  }
+}
+
+void MatmulInt8OptAvx2(const int8_t *a, const int8_t *b, int8_t *dst, int row, int col, int deep16, const int *a_sums,
+                       const int *bias, int mini, int maxi, int out_zp, const int32_t *multiplier,
+                       const int32_t *left_shift, const int32_t *right_shift, size_t stride, size_t filter_peroc,
+                       const int32_t *filter_zp) {
+  int32_t block[C4NUM * C4NUM];
+  for (int c = 0; c < col; c += C4NUM) {
+    int col_num = MSMIN(C4NUM, col - c);
+    for (int r = 0; r < row; r += C4NUM) {
+      int row_num = MSMIN(C4NUM, row - r);
+      MatMulInt8Block4x4x16Avx2(a + r * deep16, b + c * deep16, deep16, block);
+      for (int i = 0; i < row_num; ++i) {
+        for (int j = 0; j < col_num; ++j) {
+          int oc = c + j;
+          int32_t cur_input_sum = filter_peroc ? a_sums[r + i] * filter_zp[oc] : a_sums[r + i];
+          int32_t value = block[i * C4NUM + j] - cur_input_sum + bias[oc];
+          int param_index = filter_peroc ? oc : 0;
+          dst[(r + i) * stride + oc] = RequantizeInt8(value, multiplier[param_index], left_shift[param_index],
+                                                      right_shift[param_index], out_zp, mini, maxi);
+        }
+      }
+    }
+  }
+}
+
+/*
+ * row8x4-major * row4x8-major => row-major 4x8 int32 block
+ * the four int8 values of one row in a and the 8x4 int8 values in b are widened to int16 and multiplied by vpmaddwd.
+ */
+static void MatMulInt8Block4x8x4Avx2(const int8_t *a, const int8_t *b, size_t deep4, int32_t *dst) {
+  __m256i acc0_lo = _mm256_setzero_si256();
+  __m256i acc0_hi = _mm256_setzero_si256();
+  __m256i acc1_lo = _mm256_setzero_si256();
+  __m256i acc1_hi = _mm256_setzero_si256();
+  __m256i acc2_lo = _mm256_setzero_si256();
+  __m256i acc2_hi = _mm256_setzero_si256();
+  __m256i acc3_lo = _mm256_setzero_si256();
+  __m256i acc3_hi = _mm256_setzero_si256();
+  for (size_t d = 0; d < deep4; d += C4NUM) {
+    __m256i b_lo = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)b));
+    __m256i b_hi = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(b + C16NUM)));
+    __m256i a0 = _mm256_broadcastq_epi64(_mm_cvtepi8_epi16(_mm_cvtsi32_si128(*(const int32_t *)a)));
+    __m256i a1 = _mm256_broadcastq_epi64(_mm_cvtepi8_epi16(_mm_cvtsi32_si128(*(const int32_t *)(a + C4NUM))));
+    __m256i a2 = _mm256_broadcastq_epi64(_mm_cvtepi8_epi16(_mm_cvtsi32_si128(*(const int32_t *)(a + C8NUM))));
+    __m256i a3 = _mm256_broadcastq_epi64(_mm_cvtepi8_epi16(_mm_cvtsi32_si128(*(const int32_t *)(a + C12NUM))));
+    acc0_lo = _mm256_add_epi32(acc0_lo, _mm256_madd_epi16(a0, b_lo));
+    acc0_hi = _mm256_add_epi32(acc0_hi, _mm256_madd_epi16(a0, b_hi));
+    acc1_lo = _mm256_add_epi32(acc1_lo, _mm256_madd_epi16(a1, b_lo));
+    acc1_hi = _mm256_add_epi32(acc1_hi, _mm256_madd_epi16(a1, b_hi));
+    acc2_lo = _mm256_add_epi32(acc2_lo, _mm256_madd_epi16(a2, b_lo));
+    acc2_hi = _mm256_add_epi32(acc2_hi, _mm256_madd_epi16(a2, b_hi));
+    acc3_lo = _mm256_add_epi32(acc3_lo, _mm256_madd_epi16(a3, b_lo));
+    acc3_hi = _mm256_add_epi32(acc3_hi, _mm256_madd_epi16(a3, b_hi));
+    a += C8NUM * C4NUM;
+    b += C8NUM * C4NUM;
+  }
+  // The pairwise sums are ordered as col 0 1 4 5 | 2 3 6 7, so the 64-bit lanes are permuted to 0 2 1 3.
+  __m256i res0 = _mm256_permute4x64_epi64(_mm256_hadd_epi32(acc0_lo, acc0_hi), MS_AVX_PERMUTE_0213);
+  __m256i res1 = _mm256_permute4x64_epi64(_mm256_hadd_epi32(acc1_lo, acc1_hi), MS_AVX_PERMUTE_0213);
+  __m256i res2 = _mm256_permute4x64_epi64(_mm256_hadd_epi32(acc2_lo, acc2_hi), MS_AVX_PERMUTE_0213);
+  __m256i res3 = _mm256_permute4x64_epi64(_mm256_hadd_epi32(acc3_lo, acc3_hi), MS_AVX_PERMUTE_0213);
+  _mm256_storeu_si256((__m256i *)dst, res0);
+  _mm256_storeu_si256((__m256i *)(dst + C8NUM), res1);
+  _mm256_storeu_si256((__m256i *)(dst + C16NUM), res2);
+  _mm256_storeu_si256((__m256i *)(dst + C24NUM), res3);
+}
+
+static void MatMulInt8Block8x8Requant(const int32_t *block, int8_t *dst, size_t row_start, size_t row_num,
+                                      size_t col_start, size_t col_num, size_t row, size_t stride,
+                                      const int32_t *input_sum, const int32_t *bias, const int32_t *left_shift,
+                                      const int32_t *right_shift, const int32_t *multiplier, int32_t output_zp,
+                                      int32_t mini, int32_t maxi, size_t per_channel) {
+  size_t row8 = UP_ROUND(row, C8NUM);
+  for (size_t i = 0; i < row_num; ++i) {
+    size_t r = row_start + i;
+    for (size_t j = 0; j < col_num; ++j) {
+      size_t c = col_start + j;
+      int32_t cur_input_sum = per_channel ? input_sum[col_start * row8 + r * C8NUM + j] : input_sum[r];
+      int32_t value = block[i * C8NUM + j] - cur_input_sum + bias[c];
+      size_t param_index = per_channel ? c : 0;
+      dst[r * stride + c] = RequantizeInt8(value, multiplier[param_index], left_shift[param_index],
+                                           right_shift[param_index], output_zp, mini, maxi);
+    }
+  }
+}
+
+void MatMulInt8_8x8_rAvx2(const int8_t *a, const int8_t *b, int8_t *dst, size_t row, size_t col, size_t deep_4,
+                          size_t stride, const int32_t *input_sum, const int32_t *bias, const int32_t *left_shift,
+                          const int32_t *right_shift, const int32_t *multiplier, int32_t output_zp, int32_t mini,
+                          int32_t maxi, size_t per_channel) {
+  int32_t block[C8NUM * C8NUM];
+  for (size_t c = 0; c < col; c += C8NUM) {
+    size_t col_num = MSMIN(C8NUM, col - c);
+    const int8_t *b_ptr = b + c * deep_4;
+    for (size_t r = 0; r < row; r += C8NUM) {
+      size_t row_num = MSMIN(C8NUM, row - r);
+      const int8_t *a_ptr = a + r * deep_4;
+      MatMulInt8Block4x8x4Avx2(a_ptr, b_ptr, deep_4, block);
+      if (row_num > C4NUM) {
+        MatMulInt8Block4x8x4Avx2(a_ptr + C4NUM * C4NUM, b_ptr, deep_4, block + C4NUM * C8NUM);
+      }
+      MatMulInt8Block8x8Requant(block, dst, r, row_num, c, col_num, row, stride, input_sum, bias, left_shift,
+                                right_shift, multiplier, output_zp, mini, maxi, per_channel);
+    }
+  }
+}
+
+#ifdef ENABLE_AVX512
+#ifdef _MSC_VER
+#define NNACL_AVX512_VNNI_TARGET
+#else
+#define NNACL_AVX512_VNNI_TARGET __attribute__((target("avx512f,avx512bw,avx512vl,avx512vnni")))
+#endif
+
+/*
+ * vpdpbusd multiplies unsigned int8 by signed int8, so a is offset by 128 to unsigned int8 and the sums of b
+ * multiplied by 128 are subtracted from the results.
+ */
+NNACL_AVX512_VNNI_TARGET void MatmulInt8OptAvx512Vnni(const int8_t *a, const int8_t *b, int8_t *dst, int row, int col,
+                                                      int deep16, const int *a_sums, const int *bias, int mini,
+                                                      int maxi, int out_zp, const int32_t *multiplier,
+                                                      const int32_t *left_shift, const int32_t *right_shift,
+                                                      size_t stride, size_t filter_peroc, const int32_t *filter_zp) {
+  const __m512i ones = _mm512_set1_epi8(1);
+  const __m512i offset = _mm512_set1_epi8((char)0x80);
+  int32_t block[C4NUM * C4NUM];
+  for (int c = 0; c < col; c += C4NUM) {
+    int col_num = MSMIN(C4NUM, col - c);
+    const int8_t *b_block = b + c * deep16;
+    __m512i b_sum = _mm512_setzero_si512();
+    for (int d = 0; d < deep16; d += C16NUM) {
+      b_sum = _mm512_dpbusd_epi32(b_sum, ones, _mm512_loadu_si512(b_block + d * C4NUM));
+    }
+    // The accumulators start from -128 * sum(b) to remove the offset of a.
+    const __m512i init = _mm512_sub_epi32(_mm512_setzero_si512(), _mm512_slli_epi32(b_sum, C7NUM));
+    for (int r = 0; r < row; r += C4NUM) {
+      int row_num = MSMIN(C4NUM, row - r);
+      const int8_t *a_ptr = a + r * deep16;
+      const int8_t *b_ptr = b_block;
+      __m512i acc0 = init;
+      __m512i acc1 = init;
+      __m512i acc2 = init;
+      __m512i acc3 = init;
+      for (int d = 0; d < deep16; d += C16NUM) {
+        __m512i b_vec = _mm512_loadu_si512(b_ptr);
+        __m512i a0 = _mm512_xor_si512(_mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i *)a_ptr)), offset);
+        __m512i a1 =
+          _mm512_xor_si512(_mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i *)(a_ptr + C16NUM))), offset);
+        __m512i a2 =
+          _mm512_xor_si512(_mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i *)(a_ptr + C32NUM))), offset);
+        __m512i a3 =
+          _mm512_xor_si512(_mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i *)(a_ptr + C48NUM))), offset);
+        acc0 = _mm512_dpbusd_epi32(acc0, a0, b_vec);
+        acc1 = _mm512_dpbusd_epi32(acc1, a1, b_vec);
+        acc2 = _mm512_dpbusd_epi32(acc2, a2, b_vec);
+        acc3 = _mm512_dpbusd_epi32(acc3, a3, b_vec);
+        a_ptr += C4NUM * C16NUM;
+        b_ptr += C4NUM * C16NUM;
+      }
+      // Each 128-bit lane holds the four partial sums of one column for a row, transpose the lanes of the four rows
+      // and add them up, then the lane k holds the results of the column k for the row 0 to 3.
+      __m512i t0 = _mm512_unpacklo_epi32(acc0, acc1);
+      __m512i t1 = _mm512_unpackhi_epi32(acc0, acc1);
+      __m512i t2 = _mm512_unpacklo_epi32(acc2, acc3);
+      __m512i t3 = _mm512_unpackhi_epi32(acc2, acc3);
+      __m512i s0 = _mm512_add_epi32(t0, t1);
+      __m512i s1 = _mm512_add_epi32(t2, t3);
+      __m512i res = _mm512_add_epi32(_mm512_unpacklo_epi64(s0, s1), _mm512_unpackhi_epi64(s0, s1));
+      _mm512_storeu_si512(block, res);
+      for (int i = 0; i < row_num; ++i) {
+        for (int j = 0; j < col_num; ++j) {
+          int oc = c + j;
+          int32_t cur_input_sum = filter_peroc ? a_sums[r + i] * filter_zp[oc] : a_sums[r + i];
+          int32_t value = block[j * C4NUM + i] - cur_input_sum + bias[oc];
+          int param_index = filter_peroc ? oc : 0;
+          dst[(r + i) * stride + oc] = RequantizeInt8(value, multiplier[param_index], left_shift[param_index],
+                                                      right_shift[param_index], out_zp, mini, maxi);
+        }
+      }
+    }
+  }
+}
+
+NNACL_AVX512_VNNI_TARGET void MatMulInt8_8x8_rAvx512Vnni(const int8_t *a, const int8_t *b, int8_t *dst, size_t row,
+                                                         size_t col, size_t deep_4, size_t stride,
+                                                         const int32_t *input_sum, const int32_t *bias,
+                                                         const int32_t *left_shift, const int32_t *right_shift,
+                                                         const int32_t *multiplier, int32_t output_zp, int32_t mini,
+                                                         int32_t maxi, size_t per_channel) {
+  const __m256i ones = _mm256_set1_epi8(1);
+  const __m256i offset = _mm256_set1_epi8((char)0x80);
+  int32_t block[C8NUM * C8NUM];
+  for (size_t c = 0; c < col; c += C8NUM) {
+    size_t col_num = MSMIN(C8NUM, col - c);
+    const int8_t *b_block = b + c * deep_4;
+    __m256i b_sum = _mm256_setzero_si256();
+    for (size_t d = 0; d < deep_4; d += C4NUM) {
+      b_sum = _mm256_dpbusd_epi32(b_sum, ones, _mm256_loadu_si256((const __m256i *)(b_block + d * C8NUM)));
+    }
+    const __m256i init = _mm256_sub_epi32(_mm256_setzero_si256(), _mm256_slli_epi32(b_sum, C7NUM));
+    for (size_t r = 0; r < row; r += C8NUM) {
+      size_t row_num = MSMIN(C8NUM, row - r);
+      const int8_t *a_ptr = a + r * deep_4;
+      const int8_t *b_ptr = b_block;
+      __m256i acc[C8NUM];
+      for (int i = 0; i < C8NUM; ++i) {
+        acc[i] = init;
+      }
+      for (size_t d = 0; d < deep_4; d += C4NUM) {
+        __m256i b_vec = _mm256_loadu_si256((const __m256i *)b_ptr);
+        for (int i = 0; i < C8NUM; ++i) {
+          __m256i a_vec = _mm256_xor_si256(_mm256_set1_epi32(*(const int32_t *)(a_ptr + i * C4NUM)), offset);
+          acc[i] = _mm256_dpbusd_epi32(acc[i], a_vec, b_vec);
+        }
+        a_ptr += C8NUM * C4NUM;
+        b_ptr += C8NUM * C4NUM;
+      }
+      for (int i = 0; i < C8NUM; ++i) {
+        _mm256_storeu_si256((__m256i *)(block + i * C8NUM), acc[i]);
+      }
+      MatMulInt8Block8x8Requant(block, dst, r, row_num, c, col_num, row, stride, input_sum, bias, left_shift,
+                                right_shift, multiplier, output_zp, mini, maxi, per_channel);
+    }
+  }
+}
+#endif
+#endif
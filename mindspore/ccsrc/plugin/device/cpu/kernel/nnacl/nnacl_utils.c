@@ -25,3 +25,22 @@ uint32_t getHwCap(int hwcap_type) {
   return ret;
 }
 #endif
+
+#ifdef ENABLE_AVX512
+bool X86Avx512VnniSupport(void) {
+#ifdef _MSC_VER
+  return false;
+#else
+  return __builtin_cpu_supports("avx512vnni") && __builtin_cpu_supports("avx512bw") &&
+         __builtin_cpu_supports("avx512vl");
+#endif
+}
+
+bool X86Avx512Bf16Support(void) {
+#ifdef _MSC_VER
+  return false;
+#else
+  return __builtin_cpu_supports("avx512bf16");
+#endif
+}
+#endif
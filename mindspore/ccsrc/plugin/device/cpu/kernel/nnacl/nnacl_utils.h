@@ -18,6 +18,7 @@
 #define MINDSPORE_NNACL_NNACL_UTILS_H_
 
 #include <stdint.h>
+#include <stdbool.h>
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -26,6 +27,13 @@ extern "C" {
 uint32_t getHwCap(int hwcap_type);
 #endif
 
+#ifdef ENABLE_AVX512
+// Check at runtime whether the cpu supports the avx512 vnni instructions used by the int8 kernels.
+bool X86Avx512VnniSupport(void);
+// Check at runtime whether the cpu supports the avx512 bf16 instructions used by the bf16 kernels.
+bool X86Avx512Bf16Support(void);
+#endif
+
 #ifdef DEBUG
 #include <assert.h>
 #define NNACL_ASSERT(f) assert(f)
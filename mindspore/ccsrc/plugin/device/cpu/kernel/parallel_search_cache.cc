@@ -0,0 +1,137 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "plugin/device/cpu/kernel/parallel_search_cache.h"
+
+#include <cstdio>
+#include <fstream>
+
+#include "nlohmann/json.hpp"
+#include "utils/file_utils.h"
+#include "utils/log_adapter.h"
+#include "utils/ms_context.h"
+
+namespace mindspore {
+namespace kernel {
+namespace {
+constexpr char kParallelSearchCacheFile[] = "cpu_parallel_search.json";
+constexpr char kBlockSizes[] = "block_sizes";
+}  // namespace
+
+std::string GetCPUCompileCacheDir() {
+  auto context = MsContext::GetInstance();
+  std::string cache_path = context == nullptr ? "" : context->get_param<std::string>(MS_CTX_COMPILE_CACHE_PATH);
+  if (cache_path.empty()) {
+    cache_path = common::GetEnv("MS_COMPILER_CACHE_PATH");
+  }
+  if (cache_path.empty()) {
+    return "";
+  }
+  // the ranks of a job may run on the same machine, each of them keeps its own file.
+  std::string rank_id = common::GetEnv("RANK_ID");
+  return cache_path + "/rank_" + (rank_id.empty() ? "0" : rank_id);
+}
+
+ParallelSearchCache &ParallelSearchCache::GetInstance() {
+  static ParallelSearchCache instance;
+  return instance;
+}
+
+ParallelSearchCache::ParallelSearchCache() {
+  auto cache_dir = GetCPUCompileCacheDir();
+  if (cache_dir.empty()) {
+    return;
+  }
+  cache_file_ = cache_dir + "/" + kParallelSearchCacheFile;
+  Load();
+}
+
+void ParallelSearchCache::Load() {
+  std::ifstream ifs(cache_file_);
+  if (!ifs.is_open()) {
+    MS_LOG(INFO) << "No cpu parallel search cache in " << cache_file_;
+    return;
+  }
+  try {
+    auto js = nlohmann::json::parse(ifs);
+    for (auto &item : js.at(kBlockSizes).items()) {
+      block_sizes_[item.key()] = item.value().get<float>();
+    }
+  } catch (const std::exception &e) {
+    MS_LOG(WARNING) << "Failed to load the cpu parallel search cache " << cache_file_
+                    << ", it is ignored. Error: " << e.what();
+    block_sizes_.clear();
+    return;
+  }
+  MS_LOG(INFO) << "Load " << block_sizes_.size() << " cpu parallel search results from " << cache_file_;
+}
+
+bool ParallelSearchCache::Find(const std::string &key, float *block_size) {
+  MS_EXCEPTION_IF_NULL(block_size);
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = block_sizes_.find(key);
+  if (iter == block_sizes_.end()) {
+    ++miss_count_;
+    return false;
+  }
+  ++hit_count_;
+  *block_size = iter->second;
+  return true;
+}
+
+void ParallelSearchCache::Insert(const std::string &key, float block_size) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = block_sizes_.find(key);
+  if (iter != block_sizes_.end() && iter->second == block_size) {
+    return;
+  }
+  block_sizes_[key] = block_size;
+  dirty_ = true;
+}
+
+void ParallelSearchCache::Save() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  MS_LOG(INFO) << "Cpu parallel search cache hit: " << hit_count_ << ", miss: " << miss_count_;
+  if (cache_file_.empty() || !dirty_) {
+    return;
+  }
+  auto cache_dir = FileUtils::CreateNotExistDirs(GetCPUCompileCacheDir(), true);
+  if (!cache_dir.has_value()) {
+    MS_LOG(WARNING) << "Failed to create the directory of the cpu parallel search cache " << cache_file_;
+    return;
+  }
+  nlohmann::json js;
+  js[kBlockSizes] = block_sizes_;
+  // write a temporary file first, so a job starting meanwhile never reads a half written cache.
+  std::string tmp_file = cache_file_ + ".tmp";
+  {
+    std::ofstream ofs(tmp_file);
+    if (!ofs.is_open()) {
+      MS_LOG(WARNING) << "Failed to open " << tmp_file << " to save the cpu parallel search cache.";
+      return;
+    }
+    ofs << js.dump(1);
+  }
+  if (std::rename(tmp_file.c_str(), cache_file_.c_str()) != 0) {
+    MS_LOG(WARNING) << "Failed to save the cpu parallel search cache to " << cache_file_;
+    (void)std::remove(tmp_file.c_str());
+    return;
+  }
+  dirty_ = false;
+  MS_LOG(INFO) << "Save " << block_sizes_.size() << " cpu parallel search results to " << cache_file_;
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,66 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_KERNEL_PARALLEL_SEARCH_CACHE_H_
+#define MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_KERNEL_PARALLEL_SEARCH_CACHE_H_
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "utils/ms_utils.h"
+
+namespace mindspore {
+namespace kernel {
+// Get the directory of the cpu compile cache files under the compile cache path of the rank, empty if the compile
+// cache path is not set.
+std::string GetCPUCompileCacheDir();
+
+// The block sizes found by ParallelLaunchAutoSearch, keyed by the kernel type, the shapes and the thread number.
+// The kernels of the same key share the result in the process, and when the compile cache path is set, the results
+// are loaded from and saved to the cache file under it, so the next job starts at the searched block sizes.
+class ParallelSearchCache {
+ public:
+  static ParallelSearchCache &GetInstance();
+
+  // Get the searched block size of the key, return false if it is not cached.
+  bool Find(const std::string &key, float *block_size);
+  void Insert(const std::string &key, float block_size);
+  // Write the cache file if there are new results.
+  void Save();
+
+  size_t hit_count() const { return hit_count_; }
+  size_t miss_count() const { return miss_count_; }
+
+ private:
+  ParallelSearchCache();
+  ~ParallelSearchCache() = default;
+  DISABLE_COPY_AND_ASSIGN(ParallelSearchCache)
+  void Load();
+
+  // empty if the compile cache path is not set.
+  std::string cache_file_;
+  std::mutex mutex_;
+  std::unordered_map<std::string, float> block_sizes_;
+  bool dirty_{false};
+  std::atomic_size_t hit_count_{0};
+  std::atomic_size_t miss_count_{0};
+};
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_PLUGIN_DEVICE_CPU_KERNEL_PARALLEL_SEARCH_CACHE_H_
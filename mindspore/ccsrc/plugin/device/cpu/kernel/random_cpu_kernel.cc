@@ -40,8 +40,7 @@ void LaunchStandardNormal(RandomCpuKernelMod *content, unsigned int seed, const
   auto output = reinterpret_cast<float *>(outputs[0]->addr);
   // multithreading
   size_t lens = outputs[0]->size / sizeof(float);
-  auto thread_pool = GetActorMgrInnerThreadPool();
-  size_t max_thread_num = thread_pool->GetKernelThreadNum();
+  size_t max_thread_num = GetKernelThreadPool().GetSyncRunThreadNum();
   size_t thread_num = lens < kRandomBlockSize * max_thread_num ? std::ceil(lens / kRandomBlockSize) : max_thread_num;
   size_t once_compute_size = (lens + thread_num - 1) / thread_num;
   std::normal_distribution<float> distribution;
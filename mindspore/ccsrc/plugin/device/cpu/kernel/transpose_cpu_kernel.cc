@@ -157,8 +157,7 @@ void TransposeFwdCpuKernelMod::ParallelRun(const T *input_addr, T *output_addr,
   } else if constexpr (std::is_same_v<T, bool>) {
     TransposeDims = &TransposeDimsBool;
   }
-  auto thread_pool = GetActorMgrInnerThreadPool();
-  size_t thread_num = thread_pool->GetKernelThreadNum();
+  size_t thread_num = GetKernelThreadPool().GetSyncRunThreadNum();
   auto task = [this, &TransposeDims, input_addr, output_addr, output_shape, thread_num](size_t start, size_t end) {
     for (size_t idx = start; idx < end; idx++) {
       TransposeDims(input_addr, output_addr, output_shape, &transpose_param_, SizeToInt(idx), SizeToInt(thread_num));
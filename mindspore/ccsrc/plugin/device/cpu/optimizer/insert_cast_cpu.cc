@@ -29,6 +29,7 @@
 #include "backend/common/session/kernel_graph.h"
 #include "include/common/utils/utils.h"
 #include "utils/ms_context.h"
+#include "utils/ms_utils.h"
 #include "kernel/common_utils.h"
 #include "base/core_ops.h"
 
@@ -36,6 +37,35 @@ namespace mindspore {
 namespace opt {
 namespace {
 constexpr unsigned int kLstmReserveIndex = 3;
+constexpr auto kEnableBf16Env = "MS_CPU_ENABLE_BF16";
+
+bool IsBf16Enabled() {
+  static const bool enable_bf16 = common::GetEnv(kEnableBf16Env) == "1";
+  return enable_bf16;
+}
+
+// Switch the fp32 matmul to the bf16 kernel, the fp32 to bf16 casts of the inputs are inserted by InsertCast later,
+// the output keeps fp32 because the bf16 kernel accumulates in fp32.
+void SelectBf16MatMulKernel(const CNodePtr &cnode) {
+  MS_EXCEPTION_IF_NULL(cnode);
+  if (!IsPrimitiveCNode(cnode, prim::kPrimMatMul) && !IsPrimitiveCNode(cnode, prim::kPrimBatchMatMul)) {
+    return;
+  }
+  auto build_info = AnfAlgo::GetSelectKernelBuildInfo(cnode);
+  if (build_info == nullptr) {
+    return;
+  }
+  auto input_types = build_info->GetAllInputDeviceTypes();
+  if (input_types.empty() ||
+      std::any_of(input_types.begin(), input_types.end(), [](TypeId type) { return type != kNumberTypeFloat32; })) {
+    return;
+  }
+  kernel::KernelBuildInfo::KernelBuildInfoBuilder builder(build_info);
+  builder.SetInputsDeviceType(std::vector<TypeId>(input_types.size(), kNumberTypeBFloat16));
+  AnfAlgo::SetSelectKernelBuildInfo(builder.Build(), cnode.get());
+  MS_LOG(INFO) << "Select the bf16 kernel for " << cnode->fullname_with_scope();
+}
+
 AnfNodePtr AddCastOpNodeToGraph(const FuncGraphPtr &func_graph, const AnfNodePtr &input, const std::string &format,
                                 const TypeId &input_type, const TypeId &output_type,
                                 const abstract::BaseShapePtr &origin_shape, const TypeId &origin_type) {
@@ -194,6 +224,9 @@ bool InsertCastCPU::Run(const FuncGraphPtr &func_graph) {
   for (auto node : node_list) {
     if (node != nullptr && node->isa<CNode>() && AnfUtils::IsRealKernel(node)) {
       CNodePtr cnode = node->cast<CNodePtr>();
+      if (IsBf16Enabled()) {
+        SelectBf16MatMulKernel(cnode);
+      }
       InsertCast(func_graph, cnode);
     }
   }
@@ -15,9 +15,97 @@
  */
 
 #include "ps/ps_cache/embedding_hash_map.h"
+#include <algorithm>
+#include "include/common/thread_pool.h"
+#include "utils/ms_exception.h"
 
 namespace mindspore {
 namespace ps {
+namespace {
+// The batch is looked up by one thread if it is small, since handing it to the pool costs more than the lookup.
+constexpr size_t kMaxLookupThreadNum = 16;
+constexpr size_t kMinIdsPerLookupThread = 10000;
+// Keep the table at most half full, and rehash when the deleted slots take a quarter of it.
+constexpr size_t kTableLoadFactorInverse = 2;
+constexpr size_t kTableMaxUsedRatio = 4;
+}  // namespace
+
+EmbeddingIdTable::EmbeddingIdTable(size_t max_size) {
+  capacity_ = kGroupSize;
+  shift_ = 64 - 2;
+  while (capacity_ < max_size * kTableLoadFactorInverse) {
+    capacity_ <<= 1;
+    --shift_;
+  }
+  ids_.resize(capacity_, kEmptyId);
+  indexes_.resize(capacity_, INVALID_INDEX_VALUE);
+}
+
+void EmbeddingIdTable::Insert(const int id, const int index) {
+  if (IsReservedId(id)) {
+    reserved_indexes_[id - kEmptyId] = index;
+    return;
+  }
+  if ((size_ + deleted_num_ + 1) * kTableMaxUsedRatio > capacity_ * (kTableMaxUsedRatio - 1)) {
+    Rehash();
+  }
+  size_t pos = GroupStart(id);
+  while (true) {
+    const int *group = ids_.data() + pos;
+    auto deleted = MatchGroup(group, kDeletedId);
+    auto available = MatchGroup(group, kEmptyId) | deleted;
+    if (available != 0) {
+      auto slot = static_cast<size_t>(__builtin_ctz(available));
+      if ((deleted & (1U << slot)) != 0) {
+        --deleted_num_;
+      }
+      ids_[pos + slot] = id;
+      indexes_[pos + slot] = index;
+      ++size_;
+      return;
+    }
+    pos = (pos + kGroupSize) & (capacity_ - 1);
+  }
+}
+
+bool EmbeddingIdTable::Erase(const int id) {
+  if (IsReservedId(id)) {
+    if (reserved_indexes_[id - kEmptyId] == INVALID_INDEX_VALUE) {
+      return false;
+    }
+    reserved_indexes_[id - kEmptyId] = INVALID_INDEX_VALUE;
+    return true;
+  }
+  auto slot = FindSlot(id);
+  if (slot == capacity_) {
+    return false;
+  }
+  // No probe passes a group having an empty slot, so the slot can be emptied instead of being marked as deleted.
+  if (MatchGroup(ids_.data() + (slot & ~(kGroupSize - 1)), kEmptyId) != 0) {
+    ids_[slot] = kEmptyId;
+  } else {
+    ids_[slot] = kDeletedId;
+    ++deleted_num_;
+  }
+  indexes_[slot] = INVALID_INDEX_VALUE;
+  --size_;
+  return true;
+}
+
+void EmbeddingIdTable::Rehash() {
+  std::vector<int> ids(capacity_, kEmptyId);
+  std::vector<int> indexes(capacity_, INVALID_INDEX_VALUE);
+  ids_.swap(ids);
+  indexes_.swap(indexes);
+  size_ = 0;
+  deleted_num_ = 0;
+  for (size_t i = 0; i < capacity_; ++i) {
+    if (ids[i] != kEmptyId && ids[i] != kDeletedId) {
+      Insert(ids[i], indexes[i]);
+    }
+  }
+}
+
 int EmbeddingHashMap::ParseData(const int id, int *const swap_out_index, int *const swap_out_ids,
                                 const size_t data_step, const size_t graph_running_step, size_t *const swap_out_size,
                                 bool *const need_wait_graph) {
@@ -32,7 +120,7 @@ int EmbeddingHashMap::ParseData(const int id, int *const swap_out_index, int *co
 
   if (!need_swap) {
     hash_count_++;
-    (void)hash_id_to_index_.emplace(id, hash_index);
+    hash_id_to_index_.Insert(id, hash_index);
     hash_map_elements_[hash_index].set_id(id);
     hash_map_elements_[hash_index].set_step(data_step);
     return hash_index;
@@ -41,13 +129,97 @@ int EmbeddingHashMap::ParseData(const int id, int *const swap_out_index, int *co
   swap_out_index[*swap_out_size] = hash_index;
   swap_out_ids[*swap_out_size] = hash_map_elements_[hash_index].id_;
   (*swap_out_size)++;
-  (void)hash_id_to_index_.erase(hash_map_elements_[hash_index].id_);
-  (void)hash_id_to_index_.emplace(id, hash_index);
+  (void)hash_id_to_index_.Erase(hash_map_elements_[hash_index].id_);
+  hash_id_to_index_.Insert(id, hash_index);
   hash_map_elements_[hash_index].set_id(id);
   hash_map_elements_[hash_index].set_step(data_step);
   return hash_index;
 }
 
+size_t EmbeddingHashMap::Lookup(const int *ids, const size_t ids_len, const size_t data_step, int *const hash_index) {
+  MS_EXCEPTION_IF_NULL(ids);
+  MS_EXCEPTION_IF_NULL(hash_index);
+  // Each thread scans the whole batch for the ids of its shard, and the shard number is a power of two to be masked.
+  // The current thread joins the threads of the pool to look up the shards.
+  auto &thread_pool = common::ThreadPool::GetInstance();
+  size_t max_thread_num = std::min(thread_pool.GetSyncRunThreadNum() + 1, kMaxLookupThreadNum);
+  max_thread_num = std::min(ids_len / kMinIdsPerLookupThread + 1, max_thread_num);
+  size_t thread_num = 1;
+  while (thread_num * 2 <= max_thread_num) {
+    thread_num *= 2;
+  }
+  if (thread_num == 1) {
+    size_t hit_count = 0;
+    LookupTask(ids, ids_len, data_step, 0, 1, hash_index, &hit_count);
+    return hit_count;
+  }
+  std::vector<size_t> hit_counts(thread_num, 0);
+  auto task = [this, ids, ids_len, data_step, thread_num, hash_index, &hit_counts](size_t start, size_t end) {
+    for (size_t i = start; i < end; ++i) {
+      LookupTask(ids, ids_len, data_step, i, thread_num, hash_index, &hit_counts[i]);
+    }
+    return common::SUCCESS;
+  };
+  if (!thread_pool.ParallelFor(thread_num, 1, task)) {
+    MsException::Instance().CheckException();
+    MS_LOG(EXCEPTION) << "Looking up " << ids_len << " ids by " << thread_num << " shards failed.";
+  }
+  size_t hit_count = 0;
+  for (size_t i = 0; i < thread_num; ++i) {
+    hit_count += hit_counts[i];
+  }
+  return hit_count;
+}
+
+void EmbeddingHashMap::LookupTask(const int *ids, const size_t ids_len, const size_t data_step, const size_t shard_id,
+                                  const size_t shard_num, int *const hash_index, size_t *const hit_count) {
+  for (size_t i = 0; i < ids_len; ++i) {
+    if ((static_cast<size_t>(static_cast<uint32_t>(ids[i])) & (shard_num - 1)) != shard_id) {
+      continue;
+    }
+    auto index = hash_id_to_index_.Find(ids[i]);
+    hash_index[i] = index;
+    if (index != INVALID_INDEX_VALUE && hash_map_elements_[index].step_ != data_step) {
+      hash_map_elements_[index].set_step(data_step);
+      ++(*hit_count);
+    }
+  }
+}
+
+size_t EmbeddingHashMap::ParseData(const int *ids, const size_t ids_len, const size_t data_step,
+                                   const size_t graph_running_step, int *const hash_index,
+                                   HashSwapInfo *const swap_info, bool *const need_wait_graph) {
+  MS_EXCEPTION_IF_NULL(ids);
+  MS_EXCEPTION_IF_NULL(hash_index);
+  MS_EXCEPTION_IF_NULL(swap_info);
+  swap_info->hash_hit_count += Lookup(ids, ids_len, data_step, hash_index);
+  for (size_t i = 0; i < ids_len; ++i) {
+    if (hash_index[i] != INVALID_INDEX_VALUE) {
+      continue;
+    }
+    // The id repeated in the batch is inserted at its first appearance.
+    auto index = hash_id_to_index_.Find(ids[i]);
+    if (index != INVALID_INDEX_VALUE) {
+      hash_index[i] = index;
+      continue;
+    }
+    index = ParseData(ids[i], swap_info->swap_out_index, swap_info->swap_out_ids, data_step, graph_running_step,
+                      &swap_info->swap_out_size, need_wait_graph);
+    if (index == INVALID_INDEX_VALUE) {
+      return i;
+    }
+    hash_index[i] = index;
+    if (swap_info->swap_in_index != nullptr) {
+      swap_info->swap_in_index[swap_info->swap_in_size] = index;
+    }
+    if (swap_info->swap_in_ids != nullptr) {
+      swap_info->swap_in_ids[swap_info->swap_in_size] = ids[i];
+    }
+    swap_info->swap_in_size++;
+  }
+  return ids_len;
+}
+
 int EmbeddingHashMap::FindInsertionPos(const size_t, const size_t graph_running_step, bool *const need_swap,
                                        bool *const need_wait_graph) {
   MS_EXCEPTION_IF_NULL(need_swap);
@@ -85,9 +257,7 @@ int EmbeddingHashMap::FindInsertionPos(const size_t, const size_t graph_running_
 void EmbeddingHashMap::DumpHashMap() {
   MS_LOG(INFO) << "Dump hash map info begin, hash_capacity: " << hash_capacity_ << " hash_count: " << hash_count_;
   MS_LOG(INFO) << "Dump hash_id_to_index: ";
-  for (auto iter = hash_id_to_index_.begin(); iter != hash_id_to_index_.end(); ++iter) {
-    MS_LOG(INFO) << "  id: " << iter->first << " index: " << iter->second;
-  }
+  hash_id_to_index_.ForEach([](int id, int index) { MS_LOG(INFO) << "  id: " << id << " index: " << index; });
   MS_LOG(INFO) << "Dump hash_map_unit: ";
   for (size_t i = 0; i < hash_map_elements_.size(); i++) {
     if (!hash_map_elements_[i].IsEmpty()) {
@@ -18,10 +18,14 @@
 #define MINDSPORE_CCSRC_PS_PS_CACHE_EMBEDDING_HASH_MAP_H_
 
 #include <math.h>
+#include <climits>
 #include <utility>
 #include <memory>
 #include <vector>
-#include "utils/hash_map.h"
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#include "utils/log_adapter.h"
 #include "utils/convert_utils_base.h"
 
 namespace mindspore {
@@ -39,6 +43,111 @@ struct HashMapElement {
   void set_step(size_t step) { step_ = step; }
 };
 
+// The open addressing table from id to the index in the hash table. The slots are probed by groups, and all the ids
+// of a group are compared at once by SIMD instructions if supported. The ids INT_MIN and INT_MIN + 1 mark the empty and
+// the deleted slots, so they are kept in the side slots out of the table.
+class EmbeddingIdTable {
+ public:
+  explicit EmbeddingIdTable(size_t max_size);
+  ~EmbeddingIdTable() = default;
+
+  // Return the index of the id, or INVALID_INDEX_VALUE if the id is not in the table.
+  int Find(const int id) const {
+    if (IsReservedId(id)) {
+      return reserved_indexes_[id - kEmptyId];
+    }
+    auto slot = FindSlot(id);
+    return slot == capacity_ ? INVALID_INDEX_VALUE : indexes_[slot];
+  }
+  // The id must not be in the table.
+  void Insert(const int id, const int index);
+  bool Erase(const int id);
+  size_t size() const { return size_ + ReservedIdNum(); }
+  template <typename Func>
+  void ForEach(Func &&func) const {
+    for (int i = 0; i < kReservedIdNum; ++i) {
+      if (reserved_indexes_[i] != INVALID_INDEX_VALUE) {
+        func(kEmptyId + i, reserved_indexes_[i]);
+      }
+    }
+    for (size_t i = 0; i < capacity_; ++i) {
+      if (ids_[i] != kEmptyId && ids_[i] != kDeletedId) {
+        func(ids_[i], indexes_[i]);
+      }
+    }
+  }
+
+  static constexpr size_t kGroupSize = 4;
+
+ private:
+  static constexpr int kEmptyId = INT_MIN;
+  static constexpr int kDeletedId = INT_MIN + 1;
+  static constexpr int kReservedIdNum = 2;
+
+  static bool IsReservedId(const int id) { return id == kEmptyId || id == kDeletedId; }
+  size_t ReservedIdNum() const {
+    return static_cast<size_t>(reserved_indexes_[0] != INVALID_INDEX_VALUE) +
+           static_cast<size_t>(reserved_indexes_[1] != INVALID_INDEX_VALUE);
+  }
+
+  // Fibonacci hashing, the high bits of the product are used to locate the group.
+  size_t GroupStart(const int id) const {
+    constexpr uint64_t kGoldenRatio = 0x9E3779B97F4A7C15ULL;
+    return static_cast<size_t>((static_cast<uint64_t>(static_cast<uint32_t>(id)) * kGoldenRatio) >> shift_) &
+           ~(kGroupSize - 1);
+  }
+  // Return the bit mask of the slots in the group whose id equals the given id.
+  static uint32_t MatchGroup(const int *group, const int id) {
+#if defined(__SSE2__)
+    auto eq = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(group)), _mm_set1_epi32(id));
+    return static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(eq)));
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < kGroupSize; ++i) {
+      mask |= static_cast<uint32_t>(group[i] == id) << i;
+    }
+    return mask;
+#endif
+  }
+  // Return the slot of the id, or capacity_ if the id is not in the table.
+  size_t FindSlot(const int id) const {
+    size_t pos = GroupStart(id);
+    while (true) {
+      const int *group = ids_.data() + pos;
+      auto match = MatchGroup(group, id);
+      if (match != 0) {
+        return pos + static_cast<size_t>(__builtin_ctz(match));
+      }
+      // The ids are never moved over an empty slot, so the probe stops at the group having one.
+      if (MatchGroup(group, kEmptyId) != 0) {
+        return capacity_;
+      }
+      pos = (pos + kGroupSize) & (capacity_ - 1);
+    }
+  }
+  void Rehash();
+
+  size_t capacity_;
+  size_t shift_;
+  size_t size_{0};
+  size_t deleted_num_{0};
+  std::vector<int> ids_;
+  std::vector<int> indexes_;
+  // The indexes of the ids kEmptyId and kDeletedId, size_ does not count them.
+  int reserved_indexes_[kReservedIdNum]{INVALID_INDEX_VALUE, INVALID_INDEX_VALUE};
+};
+
+// The swap in and swap out lists filled when parsing a batch of ids.
+struct HashSwapInfo {
+  int *swap_in_index{nullptr};
+  int *swap_in_ids{nullptr};
+  size_t swap_in_size{0};
+  int *swap_out_index{nullptr};
+  int *swap_out_ids{nullptr};
+  size_t swap_out_size{0};
+  size_t hash_hit_count{0};
+};
+
 // Hash table is held in device, HashMap is used to manage hash table in host.
 class EmbeddingHashMap {
  public:
@@ -49,7 +158,8 @@ class EmbeddingHashMap {
         current_batch_start_pos_(0),
         graph_running_index_num_(0),
         graph_running_index_pos_(0),
-        expired_element_full_(false) {
+        expired_element_full_(false),
+        hash_id_to_index_(hash_capacity) {
     hash_map_elements_.resize(hash_capacity);
     // In multi-device mode, embedding table are distributed on different devices by ID interval,
     // and IDs outside the range of local device will use the front and back positions of the table,
@@ -61,9 +171,20 @@ class EmbeddingHashMap {
   virtual ~EmbeddingHashMap() = default;
   int ParseData(const int id, int *const swap_out_index, int *const swap_out_ids, const size_t data_step,
                 const size_t graph_running_step, size_t *const swap_out_size, bool *const need_wait_graph);
+  // Look up a batch of ids on the common thread pool, the ids are sharded by value so that each id is handled by one
+  // thread.
+  // The index of a found id is written to hash_index and its step is refreshed to data_step, INVALID_INDEX_VALUE is
+  // written for a missed id. Return the number of the found ids whose step is refreshed.
+  size_t Lookup(const int *ids, const size_t ids_len, const size_t data_step, int *const hash_index);
+  // Parse a batch of ids in one pass: the found ids are refreshed as Lookup does, the missed ids are inserted in
+  // order and appended to the swap in list, the ids replaced by them are appended to the swap out list. Return the
+  // number of the parsed ids, which is less than ids_len if there is no space until the running graph finishes, and
+  // the remaining ids should be parsed again after that.
+  size_t ParseData(const int *ids, const size_t ids_len, const size_t data_step, const size_t graph_running_step,
+                   int *const hash_index, HashSwapInfo *const swap_info, bool *const need_wait_graph);
   size_t hash_step(const int hash_index) const { return hash_map_elements_[hash_index].step_; }
   void set_hash_step(const int hash_index, const size_t step) { hash_map_elements_[hash_index].set_step(step); }
-  const mindspore::HashMap<int, int> &hash_id_to_index() const { return hash_id_to_index_; }
+  const EmbeddingIdTable &hash_id_to_index() const { return hash_id_to_index_; }
   size_t hash_capacity() const { return hash_capacity_; }
   void DumpHashMap();
   void Reset();
@@ -71,16 +192,18 @@ class EmbeddingHashMap {
  private:
   int FindInsertionPos(const size_t data_step, const size_t graph_running_step, bool *const need_swap,
                        bool *const need_wait_graph);
+  void LookupTask(const int *ids, const size_t ids_len, const size_t data_step, const size_t shard_id,
+                  const size_t shard_num, int *const hash_index, size_t *const hit_count);
   size_t hash_count_;
   size_t hash_capacity_;
   std::vector<HashMapElement> hash_map_elements_;
-  mindspore::HashMap<int, int> hash_id_to_index_;
   size_t current_pos_;
   size_t current_batch_start_pos_;
   size_t graph_running_index_num_;
   size_t graph_running_index_pos_;
   std::unique_ptr<int[]> graph_running_index_;
   bool expired_element_full_;
+  EmbeddingIdTable hash_id_to_index_;
 };
 }  // namespace ps
 }  // namespace mindspore
@@ -440,78 +440,6 @@ bool PsCacheManager::ProcessData() {
   return true;
 }
 
-bool PsCacheManager::CheckCacheHitOrOutRangeTask(const int *batch_ids, const size_t batch_ids_len, int *hash_index,
-                                                 bool *in_device, bool *out_range, size_t *hash_hit_count) {
-  MS_ERROR_IF_NULL(batch_ids);
-  MS_ERROR_IF_NULL(hash_index);
-  MS_ERROR_IF_NULL(in_device);
-  MS_ERROR_IF_NULL(hash_hit_count);
-  MS_ERROR_IF_NULL(embedding_device_cache_);
-  auto &device_hash_map = embedding_device_cache_->device_hash_map_;
-  MS_ERROR_IF_NULL(device_hash_map);
-  const auto &hash_id_to_index = device_hash_map->hash_id_to_index();
-
-  for (size_t i = 0; i < batch_ids_len; ++i) {
-    if (batch_ids[i] < emb_table_slice_bounds_.first) {
-      hash_index[i] = batch_ids[i] - emb_table_slice_bounds_.first + cache_indices_bounds_.first;
-      out_range[i] = true;
-      continue;
-    }
-    if (batch_ids[i] >= emb_table_slice_bounds_.second) {
-      hash_index[i] = batch_ids[i] + cache_indices_bounds_.second;
-      out_range[i] = true;
-      continue;
-    }
-    auto iter = hash_id_to_index.find(batch_ids[i]);
-    if (iter != hash_id_to_index.end()) {
-      hash_index[i] = iter->second + cache_indices_bounds_.first;
-      if (device_hash_map->hash_step(iter->second) != data_step_) {
-        ++(*hash_hit_count);
-        device_hash_map->set_hash_step(iter->second, data_step_);
-      }
-      in_device[i] = true;
-    }
-  }
-  return true;
-}
-
-bool PsCacheManager::CheckCacheHitOrOutRange(const int *batch_ids, const size_t batch_ids_len, int *hash_index,
-                                             bool *in_device, bool *out_range) {
-  MS_ERROR_IF_NULL(batch_ids);
-  MS_ERROR_IF_NULL(hash_index);
-  MS_ERROR_IF_NULL(in_device);
-  MS_ERROR_IF_NULL(out_range);
-
-  size_t thread_num = batch_ids_len / kMaxIdsPerThread + 1;
-  thread_num = thread_num > kMaxThreadNum ? kMaxThreadNum : thread_num;
-  std::thread threads[kMaxThreadNum];
-  size_t hash_hit_count[kMaxThreadNum] = {0};
-  size_t i = 0;
-  size_t task_offset = 0;
-
-  for (; i < thread_num; ++i) {
-    if (task_offset >= batch_ids_len) {
-      break;
-    }
-    size_t task_proc_lens = batch_ids_len / thread_num + (i < (batch_ids_len % thread_num) ? 1 : 0);
-    threads[i] =
-      std::thread(&PsCacheManager::CheckCacheHitOrOutRangeTask, this, batch_ids + task_offset, task_proc_lens,
-                  hash_index + task_offset, in_device + task_offset, out_range + task_offset, hash_hit_count + i);
-    task_offset += task_proc_lens;
-  }
-  if (task_offset != batch_ids_len) {
-    MS_LOG(WARNING) << "Ps cache check id in device inadequate, total:" << batch_ids_len << " checked:" << task_offset;
-  }
-
-  for (size_t j = 0; j < i; j++) {
-    threads[j].join();
-  }
-  for (size_t j = 0; j < i; j++) {
-    statistics_info_.hash_hit_count_ += hash_hit_count[j];
-  }
-  return true;
-}
-
 bool PsCacheManager::ResetEmbeddingHashMap() {
   MS_ERROR_IF_NULL(embedding_device_cache_);
   const auto &device_hash_map = embedding_device_cache_->device_hash_map_;
@@ -529,31 +457,62 @@ bool PsCacheManager::ResetEmbeddingHashMap() {
 bool PsCacheManager::ParseData(const int *batch_ids, const size_t batch_ids_len, int *hash_index) {
   MS_ERROR_IF_NULL(batch_ids);
   MS_ERROR_IF_NULL(hash_index);
+  MS_ERROR_IF_NULL(embedding_device_cache_);
+  auto &device_hash_map = embedding_device_cache_->device_hash_map_;
+  MS_ERROR_IF_NULL(device_hash_map);
   statistics_info_.batch_id_count_ = batch_ids_len;
-  std::unique_ptr<bool[]> in_device = std::make_unique<bool[]>(batch_ids_len);
-  std::unique_ptr<bool[]> out_range = std::make_unique<bool[]>(batch_ids_len);
-  if (memset_s(in_device.get(), batch_ids_len * sizeof(bool), 0, batch_ids_len * sizeof(bool))) {
-    MS_LOG(EXCEPTION) << "Initialize in_device array failed.";
-  }
-  if (memset_s(out_range.get(), batch_ids_len * sizeof(bool), 0, batch_ids_len * sizeof(bool))) {
-    MS_LOG(EXCEPTION) << "Initialize out_range array failed.";
+  // The ids out of the range of local device use the reserved positions, the others are parsed by the hash map.
+  std::vector<int> local_ids;
+  std::vector<size_t> local_pos;
+  local_ids.reserve(batch_ids_len);
+  local_pos.reserve(batch_ids_len);
+  for (size_t i = 0; i < batch_ids_len; ++i) {
+    if (batch_ids[i] < emb_table_slice_bounds_.first) {
+      hash_index[i] = batch_ids[i] - emb_table_slice_bounds_.first + cache_indices_bounds_.first;
+    } else if (batch_ids[i] >= emb_table_slice_bounds_.second) {
+      hash_index[i] = batch_ids[i] + cache_indices_bounds_.second;
+    } else {
+      local_ids.push_back(batch_ids[i]);
+      local_pos.push_back(i);
+    }
   }
-  RETURN_IF_FALSE(CheckCacheHitOrOutRange(batch_ids, batch_ids_len, hash_index, in_device.get(), out_range.get()));
   RETURN_IF_FALSE(ResetEmbeddingHashMap());
-  for (size_t i = 0; i < batch_ids_len; i++) {
-    if (in_device[i] || out_range[i]) {
-      continue;
-    }
-    bool need_swap_host_to_device = true;
-    bool need_swap_device_to_host = true;
-    int index = INVALID_INDEX_VALUE;
-    RETURN_IF_FALSE(ParseDeviceData(batch_ids[i], &need_swap_device_to_host, &need_swap_host_to_device, &index));
-    hash_index[i] = index + cache_indices_bounds_.first;
-    if (need_swap_host_to_device) {
-      RETURN_IF_FALSE(ParseHostDataHostToDevice(batch_ids[i]));
+
+  HashSwapInfo swap_info;
+  swap_info.swap_in_index = embedding_device_cache_->host_to_device_index.get();
+  swap_info.swap_in_ids = embedding_device_cache_->host_to_device_ids.get();
+  swap_info.swap_out_index = embedding_device_cache_->device_to_host_index.get();
+  swap_info.swap_out_ids = embedding_device_cache_->device_to_host_ids.get();
+  MS_ERROR_IF_NULL(swap_info.swap_in_index);
+  MS_ERROR_IF_NULL(swap_info.swap_in_ids);
+  MS_ERROR_IF_NULL(swap_info.swap_out_index);
+  MS_ERROR_IF_NULL(swap_info.swap_out_ids);
+  std::vector<int> local_index(local_ids.size(), INVALID_INDEX_VALUE);
+  size_t parsed_size = 0;
+  while (true) {
+    parsed_size += device_hash_map->ParseData(local_ids.data() + parsed_size, local_ids.size() - parsed_size,
+                                              data_step_, graph_running_step_, local_index.data() + parsed_size,
+                                              &swap_info, &device_need_wait_graph_);
+    if (parsed_size == local_ids.size()) {
+      break;
     }
-    if (need_swap_device_to_host) {
-      RETURN_IF_FALSE(ParseHostDataDeviceToHost());
+    RETURN_IF_FALSE(WaitGraphRun());
+  }
+  statistics_info_.hash_hit_count_ += swap_info.hash_hit_count;
+  statistics_info_.host_to_device_size_ = swap_info.swap_in_size;
+  statistics_info_.device_to_host_size_ = swap_info.swap_out_size;
+  for (size_t i = 0; i < local_pos.size(); ++i) {
+    hash_index[local_pos[i]] = local_index[i] + cache_indices_bounds_.first;
+  }
+
+  // An id swapped out of device is replaced by the id swapped in at the same position, and one position is swapped in
+  // at most once in a batch, so the swap out list is walked along with the swap in list.
+  size_t swap_out_pos = 0;
+  for (size_t i = 0; i < swap_info.swap_in_size; ++i) {
+    RETURN_IF_FALSE(ParseHostDataHostToDevice(swap_info.swap_in_ids[i], i));
+    if (swap_out_pos < swap_info.swap_out_size &&
+        swap_info.swap_out_index[swap_out_pos] == swap_info.swap_in_index[i]) {
+      RETURN_IF_FALSE(ParseHostDataDeviceToHost(swap_out_pos++));
     }
   }
   return true;
@@ -573,69 +532,19 @@ bool PsCacheManager::WaitGraphRun() {
   return true;
 }
 
-bool PsCacheManager::ParseDeviceData(size_t id, bool *need_swap_device_to_host, bool *need_swap_host_to_device,
-                                     int *hash_index) {
-  MS_ERROR_IF_NULL(need_swap_device_to_host);
-  MS_ERROR_IF_NULL(need_swap_host_to_device);
-  MS_ERROR_IF_NULL(hash_index);
-  MS_ERROR_IF_NULL(embedding_device_cache_);
-  auto &device_hash_map = embedding_device_cache_->device_hash_map_;
-  MS_ERROR_IF_NULL(device_hash_map);
-
-  int index = INVALID_INDEX_VALUE;
-  const auto &hash_id_to_index = device_hash_map->hash_id_to_index();
-  const auto &iter = hash_id_to_index.find(id);
-  if (iter != hash_id_to_index.end()) {
-    *need_swap_device_to_host = false;
-    *need_swap_host_to_device = false;
-    index = iter->second;
-    if (device_hash_map->hash_step(index) != data_step_) {
-      statistics_info_.hash_hit_count_++;
-      device_hash_map->set_hash_step(index, data_step_);
-    }
-  } else {
-    int *device_to_host_index = embedding_device_cache_->device_to_host_index.get();
-    int *device_to_host_ids = embedding_device_cache_->device_to_host_ids.get();
-    int *host_to_device_index = embedding_device_cache_->host_to_device_index.get();
-    int *host_to_device_ids = embedding_device_cache_->host_to_device_ids.get();
-    MS_ERROR_IF_NULL(host_to_device_index);
-    MS_ERROR_IF_NULL(host_to_device_ids);
-    auto tmp_device_to_host_size = statistics_info_.device_to_host_size_;
-    while (true) {
-      index = device_hash_map->ParseData(id, device_to_host_index, device_to_host_ids, data_step_, graph_running_step_,
-                                         &(statistics_info_.device_to_host_size_), &device_need_wait_graph_);
-      if (index == INVALID_INDEX_VALUE) {
-        if (!WaitGraphRun()) {
-          return false;
-        }
-        continue;
-      }
-      host_to_device_index[statistics_info_.host_to_device_size_] = index;
-      host_to_device_ids[statistics_info_.host_to_device_size_] = id;
-      statistics_info_.host_to_device_size_++;
-      *need_swap_device_to_host = statistics_info_.device_to_host_size_ > tmp_device_to_host_size;
-      break;
-    }
-  }
-  *hash_index = index;
-  return true;
-}
-
-bool PsCacheManager::ParseHostDataHostToDevice(size_t id) {
+bool PsCacheManager::ParseHostDataHostToDevice(size_t id, size_t swap_pos) {
   MS_ERROR_IF_NULL(embedding_host_cache_);
   int *host_to_device_index = embedding_host_cache_->host_to_device_index.get();
   MS_ERROR_IF_NULL(host_to_device_index);
   auto &host_hash_map = embedding_host_cache_->host_hash_map_;
   MS_ERROR_IF_NULL(host_hash_map);
 
-  const auto &hash_id_to_index = host_hash_map->hash_id_to_index();
-  const auto &iter = hash_id_to_index.find(id);
-  if (iter != hash_id_to_index.end()) {
-    auto index = iter->second;
+  auto index = host_hash_map->hash_id_to_index().Find(static_cast<int>(id));
+  if (index != INVALID_INDEX_VALUE) {
     if (host_hash_map->hash_step(index) != data_step_) {
       host_hash_map->set_hash_step(index, data_step_);
     }
-    host_to_device_index[statistics_info_.host_to_device_size_ - 1] = index;
+    host_to_device_index[swap_pos] = index;
   } else {
     int *host_to_server_index = embedding_host_cache_->host_to_server_index.get();
     int *host_to_server_ids = embedding_host_cache_->host_to_server_ids.get();
@@ -644,14 +553,13 @@ bool PsCacheManager::ParseHostDataHostToDevice(size_t id) {
     MS_ERROR_IF_NULL(server_to_host_index);
     MS_ERROR_IF_NULL(server_to_host_ids);
     while (true) {
-      auto index =
-        host_hash_map->ParseData(id, host_to_server_index, host_to_server_ids, data_step_, graph_running_step_,
-                                 &statistics_info_.host_to_server_size_, &host_need_wait_graph_);
+      index = host_hash_map->ParseData(id, host_to_server_index, host_to_server_ids, data_step_, graph_running_step_,
+                                       &statistics_info_.host_to_server_size_, &host_need_wait_graph_);
       if (index == INVALID_INDEX_VALUE) {
         RETURN_IF_FALSE(WaitGraphRun());
         continue;
       }
-      host_to_device_index[statistics_info_.host_to_device_size_ - 1] = index;
+      host_to_device_index[swap_pos] = index;
       server_to_host_index[statistics_info_.server_to_host_size_] = index;
       server_to_host_ids[statistics_info_.server_to_host_size_++] = id;
       break;
@@ -660,7 +568,7 @@ bool PsCacheManager::ParseHostDataHostToDevice(size_t id) {
   return true;
 }
 
-bool PsCacheManager::ParseHostDataDeviceToHost() {
+bool PsCacheManager::ParseHostDataDeviceToHost(size_t swap_pos) {
   MS_ERROR_IF_NULL(embedding_device_cache_);
   MS_ERROR_IF_NULL(embedding_host_cache_);
   int *device_to_host_ids = embedding_device_cache_->device_to_host_ids.get();
@@ -670,27 +578,25 @@ bool PsCacheManager::ParseHostDataDeviceToHost() {
 
   auto &host_hash_map = embedding_host_cache_->host_hash_map_;
   MS_ERROR_IF_NULL(host_hash_map);
-  int swap_device_to_host_id = device_to_host_ids[statistics_info_.device_to_host_size_ - 1];
-  const auto &hash_id_to_index = host_hash_map->hash_id_to_index();
-  const auto &iter = hash_id_to_index.find(swap_device_to_host_id);
-  if (iter != hash_id_to_index.end()) {
-    auto index = iter->second;
+  int swap_device_to_host_id = device_to_host_ids[swap_pos];
+  auto index = host_hash_map->hash_id_to_index().Find(swap_device_to_host_id);
+  if (index != INVALID_INDEX_VALUE) {
     if (host_hash_map->hash_step(index) != data_step_) {
       host_hash_map->set_hash_step(index, data_step_);
     }
-    device_to_host_index[statistics_info_.device_to_host_size_ - 1] = index;
+    device_to_host_index[swap_pos] = index;
   } else {
     int *host_to_server_index = embedding_host_cache_->host_to_server_index.get();
     int *host_to_server_ids = embedding_host_cache_->host_to_server_ids.get();
     while (true) {
-      auto index =
+      index =
         host_hash_map->ParseData(swap_device_to_host_id, host_to_server_index, host_to_server_ids, data_step_,
                                  graph_running_step_, &statistics_info_.host_to_server_size_, &host_need_wait_graph_);
       if (index == INVALID_INDEX_VALUE) {
         RETURN_IF_FALSE(WaitGraphRun());
         continue;
       }
-      device_to_host_index[statistics_info_.device_to_host_size_ - 1] = index;
+      device_to_host_index[swap_pos] = index;
       break;
     }
   }
@@ -966,10 +872,10 @@ bool PsCacheManager::SyncHostEmbeddingTable() {
   std::unique_ptr<int[]> host_to_server_indices_ptr = std::make_unique<int[]>(swap_indices_lens);
   MS_ERROR_IF_NULL(host_to_server_indices_ptr);
   size_t idx = 0;
-  for (const auto &item : hash_id_to_index) {
-    host_to_server_ids_ptr[idx] = item.first;
-    host_to_server_indices_ptr[idx++] = item.second;
-  }
+  hash_id_to_index.ForEach([&](int id, int index) {
+    host_to_server_ids_ptr[idx] = id;
+    host_to_server_indices_ptr[idx++] = index;
+  });
   for (const auto &item : hash_tables_) {
     const auto &hash_info = item.second;
     if (hash_info.param_init_info_.param_type_ != kWeight) {
@@ -1013,10 +919,10 @@ bool PsCacheManager::SyncDeviceEmbeddingTable() {
   std::unique_ptr<int[]> device_to_server_indices_ptr = std::make_unique<int[]>(swap_indices_lens);
   MS_ERROR_IF_NULL(device_to_server_indices_ptr);
   size_t idx = 0;
-  for (const auto &item : hash_id_to_index) {
-    device_to_server_ids_ptr[idx] = item.first;
-    device_to_server_indices_ptr[idx++] = item.second;
-  }
+  hash_id_to_index.ForEach([&](int id, int index) {
+    device_to_server_ids_ptr[idx] = id;
+    device_to_server_indices_ptr[idx++] = index;
+  });
   for (const auto &item : hash_tables_) {
     const auto &hash_info = item.second;
     if (hash_info.param_init_info_.param_type_ != kWeight) {
@@ -260,10 +260,32 @@ bool MemScheduler::PostCompute(void *stream) {
       SwapOutAndFreeDevice(event->key, device_ptr, event->mem_size, stream);
     }
   }
+  if (stream != nullptr) {
+    PrefetchNextStep();
+  }
   ++current_step_;
   return true;
 }
 
+void MemScheduler::PrefetchNextStep() {
+  if (current_step_ + 1 >= total_step_) {
+    return;
+  }
+  auto &events = strategy_->GetPreComputeEvents(current_step_ + 1);
+  for (auto &event : events) {
+    MS_EXCEPTION_IF_NULL(event);
+    if (event->type != kSwapIn) {
+      continue;
+    }
+    bool from_init = true;
+    void *host_ptr = nullptr;
+    GetHostPtr(event->key, &host_ptr, &from_init);
+    if (host_ptr != nullptr && !from_init) {
+      mem_handler_->Prefetch(host_ptr, event->mem_size);
+    }
+  }
+}
+
 void MemScheduler::OptMemUsage(float mem_used_factor) {
   MS_EXCEPTION_IF_NULL(mem_handler_);
 
@@ -36,6 +36,9 @@ class MemHandler {
   virtual void FreeHost(void *ptr) = 0;
   virtual void SwapIn(const void *host_ptr, void *device_ptr, size_t mem_size, void *stream) = 0;
   virtual void SwapOut(const void *device_ptr, void *host_ptr, size_t mem_size, void *stream) = 0;
+  // Start to load the host memory which will be swapped in at the next step, the handlers which copy the memory
+  // asynchronously in the swap in don't need it.
+  virtual void Prefetch(const void *host_ptr, size_t mem_size) {}
 };
 
 class MemScheduler {
@@ -115,6 +118,8 @@ class MemScheduler {
 
   bool PreComputeGet(const std::shared_ptr<MemEvent> &event, void *stream);
 
+  void PrefetchNextStep();
+
   std::map<const void *, MemPriority> mem_priority_;
   std::map<const void *, std::vector<std::shared_ptr<MemEvent>>> mem_events_;
   std::set<const void *> manual_offload_keys_;
@@ -27,6 +27,7 @@
 #include "backend/common/optimizer/helper.h"
 #include "utils/anf_utils.h"
 #include "include/common/utils/config_manager.h"
+#include "include/common/thread_pool.h"
 #include "utils/log_adapter.h"
 #include "include/common/utils/convert_utils.h"
 #include "utils/ms_context.h"
@@ -193,6 +194,13 @@ void GraphScheduler::Clear(const ActorInfo &actor_info, const std::vector<Kernel
       return;
     }
     auto actor_set = actors_[actor_info];
+    // The graphs launched as a whole release the resource kept by their device contexts.
+    for (auto &super_kernel_actor : actor_set->super_kernel_actors_) {
+      if (super_kernel_actor != nullptr && !super_kernel_actor->device_contexts().empty() &&
+          super_kernel_actor->device_contexts()[0] != nullptr) {
+        super_kernel_actor->device_contexts()[0]->ReleaseGraph(super_kernel_actor->graph());
+      }
+    }
     auto base_actors = CollectActors(actor_set.get());
     for (auto &base_actor : base_actors) {
       MS_EXCEPTION_IF_NULL(base_actor);
@@ -291,10 +299,20 @@ void GraphScheduler::Initialize() {
   ComputeThreadNums(&actor_thread_num, &actor_and_kernel_thread_num);
   auto actor_manager = ActorMgr::GetActorMgrRef();
   MS_EXCEPTION_IF_NULL(actor_manager);
-  auto ret = actor_manager->Initialize(true, actor_thread_num, actor_and_kernel_thread_num);
+  // The kernels run on the common thread pool, so the actor thread pool only keeps the actor threads and the kernel
+  // threads are given to the common thread pool, otherwise the idle kernel threads of both pools spin on the cores.
+  auto ret = actor_manager->Initialize(true, actor_thread_num, actor_thread_num);
   if (ret != MINDRT_OK) {
     MS_LOG(EXCEPTION) << "Actor manager init failed.";
   }
+  common::ThreadPool::GetInstance().SetMaxThreadNum(actor_and_kernel_thread_num - actor_thread_num);
+  // The work stealing mode runs the successor actor on the same actor thread and steals actors between threads.
+  if (common::GetEnv("MS_DEV_ACTOR_WORK_STEALING") == "1") {
+    auto thread_pool = actor_manager->GetActorThreadPool();
+    MS_EXCEPTION_IF_NULL(thread_pool);
+    thread_pool->SetActorQueueMode(kWorkStealing);
+    MS_LOG(INFO) << "Enable the work stealing mode of actor thread pool.";
+  }
   common::SetOMPThreadNum();
   MS_LOG(INFO) << "The actor thread number: " << actor_thread_num
                << ", the kernel thread number: " << (actor_and_kernel_thread_num - actor_thread_num);
@@ -127,6 +127,8 @@ class DeviceContext {
 
   // Launch graph, device such as Ascend support the whole graph sink to the device executing.
   virtual bool LaunchGraph(const KernelGraphPtr &graph) const { return true; }
+  // Release the resource kept for launching the graph as a whole, the graph is not launched anymore.
+  virtual void ReleaseGraph(const KernelGraphPtr &graph) const {}
 
   // Launch a kernel via 'KernelMod' of the kernel.
   virtual bool LaunchKernel(const CNodePtr &kernel, const std::vector<AddressPtr> &inputs,
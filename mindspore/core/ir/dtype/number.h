@@ -199,6 +199,25 @@ class MS_CORE_API Float : public Number {
   }
 };
 
+// BFloat
+/// \brief BFloat defines a Number class whose type is bfloat16, which has the exponent bits of float32 and 7 mantissa
+/// bits.
+class MS_CORE_API BFloat : public Number {
+ public:
+  /// \brief Default constructor for BFloat.
+  BFloat() : Number(kNumberTypeBFloat16, static_cast<int>(BitsNum::eBits16), false) {}
+
+  /// \brief Destructor of BFloat.
+  ~BFloat() override {}
+  MS_DECLARE_PARENT(BFloat, Number)
+
+  TypeId generic_type_id() const override { return kNumberTypeFloat; }
+  TypePtr DeepCopy() const override { return std::make_shared<BFloat>(); }
+  std::string ToString() const override { return GetTypeName("BFloat"); }
+  std::string ToReprString() const override { return GetTypeName("bfloat"); }
+  std::string DumpText() const override { return std::string("BF") + std::to_string(nbits()); }
+};
+
 // Complex
 /// \brief Complex defines a Number class whose type is complex.
 class MS_CORE_API Complex : public Number {
@@ -240,6 +259,7 @@ GVAR_DEF(TypePtr, kUInt64, std::make_shared<UInt>(static_cast<int>(BitsNum::eBit
 GVAR_DEF(TypePtr, kFloat16, std::make_shared<Float>(static_cast<int>(BitsNum::eBits16)));
 GVAR_DEF(TypePtr, kFloat32, std::make_shared<Float>(static_cast<int>(BitsNum::eBits32)));
 GVAR_DEF(TypePtr, kFloat64, std::make_shared<Float>(static_cast<int>(BitsNum::eBits64)));
+GVAR_DEF(TypePtr, kBFloat16, std::make_shared<BFloat>());
 GVAR_DEF(TypePtr, kInt, std::make_shared<Int>());
 GVAR_DEF(TypePtr, kUInt, std::make_shared<UInt>());
 GVAR_DEF(TypePtr, kFloat, std::make_shared<Float>());
@@ -77,6 +77,7 @@ static mindspore::HashMap<TypeId, std::string> g_type_2_lable{
   {kNumberTypeFloat64, MS_TYPE2LABLE(kNumberTypeFloat64)},
   {kNumberTypeComplex64, MS_TYPE2LABLE(kNumberTypeComplex64)},
   {kNumberTypeComplex128, MS_TYPE2LABLE(kNumberTypeComplex128)},
+  {kNumberTypeBFloat16, MS_TYPE2LABLE(kNumberTypeBFloat16)},
   {kNumberTypeEnd, MS_TYPE2LABLE(kNumberTypeEnd)},
   {kObjectTypeMonad, MS_TYPE2LABLE(kObjectTypeMonad)},
   {kObjectTypeUMonad, MS_TYPE2LABLE(kObjectTypeUMonad)},
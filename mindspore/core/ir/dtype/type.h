@@ -239,7 +239,8 @@ class MS_CORE_API Object : public Type {
 const mindspore::HashMap<TypeId, std::string> type_name_map = {
   {kNumberTypeBool, "bool_"},      {kNumberTypeInt8, "int8"},       {kNumberTypeUInt8, "uint8"},
   {kNumberTypeInt16, "int16"},     {kNumberTypeInt32, "int32"},     {kNumberTypeInt64, "int64"},
-  {kNumberTypeFloat16, "float16"}, {kNumberTypeFloat32, "float32"}, {kNumberTypeFloat64, "float64"}};
+  {kNumberTypeFloat16, "float16"}, {kNumberTypeFloat32, "float32"}, {kNumberTypeFloat64, "float64"},
+  {kNumberTypeBFloat16, "bfloat16"}};
 
 const mindspore::HashMap<TypeId, int> type_priority_map = {
   {kNumberTypeBool, 0},    {kNumberTypeUInt8, 1},   {kNumberTypeInt8, 2},
@@ -93,6 +93,7 @@ TypePtr TypeIdToType(TypeId id) {
                                                                 {kNumberTypeFloat, kFloat32},
                                                                 {kNumberTypeFloat32, kFloat32},
                                                                 {kNumberTypeFloat64, kFloat64},
+                                                                {kNumberTypeBFloat16, kBFloat16},
                                                                 {kNumberTypeComplex64, kComplex64},
                                                                 {kNumberTypeInt8, kInt8},
                                                                 {kNumberTypeInt16, kInt16},
@@ -387,6 +388,8 @@ TypePtr GetTypeByFullString(const std::string &type_name) {
                                                     {"Number", std::make_shared<Number>()},
                                                     {"Bool", std::make_shared<Bool>()},
                                                     {"bool", std::make_shared<Bool>()},
+                                                    {"BFloat16", std::make_shared<BFloat>()},
+                                                    {"bfloat16", std::make_shared<BFloat>()},
                                                     {"Slice", std::make_shared<Slice>()},
                                                     {"Dictionary", std::make_shared<Dictionary>()},
                                                     {"String", std::make_shared<String>()},
@@ -98,7 +98,12 @@ enum TypeId : int {
   // in order to keep fit with the type of existing model on the lite side.
   kSparseTypeBegin = kMonadTypeEnd,
   kObjectTypeCSRTensorType,
-  kSparseTypeEnd
+  kSparseTypeEnd,
+  //
+  // Extended Number Types
+  //
+  // Number types added later are placed after the sparse types, so that the values of the types above keep unchanged.
+  kNumberTypeBFloat16
 };
 }  // namespace mindspore
 #endif  // MINDSPORE_CORE_MINDAPI_BASE_TYPE_ID_H_
@@ -22,14 +22,47 @@
 
 namespace mindspore {
 constexpr size_t MAX_READY_ACTOR_NR = 4096;
-void ActorWorker::CreateThread(ActorThreadPool *pool) {
+namespace {
+// the actor worker running on the current thread, nullptr for threads that are not actor threads
+thread_local ActorWorker *current_actor_worker = nullptr;
+}  // namespace
+
+ActorWorker::~ActorWorker() {
+  // the thread must exit before the local queue is cleaned
+  StopThread();
+  local_queue_.Clean();
+}
+
+void ActorWorker::StopThread() {
+  {
+    std::lock_guard<std::mutex> _l(mutex_);
+    alive_ = false;
+  }
+  cond_var_.notify_one();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void ActorWorker::CreateThread(ActorThreadPool *pool, size_t worker_id) {
   THREAD_RETURN_IF_NULL(pool);
   pool_ = pool;
+  worker_id_ = worker_id;
   thread_ = std::thread(&ActorWorker::RunWithSpin, this);
 }
 
+bool ActorWorker::InitLocalQueue(int32_t queue_size, size_t actor_thread_num) {
+  if (local_queue_inited_) {
+    return true;
+  }
+  victim_run_counts_.assign(actor_thread_num, 0);
+  local_queue_inited_ = local_queue_.Init(queue_size);
+  return local_queue_inited_;
+}
+
 void ActorWorker::RunWithSpin() {
   SetAffinity();
+  current_actor_worker = this;
 #if !defined(__APPLE__) && !defined(SUPPORT_MSVC)
   static std::atomic_int index = {0};
   (void)pthread_setname_np(pthread_self(), ("ActorThread_" + std::to_string(index++)).c_str());
@@ -55,14 +88,74 @@ void ActorWorker::RunWithSpin() {
 
 bool ActorWorker::RunQueueActorTask() {
   THREAD_ERROR_IF_NULL(pool_);
-  auto actor = pool_->PopActorFromQueue();
+  ActorBase *actor = nullptr;
+  if (pool_->actor_queue_mode() == kWorkStealing) {
+    actor = PopLocalActor();
+    if (actor == nullptr) {
+      actor = pool_->PopActorFromQueue();
+    }
+    if (actor == nullptr) {
+      actor = pool_->StealActor(worker_id_);
+    }
+  } else {
+    actor = pool_->PopActorFromQueue();
+  }
   if (actor == nullptr) {
     return false;
   }
+  // the worker may have found the actor while spinning as an idle worker, mark it busy so that the actor parked in
+  // its next slot wakes another worker instead of this one
+  status_ = kThreadBusy;
   actor->Run();
+  (void)++run_count_;
   return true;
 }
 
+bool ActorWorker::PushLocalActor(ActorBase *actor) {
+  auto prev = next_actor_.exchange(actor);
+  if (prev == nullptr) {
+    return true;
+  }
+  if (local_queue_.Enqueue(prev)) {
+    return true;
+  }
+  // the local queue is full, take the actor back and give it to the caller, unless a thief has already taken it
+  auto expected = actor;
+  if (next_actor_.compare_exchange_strong(expected, prev)) {
+    return false;
+  }
+  // only the owner fills the next slot, so it is still empty after the thief took the actor
+  next_actor_ = prev;
+  return true;
+}
+
+ActorBase *ActorWorker::PopLocalActor() {
+  auto actor = next_actor_.exchange(nullptr);
+  if (actor != nullptr) {
+    return actor;
+  }
+  return local_queue_.Dequeue();
+}
+
+ActorBase *ActorWorker::StealActor(ActorWorker *victim) {
+  if (victim == nullptr) {
+    return nullptr;
+  }
+  auto actor = victim->local_queue_.Dequeue();
+  if (actor != nullptr || victim->worker_id_ >= victim_run_counts_.size()) {
+    return actor;
+  }
+  // the next slot is reserved for the victim, steal it only when the victim has not finished any actor since the last
+  // look of this worker, e.g. it is blocked in a long running actor
+  auto &run_count = victim_run_counts_[victim->worker_id_];
+  size_t victim_run_count = victim->run_count_;
+  if (run_count != victim_run_count) {
+    run_count = victim_run_count;
+    return nullptr;
+  }
+  return victim->next_actor_.exchange(nullptr);
+}
+
 bool ActorWorker::ActorActive() {
   if (status_ != kThreadIdle) {
     return false;
@@ -81,14 +174,7 @@ ActorThreadPool::~ActorThreadPool() {
   bool terminate = false;
   int count = 0;
   do {
-    {
-#ifdef USE_HQUEUE
-      terminate = actor_queue_.Empty();
-#else
-      std::lock_guard<std::mutex> _l(actor_mutex_);
-      terminate = actor_queue_.empty();
-#endif
-    }
+    terminate = ActorQueueEmpty();
     if (!terminate) {
       for (auto &worker : workers_) {
         worker->Active();
@@ -96,6 +182,10 @@ ActorThreadPool::~ActorThreadPool() {
       std::this_thread::yield();
     }
   } while (!terminate && count++ < kMaxCount);
+  // the actor workers steal from each other, all of them must exit before any one is deleted
+  for (size_t i = 0; i < actor_thread_num_ && i < workers_.size(); ++i) {
+    static_cast<ActorWorker *>(workers_[i])->StopThread();
+  }
   for (auto &worker : workers_) {
     delete worker;
     worker = nullptr;
@@ -106,6 +196,28 @@ ActorThreadPool::~ActorThreadPool() {
 #endif
 }
 
+bool ActorThreadPool::ActorQueueEmpty() {
+  bool empty = false;
+  {
+#ifdef USE_HQUEUE
+    empty = actor_queue_.Empty();
+#else
+    std::lock_guard<std::mutex> _l(actor_mutex_);
+    empty = actor_queue_.empty();
+#endif
+  }
+  if (!empty || actor_queue_mode_ != kWorkStealing) {
+    return empty;
+  }
+  for (size_t i = 0; i < actor_thread_num_ && i < workers_.size(); ++i) {
+    auto worker = static_cast<ActorWorker *>(workers_[i]);
+    if (!worker->NextActorEmpty() || !worker->LocalQueueEmpty()) {
+      return false;
+    }
+  }
+  return true;
+}
+
 ActorBase *ActorThreadPool::PopActorFromQueue() {
 #ifdef USE_HQUEUE
   return actor_queue_.Dequeue();
@@ -120,10 +232,36 @@ ActorBase *ActorThreadPool::PopActorFromQueue() {
 #endif
 }
 
+ActorBase *ActorThreadPool::StealActor(size_t thief_id) {
+  if (thief_id >= actor_thread_num_) {
+    return nullptr;
+  }
+  auto thief = static_cast<ActorWorker *>(workers_[thief_id]);
+  // start from the neighbour of the thief to spread the thieves over the victims
+  for (size_t i = 1; i < actor_thread_num_; ++i) {
+    auto victim = static_cast<ActorWorker *>(workers_[(thief_id + i) % actor_thread_num_]);
+    auto actor = thief->StealActor(victim);
+    if (actor != nullptr) {
+      return actor;
+    }
+  }
+  return nullptr;
+}
+
 void ActorThreadPool::PushActorToQueue(ActorBase *actor) {
   if (!actor) {
     return;
   }
+  // the actor triggered by an actor thread (e.g. the successor of a kernel actor) runs on the same thread in work
+  // stealing mode to keep cache locality
+  if (actor_queue_mode_ == kWorkStealing && current_actor_worker != nullptr && current_actor_worker->pool() == this &&
+      current_actor_worker->PushLocalActor(actor)) {
+    THREAD_DEBUG("actor[%s] enqueue local queue success", actor->GetAID().Name().c_str());
+    // wake an idle actor thread to steal the displaced actors in the local queue, or the actor in the next slot if
+    // the current actor keeps running for long
+    ActiveActorWorker();
+    return;
+  }
   {
 #ifdef USE_HQUEUE
     while (!actor_queue_.Enqueue(actor)) {
@@ -134,6 +272,25 @@ void ActorThreadPool::PushActorToQueue(ActorBase *actor) {
 #endif
   }
   THREAD_DEBUG("actor[%s] enqueue success", actor->GetAID().Name().c_str());
+  ActiveActorWorker();
+}
+
+void ActorThreadPool::SetActorQueueMode(ActorQueueMode mode) {
+  if (mode == kWorkStealing) {
+    // the local queues are only used in work stealing mode, create them before any worker can see the mode
+    std::lock_guard<std::mutex> _l(pool_mutex_);
+    for (size_t i = 0; i < actor_thread_num_ && i < workers_.size(); ++i) {
+      auto worker = static_cast<ActorWorker *>(workers_[i]);
+      if (!worker->InitLocalQueue(static_cast<int32_t>(MAX_READY_ACTOR_NR), actor_thread_num_)) {
+        THREAD_ERROR("init local actor queue failed, keep the actor queue mode.");
+        return;
+      }
+    }
+  }
+  actor_queue_mode_ = mode;
+}
+
+void ActorThreadPool::ActiveActorWorker() {
   // active one idle actor thread if exist
   for (size_t i = 0; i < actor_thread_num_; ++i) {
     auto worker = reinterpret_cast<ActorWorker *>(workers_[i]);
@@ -165,7 +322,7 @@ int ActorThreadPool::CreateThreads(size_t actor_thread_num, size_t all_thread_nu
     auto worker = new (std::nothrow) ActorWorker();
     THREAD_ERROR_IF_NULL(worker);
     worker->InitWorkerMask(core_list, workers_.size());
-    worker->CreateThread(this);
+    worker->CreateThread(this, workers_.size());
     workers_.push_back(worker);
     THREAD_INFO("create actor thread[%zu]", i);
   }
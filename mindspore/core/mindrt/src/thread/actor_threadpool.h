@@ -28,17 +28,47 @@
 #include "thread/hqueue.h"
 #define USE_HQUEUE
 namespace mindspore {
+enum ActorQueueMode {
+  kGlobalActorQueue = 0,  // all actor threads share one ready actor queue
+  kWorkStealing = 1       // every actor thread owns a local queue and steals from others when it runs out of actors
+};
+
 class ActorThreadPool;
 class ActorWorker : public Worker {
  public:
-  void CreateThread(ActorThreadPool *pool);
+  ~ActorWorker() override;
+  void CreateThread(ActorThreadPool *pool, size_t worker_id);
   bool ActorActive();
+  ActorThreadPool *pool() const { return pool_; }
+
+  // stop the thread and wait until it exits
+  void StopThread();
+
+  // the local queue is created when the pool turns to work stealing mode and kept until the worker is deleted
+  bool InitLocalQueue(int32_t queue_size, size_t actor_thread_num);
+  // the actor triggered by the running actor of this worker is kept in the next slot and run right after it,
+  // the previous one in the next slot is moved to the local queue which can be stolen by other workers
+  bool PushLocalActor(ActorBase *actor);
+  // steal a ready actor from the victim for this worker, the next slot of the victim is stolen when the victim has
+  // made no progress between two looks of this worker
+  ActorBase *StealActor(ActorWorker *victim);
+  bool LocalQueueEmpty() { return local_queue_.Empty(); }
+  bool NextActorEmpty() const { return next_actor_ == nullptr; }
 
  private:
   void RunWithSpin();
   bool RunQueueActorTask();
+  ActorBase *PopLocalActor();
 
   ActorThreadPool *pool_{nullptr};
+  size_t worker_id_{0};
+  HQueue<ActorBase> local_queue_;
+  bool local_queue_inited_{false};
+  std::atomic<ActorBase *> next_actor_{nullptr};
+  // the number of actors run by this worker, used by thieves to judge whether this worker makes progress
+  std::atomic<size_t> run_count_{0};
+  // the run count of every victim seen by the last look of this worker when stealing
+  std::vector<size_t> victim_run_counts_;
 };
 
 class ActorThreadPool : public ThreadPool {
@@ -54,11 +84,20 @@ class ActorThreadPool : public ThreadPool {
 
   void PushActorToQueue(ActorBase *actor);
   ActorBase *PopActorFromQueue();
+  // steal a ready actor from the local queue of other actor workers
+  ActorBase *StealActor(size_t thief_id);
+
+  // the mode can only be changed when there is no ready actor in the pool
+  void SetActorQueueMode(ActorQueueMode mode);
+  ActorQueueMode actor_queue_mode() const { return actor_queue_mode_; }
 
  private:
   ActorThreadPool() {}
   int CreateThreads(size_t actor_thread_num, size_t all_thread_num, const std::vector<int> &core_list);
+  bool ActorQueueEmpty();
+  void ActiveActorWorker();
   size_t actor_thread_num_{0};
+  std::atomic<ActorQueueMode> actor_queue_mode_{kGlobalActorQueue};
 
   std::mutex actor_mutex_;
   std::condition_variable actor_cond_;
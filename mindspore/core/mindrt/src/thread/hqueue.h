@@ -35,7 +35,8 @@ template <typename T>
 struct HQNode {
   std::atomic<Pointer> next;
   T *value = nullptr;
-  std::atomic_bool free = {true};
+  // link to the next node in the free list, only meaningful while the node is free
+  std::atomic<int32_t> free_next = {-1};
 };
 
 template <typename T>
@@ -54,15 +55,21 @@ class HQueue {
         return false;
       }
       node->value = nullptr;
-      node->free = true;
       node->next = {-1, 0};
       nodes.emplace_back(node);
     }
+    if (nodes.empty()) {
+      return false;
+    }
 
-    // init first node as dummy head
+    // init first node as dummy head, chain the rest into the free list
     qhead = {0, 0};
     qtail = {0, 0};
-    nodes[0]->free = false;
+    int32_t node_num = static_cast<int32_t>(nodes.size());
+    for (int32_t i = 1; i < node_num; i++) {
+      nodes[i]->free_next = (i + 1 < node_num) ? i + 1 : -1;
+    }
+    free_head = {(node_num > 1) ? 1 : -1, 0};
     return true;
   }
 
@@ -74,18 +81,11 @@ class HQueue {
   }
 
   bool Enqueue(T *t) {
-    HQNode<T> *node = nullptr;
-    int32_t nodeIdx;
-    for (nodeIdx = 0; nodeIdx < static_cast<int32_t>(nodes.size()); nodeIdx++) {
-      bool expected = true;
-      if (nodes[nodeIdx]->free.compare_exchange_strong(expected, false)) {
-        node = nodes[nodeIdx];
-        break;
-      }
-    }
-    if (node == nullptr) {
+    int32_t nodeIdx = AllocNode();
+    if (nodeIdx == -1) {
       return false;
     }
+    HQNode<T> *node = nodes[nodeIdx];
     node->value = t;
     node->next = {-1, 0};
 
@@ -140,7 +140,7 @@ class HQueue {
         ret = nodes[next.index]->value;
         if (this->qhead.compare_exchange_strong(head, {next.index, head.version + 1})) {
           // free head
-          nodes[head.index]->free = true;
+          FreeNode(head.index);
           return ret;
         }
       }
@@ -163,8 +163,29 @@ class HQueue {
   }
 
  private:
+  // pop a node from the free list, the version in free_head avoids the ABA problem
+  int32_t AllocNode() {
+    Pointer head = free_head;
+    while (head.index != -1) {
+      int32_t next = nodes[head.index]->free_next;
+      if (free_head.compare_exchange_weak(head, {next, head.version + 1})) {
+        return head.index;
+      }
+    }
+    return -1;
+  }
+
+  // push a node back to the free list
+  void FreeNode(int32_t index) {
+    Pointer head = free_head;
+    do {
+      nodes[index]->free_next = head.index;
+    } while (!free_head.compare_exchange_weak(head, {index, head.version + 1}));
+  }
+
   std::atomic<Pointer> qhead;
   std::atomic<Pointer> qtail;
+  std::atomic<Pointer> free_head;
   std::vector<HQNode<T> *> nodes;
 };
 }  // namespace mindspore
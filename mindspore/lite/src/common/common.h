@@ -69,6 +69,8 @@ static const char *const kMSCacheSerializePath = "serialize_path";
 #ifdef SERVER_INFERENCE
 static const char *const kConfigServerInference = "server_inference";
 static const char *const kConfigNUMANodeId = "numa_node_id";
+static const char *const kConfigThreadCostModel = "thread_cost_model";
+static const char *const kConfigThreadCostProfile = "profile_path";
 #endif
 }  // namespace lite
 }  // namespace mindspore
@@ -324,6 +324,15 @@ Status ModelPool::Init(const std::string &model_path, const std::shared_ptr<Runn
     model_inputs_ = model_worker->GetInputs();
     model_outputs_ = model_worker->GetOutputs();
   }
+  if (runner_config != nullptr && runner_config->max_batch_size > 1) {
+    MS_LOG(INFO) << "enable dynamic batching, max batch size: " << runner_config->max_batch_size
+                 << ", max batch delay: " << runner_config->max_batch_delay_us << " us";
+    predict_batcher_ = std::make_shared<PredictBatcher>(
+      runner_config->max_batch_size, runner_config->max_batch_delay_us,
+      [this](const std::vector<MSTensor> &inputs, std::vector<MSTensor> *outputs) {
+        return PredictInner(inputs, outputs, nullptr, nullptr);
+      });
+  }
   return kSuccess;
 }
 
@@ -509,6 +518,15 @@ void ModelPool::GetMaxWaitWorkerNum(int *max_wait_worker_node_id, int *max_wait_
 
 Status ModelPool::Predict(const std::vector<MSTensor> &inputs, std::vector<MSTensor> *outputs,
                           const MSKernelCallBack &before, const MSKernelCallBack &after) {
+  if (predict_batcher_ != nullptr && before == nullptr && after == nullptr &&
+      predict_batcher_->CanBatch(inputs, outputs)) {
+    return predict_batcher_->Predict(inputs, outputs);
+  }
+  return PredictInner(inputs, outputs, before, after);
+}
+
+Status ModelPool::PredictInner(const std::vector<MSTensor> &inputs, std::vector<MSTensor> *outputs,
+                               const MSKernelCallBack &before, const MSKernelCallBack &after) {
   mtx_split_task_.lock();
   int max_wait_worker_node_id = 0;
   int max_wait_worker_num = 0;
@@ -532,15 +550,23 @@ Status ModelPool::Predict(const std::vector<MSTensor> &inputs, std::vector<MSTen
       return kLiteError;
     }
 
-    std::vector<std::shared_ptr<PredictTask>> tasks;
+    std::vector<std::unique_ptr<PredictTask>> tasks;
     for (size_t i = 0; i < batch_split_num; i++) {
-      auto predict_task = std::make_shared<PredictTask>(&new_inputs[i], &new_outputs.at(i), before, after);
-      PredictTaskQueue::GetInstance()->PushPredictTask(predict_task, max_wait_worker_node_id);
-      tasks.push_back(predict_task);
+      tasks.push_back(std::make_unique<PredictTask>(&new_inputs[i], &new_outputs.at(i), before, after));
+      PredictTaskQueue::GetInstance()->PushPredictTask(tasks.back().get(), max_wait_worker_node_id);
     }
     mtx_split_task_.unlock();
     for (size_t i = 0; i < batch_split_num; i++) {
-      PredictTaskQueue::GetInstance()->WaitUntilPredictActive(tasks[i]);
+      PredictTaskQueue::GetInstance()->WaitUntilPredictActive(tasks[i].get());
+    }
+    PredictTaskQueue::GetInstance()->IncreaseWaitModelNum(batch_split_num, max_wait_worker_node_id);
+    for (size_t i = 0; i < batch_split_num; i++) {
+      if (tasks[i]->status != kSuccess) {
+        MS_LOG(ERROR) << "model pool predict the split task " << i << " failed.";
+        (void)FreeSplitTensor(&new_inputs, &new_outputs);
+        outputs->clear();
+        return tasks[i]->status;
+      }
     }
     status = ConcatPredictOutput(&new_outputs, outputs);
     if (status != kSuccess) {
@@ -552,14 +578,17 @@ Status ModelPool::Predict(const std::vector<MSTensor> &inputs, std::vector<MSTen
       MS_LOG(ERROR) << "free split tensor failed.";
       return kLiteError;
     }
-    PredictTaskQueue::GetInstance()->IncreaseWaitModelNum(batch_split_num, max_wait_worker_node_id);
   } else {
     PredictTaskQueue::GetInstance()->DecreaseWaitModelNum(1, max_wait_worker_node_id);
-    auto predict_task = std::make_shared<PredictTask>(&inputs, outputs, before, after);
-    PredictTaskQueue::GetInstance()->PushPredictTask(predict_task, max_wait_worker_node_id);
+    PredictTask predict_task(&inputs, outputs, before, after);
+    PredictTaskQueue::GetInstance()->PushPredictTask(&predict_task, max_wait_worker_node_id);
     mtx_split_task_.unlock();
-    PredictTaskQueue::GetInstance()->WaitUntilPredictActive(predict_task);
+    PredictTaskQueue::GetInstance()->WaitUntilPredictActive(&predict_task);
     PredictTaskQueue::GetInstance()->IncreaseWaitModelNum(1, max_wait_worker_node_id);
+    if (predict_task.status != kSuccess) {
+      MS_LOG(ERROR) << "model pool predict failed.";
+      return predict_task.status;
+    }
   }
   return kSuccess;
 }
@@ -26,6 +26,7 @@
 #include "include/api/model_parallel_runner.h"
 #include "src/cxx_api/model_pool/model_worker.h"
 #include "src/cxx_api/model_pool/predict_task_queue.h"
+#include "src/cxx_api/model_pool/predict_batcher.h"
 namespace mindspore {
 using ModelPoolContex = std::vector<std::shared_ptr<Context>>;
 
@@ -65,6 +66,8 @@ class ModelPool {
   Status FreeSplitTensor(std::vector<std::vector<MSTensor>> *new_inputs,
                          std::vector<std::vector<MSTensor>> *new_outputs);
   void GetMaxWaitWorkerNum(int *max_wait_worker_node_id, int *max_wait_worker_num);
+  Status PredictInner(const std::vector<MSTensor> &inputs, std::vector<MSTensor> *outputs,
+                      const MSKernelCallBack &before, const MSKernelCallBack &after);
 
   std::vector<std::thread> model_worker_vec_;
   std::vector<MSTensor> model_inputs_;
@@ -76,6 +79,7 @@ class ModelPool {
   int numa_node_num_ = 1;
   int used_numa_node_num_ = 0;
   bool use_numa_bind_mode_ = false;
+  std::shared_ptr<PredictBatcher> predict_batcher_ = nullptr;
 };
 }  // namespace mindspore
 #endif  // MINDSPORE_LITE_SRC_CXX_API_MODEL_POOL_MODEL_POOL_H_
@@ -31,8 +31,9 @@ void ModelWorker::Run(int node_id) {
     auto status = Predict(*inputs, outputs, before, after);
     if (status != kSuccess) {
       MS_LOG(ERROR) << "model predict failed.";
-      task->ready = true;
-      PredictTaskQueue::GetInstance()->ActiveTask();
+      outputs->clear();
+      task->status = status;
+      PredictTaskQueue::GetInstance()->ActiveTask(task);
       continue;
     }
     if (need_copy_output_) {
@@ -44,18 +45,18 @@ void ModelWorker::Run(int node_id) {
                                             outputs->at(i).MutableData(), outputs->at(i).DataSize());
         if (copy_tensor == nullptr) {
           MS_LOG(ERROR) << "model thread copy output tensor failed.";
-          task->ready = true;
-          PredictTaskQueue::GetInstance()->ActiveTask();
-          continue;
+          task->status = kLiteMemoryFailed;
+          break;
         }
         new_outputs.push_back(*copy_tensor);
         delete copy_tensor;
       }
       outputs->clear();
-      outputs->insert(outputs->end(), new_outputs.begin(), new_outputs.end());
+      if (task->status == kSuccess) {
+        outputs->insert(outputs->end(), new_outputs.begin(), new_outputs.end());
+      }
     }
-    task->ready = true;
-    PredictTaskQueue::GetInstance()->ActiveTask();
+    PredictTaskQueue::GetInstance()->ActiveTask(task);
   }
 }
 
@@ -94,7 +95,6 @@ std::vector<MSTensor> ModelWorker::GetOutputs() {
 
 std::pair<std::vector<std::vector<int64_t>>, bool> ModelWorker::GetModelResize(
   const std::vector<MSTensor> &model_inputs, const std::vector<MSTensor> &inputs) {
-  std::unique_lock<std::mutex> model_lock(mtx_model_);
   std::vector<std::vector<int64_t>> dims;
   bool need_resize = false;
   for (size_t i = 0; i < model_inputs.size(); i++) {
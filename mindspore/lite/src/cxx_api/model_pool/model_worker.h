@@ -48,8 +48,8 @@ class ModelWorker {
                                                                     const std::vector<MSTensor> &inputs);
 
  private:
+  // the model is only used by the worker thread, so it is not guarded by a lock.
   std::shared_ptr<mindspore::Model> model_ = nullptr;
-  std::mutex mtx_model_;
   bool need_copy_output_ = true;
 };
 }  // namespace mindspore
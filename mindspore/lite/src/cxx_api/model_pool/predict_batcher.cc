@@ -0,0 +1,234 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "src/cxx_api/model_pool/predict_batcher.h"
+#include <cstring>
+#include "src/common/log.h"
+
+namespace mindspore {
+namespace {
+bool IsSameSample(const std::vector<MSTensor> &lhs, const std::vector<MSTensor> &rhs) {
+  if (lhs.size() != rhs.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < lhs.size(); i++) {
+    auto lhs_shape = lhs[i].Shape();
+    auto rhs_shape = rhs[i].Shape();
+    if (lhs[i].DataType() != rhs[i].DataType() || lhs_shape.size() != rhs_shape.size()) {
+      return false;
+    }
+    for (size_t j = 1; j < lhs_shape.size(); j++) {
+      if (lhs_shape[j] != rhs_shape[j]) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}  // namespace
+
+bool PredictBatcher::CanBatch(const std::vector<MSTensor> &inputs, const std::vector<MSTensor> *outputs) const {
+  if (max_batch_size_ <= 1 || batch_disabled_ || inputs.empty() || outputs == nullptr || !outputs->empty()) {
+    return false;
+  }
+  auto batch = inputs[0].Shape().empty() ? 0 : inputs[0].Shape()[0];
+  if (batch <= 0 || batch >= max_batch_size_) {
+    return false;
+  }
+  for (auto &input : inputs) {
+    auto shape = input.Shape();
+    if (shape.empty() || shape[0] != batch || input.Data() == nullptr) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::vector<std::shared_ptr<BatchRequest>> PredictBatcher::TakeBatch() {
+  std::vector<std::shared_ptr<BatchRequest>> batch;
+  if (pending_requests_.empty()) {
+    return batch;
+  }
+  // the oldest request is always taken, the later ones are taken when they have the same sample shape and fit in.
+  auto first = pending_requests_.front();
+  int64_t batch_size = 0;
+  for (auto iter = pending_requests_.begin(); iter != pending_requests_.end();) {
+    auto &request = *iter;
+    if (request == first ||
+        (batch_size + request->batch <= max_batch_size_ && IsSameSample(*first->inputs, *request->inputs))) {
+      batch_size += request->batch;
+      pending_batch_ -= request->batch;
+      request->pending = false;
+      batch.push_back(request);
+      iter = pending_requests_.erase(iter);
+    } else {
+      ++iter;
+    }
+    if (batch_size >= max_batch_size_) {
+      break;
+    }
+  }
+  return batch;
+}
+
+Status PredictBatcher::Predict(const std::vector<MSTensor> &inputs, std::vector<MSTensor> *outputs) {
+  auto request = std::make_shared<BatchRequest>(&inputs, outputs, inputs[0].Shape()[0]);
+  std::unique_lock<std::mutex> batch_lock(mtx_batch_);
+  pending_requests_.push_back(request);
+  pending_batch_ += request->batch;
+  if (pending_batch_ >= max_batch_size_) {
+    batch_cond_.notify_all();
+  }
+  while (!request->done) {
+    if (has_leader_ || !request->pending) {
+      batch_cond_.wait(batch_lock);
+      continue;
+    }
+    has_leader_ = true;
+    auto deadline = pending_requests_.front()->enqueue_time + std::chrono::microseconds(max_delay_us_);
+    (void)batch_cond_.wait_until(batch_lock, deadline, [this] { return pending_batch_ >= max_batch_size_; });
+    auto batch = TakeBatch();
+    has_leader_ = false;
+    // let one of the remaining requests lead the next batch while this one is running.
+    batch_cond_.notify_all();
+    batch_lock.unlock();
+    RunBatch(batch);
+    batch_lock.lock();
+    for (auto &batch_request : batch) {
+      batch_request->done = true;
+    }
+    batch_cond_.notify_all();
+  }
+  return request->status;
+}
+
+void PredictBatcher::RunBatch(const std::vector<std::shared_ptr<BatchRequest>> &batch) {
+  if (batch.empty()) {
+    return;
+  }
+  if (batch.size() == 1) {
+    batch[0]->status = predict_func_(*batch[0]->inputs, batch[0]->outputs);
+    return;
+  }
+  auto set_status = [&batch](const Status &status) {
+    for (auto &request : batch) {
+      request->status = status;
+    }
+  };
+  std::vector<MSTensor> batch_inputs;
+  auto status = ConcatBatchInputs(batch, &batch_inputs);
+  if (status != kSuccess) {
+    MS_LOG(ERROR) << "concat the inputs of " << batch.size() << " requests failed.";
+    set_status(status);
+    return;
+  }
+  std::vector<MSTensor> batch_outputs;
+  status = predict_func_(batch_inputs, &batch_outputs);
+  if (status != kSuccess) {
+    MS_LOG(ERROR) << "predict the merged batch failed.";
+    set_status(status);
+    return;
+  }
+  status = SplitBatchOutputs(batch, batch_outputs);
+  if (status == kLiteNotSupport) {
+    // the model has an output which is not batched by dim 0, so its requests can never be merged.
+    MS_LOG(WARNING) << "the outputs of the model can not be split by batch, the requests are run one by one.";
+    batch_disabled_ = true;
+    for (auto &request : batch) {
+      request->status = predict_func_(*request->inputs, request->outputs);
+    }
+    return;
+  }
+  if (status != kSuccess) {
+    MS_LOG(ERROR) << "split the outputs of " << batch.size() << " requests failed.";
+  }
+  set_status(status);
+}
+
+Status PredictBatcher::ConcatBatchInputs(const std::vector<std::shared_ptr<BatchRequest>> &batch,
+                                         std::vector<MSTensor> *inputs) {
+  int64_t batch_size = 0;
+  for (auto &request : batch) {
+    batch_size += request->batch;
+  }
+  auto &first_inputs = *batch[0]->inputs;
+  for (size_t i = 0; i < first_inputs.size(); i++) {
+    auto shape = first_inputs[i].Shape();
+    shape[0] = batch_size;
+    auto tensor = MSTensor::CreateTensor(first_inputs[i].Name(), first_inputs[i].DataType(), shape, nullptr, 0);
+    if (tensor == nullptr) {
+      MS_LOG(ERROR) << "create batch input tensor failed.";
+      return kLiteError;
+    }
+    inputs->push_back(*tensor);
+    delete tensor;
+    auto dst = reinterpret_cast<uint8_t *>(inputs->back().MutableData());
+    if (dst == nullptr) {
+      MS_LOG(ERROR) << "malloc batch input data failed.";
+      return kLiteError;
+    }
+    size_t offset = 0;
+    for (auto &request : batch) {
+      auto &src = request->inputs->at(i);
+      if (offset + src.DataSize() > inputs->back().DataSize()) {
+        MS_LOG(ERROR) << "input data size of request is wrong: " << src.DataSize();
+        return kLiteError;
+      }
+      (void)memcpy(dst + offset, src.Data().get(), src.DataSize());
+      offset += src.DataSize();
+    }
+  }
+  return kSuccess;
+}
+
+Status PredictBatcher::SplitBatchOutputs(const std::vector<std::shared_ptr<BatchRequest>> &batch,
+                                         const std::vector<MSTensor> &outputs) {
+  int64_t batch_size = 0;
+  for (auto &request : batch) {
+    batch_size += request->batch;
+  }
+  for (auto &output : outputs) {
+    auto shape = output.Shape();
+    if (shape.empty() || shape[0] != batch_size) {
+      MS_LOG(INFO) << "output " << output.Name() << " can not be split by batch " << batch_size;
+      return kLiteNotSupport;
+    }
+  }
+  for (size_t i = 0; i < outputs.size(); i++) {
+    auto &output = const_cast<MSTensor &>(outputs[i]);
+    auto src = reinterpret_cast<uint8_t *>(output.MutableData());
+    if (src == nullptr) {
+      MS_LOG(ERROR) << "output data is nullptr.";
+      return kLiteError;
+    }
+    size_t sample_size = output.DataSize() / static_cast<size_t>(batch_size);
+    size_t offset = 0;
+    for (auto &request : batch) {
+      auto shape = output.Shape();
+      shape[0] = request->batch;
+      size_t data_size = sample_size * static_cast<size_t>(request->batch);
+      auto tensor = MSTensor::CreateTensor(output.Name(), output.DataType(), shape, src + offset, data_size);
+      if (tensor == nullptr) {
+        MS_LOG(ERROR) << "create output tensor of request failed.";
+        return kLiteError;
+      }
+      request->outputs->push_back(*tensor);
+      delete tensor;
+      offset += data_size;
+    }
+  }
+  return kSuccess;
+}
+}  // namespace mindspore
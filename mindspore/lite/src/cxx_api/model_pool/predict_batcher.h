@@ -0,0 +1,81 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_LITE_SRC_CXX_API_MODEL_POOL_PREDICT_BATCHER_H_
+#define MINDSPORE_LITE_SRC_CXX_API_MODEL_POOL_PREDICT_BATCHER_H_
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "include/api/types.h"
+#include "include/api/status.h"
+namespace mindspore {
+using BatchPredictFunc = std::function<Status(const std::vector<MSTensor> &, std::vector<MSTensor> *)>;
+
+struct BatchRequest {
+  BatchRequest(const std::vector<MSTensor> *in, std::vector<MSTensor> *out, int64_t batch)
+      : inputs(in), outputs(out), batch(batch), enqueue_time(std::chrono::steady_clock::now()) {}
+  const std::vector<MSTensor> *inputs;
+  std::vector<MSTensor> *outputs;
+  int64_t batch;
+  std::chrono::steady_clock::time_point enqueue_time;
+  Status status = kSuccess;
+  bool pending = true;
+  bool done = false;
+};
+
+// PredictBatcher coalesces the concurrent small requests into one inference. The inputs of the requests are
+// concatenated along the batch dim until max_batch_size is reached or the oldest request has waited max_delay_us,
+// and the outputs are split back to the requests by their batch. If an output of the model is not batched by dim 0,
+// the merged requests are run one by one and no request is merged afterwards.
+// There is no extra thread: the first caller which finds no leader becomes the leader of the next batch, waits for
+// the batch to be filled, runs it with predict_func and wakes up the other callers of the batch.
+class PredictBatcher {
+ public:
+  PredictBatcher(int64_t max_batch_size, int64_t max_delay_us, BatchPredictFunc predict_func)
+      : max_batch_size_(max_batch_size), max_delay_us_(max_delay_us), predict_func_(std::move(predict_func)) {}
+  ~PredictBatcher() = default;
+
+  // whether the request can be merged with the others, the outputs must be empty so that the batcher allocates them.
+  bool CanBatch(const std::vector<MSTensor> &inputs, const std::vector<MSTensor> *outputs) const;
+
+  Status Predict(const std::vector<MSTensor> &inputs, std::vector<MSTensor> *outputs);
+
+ private:
+  std::vector<std::shared_ptr<BatchRequest>> TakeBatch();
+  // run the requests of the batch and set their status.
+  void RunBatch(const std::vector<std::shared_ptr<BatchRequest>> &batch);
+  Status ConcatBatchInputs(const std::vector<std::shared_ptr<BatchRequest>> &batch, std::vector<MSTensor> *inputs);
+  // return kLiteNotSupport without touching the outputs of the requests if an output is not batched by dim 0.
+  Status SplitBatchOutputs(const std::vector<std::shared_ptr<BatchRequest>> &batch,
+                           const std::vector<MSTensor> &outputs);
+
+  int64_t max_batch_size_;
+  int64_t max_delay_us_;
+  BatchPredictFunc predict_func_;
+  std::deque<std::shared_ptr<BatchRequest>> pending_requests_;
+  int64_t pending_batch_ = 0;
+  bool has_leader_ = false;
+  std::atomic_bool batch_disabled_{false};
+  std::mutex mtx_batch_;
+  std::condition_variable batch_cond_;
+};
+}  // namespace mindspore
+#endif  // MINDSPORE_LITE_SRC_CXX_API_MODEL_POOL_PREDICT_BATCHER_H_
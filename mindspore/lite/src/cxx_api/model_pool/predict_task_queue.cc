@@ -15,53 +15,164 @@
  */
 
 #include "src/cxx_api/model_pool/predict_task_queue.h"
+#include <thread>
 namespace mindspore {
+namespace {
+constexpr size_t kTaskRingCapacity = 1024;
+constexpr int kPopSpinCount = 256;
+constexpr int kReadySpinCount = 256;
+}  // namespace
+
+PredictTaskRing::PredictTaskRing(size_t capacity) {
+  size_t size = 1;
+  while (size < capacity) {
+    size <<= 1;
+  }
+  cells_ = std::make_unique<Cell[]>(size);
+  for (size_t i = 0; i < size; i++) {
+    cells_[i].sequence.store(i, std::memory_order_relaxed);
+    cells_[i].task = nullptr;
+  }
+  mask_ = size - 1;
+}
+
+bool PredictTaskRing::TryPush(PredictTask *task) {
+  size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+  while (true) {
+    auto &cell = cells_[pos & mask_];
+    size_t sequence = cell.sequence.load(std::memory_order_acquire);
+    auto diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(pos);
+    if (diff == 0) {
+      if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+        cell.task = task;
+        cell.sequence.store(pos + 1, std::memory_order_release);
+        return true;
+      }
+    } else if (diff < 0) {
+      // the ring is full
+      return false;
+    } else {
+      pos = enqueue_pos_.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+bool PredictTaskRing::TryPop(PredictTask **task) {
+  size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+  while (true) {
+    auto &cell = cells_[pos & mask_];
+    size_t sequence = cell.sequence.load(std::memory_order_acquire);
+    auto diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(pos + 1);
+    if (diff == 0) {
+      if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+        *task = cell.task;
+        cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+        return true;
+      }
+    } else if (diff < 0) {
+      // the ring is empty
+      return false;
+    } else {
+      pos = dequeue_pos_.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+size_t PredictTaskRing::Size() const {
+  size_t dequeue_pos = dequeue_pos_.load(std::memory_order_relaxed);
+  size_t enqueue_pos = enqueue_pos_.load(std::memory_order_relaxed);
+  return enqueue_pos > dequeue_pos ? enqueue_pos - dequeue_pos : 0;
+}
+
+PredictTaskQueue::NodeQueue::NodeQueue() : ring(kTaskRingCapacity) {}
+
 PredictTaskQueue::~PredictTaskQueue() {
   predict_task_done_ = true;
-  task_push_cond_.notify_all();
+  for (auto &node_queue : node_queues_) {
+    std::unique_lock<std::mutex> park_lock(node_queue->park_mtx);
+    node_queue->park_cond.notify_all();
+  }
+  while (getting_worker_num_ > 0) {
+    std::this_thread::yield();
+  }
 }
 
 void PredictTaskQueue::SetTaskQueueNum(int num) {
-  predict_task_.resize(num);
-  waite_worker_num_.resize(num, 0);
+  node_queues_.clear();
+  for (int i = 0; i < num; i++) {
+    node_queues_.push_back(std::make_unique<NodeQueue>());
+  }
 }
 
-void PredictTaskQueue::WaitUntilPredictActive(const std::shared_ptr<PredictTask> &task) {
-  std::unique_lock<std::mutex> result_lock(mtx_predict_task_);
-  while (!task->ready) {
-    task_pop_cond_.wait(result_lock);
+void PredictTaskQueue::WaitUntilPredictActive(PredictTask *task) {
+  for (int i = 0; i < kReadySpinCount && !task->ready.load(std::memory_order_acquire); i++) {
+    std::this_thread::yield();
   }
-  return;
+  // always pass through the lock, the worker may still be notifying when ready is observed by spinning.
+  std::unique_lock<std::mutex> ready_lock(task->ready_mtx);
+  task->ready_cond.wait(ready_lock, [task] { return task->ready.load(std::memory_order_acquire); });
 }
 
-void PredictTaskQueue::ActiveTask() { task_pop_cond_.notify_all(); }
+void PredictTaskQueue::ActiveTask(PredictTask *task) {
+  std::unique_lock<std::mutex> ready_lock(task->ready_mtx);
+  task->ready.store(true, std::memory_order_release);
+  task->ready_cond.notify_one();
+}
 
 PredictTaskQueue *PredictTaskQueue::GetInstance() {
   static PredictTaskQueue instance;
   return &instance;
 }
 
-void PredictTaskQueue::PushPredictTask(std::shared_ptr<PredictTask> task, int node_id) {
-  std::unique_lock<std::mutex> task_lock(mtx_predict_task_);
-  predict_task_.at(node_id).push(task);
-  task_push_cond_.notify_all();
+void PredictTaskQueue::PushPredictTask(PredictTask *task, int node_id) {
+  auto &node_queue = node_queues_.at(node_id);
+  while (!node_queue->ring.TryPush(task)) {
+    std::this_thread::yield();
+  }
+  // pairs with the increment of parked_worker_num in GetPredictTask, either the worker sees the task before it
+  // parks, or the producer sees the parked worker and wakes it up.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (node_queue->parked_worker_num.load() > 0) {
+    std::unique_lock<std::mutex> park_lock(node_queue->park_mtx);
+    node_queue->park_cond.notify_one();
+  }
 }
 
-std::shared_ptr<PredictTask> PredictTaskQueue::GetPredictTask(int node_id) {
-  std::unique_lock<std::mutex> task_lock(mtx_predict_task_);
-  while (predict_task_.at(node_id).empty() && !predict_task_done_) {
-    task_push_cond_.wait(task_lock);
-  }
+PredictTask *PredictTaskQueue::GetPredictTask(int node_id) {
+  getting_worker_num_++;
   if (predict_task_done_) {
+    getting_worker_num_--;
     return nullptr;
   }
-  auto predict_task = predict_task_.at(node_id).front();
-  predict_task_.at(node_id).pop();
-  return predict_task;
+  auto task = PopPredictTask(node_queues_.at(node_id).get());
+  getting_worker_num_--;
+  return task;
 }
 
-int PredictTaskQueue::GetTaskNum(int node_id) {
-  std::unique_lock<std::mutex> task_lock(mtx_predict_task_);
-  return predict_task_.at(node_id).size();
+PredictTask *PredictTaskQueue::PopPredictTask(NodeQueue *node_queue) {
+  PredictTask *task = nullptr;
+  for (int i = 0; i < kPopSpinCount; i++) {
+    if (predict_task_done_) {
+      return nullptr;
+    }
+    if (node_queue->ring.TryPop(&task)) {
+      return task;
+    }
+    std::this_thread::yield();
+  }
+  std::unique_lock<std::mutex> park_lock(node_queue->park_mtx);
+  node_queue->parked_worker_num++;
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  while (!node_queue->ring.TryPop(&task)) {
+    if (predict_task_done_) {
+      task = nullptr;
+      break;
+    }
+    node_queue->park_cond.wait(park_lock);
+  }
+  node_queue->parked_worker_num--;
+  return task;
 }
+
+int PredictTaskQueue::GetTaskNum(int node_id) { return static_cast<int>(node_queues_.at(node_id)->ring.Size()); }
 }  // namespace mindspore
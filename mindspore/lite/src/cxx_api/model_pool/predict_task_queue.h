@@ -16,7 +16,7 @@
 #ifndef MINDSPORE_LITE_SRC_CXX_API_MODEL_POOL_PREDICT_TASK_QUEUE_H_
 #define MINDSPORE_LITE_SRC_CXX_API_MODEL_POOL_PREDICT_TASK_QUEUE_H_
 
-#include <queue>
+#include <atomic>
 #include <mutex>
 #include <memory>
 #include <vector>
@@ -24,6 +24,7 @@
 #include "include/api/types.h"
 #include "include/api/status.h"
 namespace mindspore {
+// The task is owned by the caller of Predict, which waits until the task is ready, so only the pointer is queued.
 struct PredictTask {
   PredictTask(const std::vector<MSTensor> *in, std::vector<MSTensor> *out, MSKernelCallBack before,
               MSKernelCallBack after, bool ready = false)
@@ -32,7 +33,33 @@ struct PredictTask {
   std::vector<MSTensor> *outputs;
   MSKernelCallBack before;
   MSKernelCallBack after;
-  bool ready;
+  // set by the worker before the task is activated, the outputs are cleared if it is not kSuccess.
+  Status status = kSuccess;
+  std::atomic_bool ready;
+  std::mutex ready_mtx;
+  std::condition_variable ready_cond;
+};
+
+// Bounded multi-producer multi-consumer ring, each cell carries a sequence number which tells whether the cell is
+// ready to be written or read in the current lap, so push and pop only contend on one atomic position each.
+class PredictTaskRing {
+ public:
+  explicit PredictTaskRing(size_t capacity);
+  ~PredictTaskRing() = default;
+
+  bool TryPush(PredictTask *task);
+  bool TryPop(PredictTask **task);
+  size_t Size() const;
+
+ private:
+  struct Cell {
+    std::atomic<size_t> sequence;
+    PredictTask *task;
+  };
+  std::unique_ptr<Cell[]> cells_;
+  size_t mask_;
+  alignas(64) std::atomic<size_t> enqueue_pos_{0};
+  alignas(64) std::atomic<size_t> dequeue_pos_{0};
 };
 
 class PredictTaskQueue {
@@ -40,26 +67,35 @@ class PredictTaskQueue {
   static PredictTaskQueue *GetInstance();
   ~PredictTaskQueue();
 
-  void PushPredictTask(std::shared_ptr<PredictTask> task, int node_id);
-  void WaitUntilPredictActive(const std::shared_ptr<PredictTask> &task);
-  std::shared_ptr<PredictTask> GetPredictTask(int node_id);
-  void ActiveTask();
+  void PushPredictTask(PredictTask *task, int node_id);
+  void WaitUntilPredictActive(PredictTask *task);
+  PredictTask *GetPredictTask(int node_id);
+  void ActiveTask(PredictTask *task);
   int GetTaskNum(int node_id);
   void SetTaskQueueNum(int num);
 
   bool IsPredictTaskDone() { return predict_task_done_; }
-  int GetWaitModelNum(int node_id) { return waite_worker_num_.at(node_id); }
-  void DecreaseWaitModelNum(int num, int node_id) { waite_worker_num_.at(node_id) -= num; }
-  void IncreaseWaitModelNum(int num, int node_id) { waite_worker_num_.at(node_id) += num; }
+  int GetWaitModelNum(int node_id) { return node_queues_.at(node_id)->wait_worker_num; }
+  void DecreaseWaitModelNum(int num, int node_id) { node_queues_.at(node_id)->wait_worker_num -= num; }
+  void IncreaseWaitModelNum(int num, int node_id) { node_queues_.at(node_id)->wait_worker_num += num; }
 
  private:
   PredictTaskQueue() = default;
-  std::vector<std::queue<std::shared_ptr<PredictTask>>> predict_task_;
-  std::vector<int> waite_worker_num_;
-  std::mutex mtx_predict_task_;
-  std::condition_variable task_pop_cond_;
-  std::condition_variable task_push_cond_;
-  bool predict_task_done_ = false;
+  // the workers of one numa node share a ring, an idle worker spins for a while and then parks on the condition
+  // variable, the producer only takes the lock when some worker is parked.
+  struct NodeQueue {
+    NodeQueue();
+    PredictTaskRing ring;
+    std::atomic_int wait_worker_num{0};
+    std::atomic_int parked_worker_num{0};
+    std::mutex park_mtx;
+    std::condition_variable park_cond;
+  };
+  PredictTask *PopPredictTask(NodeQueue *node_queue);
+  std::vector<std::unique_ptr<NodeQueue>> node_queues_;
+  std::atomic_bool predict_task_done_{false};
+  // the number of workers inside GetPredictTask, the queues are freed after all of them have left.
+  std::atomic_int getting_worker_num_{0};
 };
 }  // namespace mindspore
 #endif  // MINDSPORE_LITE_SRC_CXX_API_MODEL_POOL_PREDICT_TASK_QUEUE_H_
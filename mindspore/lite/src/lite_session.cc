@@ -42,6 +42,7 @@
 #include "src/runtime/runtime_allocator.h"
 #ifdef SERVER_INFERENCE
 #include "src/runtime/dynamic_mem_allocator.h"
+#include "src/thread_cost_model.h"
 #endif
 #include "src/lite_kernel_util.h"
 #ifndef CUSTOM_KERNEL_REGISTRY_CLIP
@@ -667,6 +668,22 @@ void LiteSession::FreePackOpWeight(const std::vector<kernel::LiteKernel *> &kern
   }
 }
 #ifdef SERVER_INFERENCE
+int LiteSession::InitThreadCostModel() {
+  if (config_info_ == nullptr) {
+    return RET_OK;
+  }
+  auto section_iter = config_info_->find(kConfigThreadCostModel);
+  if (section_iter == config_info_->end()) {
+    return RET_OK;
+  }
+  auto path_iter = section_iter->second.find(kConfigThreadCostProfile);
+  if (path_iter == section_iter->second.end() || path_iter->second.empty()) {
+    MS_LOG(ERROR) << kConfigThreadCostProfile << " is not set in " << kConfigThreadCostModel;
+    return RET_INPUT_PARAM_INVALID;
+  }
+  return lite::InitThreadCostModel(context_, path_iter->second);
+}
+
 int LiteSession::IniPackWeightData(Model *model) {
   auto lite_model = reinterpret_cast<LiteModel *>(model);
   auto kernel_num = model->all_nodes_.size();
@@ -1070,6 +1087,15 @@ int LiteSession::Init(InnerContext *context) {
     return ret;
   }
 
+#ifdef SERVER_INFERENCE
+  ret = InitThreadCostModel();
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "Init thread cost model failed.";
+    is_running_.store(false);
+    return ret;
+  }
+#endif
+
   ret = DelegateInit();
   if (ret != RET_OK) {
     MS_LOG(ERROR) << "Init delegate failed.";
@@ -132,6 +132,9 @@ class LiteSession : public session::LiteSession {
   int CreateNPUDelegate();
   int DelegateInit();
   int InitGPURuntime();
+#ifdef SERVER_INFERENCE
+  int InitThreadCostModel();
+#endif
 
  private:
   int IsolateOutputTensor();
@@ -32,6 +32,7 @@ int SplitBaseCPUKernel::UpdateThreadNumPass() {
     thread_cost_context_->per_unit_load_num_ = in_tensors_.at(0)->ElementsNum() / num_unit_;
     thread_cost_context_->per_unit_store_num_ = in_tensors_.at(0)->ElementsNum() / num_unit_;
     thread_cost_context_->per_unit_compute_cost_ = 17.573;  // 17.573 : split per unit compute cost
+    thread_cost_context_->op_type_ = op_parameter_->type_;
   }
 
   if (thread_cost_context_ != nullptr) {
@@ -54,6 +54,8 @@ int ActivationCPUKernel::UpdateThreadNumPass() {
     thread_cost_context_->per_unit_load_num_ = 1;
     thread_cost_context_->per_unit_store_num_ = 1;
     thread_cost_context_->per_unit_compute_cost_ = activation_compute_cost_map_.at(type_);
+    thread_cost_context_->op_type_ = schema::PrimitiveType_Activation;
+    thread_cost_context_->op_sub_type_ = type_;
   }
 
   if (thread_cost_context_ != nullptr) {
@@ -67,6 +67,8 @@ int ArithmeticCPUKernel::UpdateThreadNumPass() {
     thread_cost_context_->per_unit_load_num_ = 1;
     thread_cost_context_->per_unit_store_num_ = 1;
     thread_cost_context_->per_unit_compute_cost_ = arithmetic_compute_cost_map_.at(fusion_type);
+    thread_cost_context_->op_type_ = fusion_type.first;
+    thread_cost_context_->op_sub_type_ = fusion_type.second;
   }
 
   if (thread_cost_context_ != nullptr) {
@@ -55,6 +55,7 @@ int ArithmeticSelfCPUKernel::UpdateThreadNumPass() {
     thread_cost_context_->per_unit_load_num_ = 1;
     thread_cost_context_->per_unit_store_num_ = 1;
     thread_cost_context_->per_unit_compute_cost_ = arithmetic_self_compute_cost_map_.at(type_);
+    thread_cost_context_->op_type_ = type_;
   }
 
   if (thread_cost_context_ != nullptr) {
@@ -50,6 +50,7 @@ int SoftmaxCPUKernel::UpdateThreadNumPass() {
     thread_cost_context_->per_unit_load_num_ = softmax_param_->input_shape_[softmax_param_->axis_];
     thread_cost_context_->per_unit_store_num_ = softmax_param_->input_shape_[softmax_param_->axis_];
     thread_cost_context_->per_unit_compute_cost_ = 42.042;  // 42.042 : split per unit compute cost
+    thread_cost_context_->op_type_ = op_parameter_->type_;
   }
 
   if (thread_cost_context_ != nullptr) {
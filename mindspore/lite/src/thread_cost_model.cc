@@ -15,20 +15,34 @@
  */
 
 #include "src/thread_cost_model.h"
+#include <atomic>
+#ifdef SERVER_INFERENCE
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <vector>
+#include "schema/model_generated.h"
+#include "nnacl/fp32/activation_fp32.h"
+#include "nnacl/fp32/add_fp32.h"
+#include "nnacl/fp32/div_fp32.h"
+#include "nnacl/fp32/mul_fp32.h"
+#include "nnacl/fp32/sub_fp32.h"
+#endif
 #include "src/common/log_util.h"
 #include "src/inner_context.h"
 #include "thread/threadpool.h"
 
 namespace mindspore::lite {
-float ThreadCostModel::per_unit_load_cost_ = 1.0 / 64 * 11;   // 64: L2 cache size, 11 : L2 cache latency on Haswell
-float ThreadCostModel::per_unit_store_cost_ = 1.0 / 64 * 11;  // 64: L2 cache size, 11 : L2 cache latency on Haswell
-int64_t ThreadCostModel::per_unit_compute_num_ = 1;           // 1 : per unit compute num
+namespace {
+const ThreadCostModel kDefaultThreadCostModel;
+std::atomic<const ThreadCostModel *> current_thread_cost_model{&kDefaultThreadCostModel};
+}  // namespace
 
-float ThreadCostModel::thread_startup_cost_ = 100000.0f;  // 100000 : thread startup inherent cost
-float ThreadCostModel::single_thread_cost_ = 100000.0f;   // 100000 : Minimum cost of single-threaded
-float ThreadCostModel::parallel_thread_cost_ = 40000.0f;  // 40000 : Minimum cost of per thread in parallel-thread
+const ThreadCostModel &ThreadCostModel::Current() { return *current_thread_cost_model.load(std::memory_order_acquire); }
 
-int ThreadCostModel::get_optimal_thread_num(const ThreadCostContext *thread_cost_context, const int thread_num) {
+int ThreadCostModel::get_optimal_thread_num(const ThreadCostContext *thread_cost_context,
+                                            const int thread_num) const {
   const int64_t max_oversharding_factor = 4;
 
   int64_t block_size = MSVALID(max_oversharding_factor * thread_num, thread_block_size(thread_cost_context),
@@ -69,13 +83,205 @@ int UpdateThreadNum(const Context *context, const ThreadCostContext *thread_cost
   }
 
   if (thread_cost_context != nullptr) {
-    if (ThreadCostModel::thread_num(thread_cost_context) == 1) {
+    const auto &model = ThreadCostModel::Current();
+    ThreadCostContext cost_context = *thread_cost_context;
+    auto iter = model.op_compute_cost_.find({cost_context.op_type_, cost_context.op_sub_type_});
+    if (iter != model.op_compute_cost_.end()) {
+      cost_context.per_unit_compute_cost_ = iter->second;
+    } else {
+      cost_context.per_unit_compute_cost_ *= model.compute_cost_scale_;
+    }
+    if (model.thread_num(&cost_context) == 1) {
       return 1;
     }
-    int opt_thread = static_cast<int>(ThreadCostModel::parallel_degree(thread_cost_context));
+    int opt_thread = static_cast<int>(model.parallel_degree(&cost_context));
     task_num = MSVALID(1, opt_thread, task_num);
-    task_num = MSMIN(task_num, thread_cost_context->total_unit_num_);
+    task_num = MSMIN(task_num, cost_context.total_unit_num_);
   }
   return task_num;
 }
+
+#ifdef SERVER_INFERENCE
+namespace {
+constexpr int kCalibrateUnitNum = 1 << 20;  // 4M bytes of float, larger than L2 cache
+constexpr int kCalibrateRepeat = 5;
+constexpr int kCalibrateLaunchRepeat = 200;
+constexpr float kSingleThreadCostRatio = 2.5f;    // keeps the ratio of the default single and parallel thread cost
+constexpr float kParallelThreadCostRatio = 1.0f;  // the work of a thread should cover the launch overhead
+constexpr float kMinComputeCost = 0.01f;
+const char *const kProfileOpComputeCost = "op_compute_cost";
+
+template <typename Fn>
+float MeasureNsPerUnit(const Fn &fn) {
+  fn();  // warm up the pages
+  float best = -1.0f;
+  for (int i = 0; i < kCalibrateRepeat; i++) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto end = std::chrono::steady_clock::now();
+    float cost = std::chrono::duration<float, std::nano>(end - start).count() / kCalibrateUnitNum;
+    best = best < 0 ? cost : MSMIN(best, cost);
+  }
+  return best;
+}
+
+int EmptyTask(void *cdata, int task_id, float lhs_scale, float rhs_scale) { return RET_OK; }
+
+float MeasureLaunchCost(const Context *context) {
+  int task_num = MSMAX(context->thread_num_, C2NUM);
+  (void)ParallelLaunch(context, EmptyTask, nullptr, task_num);
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kCalibrateLaunchRepeat; i++) {
+    if (ParallelLaunch(context, EmptyTask, nullptr, task_num) != RET_OK) {
+      return -1.0f;
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<float, std::nano>(end - start).count() / kCalibrateLaunchRepeat;
+}
+}  // namespace
+
+int CalibrateThreadCostModel(const Context *context, ThreadCostModel *model) {
+  MS_CHECK_TRUE_RET(context != nullptr, RET_NULL_PTR);
+  MS_CHECK_TRUE_RET(model != nullptr, RET_NULL_PTR);
+  std::vector<float> in0(kCalibrateUnitNum, 1.0f);
+  std::vector<float> in1(kCalibrateUnitNum, 2.0f);
+  std::vector<float> out(kCalibrateUnitNum, 0.0f);
+  volatile float sink = 0.0f;
+  float load_cost = MeasureNsPerUnit([&]() {
+    float sum = 0.0f;
+    for (int i = 0; i < kCalibrateUnitNum; i++) {
+      sum += in0[i];
+    }
+    sink = sum;
+  });
+  float store_cost = MeasureNsPerUnit([&]() { (void)Fp32Relu(in0.data(), kCalibrateUnitNum, out.data()); }) - load_cost;
+  (void)sink;
+  load_cost = MSMAX(load_cost, kMinComputeCost);
+  store_cost = MSMAX(store_cost, kMinComputeCost);
+
+  // the compute cost is what is left after the memory access, the binary ops load two units.
+  auto binary_cost = [&](int (*op)(const float *, const float *, float *, int)) {
+    auto cost = MeasureNsPerUnit([&]() { (void)op(in0.data(), in1.data(), out.data(), kCalibrateUnitNum); });
+    return MSMAX(cost - C2NUM * load_cost - store_cost, kMinComputeCost);
+  };
+  auto unary_cost = [&](int (*op)(const float *, int, float *)) {
+    auto cost = MeasureNsPerUnit([&]() { (void)op(in0.data(), kCalibrateUnitNum, out.data()); });
+    return MSMAX(cost - load_cost - store_cost, kMinComputeCost);
+  };
+  std::map<std::pair<int, int>, float> op_compute_cost = {
+    {{schema::PrimitiveType_AddFusion, schema::ActivationType_NO_ACTIVATION}, binary_cost(ElementAdd)},
+    {{schema::PrimitiveType_SubFusion, schema::ActivationType_NO_ACTIVATION}, binary_cost(ElementSub)},
+    {{schema::PrimitiveType_MulFusion, schema::ActivationType_NO_ACTIVATION}, binary_cost(ElementMul)},
+    {{schema::PrimitiveType_DivFusion, schema::ActivationType_NO_ACTIVATION}, binary_cost(ElementDiv)},
+    {{schema::PrimitiveType_Activation, schema::ActivationType_RELU}, unary_cost(Fp32Relu)},
+    {{schema::PrimitiveType_Activation, schema::ActivationType_RELU6}, unary_cost(Fp32Relu6)},
+  };
+
+  float launch_cost = MeasureLaunchCost(context);
+  if (launch_cost <= 0) {
+    MS_LOG(ERROR) << "measure the parallel launch cost failed.";
+    return RET_ERROR;
+  }
+  model->per_unit_load_cost_ = load_cost;
+  model->per_unit_store_cost_ = store_cost;
+  model->thread_startup_cost_ = launch_cost;
+  model->single_thread_cost_ = launch_cost * kSingleThreadCostRatio;
+  model->parallel_thread_cost_ = launch_cost * kParallelThreadCostRatio;
+  model->compute_cost_scale_ = load_cost / kDefaultUnitLoadCost;
+  model->op_compute_cost_ = op_compute_cost;
+  MS_LOG(INFO) << "calibrated thread cost model, load cost: " << load_cost << ", store cost: " << store_cost
+               << ", launch cost: " << launch_cost;
+  return RET_OK;
+}
+
+int LoadThreadCostProfile(const std::string &profile_path, ThreadCostModel *model) {
+  MS_CHECK_TRUE_RET(model != nullptr, RET_NULL_PTR);
+  std::ifstream ifs(profile_path);
+  if (!ifs.good()) {
+    MS_LOG(ERROR) << "open thread cost profile failed: " << profile_path;
+    return RET_ERROR;
+  }
+  std::map<std::string, float *> cost_map = {
+    {"per_unit_load_cost", &model->per_unit_load_cost_},
+    {"per_unit_store_cost", &model->per_unit_store_cost_},
+    {"thread_startup_cost", &model->thread_startup_cost_},
+    {"single_thread_cost", &model->single_thread_cost_},
+    {"parallel_thread_cost", &model->parallel_thread_cost_},
+  };
+  std::map<std::pair<int, int>, float> op_compute_cost;
+  std::string line;
+  while (std::getline(ifs, line)) {
+    std::istringstream line_stream(line);
+    std::string name;
+    if (!(line_stream >> name) || name[0] == '#') {
+      continue;
+    }
+    if (name == kProfileOpComputeCost) {
+      int op_type = 0;
+      int op_sub_type = 0;
+      float cost = 0.0f;
+      if (!(line_stream >> op_type >> op_sub_type >> cost) || cost <= 0) {
+        MS_LOG(ERROR) << "invalid line in thread cost profile: " << line;
+        return RET_ERROR;
+      }
+      op_compute_cost[{op_type, op_sub_type}] = cost;
+      continue;
+    }
+    auto iter = cost_map.find(name);
+    float cost = 0.0f;
+    if (iter == cost_map.end() || !(line_stream >> cost) || cost <= 0) {
+      MS_LOG(ERROR) << "invalid line in thread cost profile: " << line;
+      return RET_ERROR;
+    }
+    *(iter->second) = cost;
+  }
+  model->compute_cost_scale_ = model->per_unit_load_cost_ / kDefaultUnitLoadCost;
+  model->op_compute_cost_ = op_compute_cost;
+  return RET_OK;
+}
+
+int SaveThreadCostProfile(const std::string &profile_path, const ThreadCostModel &model) {
+  std::ofstream ofs(profile_path);
+  if (!ofs.good()) {
+    MS_LOG(ERROR) << "create thread cost profile failed: " << profile_path;
+    return RET_ERROR;
+  }
+  ofs << "# thread cost model profile, the costs are in nanoseconds\n";
+  ofs << "per_unit_load_cost " << model.per_unit_load_cost_ << "\n";
+  ofs << "per_unit_store_cost " << model.per_unit_store_cost_ << "\n";
+  ofs << "thread_startup_cost " << model.thread_startup_cost_ << "\n";
+  ofs << "single_thread_cost " << model.single_thread_cost_ << "\n";
+  ofs << "parallel_thread_cost " << model.parallel_thread_cost_ << "\n";
+  for (auto &op_cost : model.op_compute_cost_) {
+    ofs << kProfileOpComputeCost << " " << op_cost.first.first << " " << op_cost.first.second << " " << op_cost.second
+        << "\n";
+  }
+  ofs.close();
+  return ofs.fail() ? RET_ERROR : RET_OK;
+}
+
+int InitThreadCostModel(const Context *context, const std::string &profile_path) {
+  static std::once_flag init_flag;
+  static int init_ret = RET_OK;
+  std::call_once(init_flag, [&]() {
+    // the model is published after it is filled, and is never written again.
+    static ThreadCostModel model;
+    std::ifstream ifs(profile_path);
+    if (ifs.good()) {
+      ifs.close();
+      init_ret = LoadThreadCostProfile(profile_path, &model);
+    } else {
+      init_ret = CalibrateThreadCostModel(context, &model);
+      if (init_ret == RET_OK) {
+        init_ret = SaveThreadCostProfile(profile_path, model);
+      }
+    }
+    if (init_ret == RET_OK) {
+      current_thread_cost_model.store(&model, std::memory_order_release);
+    }
+  });
+  return init_ret;
+}
+#endif
 }  // namespace mindspore::lite
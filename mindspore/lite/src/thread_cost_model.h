@@ -18,6 +18,9 @@
 #define MINDSPORE_LITE_SRC_THREAD_COST_MODEL_H
 
 #include <stdint.h>
+#include <map>
+#include <string>
+#include <utility>
 #include "nnacl/op_base.h"
 #include "include/api/context.h"
 
@@ -27,45 +30,71 @@ typedef struct ThreadCostContext {
   int64_t per_unit_load_num_;
   int64_t per_unit_store_num_;
   float per_unit_compute_cost_;
+  int op_type_;      // primitive type, used to look up the calibrated compute cost
+  int op_sub_type_;  // activation type of the op, 0 if the op has none
 } ThreadCostContext;
 
+constexpr float kDefaultUnitLoadCost = 1.0 / 64 * 11;  // 64: L2 cache size, 11 : L2 cache latency on Haswell
+
 struct ThreadCostModel {
-  static float unit_cost(const ThreadCostContext *thread_cost_context) {
+  float unit_cost(const ThreadCostContext *thread_cost_context) const {
     return per_unit_load_cost_ * thread_cost_context->per_unit_load_num_ +
            per_unit_store_cost_ * thread_cost_context->per_unit_store_num_ +
            thread_cost_context->per_unit_compute_cost_ * per_unit_compute_num_;
   }
 
-  static float total_cost(const ThreadCostContext *thread_cost_context) {
+  float total_cost(const ThreadCostContext *thread_cost_context) const {
     return thread_cost_context->total_unit_num_ * unit_cost(thread_cost_context);
   }
 
   // thread_num assesses parallel thread num. Value of 1.0 means ideal parallel task size. Values < 1.0 mean that task
   // granularity needs to be increased to mitigate parallelization overheads.
-  static float parallel_degree(const ThreadCostContext *thread_cost_context) {
+  float parallel_degree(const ThreadCostContext *thread_cost_context) const {
     return total_cost(thread_cost_context) / parallel_thread_cost_;
   }
 
-  static int thread_num(const ThreadCostContext *thread_cost_context) {
+  int thread_num(const ThreadCostContext *thread_cost_context) const {
     return MSMAX(
       1, static_cast<int>((total_cost(thread_cost_context) - thread_startup_cost_) / single_thread_cost_ + 0.9));
   }
 
-  static int64_t thread_block_size(const ThreadCostContext *thread_cost_context) {
+  int64_t thread_block_size(const ThreadCostContext *thread_cost_context) const {
     return static_cast<int64_t>(parallel_thread_cost_ / unit_cost(thread_cost_context));
   }
-  static int get_optimal_thread_num(const ThreadCostContext *thread_cost_context, const int thread_num);
+  int get_optimal_thread_num(const ThreadCostContext *thread_cost_context, const int thread_num) const;
+
+  // the model used by UpdateThreadNum: the default one, or the loaded or calibrated one which never changes once set.
+  static const ThreadCostModel &Current();
 
-  static float per_unit_load_cost_;      // per unit load cost
-  static float per_unit_store_cost_;     // per unit store cost
-  static int64_t per_unit_compute_num_;  // per unit compute num
+  float per_unit_load_cost_ = kDefaultUnitLoadCost;   // per unit load cost
+  float per_unit_store_cost_ = kDefaultUnitLoadCost;  // per unit store cost
+  int64_t per_unit_compute_num_ = 1;                  // per unit compute num
 
-  static float thread_startup_cost_;   // thread startup inherent cost
-  static float single_thread_cost_;    // Minimum cost of single-threaded
-  static float parallel_thread_cost_;  // Minimum cost of per thread in parallel-thread
+  float thread_startup_cost_ = 100000.0f;  // thread startup inherent cost
+  float single_thread_cost_ = 100000.0f;   // Minimum cost of single-threaded
+  float parallel_thread_cost_ = 40000.0f;  // Minimum cost of per thread in parallel-thread
+
+  // the static per unit compute cost of the kernels is relative to the default load cost, it is scaled by the ratio of
+  // the load cost of this model to the default one, so that all the costs are in the same unit.
+  float compute_cost_scale_ = 1.0f;
+  // calibrated per unit compute cost of {op type, activation type}, overrides the static cost of the kernel
+  std::map<std::pair<int, int>, float> op_compute_cost_;
 };
 
 int UpdateThreadNum(const Context *context, const ThreadCostContext *thread_cost_context, int task_num);
+
+#ifdef SERVER_INFERENCE
+// The costs are in nanoseconds on the calibrated machine. The profile is a text file of "name value" lines, and
+// "op_compute_cost op_type activation_type value" lines for the calibrated ops.
+int LoadThreadCostProfile(const std::string &profile_path, ThreadCostModel *model);
+int SaveThreadCostProfile(const std::string &profile_path, const ThreadCostModel &model);
+// measures the memory access cost, the compute cost of the common element-wise ops and the parallel launch overhead of
+// the pool into model.
+int CalibrateThreadCostModel(const Context *context, ThreadCostModel *model);
+// loads the profile if it exists, otherwise calibrates and saves it, then makes it the current model. It is done once
+// per process.
+int InitThreadCostModel(const Context *context, const std::string &profile_path);
+#endif
 }  // namespace mindspore::lite
 
 #endif  // MINDSPORE_LITE_SRC_INNER_CONTEXT_H
@@ -0,0 +1,219 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+#include "common/common_test.h"
+#include "nnacl/bf16/cast_bf16.h"
+#include "nnacl/bf16/matmul_bf16.h"
+#include "nnacl/bf16/conv_bf16.h"
+#include "nnacl/nnacl_utils.h"
+
+namespace mindspore {
+class Bf16KernelTest : public mindspore::CommonTest {
+ public:
+  Bf16KernelTest() {}
+};
+
+namespace {
+constexpr float kRelativeError = 1e-4;
+
+std::vector<uint16_t> RandomBf16(size_t size, std::mt19937 *gen) {
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  std::vector<float> data(size);
+  for (auto &value : data) {
+    value = dist(*gen);
+  }
+  std::vector<uint16_t> bf16_data(size);
+  Float32ToBf16(data.data(), bf16_data.data(), static_cast<int>(size));
+  return bf16_data;
+}
+
+// c = a(row x deep) * b(deep x col) in double with the bf16 values.
+std::vector<double> ReferenceMatMul(const std::vector<uint16_t> &a, const std::vector<uint16_t> &b,
+                                    const std::vector<float> &bias, int row, int deep, int col) {
+  std::vector<double> c(row * col, 0);
+  for (int r = 0; r < row; ++r) {
+    for (int j = 0; j < col; ++j) {
+      double value = bias[j];
+      for (int d = 0; d < deep; ++d) {
+        value += static_cast<double>(Bf16ToFloat32Scalar(a[r * deep + d])) * Bf16ToFloat32Scalar(b[d * col + j]);
+      }
+      c[r * col + j] = value;
+    }
+  }
+  return c;
+}
+
+void ExpectNear(const std::vector<float> &result, const std::vector<double> &expect, double scale) {
+  ASSERT_EQ(result.size(), expect.size());
+  for (size_t i = 0; i < result.size(); ++i) {
+    ASSERT_NEAR(result[i], expect[i], kRelativeError * scale) << "index " << i;
+  }
+}
+}  // namespace
+
+/// Feature: Float32ToBf16 and Bf16ToFloat32
+/// Description: cast the normal, the rounding, the inf and the nan values with the vectorized and the tail loops
+/// Expectation: the values are rounded to the nearest even and the special values are kept
+TEST_F(Bf16KernelTest, Cast) {
+  std::vector<float> input = {1.0f, -2.5f, 3.14159f, 1.00390625f, 1.01171875f, 65504.0f, 1e-40f, 0.0f, -0.0f,
+                              std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(),
+                              std::numeric_limits<float>::quiet_NaN(), 3.4e38f, 1e38f, -7.0f, 0.1f, 100.0f};
+  std::vector<uint16_t> expect = {0x3f80, 0xc020, 0x4049, 0x3f80, 0x3f82, 0x4780, 0x0001, 0x0000, 0x8000,
+                                  0x7f80, 0xff80, 0x7fc0, 0x7f80, 0x7e96, 0xc0e0, 0x3dcd, 0x42c8};
+  std::vector<uint16_t> output(input.size());
+  Float32ToBf16(input.data(), output.data(), static_cast<int>(input.size()));
+  for (size_t i = 0; i < input.size(); ++i) {
+    EXPECT_EQ(output[i], expect[i]) << "index " << i;
+    EXPECT_EQ(output[i], Float32ToBf16Scalar(input[i])) << "index " << i;
+  }
+  std::vector<float> back(input.size());
+  Bf16ToFloat32(output.data(), back.data(), static_cast<int>(output.size()));
+  for (size_t i = 0; i < input.size(); ++i) {
+    EXPECT_EQ(Float32ToBf16Scalar(back[i]), output[i]) << "index " << i;
+  }
+}
+
+/// Feature: MatMulBf16
+/// Description: pack the lhs and the rhs with and without transpose, and multiply them with odd shapes
+/// Expectation: the results are the same as the double computation of the bf16 values
+TEST_F(Bf16KernelTest, MatMul) {
+  const int row = 19;
+  const int deep = 77;
+  const int col = 37;
+  std::mt19937 gen(0);
+  auto a = RandomBf16(row * deep, &gen);
+  auto b = RandomBf16(deep * col, &gen);
+  std::vector<float> bias(col);
+  for (int j = 0; j < col; ++j) {
+    bias[j] = static_cast<float>(j) / col;
+  }
+  auto expect = ReferenceMatMul(a, b, bias, row, deep, col);
+  std::vector<uint16_t> a_t(row * deep);
+  std::vector<uint16_t> b_t(deep * col);
+  for (int r = 0; r < row; ++r) {
+    for (int d = 0; d < deep; ++d) {
+      a_t[d * row + r] = a[r * deep + d];
+    }
+  }
+  for (int d = 0; d < deep; ++d) {
+    for (int j = 0; j < col; ++j) {
+      b_t[j * deep + d] = b[d * col + j];
+    }
+  }
+  int deep2 = UP_ROUND(deep, C2NUM);
+  for (bool transpose : {false, true}) {
+    std::vector<uint16_t> packed_a(row * deep2);
+    std::vector<uint16_t> packed_b(UP_ROUND(col, C16NUM) * deep2);
+    PackMatmulLhsBf16(transpose ? a_t.data() : a.data(), packed_a.data(), row, deep, transpose);
+    PackMatmulRhsBf16(transpose ? b_t.data() : b.data(), packed_b.data(), deep, col, transpose);
+    std::vector<float> c(row * col);
+    MatMulBf16(packed_a.data(), packed_b.data(), c.data(), bias.data(), ActType_No, deep, row, col, col);
+    ExpectNear(c, expect, deep);
+    MatMulBf16Emulate(packed_a.data(), packed_b.data(), c.data(), bias.data(), ActType_No, deep, row, col, col);
+    ExpectNear(c, expect, deep);
+#ifdef ENABLE_AVX
+    MatMulBf16Avx2(packed_a.data(), packed_b.data(), c.data(), bias.data(), ActType_No, deep, row, col, col);
+    ExpectNear(c, expect, deep);
+#endif
+#ifdef ENABLE_AVX512
+    if (X86Avx512Bf16Support()) {
+      MatMulBf16Avx512(packed_a.data(), packed_b.data(), c.data(), bias.data(), ActType_No, deep, row, col, col);
+      ExpectNear(c, expect, deep);
+    }
+#endif
+  }
+  std::vector<uint16_t> packed_a(row * deep2);
+  std::vector<uint16_t> packed_b(UP_ROUND(col, C16NUM) * deep2);
+  PackMatmulLhsBf16(a.data(), packed_a.data(), row, deep, false);
+  PackMatmulRhsBf16(b.data(), packed_b.data(), deep, col, false);
+  std::vector<float> c(row * col);
+  MatMulBf16(packed_a.data(), packed_b.data(), c.data(), bias.data(), ActType_Relu6, deep, row, col, col);
+  for (auto &value : expect) {
+    value = std::min(6.0, std::max(0.0, value));
+  }
+  ExpectNear(c, expect, deep);
+}
+
+/// Feature: ConvBf16
+/// Description: run the bf16 convolution with padding, stride and dilation by two threads
+/// Expectation: the results are the same as the direct convolution of the bf16 values
+TEST_F(Bf16KernelTest, Conv) {
+  ConvParameter conv_param = {};
+  conv_param.input_batch_ = 2;
+  conv_param.input_h_ = 9;
+  conv_param.input_w_ = 11;
+  conv_param.input_channel_ = 5;
+  conv_param.output_channel_ = 19;
+  conv_param.kernel_h_ = 3;
+  conv_param.kernel_w_ = 3;
+  conv_param.stride_h_ = 2;
+  conv_param.stride_w_ = 1;
+  conv_param.dilation_h_ = 1;
+  conv_param.dilation_w_ = 2;
+  conv_param.pad_u_ = 1;
+  conv_param.pad_l_ = 2;
+  conv_param.output_h_ = 5;
+  conv_param.output_w_ = 11;
+  conv_param.thread_num_ = 2;
+  conv_param.act_type_ = ActType_No;
+  const int in_c = conv_param.input_channel_;
+  const int out_c = conv_param.output_channel_;
+  const int deep = conv_param.kernel_h_ * conv_param.kernel_w_ * in_c;
+  const int output_hw = conv_param.output_h_ * conv_param.output_w_;
+  std::mt19937 gen(1);
+  auto input = RandomBf16(conv_param.input_batch_ * conv_param.input_h_ * conv_param.input_w_ * in_c, &gen);
+  auto weight = RandomBf16(out_c * deep, &gen);
+  std::vector<float> bias(out_c, 0.5f);
+
+  std::vector<uint16_t> packed_weight(UP_ROUND(out_c, C16NUM) * UP_ROUND(deep, C2NUM));
+  PackMatmulRhsBf16(weight.data(), packed_weight.data(), deep, out_c, true);
+  std::vector<uint16_t> packed_input(conv_param.thread_num_ * CONV_BF16_TILE * UP_ROUND(deep, C2NUM));
+  std::vector<float> output(conv_param.input_batch_ * output_hw * out_c);
+  for (int task_id = 0; task_id < conv_param.thread_num_; ++task_id) {
+    ConvBf16(input.data(), packed_input.data(), packed_weight.data(), bias.data(), output.data(), task_id, &conv_param);
+  }
+
+  std::vector<double> expect(output.size());
+  for (int b = 0; b < conv_param.input_batch_; ++b) {
+    for (int oh = 0; oh < conv_param.output_h_; ++oh) {
+      for (int ow = 0; ow < conv_param.output_w_; ++ow) {
+        for (int oc = 0; oc < out_c; ++oc) {
+          double value = bias[oc];
+          for (int kh = 0; kh < conv_param.kernel_h_; ++kh) {
+            for (int kw = 0; kw < conv_param.kernel_w_; ++kw) {
+              int ih = oh * conv_param.stride_h_ - conv_param.pad_u_ + kh * conv_param.dilation_h_;
+              int iw = ow * conv_param.stride_w_ - conv_param.pad_l_ + kw * conv_param.dilation_w_;
+              if (ih < 0 || ih >= conv_param.input_h_ || iw < 0 || iw >= conv_param.input_w_) {
+                continue;
+              }
+              for (int ic = 0; ic < in_c; ++ic) {
+                auto x = input[((b * conv_param.input_h_ + ih) * conv_param.input_w_ + iw) * in_c + ic];
+                auto w = weight[oc * deep + (kh * conv_param.kernel_w_ + kw) * in_c + ic];
+                value += static_cast<double>(Bf16ToFloat32Scalar(x)) * Bf16ToFloat32Scalar(w);
+              }
+            }
+          }
+          expect[(b * output_hw + oh * conv_param.output_w_ + ow) * out_c + oc] = value;
+        }
+      }
+    }
+  }
+  ExpectNear(output, expect, deep);
+}
+}  // namespace mindspore
@@ -0,0 +1,196 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "common/common_test.h"
+#include "nnacl/int8/matmul_int8.h"
+#include "nnacl/int8/fixed_point.h"
+#include "nnacl/nnacl_utils.h"
+
+namespace mindspore {
+class MatMulInt8Test : public mindspore::CommonTest {
+ public:
+  MatMulInt8Test() {}
+};
+
+namespace {
+constexpr int kRow = 37;
+constexpr int kCol = 29;
+constexpr int kDeep = 75;
+constexpr int kOutZp = 3;
+constexpr int kActMin = -100;
+constexpr int kActMax = 120;
+
+struct QuantArgs {
+  std::vector<int32_t> multiplier;
+  std::vector<int32_t> left_shift;
+  std::vector<int32_t> right_shift;
+  std::vector<int32_t> filter_zp;
+  std::vector<int32_t> bias;
+};
+
+std::vector<int8_t> RandomInt8(size_t size, std::mt19937 *gen) {
+  std::uniform_int_distribution<int> dist(INT8_MIN, INT8_MAX);
+  std::vector<int8_t> data(size);
+  for (auto &value : data) {
+    value = static_cast<int8_t>(dist(*gen));
+  }
+  return data;
+}
+
+QuantArgs RandomQuantArgs(int col, bool per_channel, std::mt19937 *gen) {
+  std::uniform_int_distribution<int32_t> multiplier_dist(1 << 29, INT32_MAX);
+  std::uniform_int_distribution<int32_t> shift_dist(-12, -8);
+  std::uniform_int_distribution<int32_t> zp_dist(-5, 5);
+  std::uniform_int_distribution<int32_t> bias_dist(-1000, 1000);
+  QuantArgs args;
+  int param_num = per_channel ? col : 1;
+  for (int i = 0; i < param_num; ++i) {
+    args.multiplier.push_back(multiplier_dist(*gen));
+    args.left_shift.push_back(0);
+    args.right_shift.push_back(shift_dist(*gen));
+    args.filter_zp.push_back(zp_dist(*gen));
+  }
+  for (int i = 0; i < col; ++i) {
+    args.bias.push_back(bias_dist(*gen));
+  }
+  return args;
+}
+
+// The expected result of a(row x deep) * b(col x deep)^T with the row sums subtracted and requantized.
+int8_t ExpectedValue(const std::vector<int8_t> &a, const std::vector<int8_t> &b, int r, int c, int deep,
+                     int32_t input_sum, const QuantArgs &args, bool per_channel) {
+  int32_t value = 0;
+  for (int d = 0; d < deep; ++d) {
+    value += static_cast<int32_t>(a[r * deep + d]) * static_cast<int32_t>(b[c * deep + d]);
+  }
+  value = value - input_sum + args.bias[c];
+  int index = per_channel ? c : 0;
+  value = MultiplyByQuantizedMultiplier(value, args.multiplier[index], args.left_shift[index],
+                                        args.right_shift[index]) +
+          kOutZp;
+  return static_cast<int8_t>(std::max(kActMin, std::min(kActMax, value)));
+}
+}  // namespace
+
+/// Feature: MatmulInt8Opt
+/// Description: multiply the row4x16-major int8 matrix by the row16x4-major int8 matrix with per layer and per
+/// channel quant args, the x86 builds use the avx2 or avx512 vnni kernels
+/// Expectation: the results are the same as the scalar computation
+TEST_F(MatMulInt8Test, MatmulInt8Opt) {
+  std::mt19937 gen(0);
+  int row4 = UP_ROUND(kRow, C4NUM);
+  int col4 = UP_ROUND(kCol, C4NUM);
+  int deep16 = UP_ROUND(kDeep, C16NUM);
+  auto a = RandomInt8(kRow * kDeep, &gen);
+  auto b = RandomInt8(kCol * kDeep, &gen);
+  std::vector<int8_t> packed_a(row4 * deep16, 0);
+  std::vector<int8_t> packed_b(col4 * deep16, 0);
+  RowMajor2Row16x4MajorInt8(a.data(), packed_a.data(), kRow, kDeep);
+  RowMajor2Row16x4MajorInt8(b.data(), packed_b.data(), kCol, kDeep);
+  std::vector<int32_t> a_sums(row4, 0);
+  for (int r = 0; r < kRow; ++r) {
+    for (int d = 0; d < kDeep; ++d) {
+      a_sums[r] += a[r * kDeep + d];
+    }
+  }
+
+  for (bool per_channel : {false, true}) {
+    auto args = RandomQuantArgs(kCol, per_channel, &gen);
+    std::vector<int32_t> input_sums(row4, 0);
+    for (int r = 0; r < kRow; ++r) {
+      input_sums[r] = per_channel ? a_sums[r] : a_sums[r] * args.filter_zp[0];
+    }
+    std::vector<int8_t> dst(kRow * kCol, 0);
+    MatmulInt8Opt(packed_a.data(), packed_b.data(), dst.data(), kRow, kCol, deep16, input_sums.data(),
+                  args.bias.data(), kActMin, kActMax, kOutZp, args.multiplier.data(), args.left_shift.data(),
+                  args.right_shift.data(), kCol, per_channel, args.filter_zp.data());
+    for (int r = 0; r < kRow; ++r) {
+      for (int c = 0; c < kCol; ++c) {
+        int32_t input_sum = per_channel ? input_sums[r] * args.filter_zp[c] : input_sums[r];
+        ASSERT_EQ(dst[r * kCol + c], ExpectedValue(a, b, r, c, kDeep, input_sum, args, per_channel));
+      }
+    }
+  }
+}
+
+/// Feature: MatMulInt8_8x8_r
+/// Description: multiply the row8x4-major int8 matrix by the row4x8-major int8 matrix with per layer and per channel
+/// quant args, the x86 builds use the avx2 or avx512 vnni kernels
+/// Expectation: the results are the same as the scalar computation
+TEST_F(MatMulInt8Test, MatMulInt8_8x8_r) {
+  std::mt19937 gen(1);
+  int row8 = UP_ROUND(kRow, C8NUM);
+  int col8 = UP_ROUND(kCol, C8NUM);
+  int deep4 = UP_ROUND(kDeep, C4NUM);
+  auto a = RandomInt8(kRow * kDeep, &gen);
+  auto b = RandomInt8(kCol * kDeep, &gen);
+  std::vector<int8_t> packed_a(row8 * deep4, 0);
+  std::vector<int8_t> packed_b(col8 * deep4, 0);
+  RowMajor2Row8x4MajorInt8(a.data(), packed_a.data(), kRow, kDeep);
+  RowMajor2Row8x4MajorInt8(b.data(), packed_b.data(), kCol, kDeep);
+
+  for (bool per_channel : {false, true}) {
+    auto args = RandomQuantArgs(kCol, per_channel, &gen);
+    // The per channel input sums are packed as col8 blocks of row8 x 8.
+    std::vector<int32_t> input_sums(per_channel ? row8 * col8 : row8, 0);
+    std::uniform_int_distribution<int32_t> sum_dist(-10000, 10000);
+    for (auto &sum : input_sums) {
+      sum = sum_dist(gen);
+    }
+    std::vector<int8_t> dst(kRow * kCol, 0);
+    MatMulInt8_8x8_r(packed_a.data(), packed_b.data(), dst.data(), kRow, kCol, deep4, kCol, input_sums.data(),
+                     args.bias.data(), args.left_shift.data(), args.right_shift.data(), args.multiplier.data(), kOutZp,
+                     kActMin, kActMax, per_channel);
+    for (int r = 0; r < kRow; ++r) {
+      for (int c = 0; c < kCol; ++c) {
+        int32_t input_sum =
+          per_channel ? input_sums[c / C8NUM * row8 * C8NUM + r * C8NUM + c % C8NUM] : input_sums[r];
+        ASSERT_EQ(dst[r * kCol + c], ExpectedValue(a, b, r, c, kDeep, input_sum, args, per_channel));
+      }
+    }
+  }
+}
+
+#ifdef ENABLE_AVX512
+/// Feature: MatmulInt8OptAvx512Vnni
+/// Description: run the avx512 vnni and the avx2 int8 kernels on the same inputs when the cpu supports vnni
+/// Expectation: the results are the same
+TEST_F(MatMulInt8Test, Avx512VnniSameAsAvx2) {
+  if (!X86Avx512VnniSupport()) {
+    return;
+  }
+  std::mt19937 gen(2);
+  int row4 = UP_ROUND(kRow, C4NUM);
+  int col4 = UP_ROUND(kCol, C4NUM);
+  int deep16 = UP_ROUND(kDeep, C16NUM);
+  auto packed_a = RandomInt8(row4 * deep16, &gen);
+  auto packed_b = RandomInt8(col4 * deep16, &gen);
+  auto args = RandomQuantArgs(kCol, true, &gen);
+  std::vector<int32_t> input_sums(row4, 1);
+  std::vector<int8_t> vnni_dst(kRow * kCol, 0);
+  std::vector<int8_t> avx2_dst(kRow * kCol, 0);
+  MatmulInt8OptAvx512Vnni(packed_a.data(), packed_b.data(), vnni_dst.data(), kRow, kCol, deep16, input_sums.data(),
+                          args.bias.data(), kActMin, kActMax, kOutZp, args.multiplier.data(), args.left_shift.data(),
+                          args.right_shift.data(), kCol, true, args.filter_zp.data());
+  MatmulInt8OptAvx2(packed_a.data(), packed_b.data(), avx2_dst.data(), kRow, kCol, deep16, input_sums.data(),
+                    args.bias.data(), kActMin, kActMax, kOutZp, args.multiplier.data(), args.left_shift.data(),
+                    args.right_shift.data(), kCol, true, args.filter_zp.data());
+  ASSERT_EQ(vnni_dst, avx2_dst);
+}
+#endif
+}  // namespace mindspore
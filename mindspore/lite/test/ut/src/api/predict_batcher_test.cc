@@ -0,0 +1,133 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "src/cxx_api/model_pool/predict_batcher.h"
+
+namespace mindspore {
+namespace {
+constexpr int64_t kMaxBatchSize = 8;
+constexpr int64_t kMaxDelayUs = 200000;
+constexpr size_t kRequestNum = 4;
+constexpr int64_t kSampleSize = 3;
+
+MSTensor CreateFloatTensor(const std::vector<int64_t> &shape, const std::vector<float> &data) {
+  auto tensor = MSTensor::CreateTensor("tensor", DataType::kNumberTypeFloat32, shape, data.data(),
+                                       data.size() * sizeof(float));
+  MSTensor result = tensor == nullptr ? MSTensor(nullptr) : *tensor;
+  delete tensor;
+  return result;
+}
+
+std::vector<float> GetData(const MSTensor &tensor) {
+  auto data = reinterpret_cast<const float *>(tensor.Data().get());
+  return std::vector<float>(data, data + tensor.ElementNum());
+}
+
+// Run kRequestNum requests of batch 1 at the same time, the i-th request has the sample filled with i.
+void RunRequests(PredictBatcher *batcher, std::vector<std::vector<MSTensor>> *outputs, std::vector<Status> *status) {
+  std::vector<std::vector<MSTensor>> inputs(kRequestNum);
+  for (size_t i = 0; i < kRequestNum; i++) {
+    inputs[i].push_back(CreateFloatTensor({1, kSampleSize}, std::vector<float>(kSampleSize, static_cast<float>(i))));
+  }
+  outputs->resize(kRequestNum);
+  status->resize(kRequestNum);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < kRequestNum; i++) {
+    ASSERT_TRUE(batcher->CanBatch(inputs[i], &outputs->at(i)));
+    threads.emplace_back([batcher, &inputs, outputs, status, i]() {
+      status->at(i) = batcher->Predict(inputs[i], &outputs->at(i));
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+}  // namespace
+
+class PredictBatcherTest : public mindspore::CommonTest {
+ public:
+  PredictBatcherTest() {}
+};
+
+/// Feature: PredictBatcher
+/// Description: run concurrent requests on a model whose output is batched by dim 0
+/// Expectation: the requests are merged, and each request gets the output of its own sample
+TEST_F(PredictBatcherTest, SplitBatchedOutputs) {
+  std::atomic<size_t> merged_num(0);
+  auto predict_func = [&merged_num](const std::vector<MSTensor> &inputs, std::vector<MSTensor> *outputs) {
+    if (inputs[0].Shape()[0] > 1) {
+      ++merged_num;
+    }
+    auto data = GetData(inputs[0]);
+    for (auto &value : data) {
+      value *= 2;
+    }
+    outputs->push_back(CreateFloatTensor(inputs[0].Shape(), data));
+    return Status(kSuccess);
+  };
+  PredictBatcher batcher(kMaxBatchSize, kMaxDelayUs, predict_func);
+  std::vector<std::vector<MSTensor>> outputs;
+  std::vector<Status> status;
+  RunRequests(&batcher, &outputs, &status);
+  ASSERT_GT(merged_num.load(), 0);
+  for (size_t i = 0; i < kRequestNum; i++) {
+    ASSERT_EQ(status[i], kSuccess);
+    ASSERT_EQ(outputs[i].size(), 1);
+    ASSERT_EQ(outputs[i][0].Shape(), std::vector<int64_t>({1, kSampleSize}));
+    ASSERT_EQ(GetData(outputs[i][0]), std::vector<float>(kSampleSize, static_cast<float>(2 * i)));
+  }
+}
+
+/// Feature: PredictBatcher
+/// Description: run concurrent requests on a model whose output sums the samples, so its dim 0 is not the batch
+/// Expectation: the merged requests are run one by one, each request gets the output of its own sample, and the later
+/// requests are not merged
+TEST_F(PredictBatcherTest, FallBackForNonBatchedOutputs) {
+  std::atomic<size_t> merged_num(0);
+  auto predict_func = [&merged_num](const std::vector<MSTensor> &inputs, std::vector<MSTensor> *outputs) {
+    auto batch = inputs[0].Shape()[0];
+    if (batch > 1) {
+      ++merged_num;
+    }
+    auto data = GetData(inputs[0]);
+    std::vector<float> sum(kSampleSize, 0);
+    for (int64_t i = 0; i < batch; i++) {
+      for (int64_t j = 0; j < kSampleSize; j++) {
+        sum[j] += data[i * kSampleSize + j];
+      }
+    }
+    outputs->push_back(CreateFloatTensor({1, kSampleSize}, sum));
+    return Status(kSuccess);
+  };
+  PredictBatcher batcher(kMaxBatchSize, kMaxDelayUs, predict_func);
+  std::vector<std::vector<MSTensor>> outputs;
+  std::vector<Status> status;
+  RunRequests(&batcher, &outputs, &status);
+  ASSERT_GT(merged_num.load(), 0);
+  for (size_t i = 0; i < kRequestNum; i++) {
+    ASSERT_EQ(status[i], kSuccess);
+    ASSERT_EQ(outputs[i].size(), 1);
+    ASSERT_EQ(GetData(outputs[i][0]), std::vector<float>(kSampleSize, static_cast<float>(i)));
+  }
+  std::vector<MSTensor> inputs = {CreateFloatTensor({1, kSampleSize}, std::vector<float>(kSampleSize, 0))};
+  std::vector<MSTensor> empty_outputs;
+  ASSERT_FALSE(batcher.CanBatch(inputs, &empty_outputs));
+}
+}  // namespace mindspore
@@ -0,0 +1,89 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include "common/common_test.h"
+#include "include/errorcode.h"
+#include "src/thread_cost_model.h"
+
+namespace mindspore {
+namespace {
+constexpr auto kProfilePath = "./thread_cost_model_test.profile";
+
+void WriteProfile(const std::string &content) {
+  std::ofstream ofs(kProfilePath);
+  ofs << content;
+}
+}  // namespace
+
+class ThreadCostModelTest : public mindspore::CommonTest {
+ public:
+  ThreadCostModelTest() {}
+  void TearDown() override { (void)std::remove(kProfilePath); }
+};
+
+/// Feature: ThreadCostModel profile
+/// Description: save a model with the costs different from the default ones and load it into a default model
+/// Expectation: the loaded model has the saved costs, and the compute cost scale follows the load cost
+TEST_F(ThreadCostModelTest, SaveAndLoadProfile) {
+  lite::ThreadCostModel model;
+  model.per_unit_load_cost_ = 0.5f;
+  model.per_unit_store_cost_ = 0.75f;
+  model.thread_startup_cost_ = 2048.0f;
+  model.single_thread_cost_ = 5120.0f;
+  model.parallel_thread_cost_ = 2048.0f;
+  model.op_compute_cost_ = {{{1, 0}, 1.25f}, {{2, 3}, 0.125f}};
+  ASSERT_EQ(lite::SaveThreadCostProfile(kProfilePath, model), lite::RET_OK);
+
+  lite::ThreadCostModel loaded;
+  ASSERT_EQ(lite::LoadThreadCostProfile(kProfilePath, &loaded), lite::RET_OK);
+  ASSERT_FLOAT_EQ(loaded.per_unit_load_cost_, model.per_unit_load_cost_);
+  ASSERT_FLOAT_EQ(loaded.per_unit_store_cost_, model.per_unit_store_cost_);
+  ASSERT_FLOAT_EQ(loaded.thread_startup_cost_, model.thread_startup_cost_);
+  ASSERT_FLOAT_EQ(loaded.single_thread_cost_, model.single_thread_cost_);
+  ASSERT_FLOAT_EQ(loaded.parallel_thread_cost_, model.parallel_thread_cost_);
+  ASSERT_FLOAT_EQ(loaded.compute_cost_scale_, model.per_unit_load_cost_ / lite::kDefaultUnitLoadCost);
+  ASSERT_EQ(loaded.op_compute_cost_, model.op_compute_cost_);
+}
+
+/// Feature: ThreadCostModel profile
+/// Description: load a profile which has comments, empty lines and only part of the costs
+/// Expectation: the costs in the profile are loaded, and the other costs keep the default values
+TEST_F(ThreadCostModelTest, LoadPartialProfile) {
+  WriteProfile("# comment\n\nthread_startup_cost 1000\nop_compute_cost 5 1 2.5\n");
+  lite::ThreadCostModel loaded;
+  ASSERT_EQ(lite::LoadThreadCostProfile(kProfilePath, &loaded), lite::RET_OK);
+  lite::ThreadCostModel default_model;
+  ASSERT_FLOAT_EQ(loaded.thread_startup_cost_, 1000.0f);
+  ASSERT_FLOAT_EQ(loaded.per_unit_load_cost_, default_model.per_unit_load_cost_);
+  ASSERT_FLOAT_EQ(loaded.compute_cost_scale_, 1.0f);
+  ASSERT_EQ(loaded.op_compute_cost_.size(), 1);
+  ASSERT_FLOAT_EQ(loaded.op_compute_cost_.at({5, 1}), 2.5f);
+}
+
+/// Feature: ThreadCostModel profile
+/// Description: load the profiles which do not exist, have an unknown cost, a negative cost or a broken op cost line
+/// Expectation: the loading fails
+TEST_F(ThreadCostModelTest, LoadInvalidProfile) {
+  lite::ThreadCostModel loaded;
+  ASSERT_NE(lite::LoadThreadCostProfile(kProfilePath, &loaded), lite::RET_OK);
+  for (auto content : {"unknown_cost 1\n", "per_unit_load_cost -1\n", "op_compute_cost 5 1\n"}) {
+    WriteProfile(content);
+    ASSERT_NE(lite::LoadThreadCostProfile(kProfilePath, &loaded), lite::RET_OK) << content;
+  }
+}
+}  // namespace mindspore
@@ -541,6 +541,7 @@ int Benchmark::MarkPerformance() {
     const std::vector<std::string> per_op_type = {"opType", "avg(ms)", "percent", "calledTimes", "opTotalTime"};
     PrintResult(per_op_name, op_times_by_name_);
     PrintResult(per_op_type, op_times_by_type_);
+    PrintThroughputResult();
 #ifdef ENABLE_ARM64
   } else if (flags_->perf_profiling_) {
     if (flags_->perf_event_ == "CACHE") {
@@ -825,6 +826,13 @@ int Benchmark::InitTimeProfilingCallbackParameter() {
     op_times_by_type_[call_param.node_type].second += cost;
     op_times_by_name_[call_param.node_name].first++;
     op_times_by_name_[call_param.node_name].second += cost;
+    if (after_inputs.size() > 1 && !after_outputs.empty()) {
+      auto in_shape = after_inputs.front()->shape();
+      auto out_shape = after_outputs.front()->shape();
+      UpdateOpFlops(call_param.node_name, call_param.node_type, after_inputs.front()->data_type(),
+                    std::vector<int64_t>(in_shape.begin(), in_shape.end()), after_inputs.at(1)->ElementsNum(),
+                    std::vector<int64_t>(out_shape.begin(), out_shape.end()));
+    }
     return true;
   };
   return RET_OK;
@@ -22,6 +22,7 @@
 #include <utility>
 #include <regex>
 #include <functional>
+#include <unordered_set>
 #include "include/context.h"
 #include "include/ms_tensor.h"
 #include "include/version.h"
@@ -48,6 +49,10 @@ constexpr int kParallelThreadNumMin = 1;
 constexpr int kColumnLen = 4;
 constexpr int kPrintColNum = 5;
 constexpr int kPrintRowLenMax = 100;
+constexpr double kFlopsPerMac = 2.0;
+constexpr size_t kMatMulMinRank = 2;
+constexpr double kMsPerSecond = 1000.0;
+constexpr double kFlopsPerGiga = 1e9;
 
 constexpr float kInputDataFloatMin = 0.1f;
 constexpr float kInputDataFloatMax = 1.0f;
@@ -81,6 +86,13 @@ const std::unordered_map<mindspore::Format, std::string> kTensorFormatMap{
   {mindspore::CHWK, "CHWK"}, {mindspore::HW, "HW"},         {mindspore::HW4, "HW4"},     {mindspore::NC, "NC"},
   {mindspore::NC4, "NC4"},   {mindspore::NC4HW4, "NC4HW4"}, {mindspore::NCDHW, "NCDHW"}};
 
+// The ops whose weight is the second input and each output channel is the dot product of weight_elements / out_channel
+// input values and weights.
+const std::unordered_set<std::string> kFlopsCountedOps{"Conv2DFusion", "Conv2D", "MatMulFusion", "MatMul",
+                                                       "FullConnection"};
+// The ops whose second input may be batched, so each output is the dot product of the reduction dim K of the inputs.
+const std::unordered_set<std::string> kMatMulOps{"MatMulFusion", "MatMul"};
+
 int BenchmarkBase::GenerateRandomData(size_t size, void *data, int data_type) {
   if (data == nullptr && size > 0) {
     data = malloc(size);
@@ -564,6 +576,61 @@ int BenchmarkBase::PrintResult(const std::vector<std::string> &title,
   return RET_OK;
 }
 
+void BenchmarkBase::UpdateOpFlops(const std::string &node_name, const std::string &node_type, int data_type,
+                                  const std::vector<int64_t> &input_shape, int64_t weight_elements,
+                                  const std::vector<int64_t> &output_shape) {
+  if (kFlopsCountedOps.find(node_type) == kFlopsCountedOps.end() || output_shape.empty() || output_shape.back() <= 0) {
+    return;
+  }
+  int64_t output_elements = 1;
+  for (auto dim : output_shape) {
+    output_elements *= dim;
+  }
+  auto macs_per_output = static_cast<double>(weight_elements) / static_cast<double>(output_shape.back());
+  // The last two dims of the first input are M and K in either order whatever the transpose is, and M is the second
+  // last dim of the output, while the weight elements of a batched matmul count the batch too.
+  if (kMatMulOps.find(node_type) != kMatMulOps.end() && input_shape.size() >= kMatMulMinRank &&
+      output_shape.size() >= kMatMulMinRank && output_shape[output_shape.size() - kMatMulMinRank] > 0) {
+    macs_per_output = static_cast<double>(input_shape[input_shape.size() - 1] *
+                                          input_shape[input_shape.size() - kMatMulMinRank]) /
+                      static_cast<double>(output_shape[output_shape.size() - kMatMulMinRank]);
+  }
+  auto type_name = kTypeIdMap.find(data_type) != kTypeIdMap.end() ? kTypeIdMap.at(data_type) : "Unknown";
+  auto &flops = op_flops_by_name_[node_name];
+  flops.first = node_type + "(" + type_name + ")";
+  flops.second += kFlopsPerMac * static_cast<double>(output_elements) * macs_per_output;
+}
+
+int BenchmarkBase::PrintThroughputResult() {
+  if (op_flops_by_name_.empty()) {
+    return RET_OK;
+  }
+  // op type with data type -> (cost of all the calls in ms, float operations of all the calls)
+  std::map<std::string, std::pair<float, double>> flops_by_type;
+  printf("-------------------------------------------------------------------------\n");
+  printf("%-48s\t%-24s\t%-12s\t%-12s\n", "opName", "opType(dataType)", "avg(ms)", "GFLOPS");
+  for (auto &iter : op_flops_by_name_) {
+    auto times = op_times_by_name_.find(iter.first);
+    if (times == op_times_by_name_.end() || times->second.second <= 0) {
+      continue;
+    }
+    auto cost = times->second.second;
+    auto gflops = iter.second.second / (cost / kMsPerSecond) / kFlopsPerGiga;
+    printf("%-48s\t%-24s\t%-12f\t%-12f\n", iter.first.c_str(), iter.second.first.c_str(),
+           cost / static_cast<float>(flags_->loop_count_), gflops);
+    flops_by_type[iter.second.first].first += cost;
+    flops_by_type[iter.second.first].second += iter.second.second;
+  }
+  printf("-------------------------------------------------------------------------\n");
+  printf("%-24s\t%-12s\t%-12s\n", "opType(dataType)", "avg(ms)", "GFLOPS");
+  for (auto &iter : flops_by_type) {
+    auto cost = iter.second.first;
+    auto gflops = iter.second.second / (cost / kMsPerSecond) / kFlopsPerGiga;
+    printf("%-24s\t%-12f\t%-12f\n", iter.first.c_str(), cost / static_cast<float>(flags_->loop_count_), gflops);
+  }
+  return RET_OK;
+}
+
 #ifdef ENABLE_ARM64
 int BenchmarkBase::PrintPerfResult(const std::vector<std::string> &title,
                                    const std::map<std::string, std::pair<int, struct PerfCount>> &result) {
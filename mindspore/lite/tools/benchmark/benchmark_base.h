@@ -150,6 +150,13 @@ class MS_API BenchmarkFlags : public virtual FlagParser {
     AddFlag(&BenchmarkFlags::parallel_request_num_, "parallelRequestNum", "parallel request num of parallel predict",
             1);
     AddFlag(&BenchmarkFlags::workers_num_, "workersNum", "works num of parallel predict", 2);
+    AddFlag(&BenchmarkFlags::max_batch_size_, "maxBatchSize",
+            "merge the parallel requests into one inference up to this batch, 0 means disable", 0);
+    AddFlag(&BenchmarkFlags::max_batch_delay_us_, "maxBatchDelayUs",
+            "max time in microseconds a request waits to be merged", 1000);
+    AddFlag(&BenchmarkFlags::stress_client_num_, "stressClientNum",
+            "client threads of the parallel predict stress test, 0 means disable", 0);
+    AddFlag(&BenchmarkFlags::stress_time_, "stressTime", "seconds of the parallel predict stress test", 10);
 #ifdef ENABLE_OPENGL_TEXTURE
     AddFlag(&BenchmarkFlags::enable_gl_texture_, "enableGLTexture", "Enable GlTexture2D", false);
 #endif
@@ -166,6 +173,10 @@ class MS_API BenchmarkFlags : public virtual FlagParser {
   bool enable_parallel_predict_ = false;
   int parallel_request_num_ = 1;
   int workers_num_ = 2;
+  int max_batch_size_ = 0;
+  int max_batch_delay_us_ = 1000;
+  int stress_client_num_ = 0;
+  int stress_time_ = 10;
   std::string model_file_;
   std::string in_data_file_;
   std::string config_file_;
@@ -246,6 +257,14 @@ class MS_API BenchmarkBase {
 
   int PrintResult(const std::vector<std::string> &title, const std::map<std::string, std::pair<int, float>> &result);
 
+  // Records the float operations of the conv and matmul like ops, so the throughput of each layer can be compared
+  // between the int8 and the float model.
+  void UpdateOpFlops(const std::string &node_name, const std::string &node_type, int data_type,
+                     const std::vector<int64_t> &input_shape, int64_t weight_elements,
+                     const std::vector<int64_t> &output_shape);
+
+  int PrintThroughputResult();
+
 #ifdef ENABLE_ARM64
   int PrintPerfResult(const std::vector<std::string> &title,
                       const std::map<std::string, std::pair<int, struct PerfCount>> &result);
@@ -438,6 +457,8 @@ class MS_API BenchmarkBase {
   float op_cost_total_ = 0.0f;
   std::map<std::string, std::pair<int, float>> op_times_by_type_;
   std::map<std::string, std::pair<int, float>> op_times_by_name_;
+  // op name -> (op type with data type, float operations of all the calls)
+  std::map<std::string, std::pair<std::string, double>> op_flops_by_name_;
 #ifndef BENCHMARK_CLIP_JSON
   // dump data
   nlohmann::json dump_cfg_json_;
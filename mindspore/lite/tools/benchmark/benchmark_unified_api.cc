@@ -43,6 +43,8 @@
 #endif
 #ifdef SERVER_INFERENCE
 #include <thread>
+#include <mutex>
+#include <atomic>
 #endif
 namespace mindspore {
 constexpr size_t kDataToStringMaxNum = 40;
@@ -53,6 +55,8 @@ constexpr int kDumpInputsAndOutputs = 0;
 constexpr int kDumpOutputs = 2;
 #ifdef SERVER_INFERENCE
 constexpr int kMaxRequestNum = 200;
+constexpr float kLatencyP50 = 0.5;
+constexpr float kLatencyP99 = 0.99;
 #endif
 namespace lite {
 #ifdef ENABLE_OPENGL_TEXTURE
@@ -803,6 +807,7 @@ int BenchmarkUnifiedApi::MarkPerformance() {
     const std::vector<std::string> per_op_type = {"opType", "avg(ms)", "percent", "calledTimes", "opTotalTime"};
     PrintResult(per_op_name, op_times_by_name_);
     PrintResult(per_op_type, op_times_by_type_);
+    PrintThroughputResult();
 #ifdef ENABLE_ARM64
   } else if (flags_->perf_profiling_) {
     if (flags_->perf_event_ == "CACHE") {
@@ -948,6 +953,22 @@ int BenchmarkUnifiedApi::PrintInputData() {
   return RET_OK;
 }
 #ifdef SERVER_INFERENCE
+namespace {
+void PrintParallelLatency(std::vector<uint64_t> *latencies, uint64_t run_time_us) {
+  if (latencies->empty() || run_time_us == 0) {
+    return;
+  }
+  std::sort(latencies->begin(), latencies->end());
+  auto percentile = [latencies](float ratio) {
+    auto index = static_cast<size_t>(ratio * (latencies->size() - 1));
+    return latencies->at(index) / kFloatMSEC;
+  };
+  std::cout << "parallel predict latency p50: " << percentile(kLatencyP50) << " ms, p99: " << percentile(kLatencyP99)
+            << " ms\n";
+  std::cout << "parallel predict QPS: " << latencies->size() * kFloatMSEC * kFloatMSEC / run_time_us << "\n";
+}
+}  // namespace
+
 int BenchmarkUnifiedApi::RunModelPool(std::shared_ptr<mindspore::Context> context) {
   if (flags_->warm_up_loop_count_ > kMaxRequestNum) {
     MS_LOG(WARNING) << "in parallel predict warm up loop count should less than" << kMaxRequestNum;
@@ -964,6 +985,8 @@ int BenchmarkUnifiedApi::RunModelPool(std::shared_ptr<mindspore::Context> contex
   auto runner_config = std::make_shared<RunnerConfig>();
   runner_config->context = context;
   runner_config->workers_num = flags_->workers_num_;
+  runner_config->max_batch_size = flags_->max_batch_size_;
+  runner_config->max_batch_delay_us = flags_->max_batch_delay_us_;
   auto model_init_start = GetTimeUs();
   auto ret = model_pool.Init(flags_->model_file_, runner_config);
   if (ret != kSuccess) {
@@ -999,6 +1022,8 @@ int BenchmarkUnifiedApi::RunModelPool(std::shared_ptr<mindspore::Context> contex
     }
   }
   // model pool predict
+  std::mutex latency_mutex;
+  std::vector<uint64_t> latencies;
   auto model_pool_run = [&](int num) {
     auto input = all_inputs_[num];
     auto output = all_outputs_[num];
@@ -1009,6 +1034,10 @@ int BenchmarkUnifiedApi::RunModelPool(std::shared_ptr<mindspore::Context> contex
     }
     auto predict_end = GetTimeUs();
     std::cout << "per predict time: " << (predict_end - predict_start) / kFloatMSEC << " ms\n";
+    if (num >= flags_->warm_up_loop_count_) {
+      std::lock_guard<std::mutex> latency_lock(latency_mutex);
+      latencies.push_back(predict_end - predict_start);
+    }
     if (!flags_->benchmark_data_file_.empty()) {
       auto status = CompareOutputForModelPool(&output);
       if (status != RET_OK) {
@@ -1038,9 +1067,54 @@ int BenchmarkUnifiedApi::RunModelPool(std::shared_ptr<mindspore::Context> contex
   std::cout << "=================================" << std::endl;
   std::cout << "parallel predict init time: " << (model_init_end - model_init_start) / kFloatMSEC << " ms\n";
   std::cout << "parallel predict all run time: " << (all_end - all_start) / kFloatMSEC / flags_->loop_count_ << " ms\n";
+  PrintParallelLatency(&latencies, all_end - all_start);
   std::cout << "=================================" << std::endl;
+  if (flags_->stress_client_num_ > 0) {
+    return RunModelPoolStress(&model_pool);
+  }
   return RET_OK;
 }
+
+int BenchmarkUnifiedApi::RunModelPoolStress(ModelParallelRunner *model_pool) {
+  // every client sends the next request as soon as the previous one returns, which keeps the task queue busy.
+  std::cout << "stress parallel predict with " << flags_->stress_client_num_ << " clients for " << flags_->stress_time_
+            << " s\n";
+  std::atomic_bool failed{false};
+  std::vector<std::vector<uint64_t>> client_latencies(flags_->stress_client_num_);
+  auto stress_start = GetTimeUs();
+  uint64_t stress_end = stress_start + static_cast<uint64_t>(flags_->stress_time_ * kFloatMSEC * kFloatMSEC);
+  auto client_run = [&](int client_id) {
+    auto &input = all_inputs_[flags_->warm_up_loop_count_ + client_id % flags_->parallel_request_num_];
+    auto &latencies = client_latencies[client_id];
+    while (!failed && GetTimeUs() < stress_end) {
+      std::vector<MSTensor> output;
+      auto predict_start = GetTimeUs();
+      if (model_pool->Predict(input, &output) != kSuccess) {
+        MS_LOG(ERROR) << "model pool predict failed in stress client " << client_id;
+        failed = true;
+        return;
+      }
+      latencies.push_back(GetTimeUs() - predict_start);
+    }
+  };
+  std::vector<std::thread> clients;
+  for (int i = 0; i < flags_->stress_client_num_; i++) {
+    clients.push_back(std::thread(client_run, i));
+  }
+  for (auto &client : clients) {
+    client.join();
+  }
+  auto run_time = GetTimeUs() - stress_start;
+  std::vector<uint64_t> latencies;
+  for (auto &client_latency : client_latencies) {
+    latencies.insert(latencies.end(), client_latency.begin(), client_latency.end());
+  }
+  std::cout << "=================================" << std::endl;
+  std::cout << "stress predict request num: " << latencies.size() << "\n";
+  PrintParallelLatency(&latencies, run_time);
+  std::cout << "=================================" << std::endl;
+  return failed ? RET_ERROR : RET_OK;
+}
 #endif
 
 int BenchmarkUnifiedApi::CompileGraph(ModelType model_type, const std::shared_ptr<Context> &context,
@@ -1221,6 +1295,10 @@ int BenchmarkUnifiedApi::InitTimeProfilingCallbackParameter() {
     op_times_by_type_[call_param.node_type].second += cost;
     op_times_by_name_[call_param.node_name].first++;
     op_times_by_name_[call_param.node_name].second += cost;
+    if (after_inputs.size() > 1 && !after_outputs.empty()) {
+      UpdateOpFlops(call_param.node_name, call_param.node_type, static_cast<int>(after_inputs.front().DataType()),
+                    after_inputs.front().Shape(), after_inputs.at(1).ElementNum(), after_outputs.front().Shape());
+    }
     return true;
   };
   return RET_OK;
@@ -102,6 +102,7 @@ class MS_API BenchmarkUnifiedApi : public BenchmarkBase {
   int PrintInputData();
 #ifdef SERVER_INFERENCE
   int RunModelPool(std::shared_ptr<mindspore::Context> context);
+  int RunModelPoolStress(ModelParallelRunner *model_pool);
 #endif
 
   template <typename T>
@@ -642,6 +642,78 @@ def get_auto_offload():
     return _config.get_auto_offload()
 
 
+def set_unordered_connector(unordered):
+    """
+    Set whether the worker threads of the dataset operations deliver rows without keeping the order among them.
+    If set_unordered_connector is True, a slow worker no longer stalls the rows produced by the other workers,
+    which speeds up the pipelines whose row order does not matter, e.g. the files are shuffled.
+
+    Args:
+        unordered (bool): Whether to deliver the rows of the workers out of order. System default: False.
+
+    Raises:
+        TypeError: If unordered is not a boolean data type.
+
+    Examples:
+        >>> # Let the workers deliver rows out of order
+        >>> ds.config.set_unordered_connector(True)
+    """
+    if not isinstance(unordered, bool):
+        raise TypeError("unordered must be a bool dtype")
+    _config.set_unordered_connector(unordered)
+
+
+def get_unordered_connector():
+    """
+    Get the state of the unordered connector flag (True or False)
+
+    Returns:
+        bool, Whether the workers deliver rows out of order.
+
+    Example:
+        >>> # Get the global configuration of the unordered connector.
+        >>> unordered = ds.config.get_unordered_connector()
+    """
+    return _config.get_unordered_connector()
+
+
+def set_mindrecord_mmap(enable):
+    """
+    Set whether MindDataset reads the MindRecord files by mapping them into memory. If set_mindrecord_mmap is True,
+    the samples are read from the mapped files without extra copies, and the upcoming samples are read ahead.
+
+    Note:
+        This feature is not supported on Windows.
+
+    Args:
+        enable (bool): Whether to map the MindRecord files into memory. System default: False.
+
+    Raises:
+        TypeError: If enable is not a boolean data type.
+
+    Examples:
+        >>> # Read the MindRecord files by mapping them into memory
+        >>> ds.config.set_mindrecord_mmap(True)
+    """
+    if not isinstance(enable, bool):
+        raise TypeError("enable must be a bool dtype")
+    _config.set_mindrecord_mmap(enable)
+
+
+def get_mindrecord_mmap():
+    """
+    Get the state of the MindRecord mmap flag (True or False)
+
+    Returns:
+        bool, Whether the MindRecord files are read by mapping them into memory.
+
+    Example:
+        >>> # Get the global configuration of the MindRecord mmap flag.
+        >>> mindrecord_mmap = ds.config.get_mindrecord_mmap()
+    """
+    return _config.get_mindrecord_mmap()
+
+
 def set_enable_watchdog(enable):
     """
     Set the default state of watchdog Python thread as enabled, the default state of watchdog Python thread is enabled.
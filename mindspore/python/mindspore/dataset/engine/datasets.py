@@ -60,7 +60,7 @@ from mindspore.parallel._utils import _get_device_num
 from . import samplers
 from .iterators import DictIterator, TupleIterator, DummyIterator, check_iterator_cleanup, _set_iterator_cleanup, \
     ITERATORS_LIST, _unset_iterator_cleanup
-from .queue import _SharedQueue
+from .queue import _SharedRing
 from .validators import check_batch, check_shuffle, check_map, check_filter, check_repeat, check_skip, check_zip, \
     check_rename, check_device_send, check_take, check_project, \
     check_sync_wait, check_zip_dataset, check_add_column, check_concat, check_split, check_bucket_batch_by_length, \
@@ -250,9 +250,9 @@ def _set_dataset_permissions(file_name, num_files):
     for item in paths:
         if os.path.exists(item):
             os.chmod(item, stat.S_IRUSR | stat.S_IWUSR)
-            index_file = item + ".db"
-            if os.path.exists(index_file):
-                os.chmod(index_file, stat.S_IRUSR | stat.S_IWUSR)
+            for index_file in [item + ".db", item + ".idx"]:
+                if os.path.exists(index_file):
+                    os.chmod(index_file, stat.S_IRUSR | stat.S_IWUSR)
 
 
 class Dataset:
@@ -2648,8 +2648,8 @@ class ShuffleDataset(UnionBaseDataset):
 # Pyfunc collection for multiprocess pyfunc
 # This global variable will only be used within subprocesses
 _GLOBAL_PYFUNC_LIST = []
-_ARGS_QUEUE = []
-_RET_QUEUE = []
+_ARGS_RING = None
+_RET_RING = None
 _OP_NAME = dict()
 _OP_PROCESS = dict()
 _LOCK = threading.Lock()
@@ -2658,21 +2658,21 @@ _LOCK = threading.Lock()
 # Pyfunc worker init function
 # Python multiprocessing library forbid sending lambda function through pipe.
 # This init function allow us to add all Python function to a global collection and then fork afterwards.
-def _pyfunc_worker_init(pyfunc_list, args_queue, ret_queue):
+def _pyfunc_worker_init(pyfunc_list, args_ring, ret_ring):
     # Some threads in multiprocess.pool can't process sigint signal,
     # and will occur hang problem, so ctrl+c will pass to parent process.
     signal.signal(signal.SIGINT, signal.SIG_IGN)
     global _GLOBAL_PYFUNC_LIST
-    global _ARGS_QUEUE
-    global _RET_QUEUE
+    global _ARGS_RING
+    global _RET_RING
     _GLOBAL_PYFUNC_LIST = pyfunc_list
-    _ARGS_QUEUE = args_queue
-    _RET_QUEUE = ret_queue
+    _ARGS_RING = args_ring
+    _RET_RING = ret_ring
 
 
 # Pyfunc worker execution function
 # All exceptions will be raised to main processes
-def _pyfunc_worker_exec(index, qid, *args):
+def _pyfunc_worker_exec(index, desc, *args):
     """
     Internal function for call certain pyfunc in Python process.
     """
@@ -2680,18 +2680,20 @@ def _pyfunc_worker_exec(index, qid, *args):
     # and will occur hang problem, so ctrl+c will pass to parent process.
     signal.signal(signal.SIGINT, signal.SIG_IGN)
 
-    if qid != -1:
-        # Pass arguments through the Queue instead of directly to remote process
-        args = _ARGS_QUEUE[qid].get()
+    if desc is not None:
+        # The arguments are in the shared memory ring, only their descriptor is passed to remote process
+        args = _ARGS_RING.get(desc)
         try:
             r = _GLOBAL_PYFUNC_LIST[index](*args)
+            if not isinstance(r, tuple):
+                r = (r,)
+            # the result may be a view of the arguments, the arrays which are not copied into the result ring are
+            # copied here, since the descriptor is pickled after the arguments are released
+            return _ARGS_RING.copy_views(_RET_RING.put(r))
         except Exception:
             return ExceptionHandler(where="in map(or batch) worker and execute python function")
-        if isinstance(r, tuple):
-            _RET_QUEUE[qid].put(r)
-        else:
-            _RET_QUEUE[qid].put((r,))
-        return [qid]
+        finally:
+            _ARGS_RING.free(desc[0])
     # not using shared memory for passing arguments, call function directly
     result = None
     try:
@@ -2701,6 +2703,14 @@ def _pyfunc_worker_exec(index, qid, *args):
     return result
 
 
+def _writable_args(args):
+    """
+    The input tensors of a multiprocessing map are passed as read only views, since the worker processes get a copy
+    of them. Copy them when the Python callable runs in the main process instead.
+    """
+    return tuple(np.array(arg) if isinstance(arg, np.ndarray) and not arg.flags.writeable else arg for arg in args)
+
+
 # PythonCallable wrapper for multiprocess pyfunc
 class _PythonCallable:
     """
@@ -2720,9 +2730,9 @@ class _PythonCallable:
             try:
                 return self.pool.execute(self.py_callable, self.idx, *args)
             except multiprocessing.TimeoutError:
-                return self.py_callable(*args)
+                return self.py_callable(*_writable_args(args))
         # Invoke original Python callable in master process in case the pool is gone.
-        return self.py_callable(*args)
+        return self.py_callable(*_writable_args(args))
 
     def to_json(self):
         return self.py_callable.to_json()
@@ -2763,10 +2773,13 @@ class _PythonMultiprocessing(cde.PythonMultiprocessingRuntime):
         self.process_pool = None
         self.op_id = -1
 
-        self.arg_q_list = []
-        self.res_q_list = []
-        self.queues_map = {}
-        self.next_queue = 0
+        self.args_ring = None
+        self.ret_ring = None
+        # the result region of the last row of each thread, see _receive
+        self.pending_ret = {}
+        # the number of calls using the rings, the rings are reclaimed when it goes down to 0
+        self.inflight = 0
+        self.inflight_lock = threading.Lock()
 
         self.eot = None
         self.watch_dog = None
@@ -2796,7 +2809,7 @@ class _PythonMultiprocessing(cde.PythonMultiprocessingRuntime):
         self.process_pool = multiprocessing.Pool(processes=self.num_parallel_workers,
                                                  initializer=_pyfunc_worker_init,
                                                  initargs=(self.operations,
-                                                           self.arg_q_list, self.res_q_list))
+                                                           self.args_ring, self.ret_ring))
 
         self.gather_workers_info()
 
@@ -2843,35 +2856,25 @@ class _PythonMultiprocessing(cde.PythonMultiprocessingRuntime):
         return self.process_pool is not None
 
     def create_shared_memory(self):
-        _check_shm_usage(self.num_parallel_workers, 1, self.max_row_size, 2)
-        self.arg_q_list = []
-        self.res_q_list = []
-        self.queues_map = {}
-        self.next_queue = 0
-
-        for _ in range(self.num_parallel_workers):
-            self.arg_q_list.append(_SharedQueue(1, max_rowsize=self.max_row_size))
-            self.res_q_list.append(_SharedQueue(1, max_rowsize=self.max_row_size))
+        """
+        Create a shared memory ring for the arguments and another for the results, which are shared by all the
+        workers. Each worker may hold a row of max_row_size in both of them, and the main process keeps the last
+        result of each thread until it is copied, so the rings are twice as large.
+        """
+        _check_shm_usage(self.num_parallel_workers, 0, self.max_row_size, 2)
+        ring_size = 2 * self.num_parallel_workers * self.max_row_size * 1024 * 1024
+        self.args_ring = _SharedRing(ring_size)
+        self.ret_ring = _SharedRing(ring_size)
+        self.pending_ret = {}
+        self.inflight = 0
 
     def delete_shared_memory(self):
         """
         Call this method to delete any shared memory created for this pool.
         """
-        if hasattr(self, 'arg_q_list') and self.arg_q_list is not None:
-            arg_q_list_len = len(self.arg_q_list)
-            for idx in range(arg_q_list_len):
-                del self.arg_q_list[arg_q_list_len - idx - 1]
-            del self.arg_q_list
-
-        if hasattr(self, 'res_q_list') and self.res_q_list is not None:
-            res_q_list_len = len(self.res_q_list)
-            for idx in range(res_q_list_len):
-                del self.res_q_list[res_q_list_len - idx - 1]
-            del self.res_q_list
-
-        #  recreate the lists for next pool creation
-        self.arg_q_list = []
-        self.res_q_list = []
+        self.args_ring = None
+        self.ret_ring = None
+        self.pending_ret = {}
 
     def gather_workers_info(self):
         """
@@ -2886,71 +2889,87 @@ class _PythonMultiprocessing(cde.PythonMultiprocessingRuntime):
         Execute
         """
         if self.is_running() and check_iterator_cleanup() is False:
-            result, qid, ret = self._send(py_callable, idx, *args)
-            if ret:
-                return result
-
-            # todo this check might be wrong
-            while check_iterator_cleanup() is False:
-                try:
-                    return self._receive(result, qid)
-                except multiprocessing.TimeoutError:
-                    continue
-                except KeyboardInterrupt:
-                    _set_iterator_cleanup()
-                    self.close_pool()
-                    raise Exception("Multiprocess Op worker receives KeyboardInterrupt.")
-            return (None,)
+            self._enter_call()
+            given_up = False
+            try:
+                result, ret = self._send(py_callable, idx, *args)
+                if ret:
+                    return result
+
+                # todo this check might be wrong
+                while check_iterator_cleanup() is False:
+                    try:
+                        return self._receive(result)
+                    except multiprocessing.TimeoutError:
+                        continue
+                    except KeyboardInterrupt:
+                        _set_iterator_cleanup()
+                        self.close_pool()
+                        raise Exception("Multiprocess Op worker receives KeyboardInterrupt.")
+                # the worker may still use the regions of the call given up, so the rings are not reclaimed anymore
+                given_up = True
+                return (None,)
+            finally:
+                if not given_up:
+                    self._exit_call()
         return None
 
+    def _enter_call(self):
+        with self.inflight_lock:
+            self.inflight += 1
+
+    def _exit_call(self):
+        """
+        Reclaim the rings when no call is in flight. The workers have released the arguments of the received calls,
+        so the regions still in use are the last results of the threads, which their callers may not have copied yet.
+        The regions their owner failed to release, e.g. the arguments of a call which failed to be sent, are reclaimed.
+        """
+        with self.inflight_lock:
+            self.inflight -= 1
+            if self.inflight == 0 and self.args_ring is not None:
+                self.args_ring.reclaim()
+                self.ret_ring.reclaim(set(self.pending_ret.values()))
+
     def _send(self, py_callable, idx, *args):
         """
         The map/batch operator will use multiprocessing-pool apply_async interface to execute python function
         in a sub process, apply_async will release GIL temporarily. For better performance, we use shared memory
-        feature and pass shared queue instead of multiprocess args.
+        feature and pass the descriptor of the arguments in the shared memory ring instead of multiprocess args.
         """
         ret = False
-        qid = None
-        if self.arg_q_list:
-            tid = threading.get_ident()
-            # Need to register each thread to use a different queue to send data to pool
-            if tid not in self.queues_map:
-                qid = self.next_queue
-                self.next_queue += 1
-                self.queues_map[tid] = qid
-            else:
-                qid = self.queues_map[tid]
-            self.arg_q_list[qid].put(args)
+        if self.args_ring is not None:
+            desc = self.args_ring.put(args)
 
-            # This call will send the tensors along with Python callable index to the process pool.
+            # This call will send the descriptor along with Python callable index to the process pool.
             # Block, yield GIL. Current thread will reacquire GIL once result is returned.
             if self.is_running() and check_iterator_cleanup() is False:
-                result = self.process_pool.apply_async(_pyfunc_worker_exec, [idx, qid, []])
+                result = self.process_pool.apply_async(_pyfunc_worker_exec, [idx, desc])
             else:
                 ret = True
-                result = py_callable(*args)
+                self.args_ring.free(desc[0])
+                result = py_callable(*_writable_args(args))
         else:
-            result = self.process_pool.apply_async(_pyfunc_worker_exec, [idx, -1, *args])
-        return result, qid, ret
+            result = self.process_pool.apply_async(_pyfunc_worker_exec, [idx, None, *args])
+        return result, ret
 
-    def _receive(self, result, qid):
+    def _receive(self, result):
         """
         The map/batch operator will use multiprocessing-pool get interface to sync output data from a sub process,
-        get interface will reacquire GIL. For better performance, we use shared memory feature and get data from
-        shared queue directly.
-        """
-        if self.arg_q_list:
-            r = result.get(30)
-            if isinstance(r, ExceptionHandler):
-                r.reraise()
-            if r[0] != qid:
-                raise Exception("In PyCallable, got results from wrong thread")
-            r = self.res_q_list[qid].get()
-            return r
+        get interface will reacquire GIL. For better performance, we use shared memory feature and map the result
+        from the shared memory ring directly.
+        """
         r = result.get(30)
         if isinstance(r, ExceptionHandler):
             r.reraise()
-        return r
+        if self.ret_ring is None:
+            return r
+        # The result is returned as views of the ring, the caller copies it into tensors before it calls again,
+        # so the region of the last result of the current thread is released now.
+        tid = threading.get_ident()
+        self.ret_ring.free(self.pending_ret.pop(tid, None))
+        if r[0] is not None:
+            self.pending_ret[tid] = r[0]
+        return self.ret_ring.get(r)
 
     # This wait function is for cleaning zombie subprocesses
     @staticmethod
@@ -16,6 +16,8 @@
 This dataset module creates an internal queue class to more optimally pass data
 between multiple processes in Python.  It has same API as multiprocessing.queue
 but it will pass large data through shared memory.
+It also creates a ring allocator in shared memory, so that a row can be passed
+between processes by a small descriptor.
 """
 
 import multiprocessing.queues
@@ -151,3 +153,189 @@ class _SharedQueue(multiprocessing.queues.Queue):
 
         self.close()
         self.join_thread()
+
+
+class _SharedRing:
+    """
+    Class to implement a ring allocator in one block of shared memory, which is mapped by the main process and
+    all the workers of a multiprocessing pool. The numpy arrays of a row are copied into one region of the ring,
+    and only the descriptor of the region is sent to the other process, which maps the arrays without copy.
+
+    The regions are allocated at the head of the ring and released in any order. Each region starts with a header
+    which keeps the size of the region, the size is negated when the region is released, and the tail moves
+    forward over the released regions. A region which is never released, e.g. the result of a call given up by the
+    main process, would stop the tail, so the owner reclaims the regions which are not in use at a point where no
+    call is in flight.
+
+    Args:
+        capacity: Size of the shared memory in bytes.
+    """
+    # size of the region header, it also aligns the arrays to the cache line
+    _ALIGN = 64
+
+    def __init__(self, capacity):
+        self.capacity = self._align(capacity)
+        # pipe can hold up to 65,636 bytes at a time, small arrays are sent along with the descriptor
+        self.min_shared_mem = 10000
+        self.print_error = True
+        try:
+            self.buf = multiprocessing.RawArray("b", self.capacity)
+        except Exception:
+            raise RuntimeError(
+                "_SharedRing: Error allocating "
+                + str(self.capacity)
+                + " bytes."
+                + " This might be caused by insufficient shm, and the recommended shm size is at least 5 GB."
+            )
+        self.lock = multiprocessing.Lock()
+        # the bytes allocated and released since the ring is created, the offset in the ring is the value % capacity
+        self.head = multiprocessing.RawValue("Q", 0)
+        self.tail = multiprocessing.RawValue("Q", 0)
+        # numpy views of the buffer, which are created lazily in each process
+        self._mem = None
+        self._headers = None
+
+    def __getstate__(self):
+        state = self.__dict__.copy()
+        state["_mem"] = None
+        state["_headers"] = None
+        return state
+
+    @classmethod
+    def _align(cls, nbytes):
+        return (nbytes + cls._ALIGN - 1) // cls._ALIGN * cls._ALIGN
+
+    def _memory(self):
+        if self._mem is None:
+            self._mem = np.frombuffer(self.buf, dtype=np.uint8)
+            self._headers = self._mem.view(np.int64)
+        return self._mem
+
+    def _allocate(self, nbytes):
+        """Allocate a region for nbytes of data, return the offset of the region, or None if the ring is full."""
+        size = self._ALIGN + self._align(nbytes)
+        self._memory()
+        with self.lock:
+            head = self.head.value
+            offset = head % self.capacity
+            # a region never wraps around, the end of the ring is skipped as a released region if it is too small.
+            skip = self.capacity - offset if offset + size > self.capacity else 0
+            if head + skip + size - self.tail.value > self.capacity:
+                return None
+            if skip > 0:
+                self._headers[offset // 8] = -skip
+                offset = 0
+            self._headers[offset // 8] = size
+            self.head.value = head + skip + size
+        return offset
+
+    def _advance_tail(self):
+        """Move the tail over the released regions, the lock must be held."""
+        tail = self.tail.value
+        head = self.head.value
+        while tail < head:
+            size = int(self._headers[(tail % self.capacity) // 8])
+            if size > 0:
+                break
+            tail -= size
+        self.tail.value = tail
+
+    def free(self, offset):
+        """Release the region at the offset, the arrays mapped from it must not be used anymore."""
+        if offset is None:
+            return
+        self._memory()
+        with self.lock:
+            self._headers[offset // 8] = -abs(int(self._headers[offset // 8]))
+            self._advance_tail()
+
+    def reclaim(self, keep=()):
+        """
+        Release all the regions except the ones at the offsets in keep. It is only called when no other process or
+        thread uses the other regions, they are released even if their owner never does.
+        """
+        self._memory()
+        with self.lock:
+            pos = self.tail.value
+            head = self.head.value
+            while pos < head:
+                offset = pos % self.capacity
+                size = int(self._headers[offset // 8])
+                if size > 0 and offset not in keep:
+                    self._headers[offset // 8] = -size
+                pos += abs(size)
+            self._advance_tail()
+
+    def copy_views(self, desc):
+        """
+        Copy the arrays sent along with the descriptor which are views of the ring, so that they are still valid after
+        their region is released, e.g. a small result returning the argument of a Python function.
+        """
+        offset, items = desc
+        mem = self._memory()
+        return offset, [(None, np.array(item[1])) if item[0] is None and isinstance(item[1], np.ndarray)
+                         and np.may_share_memory(item[1], mem) else item for item in items]
+
+    def put(self, data):
+        """
+        Copy the large numpy arrays of a row into the ring.
+
+        Returns:
+            tuple, the descriptor of the row, which is (offset of the region, items). An item is (position, dtype,
+            shape) of an array in the region, or (None, value) for the value sent along with the descriptor.
+        """
+        layout = []
+        nbytes = 0
+        for r in data:
+            # the map:pyfunc is a yield generator which can't be serialize
+            if isinstance(r, types.GeneratorType):
+                raise TypeError("Can not pickle {} object, please verify pyfunc return with numpy array"
+                                .format(type(r)))
+            if isinstance(r, np.ndarray) and not r.dtype.hasobject and r.nbytes > self.min_shared_mem:
+                layout.append(nbytes)
+                nbytes += self._align(r.nbytes)
+            else:
+                layout.append(None)
+        if nbytes == 0:
+            return None, [(None, r) for r in data]
+        offset = self._allocate(nbytes)
+        if offset is None:
+            # Only print out error the first time it happens
+            if self.print_error:
+                logger.warning("Using shared memory ring, but it is full or the row is larger than it, the row is "
+                               "pickled instead. Ring size: " + str(self.capacity) + ", current rowsize: "
+                               + str(nbytes) + ". Increase max_rowsize to avoid it.")
+                self.print_error = False
+            return None, [(None, r) for r in data]
+        start = offset + self._ALIGN
+        items = []
+        for r, pos in zip(data, layout):
+            if pos is None:
+                items.append((None, r))
+                continue
+            dest = self._mem[start + pos:start + pos + r.nbytes].view(r.dtype).reshape(r.shape)
+            np.copyto(dest, r)
+            items.append((pos, r.dtype, r.shape))
+        return offset, items
+
+    def get(self, desc):
+        """
+        Map the row of the descriptor from the ring without copy, the arrays are valid until the region is released.
+        """
+        offset, items = desc
+        if offset is None:
+            return tuple(value for _, value in items)
+        mem = self._memory()
+        start = offset + self._ALIGN
+        row = []
+        for item in items:
+            if item[0] is None:
+                row.append(item[1])
+                continue
+            pos, dtype, shape = item
+            count = 1
+            for dim in shape:
+                count *= dim
+            nbytes = count * dtype.itemsize
+            row.append(mem[start + pos:start + pos + nbytes].view(dtype).reshape(shape))
+        return tuple(row)
@@ -163,6 +163,8 @@ cast_op_info = CpuRegOp("Cast") \
     .dtype_format(DataType.BOOL_Default, DataType.F32_Default) \
     .dtype_format(DataType.BOOL_Default, DataType.F64_Default) \
     .dtype_format(DataType.BOOL_Default, DataType.BOOL_Default) \
+    .dtype_format(DataType.F32_Default, DataType.BF16_Default) \
+    .dtype_format(DataType.BF16_Default, DataType.F32_Default) \
     .get_op_info()
 
 @op_info_register(cast_op_info)
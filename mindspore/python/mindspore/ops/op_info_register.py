@@ -927,6 +927,7 @@ class DataType:
 
         F64_None = ("float64", "")
         F64_Default = ("float64", "DefaultFormat")
+        BF16_Default = ("bfloat16", "DefaultFormat")
         F64_5HD = ("float64", "NC1HWC0")
         F64_FracZ = ("float64", "FracZ")
         F64_FracNZ = ("float64", "FRACTAL_NZ")
@@ -1093,6 +1094,7 @@ class DataType:
 
     F64_None = ("float64", "")
     F64_Default = ("float64", "DefaultFormat")
+    BF16_Default = ("bfloat16", "DefaultFormat")
     F64_5HD = ("float64", "NC1HWC0")
     F64_FracZ = ("float64", "FracZ")
     F64_FracNZ = ("float64", "FRACTAL_NZ")
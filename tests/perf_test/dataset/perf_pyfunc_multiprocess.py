@@ -0,0 +1,70 @@
+# Copyright 2022 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""test the throughput of map with python_multiprocessing, with and without shared memory"""
+import argparse
+import time
+import numpy as np
+
+import mindspore.dataset as ds
+
+
+class RandomImages:
+    """random HWC uint8 images"""
+
+    def __init__(self, num_rows, height, width):
+        self.num_rows = num_rows
+        self.image = np.random.randint(0, 255, (height, width, 3), dtype=np.uint8)
+
+    def __getitem__(self, index):
+        return self.image, np.array(index, dtype=np.int32)
+
+    def __len__(self):
+        return self.num_rows
+
+
+def augment(image):
+    """a python heavy augmentation, which flips, shifts and normalizes the image"""
+    image = image[:, ::-1, :]
+    image = np.roll(image, 8, axis=0)
+    image = (image.astype(np.float32) - 127.5) / 127.5
+    return image.transpose(2, 0, 1)
+
+
+def run(num_workers, num_rows, height, width, enable_shared_mem):
+    ds.config.set_enable_shared_mem(enable_shared_mem)
+    data_set = ds.GeneratorDataset(RandomImages(num_rows, height, width), ["image", "label"], shuffle=False)
+    data_set = data_set.map(operations=augment, input_columns="image", num_parallel_workers=num_workers,
+                            python_multiprocessing=True, max_rowsize=16)
+    num_iter = 0
+    start = time.time()
+    for _ in data_set.create_tuple_iterator(num_epochs=1, output_numpy=True):
+        num_iter += 1
+    end = time.time()
+    print("workers: {}, shared memory: {}, rows: {}, cost time: {:.2f}s, rows/s: {:.1f}"
+          .format(num_workers, enable_shared_mem, num_iter, end - start, num_iter / (end - start)))
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description='throughput of map with python multiprocessing')
+    parser.add_argument('--workers', type=int, nargs='+', default=[16, 32, 64])
+    parser.add_argument('--rows', type=int, default=10000)
+    parser.add_argument('--height', type=int, default=1080)
+    parser.add_argument('--width', type=int, default=1440)
+    args = parser.parse_args()
+    shared_mem_original = ds.config.get_enable_shared_mem()
+    for workers in args.workers:
+        for shared_mem in (False, True):
+            run(workers, args.rows, args.height, args.width, shared_mem)
+    ds.config.set_enable_shared_mem(shared_mem_original)
@@ -0,0 +1,66 @@
+# Copyright 2022 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""test the compile time of a deep transformer encoder searching the strategies by the dynamic programming"""
+import argparse
+import time
+import numpy as np
+
+import mindspore.common.dtype as mstype
+import mindspore.context as context
+import mindspore.nn as nn
+from mindspore import Tensor
+from mindspore.common.api import _cell_graph_executor
+from mindspore.parallel.nn import TransformerEncoder
+
+
+class EncoderNet(nn.Cell):
+    """the encoder returning the output only"""
+
+    def __init__(self, args):
+        super(EncoderNet, self).__init__()
+        self.encoder = TransformerEncoder(batch_size=args.batch, num_layers=args.layers, hidden_size=args.hidden,
+                                          ffn_hidden_size=args.hidden * 4, seq_length=args.seq, num_heads=8)
+
+    def construct(self, x, mask):
+        output, _ = self.encoder(x, mask)
+        return output
+
+
+def compile_encoder(args, layers):
+    """compile the encoder of the layers in the auto parallel mode, return the compile time"""
+    context.reset_auto_parallel_context()
+    context.set_auto_parallel_context(parallel_mode="auto_parallel", search_mode="dynamic_programming",
+                                      device_num=args.device_num, global_rank=0)
+    args.layers = layers
+    net = EncoderNet(args)
+    x = Tensor(np.ones((args.batch, args.seq, args.hidden)), mstype.float32)
+    mask = Tensor(np.ones((args.batch, args.seq, args.seq)), mstype.float16)
+    start = time.time()
+    _cell_graph_executor.compile(net, x, mask)
+    return time.time() - start
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description='compile time of the dynamic programming strategy search')
+    parser.add_argument('--layers', type=int, nargs='+', default=[100])
+    parser.add_argument('--batch', type=int, default=8)
+    parser.add_argument('--seq', type=int, default=32)
+    parser.add_argument('--hidden', type=int, default=64)
+    parser.add_argument('--device_num', type=int, default=8)
+    arguments = parser.parse_args()
+    context.set_context(mode=context.GRAPH_MODE)
+    for num_layers in list(arguments.layers):
+        compile_time = compile_encoder(arguments, num_layers)
+        print("layers: {}, compile time: {:.3f}s".format(num_layers, compile_time), flush=True)
@@ -0,0 +1,90 @@
+# Copyright 2022 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""test the first step time of a job on cpu, without the compile cache and restarted with the compile cache"""
+import argparse
+import os
+import subprocess
+import sys
+import tempfile
+import time
+import numpy as np
+
+import mindspore.context as context
+import mindspore.nn as nn
+from mindspore import Tensor
+from mindspore.nn import TrainOneStepCell, WithLossCell
+from mindspore.nn.optim import Momentum
+
+CACHE_PATH_ENV = "MS_COMPILER_CACHE_PATH"
+
+
+class Block(nn.Cell):
+    """a residual block of small kernels"""
+
+    def __init__(self, width):
+        super(Block, self).__init__()
+        self.fc = nn.Dense(width, width)
+        self.norm = nn.LayerNorm((width,))
+        self.act = nn.GELU()
+
+    def construct(self, x):
+        return self.norm(x + self.act(self.fc(x)))
+
+
+def run_job(args):
+    """train some steps, print the time of the first step, which compiles the graph, and of the other steps"""
+    context.set_context(mode=context.GRAPH_MODE, device_target="CPU")
+    net = nn.SequentialCell([Block(args.width) for _ in range(args.depth)] + [nn.Dense(args.width, 10)])
+    optimizer = Momentum(net.trainable_params(), learning_rate=0.01, momentum=0.9)
+    criterion = nn.SoftmaxCrossEntropyWithLogits(sparse=True, reduction='mean')
+    train_network = TrainOneStepCell(WithLossCell(net, criterion), optimizer)
+    train_network.set_train()
+    data = Tensor(np.random.randn(args.batch, args.width).astype(np.float32))
+    label = Tensor(np.random.randint(0, 10, (args.batch,)).astype(np.int32))
+    start = time.time()
+    train_network(data, label).asnumpy()
+    first_step = time.time() - start
+    start = time.time()
+    for _ in range(args.steps):
+        loss = train_network(data, label)
+    loss.asnumpy()
+    step = (time.time() - start) / args.steps
+    print("first step: {:.3f}s, step time: {:.3f}ms".format(first_step, step * 1000), flush=True)
+
+
+def run_restarted_jobs(args):
+    """run the job in a new process twice, the second one takes the compile results saved by the first one"""
+    with tempfile.TemporaryDirectory() as cache_path:
+        env = dict(os.environ)
+        env[CACHE_PATH_ENV] = cache_path
+        child_args = [sys.executable, __file__, "--job", "--depth", str(args.depth), "--width", str(args.width),
+                      "--batch", str(args.batch), "--steps", str(args.steps)]
+        for name in ("cold start", "warm restart"):
+            out = subprocess.run(child_args, env=env, check=True, stdout=subprocess.PIPE, universal_newlines=True)
+            print("{}: {}".format(name, out.stdout.strip().splitlines()[-1]))
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description='first step time of cpu jobs with the compile cache')
+    parser.add_argument('--depth', type=int, default=64)
+    parser.add_argument('--width', type=int, default=64)
+    parser.add_argument('--batch', type=int, default=4)
+    parser.add_argument('--steps', type=int, default=20)
+    parser.add_argument('--job', action='store_true', help='run one job in this process')
+    arguments = parser.parse_args()
+    if arguments.job:
+        run_job(arguments)
+    else:
+        run_restarted_jobs(arguments)
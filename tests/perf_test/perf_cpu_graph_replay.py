@@ -0,0 +1,97 @@
+# Copyright 2022 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""test the step time of a graph of many small kernels, run by the kernel actors and by replaying the graph"""
+import argparse
+import os
+import time
+import numpy as np
+
+import mindspore.context as context
+import mindspore.nn as nn
+from mindspore import Tensor
+from mindspore.nn import TrainOneStepCell, WithLossCell
+from mindspore.nn.optim import Momentum
+
+REPLAY_ENV = "MS_DEV_CPU_GRAPH_REPLAY"
+REPLAY_MODES = {"0": "kernel actors", "1": "linear replay", "2": "level parallel replay"}
+
+
+class SmallBlock(nn.Cell):
+    """a residual block of tiny kernels"""
+
+    def __init__(self, width):
+        super(SmallBlock, self).__init__()
+        self.fc = nn.Dense(width, width)
+        self.norm = nn.LayerNorm((width,))
+        self.act = nn.GELU()
+
+    def construct(self, x):
+        return self.norm(x + self.act(self.fc(x)))
+
+
+class SmallKernelNet(nn.Cell):
+    """a deep and narrow network, the launch overhead dominates the step time"""
+
+    def __init__(self, depth, width, branches):
+        super(SmallKernelNet, self).__init__()
+        self.branches = nn.CellList([nn.SequentialCell([SmallBlock(width) for _ in range(depth)])
+                                     for _ in range(branches)])
+        self.head = nn.Dense(width, 10)
+
+    def construct(self, x):
+        out = self.branches[0](x)
+        for i in range(1, len(self.branches)):
+            out = out + self.branches[i](x)
+        return self.head(out)
+
+
+def run(replay_mode, args):
+    os.environ[REPLAY_ENV] = replay_mode
+    net = SmallKernelNet(args.depth, args.width, args.branches)
+    if args.train:
+        optimizer = Momentum(net.trainable_params(), learning_rate=0.01, momentum=0.9)
+        criterion = nn.SoftmaxCrossEntropyWithLogits(sparse=True, reduction='mean')
+        net = TrainOneStepCell(WithLossCell(net, criterion), optimizer)
+        net.set_train()
+    data = Tensor(np.random.randn(args.batch, args.width).astype(np.float32))
+    label = Tensor(np.random.randint(0, 10, (args.batch,)).astype(np.int32))
+    inputs = (data, label) if args.train else (data,)
+    # the first steps compile the graph and build the launch list.
+    for _ in range(args.warmup):
+        net(*inputs)
+    start = time.time()
+    for _ in range(args.steps):
+        out = net(*inputs)
+    out.asnumpy()
+    end = time.time()
+    del os.environ[REPLAY_ENV]
+    print("{}: {} steps, step time: {:.3f}ms".format(REPLAY_MODES[replay_mode], args.steps,
+                                                     (end - start) * 1000 / args.steps))
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description='step time of cpu graph replay')
+    parser.add_argument('--modes', type=str, nargs='+', default=["0", "1", "2"], choices=REPLAY_MODES.keys())
+    parser.add_argument('--depth', type=int, default=32)
+    parser.add_argument('--width', type=int, default=64)
+    parser.add_argument('--branches', type=int, default=2)
+    parser.add_argument('--batch', type=int, default=4)
+    parser.add_argument('--steps', type=int, default=200)
+    parser.add_argument('--warmup', type=int, default=5)
+    parser.add_argument('--train', action='store_true')
+    context.set_context(mode=context.GRAPH_MODE, device_target="CPU")
+    arguments = parser.parse_args()
+    for mode in arguments.modes:
+        run(mode, arguments)
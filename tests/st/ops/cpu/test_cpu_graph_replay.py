@@ -0,0 +1,105 @@
+# Copyright 2022 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+import os
+import numpy as np
+import pytest
+
+import mindspore.context as context
+import mindspore.nn as nn
+from mindspore import Tensor
+from mindspore.nn import TrainOneStepCell, WithLossCell
+from mindspore.nn.optim import Momentum
+from mindspore.ops import operations as P
+
+context.set_context(mode=context.GRAPH_MODE, device_target="CPU")
+
+REPLAY_ENV = "MS_DEV_CPU_GRAPH_REPLAY"
+
+
+class BranchNet(nn.Cell):
+    def __init__(self):
+        super(BranchNet, self).__init__()
+        self.fc1 = nn.Dense(16, 32, weight_init="ones")
+        self.fc2 = nn.Dense(16, 32, weight_init="ones")
+        self.fc3 = nn.Dense(32, 10, weight_init="ones")
+        self.relu = P.ReLU()
+        self.tanh = P.Tanh()
+
+    def construct(self, x):
+        left = self.relu(self.fc1(x))
+        right = self.tanh(self.fc2(x * 0.1))
+        return self.fc3(left * right), left + right
+
+
+def run_train(replay_mode, steps=5):
+    """train the BranchNet with the replay mode, return the losses and the parameters"""
+    os.environ[REPLAY_ENV] = replay_mode
+    try:
+        np.random.seed(1)
+        net = BranchNet()
+        optimizer = Momentum(net.trainable_params(), learning_rate=0.01, momentum=0.9)
+        criterion = nn.SoftmaxCrossEntropyWithLogits(sparse=True, reduction='mean')
+        train_network = TrainOneStepCell(WithLossCell(net, criterion), optimizer)
+        train_network.set_train()
+        losses = []
+        for _ in range(steps):
+            data = Tensor(np.random.randn(8, 16).astype(np.float32) * 0.1)
+            label = Tensor(np.random.randint(0, 10, (8,)).astype(np.int32))
+            losses.append(train_network(data, label).asnumpy())
+        params = [param.asnumpy() for param in net.trainable_params()]
+    finally:
+        del os.environ[REPLAY_ENV]
+    return losses, params
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+@pytest.mark.parametrize("replay_mode", ["1", "2"])
+def test_replay_train(replay_mode):
+    """
+    Feature: cpu graph replay.
+    Description: train a network with two branches by the kernel actors and by replaying the graph.
+    Expectation: the losses and the updated parameters are the same.
+    """
+    expect_losses, expect_params = run_train("0")
+    losses, params = run_train(replay_mode)
+    for loss, expect_loss in zip(losses, expect_losses):
+        assert np.allclose(loss, expect_loss, rtol=1e-5, atol=1e-6)
+    for param, expect_param in zip(params, expect_params):
+        assert np.allclose(param, expect_param, rtol=1e-5, atol=1e-6)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_replay_outputs_not_overwritten():
+    """
+    Feature: cpu graph replay.
+    Description: keep the outputs of a replayed graph and run it again with other inputs.
+    Expectation: the outputs of the former step are not overwritten by the next step.
+    """
+    os.environ[REPLAY_ENV] = "1"
+    try:
+        net = BranchNet()
+        first_input = np.ones((2, 16), np.float32)
+        first_outputs = net(Tensor(first_input))
+        first_values = [output.asnumpy().copy() for output in first_outputs]
+        _ = net(Tensor(first_input * 2))
+        for output, value in zip(first_outputs, first_values):
+            assert np.allclose(output.asnumpy(), value)
+    finally:
+        del os.environ[REPLAY_ENV]
@@ -0,0 +1,90 @@
+# Copyright 2022 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+import os
+import numpy as np
+import pytest
+
+import mindspore.context as context
+import mindspore.nn as nn
+from mindspore import Tensor
+from mindspore.nn import TrainOneStepCell, WithLossCell
+from mindspore.nn.optim import Momentum
+
+context.set_context(mode=context.GRAPH_MODE, device_target="CPU")
+
+MEM_LIMIT_ENV = "MS_DEV_CPU_OFFLOAD_MEM_LIMIT"
+OFFLOAD_PATH_ENV = "MS_DEV_CPU_OFFLOAD_PATH"
+# the activations and the gradients of the training are about 5MB.
+MEM_LIMIT_MB = "2"
+
+
+class DeepNet(nn.Cell):
+    def __init__(self, depth=8, width=256):
+        super(DeepNet, self).__init__()
+        self.layers = nn.SequentialCell([nn.Dense(width, width, activation="relu") for _ in range(depth)])
+        self.head = nn.Dense(width, 10)
+
+    def construct(self, x):
+        return self.head(self.layers(x))
+
+
+def run_train(envs, steps=5):
+    """train the DeepNet with the environment variables, return the losses and the parameters"""
+    os.environ.update(envs)
+    try:
+        np.random.seed(1)
+        net = DeepNet()
+        for param in net.trainable_params():
+            param.set_data(Tensor(np.random.randn(*param.shape).astype(np.float32) * 0.1))
+        optimizer = Momentum(net.trainable_params(), learning_rate=0.01, momentum=0.9)
+        criterion = nn.SoftmaxCrossEntropyWithLogits(sparse=True, reduction='mean')
+        train_network = TrainOneStepCell(WithLossCell(net, criterion), optimizer)
+        train_network.set_train()
+        losses = []
+        for _ in range(steps):
+            data = Tensor(np.random.randn(64, 256).astype(np.float32))
+            label = Tensor(np.random.randint(0, 10, (64,)).astype(np.int32))
+            losses.append(train_network(data, label).asnumpy())
+        params = [param.asnumpy() for param in net.trainable_params()]
+    finally:
+        for key in envs:
+            del os.environ[key]
+    return losses, params
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+@pytest.mark.parametrize("offload_to_file", [False, True])
+def test_train_with_low_mem_limit(offload_to_file, tmp_path):
+    """
+    Feature: cpu memory offload.
+    Description: train a network whose activations are more than the memory limit, offload them to the compressed
+        host memory or to a file.
+    Expectation: the losses and the updated parameters are the same as training without the memory limit.
+    """
+    expect_losses, expect_params = run_train({})
+    envs = {MEM_LIMIT_ENV: MEM_LIMIT_MB}
+    if offload_to_file:
+        envs[OFFLOAD_PATH_ENV] = str(tmp_path)
+    losses, params = run_train(envs)
+    for loss, expect_loss in zip(losses, expect_losses):
+        assert np.allclose(loss, expect_loss, rtol=1e-5, atol=1e-6)
+    for param, expect_param in zip(params, expect_params):
+        assert np.allclose(param, expect_param, rtol=1e-5, atol=1e-6)
+    if offload_to_file:
+        # the offload file is removed once it is opened.
+        assert not os.listdir(tmp_path)
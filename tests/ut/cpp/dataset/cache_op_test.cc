@@ -16,6 +16,7 @@
 #include <string>
 #include "minddata/dataset/core/client.h"
 #include "minddata/dataset/engine/cache/cache_client.h"
+#include "minddata/dataset/engine/cache/cache_fbb.h"
 #include "minddata/dataset/engine/execution_tree.h"
 #include "minddata/dataset/engine/datasetops/cache_op.h"
 #include "minddata/dataset/engine/datasetops/cache_lookup_op.h"
@@ -61,6 +62,53 @@ class MindDataTestCacheOp : public UT::DatasetOpTesting {
   }
 };
 
+// Serialize a row of a compressed session and restore it the way BatchFetchRequest does. No cache server is needed.
+TEST_F(MindDataTestCacheOp, TestCompressTensorRow) {
+  std::shared_ptr<Tensor> image;
+  std::shared_ptr<Tensor> label;
+  std::shared_ptr<Tensor> empty;
+  std::vector<float> pixels(4096, 0.5);
+  for (size_t i = 0; i < pixels.size(); i += 64) {
+    pixels[i] = static_cast<float>(i);
+  }
+  ASSERT_OK(Tensor::CreateFromVector(pixels, TensorShape({64, 64}), &image));
+  ASSERT_OK(Tensor::CreateScalar<int32_t>(7, &label));
+  ASSERT_OK(Tensor::CreateEmpty(TensorShape({0}), DataType(DataType::DE_INT64), &empty));
+  TensorRow row(1, {image, empty, label});
+
+  std::shared_ptr<flatbuffers::FlatBufferBuilder> fbb;
+  std::string compressed;
+  std::vector<ReadableSlice> slices;
+  int64_t sz = 0;
+  ASSERT_OK(SerializeTensorRow(row, true, &fbb, &compressed, &slices, &sz));
+  // The header followed by the data of all the columns in one piece.
+  ASSERT_EQ(slices.size(), 2);
+  auto msg = GetTensorRowHeaderMsg(fbb->GetBufferPointer());
+  int64_t uncompressed_sz = 0;
+  int64_t data_sz = GetTensorRowDataSize(msg, &uncompressed_sz);
+  EXPECT_EQ(data_sz, msg->compressed_sz());
+  EXPECT_EQ(uncompressed_sz, image->SizeInBytes() + label->SizeInBytes());
+  EXPECT_LT(data_sz, uncompressed_sz);
+  EXPECT_EQ(sz, fbb->GetSize() + data_sz);
+
+  std::string decompressed;
+  ASSERT_OK(DecompressTensorRowData(slices[1], uncompressed_sz, &decompressed));
+  ReadableSlice all_data(decompressed.data(), decompressed.size());
+  int64_t offset = 0;
+  for (auto k = 0; k < msg->column()->size(); ++k) {
+    std::shared_ptr<Tensor> ts;
+    ReadableSlice data(all_data, offset, msg->data_sz()->Get(k));
+    ASSERT_OK(RestoreOneTensor(msg->column()->Get(k), data, &ts));
+    EXPECT_EQ(*ts, *row[k]);
+    offset += data.GetSize();
+  }
+
+  // Without compression every column has its own piece.
+  ASSERT_OK(SerializeTensorRow(row, false, &fbb, &compressed, &slices, &sz));
+  EXPECT_EQ(slices.size(), row.size() + 1);
+  EXPECT_EQ(GetTensorRowHeaderMsg(fbb->GetBufferPointer())->compressed_sz(), 0);
+}
+
 TEST_F(MindDataTestCacheOp, DISABLED_TestCacheServer) {
   Status rc;
   CacheClient::Builder builder;
@@ -15,6 +15,7 @@
  */
 
 #include <fcntl.h>
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <vector>
@@ -48,12 +49,19 @@ public:
   // A random sleep/delay can be introduced for each thread. See run().
   Status Run_test_1();
 
+  // Test scenario: num_workers producers emulating the map workers with uneven processing time,
+  // and a single consumer collecting all the rows. The throughput in rows/s is returned.
+  Status Run_pipeline_benchmark(int32_t num_workers, bool ordered, double *rows_per_sec);
+
   void SetSleepMilliSec(uint32_t ms) { sleep_ms_ = ms; }
 
+  void SetOrdered(bool ordered) { ordered_ = ordered; }
+
 private:
   std::unique_ptr<TaskGroup> tg_;
   uint32_t last_input_;
   uint32_t sleep_ms_ = 0;
+  bool ordered_ = true;
   std::vector<uint32_t> input_;
   WaitPost wp;
 
@@ -82,6 +90,9 @@ private:
 
   Status ValidateOutput(const std::vector<uint32_t> &output);
 
+  // This worker loop emulates a map worker which spends some time on each row before pushing it.
+  Status MapWorkerPush(int tid, std::shared_ptr<Connector<uint32_t>> my_conn, int num_rows);
+
   uint32_t GenRand(int max);
 
   // Put the current thread to sleep mode for MaxDue milliseconds.
@@ -122,6 +133,38 @@ TEST_F(MindDataTestConnector, Test2) {
   ASSERT_TRUE(rc.IsOk());
 }
 
+/// Feature: Connector
+/// Description: test the unordered connector with multiple producers and multiple consumers with random delay
+/// Expectation: every element is received exactly once
+TEST_F(MindDataTestConnector, TestUnordered) {
+  MS_LOG(INFO) << "MindDataTestConnector TestUnordered.";
+  this->SetOrdered(false);
+  this->SetSleepMilliSec(30);
+  Status rc = this->Run_test_1();
+  ASSERT_TRUE(rc.IsOk());
+  rc = TaskManager::GetMasterThreadRc();
+  ASSERT_TRUE(rc.IsOk());
+}
+
+/// Feature: Connector
+/// Description: test the throughput of the ordered and unordered connector with 8 to 64 map workers
+/// Expectation: all the rows are collected, and the rows/s is printed for comparison
+TEST_F(MindDataTestConnector, TestPipelineBenchmark) {
+  MS_LOG(INFO) << "MindDataTestConnector TestPipelineBenchmark.";
+  constexpr int32_t kMinWorkers = 8;
+  constexpr int32_t kMaxWorkers = 64;
+  for (int32_t num_workers = kMinWorkers; num_workers <= kMaxWorkers; num_workers *= 2) {
+    double ordered_rows_per_sec = 0;
+    double unordered_rows_per_sec = 0;
+    Status rc = this->Run_pipeline_benchmark(num_workers, true, &ordered_rows_per_sec);
+    ASSERT_TRUE(rc.IsOk());
+    rc = this->Run_pipeline_benchmark(num_workers, false, &unordered_rows_per_sec);
+    ASSERT_TRUE(rc.IsOk());
+    std::cout << "Map workers: " << num_workers << ", ordered: " << ordered_rows_per_sec
+              << " rows/s, unordered: " << unordered_rows_per_sec << " rows/s" << std::endl;
+  }
+}
+
 
 
 // Implementation of MindDataTestConnector class and the helper functions.
@@ -188,11 +231,13 @@ Status MindDataTestConnector::Run_test_1() {
 
   auto conn1 = std::make_shared<Connector<uint32_t>>(l1_threads,  // num of producers
                                                      l2_threads,  // num of consumers
-                                                     conn1_qcap);  // the cap of each queue
+                                                     conn1_qcap,  // the cap of each queue
+                                                     ordered_);
 
   auto conn2 = std::make_shared<Connector<uint32_t>>(l2_threads,
                                                      l3_threads,
-                                                     conn2_qcap);
+                                                     conn2_qcap,
+                                                     ordered_);
 
   rc = conn1->Register(tg_.get());
   RETURN_IF_NOT_OK(rc);
@@ -260,9 +305,9 @@ Status MindDataTestConnector::SerialWorkerPull(
       GoToSleep(sleep_ms_);
     }
 
-    // Signal master thread after it processed the last_input_.
+    // Signal master thread after it processed all the input_.
     // This will trigger the MidWorkerJob threads to quit their worker loop.
-    if (res == last_input_) {
+    if (output->size() == input_.size()) {
       MS_LOG(INFO) << "All data is collected.";
       wp.Set();
       break;
@@ -312,7 +357,56 @@ Status MindDataTestConnector::MidWorkerJob(
   return Status::OK();
 }
 
+Status MindDataTestConnector::Run_pipeline_benchmark(int32_t num_workers, bool ordered, double *rows_per_sec) {
+  constexpr int kTotalRows = 64000;
+  constexpr int kQueueCapacity = 16;
+  TaskGroup tg;
+  auto conn = std::make_shared<Connector<uint32_t>>(num_workers, 1, kQueueCapacity, ordered);
+  RETURN_IF_NOT_OK(conn->Register(&tg));
+  int rows_per_worker = kTotalRows / num_workers;
+  auto begin = std::chrono::steady_clock::now();
+  for (int i = 0; i < num_workers; i++) {
+    RETURN_IF_NOT_OK(tg.CreateAsyncTask(
+      "Map Worker Push", std::bind(&MindDataTestConnector::MapWorkerPush, this, i, conn, rows_per_worker)));
+  }
+  int num_rows = rows_per_worker * num_workers;
+  for (int i = 0; i < num_rows; i++) {
+    uint32_t res;
+    RETURN_IF_NOT_OK(conn->Pop(0, &res));
+  }
+  auto end = std::chrono::steady_clock::now();
+  tg.join_all(Task::WaitFlag::kBlocking);
+  *rows_per_sec = num_rows / std::chrono::duration<double>(end - begin).count();
+  return Status::OK();
+}
+
+Status MindDataTestConnector::MapWorkerPush(int tid, std::shared_ptr<Connector<uint32_t>> my_conn, int num_rows) {
+  TaskManager::FindMe()->Post();
+  // Emulate the uneven cost of the map operations, one out of every sixteen rows is much slower to process,
+  // and the slow rows of different workers do not come at the same time.
+  constexpr int kSlowRowStride = 16;
+  constexpr int kBaseSpinCount = 200;
+  constexpr int kSlowFactor = 32;
+  for (int i = 0; i < num_rows; i++) {
+    int spin_count = ((i + tid) % kSlowRowStride == 0) ? kBaseSpinCount * kSlowFactor : kBaseSpinCount;
+    volatile uint32_t el = 0;
+    for (int j = 0; j < spin_count; j++) {
+      el = el + j;
+    }
+    RETURN_IF_NOT_OK(my_conn->Push(tid, static_cast<uint32_t>(i)));
+  }
+  return Status::OK();
+}
+
 Status MindDataTestConnector::ValidateOutput(const std::vector<uint32_t> &output) {
+  if (!ordered_) {
+    std::vector<uint32_t> sorted_output(output);
+    std::sort(sorted_output.begin(), sorted_output.end());
+    if (sorted_output != input_) {
+      return Status(StatusCode::kMDUnexpectedError, "Output vector does not contain all the input.");
+    }
+    return Status::OK();
+  }
   int prev = 0;
   for (auto el : output) {
     if (prev >= el) {
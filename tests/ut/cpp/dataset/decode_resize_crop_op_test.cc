@@ -0,0 +1,138 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <chrono>
+#include "common/common.h"
+#include "common/cvop_common.h"
+#include "minddata/dataset/kernels/image/center_crop_op.h"
+#include "minddata/dataset/kernels/image/decode_op.h"
+#include "minddata/dataset/kernels/image/decode_resize_crop_op.h"
+#include "minddata/dataset/kernels/image/resize_op.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+using mindspore::LogStream;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::MsLogLevel::INFO;
+constexpr double kMeanDiffThreshold = 5.0;
+
+class MindDataTestDecodeResizeCropOp : public UT::CVOP::CVOpCommon {
+ public:
+  MindDataTestDecodeResizeCropOp() : CVOpCommon() {}
+
+  // decode, resize and center crop the raw image one by one
+  std::shared_ptr<Tensor> DecodeResizeCrop(int32_t resize_size, int32_t crop_size) {
+    std::shared_ptr<Tensor> decoded;
+    std::shared_ptr<Tensor> resized;
+    std::shared_ptr<Tensor> cropped;
+    EXPECT_OK(DecodeOp(true).Compute(raw_input_tensor_, &decoded));
+    resized = decoded;
+    if (resize_size > 0) {
+      EXPECT_OK(ResizeOp(resize_size).Compute(decoded, &resized));
+    }
+    cropped = resized;
+    if (crop_size > 0) {
+      EXPECT_OK(CenterCropOp(crop_size).Compute(resized, &cropped));
+    }
+    return cropped;
+  }
+
+  double MeanDiff(const std::shared_ptr<Tensor> &lhs, const std::shared_ptr<Tensor> &rhs) {
+    cv::Mat lhs_mat = CVTensor::AsCVTensor(lhs)->mat();
+    cv::Mat rhs_mat = CVTensor::AsCVTensor(rhs)->mat();
+    cv::Mat diff;
+    cv::absdiff(lhs_mat, rhs_mat, diff);
+    cv::Scalar channel_mean = cv::mean(diff);
+    return (channel_mean[0] + channel_mean[1] + channel_mean[2]) / 3;
+  }
+};
+
+TEST_F(MindDataTestDecodeResizeCropOp, TestCenterCrop) {
+  MS_LOG(INFO) << "Doing MindDataTestDecodeResizeCropOp-TestCenterCrop.";
+  constexpr int32_t crop_size = 224;
+  auto expect = DecodeResizeCrop(0, crop_size);
+  DecodeResizeCropOp op(0, 0, InterpolationMode::kLinear, crop_size, crop_size);
+  std::shared_ptr<Tensor> output;
+  ASSERT_OK(op.Compute(raw_input_tensor_, &output));
+  ASSERT_EQ(output->shape(), expect->shape());
+  // only the ROI is decoded without scaling, the pixels are the same
+  EXPECT_EQ(MeanDiff(output, expect), 0);
+}
+
+TEST_F(MindDataTestDecodeResizeCropOp, TestResize) {
+  MS_LOG(INFO) << "Doing MindDataTestDecodeResizeCropOp-TestResize.";
+  constexpr int32_t resize_size = 256;
+  auto expect = DecodeResizeCrop(resize_size, 0);
+  DecodeResizeCropOp op(resize_size, 0, InterpolationMode::kLinear, 0, 0);
+  std::shared_ptr<Tensor> output;
+  ASSERT_OK(op.Compute(raw_input_tensor_, &output));
+  ASSERT_EQ(output->shape(), expect->shape());
+  double diff = MeanDiff(output, expect);
+  MS_LOG(INFO) << "mean diff: " << diff;
+  EXPECT_LT(diff, kMeanDiffThreshold);
+}
+
+TEST_F(MindDataTestDecodeResizeCropOp, TestResizeCenterCrop) {
+  MS_LOG(INFO) << "Doing MindDataTestDecodeResizeCropOp-TestResizeCenterCrop.";
+  constexpr int32_t resize_size = 256;
+  constexpr int32_t crop_size = 224;
+  auto expect = DecodeResizeCrop(resize_size, crop_size);
+  DecodeResizeCropOp op(resize_size, 0, InterpolationMode::kLinear, crop_size, crop_size);
+  std::shared_ptr<Tensor> output;
+  ASSERT_OK(op.Compute(raw_input_tensor_, &output));
+  ASSERT_EQ(output->shape(), expect->shape());
+  double diff = MeanDiff(output, expect);
+  MS_LOG(INFO) << "mean diff: " << diff;
+  EXPECT_LT(diff, kMeanDiffThreshold);
+}
+
+TEST_F(MindDataTestDecodeResizeCropOp, TestCenterCropPad) {
+  MS_LOG(INFO) << "Doing MindDataTestDecodeResizeCropOp-TestCenterCropPad.";
+  constexpr int32_t resize_size = 64;
+  constexpr int32_t crop_size = 96;
+  auto expect = DecodeResizeCrop(resize_size, crop_size);
+  DecodeResizeCropOp op(resize_size, 0, InterpolationMode::kLinear, crop_size, crop_size);
+  std::shared_ptr<Tensor> output;
+  ASSERT_OK(op.Compute(raw_input_tensor_, &output));
+  ASSERT_EQ(output->shape(), expect->shape());
+  EXPECT_LT(MeanDiff(output, expect), kMeanDiffThreshold);
+}
+
+// Decode throughput of Decode + Resize(256) + CenterCrop(224), the usual evaluation pipeline of ImageNet,
+// with and without the fusion. The timing is only logged, since it depends on the load of the machine.
+TEST_F(MindDataTestDecodeResizeCropOp, TestThroughput) {
+  MS_LOG(INFO) << "Doing MindDataTestDecodeResizeCropOp-TestThroughput.";
+  constexpr int32_t resize_size = 256;
+  constexpr int32_t crop_size = 224;
+  constexpr int kRepeat = 20;
+  DecodeResizeCropOp op(resize_size, 0, InterpolationMode::kLinear, crop_size, crop_size);
+  std::shared_ptr<Tensor> output;
+  std::shared_ptr<Tensor> expect;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kRepeat; i++) {
+    expect = DecodeResizeCrop(resize_size, crop_size);
+  }
+  auto mid = std::chrono::steady_clock::now();
+  for (int i = 0; i < kRepeat; i++) {
+    ASSERT_OK(op.Compute(raw_input_tensor_, &output));
+  }
+  auto end = std::chrono::steady_clock::now();
+  double unfused_ms = std::chrono::duration<double, std::milli>(mid - start).count() / kRepeat;
+  double fused_ms = std::chrono::duration<double, std::milli>(end - mid).count() / kRepeat;
+  MS_LOG(INFO) << "image shape: " << input_tensor_->shape() << ", Decode+Resize+CenterCrop: " << unfused_ms
+               << " ms/image, DecodeResizeCrop: " << fused_ms << " ms/image.";
+  ASSERT_EQ(output->shape(), expect->shape());
+  EXPECT_LT(MeanDiff(output, expect), kMeanDiffThreshold);
+}
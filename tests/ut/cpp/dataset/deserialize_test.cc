@@ -298,6 +298,28 @@ TEST_F(MindDataTestDeserialize, TestDeserializeImageFolder) {
   compare_dataset(ds);
 }
 
+// test the tensor operations which are only created by the tensor op fusion pass
+TEST_F(MindDataTestDeserialize, TestDeserializeFusedTensorOps) {
+  MS_LOG(INFO) << "Doing MindDataTestDeserialize-FusedTensorOps.";
+  std::string dataset_dir = "./data/dataset/testPK/data";
+  std::shared_ptr<SamplerObj> sampler = std::make_shared<SequentialSamplerObj>(0, 10);
+  std::set<std::string> extensions = {};
+  std::map<std::string, int32_t> class_indexing = {};
+  std::shared_ptr<DatasetNode> ds =
+    std::make_shared<ImageFolderNode>(dataset_dir, false, sampler, false, extensions, class_indexing, nullptr);
+  std::vector<int32_t> resize_size = {256};
+  std::vector<int32_t> crop_size = {224, 224};
+  std::vector<float> mean = {121.0, 115.0, 100.0};
+  std::vector<float> std = {70.0, 68.0, 71.0};
+  std::shared_ptr<TensorOperation> operation1 =
+    std::make_shared<vision::DecodeResizeCropOperation>(resize_size, InterpolationMode::kCubic, crop_size);
+  std::shared_ptr<TensorOperation> operation2 =
+    std::make_shared<vision::NormalizeHwcToChwOperation>(mean, std, true, DataType(DataType::DE_FLOAT16));
+  std::vector<std::shared_ptr<TensorOperation>> operations = {operation1, operation2};
+  ds = std::make_shared<MapNode>(ds, operations);
+  compare_dataset(ds);
+}
+
 TEST_F(MindDataTestDeserialize, TestDeserializeManifest) {
   MS_LOG(INFO) << "Doing MindDataTestDeserialize-Manifest.";
   std::string data_file = "./data/dataset/testManifestData/cpp.json";
@@ -0,0 +1,155 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <chrono>
+#include "common/common.h"
+#include "common/cvop_common.h"
+#include "minddata/dataset/kernels/data/type_cast_op.h"
+#include "minddata/dataset/kernels/image/horizontal_flip_op.h"
+#include "minddata/dataset/kernels/image/hwc_to_chw_op.h"
+#include "minddata/dataset/kernels/image/normalize_hwc_to_chw_op.h"
+#include "minddata/dataset/kernels/image/normalize_op.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+using mindspore::LogStream;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::MsLogLevel::INFO;
+
+class MindDataTestNormalizeHwcToChwOp : public UT::CVOP::CVOpCommon {
+ public:
+  MindDataTestNormalizeHwcToChwOp() : CVOpCommon() {}
+
+  // flip, normalize, convert to chw and cast the image one by one
+  std::shared_ptr<Tensor> NormalizeHwcToChw(const std::shared_ptr<Tensor> &input, bool flip_horizontal,
+                                            const DataType &output_type) {
+    std::shared_ptr<Tensor> flipped = input;
+    if (flip_horizontal) {
+      EXPECT_OK(HorizontalFlipOp().Compute(input, &flipped));
+    }
+    std::shared_ptr<Tensor> normalized;
+    EXPECT_OK(NormalizeOp(mean_, std_).Compute(flipped, &normalized));
+    std::shared_ptr<Tensor> chw;
+    EXPECT_OK(HwcToChwOp().Compute(normalized, &chw));
+    std::shared_ptr<Tensor> output = chw;
+    if (output_type != DataType::DE_FLOAT32) {
+      EXPECT_OK(TypeCastOp(output_type).Compute(chw, &output));
+    }
+    return output;
+  }
+
+  // a batch <N,H,W,C> of copies of the input image
+  std::shared_ptr<Tensor> MakeBatch(int32_t batch_size) {
+    std::shared_ptr<Tensor> batch;
+    EXPECT_OK(Tensor::CreateEmpty(input_tensor_->shape().PrependDim(batch_size), input_tensor_->type(), &batch));
+    for (int32_t i = 0; i < batch_size; i++) {
+      EXPECT_OK(batch->InsertTensor({i}, input_tensor_));
+    }
+    return batch;
+  }
+
+  std::vector<float> mean_ = {121.0, 115.0, 100.0};
+  std::vector<float> std_ = {70.0, 68.0, 71.0};
+};
+
+TEST_F(MindDataTestNormalizeHwcToChwOp, TestOp) {
+  MS_LOG(INFO) << "Doing MindDataTestNormalizeHwcToChwOp-TestOp.";
+  auto expect = NormalizeHwcToChw(input_tensor_, false, DataType(DataType::DE_FLOAT32));
+  NormalizeHwcToChwOp op(mean_, std_, false, DataType(DataType::DE_FLOAT32));
+  std::shared_ptr<Tensor> output;
+  ASSERT_OK(op.Compute(input_tensor_, &output));
+  ASSERT_EQ(output->shape(), expect->shape());
+  // the same arithmetic as Normalize, the result is identical
+  EXPECT_EQ(*output, *expect);
+}
+
+TEST_F(MindDataTestNormalizeHwcToChwOp, TestFlipFloat16) {
+  MS_LOG(INFO) << "Doing MindDataTestNormalizeHwcToChwOp-TestFlipFloat16.";
+  auto expect = NormalizeHwcToChw(input_tensor_, true, DataType(DataType::DE_FLOAT16));
+  NormalizeHwcToChwOp op(mean_, std_, true, DataType(DataType::DE_FLOAT16));
+  std::shared_ptr<Tensor> output;
+  ASSERT_OK(op.Compute(input_tensor_, &output));
+  std::vector<TensorShape> output_shapes;
+  ASSERT_OK(op.OutputShape({input_tensor_->shape()}, output_shapes));
+  ASSERT_EQ(output_shapes[0], output->shape());
+  ASSERT_EQ(output->type(), DataType(DataType::DE_FLOAT16));
+  EXPECT_EQ(*output, *expect);
+}
+
+TEST_F(MindDataTestNormalizeHwcToChwOp, TestBatch) {
+  MS_LOG(INFO) << "Doing MindDataTestNormalizeHwcToChwOp-TestBatch.";
+  constexpr int32_t batch_size = 4;
+  auto batch = MakeBatch(batch_size);
+  NormalizeHwcToChwOp op(mean_, std_, true, DataType(DataType::DE_FLOAT32));
+  std::shared_ptr<Tensor> output;
+  ASSERT_OK(op.Compute(batch, &output));
+  auto expect = NormalizeHwcToChw(input_tensor_, true, DataType(DataType::DE_FLOAT32));
+  ASSERT_EQ(output->shape(), expect->shape().PrependDim(batch_size));
+  for (int32_t i = 0; i < batch_size; i++) {
+    std::shared_ptr<Tensor> image;
+    ASSERT_OK(output->Slice(&image, {SliceOption(Slice(i, i + 1))}));
+    image->Squeeze();
+    EXPECT_EQ(*image, *expect);
+  }
+
+  // Normalize and HWC2CHW also accept the batch without the fusion
+  std::shared_ptr<Tensor> normalized;
+  ASSERT_OK(NormalizeOp(mean_, std_).Compute(batch, &normalized));
+  std::shared_ptr<Tensor> chw;
+  ASSERT_OK(HwcToChwOp().Compute(normalized, &chw));
+  NormalizeHwcToChwOp no_flip_op(mean_, std_, false, DataType(DataType::DE_FLOAT32));
+  ASSERT_OK(no_flip_op.Compute(batch, &output));
+  EXPECT_EQ(*output, *chw);
+}
+
+TEST_F(MindDataTestNormalizeHwcToChwOp, TestInvalidInput) {
+  MS_LOG(INFO) << "Doing MindDataTestNormalizeHwcToChwOp-TestInvalidInput.";
+  std::shared_ptr<Tensor> input;
+  ASSERT_OK(Tensor::CreateFromVector(std::vector<uint8_t>{1, 2, 3}, &input));
+  NormalizeHwcToChwOp op(mean_, std_, false, DataType(DataType::DE_FLOAT32));
+  std::shared_ptr<Tensor> output;
+  EXPECT_ERROR(op.Compute(input, &output));
+  NormalizeHwcToChwOp int_op(mean_, std_, false, DataType(DataType::DE_INT32));
+  EXPECT_ERROR(int_op.Compute(input_tensor_, &output));
+}
+
+// Throughput of a batch of images with and without the fusion. The timing is only logged, since it depends on the
+// load of the machine.
+TEST_F(MindDataTestNormalizeHwcToChwOp, TestThroughput) {
+  MS_LOG(INFO) << "Doing MindDataTestNormalizeHwcToChwOp-TestThroughput.";
+  constexpr int32_t batch_size = 8;
+  constexpr int kRepeat = 5;
+  auto batch = MakeBatch(batch_size);
+  NormalizeHwcToChwOp op(mean_, std_, false, DataType(DataType::DE_FLOAT32));
+  std::shared_ptr<Tensor> expect;
+  std::shared_ptr<Tensor> output;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kRepeat; i++) {
+    std::shared_ptr<Tensor> normalized;
+    ASSERT_OK(NormalizeOp(mean_, std_).Compute(batch, &normalized));
+    ASSERT_OK(HwcToChwOp().Compute(normalized, &expect));
+  }
+  auto mid = std::chrono::steady_clock::now();
+  for (int i = 0; i < kRepeat; i++) {
+    ASSERT_OK(op.Compute(batch, &output));
+  }
+  auto end = std::chrono::steady_clock::now();
+  double unfused_ms = std::chrono::duration<double, std::milli>(mid - start).count() / kRepeat;
+  double fused_ms = std::chrono::duration<double, std::milli>(end - mid).count() / kRepeat;
+  MS_LOG(INFO) << "batch shape: " << batch->shape() << ", Normalize+HWC2CHW: " << unfused_ms
+               << " ms/batch, NormalizeHwcToChw: " << fused_ms << " ms/batch.";
+  ASSERT_EQ(output->shape(), expect->shape());
+  EXPECT_EQ(*output, *expect);
+}
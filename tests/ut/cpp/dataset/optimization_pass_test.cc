@@ -29,7 +29,12 @@
 #include "minddata/dataset/include/dataset/vision_lite.h"
 #include "minddata/dataset/kernels/ir/data/transforms_ir.h"
 #include "minddata/dataset/kernels/ir/vision/decode_ir.h"
+#include "minddata/dataset/kernels/ir/vision/decode_resize_crop_ir.h"
+#include "minddata/dataset/kernels/ir/vision/hwc_to_chw_ir.h"
+#include "minddata/dataset/kernels/ir/vision/normalize_hwc_to_chw_ir.h"
+#include "minddata/dataset/kernels/ir/vision/normalize_ir.h"
 #include "minddata/dataset/kernels/ir/vision/random_crop_decode_resize_ir.h"
+#include "minddata/dataset/kernels/ir/vision/random_horizontal_flip_ir.h"
 #include "minddata/dataset/kernels/ir/vision/random_resized_crop_ir.h"
 
 using namespace mindspore::dataset;
@@ -111,3 +116,130 @@ TEST_F(MindDataTestOptimizationPass, MindDataTestTensorFusionPassPreBuiltTensorO
   ASSERT_EQ(fused_ops.size(), 1);
   ASSERT_EQ(fused_ops[0]->Name(), kRandomCropDecodeResizeOp);
 }
+
+TEST_F(MindDataTestOptimizationPass, MindDataTestTensorFusionPassDecodeResizeCrop) {
+  MS_LOG(INFO) << "Doing MindDataTestOptimizationPass-MindDataTestTensorFusionPassDecodeResizeCrop.";
+  std::string folder_path = datasets_root_path_ + "/testPK/data/";
+  auto decode_op = vision::Decode();
+  auto resize_op = vision::Resize({256});
+  auto center_crop_op = vision::CenterCrop({224});
+  auto hwc2chw_op = vision::HWC2CHW();
+  std::shared_ptr<Dataset> root =
+    ImageFolder(folder_path, false)->Map({decode_op, resize_op, center_crop_op, hwc2chw_op}, {"image"});
+
+  TensorOpFusionPass fusion_pass;
+  bool modified = false;
+  std::shared_ptr<MapNode> map_node = std::dynamic_pointer_cast<MapNode>(root->IRNode());
+  // no deepcopy is performed because this doesn't go through tree_adapter
+  fusion_pass.Run(root->IRNode(), &modified);
+  EXPECT_EQ(modified, true);
+  ASSERT_NE(map_node, nullptr);
+  auto fused_ops = map_node->operations();
+  ASSERT_EQ(fused_ops.size(), 2);
+  ASSERT_EQ(fused_ops[0]->Name(), vision::kDecodeResizeCropOperation);
+  ASSERT_EQ(fused_ops[1]->Name(), vision::kHwcToChwOperation);
+}
+
+TEST_F(MindDataTestOptimizationPass, MindDataTestTensorFusionPassDecodeCenterCrop) {
+  MS_LOG(INFO) << "Doing MindDataTestOptimizationPass-MindDataTestTensorFusionPassDecodeCenterCrop.";
+  std::string folder_path = datasets_root_path_ + "/testPK/data/";
+  auto decode_op = vision::Decode();
+  auto center_crop_op = vision::CenterCrop({224});
+  std::shared_ptr<Dataset> root = ImageFolder(folder_path, false)->Map({decode_op, center_crop_op}, {"image"});
+
+  TensorOpFusionPass fusion_pass;
+  bool modified = false;
+  std::shared_ptr<MapNode> map_node = std::dynamic_pointer_cast<MapNode>(root->IRNode());
+  fusion_pass.Run(root->IRNode(), &modified);
+  EXPECT_EQ(modified, true);
+  ASSERT_NE(map_node, nullptr);
+  auto fused_ops = map_node->operations();
+  ASSERT_EQ(fused_ops.size(), 1);
+  ASSERT_EQ(fused_ops[0]->Name(), vision::kDecodeResizeCropOperation);
+}
+
+TEST_F(MindDataTestOptimizationPass, MindDataTestTensorFusionPassDecodeNotRgb) {
+  MS_LOG(INFO) << "Doing MindDataTestOptimizationPass-MindDataTestTensorFusionPassDecodeNotRgb.";
+  std::string folder_path = datasets_root_path_ + "/testPK/data/";
+  auto decode_op = vision::Decode(false);
+  auto resize_op = vision::Resize({256});
+  std::shared_ptr<Dataset> root = ImageFolder(folder_path, false)->Map({decode_op, resize_op}, {"image"});
+
+  TensorOpFusionPass fusion_pass;
+  bool modified = false;
+  std::shared_ptr<MapNode> map_node = std::dynamic_pointer_cast<MapNode>(root->IRNode());
+  fusion_pass.Run(root->IRNode(), &modified);
+  EXPECT_EQ(modified, false);
+  ASSERT_NE(map_node, nullptr);
+  ASSERT_EQ(map_node->operations().size(), 2);
+}
+
+TEST_F(MindDataTestOptimizationPass, MindDataTestTensorFusionPassNormalizeHwcToChw) {
+  MS_LOG(INFO) << "Doing MindDataTestOptimizationPass-MindDataTestTensorFusionPassNormalizeHwcToChw.";
+  std::string folder_path = datasets_root_path_ + "/testPK/data/";
+  auto decode_op = vision::Decode();
+  auto resize_op = vision::Resize({256});
+  auto flip_op = vision::HorizontalFlip();
+  auto normalize_op = vision::Normalize({121.0, 115.0, 100.0}, {70.0, 68.0, 71.0});
+  auto hwc2chw_op = vision::HWC2CHW();
+  auto type_cast_op = transforms::TypeCast(mindspore::DataType::kNumberTypeFloat16);
+  std::shared_ptr<Dataset> root = ImageFolder(folder_path, false)
+                                    ->Map({decode_op, resize_op, flip_op, normalize_op, hwc2chw_op, type_cast_op},
+                                          {"image"});
+
+  TensorOpFusionPass fusion_pass;
+  bool modified = false;
+  std::shared_ptr<MapNode> map_node = std::dynamic_pointer_cast<MapNode>(root->IRNode());
+  fusion_pass.Run(root->IRNode(), &modified);
+  EXPECT_EQ(modified, true);
+  ASSERT_NE(map_node, nullptr);
+  auto fused_ops = map_node->operations();
+  // Decode + Resize and HorizontalFlip + Normalize + HWC2CHW + TypeCast are both fused
+  ASSERT_EQ(fused_ops.size(), 2);
+  ASSERT_EQ(fused_ops[0]->Name(), vision::kDecodeResizeCropOperation);
+  ASSERT_EQ(fused_ops[1]->Name(), vision::kNormalizeHwcToChwOperation);
+}
+
+TEST_F(MindDataTestOptimizationPass, MindDataTestTensorFusionPassTrainPipeline) {
+  MS_LOG(INFO) << "Doing MindDataTestOptimizationPass-MindDataTestTensorFusionPassTrainPipeline.";
+  std::string folder_path = datasets_root_path_ + "/testPK/data/";
+  auto decode_op = vision::Decode();
+  auto random_resized_crop_op = vision::RandomResizedCrop({224});
+  auto random_flip_op = vision::RandomHorizontalFlip();
+  auto normalize_op = vision::Normalize({121.0, 115.0, 100.0}, {70.0, 68.0, 71.0});
+  auto hwc2chw_op = vision::HWC2CHW();
+  std::shared_ptr<Dataset> root =
+    ImageFolder(folder_path, false)
+      ->Map({decode_op, random_resized_crop_op, random_flip_op, normalize_op, hwc2chw_op}, {"image"});
+
+  TensorOpFusionPass fusion_pass;
+  bool modified = false;
+  std::shared_ptr<MapNode> map_node = std::dynamic_pointer_cast<MapNode>(root->IRNode());
+  fusion_pass.Run(root->IRNode(), &modified);
+  EXPECT_EQ(modified, true);
+  ASSERT_NE(map_node, nullptr);
+  auto fused_ops = map_node->operations();
+  // Decode + RandomResizedCrop and Normalize + HWC2CHW are both fused, RandomHorizontalFlip is kept
+  ASSERT_EQ(fused_ops.size(), 3);
+  ASSERT_EQ(fused_ops[0]->Name(), vision::kRandomCropDecodeResizeOperation);
+  ASSERT_EQ(fused_ops[1]->Name(), vision::kRandomHorizontalFlipOperation);
+  ASSERT_EQ(fused_ops[2]->Name(), vision::kNormalizeHwcToChwOperation);
+}
+
+TEST_F(MindDataTestOptimizationPass, MindDataTestTensorFusionPassNormalizeNotHwcToChw) {
+  MS_LOG(INFO) << "Doing MindDataTestOptimizationPass-MindDataTestTensorFusionPassNormalizeNotHwcToChw.";
+  std::string folder_path = datasets_root_path_ + "/testPK/data/";
+  auto normalize_op = vision::Normalize({121.0, 115.0, 100.0}, {70.0, 68.0, 71.0});
+  auto type_cast_op = transforms::TypeCast(mindspore::DataType::kNumberTypeFloat16);
+  std::shared_ptr<Dataset> root = ImageFolder(folder_path, true)->Map({normalize_op, type_cast_op}, {"image"});
+
+  TensorOpFusionPass fusion_pass;
+  bool modified = false;
+  std::shared_ptr<MapNode> map_node = std::dynamic_pointer_cast<MapNode>(root->IRNode());
+  fusion_pass.Run(root->IRNode(), &modified);
+  EXPECT_EQ(modified, false);
+  ASSERT_NE(map_node, nullptr);
+  auto ops = map_node->operations();
+  ASSERT_EQ(ops.size(), 2);
+  ASSERT_EQ(ops[0]->Name(), vision::kNormalizeOperation);
+}
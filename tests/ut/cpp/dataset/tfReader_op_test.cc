@@ -261,6 +261,107 @@ TEST_F(MindDataTestTFReaderOp, TestTFReaderOneThread) {
   ASSERT_EQ(row_count, 12);
 }
 
+// One file read by several workers, the file is split into row ranges at record boundaries.
+TEST_F(MindDataTestTFReaderOp, TestTFReaderSplitFile) {
+  // Start with an empty execution tree
+  auto my_tree = std::make_shared<ExecutionTree>();
+  Status rc;
+  std::string dataset_path;
+  dataset_path = datasets_root_path_ + "/testTFTestAllTypes/test.data";
+
+  std::shared_ptr<ConfigManager> config_manager = GlobalContext::config_manager();
+  int32_t op_connector_size = config_manager->op_connector_size();
+  int32_t num_workers = 5;
+  int32_t worker_connector_size = config_manager->worker_connector_size();
+  std::vector<std::string> files = {dataset_path};
+  std::vector<std::string> columns_to_load = {};
+
+  std::unique_ptr<DataSchema> schema = std::make_unique<DataSchema>();
+  schema->LoadSchemaFile(datasets_root_path_ + "/testTFTestAllTypes/datasetSchema.json", {});
+  std::shared_ptr<TFReaderOp> my_tfreader_op =
+    std::make_shared<TFReaderOp>(num_workers, worker_connector_size, 0, files, std::move(schema), op_connector_size,
+                                 columns_to_load, false, 1, 0, false);
+  my_tfreader_op->SetSplitFiles(true);
+  rc = my_tfreader_op->Init();
+  ASSERT_TRUE(rc.IsOk());
+  rc = my_tree->AssociateNode(my_tfreader_op);
+  ASSERT_TRUE(rc.IsOk());
+
+  rc = my_tree->AssignRoot(my_tfreader_op);
+  ASSERT_TRUE(rc.IsOk());
+
+  MS_LOG(INFO) << "Launching tree and begin iteration.";
+  rc = my_tree->Prepare();
+  ASSERT_TRUE(rc.IsOk());
+
+  rc = my_tree->Launch();
+  ASSERT_TRUE(rc.IsOk());
+
+  // Start the loop of reading tensors from our pipeline
+  DatasetIterator di(my_tree);
+  TensorRow tensor_list;
+  rc = di.FetchNextTensorRow(&tensor_list);
+  ASSERT_TRUE(rc.IsOk());
+
+  int row_count = 0;
+  while (!tensor_list.empty()) {
+    // every row is loaded once and completely
+    ASSERT_EQ(tensor_list.size(), 8);
+    rc = di.FetchNextTensorRow(&tensor_list);
+    ASSERT_TRUE(rc.IsOk());
+    row_count++;
+  }
+
+  ASSERT_EQ(row_count, 12);
+}
+
+/// Feature: TFReaderOp
+/// Description: read one file by 8 workers without splitting the file, and by 1 worker
+/// Expectation: the rows are read in the same order as the rows read by 1 worker
+TEST_F(MindDataTestTFReaderOp, TestTFReaderOneFileRowOrder) {
+  std::string dataset_path = datasets_root_path_ + "/testTFTestAllTypes";
+  std::shared_ptr<ConfigManager> config_manager = GlobalContext::config_manager();
+  int32_t op_connector_size = config_manager->op_connector_size();
+  int32_t worker_connector_size = config_manager->worker_connector_size();
+  std::vector<std::string> files = {dataset_path + "/test.data"};
+
+  std::vector<std::vector<TensorRow>> rows_by_workers;
+  for (int32_t num_workers : {1, 8}) {
+    auto my_tree = std::make_shared<ExecutionTree>();
+    std::unique_ptr<DataSchema> schema = std::make_unique<DataSchema>();
+    schema->LoadSchemaFile(dataset_path + "/datasetSchema.json", {});
+    std::shared_ptr<TFReaderOp> my_tfreader_op =
+      std::make_shared<TFReaderOp>(num_workers, worker_connector_size, 0, files, std::move(schema), op_connector_size,
+                                   std::vector<std::string>(), false, 1, 0, false);
+    ASSERT_OK(my_tfreader_op->Init());
+    ASSERT_OK(my_tree->AssociateNode(my_tfreader_op));
+    ASSERT_OK(my_tree->AssignRoot(my_tfreader_op));
+    ASSERT_OK(my_tree->Prepare());
+    ASSERT_OK(my_tree->Launch());
+
+    DatasetIterator di(my_tree);
+    std::vector<TensorRow> rows;
+    TensorRow tensor_list;
+    ASSERT_OK(di.FetchNextTensorRow(&tensor_list));
+    while (!tensor_list.empty()) {
+      rows.push_back(tensor_list);
+      ASSERT_OK(di.FetchNextTensorRow(&tensor_list));
+    }
+    rows_by_workers.push_back(std::move(rows));
+  }
+
+  const auto &expected = rows_by_workers[0];
+  const auto &rows = rows_by_workers[1];
+  ASSERT_EQ(expected.size(), 12);
+  ASSERT_EQ(rows.size(), expected.size());
+  for (size_t i = 0; i < rows.size(); i++) {
+    ASSERT_EQ(rows[i].size(), expected[i].size());
+    for (size_t j = 0; j < rows[i].size(); j++) {
+      ASSERT_TRUE(*rows[i][j] == *expected[i][j]) << "row " << i << ", column " << j;
+    }
+  }
+}
+
 TEST_F(MindDataTestTFReaderOp, TestTFReaderTake1Buffer) {
   // Start with an empty execution tree
   auto my_tree = std::make_shared<ExecutionTree>();
@@ -0,0 +1,212 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <unistd.h>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "frontend/operator/ops.h"
+#include "backend/common/session/kernel_graph.h"
+#include "backend/common/session/anf_runtime_algorithm.h"
+#include "include/common/utils/anfalgo.h"
+#include "plugin/device/cpu/hal/device/cpu_compile_cache.h"
+#include "plugin/device/cpu/hal/device/kernel_select_cpu.h"
+
+namespace mindspore::device::cpu {
+using KernelBuildInfoBuilder = kernel::KernelBuildInfo::KernelBuildInfoBuilder;
+
+class TestCPUCompileCache : public UT::Common {
+ public:
+  TestCPUCompileCache() = default;
+
+ protected:
+  // mul(add(x, y), z) of the shape.
+  static KernelGraphPtr BuildGraph(const std::vector<int64_t> &shape) {
+    auto kernel_graph = std::make_shared<session::KernelGraph>();
+    auto abstract = std::make_shared<abstract::AbstractTensor>(kFloat32, shape);
+    std::vector<AnfNodePtr> parameters;
+    for (size_t i = 0; i < 3; ++i) {
+      auto parameter = kernel_graph->NewParameter();
+      MS_EXCEPTION_IF_NULL(parameter);
+      parameter->set_abstract(abstract);
+      parameters.push_back(parameter);
+    }
+    auto add = kernel_graph->NewCNode({NewValueNode(prim::kPrimAdd), parameters[0], parameters[1]});
+    MS_EXCEPTION_IF_NULL(add);
+    add->set_abstract(abstract);
+    auto mul = kernel_graph->NewCNode({NewValueNode(prim::kPrimMul), add, parameters[2]});
+    MS_EXCEPTION_IF_NULL(mul);
+    mul->set_abstract(abstract);
+    kernel_graph->set_output(kernel_graph->NewCNode({NewValueNode(prim::kPrimMakeTuple), mul}));
+    kernel_graph->SetExecOrderByDefault();
+    return kernel_graph;
+  }
+
+  static kernel::KernelBuildInfoPtr BuildInfo(size_t input_num, TypeId type) {
+    auto builder = std::make_shared<KernelBuildInfoBuilder>();
+    builder->SetInputsFormat(std::vector<std::string>(input_num, kOpFormat_DEFAULT));
+    builder->SetInputsDeviceType(std::vector<TypeId>(input_num, type));
+    builder->SetOutputsFormat({kOpFormat_DEFAULT});
+    builder->SetOutputsDeviceType({type});
+    return builder->Build();
+  }
+
+  void SetUp() override {
+    char dir_template[] = "/tmp/cpu_compile_cache_test_XXXXXX";
+    auto dir = mkdtemp(dir_template);
+    ASSERT_NE(dir, nullptr);
+    cache_dir_ = dir;
+  }
+
+  void TearDown() override {
+    (void)std::remove((cache_dir_ + "/cpu_backend_compile_cache.json").c_str());
+    (void)rmdir(cache_dir_.c_str());
+  }
+
+  std::string cache_dir_;
+};
+
+/// Feature: cpu compile cache.
+/// Description: get the keys of the graphs of the same kernels and the graph of another shape.
+/// Expectation: the keys of the same kernels are the same, the key of another shape is different.
+TEST_F(TestCPUCompileCache, TestGraphKey) {
+  auto key = CPUCompileCache::GraphKey(*BuildGraph({2, 32}));
+  EXPECT_FALSE(key.empty());
+  EXPECT_EQ(CPUCompileCache::GraphKey(*BuildGraph({2, 32})), key);
+  EXPECT_NE(CPUCompileCache::GraphKey(*BuildGraph({2, 64})), key);
+}
+
+/// Feature: cpu compile cache.
+/// Description: cache the kernel build info of a graph, then find it for the graph of the same kernels.
+/// Expectation: the cached kernel build info are the same as the selected ones, the ones not cacheable are null.
+TEST_F(TestCPUCompileCache, TestKernelBuildInfoCache) {
+  auto &compile_cache = CPUCompileCache::GetInstance();
+  auto graph = BuildGraph({4, 8});
+  auto graph_key = CPUCompileCache::GraphKey(*graph);
+  const auto &kernels = graph->execution_order();
+  ASSERT_EQ(kernels.size(), 2);
+  for (const auto &kernel : kernels) {
+    AnfAlgo::SetSelectKernelBuildInfo(BuildInfo(2, kNumberTypeFloat32), kernel.get());
+  }
+  compile_cache.InsertKernelBuildInfos(graph_key, kernels, {true, false});
+
+  auto same_graph = BuildGraph({4, 8});
+  std::vector<kernel::KernelBuildInfoPtr> build_infos;
+  auto hit_count = compile_cache.hit_count();
+  ASSERT_TRUE(compile_cache.FindKernelBuildInfos(graph_key, same_graph->execution_order(), &build_infos));
+  EXPECT_EQ(compile_cache.hit_count(), hit_count + 1);
+  ASSERT_EQ(build_infos.size(), 2);
+  ASSERT_NE(build_infos[0], nullptr);
+  EXPECT_TRUE(*build_infos[0] == *AnfAlgo::GetSelectKernelBuildInfo(kernels[0]));
+  EXPECT_EQ(build_infos[1], nullptr);
+
+  auto miss_count = compile_cache.miss_count();
+  EXPECT_FALSE(compile_cache.FindKernelBuildInfos(CPUCompileCache::GraphKey(*BuildGraph({4, 16})),
+                                                  same_graph->execution_order(), &build_infos));
+  EXPECT_EQ(compile_cache.miss_count(), miss_count + 1);
+}
+
+/// Feature: cpu compile cache.
+/// Description: cache the memory plan of a graph, then find it for the same buffers and for other buffers.
+/// Expectation: the same buffers get the cached offsets and size, the other buffers are not found.
+TEST_F(TestCPUCompileCache, TestMemPlanCache) {
+  auto &compile_cache = CPUCompileCache::GetInstance();
+  auto graph = BuildGraph({8, 8});
+  auto graph_key = CPUCompileCache::GraphKey(*graph);
+  compile_cache.InsertKernelBuildInfos(graph_key, graph->execution_order(), {false, false});
+  std::vector<MemPlanBuffer> buffers = {{256, 0, 1, 0}, {256, 1, 2, 256}, {512, 2, 2, 512}};
+  constexpr size_t kMemSize = 1024;
+  compile_cache.InsertMemPlan(graph_key, buffers, kMemSize);
+
+  std::vector<MemPlanBuffer> same_buffers = {{256, 0, 1, 0}, {256, 1, 2, 0}, {512, 2, 2, 0}};
+  size_t mem_size = 0;
+  ASSERT_TRUE(compile_cache.FindMemPlan(graph_key, &same_buffers, &mem_size));
+  EXPECT_EQ(mem_size, kMemSize);
+  for (size_t i = 0; i < buffers.size(); ++i) {
+    EXPECT_EQ(same_buffers[i].offset, buffers[i].offset);
+  }
+  std::vector<MemPlanBuffer> other_buffers = {{256, 0, 2, 0}, {256, 1, 2, 0}, {512, 2, 2, 0}};
+  EXPECT_FALSE(compile_cache.FindMemPlan(graph_key, &other_buffers, &mem_size));
+}
+
+/// Feature: cpu compile cache.
+/// Description: cache the kernel build info and the memory plan of a graph in the cache directory, then load the cache
+/// file in another instance.
+/// Expectation: the cache file is saved on inserting, and the loaded instance finds the same build info and plan.
+TEST_F(TestCPUCompileCache, TestSaveAndLoad) {
+  auto graph = BuildGraph({4, 32});
+  auto graph_key = CPUCompileCache::GraphKey(*graph);
+  const auto &kernels = graph->execution_order();
+  ASSERT_EQ(kernels.size(), 2);
+  for (const auto &kernel : kernels) {
+    AnfAlgo::SetSelectKernelBuildInfo(BuildInfo(2, kNumberTypeFloat32), kernel.get());
+  }
+  std::vector<MemPlanBuffer> buffers = {{128, 0, 1, 0}, {128, 1, 2, 128}};
+  constexpr size_t kMemSize = 256;
+  {
+    CPUCompileCache compile_cache(cache_dir_);
+    ASSERT_TRUE(compile_cache.enabled());
+    compile_cache.InsertKernelBuildInfos(graph_key, kernels, {true, true});
+    compile_cache.InsertMemPlan(graph_key, buffers, kMemSize);
+  }
+
+  CPUCompileCache loaded_cache(cache_dir_);
+  auto same_graph = BuildGraph({4, 32});
+  std::vector<kernel::KernelBuildInfoPtr> build_infos;
+  ASSERT_TRUE(loaded_cache.FindKernelBuildInfos(graph_key, same_graph->execution_order(), &build_infos));
+  EXPECT_EQ(loaded_cache.hit_count(), 1);
+  ASSERT_EQ(build_infos.size(), 2);
+  for (size_t i = 0; i < build_infos.size(); ++i) {
+    ASSERT_NE(build_infos[i], nullptr);
+    EXPECT_TRUE(*build_infos[i] == *AnfAlgo::GetSelectKernelBuildInfo(kernels[i]));
+  }
+  std::vector<MemPlanBuffer> same_buffers = {{128, 0, 1, 0}, {128, 1, 2, 0}};
+  size_t mem_size = 0;
+  ASSERT_TRUE(loaded_cache.FindMemPlan(graph_key, &same_buffers, &mem_size));
+  EXPECT_EQ(mem_size, kMemSize);
+  EXPECT_EQ(same_buffers[1].offset, buffers[1].offset);
+}
+
+/// Feature: cpu compile cache.
+/// Description: set the cached kernel build info of Unique which is one of its kernel attrs, and the one which is not.
+/// Expectation: the supported build info is set, the other one is refused so that the kernel is selected again.
+TEST_F(TestCPUCompileCache, TestCachedKernelInfoMismatch) {
+  auto kernel_graph = std::make_shared<session::KernelGraph>();
+  auto parameter = kernel_graph->NewParameter();
+  MS_EXCEPTION_IF_NULL(parameter);
+  parameter->set_abstract(std::make_shared<abstract::AbstractTensor>(kFloat32, std::vector<int64_t>{8}));
+  auto unique = kernel_graph->NewCNode({NewValueNode(std::make_shared<Primitive>("Unique")), parameter});
+  MS_EXCEPTION_IF_NULL(unique);
+  auto build_info = [](TypeId input_type, TypeId output_type) {
+    auto builder = std::make_shared<KernelBuildInfoBuilder>();
+    builder->SetInputsFormat({kOpFormat_DEFAULT});
+    builder->SetInputsDeviceType({input_type});
+    builder->SetOutputsFormat({kOpFormat_DEFAULT, kOpFormat_DEFAULT});
+    builder->SetOutputsDeviceType({output_type, kNumberTypeInt32});
+    return builder->Build();
+  };
+
+  auto unsupported_info = build_info(kNumberTypeFloat64, kNumberTypeFloat64);
+  EXPECT_FALSE(SetCachedKernelInfo(unique, unsupported_info));
+  EXPECT_EQ(AnfAlgo::GetSelectKernelBuildInfo(unique), nullptr);
+  auto supported_info = build_info(kNumberTypeFloat32, kNumberTypeFloat32);
+  EXPECT_TRUE(SetCachedKernelInfo(unique, supported_info));
+  EXPECT_EQ(AnfAlgo::GetSelectKernelBuildInfo(unique), supported_info);
+}
+}  // namespace mindspore::device::cpu
@@ -0,0 +1,69 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include "common/common_test.h"
+#include "plugin/device/cpu/hal/device/cpu_simple_mem_plan.h"
+#include "plugin/device/cpu/hal/hardware/cpu_graph_replayer.h"
+
+namespace mindspore::device::cpu {
+class TestCPUGraphReplayer : public UT::Common {
+ public:
+  TestCPUGraphReplayer() = default;
+};
+
+/// Feature: cpu graph replay.
+/// Description: compute the levels of two independent branches joined by a kernel.
+/// Expectation: the kernels of the two branches at the same depth share the level, the join is after both.
+TEST_F(TestCPUGraphReplayer, TestLevelsOfBranches) {
+  // 0 -> 1 -> 2, 3 -> 4, (2, 4) -> 5
+  std::vector<std::vector<size_t>> inputs = {{}, {0}, {1}, {}, {3}, {2, 4}};
+  std::vector<bool> has_side_effect(inputs.size(), false);
+  auto levels = CPUGraphReplayer::ComputeLevels(inputs, has_side_effect);
+  std::vector<size_t> expect = {0, 1, 2, 0, 1, 3};
+  EXPECT_EQ(levels, expect);
+}
+
+/// Feature: cpu graph replay.
+/// Description: compute the levels of independent kernels with a kernel of side effects in the middle.
+/// Expectation: the kernel of side effects is alone in its level, between the kernels before and after it.
+TEST_F(TestCPUGraphReplayer, TestLevelsWithSideEffect) {
+  std::vector<std::vector<size_t>> inputs = {{}, {}, {}, {}, {}};
+  std::vector<bool> has_side_effect = {false, false, true, false, false};
+  auto levels = CPUGraphReplayer::ComputeLevels(inputs, has_side_effect);
+  std::vector<size_t> expect = {0, 0, 1, 2, 2};
+  EXPECT_EQ(levels, expect);
+
+  // the first kernel has side effects, the kernel after it reads its output.
+  inputs = {{}, {0}, {}};
+  has_side_effect = {true, false, false};
+  levels = CPUGraphReplayer::ComputeLevels(inputs, has_side_effect);
+  expect = {0, 1, 1};
+  EXPECT_EQ(levels, expect);
+}
+
+/// Feature: cpu graph replay.
+/// Description: plan the buffers of two kernels in the same level, and the same kernels in two levels.
+/// Expectation: the buffers of the same level don't share memory, the ones of different levels do.
+TEST_F(TestCPUGraphReplayer, TestPlanByLevels) {
+  constexpr size_t kBufferSize = 1024;
+  // the workspaces of the kernel 0 and 1.
+  std::vector<MemPlanBuffer> same_level = {{kBufferSize, 0, 0, 0}, {kBufferSize, 0, 0, 0}};
+  EXPECT_EQ(CPUSimpleMemPlan::AssignOffsets(&same_level), 2 * kBufferSize);
+  std::vector<MemPlanBuffer> two_levels = {{kBufferSize, 0, 0, 0}, {kBufferSize, 1, 1, 0}};
+  EXPECT_EQ(CPUSimpleMemPlan::AssignOffsets(&two_levels), kBufferSize);
+}
+}  // namespace mindspore::device::cpu
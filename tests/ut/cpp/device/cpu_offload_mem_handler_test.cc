@@ -0,0 +1,218 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <unistd.h>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "runtime/device/memory_scheduler.h"
+#include "plugin/device/cpu/hal/device/cpu_offload_mem_handler.h"
+
+namespace mindspore::device::cpu {
+namespace {
+constexpr size_t kHiddenSize = 1024;
+constexpr size_t kLayerNum = 16;
+constexpr size_t kActivationSize = kHiddenSize * sizeof(float);
+constexpr float kLearningRate = 0.01;
+}  // namespace
+
+class TestCPUOffloadMemHandler : public UT::Common {
+ public:
+  TestCPUOffloadMemHandler() = default;
+
+ protected:
+  void SetUp() override {
+    char dir_template[] = "/tmp/cpu_offload_test_XXXXXX";
+    auto dir = mkdtemp(dir_template);
+    ASSERT_NE(dir, nullptr);
+    offload_dir_ = dir;
+  }
+
+  // The offload file is unlinked once it is opened, so only the directory is left.
+  void TearDown() override { (void)rmdir(offload_dir_.c_str()); }
+
+  // A network of kLayerNum layers y = relu(x * w) trained by the gradients of sum(y) of the last layer. The
+  // activations of the forward steps are read by the backward steps in the reverse order, they are the memory got from
+  // the memory scheduler, and the weights are in the host memory.
+  void Train(const std::shared_ptr<MemScheduler> &scheduler, void *stream, size_t iterations,
+             std::vector<float> *weights) {
+    ASSERT_NE(weights, nullptr);
+    const size_t total_step = 2 * kLayerNum + 1;
+    // the keys of the activations and the gradient.
+    const void *grad_key = keys_.data() + kLayerNum + 1;
+    for (size_t iteration = 0; iteration < iterations; ++iteration) {
+      if (scheduler != nullptr) {
+        scheduler->Reset();
+        scheduler->Update();
+      }
+      std::vector<float *> activations(kLayerNum + 1, nullptr);
+      float *grad = nullptr;
+      auto get = [&scheduler](const void *key, std::vector<std::vector<float>> *fallback, size_t index) -> float * {
+        if (scheduler == nullptr) {
+          return (*fallback)[index].data();
+        }
+        return reinterpret_cast<float *>(scheduler->GetOrMalloc(key, kActivationSize));
+      };
+      std::vector<std::vector<float>> fallback(kLayerNum + 2, std::vector<float>(kHiddenSize));
+      // step 0 writes the input, the step i writes the activation i by the activation i - 1.
+      for (size_t step = 0; step < total_step; ++step) {
+        if (scheduler != nullptr) {
+          ASSERT_TRUE(scheduler->PreCompute(stream));
+        }
+        if (step <= kLayerNum) {
+          activations[step] = get(keys_.data() + step, &fallback, step);
+          if (step > 0) {
+            activations[step - 1] = get(keys_.data() + step - 1, &fallback, step - 1);
+          }
+        } else {
+          // the backward step of the layer i reads the activation i and i - 1 and updates the gradient.
+          size_t layer = total_step - step;
+          activations[layer] = get(keys_.data() + layer, &fallback, layer);
+          activations[layer - 1] = get(keys_.data() + layer - 1, &fallback, layer - 1);
+          grad = get(grad_key, &fallback, kLayerNum + 1);
+        }
+        if (stream != nullptr || scheduler == nullptr) {
+          Compute(step, activations, grad, weights, iteration);
+        }
+        if (scheduler != nullptr) {
+          ASSERT_TRUE(scheduler->PostCompute(stream));
+        }
+      }
+    }
+  }
+
+  void Compute(size_t step, const std::vector<float *> &activations, float *grad, std::vector<float> *weights,
+               size_t iteration) {
+    if (step == 0) {
+      for (size_t j = 0; j < kHiddenSize; ++j) {
+        // the input has the runs of zeros, so the activations are sparse.
+        activations[0][j] = (j % 3 == 0) ? 0.0f : static_cast<float>((j + iteration) % 7) - 3.0f;
+      }
+      return;
+    }
+    if (step <= kLayerNum) {
+      float w = (*weights)[step - 1];
+      for (size_t j = 0; j < kHiddenSize; ++j) {
+        activations[step][j] = std::max(activations[step - 1][j] * w, 0.0f);
+      }
+      return;
+    }
+    size_t layer = 2 * kLayerNum + 1 - step;
+    if (layer == kLayerNum) {
+      std::fill(grad, grad + kHiddenSize, 1.0f);
+    }
+    float w = (*weights)[layer - 1];
+    float weight_grad = 0;
+    for (size_t j = 0; j < kHiddenSize; ++j) {
+      float relu_grad = activations[layer][j] > 0 ? grad[j] : 0.0f;
+      weight_grad += relu_grad * activations[layer - 1][j];
+      grad[j] = relu_grad * w;
+    }
+    (*weights)[layer - 1] = w - kLearningRate * weight_grad / kHiddenSize;
+  }
+
+  void TrainWithMemLimit(size_t mem_limit, const std::string &offload_path) {
+    constexpr size_t kIterations = 3;
+    std::vector<float> expect_weights(kLayerNum, 1.01);
+    Train(nullptr, nullptr, kIterations, &expect_weights);
+
+    auto handler = std::make_shared<CPUOffloadMemHandler>(mem_limit, offload_path);
+    auto scheduler = std::make_shared<MemScheduler>();
+    scheduler->SetMemHandler(handler);
+    scheduler->SetTotalStep(2 * kLayerNum + 1);
+    std::vector<float> weights(kLayerNum, 1.01);
+    Train(scheduler, nullptr, 1, &weights);
+    scheduler->set_need_record_event(false);
+    ASSERT_TRUE(scheduler->Optimize());
+    Train(scheduler, handler.get(), kIterations, &weights);
+    EXPECT_LE(handler->mem_used(), mem_limit);
+    for (size_t i = 0; i < kLayerNum; ++i) {
+      EXPECT_FLOAT_EQ(weights[i], expect_weights[i]);
+    }
+    scheduler->ClearAllocatedMem();
+  }
+
+  std::vector<uint8_t> keys_ = std::vector<uint8_t>(kLayerNum + 2);
+  std::string offload_dir_;
+};
+
+/// Feature: cpu memory offload.
+/// Description: compress the sparse data, the dense data and the data of zeros, then decompress them.
+/// Expectation: the decompressed data are the same as the origin ones, the sparse data are compressed.
+TEST_F(TestCPUOffloadMemHandler, TestCompressZeros) {
+  constexpr size_t kSize = 4096;
+  std::vector<uint8_t> sparse(kSize, 0);
+  for (size_t i = 0; i < kSize; i += 100) {
+    sparse[i] = static_cast<uint8_t>(i % 255 + 1);
+  }
+  std::vector<uint8_t> dense(kSize);
+  for (size_t i = 0; i < kSize; ++i) {
+    dense[i] = static_cast<uint8_t>(i % 255 + 1);
+  }
+  std::vector<uint8_t> zeros(kSize, 0);
+  for (const auto &data : {sparse, dense, zeros}) {
+    auto compressed = CPUOffloadMemHandler::CompressZeros(data.data(), data.size());
+    std::vector<uint8_t> decompressed(data.size(), 1);
+    CPUOffloadMemHandler::DecompressZeros(compressed, decompressed.data(), decompressed.size());
+    EXPECT_EQ(decompressed, data);
+  }
+  EXPECT_LT(CPUOffloadMemHandler::CompressZeros(sparse.data(), kSize).size(), kSize / 2);
+}
+
+/// Feature: cpu memory offload.
+/// Description: swap the memory out to the host memory and to a file, prefetch it and swap it in.
+/// Expectation: the data swapped in are the same as the ones swapped out, the memory limit is kept.
+TEST_F(TestCPUOffloadMemHandler, TestSwapOutAndIn) {
+  constexpr size_t kMemLimit = 4 * kActivationSize;
+  for (const std::string &offload_path : {std::string(), offload_dir_}) {
+    CPUOffloadMemHandler handler(kMemLimit, offload_path);
+    EXPECT_EQ(handler.file_backed(), !offload_path.empty());
+    auto device_ptr = reinterpret_cast<float *>(handler.MallocDevice(kActivationSize));
+    ASSERT_NE(device_ptr, nullptr);
+    for (size_t i = 0; i < kHiddenSize; ++i) {
+      device_ptr[i] = (i % 2 == 0) ? 0.0f : static_cast<float>(i);
+    }
+    std::vector<float> expect(device_ptr, device_ptr + kHiddenSize);
+    auto host_ptr = handler.MallocHost(kActivationSize);
+    handler.SwapOut(device_ptr, host_ptr, kActivationSize, &handler);
+    handler.FreeDevice(device_ptr);
+    EXPECT_EQ(handler.MallocDevice(handler.GetAvailableMemSize() + 1), nullptr);
+
+    handler.Prefetch(host_ptr, kActivationSize);
+    auto swap_in_ptr = reinterpret_cast<float *>(handler.MallocDevice(kActivationSize));
+    ASSERT_NE(swap_in_ptr, nullptr);
+    handler.SwapIn(host_ptr, swap_in_ptr, kActivationSize, &handler);
+    handler.FreeHost(host_ptr);
+    EXPECT_EQ(std::vector<float>(swap_in_ptr, swap_in_ptr + kHiddenSize), expect);
+    EXPECT_LE(handler.mem_used(), kMemLimit);
+    handler.FreeDevice(swap_in_ptr);
+    EXPECT_EQ(handler.mem_used(), 0);
+  }
+}
+
+/// Feature: cpu memory offload.
+/// Description: train a network whose activations are more than the memory limit, offload them to the host memory
+/// and to a file.
+/// Expectation: the training runs within the memory limit and the weights are the same as training without it.
+TEST_F(TestCPUOffloadMemHandler, TestTrainWithLowMemoryLimit) {
+  // the activations of all the layers are 4 times the memory limit.
+  constexpr size_t kMemLimit = kLayerNum * kActivationSize / 4;
+  TrainWithMemLimit(kMemLimit, "");
+  TrainWithMemLimit(kMemLimit, offload_dir_);
+}
+}  // namespace mindspore::device::cpu
@@ -0,0 +1,190 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <vector>
+#include "common/common_test.h"
+#include "plugin/device/cpu/hal/device/cpu_simple_mem_plan.h"
+
+namespace mindspore::device::cpu {
+namespace {
+constexpr size_t kFloatSize = 4;
+
+// Build the buffers of a graph in the execution order, each kernel reads some outputs of the former kernels and
+// writes one output, it may have a workspace.
+class BufferTraceBuilder {
+ public:
+  size_t AddKernel(const std::vector<size_t> &inputs, size_t output_size, size_t workspace_size = 0) {
+    size_t step = step_num_++;
+    for (auto input : inputs) {
+      buffers_[input].last_use = step;
+    }
+    if (workspace_size > 0) {
+      buffers_.push_back({workspace_size, step, step, 0});
+    }
+    buffers_.push_back({output_size, step, step, 0});
+    return buffers_.size() - 1;
+  }
+
+  // the graph output is live to the end
+  void SetOutput(size_t output) { buffers_[output].last_use = step_num_; }
+
+  std::vector<MemPlanBuffer> &buffers() { return buffers_; }
+
+ private:
+  size_t step_num_{0};
+  std::vector<MemPlanBuffer> buffers_;
+};
+
+// ResNet50 with batch 32, the convolutions, batch norms and relus are fused, and the output of each bottleneck is
+// kept for the shortcut.
+std::vector<MemPlanBuffer> ResNet50Buffers() {
+  constexpr size_t batch = 32;
+  BufferTraceBuilder builder;
+  size_t x = builder.AddKernel({}, batch * 224 * 224 * 3 * kFloatSize);
+  x = builder.AddKernel({x}, batch * 112 * 112 * 64 * kFloatSize, batch * 112 * 112 * 147 * kFloatSize);
+  x = builder.AddKernel({x}, batch * 56 * 56 * 64 * kFloatSize);
+  const std::vector<size_t> block_nums = {3, 4, 6, 3};
+  size_t width = 64;
+  size_t spatial = 56;
+  for (size_t stage = 0; stage < block_nums.size(); ++stage) {
+    for (size_t block = 0; block < block_nums[stage]; ++block) {
+      size_t out_channel = width * 4;
+      size_t area = batch * spatial * spatial;
+      size_t shortcut = x;
+      if (block == 0) {
+        shortcut = builder.AddKernel({x}, area * out_channel * kFloatSize);
+      }
+      size_t y = builder.AddKernel({x}, area * width * kFloatSize);
+      y = builder.AddKernel({y}, area * width * kFloatSize, area * width * 9 * kFloatSize);
+      y = builder.AddKernel({y}, area * out_channel * kFloatSize);
+      x = builder.AddKernel({y, shortcut}, area * out_channel * kFloatSize);
+    }
+    width *= 2;
+    spatial /= 2;
+  }
+  x = builder.AddKernel({x}, batch * 2048 * kFloatSize);
+  x = builder.AddKernel({x}, batch * 1000 * kFloatSize);
+  builder.SetOutput(x);
+  return builder.buffers();
+}
+
+// BERT base with batch 8 and sequence length 128.
+std::vector<MemPlanBuffer> BertBaseBuffers() {
+  constexpr size_t batch = 8;
+  constexpr size_t seq = 128;
+  constexpr size_t hidden = 768;
+  constexpr size_t heads = 12;
+  constexpr size_t layers = 12;
+  constexpr size_t hidden_size = batch * seq * hidden * kFloatSize;
+  BufferTraceBuilder builder;
+  size_t x = builder.AddKernel({}, hidden_size);
+  for (size_t layer = 0; layer < layers; ++layer) {
+    size_t q = builder.AddKernel({x}, hidden_size);
+    size_t k = builder.AddKernel({x}, hidden_size);
+    size_t v = builder.AddKernel({x}, hidden_size);
+    size_t scores = builder.AddKernel({q, k}, batch * heads * seq * seq * kFloatSize);
+    size_t probs = builder.AddKernel({scores}, batch * heads * seq * seq * kFloatSize);
+    size_t context = builder.AddKernel({probs, v}, hidden_size);
+    size_t attention = builder.AddKernel({context}, hidden_size);
+    size_t residual = builder.AddKernel({attention, x}, hidden_size);
+    size_t norm = builder.AddKernel({residual}, hidden_size, batch * seq * 2 * kFloatSize);
+    size_t ffn = builder.AddKernel({norm}, hidden_size * 4);
+    ffn = builder.AddKernel({ffn}, hidden_size * 4);
+    ffn = builder.AddKernel({ffn}, hidden_size);
+    residual = builder.AddKernel({ffn, norm}, hidden_size);
+    x = builder.AddKernel({residual}, hidden_size, batch * seq * 2 * kFloatSize);
+  }
+  builder.SetOutput(x);
+  return builder.buffers();
+}
+
+// the largest total size of the buffers live at the same step, no plan can be smaller than it.
+size_t PeakLiveSize(const std::vector<MemPlanBuffer> &buffers) {
+  size_t step_num = 0;
+  for (const auto &buffer : buffers) {
+    step_num = std::max(step_num, buffer.last_use + 1);
+  }
+  std::vector<size_t> live_size(step_num, 0);
+  for (const auto &buffer : buffers) {
+    for (size_t step = buffer.first_use; step <= buffer.last_use; ++step) {
+      live_size[step] += buffer.size;
+    }
+  }
+  return *std::max_element(live_size.begin(), live_size.end());
+}
+
+size_t TotalSize(const std::vector<MemPlanBuffer> &buffers) {
+  size_t total = 0;
+  for (const auto &buffer : buffers) {
+    total += buffer.size;
+  }
+  return total;
+}
+
+void CheckNoOverlap(const std::vector<MemPlanBuffer> &buffers, size_t planned_size) {
+  for (size_t i = 0; i < buffers.size(); ++i) {
+    const auto &lhs = buffers[i];
+    EXPECT_LE(lhs.offset + lhs.size, planned_size);
+    for (size_t j = i + 1; j < buffers.size(); ++j) {
+      const auto &rhs = buffers[j];
+      bool live_together = lhs.first_use <= rhs.last_use && rhs.first_use <= lhs.last_use;
+      bool overlap = lhs.offset < rhs.offset + rhs.size && rhs.offset < lhs.offset + lhs.size;
+      EXPECT_FALSE(live_together && overlap) << "buffer " << i << " and " << j << " overlap.";
+    }
+  }
+}
+}  // namespace
+
+class TestCPUSimpleMemPlan : public UT::Common {
+ public:
+  TestCPUSimpleMemPlan() = default;
+};
+
+/// Feature: cpu simple mem plan.
+/// Description: plan a chain of kernels, each reads the output of the former one.
+/// Expectation: the outputs are placed in two buffers by turns.
+TEST_F(TestCPUSimpleMemPlan, TestChain) {
+  constexpr size_t kSize = 1024;
+  BufferTraceBuilder builder;
+  size_t x = builder.AddKernel({}, kSize);
+  for (size_t i = 0; i < 10; ++i) {
+    x = builder.AddKernel({x}, kSize);
+  }
+  builder.SetOutput(x);
+  auto &buffers = builder.buffers();
+  size_t planned_size = CPUSimpleMemPlan::AssignOffsets(&buffers);
+  EXPECT_EQ(planned_size, 2 * kSize);
+  CheckNoOverlap(buffers, planned_size);
+}
+
+/// Feature: cpu simple mem plan.
+/// Description: plan the buffers of ResNet50 and BERT base.
+/// Expectation: the buffers live at the same time don't overlap, and the planned size is close to the peak live size.
+TEST_F(TestCPUSimpleMemPlan, TestNetworks) {
+  for (auto buffers : {ResNet50Buffers(), BertBaseBuffers()}) {
+    size_t naive_size = TotalSize(buffers);
+    size_t peak_size = PeakLiveSize(buffers);
+    size_t planned_size = CPUSimpleMemPlan::AssignOffsets(&buffers);
+    MS_LOG(INFO) << "buffer num: " << buffers.size() << ", size without reuse: " << naive_size
+                 << ", peak live size: " << peak_size << ", planned size: " << planned_size;
+    CheckNoOverlap(buffers, planned_size);
+    EXPECT_GE(planned_size, peak_size);
+    EXPECT_LT(planned_size, naive_size / 4);
+    EXPECT_LT(planned_size, peak_size + peak_size / 4);
+  }
+}
+}  // namespace mindspore::device::cpu
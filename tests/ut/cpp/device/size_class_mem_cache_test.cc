@@ -0,0 +1,348 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "common/mem_reuse/mem_dynamic_allocator.h"
+
+namespace mindspore::device {
+namespace {
+constexpr size_t kPoolUnitSize = 256 << 20;
+
+class TestMemPool : public DynamicMemPoolBestFit {
+ public:
+  TestMemPool() { SetMemAllocUintSize(kPoolUnitSize, kPoolUnitSize); }
+  ~TestMemPool() override { ReleaseDeviceRes(); }
+
+  size_t AllocDeviceMem(size_t size, DeviceMemPtr *addr) override {
+    *addr = malloc(size);
+    return *addr == nullptr ? 0 : size;
+  }
+  bool FreeDeviceMem(const DeviceMemPtr &addr) override {
+    free(addr);
+    return true;
+  }
+  size_t free_mem_size() override { return SIZE_MAX; }
+};
+
+// One record of the alloc/free trace, the free record refers to the index of the alloc record.
+struct TraceRecord {
+  bool is_alloc;
+  size_t size;
+  size_t alloc_index;
+};
+
+// Load the trace with lines of "alloc <size>" or "free <alloc index>" from the file set by MS_DEV_MEM_TRACE_FILE, or
+// generate a trace which is similar to the small kernels running on CPU backend.
+std::vector<TraceRecord> LoadTrace(size_t record_num, uint32_t seed) {
+  std::vector<TraceRecord> trace;
+  auto trace_file = std::getenv("MS_DEV_MEM_TRACE_FILE");
+  if (trace_file != nullptr) {
+    std::ifstream ifs(trace_file);
+    std::string type;
+    size_t value = 0;
+    while (ifs >> type >> value) {
+      if (type == "alloc") {
+        trace.push_back({true, value, 0});
+      } else if (type == "free") {
+        trace.push_back({false, 0, value});
+      }
+    }
+    return trace;
+  }
+  std::mt19937 gen(seed);
+  // Most of the tensors of small kernels are less than 64KB, and a few are large.
+  std::discrete_distribution<size_t> size_kind({70, 25, 5});
+  std::uniform_int_distribution<size_t> small_size(1, 4096);
+  std::uniform_int_distribution<size_t> medium_size(4097, 64 << 10);
+  std::uniform_int_distribution<size_t> large_size((64 << 10) + 1, 4 << 20);
+  std::vector<size_t> live;
+  constexpr size_t kMaxLiveNum = 64;
+  for (size_t i = 0; i < record_num; ++i) {
+    if (live.size() < kMaxLiveNum && (live.empty() || gen() % 2 == 0)) {
+      auto kind = size_kind(gen);
+      auto size = kind == 0 ? small_size(gen) : (kind == 1 ? medium_size(gen) : large_size(gen));
+      live.emplace_back(trace.size());
+      trace.push_back({true, size, 0});
+    } else {
+      auto pos = gen() % live.size();
+      trace.push_back({false, 0, live[pos]});
+      live[pos] = live.back();
+      live.pop_back();
+    }
+  }
+  for (auto index : live) {
+    trace.push_back({false, 0, index});
+  }
+  return trace;
+}
+
+bool ReplayTrace(DynamicMemPoolBestFit *pool, const std::vector<TraceRecord> &trace) {
+  std::vector<DeviceMemPtr> addrs(trace.size(), nullptr);
+  for (size_t i = 0; i < trace.size(); ++i) {
+    const auto &record = trace[i];
+    if (record.is_alloc) {
+      addrs[i] = pool->AllocTensorMem(record.size);
+      if (addrs[i] == nullptr) {
+        return false;
+      }
+      // Touch the memory as the kernel does.
+      static_cast<uint8_t *>(addrs[i])[0] = 1;
+      static_cast<uint8_t *>(addrs[i])[record.size - 1] = 1;
+    } else if (record.alloc_index < addrs.size() && addrs[record.alloc_index] != nullptr) {
+      pool->FreeTensorMem(addrs[record.alloc_index]);
+      addrs[record.alloc_index] = nullptr;
+    }
+  }
+  return true;
+}
+
+// Replay the trace on thread_num threads, return the cost in milliseconds.
+double RunTraceBenchmark(bool enable_cache, size_t thread_num, const std::vector<std::vector<TraceRecord>> &traces) {
+  TestMemPool pool;
+  if (enable_cache) {
+    pool.EnableSizeClassMemCache(SIZE_MAX);
+  }
+  std::vector<std::thread> threads;
+  std::atomic_bool success = {true};
+  auto begin = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < thread_num; ++i) {
+    threads.emplace_back([&pool, &traces, &success, i]() {
+      if (!ReplayTrace(&pool, traces[i % traces.size()])) {
+        success = false;
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  auto end = std::chrono::steady_clock::now();
+  if (!success) {
+    return -1;
+  }
+  return std::chrono::duration<double, std::milli>(end - begin).count();
+}
+}  // namespace
+
+class TestSizeClassMemCache : public UT::Common {
+ public:
+  TestSizeClassMemCache() = default;
+};
+
+/// Feature: SizeClassMemCache
+/// Description: alloc and free the small and large memory with size class cache enabled
+/// Expectation: the small memory is served by the cache and can be reused, the large memory is served by best fit pool
+TEST_F(TestSizeClassMemCache, test_alloc_free) {
+  TestMemPool pool;
+  pool.EnableSizeClassMemCache(SIZE_MAX);
+  auto cache = pool.size_class_mem_cache();
+  ASSERT_NE(cache, nullptr);
+
+  auto small_addr = pool.AllocTensorMem(1000);
+  ASSERT_NE(small_addr, nullptr);
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(small_addr) % kSizeClassAlignSize, 0);
+  ASSERT_EQ(cache->TotalUsedMemStatistics(), 1024);
+  auto large_addr = pool.AllocTensorMem(kMaxSizeClassMemSize + 1);
+  ASSERT_NE(large_addr, nullptr);
+  ASSERT_EQ(cache->TotalUsedMemStatistics(), 1024);
+
+  pool.FreeTensorMem(small_addr);
+  pool.FreeTensorMem(large_addr);
+  ASSERT_EQ(cache->TotalUsedMemStatistics(), 0);
+  // The freed memory is reused from the thread cache.
+  auto reused_addr = pool.AllocTensorMem(600);
+  ASSERT_EQ(reused_addr, small_addr);
+  const auto &stat = cache->SizeClassStatistics(1);
+  ASSERT_EQ(stat.alloc_count_, 2);
+  ASSERT_EQ(stat.free_count_, 1);
+  ASSERT_EQ(stat.thread_cache_hit_count_, 1);
+  ASSERT_EQ(stat.span_count_, 1);
+  pool.FreeTensorMem(reused_addr);
+
+  // The continuous memory is always allocated from the best fit pool.
+  auto addr_list = pool.AllocContinuousTensorMem(1024, {512, 512});
+  ASSERT_EQ(addr_list.size(), 2);
+  pool.FreeTensorMem(addr_list[0]);
+  pool.FreeTensorMem(addr_list[1]);
+}
+
+/// Feature: SizeClassMemCache
+/// Description: alloc memory until the max cache size is reached
+/// Expectation: the memory beyond the max cache size is served by the best fit pool
+TEST_F(TestSizeClassMemCache, test_max_cache_size) {
+  TestMemPool pool;
+  pool.EnableSizeClassMemCache(0);
+  auto addr = pool.AllocTensorMem(512);
+  ASSERT_NE(addr, nullptr);
+  ASSERT_EQ(pool.size_class_mem_cache()->TotalMemStatistics(), 0);
+  pool.FreeTensorMem(addr);
+}
+
+/// Feature: SizeClassMemCache
+/// Description: a thread frees the memory into its thread cache and exits, then another thread allocates the memory
+/// Expectation: the memory cached by the exited thread is returned, the idle span is given back and reused
+TEST_F(TestSizeClassMemCache, test_thread_exit_flush) {
+  TestMemPool pool;
+  pool.EnableSizeClassMemCache(SIZE_MAX);
+  auto cache = pool.size_class_mem_cache();
+  ASSERT_NE(cache, nullptr);
+  constexpr size_t kSize = 4096;
+  const auto &stat = cache->SizeClassStatistics(kSize / kSizeClassAlignSize - 1);
+  const size_t addr_num = kSizeClassSpanSize / kSize;
+  std::vector<DeviceMemPtr> addrs(addr_num, nullptr);
+  std::thread worker([&pool, &addrs]() {
+    for (auto &addr : addrs) {
+      addr = pool.AllocTensorMem(kSize);
+    }
+    for (auto &addr : addrs) {
+      pool.FreeTensorMem(addr);
+    }
+  });
+  worker.join();
+  ASSERT_EQ(stat.span_count_, 0);
+  auto total_mem_size = cache->TotalMemStatistics();
+  // All the memory of the span is handed out again without allocating a new arena.
+  for (auto &addr : addrs) {
+    addr = pool.AllocTensorMem(kSize);
+    ASSERT_NE(addr, nullptr);
+  }
+  ASSERT_EQ(stat.span_count_, 1);
+  ASSERT_EQ(cache->TotalMemStatistics(), total_mem_size);
+  for (auto &addr : addrs) {
+    pool.FreeTensorMem(addr);
+  }
+}
+
+/// Feature: SizeClassMemCache
+/// Description: a thread frees much of the large size class memory, then another thread allocates the memory
+/// Expectation: the thread cache keeps a few of the large memory, the others are reused by the other thread
+TEST_F(TestSizeClassMemCache, test_thread_cache_size) {
+  TestMemPool pool;
+  pool.EnableSizeClassMemCache(SIZE_MAX);
+  auto cache = pool.size_class_mem_cache();
+  ASSERT_NE(cache, nullptr);
+  constexpr size_t kAddrNum = kThreadCacheMaxCount;
+  const auto &stat = cache->SizeClassStatistics(kSizeClassNum - 1);
+  std::vector<DeviceMemPtr> addrs(kAddrNum, nullptr);
+  for (auto &addr : addrs) {
+    addr = pool.AllocTensorMem(kMaxSizeClassMemSize);
+    ASSERT_NE(addr, nullptr);
+  }
+  auto span_count = stat.span_count_.load();
+  for (auto &addr : addrs) {
+    pool.FreeTensorMem(addr);
+  }
+  std::thread worker([&pool]() {
+    std::vector<DeviceMemPtr> worker_addrs(kAddrNum - kThreadCacheMaxClassSize / kMaxSizeClassMemSize, nullptr);
+    for (auto &addr : worker_addrs) {
+      addr = pool.AllocTensorMem(kMaxSizeClassMemSize);
+      ASSERT_NE(addr, nullptr);
+    }
+    for (auto &addr : worker_addrs) {
+      pool.FreeTensorMem(addr);
+    }
+  });
+  worker.join();
+  ASSERT_LE(stat.span_count_, span_count);
+}
+
+/// Feature: SizeClassMemCache
+/// Description: alloc the memory of more than one arena on a thread, free it and exit the thread, then alloc the
+/// memory of another size class
+/// Expectation: the idle arenas are freed to the best fit pool except the last one, whose spans are reused
+TEST_F(TestSizeClassMemCache, test_release_idle_span) {
+  TestMemPool pool;
+  pool.EnableSizeClassMemCache(SIZE_MAX);
+  auto cache = pool.size_class_mem_cache();
+  ASSERT_NE(cache, nullptr);
+  const size_t arena_size = (kSizeClassSpanNumPerArena + 1) * kSizeClassSpanSize;
+  const size_t addr_num = (kSizeClassSpanNumPerArena + 1) * (kSizeClassSpanSize / kMaxSizeClassMemSize);
+  std::thread worker([&pool, addr_num]() {
+    std::vector<DeviceMemPtr> addrs(addr_num, nullptr);
+    for (auto &addr : addrs) {
+      addr = pool.AllocTensorMem(kMaxSizeClassMemSize);
+      ASSERT_NE(addr, nullptr);
+    }
+    for (auto &addr : addrs) {
+      pool.FreeTensorMem(addr);
+    }
+  });
+  worker.join();
+  ASSERT_EQ(cache->SizeClassStatistics(kSizeClassNum - 1).span_count_, 0);
+  ASSERT_EQ(cache->TotalMemStatistics(), arena_size);
+  auto addr = pool.AllocTensorMem(kSizeClassAlignSize);
+  ASSERT_NE(addr, nullptr);
+  ASSERT_EQ(cache->SizeClassStatistics(0).span_count_, 1);
+  ASSERT_EQ(cache->TotalMemStatistics(), arena_size);
+  pool.FreeTensorMem(addr);
+}
+
+/// Feature: SizeClassMemCache
+/// Description: alloc and free memory on more threads than the threads which had a thread cache before
+/// Expectation: every thread is served by its own thread cache
+TEST_F(TestSizeClassMemCache, test_many_threads) {
+  TestMemPool pool;
+  pool.EnableSizeClassMemCache(SIZE_MAX);
+  auto cache = pool.size_class_mem_cache();
+  ASSERT_NE(cache, nullptr);
+  constexpr size_t kThreadNum = 256;
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < kThreadNum; ++i) {
+    threads.emplace_back([&pool]() {
+      // The second allocation takes the memory freed by the first one from the thread cache.
+      for (size_t j = 0; j < 2; ++j) {
+        auto addr = pool.AllocTensorMem(kSizeClassAlignSize);
+        ASSERT_NE(addr, nullptr);
+        pool.FreeTensorMem(addr);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  const auto &stat = cache->SizeClassStatistics(0);
+  ASSERT_EQ(stat.alloc_count_, 2 * kThreadNum);
+  ASSERT_EQ(stat.thread_cache_hit_count_, kThreadNum);
+  ASSERT_EQ(cache->TotalUsedMemStatistics(), 0);
+}
+
+/// Feature: SizeClassMemCache
+/// Description: replay the alloc/free trace on several threads with and without size class cache
+/// Expectation: the trace is replayed successfully, and the cost is printed for comparison
+TEST_F(TestSizeClassMemCache, test_trace_replay_benchmark) {
+  constexpr size_t kRecordNum = 200000;
+  constexpr size_t kTraceNum = 8;
+  std::vector<std::vector<TraceRecord>> traces;
+  for (size_t i = 0; i < kTraceNum; ++i) {
+    traces.emplace_back(LoadTrace(kRecordNum, static_cast<uint32_t>(i)));
+  }
+  for (size_t thread_num = 1; thread_num <= kTraceNum; thread_num *= 2) {
+    auto best_fit_cost = RunTraceBenchmark(false, thread_num, traces);
+    auto size_class_cost = RunTraceBenchmark(true, thread_num, traces);
+    ASSERT_GE(best_fit_cost, 0);
+    ASSERT_GE(size_class_cost, 0);
+    std::cout << "Trace replay threads: " << thread_num << ", best fit: " << best_fit_cost
+              << " ms, size class cache: " << size_class_cost << " ms" << std::endl;
+  }
+}
+}  // namespace mindspore::device
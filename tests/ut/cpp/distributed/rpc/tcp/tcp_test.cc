@@ -15,17 +15,26 @@
  */
 
 #include <sys/resource.h>
+#include <sys/socket.h>
 #include <sys/types.h>
+#include <sys/uio.h>
+#include <fcntl.h>
+#include <poll.h>
 #include <dirent.h>
 #include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iostream>
 #include <string>
 #include <thread>
+#include <vector>
 #include <csignal>
 
 #include <gtest/gtest.h>
 #define private public
 #include "distributed/rpc/tcp/tcp_server.h"
 #include "distributed/rpc/tcp/tcp_client.h"
+#include "distributed/rpc/tcp/tcp_socket_operation.h"
 #include "common/common_test.h"
 
 namespace mindspore {
@@ -230,6 +239,159 @@ TEST_F(TCPTest, StartServerWithRandomPort) {
   EXPECT_LT(0, port);
   server->Finalize();
 }
+
+/// Feature: test sending and receiving a message of several buffers by short writes and reads.
+/// Description: send three buffers with sendmsg on a non-blocking socket whose send buffer is much smaller than the
+/// message, and receive them into three buffers of other sizes while the data arrives in pieces.
+/// Expectation: the bytes received are the same as the bytes sent, in order.
+TEST_F(TCPTest, SendAndReceiveMessageByShortWrites) {
+  int fds[2] = {-1, -1};
+  ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+  int buf_size = 4096;
+  ASSERT_EQ(0, setsockopt(fds[0], SOL_SOCKET, SO_SNDBUF, &buf_size, sizeof(buf_size)));
+  ASSERT_EQ(0, setsockopt(fds[1], SOL_SOCKET, SO_RCVBUF, &buf_size, sizeof(buf_size)));
+  for (int fd : fds) {
+    ASSERT_EQ(0, fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK));
+  }
+
+  std::vector<size_t> send_sizes = {100, 300000, 777};
+  std::vector<std::string> send_bufs;
+  std::string expected;
+  for (size_t i = 0; i < send_sizes.size(); ++i) {
+    std::string buf(send_sizes[i], '\0');
+    for (size_t j = 0; j < buf.size(); ++j) {
+      buf[j] = static_cast<char>((i * 131 + j) % 251);
+    }
+    expected += buf;
+    send_bufs.push_back(std::move(buf));
+  }
+
+  TCPSocketOperation socket_operation;
+  std::thread sender([&socket_operation, &send_bufs, &fds]() {
+    Connection connection;
+    connection.socket_fd = fds[0];
+    std::vector<struct iovec> iovs(send_bufs.size());
+    for (size_t i = 0; i < send_bufs.size(); ++i) {
+      iovs[i].iov_base = &send_bufs[i][0];
+      iovs[i].iov_len = send_bufs[i].size();
+    }
+    struct msghdr send_msg = {};
+    send_msg.msg_iov = iovs.data();
+    send_msg.msg_iovlen = iovs.size();
+    uint32_t send_len = 0;
+    for (const auto &buf : send_bufs) {
+      send_len += buf.size();
+    }
+    while (send_len > 0) {
+      ASSERT_GE(socket_operation.SendMessage(&connection, &send_msg, &send_len), 0);
+      struct pollfd pfd = {fds[0], POLLOUT, 0};
+      (void)poll(&pfd, 1, 100);
+    }
+  });
+
+  Connection connection;
+  connection.socket_fd = fds[1];
+  std::vector<std::string> recv_bufs = {std::string(5000, '\0'), std::string(200, '\0'),
+                                        std::string(expected.size() - 5200, '\0')};
+  std::vector<struct iovec> iovs(recv_bufs.size());
+  for (size_t i = 0; i < recv_bufs.size(); ++i) {
+    iovs[i].iov_base = &recv_bufs[i][0];
+    iovs[i].iov_len = recv_bufs[i].size();
+  }
+  struct msghdr recv_msg = {};
+  recv_msg.msg_iov = iovs.data();
+  recv_msg.msg_iovlen = iovs.size();
+  uint32_t recv_len = expected.size();
+  while (recv_len > 0) {
+    struct pollfd pfd = {fds[1], POLLIN, 0};
+    (void)poll(&pfd, 1, 100);
+    auto retval = socket_operation.ReceiveMessage(&connection, &recv_msg, recv_len);
+    ASSERT_GE(retval, 0);
+    recv_len -= retval;
+  }
+  sender.join();
+  EXPECT_EQ(expected, recv_bufs[0] + recv_bufs[1] + recv_bufs[2]);
+  (void)close(fds[0]);
+  (void)close(fds[1]);
+}
+
+/// Feature: test sending messages to many peers with multiple event loops.
+/// Description: start many socket servers on the loopback address and send messages from one client to all of them,
+/// with one event loop and four event loops.
+/// Expectation: all the messages are received, and the throughput and latency are printed for comparison.
+TEST_F(TCPTest, SendToManyPeersBenchmark) {
+  const size_t peer_num = 16;
+  const size_t msg_num_per_peer = 2000;
+  const size_t body_size = 128;
+  for (size_t event_loop_num : {1, 4}) {
+    std::atomic<size_t> recv_num(0);
+    std::atomic<int64_t> total_latency_us(0);
+    auto handler = [&recv_num, &total_latency_us](const std::shared_ptr<MessageBase> &message) -> void {
+      int64_t send_time = 0;
+      (void)memcpy(&send_time, message->body.data(), sizeof(send_time));
+      auto now = std::chrono::duration_cast<std::chrono::microseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+                   .count();
+      total_latency_us += now - send_time;
+      ++recv_num;
+    };
+
+    // Start the tcp servers.
+    std::vector<std::unique_ptr<TCPServer>> servers;
+    std::vector<std::string> server_urls;
+    for (size_t i = 0; i < peer_num; ++i) {
+      auto server = std::make_unique<TCPServer>(event_loop_num);
+      ASSERT_TRUE(server->Initialize("127.0.0.1:0"));
+      server->SetMessageHandler(handler);
+      server_urls.push_back(server->GetIP() + ":" + std::to_string(server->GetPort()));
+      servers.push_back(std::move(server));
+    }
+
+    // Start the tcp client and connect to all the servers.
+    auto client_url = "127.0.0.1:1234";
+    auto client = std::make_unique<TCPClient>(event_loop_num);
+    ASSERT_TRUE(client->Initialize());
+    for (const auto &server_url : server_urls) {
+      ASSERT_TRUE(client->Connect(server_url));
+    }
+
+    // Send the messages to the servers in turn.
+    auto begin = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < msg_num_per_peer; ++i) {
+      for (const auto &server_url : server_urls) {
+        auto message = std::make_unique<MessageBase>();
+        message->name = "testname";
+        message->from = AID("client", client_url);
+        message->to = AID("server", server_url);
+        message->body.resize(body_size);
+        int64_t send_time = std::chrono::duration_cast<std::chrono::microseconds>(
+                              std::chrono::steady_clock::now().time_since_epoch())
+                              .count();
+        (void)memcpy(message->body.data(), &send_time, sizeof(send_time));
+        client->Send(std::move(message));
+      }
+    }
+    const size_t total_msg_num = peer_num * msg_num_per_peer;
+    const int timeout_in_ms = 60000;
+    for (int i = 0; i < timeout_in_ms && recv_num < total_msg_num; ++i) {
+      usleep(1000);
+    }
+    auto elapsed_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    EXPECT_EQ(total_msg_num, recv_num.load());
+    std::cout << "Event loop number: " << event_loop_num << ", peers: " << peer_num << ", messages: " << recv_num
+              << ", throughput: " << recv_num / elapsed_s
+              << " msgs/s, average latency: " << total_latency_us / std::max<size_t>(recv_num, 1) << " us" << std::endl;
+
+    // Destroy
+    for (const auto &server_url : server_urls) {
+      client->Disconnect(server_url);
+    }
+    client->Finalize();
+    for (auto &server : servers) {
+      server->Finalize();
+    }
+  }
+}
 }  // namespace rpc
 }  // namespace distributed
 }  // namespace mindspore
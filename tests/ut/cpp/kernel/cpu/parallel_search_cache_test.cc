@@ -0,0 +1,63 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include "common/common_test.h"
+#include "plugin/device/cpu/kernel/cpu_kernel.h"
+#include "plugin/device/cpu/kernel/parallel_search_cache.h"
+
+namespace mindspore {
+namespace kernel {
+class ParallelSearchCacheTest : public UT::Common {
+ public:
+  ParallelSearchCacheTest() = default;
+};
+
+/// Feature: cpu parallel search cache.
+/// Description: search the block size of a kernel, then launch another kernel of the same key.
+/// Expectation: the second kernel gets the searched block size from the cache without searching.
+TEST_F(ParallelSearchCacheTest, TestReuseSearchResult) {
+  constexpr size_t kCount = 1024;
+  std::vector<float> data(kCount, 0);
+  auto task = [&data](size_t start, size_t end) {
+    for (size_t i = start; i < end; ++i) {
+      data[i] += 1;
+    }
+  };
+  auto &search_cache = ParallelSearchCache::GetInstance();
+  ParallelSearchInfo first;
+  first.kernel_key = "ParallelSearchCacheTest_Float32:[1024]->_Float32:[1024]";
+  size_t launch_num = 0;
+  while (first.search_count < 30) {
+    ParallelLaunchAutoSearch(task, kCount, nullptr, &first);
+    ++launch_num;
+  }
+  EXPECT_GT(first.best_block_size, 0);
+
+  auto hit_count = search_cache.hit_count();
+  ParallelSearchInfo second;
+  second.kernel_key = first.kernel_key;
+  ParallelLaunchAutoSearch(task, kCount, nullptr, &second);
+  ++launch_num;
+  EXPECT_EQ(search_cache.hit_count(), hit_count + 1);
+  EXPECT_EQ(second.best_block_size, first.best_block_size);
+  EXPECT_EQ(second.search_count, first.search_count);
+  for (auto value : data) {
+    EXPECT_EQ(value, launch_num);
+  }
+}
+}  // namespace kernel
+}  // namespace mindspore
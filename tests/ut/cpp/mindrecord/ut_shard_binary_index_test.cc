@@ -0,0 +1,250 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "common/common_test.h"
+#include "minddata/mindrecord/include/shard_binary_index.h"
+#include "./sqlite3.h"
+
+namespace mindspore {
+namespace mindrecord {
+namespace {
+using IndexRows = std::vector<std::vector<std::tuple<std::string, std::string, std::string>>>;
+
+constexpr uint64_t kRowsPerPage = 64;
+constexpr uint64_t kBlobSize = 1000;
+
+// Generate the rows as ShardIndexGenerator binds them to the sqlite index, the label has num_labels classes.
+IndexRows GenerateRows(uint64_t num_rows, uint64_t num_labels) {
+  IndexRows rows;
+  for (uint64_t i = 0; i < num_rows; ++i) {
+    auto page = std::to_string(i / kRowsPerPage);
+    auto offset = i % kRowsPerPage;
+    rows.push_back({{":ROW_ID", "INTEGER", std::to_string(i)},
+                    {":ROW_GROUP_ID", "INTEGER", page},
+                    {":PAGE_ID_RAW", "INTEGER", "0"},
+                    {":PAGE_OFFSET_RAW", "INTEGER", std::to_string(offset * 16)},
+                    {":PAGE_OFFSET_RAW_END", "INTEGER", std::to_string(offset * 16 + 16)},
+                    {":PAGE_ID_BLOB", "INTEGER", page},
+                    {":PAGE_OFFSET_BLOB", "INTEGER", std::to_string(offset * kBlobSize)},
+                    {":PAGE_OFFSET_BLOB_END", "INTEGER", std::to_string(offset * kBlobSize + kBlobSize)},
+                    {":INC_0", "INTEGER", "0"},
+                    {":label_0", "INTEGER", std::to_string(i % num_labels)},
+                    {":INC_1", "INTEGER", "0"},
+                    {":file_name_0", "TEXT", "image_" + std::to_string(i) + ".jpg"}});
+  }
+  return rows;
+}
+
+void WriteBinaryIndex(const std::string &path, const IndexRows &rows) {
+  ShardBinaryIndexWriter writer({{"label_0", "INTEGER"}, {"file_name_0", "TEXT"}});
+  ASSERT_TRUE(writer.AddRows(rows).IsOk());
+  ASSERT_TRUE(writer.Write(path, "test.mindrecord", 1024).IsOk());
+}
+
+void WriteSqliteIndex(const std::string &path, const IndexRows &rows) {
+  (void)std::remove(path.c_str());
+  sqlite3 *db = nullptr;
+  ASSERT_EQ(sqlite3_open_v2(path.c_str(), &db, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, nullptr), SQLITE_OK);
+  std::string sql =
+    "CREATE TABLE INDEXES(ROW_ID INT NOT NULL, PAGE_ID_RAW INT NOT NULL, PAGE_OFFSET_RAW INT NOT NULL, "
+    "PAGE_OFFSET_RAW_END INT NOT NULL, ROW_GROUP_ID INT NOT NULL, PAGE_ID_BLOB INT NOT NULL, "
+    "PAGE_OFFSET_BLOB INT NOT NULL, PAGE_OFFSET_BLOB_END INT NOT NULL, INC_0 INT, label_0 INTEGER, INC_1 INT, "
+    "file_name_0 TEXT, PRIMARY KEY(ROW_ID, INC_0, INC_1));";
+  ASSERT_EQ(sqlite3_exec(db, sql.c_str(), nullptr, nullptr, nullptr), SQLITE_OK);
+  sql =
+    "INSERT INTO INDEXES (ROW_ID,ROW_GROUP_ID,PAGE_ID_RAW,PAGE_OFFSET_RAW,PAGE_OFFSET_RAW_END,PAGE_ID_BLOB,"
+    "PAGE_OFFSET_BLOB,PAGE_OFFSET_BLOB_END,INC_0,label_0,INC_1,file_name_0) VALUES (:ROW_ID,:ROW_GROUP_ID,"
+    ":PAGE_ID_RAW,:PAGE_OFFSET_RAW,:PAGE_OFFSET_RAW_END,:PAGE_ID_BLOB,:PAGE_OFFSET_BLOB,:PAGE_OFFSET_BLOB_END,"
+    ":INC_0,:label_0,:INC_1,:file_name_0);";
+  sqlite3_stmt *stmt = nullptr;
+  ASSERT_EQ(sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr), SQLITE_OK);
+  (void)sqlite3_exec(db, "BEGIN TRANSACTION;", nullptr, nullptr, nullptr);
+  for (const auto &row : rows) {
+    for (const auto &field : row) {
+      int index = sqlite3_bind_parameter_index(stmt, std::get<0>(field).c_str());
+      if (std::get<1>(field) == "INTEGER") {
+        (void)sqlite3_bind_int64(stmt, index, std::stoll(std::get<2>(field)));
+      } else {
+        (void)sqlite3_bind_text(stmt, index, std::get<2>(field).c_str(), -1, SQLITE_TRANSIENT);
+      }
+    }
+    ASSERT_EQ(sqlite3_step(stmt), SQLITE_DONE);
+    (void)sqlite3_reset(stmt);
+  }
+  (void)sqlite3_exec(db, "END TRANSACTION;", nullptr, nullptr, nullptr);
+  (void)sqlite3_finalize(stmt);
+  (void)sqlite3_close(db);
+}
+
+int CountCallback(void *count, int, char **, char **) {
+  ++*static_cast<uint64_t *>(count);
+  return 0;
+}
+
+double ElapsedMs(std::chrono::steady_clock::time_point begin) {
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+}
+}  // namespace
+
+class TestShardBinaryIndex : public UT::Common {
+ public:
+  TestShardBinaryIndex() {}
+
+  void TearDown() override {
+    (void)std::remove(kIndexPath);
+    (void)std::remove(kSqlitePath);
+  }
+
+  const char *kIndexPath = "./binary_index_test.mindrecord.idx";
+  const char *kSqlitePath = "./binary_index_test.mindrecord.db";
+};
+
+/// Feature: ShardBinaryIndex
+/// Description: write the binary index of rows and query the rows by row id, blob page and field value
+/// Expectation: the results are the same as the rows written
+TEST_F(TestShardBinaryIndex, TestWriteAndQuery) {
+  const uint64_t num_rows = 1000;
+  const uint64_t num_labels = 10;
+  WriteBinaryIndex(kIndexPath, GenerateRows(num_rows, num_labels));
+
+  ShardBinaryIndex index;
+  ASSERT_TRUE(index.Open(kIndexPath).IsOk());
+  ASSERT_EQ(index.ShardName(), "test.mindrecord");
+  ASSERT_EQ(index.ShardSize(), 1024);
+  ASSERT_EQ(index.NumRows(), num_rows);
+
+  auto row = index.FindRow(100);
+  ASSERT_EQ(index.Get(kIndexRowId, row), 100);
+  ASSERT_EQ(index.Get(kIndexPageIdBlob, row), 100 / kRowsPerPage);
+  ASSERT_EQ(index.Get(kIndexPageOffsetBlobEnd, row), (100 % kRowsPerPage) * kBlobSize + kBlobSize);
+  ASSERT_EQ(index.FindRow(num_rows), num_rows);
+
+  auto page_rows = index.RowsInBlobPage(1);
+  ASSERT_EQ(page_rows.size(), kRowsPerPage);
+  for (size_t i = 0; i < page_rows.size(); ++i) {
+    ASSERT_EQ(index.Get(kIndexRowId, page_rows[i]), kRowsPerPage + i);
+  }
+  ASSERT_TRUE(index.RowsInBlobPage(num_rows).empty());
+
+  auto label = index.FieldId("label_0");
+  auto file_name = index.FieldId("file_name_0");
+  ASSERT_GE(label, 0);
+  ASSERT_GE(file_name, 0);
+  ASSERT_EQ(index.FieldId("label"), -1);
+  ASSERT_EQ(index.DistinctValues(label).size(), num_labels);
+  ASSERT_EQ(index.FieldValue(file_name, row), "image_100.jpg");
+
+  // The numbers are compared by value, the texts are compared exactly.
+  auto label_rows = index.RowsWithValue(label, "3.0");
+  ASSERT_EQ(label_rows.size(), num_rows / num_labels);
+  for (size_t i = 0; i < label_rows.size(); ++i) {
+    ASSERT_EQ(index.Get(kIndexRowId, label_rows[i]), i * num_labels + 3);
+  }
+  ASSERT_TRUE(index.RowHasValue(label, row, "0"));
+  ASSERT_FALSE(index.RowHasValue(label, row, "abc"));
+  ASSERT_EQ(index.RowsWithValue(file_name, "image_7.jpg").size(), 1);
+  ASSERT_TRUE(index.RowsWithValue(file_name, "image_7").empty());
+}
+
+/// Feature: ShardBinaryIndex
+/// Description: open a truncated binary index file
+/// Expectation: the file is rejected, so the reader falls back to the sqlite index
+TEST_F(TestShardBinaryIndex, TestBrokenFile) {
+  WriteBinaryIndex(kIndexPath, GenerateRows(100, 10));
+  std::ifstream in(kIndexPath, std::ios::binary);
+  std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  in.close();
+  std::ofstream out(kIndexPath, std::ios::binary | std::ios::trunc);
+  out.write(content.data(), content.size() / 2);
+  out.close();
+
+  ShardBinaryIndex index;
+  ASSERT_FALSE(index.Open(kIndexPath).IsOk());
+}
+
+/// Feature: ShardBinaryIndex
+/// Description: open the index and query the rows of categories by page with the binary index and the sqlite index
+/// Expectation: both indexes return the same number of rows, and the cost is printed for comparison
+TEST_F(TestShardBinaryIndex, TestOpenAndQueryBenchmark) {
+  const uint64_t num_rows = 200000;
+  const uint64_t num_labels = 100;
+  const uint64_t num_queries = 200;
+  auto rows = GenerateRows(num_rows, num_labels);
+  WriteBinaryIndex(kIndexPath, rows);
+  WriteSqliteIndex(kSqlitePath, rows);
+
+  // Open the index and read all the rows as the reader does when the tasks are created.
+  auto begin = std::chrono::steady_clock::now();
+  sqlite3 *db = nullptr;
+  ASSERT_EQ(sqlite3_open_v2(kSqlitePath, &db, SQLITE_OPEN_READONLY, nullptr), SQLITE_OK);
+  uint64_t sqlite_count = 0;
+  std::string sql =
+    "SELECT ROW_GROUP_ID, PAGE_OFFSET_BLOB, PAGE_OFFSET_BLOB_END, label_0 FROM INDEXES ORDER BY ROW_ID;";
+  ASSERT_EQ(sqlite3_exec(db, sql.c_str(), CountCallback, &sqlite_count, nullptr), SQLITE_OK);
+  auto sqlite_open_ms = ElapsedMs(begin);
+
+  begin = std::chrono::steady_clock::now();
+  ShardBinaryIndex index;
+  ASSERT_TRUE(index.Open(kIndexPath).IsOk());
+  auto label = index.FieldId("label_0");
+  uint64_t binary_count = 0;
+  uint64_t checksum = 0;
+  for (uint64_t row = 0; row < index.NumRows(); ++row) {
+    checksum += index.Get(kIndexRowGroupId, row) + index.Get(kIndexPageOffsetBlob, row) +
+                index.Get(kIndexPageOffsetBlobEnd, row) + index.FieldValue(label, row).size();
+    ++binary_count;
+  }
+  auto binary_open_ms = ElapsedMs(begin);
+  ASSERT_EQ(sqlite_count, num_rows);
+  ASSERT_EQ(binary_count, num_rows);
+  ASSERT_GT(checksum, 0);
+
+  // Query the rows of a category in a page as the category sampler does.
+  begin = std::chrono::steady_clock::now();
+  sqlite_count = 0;
+  for (uint64_t i = 0; i < num_queries; ++i) {
+    sql = "SELECT PAGE_OFFSET_BLOB, PAGE_OFFSET_BLOB_END FROM INDEXES WHERE PAGE_ID_BLOB = " +
+          std::to_string(i % (num_rows / kRowsPerPage)) + " AND label_0 = " + std::to_string(i % num_labels) + ";";
+    ASSERT_EQ(sqlite3_exec(db, sql.c_str(), CountCallback, &sqlite_count, nullptr), SQLITE_OK);
+  }
+  auto sqlite_query_ms = ElapsedMs(begin);
+  (void)sqlite3_close(db);
+
+  begin = std::chrono::steady_clock::now();
+  binary_count = 0;
+  for (uint64_t i = 0; i < num_queries; ++i) {
+    for (auto row : index.RowsInBlobPage(i % (num_rows / kRowsPerPage))) {
+      binary_count += index.RowHasValue(label, row, std::to_string(i % num_labels)) ? 1 : 0;
+    }
+  }
+  auto binary_query_ms = ElapsedMs(begin);
+  ASSERT_EQ(sqlite_count, binary_count);
+
+  std::cout << "Rows: " << num_rows << ", open and read all rows, sqlite: " << sqlite_open_ms
+            << " ms, binary index: " << binary_open_ms << " ms; " << num_queries
+            << " category queries by page, sqlite: " << sqlite_query_ms << " ms, binary index: " << binary_query_ms
+            << " ms" << std::endl;
+}
+}  // namespace mindrecord
+}  // namespace mindspore
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <sys/stat.h>
+#include <unistd.h>
 #include <cstring>
 #include <functional>
 #include <iostream>
@@ -24,6 +26,7 @@
 #include "utils/ms_utils.h"
 #include "gtest/gtest.h"
 #include "utils/log_adapter.h"
+#include "minddata/mindrecord/include/shard_index_generator.h"
 #include "minddata/mindrecord/include/shard_reader.h"
 #include "minddata/mindrecord/include/shard_sample.h"
 #include "ut_common.h"
@@ -94,6 +97,39 @@ TEST_F(TestShardReader, TestShardReaderLazyLoad) {
   dataset.Close();
 }
 
+/// Feature: ShardReader
+/// Description: read the rows by id through the blob view of the mapped shard file
+/// Expectation: the blob view and the fields are the same as the rows read by the file stream
+TEST_F(TestShardReader, TestShardReaderBlobViewMmap) {
+  MS_LOG(INFO) << FormatInfo("Test read imageNet by blob view");
+  std::string file_name = "./imagenet.shard01";
+  auto column_list = std::vector<std::string>{"file_name", "label"};
+
+  ShardReader stream_dataset;
+  ASSERT_TRUE(stream_dataset.Open({file_name}, true, 1, column_list).IsOk());
+  ASSERT_TRUE(stream_dataset.Launch(true).IsOk());
+  ShardReader mmap_dataset;
+  ASSERT_TRUE(mmap_dataset.Open({file_name}, true, 1, column_list, {}, 0, false, true).IsOk());
+  ASSERT_TRUE(mmap_dataset.Launch(true).IsOk());
+
+  auto num_rows = mmap_dataset.GetNumRows();
+  for (int64_t i = 0; i < num_rows; ++i) {
+    auto expected = stream_dataset.GetNextById(i, 0);
+    ASSERT_EQ(expected.second.size(), 1);
+    TaskType task_type = TaskType::kPaddedTask;
+    ShardBlobView blob;
+    json fields;
+    ASSERT_TRUE(mmap_dataset.GetBlobViewById(i, 0, &task_type, &blob, &fields).IsOk());
+    ASSERT_EQ(task_type, TaskType::kCommonTask);
+    const auto &expected_blob = std::get<0>(expected.second[0]);
+    ASSERT_EQ(blob.size, expected_blob.size());
+    ASSERT_TRUE(blob.size == 0 || memcmp(blob.data, expected_blob.data(), blob.size) == 0);
+    ASSERT_EQ(fields, std::get<1>(expected.second[0]));
+  }
+  stream_dataset.Close();
+  mmap_dataset.Close();
+}
+
 TEST_F(TestShardReader, TestShardReaderSample) {
   MS_LOG(INFO) << FormatInfo("Test read imageNet");
   std::string file_name = "./imagenet.shard01";
@@ -243,5 +279,36 @@ TEST_F(TestShardReader, TestShardReaderConsumer) {
   }
   dataset.Close();
 }
+
+/// Feature: MindRecord binary index.
+/// Description: generate the index when the binary index file of a shard can not be written.
+/// Expectation: the index generation succeeds without the binary index, and the reader falls back to sqlite.
+TEST_F(TestShardReader, TestIndexGeneratorSkipFailedBinaryIndex) {
+  std::string file_name = "./imagenet.shard01";
+  for (int i = 1; i <= 4; i++) {
+    string shard_name = std::string("./imagenet.shard0") + std::to_string(i);
+    remove(common::SafeCStr(shard_name + ".db"));
+    remove(common::SafeCStr(shard_name + ".idx"));
+  }
+  // A directory in the place of the binary index makes writing it fail.
+  std::string index_name = file_name + ".idx";
+  ASSERT_EQ(mkdir(index_name.c_str(), S_IRWXU), 0);
+  ShardIndexGenerator generator{file_name};
+  auto build_status = generator.Build();
+  auto write_status = generator.WriteToDatabase();
+  (void)rmdir(index_name.c_str());
+  ASSERT_TRUE(build_status.IsOk());
+  ASSERT_TRUE(write_status.IsOk());
+
+  ShardReader dataset;
+  ASSERT_TRUE(dataset.Open({file_name}, true, 4, std::vector<std::string>{"file_name"}).IsOk());
+  ASSERT_TRUE(dataset.Launch().IsOk());
+  int row_num = 0;
+  while (!dataset.GetNext().empty()) {
+    row_num++;
+  }
+  dataset.Close();
+  ASSERT_EQ(row_num, 10);
+}
 }  // namespace mindrecord
 }  // namespace mindspore
@@ -0,0 +1,291 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "actor/actor.h"
+#include "async/async.h"
+#include "thread/actor_threadpool.h"
+
+namespace mindspore {
+class TestActorThreadPool : public UT::Common {
+ public:
+  TestActorThreadPool() = default;
+};
+
+namespace {
+constexpr size_t kActorBufferSize = 256;
+
+// A small compute actor which triggers its successor when it finishes, like the kernel actor does in SendOutput.
+class ChainActor : public ActorBase {
+ public:
+  ChainActor(const std::string &name, ActorThreadPool *pool, std::atomic_size_t *finished_num)
+      : ActorBase(name, pool), finished_num_(finished_num), buffer_(kActorBufferSize, 1.0f) {}
+  ~ChainActor() override = default;
+
+  void set_successor(const AID &successor) {
+    successor_ = successor;
+    has_successor_ = true;
+  }
+
+  void Step(int step) {
+    for (auto &value : buffer_) {
+      value = value * 0.5f + static_cast<float>(step);
+    }
+    if (has_successor_) {
+      Async(successor_, &ChainActor::Step, step);
+    } else {
+      (void)++(*finished_num_);
+    }
+  }
+
+ private:
+  std::atomic_size_t *finished_num_;
+  std::vector<float> buffer_;
+  AID successor_;
+  bool has_successor_{false};
+};
+
+// Build chain_num chains of chain_len actors and return the average step latency in microseconds.
+double RunActorGraph(ActorQueueMode mode, size_t thread_num, size_t chain_num, size_t chain_len, size_t step_num) {
+  auto pool = ActorThreadPool::CreateThreadPool(thread_num);
+  if (pool == nullptr) {
+    return -1;
+  }
+  pool->SetActorQueueMode(mode);
+  std::atomic_size_t finished_num = {0};
+  std::vector<std::shared_ptr<ChainActor>> actors;
+  std::vector<AID> heads;
+  for (size_t chain = 0; chain < chain_num; chain++) {
+    std::shared_ptr<ChainActor> prev = nullptr;
+    for (size_t i = 0; i < chain_len; i++) {
+      auto name = "ChainActor_" + std::to_string(mode) + "_" + std::to_string(chain) + "_" + std::to_string(i);
+      auto actor = std::make_shared<ChainActor>(name, pool, &finished_num);
+      (void)ActorMgr::GetActorMgrRef()->Spawn(actor);
+      if (prev == nullptr) {
+        heads.emplace_back(actor->GetAID());
+      } else {
+        prev->set_successor(actor->GetAID());
+      }
+      actors.emplace_back(actor);
+      prev = actor;
+    }
+  }
+
+  auto begin = std::chrono::steady_clock::now();
+  for (size_t step = 0; step < step_num; step++) {
+    finished_num = 0;
+    for (auto &head : heads) {
+      Async(head, &ChainActor::Step, static_cast<int>(step));
+    }
+    while (finished_num < chain_num) {
+      std::this_thread::yield();
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  for (auto &actor : actors) {
+    ActorMgr::GetActorMgrRef()->Terminate(actor->GetAID());
+  }
+  delete pool;
+  auto cost_us = std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+  return static_cast<double>(cost_us) / step_num;
+}
+
+// An actor counting the messages it handles, which fails if it is run by two threads at the same time.
+class CountActor : public ActorBase {
+ public:
+  CountActor(const std::string &name, ActorThreadPool *pool, std::atomic_size_t *total_count)
+      : ActorBase(name, pool), total_count_(total_count) {}
+  ~CountActor() override = default;
+
+  void set_peers(const std::vector<AID> *peers) { peers_ = peers; }
+  size_t count() const { return count_; }
+  bool overlapped() const { return overlapped_; }
+
+  void Count() {
+    if (running_.exchange(true)) {
+      overlapped_ = true;
+    }
+    ++count_;
+    (void)++(*total_count_);
+    running_ = false;
+  }
+
+  // send a message to every peer from the actor thread, which fills the local queue of the thread
+  void FanOut() {
+    for (auto &peer : *peers_) {
+      Async(peer, &CountActor::Count);
+    }
+  }
+
+ private:
+  std::atomic_size_t *total_count_;
+  const std::vector<AID> *peers_{nullptr};
+  std::atomic_bool running_{false};
+  std::atomic_bool overlapped_{false};
+  size_t count_{0};
+};
+
+// An actor which sets the flag, it is triggered by the WaitActor.
+class FlagActor : public ActorBase {
+ public:
+  FlagActor(const std::string &name, ActorThreadPool *pool, std::atomic_bool *flag)
+      : ActorBase(name, pool), flag_(flag) {}
+  ~FlagActor() override = default;
+
+  void Set() { *flag_ = true; }
+
+ private:
+  std::atomic_bool *flag_;
+};
+
+// An actor which triggers the FlagActor and waits for the flag on the actor thread, so the FlagActor kept in the next
+// slot of the thread has to be stolen by another thread.
+class WaitActor : public ActorBase {
+ public:
+  WaitActor(const std::string &name, ActorThreadPool *pool, const AID &flag_actor, std::atomic_bool *flag)
+      : ActorBase(name, pool), flag_actor_(flag_actor), flag_(flag) {}
+  ~WaitActor() override = default;
+
+  void TriggerAndWait(std::chrono::milliseconds timeout) {
+    Async(flag_actor_, &FlagActor::Set);
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!*flag_ && std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::yield();
+    }
+    finished_ = true;
+  }
+  bool finished() const { return finished_; }
+
+ private:
+  AID flag_actor_;
+  std::atomic_bool *flag_;
+  std::atomic_bool finished_{false};
+};
+}  // namespace
+
+/// Feature: ActorThreadPool work stealing mode.
+/// Description: many threads send messages to more actors than the local queue can hold, and actors send messages
+///     to all the actors from the actor threads at the same time.
+/// Expectation: every message is handled exactly once and no actor is run by two threads at the same time.
+TEST_F(TestActorThreadPool, test_work_stealing_run_actors_once) {
+  constexpr size_t kThreadNum = 4;
+  constexpr size_t kActorNum = 4608;
+  constexpr size_t kSenderNum = 8;
+  constexpr size_t kRoundNum = 4;
+  auto pool = ActorThreadPool::CreateThreadPool(kThreadNum);
+  ASSERT_NE(pool, nullptr);
+  pool->SetActorQueueMode(kWorkStealing);
+  std::atomic_size_t total_count = {0};
+  std::vector<std::shared_ptr<CountActor>> actors;
+  std::vector<AID> aids;
+  for (size_t i = 0; i < kActorNum; i++) {
+    auto actor = std::make_shared<CountActor>("CountActor_" + std::to_string(i), pool, &total_count);
+    (void)ActorMgr::GetActorMgrRef()->Spawn(actor);
+    actors.emplace_back(actor);
+    aids.emplace_back(actor->GetAID());
+  }
+  for (auto &actor : actors) {
+    actor->set_peers(&aids);
+  }
+
+  std::vector<std::thread> senders;
+  for (size_t sender = 0; sender < kSenderNum; sender++) {
+    senders.emplace_back([&aids, sender]() {
+      for (size_t round = 0; round < kRoundNum; round++) {
+        Async(aids[(sender * kRoundNum + round) % aids.size()], &CountActor::FanOut);
+        for (auto &aid : aids) {
+          Async(aid, &CountActor::Count);
+        }
+      }
+    });
+  }
+  for (auto &sender : senders) {
+    sender.join();
+  }
+  // every sender and every fan out sends one message to each actor in each round
+  const size_t expected_count = 2 * kSenderNum * kRoundNum;
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(60);
+  while (total_count < expected_count * kActorNum && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_EQ(total_count, expected_count * kActorNum);
+  for (auto &actor : actors) {
+    EXPECT_EQ(actor->count(), expected_count);
+    EXPECT_FALSE(actor->overlapped());
+    ActorMgr::GetActorMgrRef()->Terminate(actor->GetAID());
+  }
+  delete pool;
+}
+
+/// Feature: ActorThreadPool work stealing mode.
+/// Description: an actor triggers another actor and waits for it on the actor thread.
+/// Expectation: the triggered actor in the next slot of the waiting thread is stolen and run by another thread.
+TEST_F(TestActorThreadPool, test_work_stealing_next_actor) {
+  constexpr size_t kThreadNum = 2;
+  constexpr auto kWaitTimeout = std::chrono::milliseconds(5000);
+  // the actor threads are no more than the cores, and no thread can steal the actor with one core
+  if (std::thread::hardware_concurrency() < kThreadNum) {
+    std::cout << "Skip the test on the machine with less than " << kThreadNum << " cores." << std::endl;
+    return;
+  }
+  auto pool = ActorThreadPool::CreateThreadPool(kThreadNum);
+  ASSERT_NE(pool, nullptr);
+  pool->SetActorQueueMode(kWorkStealing);
+  // let the actor threads sleep before the actors are triggered
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  std::atomic_bool flag = {false};
+  auto flag_actor = std::make_shared<FlagActor>("FlagActor", pool, &flag);
+  (void)ActorMgr::GetActorMgrRef()->Spawn(flag_actor);
+  auto wait_actor = std::make_shared<WaitActor>("WaitActor", pool, flag_actor->GetAID(), &flag);
+  (void)ActorMgr::GetActorMgrRef()->Spawn(wait_actor);
+  Async(wait_actor->GetAID(), &WaitActor::TriggerAndWait, kWaitTimeout);
+  auto deadline = std::chrono::steady_clock::now() + kWaitTimeout / 2;
+  while (!flag && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_TRUE(flag);
+  while (!wait_actor->finished()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  ActorMgr::GetActorMgrRef()->Terminate(wait_actor->GetAID());
+  ActorMgr::GetActorMgrRef()->Terminate(flag_actor->GetAID());
+  delete pool;
+}
+
+/// Feature: ActorThreadPool work stealing mode.
+/// Description: run a graph of several thousands of small actors in the global queue mode and work stealing mode.
+/// Expectation: every step finishes in both modes; the step latency is printed for comparison.
+TEST_F(TestActorThreadPool, test_work_stealing_benchmark) {
+  constexpr size_t kThreadNum = 4;
+  constexpr size_t kChainNum = 64;
+  constexpr size_t kChainLen = 64;
+  constexpr size_t kStepNum = 20;
+  double global_latency = RunActorGraph(kGlobalActorQueue, kThreadNum, kChainNum, kChainLen, kStepNum);
+  double stealing_latency = RunActorGraph(kWorkStealing, kThreadNum, kChainNum, kChainLen, kStepNum);
+  ASSERT_GE(global_latency, 0);
+  ASSERT_GE(stealing_latency, 0);
+  std::cout << "Actor graph step latency, global queue: " << global_latency
+            << " us, work stealing: " << stealing_latency << " us" << std::endl;
+}
+}  // namespace mindspore
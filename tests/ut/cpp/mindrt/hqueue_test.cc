@@ -0,0 +1,154 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "thread/hqueue.h"
+
+namespace mindspore {
+class TestHQueue : public UT::Common {
+ public:
+  TestHQueue() = default;
+};
+
+namespace {
+constexpr int32_t kQueueSize = 4096;
+
+// Run producer_num producers against one consumer, returns the throughput in million ops per second.
+double RunEnqueueDequeue(size_t producer_num, size_t msg_per_producer, size_t *consumed) {
+  HQueue<size_t> queue;
+  if (!queue.Init(kQueueSize)) {
+    return 0;
+  }
+  std::vector<size_t> values(producer_num * msg_per_producer);
+  for (size_t i = 0; i < values.size(); i++) {
+    values[i] = i;
+  }
+  std::atomic_bool start = {false};
+  std::vector<std::thread> producers;
+  for (size_t p = 0; p < producer_num; p++) {
+    producers.emplace_back([&, p]() {
+      while (!start) {
+      }
+      for (size_t i = 0; i < msg_per_producer; i++) {
+        while (!queue.Enqueue(&values[p * msg_per_producer + i])) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  size_t total = producer_num * msg_per_producer;
+  size_t count = 0;
+  auto begin = std::chrono::steady_clock::now();
+  start = true;
+  while (count < total) {
+    if (queue.Dequeue() != nullptr) {
+      count++;
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+  for (auto &producer : producers) {
+    producer.join();
+  }
+  queue.Clean();
+  *consumed = count;
+  auto cost_us = std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+  return cost_us == 0 ? 0 : static_cast<double>(total) / cost_us;
+}
+}  // namespace
+
+/// Feature: HQueue.
+/// Description: enqueue from several threads and dequeue from one thread.
+/// Expectation: every enqueued element is dequeued exactly once.
+TEST_F(TestHQueue, test_multi_producer) {
+  HQueue<int> queue;
+  ASSERT_TRUE(queue.Init(kQueueSize));
+  ASSERT_TRUE(queue.Empty());
+  constexpr size_t kProducerNum = 4;
+  constexpr size_t kMsgNum = 10000;
+  std::vector<int> values(kProducerNum * kMsgNum, 0);
+  std::vector<std::thread> producers;
+  for (size_t p = 0; p < kProducerNum; p++) {
+    producers.emplace_back([&, p]() {
+      for (size_t i = 0; i < kMsgNum; i++) {
+        while (!queue.Enqueue(&values[p * kMsgNum + i])) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  size_t count = 0;
+  while (count < values.size()) {
+    int *value = queue.Dequeue();
+    if (value != nullptr) {
+      (*value)++;
+      count++;
+    }
+  }
+  for (auto &producer : producers) {
+    producer.join();
+  }
+  for (auto value : values) {
+    ASSERT_EQ(value, 1);
+  }
+  ASSERT_TRUE(queue.Empty());
+  queue.Clean();
+}
+
+/// Feature: HQueue.
+/// Description: fill the queue to its capacity, then drain it.
+/// Expectation: enqueue fails only when all nodes are in use and nodes are reusable after dequeue.
+TEST_F(TestHQueue, test_capacity) {
+  constexpr int32_t kSize = 8;
+  HQueue<int> queue;
+  ASSERT_TRUE(queue.Init(kSize));
+  std::vector<int> values(kSize);
+  // one node is used as the dummy head
+  for (int32_t i = 0; i < kSize - 1; i++) {
+    ASSERT_TRUE(queue.Enqueue(&values[i]));
+  }
+  ASSERT_FALSE(queue.Enqueue(&values[kSize - 1]));
+  for (int round = 0; round < 3; round++) {
+    ASSERT_EQ(queue.Dequeue(), &values[round]);
+    ASSERT_TRUE(queue.Enqueue(&values[round]));
+    ASSERT_FALSE(queue.Enqueue(&values[kSize - 1]));
+  }
+  size_t count = 0;
+  while (queue.Dequeue() != nullptr) {
+    count++;
+  }
+  ASSERT_EQ(count, kSize - 1);
+  ASSERT_TRUE(queue.Empty());
+  queue.Clean();
+}
+
+/// Feature: HQueue.
+/// Description: measure enqueue/dequeue throughput with 1 to 64 producers.
+/// Expectation: all messages are consumed; throughput is printed for comparison between revisions.
+TEST_F(TestHQueue, test_throughput_benchmark) {
+  constexpr size_t kMsgPerProducer = 20000;
+  for (size_t producer_num = 1; producer_num <= 64; producer_num *= 2) {
+    size_t consumed = 0;
+    double mops = RunEnqueueDequeue(producer_num, kMsgPerProducer, &consumed);
+    ASSERT_EQ(consumed, producer_num * kMsgPerProducer);
+    std::cout << "HQueue producers: " << producer_num << ", throughput: " << mops << " Mops/s" << std::endl;
+  }
+}
+}  // namespace mindspore
@@ -163,5 +163,33 @@ TEST_F(TestEdgeCostModel, test_EdgeEliminationSetNewCost) {
   new_edge->EdgeEliminationSetNewCost(matmul1, edges, matmul5);
 }
 
+/// Feature: auto parallel redistribution cost cache.
+/// Description: init the costs of two edges between the operators of the same layouts.
+/// Expectation: the costs of the same strategies are the same, and each edge has its own cost objects.
+TEST_F(TestEdgeCostModel, test_InitEdgeCostWithCachedRedistributionCost) {
+  std::string edge_name = "MatMul-MatMul";
+  matmul1->GenerateStrategies(0);
+  matmul2->GenerateStrategies(0);
+  ClearRedistributionCostCache();
+  std::shared_ptr<Edge> edge = std::make_shared<Edge>(edge_name, matmul1, matmul2, 0, 0, false);
+  std::shared_ptr<Edge> same_edge = std::make_shared<Edge>(edge_name, matmul1, matmul2, 0, 0, false);
+  ASSERT_EQ(edge->InitEdgeCost(), SUCCESS);
+  ASSERT_EQ(same_edge->InitEdgeCost(), SUCCESS);
+
+  for (auto &output_pair : edge->prev_op_output()) {
+    for (auto &input_pair : edge->next_op_input()) {
+      auto clist = edge->GetCostList(output_pair.first, input_pair.first);
+      auto same_clist = same_edge->GetCostList(output_pair.first, input_pair.first);
+      ASSERT_EQ(clist.size(), 1);
+      ASSERT_EQ(same_clist.size(), 1);
+      EXPECT_NE(clist[0], same_clist[0]);
+      EXPECT_DOUBLE_EQ(clist[0]->computation_cost_, same_clist[0]->computation_cost_);
+      EXPECT_DOUBLE_EQ(clist[0]->communication_cost_, same_clist[0]->communication_cost_);
+      EXPECT_DOUBLE_EQ(clist[0]->communication_forward_, same_clist[0]->communication_forward_);
+      EXPECT_DOUBLE_EQ(clist[0]->memory_with_reuse_, same_clist[0]->memory_with_reuse_);
+    }
+  }
+}
+
 }  // namespace parallel
 }  // namespace mindspore
@@ -0,0 +1,290 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+#include <vector>
+#include "common/common_test.h"
+#include "utils/hash_map.h"
+#include "ps/ps_cache/embedding_hash_map.h"
+
+namespace mindspore {
+namespace ps {
+namespace {
+// Generate the ids in [0, vocab_size) following the zipfian distribution, the smaller id is the hotter.
+std::vector<int> GenerateZipfianIds(size_t ids_num, size_t vocab_size, double skew, uint32_t seed) {
+  std::vector<double> cdf(vocab_size);
+  double sum = 0;
+  for (size_t i = 0; i < vocab_size; ++i) {
+    sum += 1.0 / std::pow(static_cast<double>(i + 1), skew);
+    cdf[i] = sum;
+  }
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> dist(0, sum);
+  std::vector<int> ids(ids_num);
+  for (auto &id : ids) {
+    id = static_cast<int>(std::lower_bound(cdf.begin(), cdf.end(), dist(gen)) - cdf.begin());
+  }
+  return ids;
+}
+
+// Parse the ids one by one as the cache manager did before the batch interface: the batch is checked for the ids in
+// the cache at first, and then the missed ids are inserted one by one.
+size_t ParseIdById(EmbeddingHashMap *hash_map, const std::vector<int> &ids, size_t data_step,
+                   size_t graph_running_step, int *hash_index, HashSwapInfo *swap_info, bool *need_wait_graph) {
+  std::vector<bool> in_cache(ids.size(), false);
+  for (size_t i = 0; i < ids.size(); ++i) {
+    auto index = hash_map->hash_id_to_index().Find(ids[i]);
+    if (index != INVALID_INDEX_VALUE) {
+      if (hash_map->hash_step(index) != data_step) {
+        hash_map->set_hash_step(index, data_step);
+        swap_info->hash_hit_count++;
+      }
+      hash_index[i] = index;
+      in_cache[i] = true;
+    }
+  }
+  for (size_t i = 0; i < ids.size(); ++i) {
+    if (in_cache[i]) {
+      continue;
+    }
+    auto index = hash_map->hash_id_to_index().Find(ids[i]);
+    if (index != INVALID_INDEX_VALUE) {
+      hash_index[i] = index;
+      continue;
+    }
+    index = hash_map->ParseData(ids[i], swap_info->swap_out_index, swap_info->swap_out_ids, data_step,
+                                graph_running_step, &swap_info->swap_out_size, need_wait_graph);
+    if (index == INVALID_INDEX_VALUE) {
+      return i;
+    }
+    hash_index[i] = index;
+    swap_info->swap_in_index[swap_info->swap_in_size] = index;
+    swap_info->swap_in_ids[swap_info->swap_in_size++] = ids[i];
+  }
+  return ids.size();
+}
+
+struct SwapBuffers {
+  explicit SwapBuffers(size_t size)
+      : hash_index(size), swap_in_index(size), swap_in_ids(size), swap_out_index(size), swap_out_ids(size) {
+    info.swap_in_index = swap_in_index.data();
+    info.swap_in_ids = swap_in_ids.data();
+    info.swap_out_index = swap_out_index.data();
+    info.swap_out_ids = swap_out_ids.data();
+  }
+  void Clear() {
+    info.swap_in_size = 0;
+    info.swap_out_size = 0;
+    info.hash_hit_count = 0;
+  }
+  std::vector<int> hash_index;
+  std::vector<int> swap_in_index;
+  std::vector<int> swap_in_ids;
+  std::vector<int> swap_out_index;
+  std::vector<int> swap_out_ids;
+  HashSwapInfo info;
+};
+
+double ElapsedMs(std::chrono::steady_clock::time_point begin) {
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+}
+}  // namespace
+
+class TestEmbeddingHashMap : public UT::Common {
+ public:
+  TestEmbeddingHashMap() = default;
+  virtual ~TestEmbeddingHashMap() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+/// Feature: EmbeddingIdTable
+/// Description: insert and erase the ids randomly, and find the ids in the table
+/// Expectation: the table has the same content as std::unordered_map
+TEST_F(TestEmbeddingHashMap, IdTableInsertEraseFind) {
+  const size_t max_size = 1000;
+  EmbeddingIdTable table(max_size);
+  std::unordered_map<int, int> expected;
+  std::mt19937 gen(0);
+  std::uniform_int_distribution<int> id_dist(-5000, 5000);
+  for (int i = 0; i < 100000; ++i) {
+    int id = id_dist(gen);
+    auto iter = expected.find(id);
+    if (iter != expected.end()) {
+      EXPECT_EQ(table.Find(id), iter->second);
+      EXPECT_TRUE(table.Erase(id));
+      expected.erase(iter);
+    } else if (expected.size() < max_size) {
+      EXPECT_EQ(table.Find(id), INVALID_INDEX_VALUE);
+      table.Insert(id, i);
+      expected[id] = i;
+    } else {
+      EXPECT_FALSE(table.Erase(id));
+    }
+  }
+  EXPECT_EQ(table.size(), expected.size());
+  size_t count = 0;
+  table.ForEach([&](int id, int index) {
+    EXPECT_EQ(expected.at(id), index);
+    ++count;
+  });
+  EXPECT_EQ(count, expected.size());
+}
+
+/// Feature: EmbeddingIdTable
+/// Description: insert, find and erase the ids INT_MIN and INT_MIN + 1 which mark the empty and the deleted slots
+/// Expectation: the ids are found like the other ids and the table rehash does not lose them
+TEST_F(TestEmbeddingHashMap, IdTableReservedIds) {
+  const size_t max_size = 100;
+  EmbeddingIdTable table(max_size);
+  EXPECT_EQ(table.Find(INT_MIN), INVALID_INDEX_VALUE);
+  EXPECT_FALSE(table.Erase(INT_MIN + 1));
+  table.Insert(INT_MIN, 0);
+  table.Insert(INT_MIN + 1, 1);
+  // Insert and erase the other ids to rehash the table.
+  for (int i = 0; i < 1000; ++i) {
+    table.Insert(i, i + 2);
+    if (i >= 10) {
+      EXPECT_TRUE(table.Erase(i - 10));
+    }
+  }
+  EXPECT_EQ(table.Find(INT_MIN), 0);
+  EXPECT_EQ(table.Find(INT_MIN + 1), 1);
+  EXPECT_EQ(table.Find(999), 1001);
+  EXPECT_EQ(table.size(), 12);
+  size_t count = 0;
+  table.ForEach([&](int id, int index) {
+    EXPECT_EQ(table.Find(id), index);
+    ++count;
+  });
+  EXPECT_EQ(count, 12);
+  EXPECT_TRUE(table.Erase(INT_MIN));
+  EXPECT_EQ(table.Find(INT_MIN), INVALID_INDEX_VALUE);
+  EXPECT_EQ(table.Find(INT_MIN + 1), 1);
+  EXPECT_EQ(table.size(), 11);
+}
+
+/// Feature: EmbeddingHashMap
+/// Description: parse zipfian batches with evictions by the batch interface and id by id
+/// Expectation: the hash index, the swap in and swap out lists and the hit count are the same
+TEST_F(TestEmbeddingHashMap, BatchParseSameAsIdById) {
+  const size_t batch_size = 2000;
+  const size_t capacity = 3000;
+  EmbeddingHashMap batch_map(0, capacity);
+  EmbeddingHashMap single_map(0, capacity);
+  SwapBuffers batch_buffers(batch_size);
+  SwapBuffers single_buffers(batch_size);
+  size_t swap_out_count = 0;
+  for (size_t data_step = 1; data_step <= 20; ++data_step) {
+    auto ids = GenerateZipfianIds(batch_size, 100000, 0.8, data_step);
+    size_t graph_running_step = data_step - 1;
+    batch_map.Reset();
+    single_map.Reset();
+    batch_buffers.Clear();
+    single_buffers.Clear();
+    bool batch_wait = false;
+    bool single_wait = false;
+    auto batch_parsed = batch_map.ParseData(ids.data(), ids.size(), data_step, graph_running_step,
+                                            batch_buffers.hash_index.data(), &batch_buffers.info, &batch_wait);
+    auto single_parsed = ParseIdById(&single_map, ids, data_step, graph_running_step,
+                                     single_buffers.hash_index.data(), &single_buffers.info, &single_wait);
+    ASSERT_EQ(batch_parsed, single_parsed);
+    ASSERT_EQ(batch_wait, single_wait);
+    ASSERT_EQ(batch_buffers.info.hash_hit_count, single_buffers.info.hash_hit_count);
+    ASSERT_EQ(batch_buffers.info.swap_in_size, single_buffers.info.swap_in_size);
+    ASSERT_EQ(batch_buffers.info.swap_out_size, single_buffers.info.swap_out_size);
+    for (size_t i = 0; i < batch_parsed; ++i) {
+      ASSERT_EQ(batch_buffers.hash_index[i], single_buffers.hash_index[i]);
+    }
+    for (size_t i = 0; i < batch_buffers.info.swap_in_size; ++i) {
+      ASSERT_EQ(batch_buffers.swap_in_index[i], single_buffers.swap_in_index[i]);
+      ASSERT_EQ(batch_buffers.swap_in_ids[i], single_buffers.swap_in_ids[i]);
+    }
+    for (size_t i = 0; i < batch_buffers.info.swap_out_size; ++i) {
+      ASSERT_EQ(batch_buffers.swap_out_index[i], single_buffers.swap_out_index[i]);
+      ASSERT_EQ(batch_buffers.swap_out_ids[i], single_buffers.swap_out_ids[i]);
+    }
+    swap_out_count += batch_buffers.info.swap_out_size;
+  }
+  EXPECT_GT(swap_out_count, 0);
+  EXPECT_EQ(batch_map.hash_id_to_index().size(), single_map.hash_id_to_index().size());
+}
+
+/// Feature: EmbeddingHashMap
+/// Description: look up zipfian batches by mindspore::HashMap, by EmbeddingIdTable id by id and by the batch interface,
+/// and then parse the batches
+/// Expectation: the lookups find the same ids, and the cost is printed for comparison
+TEST_F(TestEmbeddingHashMap, BatchParseZipfianBenchmark) {
+  const size_t batch_size = 1000000;
+  const size_t capacity = 1200000;
+  const size_t steps = 5;
+  for (double skew : {0.8, 1.2}) {
+    EmbeddingHashMap hash_map(0, capacity);
+    mindspore::HashMap<int, int> id_to_index;
+    SwapBuffers buffers(batch_size);
+    double hash_map_ms = 0;
+    double id_table_ms = 0;
+    double lookup_ms = 0;
+    double parse_ms = 0;
+    for (size_t data_step = 1; data_step <= steps; ++data_step) {
+      auto ids = GenerateZipfianIds(batch_size, 10000000, skew, data_step);
+      auto begin = std::chrono::steady_clock::now();
+      size_t hash_map_found = 0;
+      for (auto id : ids) {
+        hash_map_found += id_to_index.find(id) != id_to_index.end() ? 1 : 0;
+      }
+      hash_map_ms += ElapsedMs(begin);
+
+      begin = std::chrono::steady_clock::now();
+      size_t id_table_found = 0;
+      for (auto id : ids) {
+        id_table_found += hash_map.hash_id_to_index().Find(id) != INVALID_INDEX_VALUE ? 1 : 0;
+      }
+      id_table_ms += ElapsedMs(begin);
+
+      begin = std::chrono::steady_clock::now();
+      (void)hash_map.Lookup(ids.data(), ids.size(), data_step, buffers.hash_index.data());
+      lookup_ms += ElapsedMs(begin);
+      auto lookup_found = std::count_if(buffers.hash_index.begin(), buffers.hash_index.end(),
+                                        [](int index) { return index != INVALID_INDEX_VALUE; });
+      ASSERT_EQ(hash_map_found, id_table_found);
+      ASSERT_EQ(hash_map_found, lookup_found);
+
+      hash_map.Reset();
+      buffers.Clear();
+      bool need_wait_graph = false;
+      begin = std::chrono::steady_clock::now();
+      auto parsed = hash_map.ParseData(ids.data(), ids.size(), data_step, data_step - 1, buffers.hash_index.data(),
+                                       &buffers.info, &need_wait_graph);
+      parse_ms += ElapsedMs(begin);
+      ASSERT_EQ(parsed, ids.size());
+      id_to_index.clear();
+      hash_map.hash_id_to_index().ForEach([&id_to_index](int id, int index) { id_to_index[id] = index; });
+    }
+    std::cout << "Zipfian skew " << skew << ", " << steps << " batches of " << batch_size
+              << " ids, lookup by mindspore::HashMap: " << hash_map_ms << " ms, by EmbeddingIdTable: " << id_table_ms
+              << " ms, by batch Lookup: " << lookup_ms << " ms; batch ParseData: " << parse_ms << " ms" << std::endl;
+  }
+}
+}  // namespace ps
+}  // namespace mindspore
@@ -0,0 +1,158 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <time.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "include/common/thread_pool.h"
+#include "common/common_test.h"
+
+namespace mindspore {
+namespace common {
+class TestThreadPool : public UT::Common {
+ public:
+  TestThreadPool() = default;
+};
+
+/// Feature: common thread pool.
+/// Description: run the tasks and check each of them runs once.
+/// Expectation: all the tasks run.
+TEST_F(TestThreadPool, TestSyncRun) {
+  constexpr size_t kTaskNum = 100;
+  std::vector<std::atomic_int> hit_num(kTaskNum);
+  std::vector<Task> tasks;
+  for (size_t i = 0; i < kTaskNum; ++i) {
+    (void)tasks.emplace_back([&hit_num, i]() {
+      ++hit_num[i];
+      return SUCCESS;
+    });
+  }
+  EXPECT_TRUE(ThreadPool::GetInstance().SyncRun(tasks));
+  for (auto &hit : hit_num) {
+    EXPECT_EQ(hit, 1);
+  }
+  tasks.emplace_back([]() { return FAIL; });
+  EXPECT_FALSE(ThreadPool::GetInstance().SyncRun(tasks));
+}
+
+/// Feature: common thread pool.
+/// Description: wait for a task sleeping much longer than the spin of the caller.
+/// Expectation: the caller sleeps instead of spinning, and returns when the task finishes.
+TEST_F(TestThreadPool, TestWaitLongTask) {
+  constexpr auto kSleepTime = std::chrono::milliseconds(200);
+  auto thread_cpu_time = []() {
+    timespec time{};
+    (void)clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+    return std::chrono::seconds(time.tv_sec) + std::chrono::nanoseconds(time.tv_nsec);
+  };
+  std::atomic_bool started{false};
+  std::atomic_bool finished{false};
+  decltype(thread_cpu_time()) begin;
+  // the first task is run by the caller, it waits for the second one to be taken by the pool.
+  std::vector<Task> tasks{[&started, &begin, &thread_cpu_time]() {
+                            while (!started) {
+                              std::this_thread::yield();
+                            }
+                            begin = thread_cpu_time();
+                            return SUCCESS;
+                          },
+                          [&started, &finished, kSleepTime]() {
+                            started = true;
+                            std::this_thread::sleep_for(kSleepTime);
+                            finished = true;
+                            return SUCCESS;
+                          }};
+  EXPECT_TRUE(ThreadPool::GetInstance().SyncRun(tasks));
+  EXPECT_TRUE(finished);
+  auto wait_cpu_time = std::chrono::duration_cast<std::chrono::milliseconds>(thread_cpu_time() - begin);
+  EXPECT_LT(wait_cpu_time.count(), kSleepTime.count() / 2);
+}
+
+/// Feature: common thread pool.
+/// Description: launch a parallel for from inside the blocks of another parallel for.
+/// Expectation: every element is visited once and the nested call doesn't block.
+TEST_F(TestThreadPool, TestNestedParallelFor) {
+  constexpr size_t kOuterNum = 16;
+  constexpr size_t kInnerNum = 1000;
+  constexpr size_t kInnerGrain = 37;
+  auto &pool = ThreadPool::GetInstance();
+  std::vector<int> visit_num(kOuterNum * kInnerNum, 0);
+  auto outer = [&pool, &visit_num](size_t start, size_t end) {
+    for (size_t i = start; i < end; ++i) {
+      auto inner = [&visit_num, i](size_t inner_start, size_t inner_end) {
+        for (size_t j = inner_start; j < inner_end; ++j) {
+          ++visit_num[i * kInnerNum + j];
+        }
+        return SUCCESS;
+      };
+      if (!pool.ParallelFor(kInnerNum, kInnerGrain, inner)) {
+        return FAIL;
+      }
+    }
+    return SUCCESS;
+  };
+  EXPECT_TRUE(pool.ParallelFor(kOuterNum, 1, outer));
+  for (auto visit : visit_num) {
+    EXPECT_EQ(visit, 1);
+  }
+}
+
+/// Feature: common thread pool.
+/// Description: run a diamond graph, and a graph with a cycle.
+/// Expectation: the tasks run after their dependencies, the cycle is rejected.
+TEST_F(TestThreadPool, TestSyncRunGraph) {
+  std::atomic_size_t order{0};
+  std::vector<size_t> finish_order(4, 0);
+  std::vector<Task> tasks;
+  for (size_t i = 0; i < finish_order.size(); ++i) {
+    (void)tasks.emplace_back([&order, &finish_order, i]() {
+      finish_order[i] = order++;
+      return SUCCESS;
+    });
+  }
+  EXPECT_TRUE(ThreadPool::GetInstance().SyncRunGraph(tasks, {{}, {0}, {0}, {1, 2}}));
+  EXPECT_LT(finish_order[0], finish_order[1]);
+  EXPECT_LT(finish_order[0], finish_order[2]);
+  EXPECT_LT(finish_order[1], finish_order[3]);
+  EXPECT_LT(finish_order[2], finish_order[3]);
+  EXPECT_FALSE(ThreadPool::GetInstance().SyncRunGraph(tasks, {{3}, {0}, {1}, {2}}));
+}
+
+/// Feature: common thread pool.
+/// Description: resize the pool after it has run the tasks, and run a parallel for on the resized pool.
+/// Expectation: the pool has the new thread number and every element is visited once.
+TEST_F(TestThreadPool, TestSetMaxThreadNum) {
+  auto &pool = ThreadPool::GetInstance();
+  size_t origin_thread_num = pool.GetSyncRunThreadNum();
+  constexpr size_t kCount = 1000;
+  for (size_t thread_num : {origin_thread_num + 3, size_t(1), origin_thread_num}) {
+    pool.SetMaxThreadNum(thread_num);
+    EXPECT_EQ(pool.GetSyncRunThreadNum(), thread_num);
+    std::vector<int> visit_num(kCount, 0);
+    EXPECT_TRUE(pool.ParallelFor(kCount, 1, [&visit_num](size_t start, size_t end) {
+      for (size_t i = start; i < end; ++i) {
+        ++visit_num[i];
+      }
+      return SUCCESS;
+    }));
+    for (auto visit : visit_num) {
+      EXPECT_EQ(visit, 1);
+    }
+  }
+}
+}  // namespace common
+}  // namespace mindspore
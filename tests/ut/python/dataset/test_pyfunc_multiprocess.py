@@ -20,6 +20,7 @@ import pytest
 import mindspore.dataset as ds
 import mindspore.dataset.transforms.py_transforms as py_transforms
 import mindspore.dataset.vision.py_transforms as py_vision
+from mindspore.dataset.engine.queue import _SharedRing
 from util import visualize_list
 
 MNIST_DATA_DIR = "../data/dataset/testMnistData"
@@ -158,6 +159,97 @@ def test_pyfunc_multiproc_max_rowsize_large():
     ds.config.set_enable_shared_mem(mem_original)
 
 
+def test_pyfunc_multiproc_shared_ring():
+    """
+    Feature: Python Multiprocessing
+    Description: Put rows of different sizes into the shared memory ring and release them out of order
+    Expectation: The rows are mapped back unchanged, the ring is empty after all the rows are released
+    """
+    ring = _SharedRing(1024 * 1024)
+    rows = []
+    descs = []
+    for i in range(64):
+        row = (np.full(((i + 3) * 1000,), i, np.float32), np.array([i]), "label" + str(i))
+        desc = ring.put(row)
+        if desc[0] is None:
+            # the ring is full, release the rows except the last one, in reverse order
+            for desc_item in reversed(descs[:-1]):
+                ring.free(desc_item[0])
+            rows = rows[-1:]
+            descs = descs[-1:]
+            desc = ring.put(row)
+            assert desc[0] is not None
+        rows.append(row)
+        descs.append(desc)
+        for expect, desc_item in zip(rows, descs):
+            out = ring.get(desc_item)
+            np.testing.assert_array_equal(out[0], expect[0])
+            np.testing.assert_array_equal(out[1], expect[1])
+            assert out[2] == expect[2]
+    for desc in descs:
+        ring.free(desc[0])
+    assert ring.head.value == ring.tail.value
+
+    # a row larger than the ring is passed inline
+    large = (np.zeros((2 * 1024 * 1024,), np.uint8),)
+    desc = ring.put(large)
+    assert desc[0] is None
+    np.testing.assert_array_equal(ring.get(desc)[0], large[0])
+
+
+def test_pyfunc_multiproc_shared_ring_reclaim():
+    """
+    Feature: Python Multiprocessing
+    Description: Leave a region of the shared memory ring unreleased, reclaim the ring, and copy a row viewing the ring
+    Expectation: The leaked region is reclaimed while the kept one is not, and the copied row outlives its region
+    """
+    ring = _SharedRing(1024 * 1024)
+    row = (np.ones((50000,), np.float32),)
+    leaked = ring.put(row)
+    kept = ring.put(row)
+    assert leaked[0] is not None and kept[0] is not None
+    for _ in range(8):
+        desc = ring.put(row)
+        if desc[0] is not None:
+            ring.free(desc[0])
+    # the leaked region stops the tail, so the ring is full although only 2 regions are in use
+    assert ring.put(row)[0] is None
+    ring.reclaim({kept[0]})
+    assert ring.put(row)[0] is not None
+    np.testing.assert_array_equal(ring.get(kept)[0], row[0])
+
+    ring.reclaim()
+    assert ring.head.value == ring.tail.value
+    view = ring.get(ring.put(row))
+    desc = ring.copy_views((None, [(None, view[0]), (None, "label")]))
+    out = ring.get(desc)
+    assert not np.shares_memory(out[0], view[0])
+    np.testing.assert_array_equal(out[0], row[0])
+    assert out[1] == "label"
+
+
+def test_pyfunc_multiproc_inplace_input():
+    """
+    Feature: Python Multiprocessing
+    Description: Test Map op with python_multiprocessing=True, the Python function modifies its input in place
+    Expectation: The output rows are correct
+    """
+
+    def pyfunc(x):
+        x += 1
+        return x
+
+    np_data = np.arange(0, 20 * 64 * 64, dtype=np.float32).reshape((20, 64, 64))
+    data1 = ds.NumpySlicesDataset(np_data, column_names=["col0"], shuffle=False)
+    data1 = data1.map(operations=[pyfunc, pyfunc], input_columns="col0", output_columns="out",
+                      num_parallel_workers=4, python_multiprocessing=True, max_rowsize=1)
+    count = 0
+    for i, data in enumerate(data1.create_dict_iterator(num_epochs=1, output_numpy=True)):
+        np.testing.assert_array_equal(data["out"], np_data[i] + 2)
+        count += 1
+    assert count == 20
+
+
 def test_pyfunc_multiproc_basic_pipeline(plot=False):
     """
     Feature: Python Multiprocessing
@@ -268,6 +360,8 @@ if __name__ == '__main__':
     test_pyfunc_multiproc_noshrmem()
     test_pyfunc_multiproc_max_rowsize_small()
     test_pyfunc_multiproc_max_rowsize_large()
+    test_pyfunc_multiproc_shared_ring()
+    test_pyfunc_multiproc_inplace_input()
     test_pyfunc_multiproc_basic_pipeline(plot=True)
     test_pyfunc_multiproc_child_exception()
     test_pyfunc_multiproc_mainproc_exception()